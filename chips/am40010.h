@@ -186,6 +186,15 @@ extern "C" {
 #define AM40010_CONFIG_HROMEN   (1<<3)          // higher ROM enable
 #define AM40010_CONFIG_IRQRESET (1<<4)          // reset IRQ counter
 
+/* raw video log register numbers (see chips_vidlog_t), events are
+   recorded at the CRT beam position (crt.h_pos, crt.v_pos) and the
+   vram copy is the 64 KByte gate-array-visible RAM
+*/
+#define AM40010_VIDLOG_REG_INK0     (0)     // 16 ink registers
+#define AM40010_VIDLOG_REG_BORDER   (16)
+#define AM40010_VIDLOG_REG_CONFIG   (17)
+#define AM40010_VIDLOG_REG_CRTC0    (32)    // CRTC registers (recorded by the host system)
+
 // memory configuration callback
 typedef void (*am40010_bankswitch_t)(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_select, void* user_data);
 /* CCLK callback, this will be called at 1 MHz frequency and must
@@ -208,6 +217,8 @@ typedef struct am40010_desc_t {
     am40010_cclk_t cclk_cb;             // the 1 MHz CCLK callback
     chips_range_t ram;                  // direct pointer to the gate-array-visible 4*16 KByte RAM banks
     chips_range_t framebuffer;          // pointer to framebuffer (at least 1024 * 312 bytes)
+    chips_triple_buffer_t* triple_buffer;   // optional, if set the framebuffers are rotated at the start of each frame
+    chips_vidlog_t* vidlog;             // optional raw video log
     void* user_data;                    // optional userdata for callbacks
 } am40010_desc_t;
 
@@ -228,6 +239,8 @@ typedef struct am40010_video_t {
     bool sync;          // state of the sync output pin
     bool intr;          // interrupt flip-flop
     uint8_t latch[2];   // store video ram bytes read at 2 MHz
+    bool pixel_lut_valid;           // false if pixel_lut needs rebuilding
+    uint8_t pixel_lut[256][8];      // video byte => pixels for active mode and inks
 } am40010_video_t;
 
 // CRT beam tracking
@@ -242,11 +255,13 @@ typedef struct am40010_crt_t {
     bool sync;          // last syns state for sync raise detection
     bool h_blank;       // true if currently in horizontal blanking
     bool v_blank;       // true if currently in vertical blanking
+    uint32_t frame_count;   // incremented at the start of each new CRT frame
 } am40010_crt_t;
 
 // AM40010 state
 typedef struct am40010_t {
     bool dbg_vis;               // debug visualization currently enabled?
+    bool headless;              // skip framebuffer writes (set by the host system)
     am40010_cpc_type_t cpc_type;
     uint32_t seq_tick_count;    // gate array sequencer ticks
     uint64_t crtc_pins;         // previous crtc pins
@@ -261,6 +276,9 @@ typedef struct am40010_t {
     void* user_data;
     uint64_t pins;              // only for debug inspection
     uint8_t* fb;                // decoded framebuffer pixels as hw palette indices
+    chips_triple_buffer_t* triple_buffer;   // optional, rotates fb at the start of each frame
+    chips_vidlog_t* vidlog;             // optional raw video log
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
     uint32_t hw_colors[AM40010_NUM_HWCOLORS]; // hardware colors (different for CPC and KCC)
 } am40010_t;
 
@@ -290,6 +308,10 @@ uint64_t am40010_tick(am40010_t* ga, uint64_t cpu_pins);
 void am40010_snapshot_onsave(am40010_t* snapshot);
 // fixup am40010_t snapshot after loading
 void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the am40010_t state (excluding host pointers)
+uint64_t am40010_hash(const am40010_t* ga, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -435,6 +457,21 @@ static void _am40010_init_hwcolors(am40010_t* ga) {
     ga->hw_colors[0x3F] = 0xFF000000;
 }
 
+// record a register write in the optional raw video log
+static inline void _am40010_vidlog(am40010_t* ga, uint8_t reg, uint8_t val) {
+    if (ga->vidlog) {
+        chips_vidlog_write(ga->vidlog, (uint16_t)ga->crt.h_pos, (uint16_t)ga->crt.v_pos, reg, val);
+    }
+}
+
+static void _am40010_vidlog_regs(am40010_t* ga) {
+    for (int i = 0; i < 16; i++) {
+        _am40010_vidlog(ga, AM40010_VIDLOG_REG_INK0 + i, ga->regs.ink[i]);
+    }
+    _am40010_vidlog(ga, AM40010_VIDLOG_REG_BORDER, ga->regs.border);
+    _am40010_vidlog(ga, AM40010_VIDLOG_REG_CONFIG, ga->regs.config);
+}
+
 // initialize am40010_t instance
 void am40010_init(am40010_t* ga, const am40010_desc_t* desc) {
     CHIPS_ASSERT(ga && desc);
@@ -447,11 +484,22 @@ void am40010_init(am40010_t* ga, const am40010_desc_t* desc) {
     ga->cclk_cb = desc->cclk_cb;
     ga->ram = desc->ram.ptr;
     ga->fb = desc->framebuffer.ptr;
+    ga->triple_buffer = desc->triple_buffer;
+    if (ga->triple_buffer) {
+        CHIPS_ASSERT(ga->triple_buffer->size >= AM40010_FRAMEBUFFER_SIZE_BYTES);
+        ga->fb = chips_triple_buffer_back(ga->triple_buffer);
+    }
+    chips_dirty_lines_set_all(&ga->dirty_lines);
     ga->user_data = desc->user_data;
     _am40010_init_regs(ga);
     _am40010_init_video(ga);
     _am40010_init_crt(ga);
     _am40010_init_hwcolors(ga);
+    ga->vidlog = desc->vidlog;
+    if (ga->vidlog) {
+        chips_vidlog_set_range(ga->vidlog, 0, ga->ram, 64*1024);
+        _am40010_vidlog_regs(ga);
+    }
     ga->bankswitch_cb(ga->ram_config, ga->regs.config, ga->rom_select, ga->user_data);
 }
 
@@ -460,6 +508,7 @@ void am40010_reset(am40010_t* ga) {
     ga->seq_tick_count = 0;
     _am40010_init_regs(ga);
     _am40010_init_video(ga);
+    _am40010_vidlog_regs(ga);
     ga->bankswitch_cb(ga->ram_config, ga->regs.config, ga->rom_select, ga->user_data);
 }
 
@@ -493,8 +542,13 @@ void am40010_iorq(am40010_t* ga, uint64_t pins) {
             case (1<<6):
                 if (ga->regs.inksel & (1<<4)) {
                     ga->regs.border = data & 0x1F;
+                    _am40010_vidlog(ga, AM40010_VIDLOG_REG_BORDER, ga->regs.border);
                 } else {
-                    ga->regs.ink[ga->regs.inksel] = data & 0x1F;
+                    if (ga->regs.ink[ga->regs.inksel] != (data & 0x1F)) {
+                        ga->regs.ink[ga->regs.inksel] = data & 0x1F;
+                        ga->video.pixel_lut_valid = false;
+                    }
+                    _am40010_vidlog(ga, AM40010_VIDLOG_REG_INK0 + (ga->regs.inksel & 0xF), data & 0x1F);
                 }
                 break;
 
@@ -512,6 +566,7 @@ void am40010_iorq(am40010_t* ga, uint64_t pins) {
                 {
                     uint8_t romen_dirty = (ga->regs.config ^ data) & (AM40010_CONFIG_LROMEN|AM40010_CONFIG_HROMEN);
                     ga->regs.config = data & 0x1F;
+                    _am40010_vidlog(ga, AM40010_VIDLOG_REG_CONFIG, ga->regs.config);
                     if (0 != romen_dirty) {
                         ga->bankswitch_cb(ga->ram_config, ga->regs.config, ga->rom_select, ga->user_data);
                     }
@@ -612,6 +667,13 @@ static void _am40010_crt_tick(am40010_t* ga, bool sync) {
     }
     if (new_frame) {
         crt->v_pos = 0;
+        crt->frame_count++;
+        if (ga->triple_buffer) {
+            ga->fb = chips_triple_buffer_publish(ga->triple_buffer);
+        }
+        if (ga->vidlog) {
+            chips_vidlog_publish(ga->vidlog);
+        }
     }
 
     // compute visible beam state
@@ -643,6 +705,16 @@ static inline bool _am40010_rising_u64(uint64_t new_val, uint64_t old_val, uint6
    function in am40010_tick
 */
 static bool _am40010_sync_irq(am40010_t* ga, uint64_t crtc_pins) {
+    /* fast path for the bulk of each scanline: no HSYNC/VSYNC edge, HSYNC
+       inactive and CLKCNT idle means only the vsync state needs updating
+    */
+    if ((0 == ((crtc_pins ^ ga->crtc_pins) & AM40010_VS)) &&
+        (0 == ((crtc_pins | ga->crtc_pins) & AM40010_HS)) &&
+        (0 == ga->video.clkcnt))
+    {
+        ga->video.sync = ga->video.hscount < 4;
+        return ga->video.sync;
+    }
     bool hs_fall = _am40010_falling_u64(crtc_pins, ga->crtc_pins, AM40010_HS);
     bool vs_rise = _am40010_rising_u64(crtc_pins, ga->crtc_pins, AM40010_VS);
 
@@ -676,7 +748,11 @@ static bool _am40010_sync_irq(am40010_t* ga, uint64_t crtc_pins) {
     uint8_t clkcnt = ga->video.clkcnt;
     if (clkcnt == 7) {
         // trigger video-mode switch
-        ga->video.mode = ga->regs.config & AM40010_CONFIG_MODE;
+        const uint8_t mode = ga->regs.config & AM40010_CONFIG_MODE;
+        if (mode != ga->video.mode) {
+            ga->video.mode = mode;
+            ga->video.pixel_lut_valid = false;
+        }
     }
     // if HSYNC is off, force the clkcnt counter to 0
     if (0 == (crtc_pins & AM40010_HS)) {
@@ -713,8 +789,14 @@ static uint8_t _am40010_vid_read(am40010_t* ga, uint64_t crtc_pins, uint16_t ccl
     return ga->ram[addr];
 }
 
-static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
-    uint8_t c;
+/*
+    Rebuild the byte-to-pixel lookup table for the active video mode and
+    current ink colors. Each video memory byte maps to 8 framebuffer bytes
+    (one 16 MHz pixel each). The table is rebuilt lazily by the first pixel
+    decode after an ink register or the active video mode has changed, which
+    turns the per-byte bit shuffling into a single 8-byte fetch and store.
+*/
+static void _am40010_update_pixel_lut(am40010_t* ga) {
     uint8_t p;
     switch (ga->video.mode) {
         case 0:
@@ -724,8 +806,8 @@ static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
                 0:       |1|5|3|7|
                 1:       |0|4|2|6|
             */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
+            for (uint32_t c = 0; c < 256; c++) {
+                uint8_t* dst = ga->video.pixel_lut[c];
                 p = ga->regs.ink[((c>>7)&0x1)|((c>>2)&0x2)|((c>>3)&0x4)|((c<<2)&0x8)];
                 *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
                 p = ga->regs.ink[((c>>6)&0x1)|((c>>1)&0x2)|((c>>2)&0x4)|((c<<3)&0x8)];
@@ -741,8 +823,8 @@ static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
                 2:       |1|5|
                 3:       |0|4|
             */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
+            for (uint32_t c = 0; c < 256; c++) {
+                uint8_t* dst = ga->video.pixel_lut[c];
                 p = ga->regs.ink[((c>>2)&2)|((c>>7)&1)];
                 *dst++ = p; *dst++ = p;
                 p = ga->regs.ink[((c>>1)&2)|((c>>6)&1)];
@@ -755,8 +837,8 @@ static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
             break;
         case 2:
             // 640x200 @ 2 colors (8 pixels per byte)
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
+            for (uint32_t c = 0; c < 256; c++) {
+                uint8_t* dst = ga->video.pixel_lut[c];
                 *dst++ = ga->regs.ink[(c>>7)&1];
                 *dst++ = ga->regs.ink[(c>>6)&1];
                 *dst++ = ga->regs.ink[(c>>5)&1];
@@ -774,8 +856,8 @@ static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
                 0:       |x|x|3|7|
                 1:       |x|x|2|6|
             */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
+            for (uint32_t c = 0; c < 256; c++) {
+                uint8_t* dst = ga->video.pixel_lut[c];
                 p = ga->regs.ink[((c>>7)&0x1)|((c>>2)&0x2)];
                 *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
                 p = ga->regs.ink[((c>>6)&0x1)|((c>>1)&0x2)];
@@ -784,6 +866,16 @@ static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
             break;
         default: _AM40010_UNREACHABLE;
     }
+    ga->video.pixel_lut_valid = true;
+}
+
+// decode the 2 latched video memory bytes into 16 framebuffer pixels
+static inline void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
+    if (!ga->video.pixel_lut_valid) {
+        _am40010_update_pixel_lut(ga);
+    }
+    memcpy(dst, ga->video.pixel_lut[ga->video.latch[0]], 8);
+    memcpy(dst + 8, ga->video.pixel_lut[ga->video.latch[1]], 8);
 }
 
 // video signal generator, call this at 1 MHz frequency
@@ -793,6 +885,11 @@ static void _am40010_decode_video(am40010_t* ga, uint64_t crtc_pins) {
         size_t dst_y = ga->crt.v_pos;
         if ((dst_x <= (AM40010_FRAMEBUFFER_WIDTH-16)) && (dst_y < AM40010_FRAMEBUFFER_HEIGHT)) {
             uint8_t* dst = &(ga->fb[dst_x + dst_y * AM40010_FRAMEBUFFER_WIDTH]);
+            chips_dirty_lines_set(&ga->dirty_lines, dst_y);
+            if ((dst_x == 0) && (dst_y > 0)) {
+                // prev_dst is at the end of the previous row
+                chips_dirty_lines_set(&ga->dirty_lines, dst_y - 1);
+            }
             uint8_t* prev_dst;
             if (dst == ga->fb) {
                 prev_dst = dst;
@@ -835,18 +932,16 @@ static void _am40010_decode_video(am40010_t* ga, uint64_t crtc_pins) {
         size_t dst_x = ga->crt.pos_x * 16;
         size_t dst_y = ga->crt.pos_y;
         bool black = ga->video.sync;
-        uint8_t* dst = &ga->fb[dst_x + dst_y * AM40010_FRAMEBUFFER_WIDTH];
+        uint8_t pixels[16];
         if (crtc_pins & AM40010_DE) {
-            _am40010_decode_pixels(ga, dst);
+            _am40010_decode_pixels(ga, pixels);
         } else if (black) {
-            for (int i = 0; i < 16; i++) {
-                *dst++ = 63;    // special 'pure black' hw color
-            }
+            memset(pixels, 63, sizeof(pixels));     // special 'pure black' hw color
         } else {
-            for (int i = 0; i < 16; i++) {
-                *dst++ = ga->regs.border;
-            }
+            memset(pixels, ga->regs.border, sizeof(pixels));
         }
+        uint8_t* dst = &ga->fb[dst_x + dst_y * AM40010_FRAMEBUFFER_WIDTH];
+        chips_dirty_lines_copy(&ga->dirty_lines, dst_y, dst, pixels, sizeof(pixels));
     }
 }
 
@@ -895,7 +990,9 @@ uint64_t am40010_tick(am40010_t* ga, uint64_t pins) {
     if (cclk1) {
         // read second video ram byte
         ga->video.latch[1] = _am40010_vid_read(ga, ga->crtc_pins, 1);
-        _am40010_decode_video(ga, ga->crtc_pins);
+        if (!CHIPS_HEADLESS_SKIP(ga->headless)) {
+            _am40010_decode_video(ga, ga->crtc_pins);
+        }
     }
 
     // perform the per-4Mhz-tick actions, the AM40010_READY pin is also the Z80_WAIT pin
@@ -929,6 +1026,8 @@ void am40010_snapshot_onsave(am40010_t* snapshot) {
     snapshot->user_data = 0;
     snapshot->ram = 0;
     snapshot->fb = 0;
+    snapshot->triple_buffer = 0;
+    snapshot->vidlog = 0;
 }
 
 void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys) {
@@ -938,6 +1037,21 @@ void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys) {
     snapshot->user_data = sys->user_data;
     snapshot->ram = sys->ram;
     snapshot->fb = sys->fb;
+    snapshot->triple_buffer = sys->triple_buffer;
+    snapshot->vidlog = sys->vidlog;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t am40010_hash(const am40010_t* ga, uint64_t h) {
+    CHIPS_ASSERT(ga);
+    am40010_t tmp;
+    memcpy(&tmp, ga, sizeof(tmp));
+    am40010_snapshot_onsave(&tmp);
+    tmp.dbg_vis = false;
+    tmp.headless = false;
+    memset(&tmp.dirty_lines, 0, sizeof(tmp.dirty_lines));
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 #endif // CHIPS_IMPL
@@ -33,6 +33,24 @@
       a CP1610 CPU
     - the RESET pin state is ignored, instead call ay38910_reset()
 
+    LAZY MODE:
+
+    With ay38910_desc_t.lazy set to true, ay38910_tick() only counts
+    ticks and keeps track of the sample clock. The tone, noise and envelope
+    generators are brought up to date when a new sample is due, or before
+    a register is written. The catch-up only runs the generator logic on
+    ticks where a counter wraps around, so the output is the same as in
+    regular mode at a fraction of the cost. Call ay38910_sync() before
+    inspecting the generator state (e.g. in a debugger).
+
+    SILENT MODE:
+
+    While ay38910_t.silent is set (by the host system, e.g. in turbo mode
+    when the audio output is discarded anyway), ay38910_tick() doesn't
+    compute output samples. In lazy mode the generators are then only
+    brought up to date before register writes, the skipped sample points
+    are dropped.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -199,6 +217,7 @@ typedef struct {
     ay38910_in_t in_cb;     /* I/O port input callback */
     ay38910_out_t out_cb;   /* I/O port output callback */
     void* user_data;        /* optional user-data for callbacks */
+    bool lazy;              /* only synthesize on register writes and sample points (see LAZY MODE) */
 } ay38910_desc_t;
 
 // a tone channel
@@ -261,6 +280,10 @@ typedef struct {
     ay38910_noise_t noise;                      // the noise generator state
     ay38910_env_t env;                          // the envelope generator state
     uint64_t pins;          // last pin state for debug inspection
+    bool lazy;              // lazy mode enabled
+    uint32_t lazy_ticks;    // ticks not yet applied to the generators in lazy mode
+    uint32_t lazy_sample_ticks; // number of lazy ticks until the next sample is due
+    bool silent;            // don't compute output samples (set by the host system, see SILENT MODE)
 
     // sample generation state
     int sample_period;
@@ -289,6 +312,8 @@ void ay38910_reset(ay38910_t* ay);
 uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins);
 // tick the AY-3-8910, return true if a new sample is ready
 bool ay38910_tick(ay38910_t* ay);
+// lazy mode: bring the tone, noise and envelope generators up to date
+void ay38910_sync(ay38910_t* ay);
 // helper functions to directly write register values and update dependent state, not intended for regular operation!
 void ay38910_set_register(ay38910_t* ay, uint8_t addr, uint8_t data);
 void ay38910_set_addr_latch(ay38910_t* ay, uint8_t addr);
@@ -296,6 +321,10 @@ void ay38910_set_addr_latch(ay38910_t* ay, uint8_t addr);
 void ay38910_snapshot_onsave(ay38910_t* snapshot);
 // fixup ay38910_t snapshot after loading
 void ay38910_snapshot_onload(ay38910_t* snapshot, ay38910_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the ay38910_t state (excluding host pointers)
+uint64_t ay38910_hash(const ay38910_t* ay, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -433,6 +462,16 @@ static void _ay38910_restart_env_shape(ay38910_t* ay) {
     }
 }
 
+// in lazy mode, compute the number of ticks until the sample counter runs out
+static void _ay38910_update_lazy_sample_ticks(ay38910_t* ay) {
+    if (ay->sample_counter > 0) {
+        ay->lazy_sample_ticks = (ay->sample_counter + AY38910_FIXEDPOINT_SCALE - 1) / AY38910_FIXEDPOINT_SCALE;
+    }
+    else {
+        ay->lazy_sample_ticks = 1;
+    }
+}
+
 void ay38910_init(ay38910_t* ay, const ay38910_desc_t* desc) {
     CHIPS_ASSERT(ay && desc);
     CHIPS_ASSERT(desc->tick_hz > 0);
@@ -447,12 +486,15 @@ void ay38910_init(ay38910_t* ay, const ay38910_desc_t* desc) {
     ay->sample_period = (desc->tick_hz * AY38910_FIXEDPOINT_SCALE) / desc->sound_hz;
     ay->sample_counter = ay->sample_period;
     ay->mag = desc->magnitude;
+    ay->lazy = desc->lazy;
+    _ay38910_update_lazy_sample_ticks(ay);
     _ay38910_update_values(ay);
     _ay38910_restart_env_shape(ay);
 }
 
 void ay38910_reset(ay38910_t* ay) {
     CHIPS_ASSERT(ay);
+    ay38910_sync(ay);
     ay->addr = 0;
     ay->tick = 0;
     for (int i = 0; i < AY38910_NUM_REGISTERS; i++) {
@@ -462,7 +504,8 @@ void ay38910_reset(ay38910_t* ay) {
     _ay38910_restart_env_shape(ay);
 }
 
-bool ay38910_tick(ay38910_t* ay) {
+// tick the tone, noise and envelope generators
+static inline void _ay38910_tick_generators(ay38910_t* ay) {
     ay->tick++;
     if ((ay->tick & 7) == 0) {
         // tick the tone channels
@@ -503,29 +546,107 @@ bool ay38910_tick(ay38910_t* ay) {
             ay->env.shape_state = _ay38910_shapes[ay->env_shape_cycle][ay->env.shape_counter];
         }
     }
+}
+
+// number of generator clocks until a counter wraps around
+static inline uint32_t _ay38910_clocks_to_wrap(uint16_t counter, uint16_t period) {
+    return ((uint32_t)counter + 1 >= period) ? 1 : (uint32_t)(period - counter);
+}
+
+/* advance the generators by a number of ticks, the generator logic only
+   runs on ticks where a counter wraps around, on all other ticks the
+   counters are simply incremented
+*/
+static void _ay38910_advance(ay38910_t* ay, uint32_t num_ticks) {
+    while (num_ticks > 0) {
+        // tone and noise counters are clocked every 8 ticks, the envelope counter every 16 ticks
+        uint32_t clk8 = _ay38910_clocks_to_wrap(ay->noise.counter, ay->noise.period);
+        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+            uint32_t c = _ay38910_clocks_to_wrap(ay->tone[i].counter, ay->tone[i].period);
+            if (c < clk8) {
+                clk8 = c;
+            }
+        }
+        const uint32_t clk16 = _ay38910_clocks_to_wrap(ay->env.counter, ay->env.period);
+        const uint32_t ticks8 = (8 - (ay->tick & 7)) + (clk8 - 1) * 8;
+        const uint32_t ticks16 = (16 - (ay->tick & 15)) + (clk16 - 1) * 16;
+        const uint32_t ticks_to_wrap = (ticks8 < ticks16) ? ticks8 : ticks16;
+        // skip over the ticks where no counter wraps around
+        const uint32_t skip = (ticks_to_wrap <= num_ticks) ? (ticks_to_wrap - 1) : num_ticks;
+        const uint16_t inc8 = (uint16_t)(((ay->tick & 7) + skip) >> 3);
+        const uint16_t inc16 = (uint16_t)(((ay->tick & 15) + skip) >> 4);
+        ay->tick += skip;
+        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+            ay->tone[i].counter += inc8;
+        }
+        ay->noise.counter += inc8;
+        ay->env.counter += inc16;
+        num_ticks -= skip;
+        if (num_ticks > 0) {
+            _ay38910_tick_generators(ay);
+            num_ticks--;
+        }
+    }
+}
+
+void ay38910_sync(ay38910_t* ay) {
+    if (ay->lazy_ticks > 0) {
+        _ay38910_advance(ay, ay->lazy_ticks);
+        int64_t counter = (int64_t)ay->sample_counter - (int64_t)ay->lazy_ticks * AY38910_FIXEDPOINT_SCALE;
+        if (counter <= -ay->sample_period) {
+            // in silent mode, drop the sample points which have been skipped
+            counter = -(-counter % ay->sample_period);
+        }
+        ay->sample_counter = (int)counter;
+        ay->lazy_ticks = 0;
+        _ay38910_update_lazy_sample_ticks(ay);
+    }
+}
+
+// compute a new output sample
+static void _ay38910_sample(ay38910_t* ay) {
+    float sm = 0.0f;
+    for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+        const ay38910_tone_t* chn = &ay->tone[i];
+        float vol;
+        if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
+            // fixed amplitude
+            vol = _ay38910_volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
+        }
+        else {
+            // envelope control
+            vol = _ay38910_volumes[ay->env.shape_state];
+        }
+        int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
+        if (vol_enable) {
+            sm += vol;
+        }
+    }
+    ay->sample = _ay38910_dcadjust(ay, sm) * ay->mag;
+}
+
+bool ay38910_tick(ay38910_t* ay) {
+    if (ay->lazy) {
+        // only count ticks until the next sample is due
+        if ((++ay->lazy_ticks < ay->lazy_sample_ticks) || ay->silent) {
+            return false;
+        }
+        ay38910_sync(ay);
+        ay->sample_counter += ay->sample_period;
+        _ay38910_update_lazy_sample_ticks(ay);
+        _ay38910_sample(ay);
+        return true;
+    }
+    _ay38910_tick_generators(ay);
 
     // generate new sample?
     ay->sample_counter -= AY38910_FIXEDPOINT_SCALE;
     if (ay->sample_counter <= 0) {
         ay->sample_counter += ay->sample_period;
-        float sm = 0.0f;
-        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
-            const ay38910_tone_t* chn = &ay->tone[i];
-            float vol;
-            if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
-                // fixed amplitude
-                vol = _ay38910_volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
-            }
-            else {
-                // envelope control
-                vol = _ay38910_volumes[ay->env.shape_state];
-            }
-            int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
-            if (vol_enable) {
-                sm += vol;
-            }
+        if (ay->silent) {
+            return false;
         }
-        ay->sample = _ay38910_dcadjust(ay, sm) * ay->mag;
+        _ay38910_sample(ay);
         return true; // new sample is ready
     }
     // fallthrough: no new sample ready yet
@@ -549,6 +670,7 @@ uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins) {
             */
             if (ay->addr < AY38910_NUM_REGISTERS) {
                 // write register content, and update dependent values
+                ay38910_sync(ay);
                 ay->reg[ay->addr] = data & _ay38910_reg_mask[ay->addr];
                 _ay38910_update_values(ay);
                 if (ay->addr == AY38910_REG_ENV_SHAPE_CYCLE) {
@@ -644,6 +766,7 @@ uint64_t ay38910_tick(ay38910_t* ay, uint64_t pins) {
 
 void ay38910_set_register(ay38910_t* ay, uint8_t addr, uint8_t data) {
     CHIPS_ASSERT(ay && (addr < AY38910_NUM_REGISTERS));
+    ay38910_sync(ay);
     ay->reg[addr] = data & _ay38910_reg_mask[addr];
     _ay38910_update_values(ay);
     if (addr == AY38910_REG_ENV_SHAPE_CYCLE) {
@@ -669,4 +792,15 @@ void ay38910_snapshot_onload(ay38910_t* snapshot, ay38910_t* sys) {
     snapshot->out_cb = sys->out_cb;
     snapshot->user_data = sys->user_data;
 }
+
+#if defined(CHIPS_HASH_SEED)
+uint64_t ay38910_hash(const ay38910_t* ay, uint64_t h) {
+    CHIPS_ASSERT(ay);
+    ay38910_t tmp;
+    memcpy(&tmp, ay, sizeof(tmp));
+    ay38910_snapshot_onsave(&tmp);
+    tmp.silent = false;
+    return CHIPS_HASH(h, tmp);
+}
+#endif
 #endif /* CHIPS_IMPL */
@@ -2,7 +2,18 @@
 /*
     beeper.h    -- simple square-wave beeper
 
-    TODO: docs
+    The beeper output is a 1-bit signal which only changes when
+    beeper_set(), beeper_toggle() or beeper_set_volume() is called.
+    Instead of filtering the signal on every tick, each level change is
+    inserted into a short output buffer as a band-limited step (BLEP)
+    at its exact sub-sample position. beeper_tick() then only needs to
+    advance the sample clock.
+
+    Output samples are delayed by BEEPER_BLEP_WIDTH/2 samples.
+
+    While beeper_t.silent is set (by the host system, e.g. in turbo mode
+    when the audio output is discarded anyway), level changes are applied
+    immediately without inserting band-limited steps.
 
     ## zlib/libpng license
 
@@ -31,8 +42,12 @@ extern "C" {
 
 // error-accumulation precision boost
 #define BEEPER_FIXEDPOINT_SCALE (16)
-// DC adjust buffer size
-#define BEEPER_DCADJ_BUFLEN (128)
+// number of samples covered by a band-limited step
+#define BEEPER_BLEP_WIDTH (16)
+// number of sub-sample positions in the band-limited step table
+#define BEEPER_BLEP_PHASES (64)
+// size of the output delta ring buffer (power of 2, >= BEEPER_BLEP_WIDTH)
+#define BEEPER_BLEP_BUFLEN (32)
 
 // initialization parameters
 typedef struct {
@@ -49,9 +64,12 @@ typedef struct {
     float base_volume;
     float volume;
     float sample;
-    float dcadj_sum;
-    uint32_t dcadj_pos;
-    float dcadj_buf[BEEPER_DCADJ_BUFLEN];
+    float level;            // current output level (state * volume * base_volume)
+    float blep_accum;       // integrated output deltas
+    uint32_t blep_pos;      // read position in blep_buf
+    uint32_t blep_settle;   // number of samples until the last step has settled
+    float blep_buf[BEEPER_BLEP_BUFLEN]; // pending band-limited output deltas
+    bool silent;            // don't insert band-limited steps (set by the host system)
 } beeper_t;
 
 // initialize beeper instance
@@ -59,17 +77,11 @@ void beeper_init(beeper_t* beeper, const beeper_desc_t* desc);
 // reset the beeper instance
 void beeper_reset(beeper_t* beeper);
 // set current on/off state
-static inline void beeper_set(beeper_t* beeper, bool state) {
-    beeper->state = state ? 1 : 0;
-}
+void beeper_set(beeper_t* beeper, bool state);
 // toggle current state (on->off or off->on)
-static inline void beeper_toggle(beeper_t* beeper) {
-    beeper->state = !beeper->state;
-}
+void beeper_toggle(beeper_t* beeper);
 // set current volume 0.0 to 1.0
-static inline void beeper_set_volume(beeper_t* beeper, float vol) {
-    beeper->volume = vol;
-}
+void beeper_set_volume(beeper_t* beeper, float vol);
 // tick the beeper, return true if a new sample is ready
 bool beeper_tick(beeper_t* beeper);
 
@@ -79,20 +91,57 @@ bool beeper_tick(beeper_t* beeper);
 /*-- IMPLEMENTATION ----------------------------------------------------------*/
 #ifdef CHIPS_IMPL
 #include <string.h>
+#include <math.h>   /* sinf, cosf, fabsf */
 #ifndef CHIPS_ASSERT
     #include <assert.h>
     #define CHIPS_ASSERT(c) assert(c)
 #endif
 
+/* band-limited impulses for each sub-sample position, the integral of an
+   impulse is a band-limited step, the table is shared by all beeper
+   instances and built by the first beeper_init() call
+*/
+static float _beeper_blep[BEEPER_BLEP_PHASES][BEEPER_BLEP_WIDTH];
+static bool _beeper_blep_valid;
+
+static void _beeper_init_blep_table(void) {
+    if (_beeper_blep_valid) {
+        return;
+    }
+    // Blackman-windowed sinc, cutoff slightly below the Nyquist frequency
+    const float cutoff = 0.45f;
+    const float pi = 3.14159265358979323846f;
+    const float half_width = BEEPER_BLEP_WIDTH / 2;
+    for (int phase = 0; phase < BEEPER_BLEP_PHASES; phase++) {
+        const float frac = (float)phase / BEEPER_BLEP_PHASES;
+        float sum = 0.0f;
+        for (int i = 0; i < BEEPER_BLEP_WIDTH; i++) {
+            const float x = (float)i - half_width + frac;
+            const float sx = 2.0f * pi * cutoff * x;
+            const float sinc = (x == 0.0f) ? 1.0f : (sinf(sx) / sx);
+            const float wx = pi * x / half_width;
+            const float window = (fabsf(x) >= half_width) ? 0.0f : (0.42f + 0.5f * cosf(wx) + 0.08f * cosf(2.0f * wx));
+            _beeper_blep[phase][i] = sinc * window;
+            sum += _beeper_blep[phase][i];
+        }
+        // normalize so that each step reaches exactly the new level
+        for (int i = 0; i < BEEPER_BLEP_WIDTH; i++) {
+            _beeper_blep[phase][i] /= sum;
+        }
+    }
+    _beeper_blep_valid = true;
+}
+
 void beeper_init(beeper_t* b, const beeper_desc_t* desc) {
     CHIPS_ASSERT(b && desc);
     CHIPS_ASSERT((desc->tick_hz > 0) && (desc->sound_hz > 0));
     *b = (beeper_t){
         .period = (desc->tick_hz * BEEPER_FIXEDPOINT_SCALE) / desc->sound_hz,
-        .counter = b->period,
         .base_volume = desc->base_volume,
         .volume = 1.0f,
     };
+    b->counter = b->period;
+    _beeper_init_blep_table();
 }
 
 void beeper_reset(beeper_t* b) {
@@ -100,31 +149,87 @@ void beeper_reset(beeper_t* b) {
     b->state = 0;
     b->counter = b->period;
     b->sample = 0;
+    b->level = 0.0f;
+    b->blep_accum = 0.0f;
+    b->blep_pos = 0;
+    b->blep_settle = 0;
+    memset(b->blep_buf, 0, sizeof(b->blep_buf));
 }
 
-/* DC adjustment filter from StSound, this moves an "offcenter"
-   signal back to the zero-line (e.g. the volume-level output
-   from the chip simulation which is >0.0 gets converted to
-   a +/- sample value)
-*/
-static void _beeper_dcadjust(beeper_t* bp, float s) {
-    bp->dcadj_sum -= bp->dcadj_buf[bp->dcadj_pos];
-    bp->dcadj_sum += s;
-    bp->dcadj_buf[bp->dcadj_pos] = s;
-    bp->dcadj_pos = (bp->dcadj_pos + 1) & (BEEPER_DCADJ_BUFLEN-1);
+// insert a band-limited step after the output level has changed
+static void _beeper_update_level(beeper_t* b) {
+    const float level = (float)b->state * b->volume * b->base_volume;
+    const float delta = level - b->level;
+    if (delta == 0.0f) {
+        return;
+    }
+    b->level = level;
+    if (b->silent) {
+        // no audio output is generated, drop any pending steps
+        if (b->blep_settle > 0) {
+            memset(b->blep_buf, 0, sizeof(b->blep_buf));
+            b->blep_settle = 0;
+        }
+        b->blep_accum = level;
+        return;
+    }
+    /* the sample counter tells how far before the next sample point the
+       level change happened, this selects the sub-sample step position
+    */
+    int phase = (int)(((int64_t)b->counter * BEEPER_BLEP_PHASES) / b->period);
+    if (phase >= BEEPER_BLEP_PHASES) {
+        phase = BEEPER_BLEP_PHASES - 1;
+    }
+    else if (phase < 0) {
+        phase = 0;
+    }
+    const float* blep = _beeper_blep[phase];
+    for (uint32_t i = 0; i < BEEPER_BLEP_WIDTH; i++) {
+        b->blep_buf[(b->blep_pos + i) & (BEEPER_BLEP_BUFLEN-1)] += delta * blep[i];
+    }
+    b->blep_settle = BEEPER_BLEP_WIDTH;
+}
+
+void beeper_set(beeper_t* b, bool state) {
+    CHIPS_ASSERT(b);
+    if (b->state != (state ? 1 : 0)) {
+        b->state = state ? 1 : 0;
+        _beeper_update_level(b);
+    }
+}
+
+void beeper_toggle(beeper_t* b) {
+    CHIPS_ASSERT(b);
+    b->state = !b->state;
+    _beeper_update_level(b);
+}
+
+void beeper_set_volume(beeper_t* b, float vol) {
+    CHIPS_ASSERT(b);
+    if (b->volume != vol) {
+        b->volume = vol;
+        _beeper_update_level(b);
+    }
 }
 
 bool beeper_tick(beeper_t* bp) {
-    _beeper_dcadjust(bp, (float)bp->state * bp->volume * bp->base_volume);
     /* generate a new sample? */
     bp->counter -= BEEPER_FIXEDPOINT_SCALE;
     if (bp->counter <= 0) {
         bp->counter += bp->period;
-        bp->sample = bp->dcadj_sum / BEEPER_DCADJ_BUFLEN;
+        if (bp->blep_settle > 0) {
+            bp->blep_accum += bp->blep_buf[bp->blep_pos];
+            bp->blep_buf[bp->blep_pos] = 0.0f;
+            bp->blep_pos = (bp->blep_pos + 1) & (BEEPER_BLEP_BUFLEN-1);
+            if (--bp->blep_settle == 0) {
+                // all steps are complete, remove accumulated rounding errors
+                bp->blep_accum = bp->level;
+            }
+        }
+        bp->sample = bp->blep_accum;
         return true;
     }
     return false;
 }
 
-
 #endif /* CHIPS_IMPL */
@@ -25,6 +25,22 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(CHIPS_PROFILE) && !defined(_MSC_VER) && !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+#include <time.h>
+#endif
+
+// force inlining, used for template-style functions with compile-time constant arguments
+#if defined(__GNUC__)
+#define CHIPS_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define CHIPS_FORCE_INLINE __forceinline
+#else
+#define CHIPS_FORCE_INLINE inline
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,22 +59,189 @@ typedef struct {
     int x, y, width, height;
 } chips_rect_t;
 
+/*
+    Dirty framebuffer row tracking.
+
+    Video decoders set the bit of a framebuffer row when they write pixels
+    which differ from the current framebuffer content. The bits accumulate
+    until the host calls chips_dirty_lines_clear(), for instance after
+    uploading the changed rows into a texture.
+*/
+#define CHIPS_DIRTY_MAX_LINES (512)
+typedef struct {
+    uint32_t bits[CHIPS_DIRTY_MAX_LINES / 32];
+} chips_dirty_lines_t;
+
+/*
+    Optional lock-free triple buffer for handing finished frames from the
+    emulation thread to a render thread.
+
+    When a triple buffer is attached to a video chip (through the system's
+    desc struct), the video chip decodes into the buffer returned by
+    chips_triple_buffer_back() instead of the system's framebuffer. When the
+    beam returns to the top of the screen, the chip publishes the finished
+    buffer with chips_triple_buffer_publish() and continues decoding
+    into the previously published buffer if the render thread hasn't
+    picked that up yet, or the buffer the render thread has released.
+    The render thread calls chips_triple_buffer_acquire() to get the most
+    recently finished frame, which it may read until the next call. No
+    pixels are copied, and neither thread ever waits for the other.
+
+    The 3 buffers are provided by the caller and must be at least as big
+    as the system's framebuffer. The video chip only writes pixels which
+    are actually decoded, so frames skipped in headless mode leave stale
+    content behind, and a system's dirty-row tracking isn't available
+    while a triple buffer is attached.
+
+    When attaching a triple buffer, the system also points its clock at
+    the system's tick counter (see 'A/V Timestamps' below), and each
+    published frame is stamped with the tick at which it was completed.
+    The render thread gets the stamp of the acquired frame with
+    chips_triple_buffer_tick().
+*/
+#define CHIPS_TRIPLE_BUFFER_FRESH (1<<2)
+typedef struct {
+    uint8_t* buffers[3];    // caller-provided framebuffers
+    size_t size;            // size of each buffer in bytes
+    uint32_t back;          // index of the buffer being decoded into, only accessed by the producer
+    uint32_t front;         // index of the buffer being displayed, only accessed by the consumer
+    uint8_t _pad0[64 - 3 * sizeof(uint8_t*) - sizeof(size_t) - 2 * sizeof(uint32_t)];  // keep the shared index on a separate cache line
+    uint32_t middle;        // index of the last published buffer, ORed with CHIPS_TRIPLE_BUFFER_FRESH until acquired
+    const uint64_t* clock;  // system tick counter for frame timestamps (set by the system)
+    uint64_t ticks[3];      // system tick at which each buffer was published
+} chips_triple_buffer_t;
+
+/*
+    Optional raw video log for reconstructing the picture outside the
+    emulator, for instance in a GPU shader.
+
+    When a video log is attached to a video chip (through the system's desc
+    struct), every write to a video register is recorded together with the
+    current beam position. When the beam returns to the top of the screen,
+    the frame is published: the video memory ranges registered by the
+    system are copied back-to-back into the caller-provided vram buffer
+    (ranges with a null pointer read as 0xFF), and the frame's events
+    together with the register values at the start of the frame become
+    available through chips_vidlog_last(). Combine the video log with the
+    system's headless mode to skip pixel decoding altogether.
+
+    Register numbers, beam position units and the vram layout are defined
+    by each system (see the 'Raw Video Log' section in the system headers).
+    Video memory is copied at the end of the frame, so CPU writes which race
+    the beam aren't reproduced. If a frame has more than
+    CHIPS_VIDLOG_MAX_EVENTS register writes, the remaining
+    events are dropped and the frame's overflow flag is set.
+*/
+#define CHIPS_VIDLOG_MAX_EVENTS (2048)
+#define CHIPS_VIDLOG_MAX_REGS (64)
+#define CHIPS_VIDLOG_MAX_RANGES (20)
+typedef struct {
+    uint16_t x, y;          // beam position
+    uint8_t reg;            // register number (< CHIPS_VIDLOG_MAX_REGS)
+    uint8_t val;            // new register value
+} chips_vidlog_event_t;
+
+typedef struct {
+    uint32_t frame;         // frame number
+    uint32_t num_events;
+    bool overflow;          // true if events have been dropped
+    uint8_t regs[CHIPS_VIDLOG_MAX_REGS];    // register values at the start of the frame
+    chips_vidlog_event_t events[CHIPS_VIDLOG_MAX_EVENTS];
+} chips_vidlog_frame_t;
+
+typedef struct {
+    chips_range_t vram;     // caller-provided buffer for the video memory copy of the last published frame
+    int num_ranges;
+    chips_range_t ranges[CHIPS_VIDLOG_MAX_RANGES];  // video memory copied into vram (set by the system)
+    uint32_t frame_count;   // number of published frames
+    uint8_t regs[CHIPS_VIDLOG_MAX_REGS];    // current register values
+    chips_vidlog_frame_t frames[2];         // frame in progress and last published frame
+} chips_vidlog_t;
+
 typedef struct {
     struct {
         chips_dim_t dim;        // framebuffer dimensions in pixels
         chips_range_t buffer;
         size_t bytes_per_pixel; // 1 or 4
+        chips_dirty_lines_t* dirty_lines;  // optional changed-rows bitmap, null if not supported
+        chips_triple_buffer_t* triple_buffer;   // if not null, get frames with chips_triple_buffer_acquire() instead of buffer
+        uint64_t tick;          // system tick at the end of the last exec call (see 'A/V Timestamps')
     } frame;
     chips_rect_t screen;
     chips_range_t palette;
     bool portrait;
 } chips_display_info_t;
 
+/*
+    Optional single-producer/single-consumer lock-free audio sample ring.
+
+    When a ring is attached to chips_audio_callback_t, a system writes each
+    new audio sample straight into the ring on the emulation thread instead
+    of collecting samples and invoking the audio callback. The audio thread
+    pulls samples with chips_audio_ring_pull(), and the frontend can use
+    chips_audio_ring_count() as a watermark for dynamic rate control.
+
+    The sample buffer is provided by the caller, and the number of samples
+    must be a power of 2. If the ring is full, new samples are dropped
+    and the overflow counter is incremented.
+*/
+typedef struct {
+    float* buffer;          // caller-provided sample buffer
+    uint32_t num_samples;   // capacity of the sample buffer (power of 2)
+    uint32_t overflows;     // number of dropped samples (written by producer)
+    uint8_t _pad0[64 - sizeof(float*) - 2 * sizeof(uint32_t)];  // keep producer and consumer positions on separate cache lines
+    uint32_t write_pos;     // free-running write position, only written by the producer
+    uint8_t _pad1[64 - sizeof(uint32_t)];
+    uint32_t read_pos;      // free-running read position, only written by the consumer
+} chips_audio_ring_t;
+
+/*
+    A/V Timestamps
+
+    Each system has a free-running tick counter which is incremented once
+    per system tick (at the frequency of the system's master clock, for
+    instance 985248 Hz on a PAL C64). It is part of the emulation state,
+    so it is saved and restored with snapshots but it isn't included in
+    the state hash and keeps running across a system reset.
+
+    If chips_audio_callback_t.timed_func is set, it is called instead of
+    func with the tick at which the block's last sample was produced.
+    Completed frames carry the tick at the end of the exec call in
+    chips_display_info_t.frame.tick (for *_exec_frame() this is the
+    tick at which the frame was finished), or the tick at which each
+    frame was published when a triple buffer is attached. A host which
+    streams audio and video can multiplex both on this one time base
+    instead of buffering to hide the jitter between them. Samples written
+    into an audio ring are not timestamped.
+*/
 typedef struct {
     void (*func)(const float* samples, int num_samples, void* user_data);
     void* user_data;
+    chips_audio_ring_t* ring;   // optional, if set samples are written into the ring and func isn't called
+    // optional, called instead of func with the system tick of the block's last sample (see 'A/V Timestamps')
+    void (*timed_func)(const float* samples, int num_samples, uint64_t tick, void* user_data);
 } chips_audio_callback_t;
 
+/*
+    An optional breakpoint map which can be attached to chips_debug_t.
+
+    Without a breakpoint map, the debug callback is invoked on every tick.
+    With a breakpoint map, the system's exec loop only invokes the debug
+    callback when an instruction starts at an address with the exec-bit set,
+    a memory read or write hits an address with the read- or write-bit set,
+    at the start of each instruction when every_op is true (for instance
+    when stepping over instructions), or on every tick when every_tick is
+    true (when per-tick breakpoints are active).
+*/
+#define CHIPS_BREAKMAP_NUM_WORDS (0x10000/32)
+typedef struct {
+    uint32_t exec[CHIPS_BREAKMAP_NUM_WORDS];    // break at start of instruction at address
+    uint32_t read[CHIPS_BREAKMAP_NUM_WORDS];    // break on memory read from address
+    uint32_t write[CHIPS_BREAKMAP_NUM_WORDS];   // break on memory write to address
+    bool every_op;                              // if true invoke the debug callback at the start of each instruction
+    bool every_tick;                            // if true invoke the debug callback on every tick
+} chips_breakmap_t;
+
 typedef void (*chips_debug_func_t)(void* user_data, uint64_t pins);
 typedef struct {
     struct {
@@ -66,6 +249,7 @@ typedef struct {
         void* user_data;
     } callback;
     bool* stopped;
+    const chips_breakmap_t* breakmap;   // optional, if null the callback is invoked on every tick
 } chips_debug_t;
 
 typedef struct {
@@ -75,14 +259,695 @@ typedef struct {
     float volume;
 } chips_audio_desc_t;
 
+/*
+    Headless video mode, embedded in system desc and state structs.
+
+    With headless.enabled set, a system still updates all timing-relevant
+    video chip state (raster counters, interrupts, bad lines, sprite
+    collisions...) but doesn't write pixels into the framebuffer. If
+    headless.interval is N > 0, the pixels are still written during every
+    Nth call to the system's exec function.
+
+    When CHIPS_HEADLESS is defined before including the implementation,
+    framebuffer writes are always skipped and the pixel decoding code
+    is removed by the compiler.
+*/
+typedef struct {
+    bool enabled;       // true to skip writing pixels into the framebuffer
+    uint32_t interval;  // if enabled and > 0, still write pixels in every Nth exec call
+    uint32_t counter;   // internal: exec call counter
+    bool skip;          // internal: true while pixel writes are skipped
+} chips_headless_t;
+
+/*
+    Turbo mode, embedded in system state structs.
+
+    With turbo.factor N > 1, each call to a system's exec function runs
+    N slices of the requested time (or N video frames in the exec_frame
+    function). Only the last slice writes pixels and forwards audio
+    samples. The slices before it run as in headless mode, and their audio
+    samples are dropped, so the host's audio stream stays in real time. All
+    chips are still ticked as usual (the audio chips already synthesize
+    lazily), so the emulation state is exactly the same as when running
+    without turbo mode. The factor can be changed between exec calls.
+
+    After each exec call, turbo.speed is the executed emulated time relative
+    to the requested time. This is usually the factor, but it's lower when a
+    breakpoint stops execution, or higher if a system-specific speed-up
+    (e.g. C64 tape turbo) kicked in.
+*/
+typedef struct {
+    uint32_t factor;    // number of exec slices per exec call, 0 or 1: turbo mode off
+    bool skip;          // internal: true while a slice without video and audio output runs
+    float speed;        // achieved speed factor of the last exec call
+} chips_turbo_t;
+
+/*
+    Guest state observation for automation and machine learning rigs.
+
+    A system's *_observe() function returns host pointers and sizes of the
+    emulated RAM banks, the system's display info (framebuffer, visible
+    screen rect and palette), and a pointer to the CPU state struct (a z80_t
+    or m6502_t). The pointers stay valid for the lifetime of the system
+    instance, so an agent can call *_observe() once and read the guest
+    state directly after each exec call, instead of going through mem_rd()
+    per byte or depending on the layout of the system struct.
+
+    The optional vblank callback (set in the system's desc struct) is
+    invoked once per emulated video frame, at the point where the video
+    chip starts a new frame. Systems which decode their video memory at
+    the end of the exec call invoke it after decoding instead. The callback
+    is called from inside the exec function and should only read state.
+    It is invoked for every frame, including frames where headless mode
+    has skipped the pixel writes.
+*/
+#define CHIPS_OBSERVE_MAX_RAM (8)
+typedef enum {
+    CHIPS_OBSERVE_CPU_Z80,
+    CHIPS_OBSERVE_CPU_M6502,
+} chips_observe_cpu_t;
+
+typedef struct {
+    const char* name;       // bank name, e.g. "ram" or "color_ram"
+    chips_range_t mem;      // host pointer and size of the bank
+} chips_observe_ram_t;
+
+typedef struct {
+    int num_ram;
+    chips_observe_ram_t ram[CHIPS_OBSERVE_MAX_RAM];
+    chips_display_info_t display;
+    struct {
+        chips_observe_cpu_t type;
+        const void* state;  // z80_t* or m6502_t*
+    } cpu;
+} chips_observation_t;
+
+typedef struct {
+    void (*func)(void* user_data);
+    void* user_data;
+} chips_vblank_callback_t;
+
+typedef struct {
+    chips_vblank_callback_t callback;
+    uint32_t frame_count;   // internal: last seen video frame counter
+} chips_vblank_t;
+
+/*
+    Next-event scheduler, embedded in system state structs.
+
+    Chips which only need attention at a predictable future tick (for
+    instance a timer underflow) or on a CPU access can be taken out of
+    the per-tick path of a system's tick function. Each such chip owns an
+    event slot. After ticking the chip, the system publishes the number of
+    following ticks the chip can be skipped with chips_sched_set(). On a
+    later tick, if the chip is selected by the CPU or chips_sched_due()
+    returns true, the system first catches the chip up with the number of
+    skipped ticks returned by chips_sched_sync() and then ticks the chip
+    normally. The system calls chips_sched_tick() once at the end of each
+    tick.
+*/
+#define CHIPS_SCHED_MAX_SLOTS (4)
+typedef struct {
+    uint64_t now;                           // current tick
+    uint64_t next;                          // earliest due tick over all slots
+    uint64_t due[CHIPS_SCHED_MAX_SLOTS];    // tick at which a slot needs to be ticked again
+    uint64_t synced[CHIPS_SCHED_MAX_SLOTS]; // tick up to which a slot has been ticked or caught up
+} chips_sched_t;
+
+/*
+    Tape queue for OS-level load traps, embedded in system state structs.
+
+    Instead of emulating tape pulses, some systems intercept the ROM's
+    tape load routine and satisfy it directly from a queue of
+    concatenated tape files: the trap takes the next file from the
+    queue, copies its data blocks into memory with mem_write_range() and
+    returns to the caller with the CPU registers set up as the ROM
+    routine would have left them. The data is owned by the caller and
+    must remain valid while it is inserted. Only the read position is
+    part of snapshots.
+*/
+typedef struct {
+    const uint8_t* ptr; // start of concatenated tape files, or 0 if no tape is inserted
+    size_t size;        // size of tape data in bytes
+    size_t pos;         // read position of the next file
+} chips_tape_t;
+
+/*
+    Text input queue, embedded in system state structs.
+
+    Holds a caller-owned text (e.g. pasted into the host window) which
+    the system types into the emulated machine at the fastest rate the
+    guest accepts. Systems with a known operating system write the
+    characters straight into the OS keyboard buffer, other systems press
+    and release keys one after another (the key and delay members are
+    only used by those). The text must remain valid until the queue is
+    empty or stopped. Only the read position is part of snapshots.
+*/
+typedef struct {
+    const uint8_t* ptr; // start of the text, or 0 if no text is queued
+    size_t size;        // size of the text in bytes
+    size_t pos;         // read position of the next character
+    int key;            // currently pressed key code, or 0
+    uint32_t delay_us;  // time until the next key press or release
+} chips_text_input_t;
+
+/*
+    IO port select table, embedded in system state structs.
+
+    Maps an 8-bit IO port address (usually the lower 8 bits of the
+    address bus, or the upper 8 bits on systems which decode those)
+    to a bit mask of selected devices. A system fills the table once
+    during initialization with chips_iomap_add() (one bit per device
+    with the device's address mask and match value), and the tick
+    function replaces the mask/compare chain for each device with a
+    single table lookup per IO request. Several devices may be selected
+    by the same port on partially decoded IO ranges.
+*/
+typedef struct {
+    uint8_t sel[256];
+} chips_iomap_t;
+
+/*
+    Streaming snapshots, a portable alternative to the in-memory snapshot
+    images of the *_save_snapshot() functions, for instance to write the
+    emulator state incrementally into a file or network connection.
+
+    A stream starts with a header (magic, format version and system tag),
+    followed by a sequence of tagged sections, and ends with an end-of-stream
+    section. Each section has a 12-byte header (tag, section version, flags
+    and payload size). All values are stored in little-endian byte order,
+    independent from the compiler's struct layout.
+
+    Field sections (chips_stream_begin() / chips_stream_end()) contain
+    explicitly encoded fields in a fixed order. The fields are written
+    and read by the same function (e.g. z80_stream()) and are assembled
+    in a caller-provided scratch buffer, which is passed to the sink in
+    one piece. New fields must only be appended to a section: when
+    loading, trailing payload bytes which aren't read are ignored, and
+    missing trailing fields are loaded as zero.
+
+    Blob sections (chips_stream_blob()) stream large memory blocks like
+    RAM, ROMs or framebuffers directly from and into their location in
+    the system state. Blob classes in the 'skip' mask are stored as empty
+    placeholders, which leave the destination memory untouched when
+    loading.
+
+    When loading, sections with unexpected tags are skipped until the
+    expected tag is found, so that newer streams may contain additional
+    sections. Errors (sink/source errors, a scratch buffer overflow, a
+    wrong header or a missing section) are sticky, once an error has
+    happened all functions return false.
+*/
+#define CHIPS_STREAM_MAGIC          (0x53534843)    // 'CHSS'
+#define CHIPS_STREAM_FORMAT_VERSION (1)
+#define CHIPS_STREAM_TAG(a,b,c,d)   ((uint32_t)(a)|((uint32_t)(b)<<8)|((uint32_t)(c)<<16)|((uint32_t)(d)<<24))
+// blob classes for chips_stream_blob() and chips_stream_desc_t.skip
+#define CHIPS_STREAM_RAM            (1<<0)
+#define CHIPS_STREAM_ROM            (1<<1)
+#define CHIPS_STREAM_FRAMEBUFFER    (1<<2)
+
+// stream sink and source callbacks, return false on error
+typedef bool (*chips_stream_write_t)(const void* ptr, size_t num_bytes, void* user_data);
+typedef bool (*chips_stream_read_t)(void* ptr, size_t num_bytes, void* user_data);
+
+typedef struct {
+    chips_stream_write_t write;     // the sink when saving
+    chips_stream_read_t read;       // the source when loading (set either write or read)
+    void* user_data;                // passed to the write/read callback
+    chips_range_t scratch;          // buffer for the payload of one field section
+    uint32_t skip;                  // CHIPS_STREAM_* blob classes which are not saved
+} chips_stream_desc_t;
+
+typedef struct {
+    chips_stream_write_t write;
+    chips_stream_read_t read;
+    void* user_data;
+    uint8_t* buf;                   // scratch buffer
+    size_t buf_size;
+    size_t pos;                     // read/write position in the current field section
+    size_t len;                     // number of payload bytes in scratch buffer when loading
+    uint32_t skip;
+    uint32_t tag;                   // tag of the current section when saving
+    uint8_t version;                // the stored version of the current section
+    bool loading;
+    bool error;
+} chips_stream_t;
+
+/*
+    Fast non-cryptographic state hashing for the *_state_hash() functions
+    (e.g. to detect desyncs between netplay peers by comparing a hash per
+    frame).
+
+    A state hash only covers emulation-relevant state (CPU and chip
+    registers, RAM), but not host pointers, callbacks, framebuffers,
+    audio sample buffers or debugging state, so that two emulator
+    instances in the same emulation state produce the same hash even if
+    they live at different host addresses.
+
+    Chips without host pointers are hashed as a whole with CHIPS_HASH(),
+    chips with host pointers have a *_hash() function which hashes all
+    other members.
+
+    Large RAM areas are hashed incrementally: chips_page_hashes_update()
+    only rehashes 1 KByte pages which have their dirty bit set in a
+    mem_t dirty bit mask (see mem_track_dirty()), and combines cached
+    per-page hashes for all other pages.
+*/
+#define CHIPS_HASH_SEED (0xCBF29CE484222325ULL)
+#define CHIPS_HASH_PAGE_SIZE (1024)     // same as the mem_t dirty page size
+#define CHIPS_HASH_MAX_PAGES (256)
+// hash a value or struct without host pointers
+#define CHIPS_HASH(h, val) chips_hash((h), &(val), sizeof(val))
+
+// incrementally updated per-page hashes of a memory region
+typedef struct {
+    bool valid;                 // if false, all pages are rehashed on the next update
+    uint64_t pages[CHIPS_HASH_MAX_PAGES];
+} chips_page_hashes_t;
+
+/*
+    Optional per-subsystem tick profiling, only compiled in when CHIPS_PROFILE
+    is defined (otherwise the CHIPS_PROFILE_* macros compile to nothing).
+
+    Every CHIPS_PROFILE_INTERVAL-th tick is sampled: the system reads the
+    host CPU's timestamp counter at the start of the tick and after each
+    subsystem (CHIPS_PROFILE_MARK), and charges the elapsed host cycles to
+    that subsystem. Dividing the accumulated cycles by the number of sampled
+    ticks gives the average host cycles per emulated tick for each subsystem
+    (this includes the cost of the timestamp reads, so treat them as
+    relative numbers). Chip accesses are counted on each tick
+    (CHIPS_PROFILE_COUNT), and the system's exec functions record the host
+    cycles spent per call.
+*/
+#define CHIPS_PROFILE_MAX_SECTIONS (8)
+#define CHIPS_PROFILE_MAX_COUNTERS (8)
+#ifndef CHIPS_PROFILE_INTERVAL
+#define CHIPS_PROFILE_INTERVAL (64)
+#endif
+#if defined(CHIPS_PROFILE)
+typedef struct {
+    int num_sections;
+    int num_counters;
+    const char* section_names[CHIPS_PROFILE_MAX_SECTIONS];  // static strings
+    const char* counter_names[CHIPS_PROFILE_MAX_COUNTERS];
+    uint32_t countdown;         // ticks until next sampled tick
+    bool active;                // true while in a sampled tick
+    uint64_t last_tsc;          // timestamp of the last mark in the current sampled tick
+    uint64_t exec_tsc;          // timestamp at start of current exec call
+    uint64_t section_cycles[CHIPS_PROFILE_MAX_SECTIONS];   // accumulated host cycles in sampled ticks
+    uint64_t counters[CHIPS_PROFILE_MAX_COUNTERS];         // accumulated access counts
+    uint64_t sampled_ticks;     // number of sampled ticks
+    uint64_t ticks;             // number of ticks executed in exec calls
+    uint64_t exec_calls;        // number of exec calls
+    uint64_t exec_cycles;       // accumulated host cycles in exec calls
+    uint64_t last_exec_cycles;  // host cycles of the last exec call
+    uint32_t last_exec_ticks;   // number of ticks in the last exec call
+} chips_profile_t;
+#endif
+
+#if defined(CHIPS_HEADLESS)
+#define CHIPS_HEADLESS_SKIP(skip) (true)
+#else
+#define CHIPS_HEADLESS_SKIP(skip) (skip)
+#endif
+
+// clear all bits in a breakpoint map (and every_op/every_tick)
+void chips_breakmap_clear(chips_breakmap_t* map);
+
+// set a bit in a breakpoint bit array (exec, read or write)
+static inline void chips_breakmap_set(uint32_t* bits, uint16_t addr) {
+    bits[addr >> 5] |= 1U << (addr & 31);
+}
+// test a bit in a breakpoint bit array (exec, read or write)
+static inline bool chips_breakmap_test(const uint32_t* bits, uint16_t addr) {
+    return 0 != (bits[addr >> 5] & (1U << (addr & 31)));
+}
+// called by a system's exec loop to check whether a tick must be forwarded to the debug callback
+static inline bool chips_breakmap_hit(const chips_breakmap_t* map, uint16_t addr, bool op_done, bool mem_rd, bool mem_wr) {
+    return map->every_tick
+        || (op_done && (map->every_op || chips_breakmap_test(map->exec, addr)))
+        || (mem_rd && chips_breakmap_test(map->read, addr))
+        || (mem_wr && chips_breakmap_test(map->write, addr));
+}
+
+// clear all entries in an IO port select table
+void chips_iomap_clear(chips_iomap_t* map);
+// add device select bits to all ports where (port & mask) == match
+void chips_iomap_add(chips_iomap_t* map, uint8_t mask, uint8_t match, uint8_t dev_bits);
+// get the device select bits for an IO port
+static inline uint8_t chips_iomap_select(const chips_iomap_t* map, uint8_t port) {
+    return map->sel[port];
+}
+
+// mark all framebuffer rows as dirty
+void chips_dirty_lines_set_all(chips_dirty_lines_t* dirty);
+// clear all dirty row bits
+void chips_dirty_lines_clear(chips_dirty_lines_t* dirty);
+// mark rows dirty if their hash differs from the previous call (for decoders that redraw entire frames)
+void chips_dirty_lines_update_hashed(chips_dirty_lines_t* dirty, uint64_t* row_hashes, const void* fb, size_t row_bytes, size_t num_rows);
+// mark a framebuffer row as dirty
+static inline void chips_dirty_lines_set(chips_dirty_lines_t* dirty, size_t y) {
+    dirty->bits[y >> 5] |= 1U << (y & 31);
+}
+// test if a framebuffer row is dirty
+static inline bool chips_dirty_lines_test(const chips_dirty_lines_t* dirty, size_t y) {
+    return 0 != (dirty->bits[y >> 5] & (1U << (y & 31)));
+}
+// copy pixels into framebuffer row y, and mark the row dirty if the pixels have changed
+static inline void chips_dirty_lines_copy(chips_dirty_lines_t* dirty, size_t y, void* dst, const void* src, size_t num_bytes) {
+    if (0 != memcmp(dst, src, num_bytes)) {
+        memcpy(dst, src, num_bytes);
+        chips_dirty_lines_set(dirty, y);
+    }
+}
+
+// called at the start of a system's exec function, returns true if pixel writes are skipped
+static inline bool chips_headless_update(chips_headless_t* h) {
+    if (!h->enabled) {
+        h->skip = false;
+    }
+    else if ((h->interval > 0) && (++h->counter >= h->interval)) {
+        h->counter = 0;
+        h->skip = false;
+    }
+    else {
+        h->skip = true;
+    }
+    h->skip = CHIPS_HEADLESS_SKIP(h->skip);
+    return h->skip;
+}
+
+// called by systems with the video chip's frame counter, invokes the vblank callback when a new frame has started
+static inline void chips_vblank_update(chips_vblank_t* vb, uint32_t frame_count) {
+    if (frame_count != vb->frame_count) {
+        vb->frame_count = frame_count;
+        if (vb->callback.func) {
+            vb->callback.func(vb->callback.user_data);
+        }
+    }
+}
+
+// called by systems at a frame boundary which isn't tracked by a frame counter
+static inline void chips_vblank_notify(chips_vblank_t* vb) {
+    vb->frame_count++;
+    if (vb->callback.func) {
+        vb->callback.func(vb->callback.user_data);
+    }
+}
+
+// number of slices the system's exec function runs in turbo mode
+static inline uint32_t chips_turbo_slices(const chips_turbo_t* t) {
+    return (t->factor > 1) ? t->factor : 1;
+}
+
+// called at the end of a system's exec function with the executed and the requested number of ticks
+static inline void chips_turbo_done(chips_turbo_t* t, uint32_t ticks, uint32_t requested_ticks) {
+    t->skip = false;
+    t->speed = (requested_ticks > 0) ? ((float)ticks / (float)requested_ticks) : 0.0f;
+}
+
+#if defined(_MSC_VER)
+#define _CHIPS_ATOMIC_LOAD(p) ((uint32_t)_InterlockedOr((volatile long*)(p), 0))
+#define _CHIPS_ATOMIC_STORE(p, v) _InterlockedExchange((volatile long*)(p), (long)(v))
+#define _CHIPS_ATOMIC_EXCHANGE(p, v) ((uint32_t)_InterlockedExchange((volatile long*)(p), (long)(v)))
+#else
+#define _CHIPS_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define _CHIPS_ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define _CHIPS_ATOMIC_EXCHANGE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#endif
+
+// initialize an audio ring with a caller-provided buffer (num_samples must be a power of 2)
+void chips_audio_ring_init(chips_audio_ring_t* ring, float* buffer, uint32_t num_samples);
+// consumer: pull up to num_samples samples, returns number of samples actually copied
+int chips_audio_ring_pull(chips_audio_ring_t* ring, float* dst, int num_samples);
+// number of samples currently in the ring (safe to call from producer and consumer)
+static inline uint32_t chips_audio_ring_count(chips_audio_ring_t* ring) {
+    return _CHIPS_ATOMIC_LOAD(&ring->write_pos) - _CHIPS_ATOMIC_LOAD(&ring->read_pos);
+}
+// producer: write a single sample, drops the sample if the ring is full
+static inline void chips_audio_ring_put(chips_audio_ring_t* ring, float sample) {
+    const uint32_t wp = ring->write_pos;
+    if ((wp - _CHIPS_ATOMIC_LOAD(&ring->read_pos)) < ring->num_samples) {
+        ring->buffer[wp & (ring->num_samples - 1)] = sample;
+        _CHIPS_ATOMIC_STORE(&ring->write_pos, wp + 1);
+    }
+    else {
+        ring->overflows++;
+    }
+}
+// system audio output: write a sample into the attached ring, or collect it in the sample buffer and invoke the callback when the buffer is full
+static inline void chips_audio_put(const chips_audio_callback_t* cb, float* sample_buffer, int num_samples, int* sample_pos, float sample, uint64_t tick) {
+    if (cb->ring) {
+        chips_audio_ring_put(cb->ring, sample);
+    }
+    else {
+        sample_buffer[(*sample_pos)++] = sample;
+        if (*sample_pos == num_samples) {
+            if (cb->timed_func) {
+                cb->timed_func(sample_buffer, num_samples, tick, cb->user_data);
+            }
+            else if (cb->func) {
+                cb->func(sample_buffer, num_samples, cb->user_data);
+            }
+            *sample_pos = 0;
+        }
+    }
+}
+
+// initialize a triple buffer with 3 caller-provided buffers of (at least) size bytes each
+void chips_triple_buffer_init(chips_triple_buffer_t* tb, void* buf0, void* buf1, void* buf2, size_t size);
+// producer: publish the finished back buffer, returns the next buffer to decode into
+uint8_t* chips_triple_buffer_publish(chips_triple_buffer_t* tb);
+// consumer: get the most recently published frame (the same as in the last call if no new frame is available)
+const uint8_t* chips_triple_buffer_acquire(chips_triple_buffer_t* tb);
+// producer: the buffer currently being decoded into
+static inline uint8_t* chips_triple_buffer_back(chips_triple_buffer_t* tb) {
+    return tb->buffers[tb->back];
+}
+// consumer: the system tick at which the frame returned by the last chips_triple_buffer_acquire() was published
+static inline uint64_t chips_triple_buffer_tick(const chips_triple_buffer_t* tb) {
+    return tb->ticks[tb->front];
+}
+// consumer: true if a new frame has been published since the last call to chips_triple_buffer_acquire()
+static inline bool chips_triple_buffer_has_new(chips_triple_buffer_t* tb) {
+    return 0 != (_CHIPS_ATOMIC_LOAD(&tb->middle) & CHIPS_TRIPLE_BUFFER_FRESH);
+}
+
+// initialize a video log with a caller-provided buffer for the video memory copy
+void chips_vidlog_init(chips_vidlog_t* log, void* vram, size_t vram_size);
+// set a video memory range which is copied into vram when a frame is published (called by systems)
+void chips_vidlog_set_range(chips_vidlog_t* log, int index, const void* ptr, size_t size);
+// copy the video memory ranges and publish the frame in progress (called by video chips)
+void chips_vidlog_publish(chips_vidlog_t* log);
+// record a video register write at a beam position
+static inline void chips_vidlog_write(chips_vidlog_t* log, uint16_t x, uint16_t y, uint8_t reg, uint8_t val) {
+    log->regs[reg & (CHIPS_VIDLOG_MAX_REGS-1)] = val;
+    chips_vidlog_frame_t* frame = &log->frames[log->frame_count & 1];
+    if (frame->num_events < CHIPS_VIDLOG_MAX_EVENTS) {
+        chips_vidlog_event_t* ev = &frame->events[frame->num_events++];
+        ev->x = x;
+        ev->y = y;
+        ev->reg = reg;
+        ev->val = val;
+    } else {
+        frame->overflow = true;
+    }
+}
+// get the last published frame, or null if no frame has been published yet
+static inline const chips_vidlog_frame_t* chips_vidlog_last(const chips_vidlog_t* log) {
+    return (log->frame_count > 0) ? &log->frames[(log->frame_count + 1) & 1] : 0;
+}
+
+// initialize the scheduler with the number of used slots, these are due on the first tick
+void chips_sched_init(chips_sched_t* sched, int num_slots);
+// advance the scheduler by one tick, call at the end of each system tick
+static inline void chips_sched_tick(chips_sched_t* sched) {
+    sched->now++;
+}
+// true if any slot is due in the current tick
+static inline bool chips_sched_any_due(const chips_sched_t* sched) {
+    return sched->now >= sched->next;
+}
+// true if a slot needs to be ticked in the current tick
+static inline bool chips_sched_due(const chips_sched_t* sched, int slot) {
+    return sched->now >= sched->due[slot];
+}
+// return the number of skipped ticks a slot must catch up with, and mark it as synced
+static inline uint32_t chips_sched_sync(chips_sched_t* sched, int slot) {
+    const uint32_t num_ticks = (uint32_t)(sched->now - sched->synced[slot]);
+    sched->synced[slot] = sched->now;
+    return num_ticks;
+}
+// call after ticking a slot's chip in the current tick, the chip can be skipped for the next idle_ticks ticks
+static inline void chips_sched_set(chips_sched_t* sched, int slot, uint32_t idle_ticks) {
+    sched->synced[slot] = sched->now + 1;
+    sched->due[slot] = sched->now + 1 + idle_ticks;
+    uint64_t next = sched->due[0];
+    for (int i = 1; i < CHIPS_SCHED_MAX_SLOTS; i++) {
+        if (sched->due[i] < next) {
+            next = sched->due[i];
+        }
+    }
+    sched->next = next;
+}
+
+// insert a caller-owned tape (concatenated tape files) and rewind it
+void chips_tape_insert(chips_tape_t* tape, chips_range_t data);
+// remove the tape
+void chips_tape_remove(chips_tape_t* tape);
+// the remaining tape data starting at the read position (size 0 if empty or no tape inserted)
+static inline chips_range_t chips_tape_remaining(const chips_tape_t* tape) {
+    chips_range_t res = { 0, 0 };
+    if (tape->ptr && (tape->pos < tape->size)) {
+        res.ptr = (void*)(tape->ptr + tape->pos);
+        res.size = tape->size - tape->pos;
+    }
+    return res;
+}
+// advance the read position by num_bytes (clamped to the end of the tape)
+static inline void chips_tape_skip(chips_tape_t* tape, size_t num_bytes) {
+    tape->pos = ((tape->pos + num_bytes) < tape->size) ? (tape->pos + num_bytes) : tape->size;
+}
+
+// queue a caller-owned text, replaces any text which is still queued
+void chips_text_input_start(chips_text_input_t* ti, chips_range_t text);
+// stop typing and drop the rest of the text (a key which is still pressed must be released by the system)
+void chips_text_input_stop(chips_text_input_t* ti);
+// return true if characters are left in the queue
+static inline bool chips_text_input_pending(const chips_text_input_t* ti) {
+    return ti->ptr && (ti->pos < ti->size);
+}
+// return the next character and advance the read position, or -1 if the queue is empty
+static inline int chips_text_input_next(chips_text_input_t* ti) {
+    return chips_text_input_pending(ti) ? ti->ptr[ti->pos++] : -1;
+}
+
+// initialize a streaming snapshot writer or reader
+void chips_stream_init(chips_stream_t* s, const chips_stream_desc_t* desc);
+// write or check the stream header
+bool chips_stream_header(chips_stream_t* s, uint32_t system_tag);
+// start a field section, when loading s->version holds the stored section version
+bool chips_stream_begin(chips_stream_t* s, uint32_t tag, uint8_t version);
+// finish a field section (when saving, this writes the section to the sink)
+bool chips_stream_end(chips_stream_t* s);
+// save or load a blob section
+bool chips_stream_blob(chips_stream_t* s, uint32_t tag, uint32_t blob_class, void* ptr, size_t num_bytes);
+// write or skip to the end-of-stream section
+bool chips_stream_finish(chips_stream_t* s);
+// save or load fields in a field section
+void chips_stream_bytes(chips_stream_t* s, void* ptr, size_t num_bytes);
+void chips_stream_u8(chips_stream_t* s, uint8_t* v);
+void chips_stream_u16(chips_stream_t* s, uint16_t* v);
+void chips_stream_u32(chips_stream_t* s, uint32_t* v);
+void chips_stream_u64(chips_stream_t* s, uint64_t* v);
+void chips_stream_bool(chips_stream_t* s, bool* v);
+void chips_stream_int(chips_stream_t* s, int* v);
+// true if no error has happened
+static inline bool chips_stream_ok(const chips_stream_t* s) {
+    return !s->error;
+}
+
+// continue a hash with a range of bytes
+uint64_t chips_hash(uint64_t h, const void* ptr, size_t num_bytes);
+// rehash dirty pages (all pages if ph->valid is false), and continue a hash with all page hashes
+uint64_t chips_page_hashes_update(chips_page_hashes_t* ph, uint64_t h, const void* ptr, size_t num_bytes, const uint32_t* dirty_bits);
+// force a full rehash on the next update (call after writes which bypass dirty tracking)
+static inline void chips_page_hashes_invalidate(chips_page_hashes_t* ph) {
+    ph->valid = false;
+}
+
+#if defined(CHIPS_PROFILE)
+// initialize profiling state with null-terminated arrays of section and counter names (static strings)
+void chips_profile_init(chips_profile_t* prof, const char* const* section_names, const char* const* counter_names);
+// clear the accumulated profiling results (keeps the names)
+void chips_profile_reset(chips_profile_t* prof);
+// read the host CPU's timestamp counter
+static inline uint64_t chips_profile_tsc(void) {
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+    #elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+    #elif defined(__aarch64__)
+    uint64_t val;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+    #else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    #endif
+}
+// called at the start of each tick, decides whether the tick is sampled
+static inline void chips_profile_tick_begin(chips_profile_t* prof) {
+    if (--prof->countdown == 0) {
+        prof->countdown = CHIPS_PROFILE_INTERVAL;
+        prof->active = true;
+        prof->last_tsc = chips_profile_tsc();
+    }
+}
+// charge the host cycles since the last mark to a section
+static inline void chips_profile_mark(chips_profile_t* prof, int section) {
+    if (prof->active) {
+        const uint64_t tsc = chips_profile_tsc();
+        prof->section_cycles[section] += tsc - prof->last_tsc;
+        prof->last_tsc = tsc;
+    }
+}
+// called at the end of each tick, charges the remaining cycles to a section
+static inline void chips_profile_tick_end(chips_profile_t* prof, int section) {
+    if (prof->active) {
+        chips_profile_mark(prof, section);
+        prof->sampled_ticks++;
+        prof->active = false;
+    }
+}
+// called at the start and end of a system's exec function
+static inline void chips_profile_exec_begin(chips_profile_t* prof) {
+    prof->exec_tsc = chips_profile_tsc();
+}
+static inline void chips_profile_exec_end(chips_profile_t* prof, uint32_t num_ticks) {
+    const uint64_t cycles = chips_profile_tsc() - prof->exec_tsc;
+    prof->exec_calls++;
+    prof->exec_cycles += cycles;
+    prof->last_exec_cycles = cycles;
+    prof->last_exec_ticks = num_ticks;
+    prof->ticks += num_ticks;
+}
+#define CHIPS_PROFILE_TICK_BEGIN(prof) chips_profile_tick_begin(prof)
+#define CHIPS_PROFILE_MARK(prof, section) chips_profile_mark((prof), (section))
+#define CHIPS_PROFILE_TICK_END(prof, section) chips_profile_tick_end((prof), (section))
+#define CHIPS_PROFILE_COUNT(prof, counter) ((prof)->counters[counter]++)
+#define CHIPS_PROFILE_EXEC_BEGIN(prof) chips_profile_exec_begin(prof)
+#define CHIPS_PROFILE_EXEC_END(prof, num_ticks) chips_profile_exec_end((prof), (num_ticks))
+#else
+#define CHIPS_PROFILE_TICK_BEGIN(prof) ((void)0)
+#define CHIPS_PROFILE_MARK(prof, section) ((void)0)
+#define CHIPS_PROFILE_TICK_END(prof, section) ((void)0)
+#define CHIPS_PROFILE_COUNT(prof, counter) ((void)0)
+#define CHIPS_PROFILE_EXEC_BEGIN(prof) ((void)0)
+#define CHIPS_PROFILE_EXEC_END(prof, num_ticks) ((void)0)
+#endif
+
 // prepare chips_audio_t snapshot for saving
 void chips_audio_callback_snapshot_onsave(chips_audio_callback_t* snapshot);
 // fixup chips_audio_t snapshot after loading
 void chips_audio_callback_snapshot_onload(chips_audio_callback_t* snapshot, chips_audio_callback_t* sys);
+// prepare chips_vblank_t snapshot for saving
+void chips_vblank_snapshot_onsave(chips_vblank_t* snapshot);
+// fixup chips_vblank_t snapshot after loading
+void chips_vblank_snapshot_onload(chips_vblank_t* snapshot, chips_vblank_t* sys);
 // prepare chips_debut_t snapshot for saving
 void chips_debug_snapshot_onsave(chips_debug_t* snapshot);
 // fixup chips_debug_t snapshot after loading
 void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys);
+// prepare chips_tape_t snapshot for saving
+void chips_tape_snapshot_onsave(chips_tape_t* snapshot);
+// fixup chips_tape_t snapshot after loading (keeps the currently inserted tape)
+void chips_tape_snapshot_onload(chips_tape_t* snapshot, chips_tape_t* sys);
+// prepare chips_text_input_t snapshot for saving
+void chips_text_input_snapshot_onsave(chips_text_input_t* snapshot);
+// fixup chips_text_input_t snapshot after loading (keeps the currently queued text)
+void chips_text_input_snapshot_onload(chips_text_input_t* snapshot, chips_text_input_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -90,27 +955,581 @@ void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys);
 
 /*--- IMPLEMENTATION ---------------------------------------------------------*/
 #ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void chips_breakmap_clear(chips_breakmap_t* map) {
+    memset(map, 0, sizeof(chips_breakmap_t));
+}
+
+void chips_iomap_clear(chips_iomap_t* map) {
+    memset(map, 0, sizeof(chips_iomap_t));
+}
+
+void chips_iomap_add(chips_iomap_t* map, uint8_t mask, uint8_t match, uint8_t dev_bits) {
+    CHIPS_ASSERT(map && ((match & mask) == match));
+    for (int port = 0; port < 256; port++) {
+        if ((port & mask) == match) {
+            map->sel[port] |= dev_bits;
+        }
+    }
+}
+
+void chips_sched_init(chips_sched_t* sched, int num_slots) {
+    CHIPS_ASSERT(sched && (num_slots >= 0) && (num_slots <= CHIPS_SCHED_MAX_SLOTS));
+    memset(sched, 0, sizeof(chips_sched_t));
+    for (int i = num_slots; i < CHIPS_SCHED_MAX_SLOTS; i++) {
+        sched->due[i] = UINT64_MAX;
+    }
+}
+
+void chips_dirty_lines_set_all(chips_dirty_lines_t* dirty) {
+    memset(dirty, 0xFF, sizeof(chips_dirty_lines_t));
+}
+
+void chips_dirty_lines_clear(chips_dirty_lines_t* dirty) {
+    memset(dirty, 0, sizeof(chips_dirty_lines_t));
+}
+
+void chips_dirty_lines_update_hashed(chips_dirty_lines_t* dirty, uint64_t* row_hashes, const void* fb, size_t row_bytes, size_t num_rows) {
+    CHIPS_ASSERT(num_rows <= CHIPS_DIRTY_MAX_LINES);
+    CHIPS_ASSERT((row_bytes & 7) == 0);
+    const uint8_t* row = (const uint8_t*) fb;
+    for (size_t y = 0; y < num_rows; y++, row += row_bytes) {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (size_t i = 0; i < row_bytes; i += 8) {
+            uint64_t v;
+            memcpy(&v, row + i, 8);
+            h = (h ^ v) * 0x100000001B3ULL;
+            h ^= h >> 29;
+        }
+        if (h != row_hashes[y]) {
+            row_hashes[y] = h;
+            chips_dirty_lines_set(dirty, y);
+        }
+    }
+}
+
+void chips_audio_ring_init(chips_audio_ring_t* ring, float* buffer, uint32_t num_samples) {
+    CHIPS_ASSERT(ring && buffer);
+    CHIPS_ASSERT((num_samples > 0) && ((num_samples & (num_samples - 1)) == 0));
+    memset(ring, 0, sizeof(chips_audio_ring_t));
+    ring->buffer = buffer;
+    ring->num_samples = num_samples;
+}
+
+int chips_audio_ring_pull(chips_audio_ring_t* ring, float* dst, int num_samples) {
+    CHIPS_ASSERT(ring && dst && (num_samples >= 0));
+    const uint32_t rp = ring->read_pos;
+    const uint32_t avail = _CHIPS_ATOMIC_LOAD(&ring->write_pos) - rp;
+    const uint32_t num = ((uint32_t)num_samples < avail) ? (uint32_t)num_samples : avail;
+    const uint32_t mask = ring->num_samples - 1;
+    // copy in at most two chunks, before and after the buffer wraps around
+    const uint32_t start = rp & mask;
+    const uint32_t num0 = ((start + num) > ring->num_samples) ? (ring->num_samples - start) : num;
+    memcpy(dst, ring->buffer + start, num0 * sizeof(float));
+    memcpy(dst + num0, ring->buffer, (num - num0) * sizeof(float));
+    _CHIPS_ATOMIC_STORE(&ring->read_pos, rp + num);
+    return (int)num;
+}
+
+void chips_triple_buffer_init(chips_triple_buffer_t* tb, void* buf0, void* buf1, void* buf2, size_t size) {
+    CHIPS_ASSERT(tb && buf0 && buf1 && buf2 && (size > 0));
+    memset(tb, 0, sizeof(chips_triple_buffer_t));
+    tb->buffers[0] = (uint8_t*) buf0;
+    tb->buffers[1] = (uint8_t*) buf1;
+    tb->buffers[2] = (uint8_t*) buf2;
+    tb->size = size;
+    tb->back = 0;
+    tb->middle = 1;
+    tb->front = 2;
+}
+
+uint8_t* chips_triple_buffer_publish(chips_triple_buffer_t* tb) {
+    CHIPS_ASSERT(tb);
+    // swap the finished back buffer with the shared buffer, which is either
+    // the last published frame (dropped if not acquired yet), or the buffer
+    // the consumer has released
+    if (tb->clock) {
+        tb->ticks[tb->back] = *tb->clock;
+    }
+    const uint32_t prev = _CHIPS_ATOMIC_EXCHANGE(&tb->middle, tb->back | CHIPS_TRIPLE_BUFFER_FRESH);
+    tb->back = prev & ~CHIPS_TRIPLE_BUFFER_FRESH;
+    return tb->buffers[tb->back];
+}
+
+const uint8_t* chips_triple_buffer_acquire(chips_triple_buffer_t* tb) {
+    CHIPS_ASSERT(tb);
+    if (chips_triple_buffer_has_new(tb)) {
+        // swap the released front buffer with the newly published frame
+        const uint32_t prev = _CHIPS_ATOMIC_EXCHANGE(&tb->middle, tb->front);
+        tb->front = prev & ~CHIPS_TRIPLE_BUFFER_FRESH;
+    }
+    return tb->buffers[tb->front];
+}
+
+void chips_vidlog_init(chips_vidlog_t* log, void* vram, size_t vram_size) {
+    CHIPS_ASSERT(log && vram && (vram_size > 0));
+    memset(log, 0, sizeof(chips_vidlog_t));
+    log->vram.ptr = vram;
+    log->vram.size = vram_size;
+}
+
+void chips_vidlog_set_range(chips_vidlog_t* log, int index, const void* ptr, size_t size) {
+    CHIPS_ASSERT(log && (index >= 0) && (index < CHIPS_VIDLOG_MAX_RANGES));
+    log->ranges[index].ptr = (void*) ptr;
+    log->ranges[index].size = size;
+    if (index >= log->num_ranges) {
+        log->num_ranges = index + 1;
+    }
+}
+
+void chips_vidlog_publish(chips_vidlog_t* log) {
+    CHIPS_ASSERT(log);
+    uint8_t* dst = (uint8_t*) log->vram.ptr;
+    size_t pos = 0;
+    for (int i = 0; i < log->num_ranges; i++) {
+        const chips_range_t* r = &log->ranges[i];
+        CHIPS_ASSERT((pos + r->size) <= log->vram.size);
+        if (r->ptr) {
+            memcpy(dst + pos, r->ptr, r->size);
+        } else {
+            memset(dst + pos, 0xFF, r->size);
+        }
+        pos += r->size;
+    }
+    log->frame_count++;
+    chips_vidlog_frame_t* frame = &log->frames[log->frame_count & 1];
+    frame->frame = log->frame_count;
+    frame->num_events = 0;
+    frame->overflow = false;
+    memcpy(frame->regs, log->regs, sizeof(frame->regs));
+}
 
 void chips_audio_callback_snapshot_onsave(chips_audio_callback_t* snapshot) {
     snapshot->func = 0;
     snapshot->user_data = 0;
+    snapshot->ring = 0;
+    snapshot->timed_func = 0;
 }
 
 void chips_audio_callback_snapshot_onload(chips_audio_callback_t* snapshot, chips_audio_callback_t* sys) {
     snapshot->func = sys->func;
     snapshot->user_data = sys->user_data;
+    snapshot->ring = sys->ring;
+    snapshot->timed_func = sys->timed_func;
+}
+
+void chips_vblank_snapshot_onsave(chips_vblank_t* snapshot) {
+    snapshot->callback.func = 0;
+    snapshot->callback.user_data = 0;
+}
+
+void chips_vblank_snapshot_onload(chips_vblank_t* snapshot, chips_vblank_t* sys) {
+    snapshot->callback = sys->callback;
 }
 
 void chips_debug_snapshot_onsave(chips_debug_t* snapshot) {
     snapshot->callback.func = 0;
     snapshot->callback.user_data = 0;
     snapshot->stopped = 0;
+    snapshot->breakmap = 0;
 }
 
 void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys) {
     snapshot->callback.func = sys->callback.func;
     snapshot->callback.user_data = sys->callback.user_data;
     snapshot->stopped = sys->stopped;
+    snapshot->breakmap = sys->breakmap;
+}
+
+void chips_tape_insert(chips_tape_t* tape, chips_range_t data) {
+    CHIPS_ASSERT(tape && data.ptr && (data.size > 0));
+    tape->ptr = (const uint8_t*)data.ptr;
+    tape->size = data.size;
+    tape->pos = 0;
+}
+
+void chips_tape_remove(chips_tape_t* tape) {
+    CHIPS_ASSERT(tape);
+    tape->ptr = 0;
+    tape->size = 0;
+    tape->pos = 0;
+}
+
+void chips_tape_snapshot_onsave(chips_tape_t* snapshot) {
+    snapshot->ptr = 0;
+}
+
+void chips_tape_snapshot_onload(chips_tape_t* snapshot, chips_tape_t* sys) {
+    snapshot->ptr = sys->ptr;
+    snapshot->size = sys->size;
+    if (snapshot->pos > snapshot->size) {
+        snapshot->pos = snapshot->size;
+    }
+}
+
+void chips_text_input_start(chips_text_input_t* ti, chips_range_t text) {
+    CHIPS_ASSERT(ti && text.ptr && (text.size > 0));
+    ti->ptr = (const uint8_t*)text.ptr;
+    ti->size = text.size;
+    ti->pos = 0;
+}
+
+void chips_text_input_stop(chips_text_input_t* ti) {
+    CHIPS_ASSERT(ti);
+    ti->ptr = 0;
+    ti->size = 0;
+    ti->pos = 0;
+}
+
+void chips_text_input_snapshot_onsave(chips_text_input_t* snapshot) {
+    snapshot->ptr = 0;
+}
+
+void chips_text_input_snapshot_onload(chips_text_input_t* snapshot, chips_text_input_t* sys) {
+    snapshot->ptr = sys->ptr;
+    snapshot->size = sys->size;
+    if (snapshot->pos > snapshot->size) {
+        snapshot->pos = snapshot->size;
+    }
+}
+
+#define _CHIPS_STREAM_END_TAG      (0)
+#define _CHIPS_STREAM_HEADER_SIZE   (12)
+#define _CHIPS_STREAM_SKIPPED       (1<<0)
+
+void chips_stream_init(chips_stream_t* s, const chips_stream_desc_t* desc) {
+    CHIPS_ASSERT(s && desc && (desc->write || desc->read) && !(desc->write && desc->read));
+    CHIPS_ASSERT(desc->scratch.ptr && (desc->scratch.size >= _CHIPS_STREAM_HEADER_SIZE));
+    memset(s, 0, sizeof(chips_stream_t));
+    s->write = desc->write;
+    s->read = desc->read;
+    s->user_data = desc->user_data;
+    s->buf = (uint8_t*)desc->scratch.ptr;
+    s->buf_size = desc->scratch.size;
+    s->skip = desc->skip;
+    s->loading = 0 != desc->read;
+}
+
+static void _chips_stream_put32(uint8_t* dst, uint32_t v) {
+    dst[0] = (uint8_t)v; dst[1] = (uint8_t)(v>>8); dst[2] = (uint8_t)(v>>16); dst[3] = (uint8_t)(v>>24);
+}
+
+static uint32_t _chips_stream_get32(const uint8_t* src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1]<<8) | ((uint32_t)src[2]<<16) | ((uint32_t)src[3]<<24);
+}
+
+static bool _chips_stream_write(chips_stream_t* s, const void* ptr, size_t num_bytes) {
+    if (!s->error && (num_bytes > 0) && !s->write(ptr, num_bytes, s->user_data)) {
+        s->error = true;
+    }
+    return !s->error;
+}
+
+static bool _chips_stream_read(chips_stream_t* s, void* ptr, size_t num_bytes) {
+    if (!s->error && (num_bytes > 0) && !s->read(ptr, num_bytes, s->user_data)) {
+        s->error = true;
+    }
+    return !s->error;
+}
+
+static bool _chips_stream_write_section_header(chips_stream_t* s, uint32_t tag, uint8_t version, uint8_t flags, uint32_t size) {
+    uint8_t hdr[_CHIPS_STREAM_HEADER_SIZE] = { 0 };
+    _chips_stream_put32(&hdr[0], tag);
+    hdr[4] = version;
+    hdr[5] = flags;
+    _chips_stream_put32(&hdr[8], size);
+    return _chips_stream_write(s, hdr, sizeof(hdr));
+}
+
+// read section headers and skip sections until the expected tag is found
+static bool _chips_stream_seek_section(chips_stream_t* s, uint32_t tag, uint8_t* out_flags, uint32_t* out_size) {
+    while (!s->error) {
+        uint8_t hdr[_CHIPS_STREAM_HEADER_SIZE];
+        if (!_chips_stream_read(s, hdr, sizeof(hdr))) {
+            break;
+        }
+        const uint32_t cur_tag = _chips_stream_get32(&hdr[0]);
+        uint32_t size = _chips_stream_get32(&hdr[8]);
+        if (cur_tag == tag) {
+            s->version = hdr[4];
+            *out_flags = hdr[5];
+            *out_size = size;
+            return true;
+        }
+        if (cur_tag == _CHIPS_STREAM_END_TAG) {
+            // expected section is missing
+            s->error = true;
+            break;
+        }
+        while ((size > 0) && !s->error) {
+            const uint32_t num_bytes = (size > s->buf_size) ? (uint32_t)s->buf_size : size;
+            _chips_stream_read(s, s->buf, num_bytes);
+            size -= num_bytes;
+        }
+    }
+    return false;
+}
+
+bool chips_stream_header(chips_stream_t* s, uint32_t system_tag) {
+    CHIPS_ASSERT(s);
+    uint8_t hdr[12];
+    if (s->loading) {
+        if (_chips_stream_read(s, hdr, sizeof(hdr))) {
+            if ((_chips_stream_get32(&hdr[0]) != CHIPS_STREAM_MAGIC) ||
+                (_chips_stream_get32(&hdr[4]) != CHIPS_STREAM_FORMAT_VERSION) ||
+                (_chips_stream_get32(&hdr[8]) != system_tag))
+            {
+                s->error = true;
+            }
+        }
+        return !s->error;
+    }
+    else {
+        _chips_stream_put32(&hdr[0], CHIPS_STREAM_MAGIC);
+        _chips_stream_put32(&hdr[4], CHIPS_STREAM_FORMAT_VERSION);
+        _chips_stream_put32(&hdr[8], system_tag);
+        return _chips_stream_write(s, hdr, sizeof(hdr));
+    }
+}
+
+bool chips_stream_begin(chips_stream_t* s, uint32_t tag, uint8_t version) {
+    CHIPS_ASSERT(s && (tag != _CHIPS_STREAM_END_TAG));
+    s->pos = 0;
+    s->len = 0;
+    if (s->loading) {
+        uint8_t flags;
+        uint32_t size;
+        if (_chips_stream_seek_section(s, tag, &flags, &size)) {
+            // trailing fields which don't fit into the scratch buffer are unknown anyway
+            s->len = (size > s->buf_size) ? s->buf_size : size;
+            if (_chips_stream_read(s, s->buf, s->len)) {
+                size -= (uint32_t)s->len;
+                while ((size > 0) && !s->error) {
+                    uint8_t junk[64];
+                    const uint32_t num_bytes = (size > sizeof(junk)) ? (uint32_t)sizeof(junk) : size;
+                    _chips_stream_read(s, junk, num_bytes);
+                    size -= num_bytes;
+                }
+            }
+        }
+    }
+    else {
+        // the section header is written in chips_stream_end() when the payload size is known
+        s->tag = tag;
+        s->version = version;
+        s->pos = _CHIPS_STREAM_HEADER_SIZE;
+    }
+    return !s->error;
+}
+
+bool chips_stream_end(chips_stream_t* s) {
+    CHIPS_ASSERT(s);
+    if (!s->loading && !s->error) {
+        memset(s->buf, 0, _CHIPS_STREAM_HEADER_SIZE);
+        _chips_stream_put32(&s->buf[0], s->tag);
+        s->buf[4] = s->version;
+        _chips_stream_put32(&s->buf[8], (uint32_t)(s->pos - _CHIPS_STREAM_HEADER_SIZE));
+        _chips_stream_write(s, s->buf, s->pos);
+    }
+    s->pos = 0;
+    s->len = 0;
+    return !s->error;
+}
+
+bool chips_stream_blob(chips_stream_t* s, uint32_t tag, uint32_t blob_class, void* ptr, size_t num_bytes) {
+    CHIPS_ASSERT(s && ptr && (tag != _CHIPS_STREAM_END_TAG));
+    if (s->loading) {
+        uint8_t flags;
+        uint32_t size;
+        if (_chips_stream_seek_section(s, tag, &flags, &size)) {
+            if (0 == (flags & _CHIPS_STREAM_SKIPPED)) {
+                if (size == num_bytes) {
+                    _chips_stream_read(s, ptr, num_bytes);
+                }
+                else {
+                    s->error = true;
+                }
+            }
+        }
+    }
+    else {
+        if (s->skip & blob_class) {
+            _chips_stream_write_section_header(s, tag, 0, _CHIPS_STREAM_SKIPPED, 0);
+        }
+        else if (_chips_stream_write_section_header(s, tag, 0, 0, (uint32_t)num_bytes)) {
+            _chips_stream_write(s, ptr, num_bytes);
+        }
+    }
+    return !s->error;
+}
+
+bool chips_stream_finish(chips_stream_t* s) {
+    CHIPS_ASSERT(s);
+    if (s->loading) {
+        uint8_t flags;
+        uint32_t size;
+        _chips_stream_seek_section(s, _CHIPS_STREAM_END_TAG, &flags, &size);
+        return !s->error;
+    }
+    else {
+        return _chips_stream_write_section_header(s, _CHIPS_STREAM_END_TAG, 0, 0, 0);
+    }
 }
 
+void chips_stream_bytes(chips_stream_t* s, void* ptr, size_t num_bytes) {
+    CHIPS_ASSERT(s && ptr);
+    if (s->error) {
+        return;
+    }
+    uint8_t* p = (uint8_t*)ptr;
+    if (s->loading) {
+        // missing trailing fields (written by an older version) are loaded as zero
+        size_t num_avail = (s->pos < s->len) ? (s->len - s->pos) : 0;
+        if (num_avail > num_bytes) {
+            num_avail = num_bytes;
+        }
+        memcpy(p, &s->buf[s->pos], num_avail);
+        memset(p + num_avail, 0, num_bytes - num_avail);
+        s->pos += num_bytes;
+    }
+    else {
+        if ((s->pos + num_bytes) > s->buf_size) {
+            s->error = true;
+        }
+        else {
+            memcpy(&s->buf[s->pos], p, num_bytes);
+            s->pos += num_bytes;
+        }
+    }
+}
+
+void chips_stream_u8(chips_stream_t* s, uint8_t* v) {
+    chips_stream_bytes(s, v, 1);
+}
+
+void chips_stream_u16(chips_stream_t* s, uint16_t* v) {
+    uint8_t b[2] = { (uint8_t)*v, (uint8_t)(*v>>8) };
+    chips_stream_bytes(s, b, sizeof(b));
+    *v = (uint16_t)(b[0] | (b[1]<<8));
+}
+
+void chips_stream_u32(chips_stream_t* s, uint32_t* v) {
+    uint8_t b[4];
+    _chips_stream_put32(b, *v);
+    chips_stream_bytes(s, b, sizeof(b));
+    *v = _chips_stream_get32(b);
+}
+
+void chips_stream_u64(chips_stream_t* s, uint64_t* v) {
+    uint32_t lo = (uint32_t)*v;
+    uint32_t hi = (uint32_t)(*v>>32);
+    chips_stream_u32(s, &lo);
+    chips_stream_u32(s, &hi);
+    *v = ((uint64_t)hi<<32) | lo;
+}
+
+void chips_stream_bool(chips_stream_t* s, bool* v) {
+    uint8_t b = *v ? 1 : 0;
+    chips_stream_bytes(s, &b, 1);
+    *v = (b != 0);
+}
+
+void chips_stream_int(chips_stream_t* s, int* v) {
+    uint32_t u = (uint32_t)(int32_t)*v;
+    chips_stream_u32(s, &u);
+    *v = (int)(int32_t)u;
+}
+
+#define _CHIPS_HASH_MUL (0x9E3779B97F4A7C15ULL)
+
+static inline uint64_t _chips_hash_mix(uint64_t h, uint64_t v) {
+    h = (h ^ v) * _CHIPS_HASH_MUL;
+    return h ^ (h >> 32);
+}
+
+uint64_t chips_hash(uint64_t h, const void* ptr, size_t num_bytes) {
+    CHIPS_ASSERT(ptr || (num_bytes == 0));
+    const uint8_t* p = (const uint8_t*) ptr;
+    // 4 independent lanes to hide the multiply latency
+    uint64_t h0 = h, h1 = h + 1, h2 = h + 2, h3 = h + 3;
+    size_t i = 0;
+    for (; (i + 32) <= num_bytes; i += 32) {
+        uint64_t v[4];
+        memcpy(v, p + i, sizeof(v));
+        h0 = _chips_hash_mix(h0, v[0]);
+        h1 = _chips_hash_mix(h1, v[1]);
+        h2 = _chips_hash_mix(h2, v[2]);
+        h3 = _chips_hash_mix(h3, v[3]);
+    }
+    h = _chips_hash_mix(h0, h1);
+    h = _chips_hash_mix(h, h2);
+    h = _chips_hash_mix(h, h3);
+    for (; (i + 8) <= num_bytes; i += 8) {
+        uint64_t v;
+        memcpy(&v, p + i, sizeof(v));
+        h = _chips_hash_mix(h, v);
+    }
+    if (i < num_bytes) {
+        uint64_t v = 0;
+        memcpy(&v, p + i, num_bytes - i);
+        h = _chips_hash_mix(h, v);
+    }
+    return _chips_hash_mix(h, (uint64_t)num_bytes);
+}
+
+uint64_t chips_page_hashes_update(chips_page_hashes_t* ph, uint64_t h, const void* ptr, size_t num_bytes, const uint32_t* dirty_bits) {
+    CHIPS_ASSERT(ph && ptr && dirty_bits);
+    CHIPS_ASSERT((num_bytes % CHIPS_HASH_PAGE_SIZE) == 0);
+    const size_t num_pages = num_bytes / CHIPS_HASH_PAGE_SIZE;
+    CHIPS_ASSERT(num_pages <= CHIPS_HASH_MAX_PAGES);
+    const uint8_t* p = (const uint8_t*) ptr;
+    for (size_t page = 0; page < num_pages; page++) {
+        const uint32_t bits = ph->valid ? dirty_bits[page>>5] : 0xFFFFFFFF;
+        if (0 == bits) {
+            // skip 32 clean pages at once
+            page |= 31;
+        }
+        else if (bits & (1U<<(page & 31))) {
+            ph->pages[page] = chips_hash(CHIPS_HASH_SEED, p + page * CHIPS_HASH_PAGE_SIZE, CHIPS_HASH_PAGE_SIZE);
+        }
+    }
+    ph->valid = true;
+    return chips_hash(h, ph->pages, num_pages * sizeof(uint64_t));
+}
+
+#if defined(CHIPS_PROFILE)
+void chips_profile_init(chips_profile_t* prof, const char* const* section_names, const char* const* counter_names) {
+    CHIPS_ASSERT(prof && section_names && counter_names);
+    memset(prof, 0, sizeof(chips_profile_t));
+    prof->countdown = CHIPS_PROFILE_INTERVAL;
+    while (section_names[prof->num_sections]) {
+        CHIPS_ASSERT(prof->num_sections < CHIPS_PROFILE_MAX_SECTIONS);
+        prof->section_names[prof->num_sections] = section_names[prof->num_sections];
+        prof->num_sections++;
+    }
+    while (counter_names[prof->num_counters]) {
+        CHIPS_ASSERT(prof->num_counters < CHIPS_PROFILE_MAX_COUNTERS);
+        prof->counter_names[prof->num_counters] = counter_names[prof->num_counters];
+        prof->num_counters++;
+    }
+}
+
+void chips_profile_reset(chips_profile_t* prof) {
+    CHIPS_ASSERT(prof);
+    memset(prof->section_cycles, 0, sizeof(prof->section_cycles));
+    memset(prof->counters, 0, sizeof(prof->counters));
+    prof->sampled_ticks = 0;
+    prof->ticks = 0;
+    prof->exec_calls = 0;
+    prof->exec_cycles = 0;
+    prof->last_exec_cycles = 0;
+    prof->last_exec_ticks = 0;
+}
+#endif
+
 #endif // CHIPS_IMPL
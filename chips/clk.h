@@ -25,6 +25,13 @@
     ~~~
         Convert micro-seconds to system ticks.
 
+    ~~~C
+    uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t num_ticks, uint64_t* inout_rem)
+    ~~~
+        Convert system ticks to micro-seconds. If inout_rem isn't null,
+        the fractional part is carried over to the next call, so that
+        the converted durations don't drift against the tick count.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -51,6 +58,8 @@ extern "C" {
 
 // helper func to convert micro_seconds into ticks
 uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds);
+// helper func to convert ticks into micro_seconds, carries the fractional remainder in inout_rem (optional)
+uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t num_ticks, uint64_t* inout_rem);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -66,4 +75,13 @@ uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds);
 uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds) {
     return (uint32_t) ((freq_hz * micro_seconds) / 1000000);
 }
+
+uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t num_ticks, uint64_t* inout_rem) {
+    CHIPS_ASSERT(freq_hz > 0);
+    const uint64_t t = ((uint64_t)num_ticks * 1000000) + (inout_rem ? *inout_rem : 0);
+    if (inout_rem) {
+        *inout_rem = t % freq_hz;
+    }
+    return (uint32_t) (t / freq_hz);
+}
 #endif
@@ -18,8 +18,36 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Optionally define CHIPS_SHARED_DISCS before including fdd.h to remove
+    the embedded disc data buffer from fdd_t (see 'Shared Disc Images'
+    below).
+
     FIXME: DOCS
 
+    ## Shared Disc Images
+
+    By default fdd_insert_disc() copies the disc image data into the
+    fdd_t struct. With fdd_insert_disc_shared() the drive instead
+    references caller-owned image data (for instance a memory-mapped
+    file) without copying. The image data must remain valid and unchanged
+    until the disc is ejected, and is never written to: the first
+    fdd_write() into a sector copies the sector into a small
+    copy-on-write buffer in fdd_t (FDD_MAX_COW_SECTORS sectors), and all
+    later reads and writes of that sector go to the copy. Sector writes
+    fail with FDD_RESULT_NOT_WRITABLE once the copy-on-write buffer is
+    full.
+
+    If CHIPS_SHARED_DISCS is defined, the embedded disc data buffer is
+    removed from fdd_t altogether and only shared discs can be inserted,
+    this shrinks the fdd_t footprint (and the size of system snapshots
+    which embed an fdd_t) by FDD_MAX_DISC_SIZE bytes.
+
+    Call fdd_snapshot_onsave() and fdd_snapshot_onload() when taking and
+    loading snapshots, a snapshot of a drive with a shared disc doesn't
+    contain the disc image, but only the copy-on-write sectors, and on
+    loading continues to reference the disc image which is currently
+    inserted into the target drive.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -40,6 +68,7 @@
 #*/
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,12 +80,17 @@ extern "C" {
 #define FDD_MAX_SECTOR_SIZE (512)   /* max size of a sector in bytes */
 #define FDD_MAX_TRACK_SIZE (FDD_MAX_SECTORS*FDD_MAX_SECTOR_SIZE)
 #define FDD_MAX_DISC_SIZE (FDD_MAX_SIDES*FDD_MAX_TRACKS*FDD_MAX_TRACK_SIZE)
+#define FDD_SECTOR_INDEX_SIZE (16) /* size of per-track sector id hash table (power of 2, > FDD_MAX_SECTORS) */
+#ifndef FDD_MAX_COW_SECTORS
+#define FDD_MAX_COW_SECTORS (64)    /* max number of written sectors on a shared disc */
+#endif
 
 // result bits (compatible with UPD765_RESULT_*)
 #define FDD_RESULT_SUCCESS (0)
 #define FDD_RESULT_NOT_READY (1<<0)
 #define FDD_RESULT_NOT_FOUND (1<<1)
 #define FDD_RESULT_END_OF_SECTOR (1<<2)
+#define FDD_RESULT_NOT_WRITABLE (1<<3)
 
 // UPD765 disc controller overlay of the sector info bytes
 typedef struct {
@@ -76,6 +110,7 @@ typedef struct {
     } info;
     int data_offset;    // start of sector data in disc data blob
     int data_size;      // size in bytes of sector data drive data buffer
+    int cow_index;      // 1-based copy-on-write slot of a written shared-disc sector, 0 if unmodified
 } fdd_sector_t;
 
 // a track description
@@ -84,6 +119,7 @@ typedef struct {
     int data_size;      // track data size in bytes
     int num_sectors;    // number of sectors in track
     fdd_sector_t sectors[FDD_MAX_SECTORS];  // the sector descriptions
+    uint8_t sector_index[FDD_SECTOR_INDEX_SIZE];    // sector id hash table, 1-based sector indices (see fdd_index_disc())
 } fdd_track_t;
 
 // a disc description
@@ -105,7 +141,13 @@ typedef struct {
     bool motor_on;
     fdd_disc_t disc;
     int data_size;
+    bool shared;                    // true if the disc image data is referenced instead of copied
+    const uint8_t* shared_data;     // caller-owned disc image data (0 in snapshots)
+    int num_cow_sectors;            // number of used copy-on-write slots
+    uint8_t cow_data[FDD_MAX_COW_SECTORS][FDD_MAX_SECTOR_SIZE];
+    #if !defined(CHIPS_SHARED_DISCS)
     uint8_t data[FDD_MAX_DISC_SIZE];
+    #endif
 } fdd_t;
 
 // initialize a floppy disc drive
@@ -114,6 +156,10 @@ void fdd_init(fdd_t* fdd);
 void fdd_motor(fdd_t* fdd, bool on);
 // insert a disc, the disc structure and data will be copied
 bool fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size);
+// insert a disc, the disc structure will be copied, the data is referenced (must remain valid until ejected)
+bool fdd_insert_disc_shared(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size);
+// build the per-track sector id index, called by the insert functions (and after setting up fdd_t.disc directly)
+void fdd_index_disc(fdd_disc_t* disc);
 // eject current disc
 void fdd_eject_disc(fdd_t* fdd);
 // return true if a disc is currently inserted
@@ -125,6 +171,25 @@ int fdd_seek_track(fdd_t* fdd, int track);
 int fdd_seek_sector(fdd_t* fdd, int side, uint8_t c, uint8_t h, uint8_t r, uint8_t n);
 // read the next byte from the seeked-to sector, return FDD_RESULT_*
 int fdd_read(fdd_t* fdd, int side, uint8_t* out_data);
+// read up to max_bytes of the remaining seeked-to sector data, return FDD_RESULT_* (END_OF_SECTOR once the sector end is reached)
+int fdd_read_bytes(fdd_t* fdd, int side, uint8_t* dst, int max_bytes, int* out_num_bytes);
+// read up to max_bytes of track data starting at the seeked-to sector position, continuing with the following sectors
+// in physical order, return FDD_RESULT_* (END_OF_SECTOR once the end of the track's last sector is reached)
+int fdd_read_track(fdd_t* fdd, int side, uint8_t* dst, int max_bytes, int* out_num_bytes);
+// write the next byte into the seeked-to sector, return FDD_RESULT_*
+int fdd_write(fdd_t* fdd, int side, uint8_t data);
+// get pointer to the current data of a sector (for debug inspection)
+const uint8_t* fdd_sector_data(const fdd_t* fdd, const fdd_sector_t* sector);
+// prepare fdd_t snapshot for saving
+void fdd_snapshot_onsave(fdd_t* snapshot);
+// fixup fdd_t snapshot after loading
+void fdd_snapshot_onload(fdd_t* snapshot, fdd_t* sys);
+// copy the drive state from src into dst, only the used parts of the disc image data are copied
+void fdd_copy_state(fdd_t* dst, const fdd_t* src);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the drive state and written shared-disc sectors (the disc image data is not hashed)
+uint64_t fdd_hash(const fdd_t* fdd, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -157,7 +222,13 @@ void fdd_eject_disc(fdd_t* fdd) {
     fdd->has_disc = false;
     fdd->motor_on = false;
     memset(&fdd->disc, 0, sizeof(fdd->disc));
+    fdd->data_size = 0;
+    fdd->shared = false;
+    fdd->shared_data = 0;
+    fdd->num_cow_sectors = 0;
+    #if !defined(CHIPS_SHARED_DISCS)
     memset(&fdd->data, 0, sizeof(fdd->data));
+    #endif
 }
 
 bool fdd_disc_inserted(fdd_t* fdd) {
@@ -165,6 +236,33 @@ bool fdd_disc_inserted(fdd_t* fdd) {
     return fdd->has_disc;
 }
 
+/* the sector id hash is the low nibble of the R byte, which is distinct
+    for the usual sector numbering schemes (01..09, 41..49, C1..C9...)
+*/
+static inline int _fdd_sector_hash(uint8_t r) {
+    return r & (FDD_SECTOR_INDEX_SIZE - 1);
+}
+
+void fdd_index_disc(fdd_disc_t* disc) {
+    CHIPS_ASSERT(disc);
+    for (int side = 0; side < FDD_MAX_SIDES; side++) {
+        for (int track_index = 0; track_index < FDD_MAX_TRACKS; track_index++) {
+            fdd_track_t* track = &disc->tracks[side][track_index];
+            memset(track->sector_index, 0, sizeof(track->sector_index));
+            /* with duplicate sector ids, lookups find the first sector in
+                physical order like a linear scan
+            */
+            for (int si = 0; (si < track->num_sectors) && (si < FDD_MAX_SECTORS); si++) {
+                int slot = _fdd_sector_hash(track->sectors[si].info.upd765.r);
+                while (track->sector_index[slot] != 0) {
+                    slot = (slot + 1) & (FDD_SECTOR_INDEX_SIZE - 1);
+                }
+                track->sector_index[slot] = (uint8_t)(si + 1);
+            }
+        }
+    }
+}
+
 bool _fdd_validate_disc(const fdd_disc_t* disc) {
     CHIPS_ASSERT(disc);
     if ((disc->num_sides < 0) || (disc->num_sides > FDD_MAX_SIDES)) {
@@ -205,13 +303,21 @@ bool _fdd_validate_disc(const fdd_disc_t* disc) {
     return true;
 }
 
-bool fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size) {
+static bool _fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size, bool shared) {
     CHIPS_ASSERT(fdd);
     if (fdd->has_disc) {
         fdd_eject_disc(fdd);
     }
     if (_fdd_validate_disc(disc)) {
         fdd->disc = *disc;
+        for (int side = 0; side < FDD_MAX_SIDES; side++) {
+            for (int track = 0; track < FDD_MAX_TRACKS; track++) {
+                for (int sector = 0; sector < FDD_MAX_SECTORS; sector++) {
+                    fdd->disc.tracks[side][track].sectors[sector].cow_index = 0;
+                }
+            }
+        }
+        fdd_index_disc(&fdd->disc);
     }
     else {
         /* invalid disc structure */
@@ -220,7 +326,18 @@ bool fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, in
     if (data) {
         if ((data_size > 0) && (data_size <= FDD_MAX_DISC_SIZE)) {
             fdd->data_size = data_size;
-            memcpy(&fdd->data, data, data_size);
+            if (shared) {
+                fdd->shared = true;
+                fdd->shared_data = data;
+            }
+            else {
+                #if defined(CHIPS_SHARED_DISCS)
+                    CHIPS_ASSERT(false);
+                    return false;
+                #else
+                    memcpy(&fdd->data, data, data_size);
+                #endif
+            }
             fdd->disc.formatted = true;
         }
         else {
@@ -235,6 +352,31 @@ bool fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, in
     return true;
 }
 
+bool fdd_insert_disc(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size) {
+    return _fdd_insert_disc(fdd, disc, data, data_size, false);
+}
+
+bool fdd_insert_disc_shared(fdd_t* fdd, const fdd_disc_t* disc, const uint8_t* data, int data_size) {
+    return _fdd_insert_disc(fdd, disc, data, data_size, true);
+}
+
+const uint8_t* fdd_sector_data(const fdd_t* fdd, const fdd_sector_t* sector) {
+    CHIPS_ASSERT(fdd && sector);
+    if (sector->cow_index > 0) {
+        return fdd->cow_data[sector->cow_index - 1];
+    }
+    else if (fdd->shared) {
+        return fdd->shared_data + sector->data_offset;
+    }
+    else {
+        #if defined(CHIPS_SHARED_DISCS)
+            return 0;
+        #else
+            return &fdd->data[sector->data_offset];
+        #endif
+    }
+}
+
 int fdd_seek_track(fdd_t* fdd, int track) {
     CHIPS_ASSERT(fdd);
     if (fdd->has_disc && fdd->motor_on && (track < fdd->disc.num_tracks)) {
@@ -255,13 +397,15 @@ int fdd_seek_sector(fdd_t* fdd, int side, uint8_t c, uint8_t h, uint8_t r, uint8
     if (fdd->has_disc && fdd->motor_on) {
         fdd->cur_side = side;
         const fdd_track_t* track = &fdd->disc.tracks[side][fdd->cur_track_index];
-        for (int si = 0; si < track->num_sectors; si++) {
-            const fdd_sector_t* sector = &track->sectors[si];
-            if (sector->info.upd765.r == r) {
+        int slot = _fdd_sector_hash(r);
+        for (int i = 0; (i < FDD_SECTOR_INDEX_SIZE) && (track->sector_index[slot] != 0); i++) {
+            const int si = track->sector_index[slot] - 1;
+            if (track->sectors[si].info.upd765.r == r) {
                 fdd->cur_sector_index = si;
                 fdd->cur_sector_pos = 0;
                 return FDD_RESULT_SUCCESS;
             }
+            slot = (slot + 1) & (FDD_SECTOR_INDEX_SIZE - 1);
         }
         return FDD_RESULT_NOT_FOUND;
     }
@@ -276,8 +420,7 @@ int fdd_read(fdd_t* fdd, int side, uint8_t* out_data) {
         fdd->cur_side = side;
         const fdd_sector_t* sector = &fdd->disc.tracks[side][fdd->cur_track_index].sectors[fdd->cur_sector_index];
         if (fdd->cur_sector_pos < sector->data_size) {
-            const int data_offset = sector->data_offset + fdd->cur_sector_pos;
-            *out_data = fdd->data[data_offset];
+            *out_data = fdd_sector_data(fdd, sector)[fdd->cur_sector_pos];
             fdd->cur_sector_pos++;
             if (fdd->cur_sector_pos < sector->data_size) {
                 return FDD_RESULT_SUCCESS;
@@ -292,4 +435,155 @@ int fdd_read(fdd_t* fdd, int side, uint8_t* out_data) {
     return FDD_RESULT_NOT_READY;
 }
 
+int fdd_read_bytes(fdd_t* fdd, int side, uint8_t* dst, int max_bytes, int* out_num_bytes) {
+    CHIPS_ASSERT(fdd && (side >= 0) && (side < FDD_MAX_SIDES) && dst && (max_bytes >= 0) && out_num_bytes);
+    *out_num_bytes = 0;
+    if (fdd->has_disc & fdd->motor_on) {
+        fdd->cur_side = side;
+        const fdd_sector_t* sector = &fdd->disc.tracks[side][fdd->cur_track_index].sectors[fdd->cur_sector_index];
+        const int remaining = sector->data_size - fdd->cur_sector_pos;
+        if (remaining > 0) {
+            const int num_bytes = (remaining < max_bytes) ? remaining : max_bytes;
+            memcpy(dst, fdd_sector_data(fdd, sector) + fdd->cur_sector_pos, num_bytes);
+            fdd->cur_sector_pos += num_bytes;
+            *out_num_bytes = num_bytes;
+            if (fdd->cur_sector_pos < sector->data_size) {
+                return FDD_RESULT_SUCCESS;
+            }
+            else {
+                return FDD_RESULT_END_OF_SECTOR;
+            }
+        }
+        return FDD_RESULT_NOT_FOUND;
+    }
+    return FDD_RESULT_NOT_READY;
+}
+
+int fdd_read_track(fdd_t* fdd, int side, uint8_t* dst, int max_bytes, int* out_num_bytes) {
+    CHIPS_ASSERT(fdd && (side >= 0) && (side < FDD_MAX_SIDES) && dst && (max_bytes >= 0) && out_num_bytes);
+    *out_num_bytes = 0;
+    if (fdd->has_disc & fdd->motor_on) {
+        const fdd_track_t* track = &fdd->disc.tracks[side][fdd->cur_track_index];
+        int res = FDD_RESULT_NOT_FOUND;
+        while ((*out_num_bytes < max_bytes) && (fdd->cur_sector_index < track->num_sectors)) {
+            int num_bytes = 0;
+            res = fdd_read_bytes(fdd, side, dst + *out_num_bytes, max_bytes - *out_num_bytes, &num_bytes);
+            *out_num_bytes += num_bytes;
+            if (res == FDD_RESULT_SUCCESS) {
+                // dst is full
+                break;
+            }
+            // continue with the next sector in physical order
+            if ((fdd->cur_sector_index + 1) >= track->num_sectors) {
+                break;
+            }
+            fdd->cur_sector_index++;
+            fdd->cur_sector_pos = 0;
+            res = FDD_RESULT_SUCCESS;
+        }
+        return res;
+    }
+    return FDD_RESULT_NOT_READY;
+}
+
+/* return a writable pointer to a sector's data, on shared discs the
+    sector is copied into a copy-on-write slot on the first write
+*/
+static uint8_t* _fdd_writable_sector_data(fdd_t* fdd, fdd_sector_t* sector) {
+    if (sector->cow_index > 0) {
+        return fdd->cow_data[sector->cow_index - 1];
+    }
+    else if (fdd->shared) {
+        if ((fdd->num_cow_sectors >= FDD_MAX_COW_SECTORS) || (sector->data_size > FDD_MAX_SECTOR_SIZE)) {
+            return 0;
+        }
+        uint8_t* dst = fdd->cow_data[fdd->num_cow_sectors++];
+        memcpy(dst, fdd->shared_data + sector->data_offset, sector->data_size);
+        sector->cow_index = fdd->num_cow_sectors;
+        return dst;
+    }
+    else {
+        #if defined(CHIPS_SHARED_DISCS)
+            return 0;
+        #else
+            return &fdd->data[sector->data_offset];
+        #endif
+    }
+}
+
+int fdd_write(fdd_t* fdd, int side, uint8_t data) {
+    CHIPS_ASSERT(fdd && (side >= 0) && (side < FDD_MAX_SIDES));
+    if (fdd->has_disc & fdd->motor_on) {
+        if (fdd->disc.write_protected || !fdd->disc.formatted) {
+            return FDD_RESULT_NOT_WRITABLE;
+        }
+        fdd->cur_side = side;
+        fdd_sector_t* sector = &fdd->disc.tracks[side][fdd->cur_track_index].sectors[fdd->cur_sector_index];
+        if (fdd->cur_sector_pos < sector->data_size) {
+            uint8_t* dst = _fdd_writable_sector_data(fdd, sector);
+            if (0 == dst) {
+                return FDD_RESULT_NOT_WRITABLE;
+            }
+            dst[fdd->cur_sector_pos++] = data;
+            if (fdd->cur_sector_pos < sector->data_size) {
+                return FDD_RESULT_SUCCESS;
+            }
+            else {
+                return FDD_RESULT_END_OF_SECTOR;
+            }
+        }
+        return FDD_RESULT_NOT_FOUND;
+    }
+    return FDD_RESULT_NOT_READY;
+}
+
+void fdd_snapshot_onsave(fdd_t* snapshot) {
+    CHIPS_ASSERT(snapshot);
+    snapshot->shared_data = 0;
+}
+
+void fdd_snapshot_onload(fdd_t* snapshot, fdd_t* sys) {
+    CHIPS_ASSERT(snapshot && sys);
+    /* a snapshot of a shared disc continues to reference the shared disc
+        image currently inserted into the target drive, and has no disc
+        if there is none
+    */
+    if (snapshot->shared) {
+        if (sys->shared && (sys->data_size == snapshot->data_size)) {
+            snapshot->shared_data = sys->shared_data;
+        }
+        else {
+            snapshot->shared = false;
+            snapshot->has_disc = false;
+        }
+    }
+}
+
+void fdd_copy_state(fdd_t* dst, const fdd_t* src) {
+    CHIPS_ASSERT(dst && src);
+    // a shared disc image is referenced by both drives
+    memcpy(dst, src, offsetof(fdd_t, cow_data));
+    memcpy(dst->cow_data, src->cow_data, (size_t)src->num_cow_sectors * FDD_MAX_SECTOR_SIZE);
+    #if !defined(CHIPS_SHARED_DISCS)
+    if (!src->shared) {
+        memcpy(dst->data, src->data, (size_t)src->data_size);
+    }
+    #endif
+}
+
+#if defined(CHIPS_HASH_SEED)
+uint64_t fdd_hash(const fdd_t* fdd, uint64_t h) {
+    CHIPS_ASSERT(fdd);
+    h = CHIPS_HASH(h, fdd->cur_side);
+    h = CHIPS_HASH(h, fdd->cur_track_index);
+    h = CHIPS_HASH(h, fdd->cur_sector_index);
+    h = CHIPS_HASH(h, fdd->cur_sector_pos);
+    h = CHIPS_HASH(h, fdd->has_disc);
+    h = CHIPS_HASH(h, fdd->motor_on);
+    h = CHIPS_HASH(h, fdd->data_size);
+    h = CHIPS_HASH(h, fdd->num_cow_sectors);
+    return chips_hash(h, fdd->cow_data, (size_t)fdd->num_cow_sectors * FDD_MAX_SECTOR_SIZE);
+}
+#endif
+
 #endif /* CHIPS_IMPL */
@@ -19,6 +19,16 @@
         data        - pointer to the .dsk image data in memory
         data_size   - size in bytes of the image data
 
+    ~~~C
+    bool fdd_cpc_insert_dsk_shared(fdd_t* fdd, chips_range_t data)
+    ~~~
+        Same as fdd_cpc_insert_dsk(), but the image data isn't copied
+        into the fdd_t struct, instead the drive references the data
+        directly (for instance a memory-mapped .dsk file). The data must
+        remain valid and unchanged until the disc is ejected, sectors
+        written by the emulated system are copied on write (see
+        'Shared Disc Images' in fdd.h).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -43,6 +53,8 @@ extern "C" {
 
 /* load Amstrad CPC .dsk file format */
 bool fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data);
+/* reference an Amstrad CPC .dsk file without copying */
+bool fdd_cpc_insert_dsk_shared(fdd_t* fdd, chips_range_t data);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -89,7 +101,7 @@ typedef struct {
 } _fdd_cpc_dsk_sector_info;
 
 /* parse a standard .dsk image */
-static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data) {
+static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data, bool shared) {
     CHIPS_ASSERT(fdd);
     const _fdd_cpc_dsk_header* hdr = (_fdd_cpc_dsk_header*)data.ptr;
     if (hdr->num_sides > 2) {
@@ -99,10 +111,21 @@ static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data) {
         return false;
     }
 
-    /* copy the data blob to the local buffer */
+    /* copy the data blob to the local buffer, or reference it */
     CHIPS_ASSERT(data.size <= FDD_MAX_DISC_SIZE);
+    const uint8_t* src = (const uint8_t*) data.ptr;
     fdd->data_size = data.size;
-    memcpy(fdd->data, data.ptr, fdd->data_size);
+    if (shared) {
+        fdd->shared = true;
+        fdd->shared_data = src;
+    }
+    else {
+        #if defined(CHIPS_SHARED_DISCS)
+            return false;
+        #else
+            memcpy(fdd->data, src, fdd->data_size);
+        #endif
+    }
 
     /* setup the disc structure */
     fdd_disc_t* disc = &fdd->disc;
@@ -122,11 +145,11 @@ static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data) {
                 track_size = (hdr->track_size_h<<8) | hdr->track_size_l;
             }
             if (track_size > 0) {
-                const _fdd_cpc_dsk_track_info* track_info = (const _fdd_cpc_dsk_track_info*) &fdd->data[data_offset];
-                if (0 != memcmp("Track-Info", track_info->magic, 10)) {
+                if ((data_offset + track_size) > data.size) {
                     return false;
                 }
-                if ((data_offset + track_size) > data.size) {
+                const _fdd_cpc_dsk_track_info* track_info = (const _fdd_cpc_dsk_track_info*) &src[data_offset];
+                if (0 != memcmp("Track-Info", track_info->magic, 10)) {
                     return false;
                 }
                 track->data_offset = data_offset;
@@ -152,6 +175,7 @@ static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data) {
                     sector->info.upd765.st2 = sector_info->st2;
                     sector->data_offset = sector_data_offset;
                     sector->data_size = sector_size;
+                    sector->cow_index = 0;
                     sector_data_offset += sector_size;
                 }
                 data_offset += track_size;
@@ -165,11 +189,12 @@ static bool _fdd_cpc_parse_dsk(fdd_t* fdd, bool ext, chips_range_t data) {
             }
         }
     }
+    fdd_index_disc(disc);
     fdd->has_disc = true;
     return true;
 }
 
-bool fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data) {
+static bool _fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data, bool shared) {
     CHIPS_ASSERT(fdd);
     CHIPS_ASSERT(sizeof(_fdd_cpc_dsk_header) == 256);
     CHIPS_ASSERT(sizeof(_fdd_cpc_dsk_track_info) == 24);
@@ -197,7 +222,7 @@ bool fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data) {
         ext = true;
     }
     if (valid) {
-        if (!_fdd_cpc_parse_dsk(fdd, ext, data)) {
+        if (!_fdd_cpc_parse_dsk(fdd, ext, data, shared)) {
             fdd_eject_disc(fdd);
             return false;
         }
@@ -207,4 +232,12 @@ bool fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data) {
         return false;
     }
 }
+
+bool fdd_cpc_insert_dsk(fdd_t* fdd, chips_range_t data) {
+    return _fdd_cpc_insert_dsk(fdd, data, false);
+}
+
+bool fdd_cpc_insert_dsk_shared(fdd_t* fdd, chips_range_t data) {
+    return _fdd_cpc_insert_dsk(fdd, data, true);
+}
 #endif /* CHIPS_IMPL */
@@ -51,10 +51,13 @@
     kbd_scan_lines() or kbd_scan_columns() to get the resulting scanned
     bit mask.
 
-    All functions for testing/scanning the keyboard matrix state are 'fast'
-    because of internal state caching, most processing happens in the
-    less frequently called functions kbd_update(), kbd_key_down() and
-    kbd_key_up().
+    All functions for testing/scanning the keyboard matrix state are 'fast':
+    whenever the pressed keys change (in kbd_key_down(), kbd_key_up() and
+    kbd_update() when a sticky key expires), the scan results for any
+    combination of columns or lines (including modifier keys) are
+    resolved into two lookup tables each, one for the lower and one for
+    the upper 6 bits of the input mask, so that a scan is just two table
+    lookups.
 
     ## zlib/libpng license
 
@@ -119,11 +122,9 @@ typedef struct {
     // active column/line masks, updated when key pressed state changes
     uint16_t scanout_column_masks[KBD_MAX_LINES];
     uint16_t scanout_line_masks[KBD_MAX_COLUMNS];
-    // last cached column / scanout combinations
-    uint16_t cur_column_mask;
-    uint16_t cur_scanout_line_mask;
-    uint16_t cur_line_mask;
-    uint16_t cur_scanout_column_mask;
+    // scan results for the lower and upper 6 bits of a column or line mask
+    uint16_t scan_lines[2][1<<(KBD_MAX_COLUMNS/2)];
+    uint16_t scan_columns[2][1<<(KBD_MAX_LINES/2)];
 } kbd_t;
 
 // initialize a keyboard matrix instance, provide key-sticky duration in number of 60Hz frames
@@ -143,9 +144,19 @@ void kbd_key_down(kbd_t* kbd, int key);
 // remove a key from the pressed-key buffer
 void kbd_key_up(kbd_t* kbd, int key);
 // test keyboard matrix against a column bitmask and return lit lines
-uint16_t kbd_test_lines(kbd_t* kbd, uint16_t column_mask);
+static inline uint16_t kbd_test_lines(kbd_t* kbd, uint16_t column_mask) {
+    return kbd->scan_lines[0][column_mask & ((1<<(KBD_MAX_COLUMNS/2))-1)] |
+           kbd->scan_lines[1][(column_mask >> (KBD_MAX_COLUMNS/2)) & ((1<<(KBD_MAX_COLUMNS/2))-1)];
+}
 // test keyboard matrix against a line bitmask and return lit columns
-uint16_t kbd_test_columns(kbd_t* kbd, uint16_t line_mask);
+static inline uint16_t kbd_test_columns(kbd_t* kbd, uint16_t line_mask) {
+    return kbd->scan_columns[0][line_mask & ((1<<(KBD_MAX_LINES/2))-1)] |
+           kbd->scan_columns[1][(line_mask >> (KBD_MAX_LINES/2)) & ((1<<(KBD_MAX_LINES/2))-1)];
+}
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+// save or load the pressed-key state in a streaming snapshot (the key mapping isn't stored)
+void kbd_stream(kbd_t* kbd, chips_stream_t* stream);
+#endif
 // set active column mask (use together with kbd_scan_lines
 static inline void kbd_set_active_columns(kbd_t* kbd, uint16_t column_mask) {
     kbd->active_columns = column_mask;
@@ -304,7 +315,25 @@ static uint16_t _kbd_test_columns(kbd_t* kbd, uint16_t line_mask) {
     return column_bits;
 }
 
-// update the scanout column- and line-masks, SLOW!
+// resolve the per-bit scan results into a lookup table for 6-bit input masks
+static void _kbd_build_scan_table(uint16_t* table, const uint16_t* bit_masks) {
+    table[0] = 0;
+    for (int bit = 0; bit < 6; bit++) {
+        for (int i = (1<<bit); i < (2<<bit); i++) {
+            table[i] = table[i - (1<<bit)] | bit_masks[bit];
+        }
+    }
+}
+
+// rebuild the scan lookup tables from the scanout column- and line-masks
+static void _kbd_update_scan_tables(kbd_t* kbd) {
+    _kbd_build_scan_table(kbd->scan_lines[0], &kbd->scanout_line_masks[0]);
+    _kbd_build_scan_table(kbd->scan_lines[1], &kbd->scanout_line_masks[KBD_MAX_COLUMNS/2]);
+    _kbd_build_scan_table(kbd->scan_columns[0], &kbd->scanout_column_masks[0]);
+    _kbd_build_scan_table(kbd->scan_columns[1], &kbd->scanout_column_masks[KBD_MAX_LINES/2]);
+}
+
+// update the scanout column- and line-masks and the scan lookup tables, SLOW!
 static void _kbd_update_scanout_masks(kbd_t* kbd) {
     for (int line = 0; line < KBD_MAX_LINES; line++) {
         kbd->scanout_column_masks[line] = _kbd_test_columns(kbd, (1<<line));
@@ -312,15 +341,13 @@ static void _kbd_update_scanout_masks(kbd_t* kbd) {
     for (int col = 0; col < KBD_MAX_COLUMNS; col++) {
         kbd->scanout_line_masks[col] = _kbd_test_lines(kbd, (1<<col));
     }
-    kbd->cur_column_mask = 0;
-    kbd->cur_scanout_line_mask = 0;
-    kbd->cur_line_mask = 0;
-    kbd->cur_scanout_column_mask = 0;
+    _kbd_update_scan_tables(kbd);
 }
 
 void kbd_update(kbd_t* kbd, uint32_t frame_time_us) {
     CHIPS_ASSERT(kbd);
     // check for sticky keys that should be released
+    bool changed = false;
     for (int i = 0; i < KBD_MAX_PRESSED_KEYS; i++) {
         key_state_t* k = &kbd->key_buffer[i];
         if (k->released) {
@@ -331,11 +358,14 @@ void kbd_update(kbd_t* kbd, uint32_t frame_time_us) {
                 k->key = 0;
                 k->pressed_time = 0;
                 k->released = false;
+                changed = true;
             }
         }
     }
     kbd->cur_time += frame_time_us;
-    _kbd_update_scanout_masks(kbd);
+    if (changed) {
+        _kbd_update_scanout_masks(kbd);
+    }
 }
 
 void kbd_key_down(kbd_t* kbd, int key) {
@@ -377,34 +407,36 @@ void kbd_key_up(kbd_t* kbd, int key) {
     _kbd_update_scanout_masks(kbd);
 }
 
-// scan keyboard matrix lines by column mask
-uint16_t kbd_test_lines(kbd_t* kbd, uint16_t column_mask) {
-    if (column_mask != kbd->cur_column_mask) {
-        uint16_t m = 0;
-        for (int col = 0; col < KBD_MAX_COLUMNS; col++) {
-            if (column_mask & (1<<col)) {
-                m |= kbd->scanout_line_masks[col];
-            }
-        }
-        kbd->cur_scanout_line_mask = m;
-        kbd->cur_column_mask = column_mask;
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+void kbd_stream(kbd_t* kbd, chips_stream_t* s) {
+    CHIPS_ASSERT(kbd && s);
+    chips_stream_begin(s, CHIPS_STREAM_TAG('K','B','D',' '), 1);
+    chips_stream_u64(s, &kbd->cur_time);
+    chips_stream_u16(s, &kbd->active_columns);
+    chips_stream_u16(s, &kbd->active_lines);
+    for (int i = 0; i < KBD_MAX_PRESSED_KEYS; i++) {
+        key_state_t* k = &kbd->key_buffer[i];
+        chips_stream_int(s, &k->key);
+        chips_stream_u32(s, &k->mask);
+        chips_stream_u64(s, &k->pressed_time);
+        chips_stream_bool(s, &k->released);
     }
-    return kbd->cur_scanout_line_mask;
-}
-
-// scan keyboard matrix lines by column mask
-uint16_t kbd_test_columns(kbd_t* kbd, uint16_t line_mask) {
-    if (line_mask != kbd->cur_line_mask) {
-        uint16_t m = 0;
-        for (int line = 0; line < KBD_MAX_LINES; line++) {
-            if (line_mask & (1<<line)) {
-                m |= kbd->scanout_column_masks[line];
-            }
-        }
-        kbd->cur_scanout_column_mask = m;
-        kbd->cur_line_mask = line_mask;
+    for (int i = 0; i < KBD_MAX_LINES; i++) {
+        chips_stream_u16(s, &kbd->scanout_column_masks[i]);
+    }
+    for (int i = 0; i < KBD_MAX_COLUMNS; i++) {
+        chips_stream_u16(s, &kbd->scanout_line_masks[i]);
+    }
+    // formerly the last scan result cache, kept for stream compatibility
+    uint16_t unused[4] = { 0 };
+    for (int i = 0; i < 4; i++) {
+        chips_stream_u16(s, &unused[i]);
+    }
+    chips_stream_end(s);
+    if (s->loading) {
+        _kbd_update_scan_tables(kbd);
     }
-    return kbd->cur_scanout_column_mask;
 }
+#endif
 
 #endif /* CHIPS_IMPL */
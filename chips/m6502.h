@@ -21,6 +21,35 @@
     CHIPS_ASSERT(c)
     ~~~
 
+    Optionally define one or more of the following before including the
+    implementation to compile a smaller decoder for systems which don't
+    need the respective feature:
+
+    ~~~C
+    #define M6502_NO_UNDOC
+    ~~~
+        The undocumented instructions (except the JAM opcodes) are removed
+        from the decoder, executing one of them jams the CPU.
+
+    ~~~C
+    #define M6502_NO_BCD
+    ~~~
+        The decimal mode is removed from ADC, SBC and ARR (like the
+        2A03 in the NES), same as setting m6502_desc_t.bcd_disabled
+        but without the runtime check.
+
+    ~~~C
+    #define M6502_NO_IO_PORT
+    ~~~
+        The m6502_tick() function doesn't update the M6510 port pins (P0..P5)
+        and doesn't reset the IO port on RES, use this when no m6510 IO
+        port is emulated (m6510_iorq() is never called).
+
+    Those are defined per compilation unit, so all systems which are
+    implemented in the same compilation unit share the same decoder (for
+    instance the C64 and its 1541 floppy drive). The m6502x.h decoder
+    uses the ADC/SBC helpers of m6502.h and thus shares M6502_NO_BCD.
+
     ## Emulated Pins
 
     ***********************************
@@ -358,6 +387,10 @@ uint64_t m6510_iorq(m6502_t* cpu, uint64_t pins);
 void m6502_snapshot_onsave(m6502_t* snapshot);
 // fixup m6502_t snapshot after loading
 void m6502_snapshot_onload(m6502_t* snapshot, m6502_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the m6502_t state (excluding host pointers)
+uint64_t m6502_hash(const m6502_t* cpu, uint64_t h);
+#endif
 
 /* register access functions */
 void m6502_set_a(m6502_t* cpu, uint8_t v);
@@ -418,9 +451,14 @@ uint16_t m6502_pc(m6502_t* cpu) { return cpu->PC; }
 
 /* helper macros and functions for code-generated instruction decoder */
 #define _M6502_NZ(p,v) ((p&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+#if defined(M6502_NO_BCD)
+#define _M6502_BCD(cpu) (false)
+#else
+#define _M6502_BCD(cpu) ((cpu)->bcd_enabled && ((cpu)->P & M6502_DF))
+#endif
 
 static inline void _m6502_adc(m6502_t* cpu, uint8_t val) {
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         /* decimal mode (credit goes to MAME) */
         uint8_t c = cpu->P & M6502_CF ? 1 : 0;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
@@ -462,7 +500,7 @@ static inline void _m6502_adc(m6502_t* cpu, uint8_t val) {
 }
 
 static inline void _m6502_sbc(m6502_t* cpu, uint8_t val) {
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         /* decimal mode (credit goes to MAME) */
         uint8_t c = cpu->P & M6502_CF ? 0 : 1;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
@@ -561,7 +599,7 @@ static inline void _m6502_arr(m6502_t* cpu) {
        by the Wolfgang Lorenz C64 test suite
        implementation taken from MAME
     */
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         bool c = cpu->P & M6502_CF;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
         uint8_t a = cpu->A>>1;
@@ -612,6 +650,7 @@ static inline void _m6502_sbx(m6502_t* cpu, uint8_t v) {
     cpu->X = (uint8_t)t;
 }
 #undef _M6502_NZ
+#undef _M6502_BCD
 
 uint64_t m6502_init(m6502_t* c, const m6502_desc_t* desc) {
     CHIPS_ASSERT(c && desc);
@@ -677,6 +716,16 @@ void m6502_snapshot_onload(m6502_t* snapshot, m6502_t* sys) {
     snapshot->user_data = sys->user_data;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t m6502_hash(const m6502_t* cpu, uint64_t h) {
+    CHIPS_ASSERT(cpu);
+    m6502_t tmp;
+    memcpy(&tmp, cpu, sizeof(tmp));
+    m6502_snapshot_onsave(&tmp);
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 /* set 16-bit address in 64-bit pin mask */
 #define _SA(addr) pins=(pins&~0xFFFF)|((addr)&0xFFFFULL)
 /* extract 16-bit addess from pin mask */
@@ -720,7 +769,9 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
 
         // RDY pin is only checked during read cycles
         if ((pins & (M6502_RW|M6502_RDY)) == (M6502_RW|M6502_RDY)) {
+            #if !defined(M6502_NO_IO_PORT)
             M6510_SET_PORT(pins, c->io_pins);
+            #endif
             c->PINS = pins;
             c->irq_pip <<= 1;
             return pins;
@@ -746,10 +797,12 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
             }
             if (0 != (pins & M6502_RES)) {
                 c->brk_flags |= M6502_BRK_RESET;
+                #if !defined(M6502_NO_IO_PORT)
                 c->io_ddr = 0;
                 c->io_out = 0;
                 c->io_inp = 0;
                 c->io_pins = 0;
+                #endif
             }
             c->irq_pip &= 0x3FF;
             c->nmi_pip &= 0x3FF;
@@ -795,6 +848,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x02<<3)|5: assert(false);break;
         case (0x02<<3)|6: assert(false);break;
         case (0x02<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO (zp,X) (undoc) */
         case (0x03<<3)|0: _SA(c->PC++);break;
         case (0x03<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -804,6 +858,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x03<<3)|5: c->AD=_GD();_WR();break;
         case (0x03<<3)|6: c->AD=_m6502_asl(c,c->AD);_SD(c->AD);c->A|=c->AD;_NZ(c->A);_WR();break;
         case (0x03<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp (undoc) */
         case (0x04<<3)|0: _SA(c->PC++);break;
         case (0x04<<3)|1: _SA(_GD());break;
@@ -813,6 +869,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x04<<3)|5: assert(false);break;
         case (0x04<<3)|6: assert(false);break;
         case (0x04<<3)|7: assert(false);break;
+#endif
     /* ORA zp */
         case (0x05<<3)|0: _SA(c->PC++);break;
         case (0x05<<3)|1: _SA(_GD());break;
@@ -831,6 +888,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x06<<3)|5: assert(false);break;
         case (0x06<<3)|6: assert(false);break;
         case (0x06<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO zp (undoc) */
         case (0x07<<3)|0: _SA(c->PC++);break;
         case (0x07<<3)|1: _SA(_GD());break;
@@ -840,6 +898,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x07<<3)|5: assert(false);break;
         case (0x07<<3)|6: assert(false);break;
         case (0x07<<3)|7: assert(false);break;
+#endif
     /* PHP  */
         case (0x08<<3)|0: _SA(c->PC);break;
         case (0x08<<3)|1: _SAD(0x0100|c->S--,c->P|M6502_XF);_WR();break;
@@ -867,6 +926,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x0A<<3)|5: assert(false);break;
         case (0x0A<<3)|6: assert(false);break;
         case (0x0A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ANC # (undoc) */
         case (0x0B<<3)|0: _SA(c->PC++);break;
         case (0x0B<<3)|1: c->A&=_GD();_NZ(c->A);if(c->A&0x80){c->P|=M6502_CF;}else{c->P&=~M6502_CF;}_FETCH();break;
@@ -876,6 +936,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x0B<<3)|5: assert(false);break;
         case (0x0B<<3)|6: assert(false);break;
         case (0x0B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs (undoc) */
         case (0x0C<<3)|0: _SA(c->PC++);break;
         case (0x0C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -885,6 +947,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x0C<<3)|5: assert(false);break;
         case (0x0C<<3)|6: assert(false);break;
         case (0x0C<<3)|7: assert(false);break;
+#endif
     /* ORA abs */
         case (0x0D<<3)|0: _SA(c->PC++);break;
         case (0x0D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -903,6 +966,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x0E<<3)|5: _FETCH();break;
         case (0x0E<<3)|6: assert(false);break;
         case (0x0E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO abs (undoc) */
         case (0x0F<<3)|0: _SA(c->PC++);break;
         case (0x0F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -912,6 +976,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x0F<<3)|5: _FETCH();break;
         case (0x0F<<3)|6: assert(false);break;
         case (0x0F<<3)|7: assert(false);break;
+#endif
     /* BPL # */
         case (0x10<<3)|0: _SA(c->PC++);break;
         case (0x10<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x80)!=0x0){_FETCH();};break;
@@ -939,6 +1004,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x12<<3)|5: assert(false);break;
         case (0x12<<3)|6: assert(false);break;
         case (0x12<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO (zp),Y (undoc) */
         case (0x13<<3)|0: _SA(c->PC++);break;
         case (0x13<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -948,6 +1014,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x13<<3)|5: c->AD=_GD();_WR();break;
         case (0x13<<3)|6: c->AD=_m6502_asl(c,c->AD);_SD(c->AD);c->A|=c->AD;_NZ(c->A);_WR();break;
         case (0x13<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0x14<<3)|0: _SA(c->PC++);break;
         case (0x14<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -957,6 +1025,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x14<<3)|5: assert(false);break;
         case (0x14<<3)|6: assert(false);break;
         case (0x14<<3)|7: assert(false);break;
+#endif
     /* ORA zp,X */
         case (0x15<<3)|0: _SA(c->PC++);break;
         case (0x15<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -975,6 +1044,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x16<<3)|5: _FETCH();break;
         case (0x16<<3)|6: assert(false);break;
         case (0x16<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO zp,X (undoc) */
         case (0x17<<3)|0: _SA(c->PC++);break;
         case (0x17<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -984,6 +1054,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x17<<3)|5: _FETCH();break;
         case (0x17<<3)|6: assert(false);break;
         case (0x17<<3)|7: assert(false);break;
+#endif
     /* CLC  */
         case (0x18<<3)|0: _SA(c->PC);break;
         case (0x18<<3)|1: c->P&=~0x1;_FETCH();break;
@@ -1002,6 +1073,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x19<<3)|5: assert(false);break;
         case (0x19<<3)|6: assert(false);break;
         case (0x19<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0x1A<<3)|0: _SA(c->PC);break;
         case (0x1A<<3)|1: _FETCH();break;
@@ -1011,6 +1083,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x1A<<3)|5: assert(false);break;
         case (0x1A<<3)|6: assert(false);break;
         case (0x1A<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* SLO abs,Y (undoc) */
         case (0x1B<<3)|0: _SA(c->PC++);break;
         case (0x1B<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1020,6 +1094,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x1B<<3)|5: c->AD=_m6502_asl(c,c->AD);_SD(c->AD);c->A|=c->AD;_NZ(c->A);_WR();break;
         case (0x1B<<3)|6: _FETCH();break;
         case (0x1B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0x1C<<3)|0: _SA(c->PC++);break;
         case (0x1C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1029,6 +1105,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x1C<<3)|5: assert(false);break;
         case (0x1C<<3)|6: assert(false);break;
         case (0x1C<<3)|7: assert(false);break;
+#endif
     /* ORA abs,X */
         case (0x1D<<3)|0: _SA(c->PC++);break;
         case (0x1D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1047,6 +1124,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x1E<<3)|5: _SD(_m6502_asl(c,c->AD));_WR();break;
         case (0x1E<<3)|6: _FETCH();break;
         case (0x1E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SLO abs,X (undoc) */
         case (0x1F<<3)|0: _SA(c->PC++);break;
         case (0x1F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1056,6 +1134,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x1F<<3)|5: c->AD=_m6502_asl(c,c->AD);_SD(c->AD);c->A|=c->AD;_NZ(c->A);_WR();break;
         case (0x1F<<3)|6: _FETCH();break;
         case (0x1F<<3)|7: assert(false);break;
+#endif
     /* JSR  */
         case (0x20<<3)|0: _SA(c->PC++);break;
         case (0x20<<3)|1: _SA(0x0100|c->S);c->AD=_GD();break;
@@ -1083,6 +1162,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x22<<3)|5: assert(false);break;
         case (0x22<<3)|6: assert(false);break;
         case (0x22<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA (zp,X) (undoc) */
         case (0x23<<3)|0: _SA(c->PC++);break;
         case (0x23<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1092,6 +1172,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x23<<3)|5: c->AD=_GD();_WR();break;
         case (0x23<<3)|6: c->AD=_m6502_rol(c,c->AD);_SD(c->AD);c->A&=c->AD;_NZ(c->A);_WR();break;
         case (0x23<<3)|7: _FETCH();break;
+#endif
     /* BIT zp */
         case (0x24<<3)|0: _SA(c->PC++);break;
         case (0x24<<3)|1: _SA(_GD());break;
@@ -1119,6 +1200,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x26<<3)|5: assert(false);break;
         case (0x26<<3)|6: assert(false);break;
         case (0x26<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA zp (undoc) */
         case (0x27<<3)|0: _SA(c->PC++);break;
         case (0x27<<3)|1: _SA(_GD());break;
@@ -1128,6 +1210,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x27<<3)|5: assert(false);break;
         case (0x27<<3)|6: assert(false);break;
         case (0x27<<3)|7: assert(false);break;
+#endif
     /* PLP  */
         case (0x28<<3)|0: _SA(c->PC);break;
         case (0x28<<3)|1: _SA(0x0100|c->S++);break;
@@ -1155,6 +1238,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x2A<<3)|5: assert(false);break;
         case (0x2A<<3)|6: assert(false);break;
         case (0x2A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ANC # (undoc) */
         case (0x2B<<3)|0: _SA(c->PC++);break;
         case (0x2B<<3)|1: c->A&=_GD();_NZ(c->A);if(c->A&0x80){c->P|=M6502_CF;}else{c->P&=~M6502_CF;}_FETCH();break;
@@ -1164,6 +1248,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x2B<<3)|5: assert(false);break;
         case (0x2B<<3)|6: assert(false);break;
         case (0x2B<<3)|7: assert(false);break;
+#endif
     /* BIT abs */
         case (0x2C<<3)|0: _SA(c->PC++);break;
         case (0x2C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1191,6 +1276,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x2E<<3)|5: _FETCH();break;
         case (0x2E<<3)|6: assert(false);break;
         case (0x2E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA abs (undoc) */
         case (0x2F<<3)|0: _SA(c->PC++);break;
         case (0x2F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1200,6 +1286,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x2F<<3)|5: _FETCH();break;
         case (0x2F<<3)|6: assert(false);break;
         case (0x2F<<3)|7: assert(false);break;
+#endif
     /* BMI # */
         case (0x30<<3)|0: _SA(c->PC++);break;
         case (0x30<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x80)!=0x80){_FETCH();};break;
@@ -1227,6 +1314,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x32<<3)|5: assert(false);break;
         case (0x32<<3)|6: assert(false);break;
         case (0x32<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA (zp),Y (undoc) */
         case (0x33<<3)|0: _SA(c->PC++);break;
         case (0x33<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1236,6 +1324,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x33<<3)|5: c->AD=_GD();_WR();break;
         case (0x33<<3)|6: c->AD=_m6502_rol(c,c->AD);_SD(c->AD);c->A&=c->AD;_NZ(c->A);_WR();break;
         case (0x33<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0x34<<3)|0: _SA(c->PC++);break;
         case (0x34<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1245,6 +1335,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x34<<3)|5: assert(false);break;
         case (0x34<<3)|6: assert(false);break;
         case (0x34<<3)|7: assert(false);break;
+#endif
     /* AND zp,X */
         case (0x35<<3)|0: _SA(c->PC++);break;
         case (0x35<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1263,6 +1354,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x36<<3)|5: _FETCH();break;
         case (0x36<<3)|6: assert(false);break;
         case (0x36<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA zp,X (undoc) */
         case (0x37<<3)|0: _SA(c->PC++);break;
         case (0x37<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1272,6 +1364,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x37<<3)|5: _FETCH();break;
         case (0x37<<3)|6: assert(false);break;
         case (0x37<<3)|7: assert(false);break;
+#endif
     /* SEC  */
         case (0x38<<3)|0: _SA(c->PC);break;
         case (0x38<<3)|1: c->P|=0x1;_FETCH();break;
@@ -1290,6 +1383,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x39<<3)|5: assert(false);break;
         case (0x39<<3)|6: assert(false);break;
         case (0x39<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0x3A<<3)|0: _SA(c->PC);break;
         case (0x3A<<3)|1: _FETCH();break;
@@ -1299,6 +1393,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x3A<<3)|5: assert(false);break;
         case (0x3A<<3)|6: assert(false);break;
         case (0x3A<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* RLA abs,Y (undoc) */
         case (0x3B<<3)|0: _SA(c->PC++);break;
         case (0x3B<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1308,6 +1404,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x3B<<3)|5: c->AD=_m6502_rol(c,c->AD);_SD(c->AD);c->A&=c->AD;_NZ(c->A);_WR();break;
         case (0x3B<<3)|6: _FETCH();break;
         case (0x3B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0x3C<<3)|0: _SA(c->PC++);break;
         case (0x3C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1317,6 +1415,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x3C<<3)|5: assert(false);break;
         case (0x3C<<3)|6: assert(false);break;
         case (0x3C<<3)|7: assert(false);break;
+#endif
     /* AND abs,X */
         case (0x3D<<3)|0: _SA(c->PC++);break;
         case (0x3D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1335,6 +1434,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x3E<<3)|5: _SD(_m6502_rol(c,c->AD));_WR();break;
         case (0x3E<<3)|6: _FETCH();break;
         case (0x3E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RLA abs,X (undoc) */
         case (0x3F<<3)|0: _SA(c->PC++);break;
         case (0x3F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1344,6 +1444,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x3F<<3)|5: c->AD=_m6502_rol(c,c->AD);_SD(c->AD);c->A&=c->AD;_NZ(c->A);_WR();break;
         case (0x3F<<3)|6: _FETCH();break;
         case (0x3F<<3)|7: assert(false);break;
+#endif
     /* RTI  */
         case (0x40<<3)|0: _SA(c->PC);break;
         case (0x40<<3)|1: _SA(0x0100|c->S++);break;
@@ -1371,6 +1472,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x42<<3)|5: assert(false);break;
         case (0x42<<3)|6: assert(false);break;
         case (0x42<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE (zp,X) (undoc) */
         case (0x43<<3)|0: _SA(c->PC++);break;
         case (0x43<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1380,6 +1482,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x43<<3)|5: c->AD=_GD();_WR();break;
         case (0x43<<3)|6: c->AD=_m6502_lsr(c,c->AD);_SD(c->AD);c->A^=c->AD;_NZ(c->A);_WR();break;
         case (0x43<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp (undoc) */
         case (0x44<<3)|0: _SA(c->PC++);break;
         case (0x44<<3)|1: _SA(_GD());break;
@@ -1389,6 +1493,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x44<<3)|5: assert(false);break;
         case (0x44<<3)|6: assert(false);break;
         case (0x44<<3)|7: assert(false);break;
+#endif
     /* EOR zp */
         case (0x45<<3)|0: _SA(c->PC++);break;
         case (0x45<<3)|1: _SA(_GD());break;
@@ -1407,6 +1512,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x46<<3)|5: assert(false);break;
         case (0x46<<3)|6: assert(false);break;
         case (0x46<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE zp (undoc) */
         case (0x47<<3)|0: _SA(c->PC++);break;
         case (0x47<<3)|1: _SA(_GD());break;
@@ -1416,6 +1522,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x47<<3)|5: assert(false);break;
         case (0x47<<3)|6: assert(false);break;
         case (0x47<<3)|7: assert(false);break;
+#endif
     /* PHA  */
         case (0x48<<3)|0: _SA(c->PC);break;
         case (0x48<<3)|1: _SAD(0x0100|c->S--,c->A);_WR();break;
@@ -1443,6 +1550,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x4A<<3)|5: assert(false);break;
         case (0x4A<<3)|6: assert(false);break;
         case (0x4A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ASR # (undoc) */
         case (0x4B<<3)|0: _SA(c->PC++);break;
         case (0x4B<<3)|1: c->A&=_GD();c->A=_m6502_lsr(c,c->A);_FETCH();break;
@@ -1452,6 +1560,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x4B<<3)|5: assert(false);break;
         case (0x4B<<3)|6: assert(false);break;
         case (0x4B<<3)|7: assert(false);break;
+#endif
     /* JMP  */
         case (0x4C<<3)|0: _SA(c->PC++);break;
         case (0x4C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1479,6 +1588,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x4E<<3)|5: _FETCH();break;
         case (0x4E<<3)|6: assert(false);break;
         case (0x4E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE abs (undoc) */
         case (0x4F<<3)|0: _SA(c->PC++);break;
         case (0x4F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1488,6 +1598,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x4F<<3)|5: _FETCH();break;
         case (0x4F<<3)|6: assert(false);break;
         case (0x4F<<3)|7: assert(false);break;
+#endif
     /* BVC # */
         case (0x50<<3)|0: _SA(c->PC++);break;
         case (0x50<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x40)!=0x0){_FETCH();};break;
@@ -1515,6 +1626,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x52<<3)|5: assert(false);break;
         case (0x52<<3)|6: assert(false);break;
         case (0x52<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE (zp),Y (undoc) */
         case (0x53<<3)|0: _SA(c->PC++);break;
         case (0x53<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1524,6 +1636,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x53<<3)|5: c->AD=_GD();_WR();break;
         case (0x53<<3)|6: c->AD=_m6502_lsr(c,c->AD);_SD(c->AD);c->A^=c->AD;_NZ(c->A);_WR();break;
         case (0x53<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0x54<<3)|0: _SA(c->PC++);break;
         case (0x54<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1533,6 +1647,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x54<<3)|5: assert(false);break;
         case (0x54<<3)|6: assert(false);break;
         case (0x54<<3)|7: assert(false);break;
+#endif
     /* EOR zp,X */
         case (0x55<<3)|0: _SA(c->PC++);break;
         case (0x55<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1551,6 +1666,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x56<<3)|5: _FETCH();break;
         case (0x56<<3)|6: assert(false);break;
         case (0x56<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE zp,X (undoc) */
         case (0x57<<3)|0: _SA(c->PC++);break;
         case (0x57<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1560,6 +1676,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x57<<3)|5: _FETCH();break;
         case (0x57<<3)|6: assert(false);break;
         case (0x57<<3)|7: assert(false);break;
+#endif
     /* CLI  */
         case (0x58<<3)|0: _SA(c->PC);break;
         case (0x58<<3)|1: c->P&=~0x4;_FETCH();break;
@@ -1578,6 +1695,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x59<<3)|5: assert(false);break;
         case (0x59<<3)|6: assert(false);break;
         case (0x59<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0x5A<<3)|0: _SA(c->PC);break;
         case (0x5A<<3)|1: _FETCH();break;
@@ -1587,6 +1705,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x5A<<3)|5: assert(false);break;
         case (0x5A<<3)|6: assert(false);break;
         case (0x5A<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* SRE abs,Y (undoc) */
         case (0x5B<<3)|0: _SA(c->PC++);break;
         case (0x5B<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1596,6 +1716,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x5B<<3)|5: c->AD=_m6502_lsr(c,c->AD);_SD(c->AD);c->A^=c->AD;_NZ(c->A);_WR();break;
         case (0x5B<<3)|6: _FETCH();break;
         case (0x5B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0x5C<<3)|0: _SA(c->PC++);break;
         case (0x5C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1605,6 +1727,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x5C<<3)|5: assert(false);break;
         case (0x5C<<3)|6: assert(false);break;
         case (0x5C<<3)|7: assert(false);break;
+#endif
     /* EOR abs,X */
         case (0x5D<<3)|0: _SA(c->PC++);break;
         case (0x5D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1623,6 +1746,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x5E<<3)|5: _SD(_m6502_lsr(c,c->AD));_WR();break;
         case (0x5E<<3)|6: _FETCH();break;
         case (0x5E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SRE abs,X (undoc) */
         case (0x5F<<3)|0: _SA(c->PC++);break;
         case (0x5F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1632,6 +1756,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x5F<<3)|5: c->AD=_m6502_lsr(c,c->AD);_SD(c->AD);c->A^=c->AD;_NZ(c->A);_WR();break;
         case (0x5F<<3)|6: _FETCH();break;
         case (0x5F<<3)|7: assert(false);break;
+#endif
     /* RTS  */
         case (0x60<<3)|0: _SA(c->PC);break;
         case (0x60<<3)|1: _SA(0x0100|c->S++);break;
@@ -1659,6 +1784,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x62<<3)|5: assert(false);break;
         case (0x62<<3)|6: assert(false);break;
         case (0x62<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA (zp,X) (undoc) */
         case (0x63<<3)|0: _SA(c->PC++);break;
         case (0x63<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1668,6 +1794,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x63<<3)|5: c->AD=_GD();_WR();break;
         case (0x63<<3)|6: c->AD=_m6502_ror(c,c->AD);_SD(c->AD);_m6502_adc(c,c->AD);_WR();break;
         case (0x63<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp (undoc) */
         case (0x64<<3)|0: _SA(c->PC++);break;
         case (0x64<<3)|1: _SA(_GD());break;
@@ -1677,6 +1805,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x64<<3)|5: assert(false);break;
         case (0x64<<3)|6: assert(false);break;
         case (0x64<<3)|7: assert(false);break;
+#endif
     /* ADC zp */
         case (0x65<<3)|0: _SA(c->PC++);break;
         case (0x65<<3)|1: _SA(_GD());break;
@@ -1695,6 +1824,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x66<<3)|5: assert(false);break;
         case (0x66<<3)|6: assert(false);break;
         case (0x66<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA zp (undoc) */
         case (0x67<<3)|0: _SA(c->PC++);break;
         case (0x67<<3)|1: _SA(_GD());break;
@@ -1704,6 +1834,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x67<<3)|5: assert(false);break;
         case (0x67<<3)|6: assert(false);break;
         case (0x67<<3)|7: assert(false);break;
+#endif
     /* PLA  */
         case (0x68<<3)|0: _SA(c->PC);break;
         case (0x68<<3)|1: _SA(0x0100|c->S++);break;
@@ -1731,6 +1862,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x6A<<3)|5: assert(false);break;
         case (0x6A<<3)|6: assert(false);break;
         case (0x6A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ARR # (undoc) */
         case (0x6B<<3)|0: _SA(c->PC++);break;
         case (0x6B<<3)|1: c->A&=_GD();_m6502_arr(c);_FETCH();break;
@@ -1740,6 +1872,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x6B<<3)|5: assert(false);break;
         case (0x6B<<3)|6: assert(false);break;
         case (0x6B<<3)|7: assert(false);break;
+#endif
     /* JMPI  */
         case (0x6C<<3)|0: _SA(c->PC++);break;
         case (0x6C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1767,6 +1900,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x6E<<3)|5: _FETCH();break;
         case (0x6E<<3)|6: assert(false);break;
         case (0x6E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA abs (undoc) */
         case (0x6F<<3)|0: _SA(c->PC++);break;
         case (0x6F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1776,6 +1910,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x6F<<3)|5: _FETCH();break;
         case (0x6F<<3)|6: assert(false);break;
         case (0x6F<<3)|7: assert(false);break;
+#endif
     /* BVS # */
         case (0x70<<3)|0: _SA(c->PC++);break;
         case (0x70<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x40)!=0x40){_FETCH();};break;
@@ -1803,6 +1938,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x72<<3)|5: assert(false);break;
         case (0x72<<3)|6: assert(false);break;
         case (0x72<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA (zp),Y (undoc) */
         case (0x73<<3)|0: _SA(c->PC++);break;
         case (0x73<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1812,6 +1948,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x73<<3)|5: c->AD=_GD();_WR();break;
         case (0x73<<3)|6: c->AD=_m6502_ror(c,c->AD);_SD(c->AD);_m6502_adc(c,c->AD);_WR();break;
         case (0x73<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0x74<<3)|0: _SA(c->PC++);break;
         case (0x74<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1821,6 +1959,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x74<<3)|5: assert(false);break;
         case (0x74<<3)|6: assert(false);break;
         case (0x74<<3)|7: assert(false);break;
+#endif
     /* ADC zp,X */
         case (0x75<<3)|0: _SA(c->PC++);break;
         case (0x75<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1839,6 +1978,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x76<<3)|5: _FETCH();break;
         case (0x76<<3)|6: assert(false);break;
         case (0x76<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA zp,X (undoc) */
         case (0x77<<3)|0: _SA(c->PC++);break;
         case (0x77<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1848,6 +1988,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x77<<3)|5: _FETCH();break;
         case (0x77<<3)|6: assert(false);break;
         case (0x77<<3)|7: assert(false);break;
+#endif
     /* SEI  */
         case (0x78<<3)|0: _SA(c->PC);break;
         case (0x78<<3)|1: c->P|=0x4;_FETCH();break;
@@ -1866,6 +2007,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x79<<3)|5: assert(false);break;
         case (0x79<<3)|6: assert(false);break;
         case (0x79<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0x7A<<3)|0: _SA(c->PC);break;
         case (0x7A<<3)|1: _FETCH();break;
@@ -1875,6 +2017,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x7A<<3)|5: assert(false);break;
         case (0x7A<<3)|6: assert(false);break;
         case (0x7A<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* RRA abs,Y (undoc) */
         case (0x7B<<3)|0: _SA(c->PC++);break;
         case (0x7B<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1884,6 +2028,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x7B<<3)|5: c->AD=_m6502_ror(c,c->AD);_SD(c->AD);_m6502_adc(c,c->AD);_WR();break;
         case (0x7B<<3)|6: _FETCH();break;
         case (0x7B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0x7C<<3)|0: _SA(c->PC++);break;
         case (0x7C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1893,6 +2039,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x7C<<3)|5: assert(false);break;
         case (0x7C<<3)|6: assert(false);break;
         case (0x7C<<3)|7: assert(false);break;
+#endif
     /* ADC abs,X */
         case (0x7D<<3)|0: _SA(c->PC++);break;
         case (0x7D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1911,6 +2058,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x7E<<3)|5: _SD(_m6502_ror(c,c->AD));_WR();break;
         case (0x7E<<3)|6: _FETCH();break;
         case (0x7E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* RRA abs,X (undoc) */
         case (0x7F<<3)|0: _SA(c->PC++);break;
         case (0x7F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -1920,6 +2068,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x7F<<3)|5: c->AD=_m6502_ror(c,c->AD);_SD(c->AD);_m6502_adc(c,c->AD);_WR();break;
         case (0x7F<<3)|6: _FETCH();break;
         case (0x7F<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP # (undoc) */
         case (0x80<<3)|0: _SA(c->PC++);break;
         case (0x80<<3)|1: _FETCH();break;
@@ -1929,6 +2079,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x80<<3)|5: assert(false);break;
         case (0x80<<3)|6: assert(false);break;
         case (0x80<<3)|7: assert(false);break;
+#endif
     /* STA (zp,X) */
         case (0x81<<3)|0: _SA(c->PC++);break;
         case (0x81<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1938,6 +2089,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x81<<3)|5: _FETCH();break;
         case (0x81<<3)|6: assert(false);break;
         case (0x81<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP # (undoc) */
         case (0x82<<3)|0: _SA(c->PC++);break;
         case (0x82<<3)|1: _FETCH();break;
@@ -1947,6 +2099,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x82<<3)|5: assert(false);break;
         case (0x82<<3)|6: assert(false);break;
         case (0x82<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* SAX (zp,X) (undoc) */
         case (0x83<<3)|0: _SA(c->PC++);break;
         case (0x83<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -1956,6 +2110,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x83<<3)|5: _FETCH();break;
         case (0x83<<3)|6: assert(false);break;
         case (0x83<<3)|7: assert(false);break;
+#endif
     /* STY zp */
         case (0x84<<3)|0: _SA(c->PC++);break;
         case (0x84<<3)|1: _SA(_GD());_SD(c->Y);_WR();break;
@@ -1983,6 +2138,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x86<<3)|5: assert(false);break;
         case (0x86<<3)|6: assert(false);break;
         case (0x86<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SAX zp (undoc) */
         case (0x87<<3)|0: _SA(c->PC++);break;
         case (0x87<<3)|1: _SA(_GD());_SD(c->A&c->X);_WR();break;
@@ -1992,6 +2148,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x87<<3)|5: assert(false);break;
         case (0x87<<3)|6: assert(false);break;
         case (0x87<<3)|7: assert(false);break;
+#endif
     /* DEY  */
         case (0x88<<3)|0: _SA(c->PC);break;
         case (0x88<<3)|1: c->Y--;_NZ(c->Y);_FETCH();break;
@@ -2001,6 +2158,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x88<<3)|5: assert(false);break;
         case (0x88<<3)|6: assert(false);break;
         case (0x88<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP # (undoc) */
         case (0x89<<3)|0: _SA(c->PC++);break;
         case (0x89<<3)|1: _FETCH();break;
@@ -2010,6 +2168,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x89<<3)|5: assert(false);break;
         case (0x89<<3)|6: assert(false);break;
         case (0x89<<3)|7: assert(false);break;
+#endif
     /* TXA  */
         case (0x8A<<3)|0: _SA(c->PC);break;
         case (0x8A<<3)|1: c->A=c->X;_NZ(c->A);_FETCH();break;
@@ -2019,6 +2178,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x8A<<3)|5: assert(false);break;
         case (0x8A<<3)|6: assert(false);break;
         case (0x8A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ANE # (undoc) */
         case (0x8B<<3)|0: _SA(c->PC++);break;
         case (0x8B<<3)|1: c->A=(c->A|0xEE)&c->X&_GD();_NZ(c->A);_FETCH();break;
@@ -2028,6 +2188,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x8B<<3)|5: assert(false);break;
         case (0x8B<<3)|6: assert(false);break;
         case (0x8B<<3)|7: assert(false);break;
+#endif
     /* STY abs */
         case (0x8C<<3)|0: _SA(c->PC++);break;
         case (0x8C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2055,6 +2216,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x8E<<3)|5: assert(false);break;
         case (0x8E<<3)|6: assert(false);break;
         case (0x8E<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SAX abs (undoc) */
         case (0x8F<<3)|0: _SA(c->PC++);break;
         case (0x8F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2064,6 +2226,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x8F<<3)|5: assert(false);break;
         case (0x8F<<3)|6: assert(false);break;
         case (0x8F<<3)|7: assert(false);break;
+#endif
     /* BCC # */
         case (0x90<<3)|0: _SA(c->PC++);break;
         case (0x90<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x1)!=0x0){_FETCH();};break;
@@ -2091,6 +2254,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x92<<3)|5: assert(false);break;
         case (0x92<<3)|6: assert(false);break;
         case (0x92<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SHA (zp),Y (undoc) */
         case (0x93<<3)|0: _SA(c->PC++);break;
         case (0x93<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2100,6 +2264,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x93<<3)|5: _FETCH();break;
         case (0x93<<3)|6: assert(false);break;
         case (0x93<<3)|7: assert(false);break;
+#endif
     /* STY zp,X */
         case (0x94<<3)|0: _SA(c->PC++);break;
         case (0x94<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2127,6 +2292,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x96<<3)|5: assert(false);break;
         case (0x96<<3)|6: assert(false);break;
         case (0x96<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SAX zp,Y (undoc) */
         case (0x97<<3)|0: _SA(c->PC++);break;
         case (0x97<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2136,6 +2302,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x97<<3)|5: assert(false);break;
         case (0x97<<3)|6: assert(false);break;
         case (0x97<<3)|7: assert(false);break;
+#endif
     /* TYA  */
         case (0x98<<3)|0: _SA(c->PC);break;
         case (0x98<<3)|1: c->A=c->Y;_NZ(c->A);_FETCH();break;
@@ -2163,6 +2330,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9A<<3)|5: assert(false);break;
         case (0x9A<<3)|6: assert(false);break;
         case (0x9A<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SHS abs,Y (undoc) */
         case (0x9B<<3)|0: _SA(c->PC++);break;
         case (0x9B<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2172,6 +2340,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9B<<3)|5: assert(false);break;
         case (0x9B<<3)|6: assert(false);break;
         case (0x9B<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* SHY abs,X (undoc) */
         case (0x9C<<3)|0: _SA(c->PC++);break;
         case (0x9C<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2181,6 +2351,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9C<<3)|5: assert(false);break;
         case (0x9C<<3)|6: assert(false);break;
         case (0x9C<<3)|7: assert(false);break;
+#endif
     /* STA abs,X */
         case (0x9D<<3)|0: _SA(c->PC++);break;
         case (0x9D<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2190,6 +2361,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9D<<3)|5: assert(false);break;
         case (0x9D<<3)|6: assert(false);break;
         case (0x9D<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SHX abs,Y (undoc) */
         case (0x9E<<3)|0: _SA(c->PC++);break;
         case (0x9E<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2199,6 +2371,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9E<<3)|5: assert(false);break;
         case (0x9E<<3)|6: assert(false);break;
         case (0x9E<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* SHA abs,Y (undoc) */
         case (0x9F<<3)|0: _SA(c->PC++);break;
         case (0x9F<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2208,6 +2382,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0x9F<<3)|5: assert(false);break;
         case (0x9F<<3)|6: assert(false);break;
         case (0x9F<<3)|7: assert(false);break;
+#endif
     /* LDY # */
         case (0xA0<<3)|0: _SA(c->PC++);break;
         case (0xA0<<3)|1: c->Y=_GD();_NZ(c->Y);_FETCH();break;
@@ -2235,6 +2410,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xA2<<3)|5: assert(false);break;
         case (0xA2<<3)|6: assert(false);break;
         case (0xA2<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX (zp,X) (undoc) */
         case (0xA3<<3)|0: _SA(c->PC++);break;
         case (0xA3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2244,6 +2420,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xA3<<3)|5: c->A=c->X=_GD();_NZ(c->A);_FETCH();break;
         case (0xA3<<3)|6: assert(false);break;
         case (0xA3<<3)|7: assert(false);break;
+#endif
     /* LDY zp */
         case (0xA4<<3)|0: _SA(c->PC++);break;
         case (0xA4<<3)|1: _SA(_GD());break;
@@ -2271,6 +2448,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xA6<<3)|5: assert(false);break;
         case (0xA6<<3)|6: assert(false);break;
         case (0xA6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX zp (undoc) */
         case (0xA7<<3)|0: _SA(c->PC++);break;
         case (0xA7<<3)|1: _SA(_GD());break;
@@ -2280,6 +2458,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xA7<<3)|5: assert(false);break;
         case (0xA7<<3)|6: assert(false);break;
         case (0xA7<<3)|7: assert(false);break;
+#endif
     /* TAY  */
         case (0xA8<<3)|0: _SA(c->PC);break;
         case (0xA8<<3)|1: c->Y=c->A;_NZ(c->Y);_FETCH();break;
@@ -2307,6 +2486,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xAA<<3)|5: assert(false);break;
         case (0xAA<<3)|6: assert(false);break;
         case (0xAA<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LXA # (undoc) */
         case (0xAB<<3)|0: _SA(c->PC++);break;
         case (0xAB<<3)|1: c->A=c->X=(c->A|0xEE)&_GD();_NZ(c->A);_FETCH();break;
@@ -2316,6 +2496,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xAB<<3)|5: assert(false);break;
         case (0xAB<<3)|6: assert(false);break;
         case (0xAB<<3)|7: assert(false);break;
+#endif
     /* LDY abs */
         case (0xAC<<3)|0: _SA(c->PC++);break;
         case (0xAC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2343,6 +2524,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xAE<<3)|5: assert(false);break;
         case (0xAE<<3)|6: assert(false);break;
         case (0xAE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX abs (undoc) */
         case (0xAF<<3)|0: _SA(c->PC++);break;
         case (0xAF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2352,6 +2534,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xAF<<3)|5: assert(false);break;
         case (0xAF<<3)|6: assert(false);break;
         case (0xAF<<3)|7: assert(false);break;
+#endif
     /* BCS # */
         case (0xB0<<3)|0: _SA(c->PC++);break;
         case (0xB0<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x1)!=0x1){_FETCH();};break;
@@ -2379,6 +2562,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xB2<<3)|5: assert(false);break;
         case (0xB2<<3)|6: assert(false);break;
         case (0xB2<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX (zp),Y (undoc) */
         case (0xB3<<3)|0: _SA(c->PC++);break;
         case (0xB3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2388,6 +2572,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xB3<<3)|5: c->A=c->X=_GD();_NZ(c->A);_FETCH();break;
         case (0xB3<<3)|6: assert(false);break;
         case (0xB3<<3)|7: assert(false);break;
+#endif
     /* LDY zp,X */
         case (0xB4<<3)|0: _SA(c->PC++);break;
         case (0xB4<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2415,6 +2600,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xB6<<3)|5: assert(false);break;
         case (0xB6<<3)|6: assert(false);break;
         case (0xB6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX zp,Y (undoc) */
         case (0xB7<<3)|0: _SA(c->PC++);break;
         case (0xB7<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2424,6 +2610,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xB7<<3)|5: assert(false);break;
         case (0xB7<<3)|6: assert(false);break;
         case (0xB7<<3)|7: assert(false);break;
+#endif
     /* CLV  */
         case (0xB8<<3)|0: _SA(c->PC);break;
         case (0xB8<<3)|1: c->P&=~0x40;_FETCH();break;
@@ -2451,6 +2638,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xBA<<3)|5: assert(false);break;
         case (0xBA<<3)|6: assert(false);break;
         case (0xBA<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAS abs,Y (undoc) */
         case (0xBB<<3)|0: _SA(c->PC++);break;
         case (0xBB<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2460,6 +2648,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xBB<<3)|5: assert(false);break;
         case (0xBB<<3)|6: assert(false);break;
         case (0xBB<<3)|7: assert(false);break;
+#endif
     /* LDY abs,X */
         case (0xBC<<3)|0: _SA(c->PC++);break;
         case (0xBC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2487,6 +2676,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xBE<<3)|5: assert(false);break;
         case (0xBE<<3)|6: assert(false);break;
         case (0xBE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* LAX abs,Y (undoc) */
         case (0xBF<<3)|0: _SA(c->PC++);break;
         case (0xBF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2496,6 +2686,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xBF<<3)|5: assert(false);break;
         case (0xBF<<3)|6: assert(false);break;
         case (0xBF<<3)|7: assert(false);break;
+#endif
     /* CPY # */
         case (0xC0<<3)|0: _SA(c->PC++);break;
         case (0xC0<<3)|1: _m6502_cmp(c, c->Y, _GD());_FETCH();break;
@@ -2514,6 +2705,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xC1<<3)|5: _m6502_cmp(c, c->A, _GD());_FETCH();break;
         case (0xC1<<3)|6: assert(false);break;
         case (0xC1<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP # (undoc) */
         case (0xC2<<3)|0: _SA(c->PC++);break;
         case (0xC2<<3)|1: _FETCH();break;
@@ -2523,6 +2715,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xC2<<3)|5: assert(false);break;
         case (0xC2<<3)|6: assert(false);break;
         case (0xC2<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* DCP (zp,X) (undoc) */
         case (0xC3<<3)|0: _SA(c->PC++);break;
         case (0xC3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2532,6 +2726,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xC3<<3)|5: c->AD=_GD();_WR();break;
         case (0xC3<<3)|6: c->AD--;_NZ(c->AD);_SD(c->AD);_m6502_cmp(c, c->A, c->AD);_WR();break;
         case (0xC3<<3)|7: _FETCH();break;
+#endif
     /* CPY zp */
         case (0xC4<<3)|0: _SA(c->PC++);break;
         case (0xC4<<3)|1: _SA(_GD());break;
@@ -2559,6 +2754,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xC6<<3)|5: assert(false);break;
         case (0xC6<<3)|6: assert(false);break;
         case (0xC6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* DCP zp (undoc) */
         case (0xC7<<3)|0: _SA(c->PC++);break;
         case (0xC7<<3)|1: _SA(_GD());break;
@@ -2568,6 +2764,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xC7<<3)|5: assert(false);break;
         case (0xC7<<3)|6: assert(false);break;
         case (0xC7<<3)|7: assert(false);break;
+#endif
     /* INY  */
         case (0xC8<<3)|0: _SA(c->PC);break;
         case (0xC8<<3)|1: c->Y++;_NZ(c->Y);_FETCH();break;
@@ -2595,6 +2792,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xCA<<3)|5: assert(false);break;
         case (0xCA<<3)|6: assert(false);break;
         case (0xCA<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SBX # (undoc) */
         case (0xCB<<3)|0: _SA(c->PC++);break;
         case (0xCB<<3)|1: _m6502_sbx(c, _GD());_FETCH();break;
@@ -2604,6 +2802,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xCB<<3)|5: assert(false);break;
         case (0xCB<<3)|6: assert(false);break;
         case (0xCB<<3)|7: assert(false);break;
+#endif
     /* CPY abs */
         case (0xCC<<3)|0: _SA(c->PC++);break;
         case (0xCC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2631,6 +2830,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xCE<<3)|5: _FETCH();break;
         case (0xCE<<3)|6: assert(false);break;
         case (0xCE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* DCP abs (undoc) */
         case (0xCF<<3)|0: _SA(c->PC++);break;
         case (0xCF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2640,6 +2840,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xCF<<3)|5: _FETCH();break;
         case (0xCF<<3)|6: assert(false);break;
         case (0xCF<<3)|7: assert(false);break;
+#endif
     /* BNE # */
         case (0xD0<<3)|0: _SA(c->PC++);break;
         case (0xD0<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x2)!=0x0){_FETCH();};break;
@@ -2667,6 +2868,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD2<<3)|5: assert(false);break;
         case (0xD2<<3)|6: assert(false);break;
         case (0xD2<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* DCP (zp),Y (undoc) */
         case (0xD3<<3)|0: _SA(c->PC++);break;
         case (0xD3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2676,6 +2878,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD3<<3)|5: c->AD=_GD();_WR();break;
         case (0xD3<<3)|6: c->AD--;_NZ(c->AD);_SD(c->AD);_m6502_cmp(c, c->A, c->AD);_WR();break;
         case (0xD3<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0xD4<<3)|0: _SA(c->PC++);break;
         case (0xD4<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2685,6 +2889,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD4<<3)|5: assert(false);break;
         case (0xD4<<3)|6: assert(false);break;
         case (0xD4<<3)|7: assert(false);break;
+#endif
     /* CMP zp,X */
         case (0xD5<<3)|0: _SA(c->PC++);break;
         case (0xD5<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2703,6 +2908,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD6<<3)|5: _FETCH();break;
         case (0xD6<<3)|6: assert(false);break;
         case (0xD6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* DCP zp,X (undoc) */
         case (0xD7<<3)|0: _SA(c->PC++);break;
         case (0xD7<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2712,6 +2918,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD7<<3)|5: _FETCH();break;
         case (0xD7<<3)|6: assert(false);break;
         case (0xD7<<3)|7: assert(false);break;
+#endif
     /* CLD  */
         case (0xD8<<3)|0: _SA(c->PC);break;
         case (0xD8<<3)|1: c->P&=~0x8;_FETCH();break;
@@ -2730,6 +2937,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xD9<<3)|5: assert(false);break;
         case (0xD9<<3)|6: assert(false);break;
         case (0xD9<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0xDA<<3)|0: _SA(c->PC);break;
         case (0xDA<<3)|1: _FETCH();break;
@@ -2739,6 +2947,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xDA<<3)|5: assert(false);break;
         case (0xDA<<3)|6: assert(false);break;
         case (0xDA<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* DCP abs,Y (undoc) */
         case (0xDB<<3)|0: _SA(c->PC++);break;
         case (0xDB<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2748,6 +2958,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xDB<<3)|5: c->AD--;_NZ(c->AD);_SD(c->AD);_m6502_cmp(c, c->A, c->AD);_WR();break;
         case (0xDB<<3)|6: _FETCH();break;
         case (0xDB<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0xDC<<3)|0: _SA(c->PC++);break;
         case (0xDC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2757,6 +2969,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xDC<<3)|5: assert(false);break;
         case (0xDC<<3)|6: assert(false);break;
         case (0xDC<<3)|7: assert(false);break;
+#endif
     /* CMP abs,X */
         case (0xDD<<3)|0: _SA(c->PC++);break;
         case (0xDD<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2775,6 +2988,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xDE<<3)|5: c->AD--;_NZ(c->AD);_SD(c->AD);_WR();break;
         case (0xDE<<3)|6: _FETCH();break;
         case (0xDE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* DCP abs,X (undoc) */
         case (0xDF<<3)|0: _SA(c->PC++);break;
         case (0xDF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2784,6 +2998,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xDF<<3)|5: c->AD--;_NZ(c->AD);_SD(c->AD);_m6502_cmp(c, c->A, c->AD);_WR();break;
         case (0xDF<<3)|6: _FETCH();break;
         case (0xDF<<3)|7: assert(false);break;
+#endif
     /* CPX # */
         case (0xE0<<3)|0: _SA(c->PC++);break;
         case (0xE0<<3)|1: _m6502_cmp(c, c->X, _GD());_FETCH();break;
@@ -2802,6 +3017,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xE1<<3)|5: _m6502_sbc(c,_GD());_FETCH();break;
         case (0xE1<<3)|6: assert(false);break;
         case (0xE1<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP # (undoc) */
         case (0xE2<<3)|0: _SA(c->PC++);break;
         case (0xE2<<3)|1: _FETCH();break;
@@ -2811,6 +3027,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xE2<<3)|5: assert(false);break;
         case (0xE2<<3)|6: assert(false);break;
         case (0xE2<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* ISB (zp,X) (undoc) */
         case (0xE3<<3)|0: _SA(c->PC++);break;
         case (0xE3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2820,6 +3038,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xE3<<3)|5: c->AD=_GD();_WR();break;
         case (0xE3<<3)|6: c->AD++;_SD(c->AD);_m6502_sbc(c,c->AD);_WR();break;
         case (0xE3<<3)|7: _FETCH();break;
+#endif
     /* CPX zp */
         case (0xE4<<3)|0: _SA(c->PC++);break;
         case (0xE4<<3)|1: _SA(_GD());break;
@@ -2847,6 +3066,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xE6<<3)|5: assert(false);break;
         case (0xE6<<3)|6: assert(false);break;
         case (0xE6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ISB zp (undoc) */
         case (0xE7<<3)|0: _SA(c->PC++);break;
         case (0xE7<<3)|1: _SA(_GD());break;
@@ -2856,6 +3076,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xE7<<3)|5: assert(false);break;
         case (0xE7<<3)|6: assert(false);break;
         case (0xE7<<3)|7: assert(false);break;
+#endif
     /* INX  */
         case (0xE8<<3)|0: _SA(c->PC);break;
         case (0xE8<<3)|1: c->X++;_NZ(c->X);_FETCH();break;
@@ -2883,6 +3104,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xEA<<3)|5: assert(false);break;
         case (0xEA<<3)|6: assert(false);break;
         case (0xEA<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* SBC # (undoc) */
         case (0xEB<<3)|0: _SA(c->PC++);break;
         case (0xEB<<3)|1: _m6502_sbc(c,_GD());_FETCH();break;
@@ -2892,6 +3114,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xEB<<3)|5: assert(false);break;
         case (0xEB<<3)|6: assert(false);break;
         case (0xEB<<3)|7: assert(false);break;
+#endif
     /* CPX abs */
         case (0xEC<<3)|0: _SA(c->PC++);break;
         case (0xEC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2919,6 +3142,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xEE<<3)|5: _FETCH();break;
         case (0xEE<<3)|6: assert(false);break;
         case (0xEE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ISB abs (undoc) */
         case (0xEF<<3)|0: _SA(c->PC++);break;
         case (0xEF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -2928,6 +3152,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xEF<<3)|5: _FETCH();break;
         case (0xEF<<3)|6: assert(false);break;
         case (0xEF<<3)|7: assert(false);break;
+#endif
     /* BEQ # */
         case (0xF0<<3)|0: _SA(c->PC++);break;
         case (0xF0<<3)|1: _SA(c->PC);c->AD=c->PC+(int8_t)_GD();if((c->P&0x2)!=0x2){_FETCH();};break;
@@ -2955,6 +3180,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF2<<3)|5: assert(false);break;
         case (0xF2<<3)|6: assert(false);break;
         case (0xF2<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ISB (zp),Y (undoc) */
         case (0xF3<<3)|0: _SA(c->PC++);break;
         case (0xF3<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2964,6 +3190,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF3<<3)|5: c->AD=_GD();_WR();break;
         case (0xF3<<3)|6: c->AD++;_SD(c->AD);_m6502_sbc(c,c->AD);_WR();break;
         case (0xF3<<3)|7: _FETCH();break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP zp,X (undoc) */
         case (0xF4<<3)|0: _SA(c->PC++);break;
         case (0xF4<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2973,6 +3201,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF4<<3)|5: assert(false);break;
         case (0xF4<<3)|6: assert(false);break;
         case (0xF4<<3)|7: assert(false);break;
+#endif
     /* SBC zp,X */
         case (0xF5<<3)|0: _SA(c->PC++);break;
         case (0xF5<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -2991,6 +3220,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF6<<3)|5: _FETCH();break;
         case (0xF6<<3)|6: assert(false);break;
         case (0xF6<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ISB zp,X (undoc) */
         case (0xF7<<3)|0: _SA(c->PC++);break;
         case (0xF7<<3)|1: c->AD=_GD();_SA(c->AD);break;
@@ -3000,6 +3230,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF7<<3)|5: _FETCH();break;
         case (0xF7<<3)|6: assert(false);break;
         case (0xF7<<3)|7: assert(false);break;
+#endif
     /* SED  */
         case (0xF8<<3)|0: _SA(c->PC);break;
         case (0xF8<<3)|1: c->P|=0x8;_FETCH();break;
@@ -3018,6 +3249,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xF9<<3)|5: assert(false);break;
         case (0xF9<<3)|6: assert(false);break;
         case (0xF9<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* NOP  (undoc) */
         case (0xFA<<3)|0: _SA(c->PC);break;
         case (0xFA<<3)|1: _FETCH();break;
@@ -3027,6 +3259,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xFA<<3)|5: assert(false);break;
         case (0xFA<<3)|6: assert(false);break;
         case (0xFA<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* ISB abs,Y (undoc) */
         case (0xFB<<3)|0: _SA(c->PC++);break;
         case (0xFB<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -3036,6 +3270,8 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xFB<<3)|5: c->AD++;_SD(c->AD);_m6502_sbc(c,c->AD);_WR();break;
         case (0xFB<<3)|6: _FETCH();break;
         case (0xFB<<3)|7: assert(false);break;
+#endif
+#if !defined(M6502_NO_UNDOC)
     /* NOP abs,X (undoc) */
         case (0xFC<<3)|0: _SA(c->PC++);break;
         case (0xFC<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -3045,6 +3281,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xFC<<3)|5: assert(false);break;
         case (0xFC<<3)|6: assert(false);break;
         case (0xFC<<3)|7: assert(false);break;
+#endif
     /* SBC abs,X */
         case (0xFD<<3)|0: _SA(c->PC++);break;
         case (0xFD<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -3063,6 +3300,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xFE<<3)|5: c->AD++;_NZ(c->AD);_SD(c->AD);_WR();break;
         case (0xFE<<3)|6: _FETCH();break;
         case (0xFE<<3)|7: assert(false);break;
+#if !defined(M6502_NO_UNDOC)
     /* ISB abs,X (undoc) */
         case (0xFF<<3)|0: _SA(c->PC++);break;
         case (0xFF<<3)|1: _SA(c->PC++);c->AD=_GD();break;
@@ -3072,9 +3310,17 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
         case (0xFF<<3)|5: c->AD++;_SD(c->AD);_m6502_sbc(c,c->AD);_WR();break;
         case (0xFF<<3)|6: _FETCH();break;
         case (0xFF<<3)|7: assert(false);break;
+#endif
 
+#if defined(M6502_NO_UNDOC)
+        default:
+            // a compiled-out undocumented instruction, same as the JAM opcodes
+            _SAD(0xFFFF,0xFF);c->IR--;break;
+#endif
     }
+    #if !defined(M6502_NO_IO_PORT)
     M6510_SET_PORT(pins, c->io_pins);
+    #endif
     c->PINS = pins;
     c->irq_pip <<= 1;
     c->nmi_pip <<= 1;
@@ -3085,6 +3331,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
 #endif
 
 #undef _SA
+#undef _GA
 #undef _SAD
 #undef _FETCH
 #undef _SD
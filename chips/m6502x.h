@@ -0,0 +1,2719 @@
+#pragma once
+/*#
+    # m6502x.h
+
+    Multi-lane MOS Technology 6502 CPU emulator for running many
+    identical machines in lockstep.
+
+    Project repo: https://github.com/floooh/chips/
+
+    NOTE: this file is code-generated from m6502x.template.h and m6502_gen.py
+    in the 'codegen' directory.
+
+    Do this:
+    ~~~C
+    #define CHIPS_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    You need to include the following header before including m6502x.h,
+    and in the implementation file, the m6502.h implementation must
+    be included before the m6502x.h implementation:
+
+        - m6502.h
+
+    Optionally provide the following macros with your own implementation
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+
+    ## Overview
+
+    m6502x.h is the same cycle-stepped 6502 emulation as m6502.h, but
+    instead of one CPU state, the m6502x_t struct holds the register
+    state of up to M6502X_MAX_LANES CPUs ('lanes') in a structure-of-arrays
+    layout, and m6502x_tick() ticks all lanes with a single call.
+
+    Decoder steps are dispatched once for each run of adjacent lanes which
+    are at the same decoder step (e.g. all lanes execute the same code
+    with different input data), the decoder step is then executed in a
+    tight loop over the lanes' register arrays which the compiler can
+    vectorize. When lanes diverge, m6502x_tick() automatically
+    falls back to dispatching smaller runs of lanes, down to one dispatch
+    per lane.
+
+    Each lane is bit-identical with a m6502_t instance created with the same
+    bcd_disabled setting. The 6510 IO port is not supported.
+
+    ## Functions
+
+    ~~~C
+    void m6502x_init(m6502x_t* cpu, const m6502x_desc_t* desc, uint64_t* pins)
+    ~~~
+        Initialize a m6502x_t instance, the desc structure provides
+        initialization attributes:
+            ~~~C
+            typedef struct {
+                int num_lanes;      // number of CPU lanes (1..M6502X_MAX_LANES)
+                bool bcd_disabled;  // set to true if BCD mode is disabled
+            } m6502x_desc_t;
+            ~~~
+        The pins argument must point to an array of num_lanes pin masks,
+        which will be initialized with the initial pin state of each lane.
+
+    ~~~C
+    void m6502x_tick(m6502x_t* cpu, uint64_t* pins)
+    ~~~
+        Tick all lanes for one clock cycle. The pins array holds one pin mask
+        per lane which is both the input and output of the tick function,
+        memory requests must be handled per lane exactly like with m6502_tick().
+
+    ~~~C
+    void m6502x_get_lane(const m6502x_t* cpu, int lane, m6502_t* out)
+    void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* src)
+    ~~~
+        Copy the CPU state of a lane into a m6502_t, or overwrite the
+        state of a lane from a m6502_t (for instance to seed all lanes
+        from a snapshot, or to inspect a lane in the debugging UI).
+
+    ## HOWTO
+
+    Run many VIC-20-style machines in lockstep with per-lane memory:
+    ~~~C
+        static m6502x_t cpu;
+        uint64_t pins[NUM_LANES];
+        m6502x_init(&cpu, &(m6502x_desc_t){ .num_lanes = NUM_LANES }, pins);
+        while (...) {
+            m6502x_tick(&cpu, pins);
+            for (int i = 0; i < NUM_LANES; i++) {
+                const uint16_t addr = M6502_GET_ADDR(pins[i]);
+                if (pins[i] & M6502_RW) {
+                    M6502_SET_DATA(pins[i], mem[i][addr]);
+                }
+                else {
+                    mem[i][addr] = M6502_GET_DATA(pins[i]);
+                }
+            }
+        }
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define M6502X_MAX_LANES (64)
+
+/* the desc structure provided to m6502x_init() */
+typedef struct {
+    int num_lanes;      /* number of CPU lanes (1..M6502X_MAX_LANES) */
+    bool bcd_disabled;  /* set to true if BCD mode is disabled */
+} m6502x_desc_t;
+
+/* multi-lane CPU state, each array item is one lane */
+typedef struct {
+    int num_lanes;
+    uint8_t bcd_enabled;
+    uint16_t IR[M6502X_MAX_LANES];
+    uint16_t PC[M6502X_MAX_LANES];
+    uint16_t AD[M6502X_MAX_LANES];
+    uint8_t A[M6502X_MAX_LANES];
+    uint8_t X[M6502X_MAX_LANES];
+    uint8_t Y[M6502X_MAX_LANES];
+    uint8_t S[M6502X_MAX_LANES];
+    uint8_t P[M6502X_MAX_LANES];
+    uint64_t PINS[M6502X_MAX_LANES];
+    uint16_t irq_pip[M6502X_MAX_LANES];
+    uint16_t nmi_pip[M6502X_MAX_LANES];
+    uint8_t brk_flags[M6502X_MAX_LANES];
+} m6502x_t;
+
+/* initialize a new m6502x instance, and initial pin masks (one per lane) */
+void m6502x_init(m6502x_t* cpu, const m6502x_desc_t* desc, uint64_t* pins);
+/* execute one tick on all lanes */
+void m6502x_tick(m6502x_t* cpu, uint64_t* pins);
+/* copy the state of one lane into a m6502_t */
+void m6502x_get_lane(const m6502x_t* cpu, int lane, m6502_t* out);
+/* overwrite the state of one lane from a m6502_t */
+void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* src);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void m6502x_init(m6502x_t* c, const m6502x_desc_t* desc, uint64_t* pins) {
+    CHIPS_ASSERT(c && desc && pins);
+    CHIPS_ASSERT((desc->num_lanes > 0) && (desc->num_lanes <= M6502X_MAX_LANES));
+    memset(c, 0, sizeof(*c));
+    c->num_lanes = desc->num_lanes;
+    c->bcd_enabled = !desc->bcd_disabled;
+    for (int i = 0; i < c->num_lanes; i++) {
+        c->P[i] = M6502_ZF;
+        c->PINS[i] = M6502_RW | M6502_SYNC | M6502_RES;
+        pins[i] = c->PINS[i];
+    }
+}
+
+void m6502x_get_lane(const m6502x_t* c, int i, m6502_t* out) {
+    CHIPS_ASSERT(c && out && (i >= 0) && (i < c->num_lanes));
+    memset(out, 0, sizeof(*out));
+    out->IR = c->IR[i];
+    out->PC = c->PC[i];
+    out->AD = c->AD[i];
+    out->A = c->A[i];
+    out->X = c->X[i];
+    out->Y = c->Y[i];
+    out->S = c->S[i];
+    out->P = c->P[i];
+    out->PINS = c->PINS[i];
+    out->irq_pip = c->irq_pip[i];
+    out->nmi_pip = c->nmi_pip[i];
+    out->brk_flags = c->brk_flags[i];
+    out->bcd_enabled = c->bcd_enabled;
+}
+
+void m6502x_set_lane(m6502x_t* c, int i, const m6502_t* src) {
+    CHIPS_ASSERT(c && src && (i >= 0) && (i < c->num_lanes));
+    c->IR[i] = src->IR;
+    c->PC[i] = src->PC;
+    c->AD[i] = src->AD;
+    c->A[i] = src->A;
+    c->X[i] = src->X;
+    c->Y[i] = src->Y;
+    c->S[i] = src->S;
+    c->P[i] = src->P;
+    c->PINS[i] = src->PINS;
+    c->irq_pip[i] = src->irq_pip;
+    c->nmi_pip[i] = src->nmi_pip;
+    c->brk_flags[i] = src->brk_flags;
+}
+
+/* ALU helpers, these forward to the m6502.h implementation through
+   a temporary m6502_t which the compiler resolves into registers
+*/
+static inline void _m6502x_adc(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_adc(&t, v);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_sbc(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_sbc(&t, v);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_cmp(m6502x_t* c, int i, uint8_t r, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    _m6502_cmp(&t, r, v);
+    c->P[i] = t.P;
+}
+
+static inline uint8_t _m6502x_asl(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_asl(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_lsr(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_lsr(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_rol(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_rol(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_ror(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_ror(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline void _m6502x_bit(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i];
+    _m6502_bit(&t, v);
+    c->P[i] = t.P;
+}
+
+static inline void _m6502x_arr(m6502x_t* c, int i) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_arr(&t);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_sbx(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.X = c->X[i]; t.P = c->P[i];
+    _m6502_sbx(&t, v);
+    c->X[i] = t.X; c->P[i] = t.P;
+}
+
+/* set 16-bit address in 64-bit pin mask */
+#define _SA(addr) pins[i]=(pins[i]&~0xFFFF)|((addr)&0xFFFFULL)
+/* extract 16-bit addess from pin mask */
+#define _GA() ((uint16_t)(pins[i]&0xFFFFULL))
+/* set 16-bit address and 8-bit data in 64-bit pin mask */
+#define _SAD(addr,data) pins[i]=(pins[i]&~0xFFFFFF)|((((data)&0xFF)<<16)&0xFF0000ULL)|((addr)&0xFFFFULL)
+/* fetch next opcode byte */
+#define _FETCH() _SA(c->PC[i]);_ON(M6502_SYNC);
+/* set 8-bit data in 64-bit pin mask */
+#define _SD(data) pins[i]=((pins[i]&~0xFF0000ULL)|(((data&0xFF)<<16)&0xFF0000ULL))
+/* extract 8-bit data from 64-bit pin mask */
+#define _GD() ((uint8_t)((pins[i]&0xFF0000ULL)>>16))
+/* enable control pins */
+#define _ON(m) pins[i]|=(m)
+/* disable control pins */
+#define _OFF(m) pins[i]&=~(m)
+/* a memory read tick */
+#define _RD() _ON(M6502_RW);
+/* a memory write tick */
+#define _WR() _OFF(M6502_RW);
+/* set N and Z flags depending on value */
+#define _NZ(v) c->P[i]=((c->P[i]&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+/* start of a lane's decoder step: advance the step counter, reads are default, writes are special */
+#define _BEGIN() c->IR[i]++;_RD();
+/* end of a lane's decoder step (there's no 6510 IO port, so the port bits are cleared) */
+#define _END() pins[i]&=~M6510_PORT_BITS;c->PINS[i]=pins[i];c->irq_pip[i]<<=1;c->nmi_pip[i]<<=1;
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4244)   /* conversion from 'uint16_t' to 'uint8_t', possible loss of data */
+#endif
+
+/* interrupt detection, RDY and instruction fetch for one lane, same as
+   the code at the start of m6502_tick(), returns false if the lane
+   is stalled by the RDY pin in this tick
+*/
+static inline bool _m6502x_begin_tick(m6502x_t* c, uint64_t* pins, int i) {
+    if (pins[i] & (M6502_SYNC|M6502_IRQ|M6502_NMI|M6502_RDY|M6502_RES)) {
+        // NMI is edge-triggered
+        if (0 != ((pins[i] & (pins[i] ^ c->PINS[i])) & M6502_NMI)) {
+            c->nmi_pip[i] |= 0x100;
+        }
+        // IRQ test is level triggered
+        if ((pins[i] & M6502_IRQ) && (0 == (c->P[i] & M6502_IF))) {
+            c->irq_pip[i] |= 0x100;
+        }
+        // RDY pin is only checked during read cycles
+        if ((pins[i] & (M6502_RW|M6502_RDY)) == (M6502_RW|M6502_RDY)) {
+            pins[i] &= ~M6510_PORT_BITS;
+            c->PINS[i] = pins[i];
+            c->irq_pip[i] <<= 1;
+            return false;
+        }
+        if (pins[i] & M6502_SYNC) {
+            // load new instruction into 'instruction register' and restart tick counter
+            c->IR[i] = _GD()<<3;
+            _OFF(M6502_SYNC);
+            if (0 != (c->irq_pip[i] & 0x400)) {
+                c->brk_flags[i] |= M6502_BRK_IRQ;
+            }
+            if (0 != (c->nmi_pip[i] & 0xFC00)) {
+                c->brk_flags[i] |= M6502_BRK_NMI;
+            }
+            if (0 != (pins[i] & M6502_RES)) {
+                c->brk_flags[i] |= M6502_BRK_RESET;
+            }
+            c->irq_pip[i] &= 0x3FF;
+            c->nmi_pip[i] &= 0x3FF;
+            // if interrupt or reset was requested, force a BRK instruction
+            if (c->brk_flags[i]) {
+                c->IR[i] = 0;
+                c->P[i] &= ~M6502_BF;
+                pins[i] &= ~M6502_RES;
+            }
+            else {
+                c->PC[i]++;
+            }
+        }
+    }
+    return true;
+}
+
+/* execute the decoder step 'ir' on the lanes i0..i1 (exclusive) */
+static void _m6502x_step(m6502x_t* c, uint64_t* pins, uint16_t ir, int i0, int i1) {
+    switch (ir) {
+    /* BRK  */
+        case (0x00<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x00<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()if(0==(c->brk_flags[i]&(M6502_BRK_IRQ|M6502_BRK_NMI))){c->PC[i]++;}_SAD(0x0100|c->S[i]--,c->PC[i]>>8);if(0==(c->brk_flags[i]&M6502_BRK_RESET)){_WR();}_END() } break;
+        case (0x00<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->PC[i]);if(0==(c->brk_flags[i]&M6502_BRK_RESET)){_WR();}_END() } break;
+        case (0x00<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->P[i]|M6502_XF);if(c->brk_flags[i]&M6502_BRK_RESET){c->AD[i]=0xFFFC;}else{_WR();if(c->brk_flags[i]&M6502_BRK_NMI){c->AD[i]=0xFFFA;}else{c->AD[i]=0xFFFE;}}_END() } break;
+        case (0x00<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]++);c->P[i]|=(M6502_IF|M6502_BF);c->brk_flags[i]=0; /* RES/NMI hijacking */_END() } break;
+        case (0x00<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]);c->AD[i]=_GD(); /* NMI "half-hijacking" not possible */_END() } break;
+        case (0x00<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_FETCH();_END() } break;
+        case (0x00<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA (zp,X) */
+        case (0x01<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x01<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x01<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x01<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x01<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x01<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x01<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x01<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x02<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x02<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x02<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x02<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x02<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x02<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x02<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x02<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO (zp,X) (undoc) */
+        case (0x03<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x03<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x03<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x03<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x03<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x03<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x03<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x03<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp (undoc) */
+        case (0x04<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x04<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x04<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x04<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x04<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x04<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x04<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x04<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA zp */
+        case (0x05<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x05<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x05<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x05<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x05<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x05<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x05<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x05<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASL zp */
+        case (0x06<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x06<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x06<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x06<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_asl(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x06<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x06<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x06<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x06<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO zp (undoc) */
+        case (0x07<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x07<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x07<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x07<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x07<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x07<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x07<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x07<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* PHP  */
+        case (0x08<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x08<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->P[i]|M6502_XF);_WR();_END() } break;
+        case (0x08<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x08<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x08<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x08<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x08<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x08<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA # */
+        case (0x09<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x09<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x09<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x09<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x09<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x09<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x09<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x09<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASLA  */
+        case (0x0A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x0A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_m6502x_asl(c,i,c->A[i]);_FETCH();_END() } break;
+        case (0x0A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ANC # (undoc) */
+        case (0x0B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x0B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);if(c->A[i]&0x80){c->P[i]|=M6502_CF;}else{c->P[i]&=~M6502_CF;}_FETCH();_END() } break;
+        case (0x0B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs (undoc) */
+        case (0x0C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x0C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x0C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x0C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x0C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA abs */
+        case (0x0D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x0D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x0D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x0D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x0D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASL abs */
+        case (0x0E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x0E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x0E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x0E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x0E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_asl(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x0E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x0E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO abs (undoc) */
+        case (0x0F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x0F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x0F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x0F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x0F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x0F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x0F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x0F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BPL # */
+        case (0x10<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x10<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x80)!=0x0){_FETCH();};_END() } break;
+        case (0x10<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0x10<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0x10<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x10<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x10<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x10<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA (zp),Y */
+        case (0x11<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x11<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x11<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x11<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x11<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x11<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x11<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x11<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x12<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x12<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x12<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x12<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x12<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x12<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x12<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x12<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO (zp),Y (undoc) */
+        case (0x13<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x13<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x13<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x13<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x13<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x13<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x13<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x13<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0x14<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x14<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x14<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x14<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x14<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x14<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x14<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x14<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA zp,X */
+        case (0x15<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x15<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x15<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x15<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x15<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x15<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x15<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x15<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASL zp,X */
+        case (0x16<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x16<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x16<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x16<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x16<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_asl(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x16<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x16<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x16<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO zp,X (undoc) */
+        case (0x17<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x17<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x17<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x17<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x17<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x17<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x17<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x17<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CLC  */
+        case (0x18<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x18<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]&=~0x1;_FETCH();_END() } break;
+        case (0x18<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x18<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x18<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x18<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x18<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x18<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA abs,Y */
+        case (0x19<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x19<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x19<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x19<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x19<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x19<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x19<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x19<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0x1A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x1A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x1A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO abs,Y (undoc) */
+        case (0x1B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x1B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x1B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x1B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x1B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x1B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x1B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x1B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0x1C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x1C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x1C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x1C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x1C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x1C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ORA abs,X */
+        case (0x1D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x1D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x1D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x1D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x1D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]|=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x1D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x1D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASL abs,X */
+        case (0x1E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x1E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x1E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x1E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x1E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x1E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_asl(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x1E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x1E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SLO abs,X (undoc) */
+        case (0x1F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x1F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x1F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x1F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x1F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x1F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_asl(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]|=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x1F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x1F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JSR  */
+        case (0x20<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x20<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]);c->AD[i]=_GD();_END() } break;
+        case (0x20<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->PC[i]>>8);_WR();_END() } break;
+        case (0x20<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->PC[i]);_WR();_END() } break;
+        case (0x20<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x20<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_FETCH();_END() } break;
+        case (0x20<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x20<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND (zp,X) */
+        case (0x21<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x21<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x21<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x21<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x21<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x21<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x21<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x21<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x22<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x22<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x22<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x22<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x22<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x22<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x22<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x22<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA (zp,X) (undoc) */
+        case (0x23<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x23<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x23<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x23<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x23<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x23<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x23<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x23<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* BIT zp */
+        case (0x24<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x24<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x24<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_bit(c,i,_GD());_FETCH();_END() } break;
+        case (0x24<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x24<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x24<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x24<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x24<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND zp */
+        case (0x25<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x25<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x25<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x25<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x25<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x25<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x25<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x25<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROL zp */
+        case (0x26<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x26<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x26<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x26<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_rol(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x26<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x26<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x26<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x26<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA zp (undoc) */
+        case (0x27<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x27<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x27<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x27<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x27<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x27<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x27<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x27<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* PLP  */
+        case (0x28<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x28<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x28<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]);_END() } break;
+        case (0x28<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]=(_GD()|M6502_BF)&~M6502_XF;_FETCH();_END() } break;
+        case (0x28<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x28<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x28<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x28<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND # */
+        case (0x29<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x29<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x29<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x29<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x29<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x29<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x29<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x29<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROLA  */
+        case (0x2A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x2A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_m6502x_rol(c,i,c->A[i]);_FETCH();_END() } break;
+        case (0x2A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ANC # (undoc) */
+        case (0x2B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x2B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);if(c->A[i]&0x80){c->P[i]|=M6502_CF;}else{c->P[i]&=~M6502_CF;}_FETCH();_END() } break;
+        case (0x2B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BIT abs */
+        case (0x2C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x2C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x2C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x2C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_bit(c,i,_GD());_FETCH();_END() } break;
+        case (0x2C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND abs */
+        case (0x2D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x2D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x2D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x2D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x2D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROL abs */
+        case (0x2E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x2E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x2E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x2E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x2E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_rol(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x2E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x2E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA abs (undoc) */
+        case (0x2F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x2F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x2F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x2F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x2F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x2F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x2F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x2F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BMI # */
+        case (0x30<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x30<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x80)!=0x80){_FETCH();};_END() } break;
+        case (0x30<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0x30<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0x30<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x30<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x30<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x30<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND (zp),Y */
+        case (0x31<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x31<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x31<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x31<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x31<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x31<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x31<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x31<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x32<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x32<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x32<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x32<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x32<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x32<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x32<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x32<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA (zp),Y (undoc) */
+        case (0x33<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x33<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x33<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x33<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x33<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x33<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x33<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x33<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0x34<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x34<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x34<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x34<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x34<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x34<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x34<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x34<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND zp,X */
+        case (0x35<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x35<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x35<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x35<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x35<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x35<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x35<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x35<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROL zp,X */
+        case (0x36<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x36<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x36<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x36<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x36<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_rol(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x36<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x36<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x36<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA zp,X (undoc) */
+        case (0x37<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x37<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x37<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x37<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x37<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x37<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x37<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x37<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SEC  */
+        case (0x38<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x38<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]|=0x1;_FETCH();_END() } break;
+        case (0x38<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x38<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x38<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x38<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x38<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x38<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND abs,Y */
+        case (0x39<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x39<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x39<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x39<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x39<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x39<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x39<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x39<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0x3A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x3A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x3A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA abs,Y (undoc) */
+        case (0x3B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x3B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x3B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x3B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x3B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x3B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x3B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x3B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0x3C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x3C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x3C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x3C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x3C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x3C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* AND abs,X */
+        case (0x3D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x3D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x3D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x3D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x3D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x3D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x3D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROL abs,X */
+        case (0x3E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x3E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x3E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x3E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x3E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x3E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_rol(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x3E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x3E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RLA abs,X (undoc) */
+        case (0x3F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x3F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x3F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x3F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x3F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x3F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_rol(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]&=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x3F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x3F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RTI  */
+        case (0x40<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x40<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x40<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x40<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);c->P[i]=(_GD()|M6502_BF)&~M6502_XF;_END() } break;
+        case (0x40<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]);c->AD[i]=_GD();_END() } break;
+        case (0x40<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_FETCH();_END() } break;
+        case (0x40<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x40<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR (zp,X) */
+        case (0x41<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x41<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x41<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x41<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x41<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x41<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x41<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x41<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x42<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x42<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x42<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x42<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x42<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x42<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x42<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x42<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE (zp,X) (undoc) */
+        case (0x43<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x43<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x43<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x43<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x43<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x43<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x43<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x43<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp (undoc) */
+        case (0x44<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x44<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x44<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x44<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x44<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x44<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x44<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x44<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR zp */
+        case (0x45<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x45<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x45<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x45<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x45<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x45<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x45<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x45<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LSR zp */
+        case (0x46<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x46<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x46<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x46<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_lsr(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x46<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x46<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x46<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x46<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE zp (undoc) */
+        case (0x47<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x47<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x47<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x47<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x47<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x47<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x47<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x47<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* PHA  */
+        case (0x48<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x48<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0x0100|c->S[i]--,c->A[i]);_WR();_END() } break;
+        case (0x48<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x48<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x48<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x48<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x48<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x48<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR # */
+        case (0x49<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x49<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x49<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x49<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x49<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x49<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x49<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x49<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LSRA  */
+        case (0x4A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x4A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_m6502x_lsr(c,i,c->A[i]);_FETCH();_END() } break;
+        case (0x4A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ASR # (undoc) */
+        case (0x4B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x4B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();c->A[i]=_m6502x_lsr(c,i,c->A[i]);_FETCH();_END() } break;
+        case (0x4B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JMP  */
+        case (0x4C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x4C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x4C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_FETCH();_END() } break;
+        case (0x4C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR abs */
+        case (0x4D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x4D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x4D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x4D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x4D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LSR abs */
+        case (0x4E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x4E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x4E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x4E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x4E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_lsr(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x4E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x4E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE abs (undoc) */
+        case (0x4F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x4F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x4F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x4F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x4F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x4F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x4F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x4F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BVC # */
+        case (0x50<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x50<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x40)!=0x0){_FETCH();};_END() } break;
+        case (0x50<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0x50<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0x50<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x50<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x50<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x50<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR (zp),Y */
+        case (0x51<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x51<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x51<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x51<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x51<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x51<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x51<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x51<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x52<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x52<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x52<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x52<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x52<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x52<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x52<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x52<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE (zp),Y (undoc) */
+        case (0x53<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x53<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x53<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x53<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x53<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x53<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x53<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x53<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0x54<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x54<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x54<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x54<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x54<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x54<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x54<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x54<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR zp,X */
+        case (0x55<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x55<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x55<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x55<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x55<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x55<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x55<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x55<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LSR zp,X */
+        case (0x56<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x56<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x56<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x56<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x56<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_lsr(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x56<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x56<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x56<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE zp,X (undoc) */
+        case (0x57<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x57<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x57<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x57<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x57<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x57<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x57<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x57<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CLI  */
+        case (0x58<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x58<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]&=~0x4;_FETCH();_END() } break;
+        case (0x58<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x58<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x58<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x58<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x58<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x58<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR abs,Y */
+        case (0x59<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x59<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x59<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x59<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x59<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x59<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x59<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x59<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0x5A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x5A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x5A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE abs,Y (undoc) */
+        case (0x5B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x5B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x5B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x5B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x5B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x5B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x5B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x5B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0x5C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x5C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x5C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x5C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x5C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x5C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* EOR abs,X */
+        case (0x5D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x5D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x5D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x5D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x5D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]^=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x5D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x5D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LSR abs,X */
+        case (0x5E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x5E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x5E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x5E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x5E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x5E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_lsr(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x5E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x5E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SRE abs,X (undoc) */
+        case (0x5F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x5F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x5F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x5F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x5F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x5F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_lsr(c,i,c->AD[i]);_SD(c->AD[i]);c->A[i]^=c->AD[i];_NZ(c->A[i]);_WR();_END() } break;
+        case (0x5F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x5F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RTS  */
+        case (0x60<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x60<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x60<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x60<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]);c->AD[i]=_GD();_END() } break;
+        case (0x60<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_SA(c->PC[i]++);_END() } break;
+        case (0x60<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x60<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x60<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC (zp,X) */
+        case (0x61<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x61<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x61<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x61<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x61<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x61<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x61<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x61<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x62<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x62<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x62<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x62<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x62<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x62<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x62<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x62<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA (zp,X) (undoc) */
+        case (0x63<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x63<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x63<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x63<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x63<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x63<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x63<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x63<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp (undoc) */
+        case (0x64<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x64<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x64<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x64<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x64<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x64<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x64<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x64<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC zp */
+        case (0x65<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x65<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x65<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x65<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x65<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x65<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x65<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x65<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROR zp */
+        case (0x66<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x66<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x66<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x66<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_ror(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x66<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x66<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x66<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x66<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA zp (undoc) */
+        case (0x67<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x67<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0x67<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x67<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x67<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x67<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x67<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x67<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* PLA  */
+        case (0x68<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x68<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]++);_END() } break;
+        case (0x68<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA(0x0100|c->S[i]);_END() } break;
+        case (0x68<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x68<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x68<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x68<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x68<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC # */
+        case (0x69<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x69<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x69<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x69<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x69<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x69<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x69<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x69<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RORA  */
+        case (0x6A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x6A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_m6502x_ror(c,i,c->A[i]);_FETCH();_END() } break;
+        case (0x6A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ARR # (undoc) */
+        case (0x6B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x6B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]&=_GD();_m6502x_arr(c,i);_FETCH();_END() } break;
+        case (0x6B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JMPI  */
+        case (0x6C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x6C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x6C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA(c->AD[i]);_END() } break;
+        case (0x6C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]&0xFF00)|((c->AD[i]+1)&0x00FF));c->AD[i]=_GD();_END() } break;
+        case (0x6C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=(_GD()<<8)|c->AD[i];_FETCH();_END() } break;
+        case (0x6C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC abs */
+        case (0x6D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x6D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x6D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x6D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x6D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROR abs */
+        case (0x6E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x6E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x6E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x6E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x6E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_ror(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x6E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x6E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA abs (undoc) */
+        case (0x6F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x6F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x6F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0x6F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x6F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x6F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x6F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x6F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BVS # */
+        case (0x70<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x70<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x40)!=0x40){_FETCH();};_END() } break;
+        case (0x70<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0x70<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0x70<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x70<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x70<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x70<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC (zp),Y */
+        case (0x71<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x71<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x71<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x71<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x71<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x71<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x71<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x71<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x72<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x72<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x72<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x72<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x72<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x72<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x72<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x72<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA (zp),Y (undoc) */
+        case (0x73<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x73<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x73<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x73<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x73<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x73<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x73<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x73<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0x74<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x74<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x74<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x74<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x74<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x74<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x74<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x74<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC zp,X */
+        case (0x75<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x75<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x75<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x75<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x75<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x75<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x75<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x75<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROR zp,X */
+        case (0x76<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x76<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x76<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x76<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x76<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_ror(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x76<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x76<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x76<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA zp,X (undoc) */
+        case (0x77<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x77<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x77<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0x77<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x77<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x77<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x77<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x77<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SEI  */
+        case (0x78<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x78<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]|=0x4;_FETCH();_END() } break;
+        case (0x78<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x78<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x78<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x78<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x78<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x78<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC abs,Y */
+        case (0x79<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x79<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x79<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0x79<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x79<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x79<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x79<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x79<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0x7A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x7A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x7A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA abs,Y (undoc) */
+        case (0x7B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x7B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x7B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x7B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0x7B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x7B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x7B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x7B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0x7C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x7C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x7C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x7C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x7C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x7C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ADC abs,X */
+        case (0x7D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x7D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x7D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0x7D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x7D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_adc(c,i,_GD());_FETCH();_END() } break;
+        case (0x7D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x7D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ROR abs,X */
+        case (0x7E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x7E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x7E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x7E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x7E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x7E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_SD(_m6502x_ror(c,i,c->AD[i]));_WR();_END() } break;
+        case (0x7E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x7E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* RRA abs,X (undoc) */
+        case (0x7F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x7F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x7F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x7F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0x7F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0x7F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_m6502x_ror(c,i,c->AD[i]);_SD(c->AD[i]);_m6502x_adc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0x7F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x7F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP # (undoc) */
+        case (0x80<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x80<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x80<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x80<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x80<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x80<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x80<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x80<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA (zp,X) */
+        case (0x81<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x81<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x81<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x81<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x81<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->A[i]);_WR();_END() } break;
+        case (0x81<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x81<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x81<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP # (undoc) */
+        case (0x82<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x82<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x82<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x82<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x82<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x82<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x82<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x82<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SAX (zp,X) (undoc) */
+        case (0x83<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x83<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x83<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0x83<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x83<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->A[i]&c->X[i]);_WR();_END() } break;
+        case (0x83<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x83<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x83<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STY zp */
+        case (0x84<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x84<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_SD(c->Y[i]);_WR();_END() } break;
+        case (0x84<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x84<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x84<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x84<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x84<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x84<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA zp */
+        case (0x85<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x85<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_SD(c->A[i]);_WR();_END() } break;
+        case (0x85<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x85<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x85<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x85<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x85<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x85<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STX zp */
+        case (0x86<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x86<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_SD(c->X[i]);_WR();_END() } break;
+        case (0x86<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x86<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x86<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x86<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x86<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x86<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SAX zp (undoc) */
+        case (0x87<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x87<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_SD(c->A[i]&c->X[i]);_WR();_END() } break;
+        case (0x87<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x87<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x87<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x87<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x87<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x87<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEY  */
+        case (0x88<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x88<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]--;_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0x88<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x88<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x88<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x88<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x88<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x88<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP # (undoc) */
+        case (0x89<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x89<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x89<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x89<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x89<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x89<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x89<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x89<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TXA  */
+        case (0x8A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x8A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i];_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x8A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ANE # (undoc) */
+        case (0x8B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x8B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=(c->A[i]|0xEE)&c->X[i]&_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x8B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STY abs */
+        case (0x8C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x8C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x8C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->Y[i]);_WR();_END() } break;
+        case (0x8C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x8C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA abs */
+        case (0x8D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x8D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x8D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->A[i]);_WR();_END() } break;
+        case (0x8D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x8D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STX abs */
+        case (0x8E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x8E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x8E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->X[i]);_WR();_END() } break;
+        case (0x8E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x8E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SAX abs (undoc) */
+        case (0x8F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x8F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x8F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_SD(c->A[i]&c->X[i]);_WR();_END() } break;
+        case (0x8F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x8F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x8F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BCC # */
+        case (0x90<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x90<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x1)!=0x0){_FETCH();};_END() } break;
+        case (0x90<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0x90<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0x90<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x90<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x90<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x90<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA (zp),Y */
+        case (0x91<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x91<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x91<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x91<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x91<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_SD(c->A[i]);_WR();_END() } break;
+        case (0x91<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x91<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x91<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0x92<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x92<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0x92<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x92<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x92<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x92<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x92<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x92<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SHA (zp),Y (undoc) */
+        case (0x93<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x93<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x93<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0x93<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x93<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_SD(c->A[i]&c->X[i]&(uint8_t)((_GA()>>8)+1));_WR();_END() } break;
+        case (0x93<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x93<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x93<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STY zp,X */
+        case (0x94<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x94<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x94<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_SD(c->Y[i]);_WR();_END() } break;
+        case (0x94<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x94<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x94<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x94<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x94<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA zp,X */
+        case (0x95<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x95<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x95<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_SD(c->A[i]);_WR();_END() } break;
+        case (0x95<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x95<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x95<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x95<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x95<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STX zp,Y */
+        case (0x96<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x96<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x96<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->Y[i])&0x00FF);_SD(c->X[i]);_WR();_END() } break;
+        case (0x96<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x96<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x96<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x96<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x96<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SAX zp,Y (undoc) */
+        case (0x97<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x97<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0x97<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->Y[i])&0x00FF);_SD(c->A[i]&c->X[i]);_WR();_END() } break;
+        case (0x97<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x97<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x97<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x97<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x97<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TYA  */
+        case (0x98<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x98<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->Y[i];_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0x98<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x98<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x98<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x98<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x98<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x98<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA abs,Y */
+        case (0x99<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x99<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x99<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x99<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_SD(c->A[i]);_WR();_END() } break;
+        case (0x99<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x99<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x99<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x99<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TXS  */
+        case (0x9A<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0x9A<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->S[i]=c->X[i];_FETCH();_END() } break;
+        case (0x9A<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9A<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9A<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9A<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9A<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9A<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SHS abs,Y (undoc) */
+        case (0x9B<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x9B<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x9B<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x9B<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);c->S[i]=c->A[i]&c->X[i];_SD(c->S[i]&(uint8_t)((_GA()>>8)+1));_WR();_END() } break;
+        case (0x9B<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x9B<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9B<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9B<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SHY abs,X (undoc) */
+        case (0x9C<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x9C<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x9C<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x9C<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_SD(c->Y[i]&(uint8_t)((_GA()>>8)+1));_WR();_END() } break;
+        case (0x9C<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x9C<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9C<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9C<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* STA abs,X */
+        case (0x9D<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x9D<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x9D<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0x9D<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_SD(c->A[i]);_WR();_END() } break;
+        case (0x9D<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x9D<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9D<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9D<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SHX abs,Y (undoc) */
+        case (0x9E<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x9E<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x9E<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x9E<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_SD(c->X[i]&(uint8_t)((_GA()>>8)+1));_WR();_END() } break;
+        case (0x9E<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x9E<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9E<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9E<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SHA abs,Y (undoc) */
+        case (0x9F<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0x9F<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0x9F<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0x9F<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_SD(c->A[i]&c->X[i]&(uint8_t)((_GA()>>8)+1));_WR();_END() } break;
+        case (0x9F<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0x9F<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9F<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0x9F<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDY # */
+        case (0xA0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=_GD();_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xA0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA (zp,X) */
+        case (0xA1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xA1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xA1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xA1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xA1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xA1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDX # */
+        case (0xA2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=_GD();_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xA2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX (zp,X) (undoc) */
+        case (0xA3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xA3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xA3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xA3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xA3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xA3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDY zp */
+        case (0xA4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xA4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=_GD();_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xA4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA zp */
+        case (0xA5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xA5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xA5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDX zp */
+        case (0xA6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xA6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=_GD();_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xA6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX zp (undoc) */
+        case (0xA7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xA7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xA7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TAY  */
+        case (0xA8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xA8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=c->A[i];_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xA8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA # */
+        case (0xA9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xA9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xA9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xA9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TAX  */
+        case (0xAA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xAA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=c->A[i];_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xAA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LXA # (undoc) */
+        case (0xAB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xAB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=(c->A[i]|0xEE)&_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xAB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDY abs */
+        case (0xAC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xAC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xAC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xAC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=_GD();_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xAC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA abs */
+        case (0xAD<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xAD<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xAD<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xAD<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xAD<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAD<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAD<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAD<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDX abs */
+        case (0xAE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xAE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xAE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xAE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=_GD();_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xAE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX abs (undoc) */
+        case (0xAF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xAF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xAF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xAF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xAF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xAF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BCS # */
+        case (0xB0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x1)!=0x1){_FETCH();};_END() } break;
+        case (0xB0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0xB0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0xB0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA (zp),Y */
+        case (0xB1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xB1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xB1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xB1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xB1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0xB2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xB2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0xB2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX (zp),Y (undoc) */
+        case (0xB3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xB3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xB3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xB3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xB3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDY zp,X */
+        case (0xB4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xB4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=_GD();_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xB4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA zp,X */
+        case (0xB5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xB5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xB5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDX zp,Y */
+        case (0xB6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->Y[i])&0x00FF);_END() } break;
+        case (0xB6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=_GD();_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xB6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX zp,Y (undoc) */
+        case (0xB7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xB7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->Y[i])&0x00FF);_END() } break;
+        case (0xB7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xB7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CLV  */
+        case (0xB8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xB8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]&=~0x40;_FETCH();_END() } break;
+        case (0xB8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA abs,Y */
+        case (0xB9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xB9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xB9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xB9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xB9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xB9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xB9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* TSX  */
+        case (0xBA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xBA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=c->S[i];_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xBA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAS abs,Y (undoc) */
+        case (0xBB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xBB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xBB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xBB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xBB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=c->S[i]=_GD()&c->S[i];_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xBB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDY abs,X */
+        case (0xBC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xBC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xBC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xBC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xBC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]=_GD();_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xBC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDA abs,X */
+        case (0xBD<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xBD<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xBD<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xBD<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xBD<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xBD<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBD<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBD<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LDX abs,Y */
+        case (0xBE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xBE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xBE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xBE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xBE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]=_GD();_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xBE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* LAX abs,Y (undoc) */
+        case (0xBF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xBF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xBF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xBF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xBF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->A[i]=c->X[i]=_GD();_NZ(c->A[i]);_FETCH();_END() } break;
+        case (0xBF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xBF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CPY # */
+        case (0xC0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->Y[i], _GD());_FETCH();_END() } break;
+        case (0xC0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP (zp,X) */
+        case (0xC1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xC1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xC1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xC1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xC1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xC1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP # (undoc) */
+        case (0xC2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xC2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP (zp,X) (undoc) */
+        case (0xC3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xC3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xC3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xC3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xC3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xC3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xC3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* CPY zp */
+        case (0xC4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xC4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->Y[i], _GD());_FETCH();_END() } break;
+        case (0xC4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP zp */
+        case (0xC5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xC5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xC5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEC zp */
+        case (0xC6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xC6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xC6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xC6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xC6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP zp (undoc) */
+        case (0xC7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xC7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xC7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xC7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xC7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INY  */
+        case (0xC8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xC8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->Y[i]++;_NZ(c->Y[i]);_FETCH();_END() } break;
+        case (0xC8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP # */
+        case (0xC9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xC9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xC9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xC9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEX  */
+        case (0xCA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xCA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]--;_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xCA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBX # (undoc) */
+        case (0xCB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xCB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbx(c,i, _GD());_FETCH();_END() } break;
+        case (0xCB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CPY abs */
+        case (0xCC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xCC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xCC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xCC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->Y[i], _GD());_FETCH();_END() } break;
+        case (0xCC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP abs */
+        case (0xCD<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xCD<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xCD<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xCD<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xCD<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCD<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCD<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCD<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEC abs */
+        case (0xCE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xCE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xCE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xCE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xCE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xCE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xCE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP abs (undoc) */
+        case (0xCF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xCF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xCF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xCF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xCF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xCF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xCF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xCF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BNE # */
+        case (0xD0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x2)!=0x0){_FETCH();};_END() } break;
+        case (0xD0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0xD0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0xD0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP (zp),Y */
+        case (0xD1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xD1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xD1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xD1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xD1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0xD2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xD2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0xD2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP (zp),Y (undoc) */
+        case (0xD3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xD3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0xD3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xD3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xD3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xD3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0xD4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xD4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xD4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP zp,X */
+        case (0xD5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xD5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xD5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEC zp,X */
+        case (0xD6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xD6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xD6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xD6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xD6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP zp,X (undoc) */
+        case (0xD7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xD7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xD7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xD7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xD7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xD7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CLD  */
+        case (0xD8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xD8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]&=~0x8;_FETCH();_END() } break;
+        case (0xD8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP abs,Y */
+        case (0xD9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xD9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xD9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xD9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xD9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xD9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xD9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0xDA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xDA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xDA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP abs,Y (undoc) */
+        case (0xDB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xDB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xDB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0xDB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xDB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xDB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xDB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xDB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0xDC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xDC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xDC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xDC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xDC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xDC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CMP abs,X */
+        case (0xDD<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xDD<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xDD<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xDD<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xDD<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->A[i], _GD());_FETCH();_END() } break;
+        case (0xDD<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDD<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xDD<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DEC abs,X */
+        case (0xDE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xDE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xDE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0xDE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xDE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xDE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xDE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xDE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* DCP abs,X (undoc) */
+        case (0xDF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xDF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xDF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0xDF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xDF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xDF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]--;_NZ(c->AD[i]);_SD(c->AD[i]);_m6502x_cmp(c,i, c->A[i], c->AD[i]);_WR();_END() } break;
+        case (0xDF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xDF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CPX # */
+        case (0xE0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->X[i], _GD());_FETCH();_END() } break;
+        case (0xE0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC (zp,X) */
+        case (0xE1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xE1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xE1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xE1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xE1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xE1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP # (undoc) */
+        case (0xE2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xE2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB (zp,X) (undoc) */
+        case (0xE3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xE3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=(c->AD[i]+c->X[i])&0xFF;_SA(c->AD[i]);_END() } break;
+        case (0xE3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xE3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xE3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xE3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xE3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* CPX zp */
+        case (0xE4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xE4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->X[i], _GD());_FETCH();_END() } break;
+        case (0xE4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC zp */
+        case (0xE5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xE5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xE5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INC zp */
+        case (0xE6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xE6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xE6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xE6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xE6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB zp (undoc) */
+        case (0xE7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(_GD());_END() } break;
+        case (0xE7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xE7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xE7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xE7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INX  */
+        case (0xE8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xE8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->X[i]++;_NZ(c->X[i]);_FETCH();_END() } break;
+        case (0xE8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC # */
+        case (0xE9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xE9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xE9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xE9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  */
+        case (0xEA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xEA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xEA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC # (undoc) */
+        case (0xEB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xEB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xEB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* CPX abs */
+        case (0xEC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xEC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xEC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xEC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_cmp(c,i, c->X[i], _GD());_FETCH();_END() } break;
+        case (0xEC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC abs */
+        case (0xED<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xED<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xED<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xED<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xED<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xED<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xED<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xED<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INC abs */
+        case (0xEE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xEE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xEE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xEE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xEE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xEE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xEE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB abs (undoc) */
+        case (0xEF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xEF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xEF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((_GD()<<8)|c->AD[i]);_END() } break;
+        case (0xEF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xEF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xEF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xEF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xEF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* BEQ # */
+        case (0xF0<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF0<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);c->AD[i]=c->PC[i]+(int8_t)_GD();if((c->P[i]&0x2)!=0x2){_FETCH();};_END() } break;
+        case (0xF0<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->PC[i]&0xFF00)|(c->AD[i]&0x00FF));if((c->AD[i]&0xFF00)==(c->PC[i]&0xFF00)){c->PC[i]=c->AD[i];c->irq_pip[i]>>=1;c->nmi_pip[i]>>=1;_FETCH();};_END() } break;
+        case (0xF0<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->PC[i]=c->AD[i];_FETCH();_END() } break;
+        case (0xF0<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF0<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF0<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF0<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC (zp),Y */
+        case (0xF1<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF1<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF1<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xF1<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xF1<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xF1<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xF1<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF1<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* JAM INVALID (undoc) */
+        case (0xF2<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xF2<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SAD(0xFFFF,0xFF);c->IR[i]--;_END() } break;
+        case (0xF2<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF2<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF2<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF2<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF2<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF2<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB (zp),Y (undoc) */
+        case (0xF3<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF3<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF3<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+1)&0xFF);c->AD[i]=_GD();_END() } break;
+        case (0xF3<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0xF3<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xF3<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xF3<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xF3<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+    /* NOP zp,X (undoc) */
+        case (0xF4<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF4<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF4<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xF4<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xF4<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF4<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF4<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF4<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC zp,X */
+        case (0xF5<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF5<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF5<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xF5<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xF5<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF5<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF5<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF5<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INC zp,X */
+        case (0xF6<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF6<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF6<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xF6<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xF6<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xF6<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xF6<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF6<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB zp,X (undoc) */
+        case (0xF7<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF7<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_SA(c->AD[i]);_END() } break;
+        case (0xF7<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()_SA((c->AD[i]+c->X[i])&0x00FF);_END() } break;
+        case (0xF7<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xF7<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xF7<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xF7<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF7<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SED  */
+        case (0xF8<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xF8<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()c->P[i]|=0x8;_FETCH();_END() } break;
+        case (0xF8<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF8<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF8<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF8<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF8<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF8<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC abs,Y */
+        case (0xF9<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xF9<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xF9<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->Y[i])>>8)))&1;_END() } break;
+        case (0xF9<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xF9<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xF9<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF9<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xF9<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP  (undoc) */
+        case (0xFA<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]);_END() } break;
+        case (0xFA<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xFA<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFA<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFA<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFA<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFA<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFA<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB abs,Y (undoc) */
+        case (0xFB<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xFB<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xFB<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->Y[i])&0xFF));_END() } break;
+        case (0xFB<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->Y[i]);_END() } break;
+        case (0xFB<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xFB<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xFB<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xFB<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* NOP abs,X (undoc) */
+        case (0xFC<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xFC<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xFC<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xFC<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xFC<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xFC<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFC<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFC<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* SBC abs,X */
+        case (0xFD<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xFD<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xFD<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));c->IR[i]+=(~((c->AD[i]>>8)-((c->AD[i]+c->X[i])>>8)))&1;_END() } break;
+        case (0xFD<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xFD<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()_m6502x_sbc(c,i,_GD());_FETCH();_END() } break;
+        case (0xFD<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFD<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+        case (0xFD<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* INC abs,X */
+        case (0xFE<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xFE<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xFE<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0xFE<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xFE<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xFE<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_NZ(c->AD[i]);_SD(c->AD[i]);_WR();_END() } break;
+        case (0xFE<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xFE<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+    /* ISB abs,X (undoc) */
+        case (0xFF<<3)|0: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);_END() } break;
+        case (0xFF<<3)|1: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->PC[i]++);c->AD[i]=_GD();_END() } break;
+        case (0xFF<<3)|2: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]|=_GD()<<8;_SA((c->AD[i]&0xFF00)|((c->AD[i]+c->X[i])&0xFF));_END() } break;
+        case (0xFF<<3)|3: for (int i = i0; i < i1; i++) { _BEGIN()_SA(c->AD[i]+c->X[i]);_END() } break;
+        case (0xFF<<3)|4: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]=_GD();_WR();_END() } break;
+        case (0xFF<<3)|5: for (int i = i0; i < i1; i++) { _BEGIN()c->AD[i]++;_SD(c->AD[i]);_m6502x_sbc(c,i,c->AD[i]);_WR();_END() } break;
+        case (0xFF<<3)|6: for (int i = i0; i < i1; i++) { _BEGIN()_FETCH();_END() } break;
+        case (0xFF<<3)|7: for (int i = i0; i < i1; i++) { _BEGIN()assert(false);_END() } break;
+
+    }
+}
+
+void m6502x_tick(m6502x_t* c, uint64_t* pins) {
+    const int num_lanes = c->num_lanes;
+    bool active[M6502X_MAX_LANES];
+    for (int i = 0; i < num_lanes; i++) {
+        active[i] = _m6502x_begin_tick(c, pins, i);
+    }
+    // dispatch each run of adjacent active lanes at the same decoder step once
+    int i0 = 0;
+    while (i0 < num_lanes) {
+        if (!active[i0]) {
+            i0++;
+            continue;
+        }
+        const uint16_t ir = c->IR[i0];
+        int i1 = i0 + 1;
+        while ((i1 < num_lanes) && active[i1] && (c->IR[i1] == ir)) {
+            i1++;
+        }
+        _m6502x_step(c, pins, ir, i0, i1);
+        i0 = i1;
+    }
+}
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#undef _SA
+#undef _GA
+#undef _SAD
+#undef _FETCH
+#undef _SD
+#undef _GD
+#undef _ON
+#undef _OFF
+#undef _RD
+#undef _WR
+#undef _NZ
+#undef _BEGIN
+#undef _END
+#endif /* CHIPS_IMPL */
@@ -86,6 +86,17 @@
     m6522_reset(&sys->via);
     ~~~
 
+    ## Skipping idle ticks
+
+    m6522_idle_ticks() returns the number of following ticks in which the
+    VIA would only count down its timers. As long as the CPU doesn't
+    access the VIA, m6522_inputs_changed() returns false for the input pin
+    mask, and the returned number of ticks hasn't elapsed, a system doesn't
+    need to call m6522_tick() but can catch up the skipped ticks with
+    m6522_advance() before the next m6522_tick() (see the event scheduler
+    in chips_common.h). During skipped ticks the output pins are unchanged
+    from the last m6522_tick() result which is stored in m6522_t.pins.
+
     ## LINKS
 
     On timer behaviour when hitting zero:
@@ -352,6 +363,12 @@ void m6522_init(m6522_t* m6522);
 void m6522_reset(m6522_t* m6522);
 // tick the m6522
 uint64_t m6522_tick(m6522_t* m6522, uint64_t pins);
+// get number of following ticks which only count down timers
+uint32_t m6522_idle_ticks(const m6522_t* m6522);
+// check if new input pins would have an effect compared to the last tick
+bool m6522_inputs_changed(const m6522_t* m6522, uint64_t pins);
+// catch up with skipped ticks (must not be greater than m6522_idle_ticks())
+void m6522_advance(m6522_t* m6522, uint32_t num_ticks);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -895,4 +912,65 @@ uint64_t m6522_tick(m6522_t* c, uint64_t pins) {
     return pins;
 }
 
+#define _M6522_PIP_BITS(pip,offset) (((pip)>>(offset))&0xFF)
+
+uint32_t m6522_idle_ticks(const m6522_t* c) {
+    CHIPS_ASSERT(c);
+    /* both timers must be counting in the steady state, and no
+       reload from latch may be in flight
+    */
+    if ((_M6522_PIP_BITS(c->t1.pip, M6522_PIP_TIMER_COUNT) != 3) || (_M6522_PIP_BITS(c->t1.pip, M6522_PIP_TIMER_LOAD) != 0) ||
+        (_M6522_PIP_BITS(c->t2.pip, M6522_PIP_TIMER_COUNT) != 3) || (_M6522_PIP_BITS(c->t2.pip, M6522_PIP_TIMER_LOAD) != 0))
+    {
+        return 0;
+    }
+    // counting PB6 pulses depends on the previous output pins
+    if (M6522_ACR_T2_COUNT_PB6(c)) {
+        return 0;
+    }
+    // interrupt state must be stable (a pending irq stays pending)
+    const uint32_t irq_bits = _M6522_PIP_BITS(c->intr.pip, M6522_PIP_IRQ);
+    if ((c->intr.ifr & c->intr.ier) ? ((irq_bits != 1) || (0 == (c->intr.ifr & (1<<7)))) : (irq_bits != 0)) {
+        return 0;
+    }
+    // timers underflow when the counter wraps around to 0xFFFF
+    uint32_t idle = c->t1.counter;
+    if (!c->t2.t_bit && (c->t2.counter < idle)) {
+        // T2 only has an effect on the first underflow
+        idle = c->t2.counter;
+    }
+    return idle;
+}
+
+bool m6522_inputs_changed(const m6522_t* c, uint64_t pins) {
+    CHIPS_ASSERT(c);
+    if ((c->pa.c1_in != (0 != (pins & M6522_CA1))) ||
+        (c->pa.c2_in != (0 != (pins & M6522_CA2))) ||
+        (c->pb.c1_in != (0 != (pins & M6522_CB1))) ||
+        (c->pb.c2_in != (0 != (pins & M6522_CB2))))
+    {
+        return true;
+    }
+    // with input latching enabled, port input pins are only sampled on CA1/CB1 transitions
+    if (!M6522_ACR_PA_LATCH_ENABLE(c) && (c->pa.inpr != M6522_GET_PA(pins))) {
+        return true;
+    }
+    if (!M6522_ACR_PB_LATCH_ENABLE(c) && (c->pb.inpr != M6522_GET_PB(pins))) {
+        return true;
+    }
+    return false;
+}
+
+void m6522_advance(m6522_t* c, uint32_t num_ticks) {
+    CHIPS_ASSERT(c);
+    if (0 == num_ticks) {
+        return;
+    }
+    CHIPS_ASSERT(c->t1.counter >= num_ticks);
+    c->t1.counter -= (uint16_t)num_ticks;
+    c->t2.counter -= (uint16_t)num_ticks;
+    c->t1.t_out = false;
+    c->t2.t_out = false;
+}
+
 #endif /* CHIPS_IMPL */
@@ -48,6 +48,17 @@
     - https://ist.uwaterloo.ca/~schepers/MJK/cia6526.html
     - https://ist.uwaterloo.ca/~schepers/MJK/cia6526.html
 
+    ## Skipping idle ticks
+
+    m6526_idle_ticks() returns the number of following ticks in which the
+    CIA only counts down its timers. As long as the CPU doesn't access
+    the chip, the input pins (port A/B and FLAG) don't change and the
+    returned number of ticks hasn't elapsed, a system doesn't need to call
+    m6526_tick() but can catch up the skipped ticks with m6526_advance()
+    before the next m6526_tick() (see the event scheduler in chips_common.h).
+    During skipped ticks, the output pins are unchanged from the last
+    m6526_tick() result which is stored in m6526_t.pins.
+
     TODO: Documentation
 
     ## zlib/libpng license
@@ -272,6 +283,10 @@ void m6526_init(m6526_t* c);
 void m6526_reset(m6526_t* c);
 // tick the m6526_t instance
 uint64_t m6526_tick(m6526_t* c, uint64_t pins);
+// get number of following ticks which only count down timers
+uint32_t m6526_idle_ticks(const m6526_t* c);
+// catch up with skipped ticks (must not be greater than m6526_idle_ticks())
+void m6526_advance(m6526_t* c, uint32_t num_ticks);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -346,7 +361,7 @@ static inline void _m6526_read_port_pins(m6526_t* c, uint64_t pins) {
     c->pb.inp = M6526_GET_PB(pins);
 }
 
-static inline uint8_t _m6526_merge_pb67(m6526_t* c, uint8_t data) {
+static inline uint8_t _m6526_merge_pb67(const m6526_t* c, uint8_t data) {
     /* merge timer state bits into data byte */
     if (M6526_PBON(c->ta.cr)) {
         data &= ~(1<<6);
@@ -683,4 +698,71 @@ uint64_t m6526_tick(m6526_t* c, uint64_t pins) {
     return pins;
 }
 
+/* Check if the next tick of a timer would only decrement the counter (or do
+   nothing at all), returns the number of such ticks before the counter
+   underflows, or 0 if the timer's delay pipelines are in motion.
+*/
+#define _M6526_PIP_BITS(pip,offset) (((pip)>>(offset))&0xFF)
+static uint32_t _m6526_timer_idle_ticks(const m6526_timer_t* t, bool active) {
+    if (M6526_FORCE_LOAD(t->cr) || (0 != _M6526_PIP_BITS(t->pip, M6526_PIP_TIMER_LOAD))) {
+        return 0;
+    }
+    if (_M6526_PIP_BITS(t->pip, M6526_PIP_TIMER_ONESHOT) != (M6526_RUNMODE_ONESHOT(t->cr) ? 1 : 0)) {
+        return 0;
+    }
+    const uint32_t count_bits = _M6526_PIP_BITS(t->pip, M6526_PIP_TIMER_COUNT);
+    if (active) {
+        // counter pipeline must be filled, and the counter must not be about to underflow
+        if ((count_bits != 3) || (t->counter == 0)) {
+            return 0;
+        }
+        return t->counter - 1U;
+    }
+    else {
+        return (count_bits == 0) ? 0xFFFFFFFF : 0;
+    }
+}
+
+uint32_t m6526_idle_ticks(const m6526_t* c) {
+    CHIPS_ASSERT(c);
+    // interrupt state must be stable (a pending irq stays pending)
+    if ((c->intr.imr != c->intr.imr1) || (0 != _M6526_PIP_BITS(c->intr.pip, M6526_PIP_READ_ICR))) {
+        return 0;
+    }
+    const bool irq_pending = 0 != (c->intr.icr & c->intr.imr);
+    const uint32_t irq_bits = _M6526_PIP_BITS(c->intr.pip, M6526_PIP_IRQ);
+    if (irq_pending ? ((irq_bits != 1) || (0 == (c->intr.icr & (1<<7)))) : (irq_bits != 0)) {
+        return 0;
+    }
+    // output pins must be up to date after a register access or timer underflow
+    if (c->ta.t_out || c->tb.t_out ||
+        (c->pa.pins != (c->pa.reg | (c->pa.inp & ~c->pa.ddr))) ||
+        (c->pb.pins != _m6526_merge_pb67(c, c->pb.reg | (c->pb.inp & ~c->pb.ddr))) ||
+        ((0 != (c->pins & M6526_IRQ)) != (0 != (c->intr.icr & (1<<7)))))
+    {
+        return 0;
+    }
+    // timer B counting from timer A underflows is driven by timer A events
+    const bool ta_active = M6526_TIMER_STARTED(c->ta.cr) && M6526_TA_INMODE_PHI2(c->ta.cr);
+    const bool tb_active = M6526_TIMER_STARTED(c->tb.cr) && M6526_TB_INMODE_PHI2(c->tb.cr);
+    const uint32_t ta_idle = _m6526_timer_idle_ticks(&c->ta, ta_active);
+    const uint32_t tb_idle = _m6526_timer_idle_ticks(&c->tb, tb_active);
+    return (ta_idle < tb_idle) ? ta_idle : tb_idle;
+}
+
+void m6526_advance(m6526_t* c, uint32_t num_ticks) {
+    CHIPS_ASSERT(c);
+    if (0 == num_ticks) {
+        return;
+    }
+    if (_M6526_PIP_BITS(c->ta.pip, M6526_PIP_TIMER_COUNT) == 3) {
+        CHIPS_ASSERT(c->ta.counter > num_ticks);
+        c->ta.counter -= (uint16_t)num_ticks;
+    }
+    if (_M6526_PIP_BITS(c->tb.pip, M6526_PIP_TIMER_COUNT) == 3) {
+        CHIPS_ASSERT(c->tb.counter > num_ticks);
+        c->tb.counter -= (uint16_t)num_ticks;
+    }
+}
+
 #endif /* CHIPS_IMPL */
@@ -21,6 +21,17 @@
 
     TODO: Documentation
 
+    ## Direct Video Memory Access
+
+    By default the VIC-I reads character codes, colors and graphics
+    data through the memory fetch callback. Alternatively the host system
+    can describe the VIC-visible memory in m6561_desc_t.vidmem as
+    16 pointers to 1 KByte pages for the 16 KByte VIC address space,
+    plus a pointer to the 1 KByte color RAM (which provides the upper
+    4 data bits). The VIC will then read video memory directly without
+    going through the callback. Unmapped pages (null pointers) read
+    as 0xFF.
+
     ## Links
 
     http://sleepingelephant.com/ipw-web/bulletin/bb/viewtopic.php?f=11&t=8733&sid=59d3d281086e98689f6d1f95c4a1c4a9
@@ -124,20 +135,42 @@ extern "C" {
 // memory fetch callback, used to feed pixel- and color-data into the m6561
 typedef uint16_t (*m6561_fetch_t)(uint16_t addr, void* user_data);
 
+// number and size of video memory pages for direct video memory access
+#define M6561_VIDMEM_PAGE_SHIFT (10)
+#define M6561_VIDMEM_PAGE_SIZE (1<<M6561_VIDMEM_PAGE_SHIFT)
+#define M6561_VIDMEM_NUM_PAGES (16)
+
+// optional direct video memory access (see 'Direct Video Memory Access')
+typedef struct {
+    const uint8_t* pages[M6561_VIDMEM_NUM_PAGES];   // 1 KB pages of the VIC address space, 0 if unmapped
+    const uint8_t* color_ram;                       // 1 KB color RAM
+} m6561_vidmem_t;
+
 // setup parameters for m6561_init() function
 typedef struct {
     // pointer and size of external framebuffer
     chips_range_t framebuffer;
     // visible CRT area decoded into framebuffer (in pixels)
     chips_rect_t screen;
-    // the memory-fetch callback
+    // the memory-fetch callback (optional if vidmem.color_ram is provided)
     m6561_fetch_t fetch_cb;
     // optional user-data for fetch callback
     void* user_data;
+    // optional direct video memory access, used instead of fetch_cb if vidmem.color_ram is set
+    m6561_vidmem_t vidmem;
     // frequency at which the tick function is called (for audio generation)
     int tick_hz;
     // sound sample frequency
     int sound_hz;
+    // optional triple buffer, if set the framebuffers are rotated at the start of each frame
+    chips_triple_buffer_t* triple_buffer;
+    /* optional raw video log, register writes are recorded at the raster
+       position (rs.h_count, rs.v_count) and frames are published when the
+       line counter wraps around, with vidmem the log's video memory copy is
+       the 16 KByte VIC address space (unmapped pages read as 0xFF) followed
+       by the 1 KByte color RAM
+    */
+    chips_vidlog_t* vidlog;
     // sound sample magnitude/volume (0.0..1.0)
     float sound_magnitude;
 } m6561_desc_t;
@@ -152,6 +185,7 @@ typedef struct {
     uint8_t rc;             // 4-bit raster counter (0..7 or 0..15)
     uint8_t row_height;     // either 8 or 16
     uint8_t row_count;      // character row count
+    uint32_t frame_count;   // incremented when the line counter wraps around
 } m6561_raster_unit_t;
 
 // memory unit state
@@ -169,6 +203,8 @@ typedef struct {
     uint8_t bg_color;       // current background color RGBA
     uint8_t brd_color;      // border color RGBA
     uint8_t aux_color;      // auxiliary color RGBA
+    uint32_t pixel_lut_key; // color state the pixel_lut was built for
+    uint8_t pixel_lut[16][4];   // 4 shifter bits => 4 pixels for the current colors
 } m6561_graphics_unit_t;
 
 // border unit state
@@ -184,6 +220,9 @@ typedef struct {
     uint16_t vis_x0, vis_y0, vis_x1, vis_y1;  // the visible area
     uint16_t vis_w, vis_h;      // width of visible area
     uint8_t* fb;
+    chips_triple_buffer_t* triple_buffer;   // optional, rotates fb at the start of each frame
+    chips_vidlog_t* vidlog;     // optional raw video log
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
 } m6561_crt_t;
 
 // sound generator state
@@ -222,7 +261,9 @@ typedef struct {
     uint64_t pins;
     m6561_fetch_t fetch_cb; // memory fetch callback
     void* user_data;        // memory fetch callback user data
+    m6561_vidmem_t vidmem;  // direct video memory access (if vidmem.color_ram is set)
     bool debug_vis;
+    bool headless;          // skip framebuffer writes (set by the host system)
     uint8_t regs[M6561_NUM_REGS];
     m6561_raster_unit_t rs;
     m6561_memory_unit_t mem;
@@ -248,6 +289,10 @@ uint32_t m6561_color(size_t i);
 void m6561_snapshot_onsave(m6561_t* snapshot);
 // fixup m6561_t snapshot after loading
 void m6561_snapshot_onload(m6561_t* snapshot, m6561_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the m6561_t state (excluding host pointers)
+uint64_t m6561_hash(const m6561_t* vic, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -302,6 +347,13 @@ static void _m6561_init_crt(m6561_crt_t* crt, const m6561_desc_t* desc) {
     CHIPS_ASSERT((desc->screen.x & 7) == 0);
     CHIPS_ASSERT((desc->screen.width & 7) == 0);
     crt->fb = desc->framebuffer.ptr;
+    crt->triple_buffer = desc->triple_buffer;
+    if (crt->triple_buffer) {
+        CHIPS_ASSERT(crt->triple_buffer->size >= M6561_FRAMEBUFFER_SIZE_BYTES);
+        crt->fb = chips_triple_buffer_back(crt->triple_buffer);
+    }
+    crt->vidlog = desc->vidlog;
+    chips_dirty_lines_set_all(&crt->dirty_lines);
     crt->vis_x0 = desc->screen.x / _M6561_PIXELS_PER_TICK;
     crt->vis_y0 = desc->screen.y;
     crt->vis_w = desc->screen.width / _M6561_PIXELS_PER_TICK;
@@ -310,18 +362,29 @@ static void _m6561_init_crt(m6561_crt_t* crt, const m6561_desc_t* desc) {
     crt->vis_y1 = crt->vis_y0 + crt->vis_h;
 }
 
+// never matches a valid pixel lookup table key
+#define _M6561_PIXEL_LUT_INVALID (0xFFFFFFFF)
+
 void m6561_init(m6561_t* vic, const m6561_desc_t* desc) {
-    CHIPS_ASSERT(vic && desc && desc->fetch_cb);
+    CHIPS_ASSERT(vic && desc && (desc->fetch_cb || desc->vidmem.color_ram));
     CHIPS_ASSERT(desc->framebuffer.ptr && (desc->framebuffer.size >= M6561_FRAMEBUFFER_SIZE_BYTES));
     memset(vic, 0, sizeof(*vic));
     _m6561_init_crt(&vic->crt, desc);
     vic->border.enabled = _M6561_HBORDER|_M6561_VBORDER;
     vic->fetch_cb = desc->fetch_cb;
     vic->user_data = desc->user_data;
+    vic->vidmem = desc->vidmem;
+    vic->gunit.pixel_lut_key = _M6561_PIXEL_LUT_INVALID;
     vic->sound.sample_period = (desc->tick_hz * _M6561_FIXEDPOINT_SCALE) / desc->sound_hz;
     vic->sound.sample_counter = vic->sound.sample_period;
     vic->sound.sample_mag = desc->sound_magnitude;
     vic->sound.noise.shift = 0x7FFFFC;
+    if (vic->crt.vidlog && vic->vidmem.color_ram) {
+        for (int i = 0; i < M6561_VIDMEM_NUM_PAGES; i++) {
+            chips_vidlog_set_range(vic->crt.vidlog, i, vic->vidmem.pages[i], M6561_VIDMEM_PAGE_SIZE);
+        }
+        chips_vidlog_set_range(vic->crt.vidlog, M6561_VIDMEM_NUM_PAGES, vic->vidmem.color_ram, M6561_VIDMEM_PAGE_SIZE);
+    }
 }
 
 static void _m6561_reset_crt(m6561_t* vic) {
@@ -343,6 +406,7 @@ static void _m6561_reset_memory_unit(m6561_t* vic) {
 
 static void _m6561_reset_graphics_unit(m6561_t* vic) {
     memset(&vic->gunit, 0, sizeof(vic->gunit));
+    vic->gunit.pixel_lut_key = _M6561_PIXEL_LUT_INVALID;
 }
 
 static void _m6561_reset_audio(m6561_t* vic) {
@@ -363,6 +427,11 @@ void m6561_reset(m6561_t* vic) {
     _m6561_reset_graphics_unit(vic);
     _m6561_reset_crt(vic);
     _m6561_reset_audio(vic);
+    if (vic->crt.vidlog) {
+        for (uint8_t i = 0; i < 16; i++) {
+            chips_vidlog_write(vic->crt.vidlog, 0, 0, i, 0);
+        }
+    }
 }
 
 chips_rect_t m6561_screen(m6561_t* vic) {
@@ -414,46 +483,69 @@ static void _m6561_regs_dirty(m6561_t* vic) {
     vic->sound.volume = vic->regs[14] & 0xF;
 }
 
-static inline void _m6561_decode_4pixels(m6561_t* vic, uint8_t* dst) {
-    if (vic->border.enabled) {
-        for (size_t i = 0; i < 4; i++) {
-            *dst++ = vic->gunit.brd_color;
+// the color state which determines the content of the pixel lookup table
+static inline uint32_t _m6561_pixel_lut_key(const m6561_graphics_unit_t* gu) {
+    return (uint32_t)gu->color |
+           ((uint32_t)gu->inv_color << 4) |
+           ((uint32_t)gu->bg_color << 5) |
+           ((uint32_t)gu->brd_color << 9) |
+           ((uint32_t)gu->aux_color << 12);
+}
+
+// rebuild the 4-bit shifter pattern => 4 pixels lookup table for the current colors
+static void _m6561_update_pixel_lut(m6561_graphics_unit_t* gu) {
+    if (gu->color & 8) {
+        // multi-color mode: 2 bits per double-wide pixel
+        const uint8_t colors[4] = { gu->bg_color, gu->brd_color, (uint8_t)(gu->color & 7), gu->aux_color };
+        for (size_t p = 0; p < 16; p++) {
+            gu->pixel_lut[p][0] = gu->pixel_lut[p][1] = colors[(p>>2) & 3];
+            gu->pixel_lut[p][2] = gu->pixel_lut[p][3] = colors[p & 3];
         }
     }
     else {
-        uint8_t p = vic->gunit.shift;
-        if (vic->gunit.color & 8) {
-            // multi-color mode
-            switch (p & 0xC0) {
-                case 0x00: dst[0] = dst[1] = vic->gunit.bg_color; break;
-                case 0x40: dst[0] = dst[1] = vic->gunit.brd_color; break;
-                case 0x80: dst[0] = dst[1] = vic->gunit.color & 7; break;
-                case 0xC0: dst[0] = dst[1] = vic->gunit.aux_color; break;
-            }
-            switch (p & 0x30) {
-                case 0x00: dst[2] = dst[3] = vic->gunit.bg_color; break;
-                case 0x10: dst[2] = dst[3] = vic->gunit.brd_color; break;
-                case 0x20: dst[2] = dst[3] = vic->gunit.color & 7; break;
-                case 0x30: dst[2] = dst[3] = vic->gunit.aux_color; break;
-            }
+        // hires mode
+        uint8_t bg, fg;
+        if (gu->inv_color) {
+            bg = gu->color & 7;
+            fg = gu->bg_color;
         }
         else {
-            // hires mode
-            uint8_t bg, fg;
-            if (vic->gunit.inv_color) {
-                bg = vic->gunit.color & 7;
-                fg = vic->gunit.bg_color;
-            }
-            else {
-                bg = vic->gunit.bg_color;
-                fg = vic->gunit.color & 7;
+            bg = gu->bg_color;
+            fg = gu->color & 7;
+        }
+        for (size_t p = 0; p < 16; p++) {
+            for (size_t i = 0; i < 4; i++) {
+                gu->pixel_lut[p][i] = (p & (8>>i)) ? fg : bg;
             }
-            dst[0] = (p & (1<<7)) ? fg : bg;
-            dst[1] = (p & (1<<6)) ? fg : bg;
-            dst[2] = (p & (1<<5)) ? fg : bg;
-            dst[3] = (p & (1<<4)) ? fg : bg;
         }
-        vic->gunit.shift = p<<4;
+    }
+    gu->pixel_lut_key = _m6561_pixel_lut_key(gu);
+}
+
+static inline void _m6561_decode_4pixels(m6561_t* vic, uint8_t* dst) {
+    if (vic->border.enabled) {
+        memset(dst, vic->gunit.brd_color, 4);
+    }
+    else {
+        m6561_graphics_unit_t* gu = &vic->gunit;
+        if (gu->pixel_lut_key != _m6561_pixel_lut_key(gu)) {
+            _m6561_update_pixel_lut(gu);
+        }
+        memcpy(dst, gu->pixel_lut[gu->shift>>4], 4);
+        gu->shift <<= 4;
+    }
+}
+
+// read a 12-bit value (upper 4 bits from color RAM) from video memory
+static inline uint16_t _m6561_fetch(m6561_t* vic, uint16_t addr) {
+    if (vic->vidmem.color_ram) {
+        const size_t page = addr >> M6561_VIDMEM_PAGE_SHIFT;
+        const uint8_t* ptr = (page < M6561_VIDMEM_NUM_PAGES) ? vic->vidmem.pages[page] : 0;
+        const uint8_t data = ptr ? ptr[addr & (M6561_VIDMEM_PAGE_SIZE-1)] : 0xFF;
+        return (vic->vidmem.color_ram[addr & (M6561_VIDMEM_PAGE_SIZE-1)]<<8) | data;
+    }
+    else {
+        return vic->fetch_cb(addr, vic->user_data);
     }
 }
 
@@ -465,15 +557,27 @@ static void _m6561_tick_video(m6561_t* vic) {
         const size_t x = vic->rs.h_count;
         const size_t y = vic->rs.v_count;
         uint8_t* dst = vic->crt.fb + (y * M6561_FRAMEBUFFER_WIDTH) + (x * _M6561_PIXELS_PER_TICK);
-        _m6561_decode_4pixels(vic, dst);
+        uint8_t pixels[_M6561_PIXELS_PER_TICK];
+        _m6561_decode_4pixels(vic, pixels);
+        chips_dirty_lines_copy(&vic->crt.dirty_lines, y, dst, pixels, sizeof(pixels));
     }
     else if ((vic->crt.x >= vic->crt.vis_x0) && (vic->crt.x < vic->crt.vis_x1) &&
              (vic->crt.y >= vic->crt.vis_y0) && (vic->crt.y < vic->crt.vis_y1))
     {
-        const size_t x = vic->crt.x - vic->crt.vis_x0;
-        const size_t y = vic->crt.y - vic->crt.vis_y0;
-        uint8_t* dst = vic->crt.fb + (y * M6561_FRAMEBUFFER_WIDTH) + (x * _M6561_PIXELS_PER_TICK);
-        _m6561_decode_4pixels(vic, dst);
+        if (CHIPS_HEADLESS_SKIP(vic->headless)) {
+            // headless: only advance the pixel shifter
+            if (!vic->border.enabled) {
+                vic->gunit.shift <<= 4;
+            }
+        }
+        else {
+            const size_t x = vic->crt.x - vic->crt.vis_x0;
+            const size_t y = vic->crt.y - vic->crt.vis_y0;
+            uint8_t* dst = vic->crt.fb + (y * M6561_FRAMEBUFFER_WIDTH) + (x * _M6561_PIXELS_PER_TICK);
+            uint8_t pixels[_M6561_PIXELS_PER_TICK];
+            _m6561_decode_4pixels(vic, pixels);
+            chips_dirty_lines_copy(&vic->crt.dirty_lines, y, dst, pixels, sizeof(pixels));
+        }
     }
 
     // display-enabled area?
@@ -498,13 +602,13 @@ static void _m6561_tick_video(m6561_t* vic) {
         uint16_t addr = vic->mem.g_addr_base +
                         ((vic->mem.c_value & 0xFF) * vic->rs.row_height) +
                         vic->rs.rc;
-        vic->gunit.shift = (uint8_t) vic->fetch_cb(addr, vic->user_data);
+        vic->gunit.shift = (uint8_t) _m6561_fetch(vic, addr);
         vic->gunit.color = (vic->mem.c_value>>8) & 0xF;
     }
     else {
         // a c-access (character code and color)
         uint16_t addr = vic->mem.c_addr_base + (vic->rs.vc>>1);
-        vic->mem.c_value = vic->fetch_cb(addr, vic->user_data);
+        vic->mem.c_value = _m6561_fetch(vic, addr);
     }
     if (!vic->rs.vc_disabled) {
         vic->rs.vc = (vic->rs.vc + 1) & ((1<<11)-1);
@@ -537,13 +641,20 @@ static void _m6561_tick_video(m6561_t* vic) {
         }
         if (vic->rs.v_count == _M6561_VRETRACEPOS) {
             vic->crt.y = 0;
+            if (vic->crt.triple_buffer) {
+                vic->crt.fb = chips_triple_buffer_publish(vic->crt.triple_buffer);
+            }
         }
         else {
             vic->crt.y++;
         }
         if (vic->rs.v_count == _M6561_VTOTAL) {
             vic->rs.v_count = 0;
+            vic->rs.frame_count++;
             vic->border.enabled |= _M6561_VBORDER;
+            if (vic->crt.vidlog) {
+                chips_vidlog_publish(vic->crt.vidlog);
+            }
         }
     }
 }
@@ -655,6 +766,9 @@ uint64_t m6561_tick(m6561_t* vic, uint64_t pins) {
             const uint8_t data = M6561_GET_DATA(pins);
             vic->regs[addr] = data;
             _m6561_regs_dirty(vic);
+            if (vic->crt.vidlog) {
+                chips_vidlog_write(vic->crt.vidlog, vic->rs.h_count, vic->rs.v_count, addr, data);
+            }
         }
     }
 
@@ -669,14 +783,36 @@ void m6561_snapshot_onsave(m6561_t* snapshot) {
     CHIPS_ASSERT(snapshot);
     snapshot->fetch_cb = 0;
     snapshot->user_data = 0;
+    memset(&snapshot->vidmem, 0, sizeof(snapshot->vidmem));
     snapshot->crt.fb = 0;
+    snapshot->crt.triple_buffer = 0;
+    snapshot->crt.vidlog = 0;
 }
 
 void m6561_snapshot_onload(m6561_t* snapshot, m6561_t* sys) {
     CHIPS_ASSERT(snapshot && sys);
     snapshot->fetch_cb = sys->fetch_cb;
     snapshot->user_data = sys->user_data;
+    snapshot->vidmem = sys->vidmem;
     snapshot->crt.fb = sys->crt.fb;
+    snapshot->crt.triple_buffer = sys->crt.triple_buffer;
+    snapshot->crt.vidlog = sys->crt.vidlog;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t m6561_hash(const m6561_t* vic, uint64_t h) {
+    CHIPS_ASSERT(vic);
+    m6561_t tmp;
+    memcpy(&tmp, vic, sizeof(tmp));
+    m6561_snapshot_onsave(&tmp);
+    tmp.debug_vis = false;
+    tmp.headless = false;
+    memset(&tmp.crt.dirty_lines, 0, sizeof(tmp.crt.dirty_lines));
+    // the pixel lookup table is a cache which depends on the video output mode
+    tmp.gunit.pixel_lut_key = _M6561_PIXEL_LUT_INVALID;
+    memset(tmp.gunit.pixel_lut, 0, sizeof(tmp.gunit.pixel_lut));
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 #endif
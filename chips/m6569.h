@@ -161,6 +161,13 @@ typedef struct {
     m6569_fetch_t fetch_cb;
     // optional user-data for fetch callback
     void* user_data;
+    // optional triple buffer, if set the framebuffers are rotated at the start of each frame
+    chips_triple_buffer_t* triple_buffer;
+    /* optional raw video log, register writes are recorded at the raster
+       position (rs.h_count, rs.v_count) and frames are published when the
+       raster counter wraps around, the host system registers the video memory
+    */
+    chips_vidlog_t* vidlog;
 } m6569_desc_t;
 
 // register bank
@@ -225,6 +232,7 @@ typedef struct {
     bool display_state;             // true: in display state, false: in idle state
     bool badline;                   // true when the badline state is active
     bool frame_badlines_enabled;    // true when badlines are enabled in frame
+    uint32_t frame_count;           // incremented when the raster counter wraps around
 } m6569_raster_unit_t;
 
 // address generator / memory interface state
@@ -259,6 +267,9 @@ typedef struct {
     uint16_t vis_x0, vis_y0, vis_x1, vis_y1;  // the visible area
     uint16_t vis_w, vis_h;      // width of visible area
     uint8_t* fb;                // pointer to host framebuffer start
+    chips_triple_buffer_t* triple_buffer;   // optional, rotates fb at the start of each frame
+    chips_vidlog_t* vidlog;     // optional raw video log
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
 } m6569_crt_t;
 
 // graphics sequencer state
@@ -297,6 +308,7 @@ typedef struct {
 // the m6569 state structure
 typedef struct {
     bool debug_vis;             // toggle this to switch debug visualization on/off
+    bool headless;              // skip framebuffer writes (set by the host system)
     m6569_registers_t reg;
     m6569_crt_t crt;
     m6569_border_unit_t brd;
@@ -324,6 +336,10 @@ uint32_t m6569_color(size_t i);
 void m6569_snapshot_onsave(m6569_t* snapshot);
 // fixup m6569_t snapshot after loading
 void m6569_snapshot_onload(m6569_t* snapshot, m6569_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the m6569_t state (excluding host pointers)
+uint64_t m6569_hash(const m6569_t* vic, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -377,6 +393,13 @@ static void _m6569_init_crt(m6569_crt_t* crt, const m6569_desc_t* desc) {
     CHIPS_ASSERT((desc->screen.x & 7) == 0);
     CHIPS_ASSERT((desc->screen.width & 7) == 0);
     crt->fb = desc->framebuffer.ptr;
+    crt->triple_buffer = desc->triple_buffer;
+    if (crt->triple_buffer) {
+        CHIPS_ASSERT(crt->triple_buffer->size >= M6569_FRAMEBUFFER_SIZE_BYTES);
+        crt->fb = chips_triple_buffer_back(crt->triple_buffer);
+    }
+    crt->vidlog = desc->vidlog;
+    chips_dirty_lines_set_all(&crt->dirty_lines);
     crt->vis_x0 = desc->screen.x / M6569_PIXELS_PER_TICK;
     crt->vis_y0 = desc->screen.y;
     crt->vis_w = desc->screen.width / M6569_PIXELS_PER_TICK;
@@ -448,6 +471,11 @@ void m6569_reset(m6569_t* vic) {
     _m6569_reset_video_matrix_unit(&vic->vm);
     _m6569_reset_graphics_unit(&vic->gunit);
     _m6569_reset_sprite_unit(&vic->sunit);
+    if (vic->crt.vidlog) {
+        for (uint8_t i = 0; i <= 0x2E; i++) {
+            chips_vidlog_write(vic->crt.vidlog, vic->rs.h_count, vic->rs.v_count, i, vic->reg.regs[i]);
+        }
+    }
 }
 
 /*--- register read/writes ---------------------------------------------------*/
@@ -696,6 +724,9 @@ static void _m6569_write(m6569_t* vic, uint64_t pins) {
     }
     if (write) {
         r->regs[r_addr] = data;
+        if (vic->crt.vidlog) {
+            chips_vidlog_write(vic->crt.vidlog, vic->rs.h_count, vic->rs.v_count, r_addr, data);
+        }
     }
 }
 
@@ -956,24 +987,65 @@ static inline uint64_t _m6569_sunit_dma_aec(m6569_t* vic, uint32_t s_index, uint
     return pins;
 }
 
-static inline uint16_t _m6569_sunit_decode(m6569_t* vic, uint8_t hpos) {
-    /* this will tick all the sprite units and return the color
-        of the highest-priority sprite color for the current pixel in
-        the lower 8 bits of the result, the high 8 bits of the result
-        have one bit set for each sprite unit that produced a color
-        (used for collision detection)
+/*
+    Sprite coverage masks for 8 pixels are passed around in an uint64_t,
+    with one byte per pixel (pixel 0 in the lowest byte), and one bit per
+    sprite unit in each byte. This allows to check sprite-sprite and
+    sprite-data collisions for all 8 pixels at once with a few bitwise
+    operations on a single 64-bit integer.
+*/
+#define _M6569_BYTES_01 (0x0101010101010101ULL)
+#define _M6569_BYTES_80 (0x8080808080808080ULL)
+
+// returns 0xFF in each byte which is not zero, and 0x00 otherwise
+static inline uint64_t _m6569_bytes_nonzero(uint64_t x) {
+    uint64_t nz = (((x & ~_M6569_BYTES_80) + ~_M6569_BYTES_80) | x) & _M6569_BYTES_80;
+    return (nz >> 7) * 0xFF;
+}
+
+// subtract 1 from each byte individually (without borrowing into the next byte)
+static inline uint64_t _m6569_bytes_dec(uint64_t x) {
+    return ((x | _M6569_BYTES_80) - _M6569_BYTES_01) ^ ((x ^ _M6569_BYTES_80) & _M6569_BYTES_80);
+}
+
+// or-fold all 8 bytes into one byte
+static inline uint8_t _m6569_bytes_or(uint64_t x) {
+    x |= x >> 32;
+    x |= x >> 16;
+    x |= x >> 8;
+    return (uint8_t)x;
+}
 
-        The function returns 0 if the sprite units didn't produce a color.
+static inline uint64_t _m6569_sunit_decode(m6569_t* vic, uint8_t hpos, uint8_t* colors) {
+    /* this will tick all the sprite units for the next 8 pixels and
+        return a coverage mask for each pixel (see above), and write the
+        color of the highest-priority sprite for each pixel to colors[]
+
+        The sprite units are independent from each other, so each sprite
+        is ticked through all 8 pixels in one go. Sprites are processed
+        from lowest to highest priority, so that higher priority colors
+        overwrite lower priority colors.
+
+        Pixels which are not covered by any sprite have a coverage mask
+        of 0, and their color is undefined.
+
+        Sets the sprite-sprite collision bits and interrupt for all pixels
+        where more than one sprite produced a color.
     */
-    uint16_t c = 0;
-    bool collision = false;
+    uint64_t cov = 0;
     m6569_sprite_unit_t* su = &vic->sunit;
     uint8_t mxe = vic->reg.mxe;
     uint8_t mmc = vic->reg.mmc;
-    for (size_t i = 0; i < 8; i++) {
-        if (su->disp_enabled[i] && (hpos >= su->h_first[i]) && (hpos <= su->h_last[i])) {
+    for (int i = 7; i >= 0; i--) {
+        if (!(su->disp_enabled[i] && (hpos >= su->h_first[i]) && (hpos <= su->h_last[i]))) {
+            continue;
+        }
+        const uint8_t bit = 1<<i;
+        const bool multicolor = 0 != (mmc & bit);
+        const bool xexp = 0 != (mxe & bit);
+        for (size_t px = 0; px < 8; px++) {
             if (su->delay_count[i] == 0) {
-                if ((0 == (su->xexp_count[i]++ & 1)) || (0 == (mxe & (1<<i)))) {
+                if ((0 == (su->xexp_count[i]++ & 1)) || !xexp) {
                     // bit 31 of outp is the current shifter output
                     su->outp[i] = su->shift[i];
                     // bits 31 and 30 of outp is half-frequency shifter output
@@ -982,32 +1054,16 @@ static inline uint16_t _m6569_sunit_decode(m6569_t* vic, uint8_t hpos) {
                     }
                     su->shift[i] <<= 1;
                 }
-                if (mmc & (1<<i)) {
-                    // multicolor mode
-                    uint32_t ci = (su->outp2[i] & ((1<<31)|(1<<30)))>>30;
+                if (multicolor) {
+                    uint32_t ci = (su->outp2[i] & ((1U<<31)|(1U<<30)))>>30;
                     if (ci != 0) {
-                        // don't overwrite higher-priority colors
-                        if (0 == c) {
-                            c = su->colors[i][ci];
-                        }
-                        else {
-                            collision = true;
-                        }
-                        c |= (1<<(8+i));
+                        colors[px] = su->colors[i][ci];
+                        cov |= (uint64_t)bit << (px * 8);
                     }
                 }
-                else {
-                    /* standard color mode */
-                    if (su->outp[i] & (1<<31)) {
-                        /* don't overwrite higher-priority colors */
-                        if (0 == c) {
-                            c = su->colors[i][2] | (1<<(24+i));
-                        }
-                        else {
-                            collision = true;
-                        }
-                        c |= (1<<(8+i));
-                    }
+                else if (su->outp[i] & (1U<<31)) {
+                    colors[px] = su->colors[i][2];
+                    cov |= (uint64_t)bit << (px * 8);
                 }
             }
             else {
@@ -1015,24 +1071,42 @@ static inline uint16_t _m6569_sunit_decode(m6569_t* vic, uint8_t hpos) {
             }
         }
     }
-    if (collision) {
-        vic->reg.mcm |= (c>>8);
+    // a pixel has a sprite-sprite collision if more than one bit is set
+    const uint64_t multi = _m6569_bytes_nonzero(cov & _m6569_bytes_dec(cov));
+    if (multi) {
+        vic->reg.mcm |= _m6569_bytes_or(cov & multi);
         vic->reg.int_latch |= M6569_INT_IMMC;
     }
-    return c;
+    return cov;
+}
+
+/*
+    Returns true if any sprite unit may produce a pixel in the 8-pixel
+    group at hpos, if not, _m6569_sunit_decode() would be a no-op for
+    all 8 pixels.
+*/
+static inline bool _m6569_sunit_active(m6569_t* vic, uint8_t hpos) {
+    const m6569_sprite_unit_t* su = &vic->sunit;
+    for (size_t i = 0; i < 8; i++) {
+        if (su->disp_enabled[i] && (hpos >= su->h_first[i]) && (hpos <= su->h_last[i])) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /*
     Check for mob-data collision.
 
-    Takes the bitmap color bmc (top 8 bits are 0 if background color)
-    the sprite color sc (top 8 bits set for each sprite which
-    produced a non-transparant color), and sets the md
-    collision bitmask, and the IMBC interrupt bit.
+    Takes the sprite coverage masks cov and the foreground masks fg
+    (0xFF for each pixel where the graphics sequencer produced a
+    foreground color), and sets the md collision bitmask and the
+    IMBC interrupt bit.
 */
-static inline void _m6569_test_mob_data_col(m6569_t* vic, uint16_t bmc, uint16_t sc) {
-    if ((sc & bmc & 0xFF00) != 0) {
-        vic->reg.mcd |= (sc>>8);
+static inline void _m6569_test_mob_data_col(m6569_t* vic, uint64_t cov, uint64_t fg) {
+    const uint64_t col = cov & fg;
+    if (col != 0) {
+        vic->reg.mcd |= _m6569_bytes_or(col);
         vic->reg.int_latch |= M6569_INT_IMBC;
     }
 }
@@ -1070,9 +1144,8 @@ static inline uint8_t _m6569_color_multiplex(uint16_t bmc, uint16_t sc, uint8_t
     return c;
 }
 
-// decode the next 8 pixels
-static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* dst, uint8_t hpos) {
-
+// start the sprite shifters of sprites which become visible at hpos
+static inline void _m6569_sunit_rewind(m6569_t* vic, uint8_t hpos) {
     m6569_sprite_unit_t* su = &vic->sunit;
     for (size_t i = 0; i < 8; i++) {
         if (su->disp_enabled[i] && (hpos == su->h_first[i])) {
@@ -1081,6 +1154,12 @@ static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* d
             su->xexp_count[i] = 0;
         }
     }
+}
+
+// decode the next 8 pixels
+static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* dst, uint8_t hpos) {
+
+    _m6569_sunit_rewind(vic, hpos);
 
     /*
         "...the vertical border flip flop controls the output of the graphics
@@ -1108,12 +1187,40 @@ static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* d
     */
     bool brd = vic->brd.vert | vic->brd.main;
     uint8_t brd_color = vic->brd.main ? vic->brd.bc : vic->gunit.bg[0];
-    const uint8_t mdp = vic->reg.mdp;
     const uint8_t mode = vic->gunit.mode;
+    if (!_m6569_sunit_active(vic, hpos)) {
+        /* fast path: no sprite unit can produce a pixel in this 8-pixel
+           group, so there's no color multiplexing and no collisions, only
+           the graphics sequencer needs to be ticked
+        */
+        if (brd) {
+            for (size_t i = 0; i < 8; i++) {
+                _m6569_gunit_tick(vic, g_data);
+            }
+            memset(dst, brd_color, 8);
+        }
+        else {
+            for (size_t i = 0; i < 8; i++) {
+                _m6569_gunit_tick(vic, g_data);
+                uint16_t bmc = 0;
+                switch (mode) {
+                    case 0: bmc = _m6569_gunit_decode_mode0(vic); break;
+                    case 1: bmc = _m6569_gunit_decode_mode1(vic); break;
+                    case 2: bmc = _m6569_gunit_decode_mode2(vic); break;
+                    case 3: bmc = _m6569_gunit_decode_mode3(vic); break;
+                    case 4: bmc = _m6569_gunit_decode_mode4(vic); break;
+                }
+                dst[i] = (uint8_t)bmc;
+            }
+        }
+        return;
+    }
+    const uint8_t mdp = vic->reg.mdp;
+    uint8_t s_colors[8];
+    const uint64_t cov = _m6569_sunit_decode(vic, hpos, s_colors);
+    uint64_t fg = 0;
     uint16_t bmc = 0;
     for (size_t i = 0; i < 8; i++) {
-        // lower 8 bit sprite color, top 8 bit 'coverage mask'
-        uint16_t sc = _m6569_sunit_decode(vic, hpos);
         _m6569_gunit_tick(vic, g_data);
         // bmc: lower 8 bit color, top 8 bit set (foregreound) or cleared (background)
         switch (mode) {
@@ -1123,8 +1230,34 @@ static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* d
             case 3: bmc = _m6569_gunit_decode_mode3(vic); break;
             case 4: bmc = _m6569_gunit_decode_mode4(vic); break;
         }
-        _m6569_test_mob_data_col(vic, bmc, sc);
-        dst[i] = brd ? brd_color : _m6569_color_multiplex(bmc, sc, mdp);
+        fg |= (uint64_t)(bmc >> 8) << (i * 8);
+        if (!brd) {
+            // lower 8 bit sprite color, top 8 bit 'coverage mask'
+            const uint8_t mask = (uint8_t)(cov >> (i * 8));
+            const uint16_t sc = mask ? ((mask << 8) | s_colors[i]) : 0;
+            dst[i] = _m6569_color_multiplex(bmc, sc, mdp);
+        }
+    }
+    if (brd) {
+        memset(dst, brd_color, 8);
+    }
+    _m6569_test_mob_data_col(vic, cov, fg);
+}
+
+/* headless version of _m6569_decode_pixels(), updates the sequencer
+   state and sprite collisions but doesn't write any pixels
+*/
+static inline void _m6569_decode_pixels_headless(m6569_t* vic, uint8_t g_data, uint8_t hpos) {
+    if (_m6569_sunit_active(vic, hpos)) {
+        // sprite pixels may collide, need to take the slow path
+        uint8_t dummy[8];
+        _m6569_decode_pixels(vic, g_data, dummy, hpos);
+    }
+    else {
+        _m6569_sunit_rewind(vic, hpos);
+        for (size_t i = 0; i < 8; i++) {
+            _m6569_gunit_tick(vic, g_data);
+        }
     }
 }
 
@@ -1184,6 +1317,10 @@ static inline void _m6569_rs_next_rasterline(m6569_t* vic) {
     if (vic->rs.v_count == (M6569_VTOTAL-1)) {
         vic->rs.v_count = 0;
         vic->rs.vc_base = 0;
+        vic->rs.frame_count++;
+        if (vic->crt.vidlog) {
+            chips_vidlog_publish(vic->crt.vidlog);
+        }
     }
     else {
         vic->rs.v_count++;
@@ -1280,6 +1417,9 @@ static inline void _m6569_crt_next_crtline(m6569_t* vic) {
     vic->crt.x = 0;
     if (vic->rs.v_count == _M6569_VRETRACEPOS) {
         vic->crt.y = 0;
+        if (vic->crt.triple_buffer) {
+            vic->crt.fb = chips_triple_buffer_publish(vic->crt.triple_buffer);
+        }
     }
     else {
         vic->crt.y++;
@@ -1625,14 +1765,26 @@ static uint64_t _m6569_tick(m6569_t* vic, uint64_t pins) {
         const size_t y = vic->rs.v_count;
         uint8_t* dst = vic->crt.fb + (y * M6569_FRAMEBUFFER_WIDTH) + (x * M6569_PIXELS_PER_TICK);
         _m6569_decode_pixels_debug(vic, g_data, 0 != (pins & M6569_BA), dst, vic->rs.h_count);
+        // the debug visualization also modifies the previous 8 pixels
+        chips_dirty_lines_set(&vic->crt.dirty_lines, y);
+        if ((x == 0) && (y > 0)) {
+            chips_dirty_lines_set(&vic->crt.dirty_lines, y - 1);
+        }
     }
     else if ((vic->crt.x >= vic->crt.vis_x0) && (vic->crt.x < vic->crt.vis_x1) &&
              (vic->crt.y >= vic->crt.vis_y0) && (vic->crt.y < vic->crt.vis_y1))
     {
-        const size_t x = vic->crt.x - vic->crt.vis_x0;
-        const size_t y = vic->crt.y - vic->crt.vis_y0;
-        uint8_t* dst = vic->crt.fb + (y * M6569_FRAMEBUFFER_WIDTH) + (x * M6569_PIXELS_PER_TICK);
-        _m6569_decode_pixels(vic, g_data, dst, vic->rs.h_count);
+        if (CHIPS_HEADLESS_SKIP(vic->headless)) {
+            _m6569_decode_pixels_headless(vic, g_data, vic->rs.h_count);
+        }
+        else {
+            const size_t x = vic->crt.x - vic->crt.vis_x0;
+            const size_t y = vic->crt.y - vic->crt.vis_y0;
+            uint8_t* dst = vic->crt.fb + (y * M6569_FRAMEBUFFER_WIDTH) + (x * M6569_PIXELS_PER_TICK);
+            uint8_t pixels[M6569_PIXELS_PER_TICK];
+            _m6569_decode_pixels(vic, g_data, pixels, vic->rs.h_count);
+            chips_dirty_lines_copy(&vic->crt.dirty_lines, y, dst, pixels, sizeof(pixels));
+        }
     }
     vic->vm.vmli = vic->vm.next_vmli;
     return pins;
@@ -1758,6 +1910,8 @@ void m6569_snapshot_onsave(m6569_t* snapshot) {
     snapshot->mem.fetch_cb = 0;
     snapshot->mem.user_data = 0;
     snapshot->crt.fb = 0;
+    snapshot->crt.triple_buffer = 0;
+    snapshot->crt.vidlog = 0;
 }
 
 void m6569_snapshot_onload(m6569_t* snapshot, m6569_t* sys) {
@@ -1765,6 +1919,21 @@ void m6569_snapshot_onload(m6569_t* snapshot, m6569_t* sys) {
     snapshot->mem.fetch_cb = sys->mem.fetch_cb;
     snapshot->mem.user_data = sys->mem.user_data;
     snapshot->crt.fb = sys->crt.fb;
+    snapshot->crt.triple_buffer = sys->crt.triple_buffer;
+    snapshot->crt.vidlog = sys->crt.vidlog;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t m6569_hash(const m6569_t* vic, uint64_t h) {
+    CHIPS_ASSERT(vic);
+    m6569_t tmp;
+    memcpy(&tmp, vic, sizeof(tmp));
+    m6569_snapshot_onsave(&tmp);
+    tmp.debug_vis = false;
+    tmp.headless = false;
+    memset(&tmp.crt.dirty_lines, 0, sizeof(tmp.crt.dirty_lines));
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 #endif // CHIPS_IMPL
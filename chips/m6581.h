@@ -36,6 +36,33 @@
     The emulation has an additional "virtual pin" which is set to active
     whenever a new sample is ready (M6581_SAMPLE).
 
+    ## Lazy Mode
+
+    With m6581_desc_t.lazy set to true, m6581_tick() only counts ticks
+    until the next sample is due or the chip is selected for a register
+    access, and then renders all pending ticks in one block. As long as
+    no voice uses hard-sync or ring-modulation, the block is rendered one
+    voice at a time, followed by the filter and mixer pass. The output is
+    identical to the regular tick-by-tick mode. Call m6581_sync() before
+    inspecting the voice state (e.g. in a debugger).
+
+    In lazy mode, m6581_idle_ticks() returns the number of following ticks
+    which would only be counted. As long as the chip isn't selected, a
+    system doesn't need to call m6581_tick() for those ticks, but can
+    catch up with m6581_advance() before the next m6581_tick() (see the
+    event scheduler in chips_common.h).
+
+    ## Silent Mode
+
+    While m6581_t.silent is set (by the host system, e.g. in turbo mode
+    when the audio output is discarded anyway), only the wave and envelope
+    generators are advanced, the filter and mixer are skipped and no
+    samples are produced. In lazy mode, the generators are then only
+    brought up to date on register accesses, so that reading OSC3 and
+    ENV3 still returns the exact values. Any number of ticks can be
+    caught up with m6581_advance() in silent mode. Call m6581_sync()
+    before clearing the flag.
+
     ## Links
 
     - http://blog.kevtris.org/?p=13
@@ -170,6 +197,7 @@ typedef struct {
     int tick_hz;        // frequency at which m6581_tick() will be called in Hz
     int sound_hz;       // sound sample frequency
     float magnitude;    // output sample magnitude (0=silence to 1=max volume)
+    bool lazy;          // render in blocks between register accesses (see Lazy Mode)
 } m6581_desc_t;
 
 // envelope generator state
@@ -238,6 +266,11 @@ typedef struct {
     float sample_accum_count;
     float sample_mag;
     float sample;
+    // lazy mode state
+    bool lazy;
+    uint32_t lazy_ticks;            // ticks not yet rendered
+    uint32_t lazy_sample_ticks;     // number of lazy ticks until the next sample is due
+    bool silent;                    // only advance the generators (set by the host system, see Silent Mode)
     // debug inspection
     uint64_t pins;
 } m6581_t;
@@ -248,6 +281,12 @@ void m6581_init(m6581_t* sid, const m6581_desc_t* desc);
 void m6581_reset(m6581_t* sid);
 // tick a m6581_t instance
 uint64_t m6581_tick(m6581_t* sid, uint64_t pins);
+// lazy mode: render all pending ticks
+void m6581_sync(m6581_t* sid);
+// lazy mode: number of following ticks which can be skipped while not selected (always 0 in regular mode)
+uint32_t m6581_idle_ticks(const m6581_t* sid);
+// lazy mode: catch up with skipped ticks (must not be greater than m6581_idle_ticks() unless in silent mode)
+void m6581_advance(m6581_t* sid, uint32_t num_ticks);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -277,6 +316,8 @@ uint64_t m6581_tick(m6581_t* sid, uint64_t pins);
 #define M6581_DCWAVE (0) // (0x380)
 #define M6581_DCMIXER (0) // (((-0xFFF*0xFF)/18) / (1<<7))
 #define M6581_DCVOICE (0) // (0x800*0xFF)
+/* max number of ticks rendered in one block in lazy mode */
+#define M6581_BLOCK_SIZE (64)
 
 static const uint32_t _m6581_rate_count_period[16] = {
     0x7F00, 0x0006, 0x003C, 0x0330, 0x20C0, 0x6755, 0x3800, 0x500E,
@@ -322,6 +363,16 @@ static void _m6581_init_cutoff_table() {
 static void _m6581_set_filter_cutoff(m6581_filter_t*);
 static void _m6581_set_resonance(m6581_filter_t*);
 
+/* in lazy mode, compute the number of ticks until the sample counter runs out */
+static void _m6581_update_lazy_sample_ticks(m6581_t* sid) {
+    if (sid->sample_counter > 0) {
+        sid->lazy_sample_ticks = (sid->sample_counter + M6581_FIXEDPOINT_SCALE - 1) / M6581_FIXEDPOINT_SCALE;
+    }
+    else {
+        sid->lazy_sample_ticks = 1;
+    }
+}
+
 static void _m6581_init_filter(m6581_filter_t* f, int sound_hz) {
     memset(f, 0, sizeof(*f));
     f->nyquist_freq = sound_hz / 2;
@@ -339,6 +390,8 @@ void m6581_init(m6581_t* sid, const m6581_desc_t* desc) {
     sid->sample_counter = sid->sample_period;
     sid->sample_mag = desc->magnitude;
     sid->sample_accum_count = 1.0f;
+    sid->lazy = desc->lazy;
+    _m6581_update_lazy_sample_ticks(sid);
     for (int i = 0; i < 3; i++) {
         _m6581_init_voice(&sid->voice[i]);
     }
@@ -358,6 +411,8 @@ void m6581_reset(m6581_t* sid) {
     sid->sample = 0.0f;
     sid->sample_accum = 0.0f;
     sid->sample_accum_count = 1.0f;
+    sid->lazy_ticks = 0;
+    _m6581_update_lazy_sample_ticks(sid);
     sid->pins = 0;
 }
 
@@ -644,6 +699,26 @@ static inline int _m6581_filter_output(m6581_filter_t* f, int vi) {
     return vf * (1<<7);
 }
 
+/* filter and mix the voice outputs of one tick, return true when new sample ready */
+static inline bool _m6581_mix(m6581_t* sid, int sum_outp, int sum_filtered_outp) {
+    int accu = (sum_outp + _m6581_filter_output(&sid->filter, sum_filtered_outp) + M6581_DCMIXER) * sid->filter.volume;
+    int sample = accu / (1<<12);
+    sid->sample_accum += (sample / 16384.0f);
+    sid->sample_accum_count += 1.0f;
+
+    /* new sample? */
+    sid->sample_counter -= M6581_FIXEDPOINT_SCALE;
+    if (sid->sample_counter <= 0) {
+        sid->sample_counter += sid->sample_period;
+        float s = sid->sample_accum / sid->sample_accum_count;
+        sid->sample = sid->sample_mag * s;
+        sid->sample_accum = 0.0f;
+        sid->sample_accum_count = 0.0f;
+        return true;
+    }
+    return false;
+}
+
 /* tick the sound generation, return true when new sample ready */
 static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
     /* decay the last written register value */
@@ -680,19 +755,7 @@ static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
             }
         }
     }
-    int accu = (sum_outp + _m6581_filter_output(&sid->filter, sum_filtered_outp) + M6581_DCMIXER) * sid->filter.volume;
-    int sample = accu / (1<<12);
-    sid->sample_accum += (sample / 16384.0f);
-    sid->sample_accum_count += 1.0f;
-
-    /* new sample? */
-    sid->sample_counter -= M6581_FIXEDPOINT_SCALE;
-    if (sid->sample_counter <= 0) {
-        sid->sample_counter += sid->sample_period;
-        float s = sid->sample_accum / sid->sample_accum_count;
-        sid->sample = sid->sample_mag * s;
-        sid->sample_accum = 0.0f;
-        sid->sample_accum_count = 0.0f;
+    if (_m6581_mix(sid, sum_outp, sum_filtered_outp)) {
         pins |= M6581_SAMPLE;
     }
     else {
@@ -701,6 +764,100 @@ static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
     return pins;
 }
 
+/* silent mode: only advance the wave and envelope generators */
+static void _m6581_advance_voices(m6581_t* sid, uint32_t num_ticks) {
+    if (sid->bus_decay > 0) {
+        if (sid->bus_decay <= num_ticks) {
+            sid->bus_decay = 0;
+            sid->bus_value = 0;
+        }
+        else {
+            sid->bus_decay -= num_ticks;
+        }
+    }
+    const uint8_t coupled = (sid->voice[0].ctrl | sid->voice[1].ctrl | sid->voice[2].ctrl) & (M6581_CTRL_SYNC|M6581_CTRL_RINGMOD);
+    if (coupled) {
+        for (uint32_t t = 0; t < num_ticks; t++) {
+            for (int i = 0; i < 3; i++) {
+                _m6581_voice_tick(sid, i);
+            }
+            for (int i = 0; i < 3; i++) {
+                _m6581_voice_sync(sid, i);
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < 3; i++) {
+            for (uint32_t t = 0; t < num_ticks; t++) {
+                _m6581_voice_tick(sid, i);
+            }
+        }
+    }
+}
+
+/* render a block of ticks in lazy mode, return true if the last tick produced a new sample */
+static bool _m6581_render_block(m6581_t* sid, uint32_t num_ticks) {
+    CHIPS_ASSERT(num_ticks <= M6581_BLOCK_SIZE);
+    bool sample_ready = false;
+    const uint8_t coupled = (sid->voice[0].ctrl | sid->voice[1].ctrl | sid->voice[2].ctrl) & (M6581_CTRL_SYNC|M6581_CTRL_RINGMOD);
+    if (coupled) {
+        /* voices depend on each other, render tick by tick */
+        for (uint32_t t = 0; t < num_ticks; t++) {
+            sample_ready = 0 != (_m6581_tick(sid, 0) & M6581_SAMPLE);
+        }
+        return sample_ready;
+    }
+    /* decay the last written register value */
+    if (sid->bus_decay > 0) {
+        if (sid->bus_decay <= num_ticks) {
+            sid->bus_decay = 0;
+            sid->bus_value = 0;
+        }
+        else {
+            sid->bus_decay -= num_ticks;
+        }
+    }
+    /* voices are independent, render one voice after another */
+    int sum_outp[M6581_BLOCK_SIZE];
+    int sum_filtered_outp[M6581_BLOCK_SIZE];
+    memset(sum_outp, 0, num_ticks * sizeof(int));
+    memset(sum_filtered_outp, 0, num_ticks * sizeof(int));
+    for (int i = 0; i < 3; i++) {
+        const m6581_voice_t* v = &sid->voice[i];
+        int* outp = (sid->filter.voices & (1<<i)) ? sum_filtered_outp : sum_outp;
+        const bool muted = v->muted && !(sid->filter.voices & (1<<i));
+        for (uint32_t t = 0; t < num_ticks; t++) {
+            _m6581_voice_tick(sid, i);
+            int wav_out = muted ? 0 : (int) v->wav_output;
+            int env_out = (int) v->env_cur_level;
+            outp[t] += (wav_out - M6581_DCWAVE) * env_out + M6581_DCVOICE;
+        }
+    }
+    /* filter and mixer pass */
+    for (uint32_t t = 0; t < num_ticks; t++) {
+        sample_ready = _m6581_mix(sid, sum_outp[t], sum_filtered_outp[t]);
+    }
+    return sample_ready;
+}
+
+/* render all pending ticks in lazy mode, return true if the last tick produced a new sample */
+static bool _m6581_render(m6581_t* sid) {
+    bool sample_ready = false;
+    uint32_t num_ticks = sid->lazy_ticks;
+    if (sid->silent) {
+        _m6581_advance_voices(sid, num_ticks);
+        num_ticks = 0;
+    }
+    while (num_ticks > 0) {
+        uint32_t n = (num_ticks > M6581_BLOCK_SIZE) ? M6581_BLOCK_SIZE : num_ticks;
+        sample_ready = _m6581_render_block(sid, n);
+        num_ticks -= n;
+    }
+    sid->lazy_ticks = 0;
+    _m6581_update_lazy_sample_ticks(sid);
+    return sample_ready;
+}
+
 /* read a register */
 static uint64_t _m6581_read(m6581_t* sid, uint64_t pins) {
     uint8_t reg = pins & M6581_ADDR_MASK;
@@ -819,7 +976,23 @@ uint64_t m6581_tick(m6581_t* sid, uint64_t pins) {
     CHIPS_ASSERT(sid);
 
     /* first perform the regular per-tick actions */
-    pins = _m6581_tick(sid, pins);
+    if (sid->lazy) {
+        /* only render when a sample is due or a register is accessed */
+        pins &= ~M6581_SAMPLE;
+        sid->lazy_ticks++;
+        if ((pins & M6581_CS) || (!sid->silent && (sid->lazy_ticks >= sid->lazy_sample_ticks))) {
+            if (_m6581_render(sid)) {
+                pins |= M6581_SAMPLE;
+            }
+        }
+    }
+    else if (sid->silent) {
+        _m6581_advance_voices(sid, 1);
+        pins &= ~M6581_SAMPLE;
+    }
+    else {
+        pins = _m6581_tick(sid, pins);
+    }
 
     /* register read/write */
     if (pins & M6581_CS) {
@@ -834,4 +1007,28 @@ uint64_t m6581_tick(m6581_t* sid, uint64_t pins) {
     return pins;
 }
 
+void m6581_sync(m6581_t* sid) {
+    CHIPS_ASSERT(sid);
+    if (sid->lazy_ticks > 0) {
+        _m6581_render(sid);
+    }
+}
+
+uint32_t m6581_idle_ticks(const m6581_t* sid) {
+    CHIPS_ASSERT(sid);
+    if (sid->lazy && ((sid->lazy_ticks + 1) < sid->lazy_sample_ticks)) {
+        // the tick which reaches lazy_sample_ticks renders a block
+        return sid->lazy_sample_ticks - sid->lazy_ticks - 1;
+    }
+    else {
+        return 0;
+    }
+}
+
+void m6581_advance(m6581_t* sid, uint32_t num_ticks) {
+    CHIPS_ASSERT(sid);
+    CHIPS_ASSERT(sid->silent || (num_ticks <= m6581_idle_ticks(sid)));
+    sid->lazy_ticks += num_ticks;
+}
+
 #endif /* CHIPS_IMPL */
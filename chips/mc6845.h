@@ -264,6 +264,13 @@ typedef struct {
     bool h_de;                      /* horizontal display enable */
     bool v_de;                      /* vertical display enable */
     uint64_t pins;                  /* pin state after last tick */
+
+    /* horizontal span cache, rebuilt by each full tick and invalidated by
+       register writes: until h_ctr reaches span_end no coincidence can
+       trigger, so only MA advances and the other output pins stay at span_pins
+    */
+    uint16_t span_end;              /* first h_ctr value with a possible coincidence (0: invalid) */
+    uint64_t span_pins;             /* output pins without MA0..MA13 inside the span */
 } mc6845_t;
 
 /* helper macros to extract address and data values from pin mask */
@@ -398,6 +405,7 @@ void mc6845_reset(mc6845_t* c) {
     c->vs = false;
     c->h_de = false;
     c->v_de = false;
+    c->span_end = 0;
     _mc6845_co_clear(c);
 }
 
@@ -515,6 +523,8 @@ uint64_t mc6845_iorq(mc6845_t* c, uint64_t pins) {
                 /* write register value (only if register is writable) */
                 if (_mc6845_rw[c->type][i] & (1<<0)) {
                     c->reg[i] = MC6845_GET_DATA(pins) & _mc6845_mask[i];
+                    /* any register may affect the output pins, leave the span */
+                    c->span_end = 0;
                     /* update the coincidence circuit state */
                     switch (i) {
                         case MC6845_HTOTAL:
@@ -630,7 +640,33 @@ static inline void _mc6845_scanline(mc6845_t* c) {
     }
 }
 
+/* compute the end of the horizontal span starting after the current h_ctr */
+static inline void _mc6845_update_span(mc6845_t* c, uint64_t pins) {
+    if (c->hs || c->co_htotal || c->co_hdisp || c->co_hspos) {
+        /* the HSYNC width counter and pending coincidences need the full tick */
+        c->span_end = 0;
+        return;
+    }
+    uint16_t end = c->h_total + 1;
+    if ((c->h_displayed > c->h_ctr) && (c->h_displayed < end)) {
+        end = c->h_displayed;
+    }
+    if ((c->h_sync_pos > c->h_ctr) && (c->h_sync_pos < end)) {
+        end = c->h_sync_pos;
+    }
+    c->span_end = end;
+    c->span_pins = pins & ~0x3FFFULL;
+}
+
 uint64_t mc6845_tick(mc6845_t* c) {
+    if ((c->h_ctr + 1) < c->span_end) {
+        /* fast path inside a span, same result as the full tick below */
+        c->ma = (c->ma + 1) & 0x3FFF;
+        c->h_ctr++;
+        const uint64_t pins = c->span_pins | c->ma;
+        c->pins = (c->pins & MC6845_IORQ_PINS) | pins;
+        return pins;
+    }
     c->ma = (c->ma + 1) & 0x3FFF;
     c->h_ctr = c->h_ctr + 1;
     _mc6845_co_cmp_hctr(c);
@@ -660,7 +696,9 @@ uint64_t mc6845_tick(mc6845_t* c) {
             c->hs = false;
         }
     }
-    return _mc6845_pins(c);
+    const uint64_t pins = _mc6845_pins(c);
+    _mc6845_update_span(c, pins);
+    return pins;
 }
 
 #endif /* CHIPS_IMPL */
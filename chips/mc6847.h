@@ -30,6 +30,16 @@
 
     FIXME: documentation
 
+    ## Linear Video Memory
+
+    By default, the MC6847 reads each video memory byte through the
+    fetch callback. If the system maps video memory linearly, provide
+    a pointer to the 8 KByte range addressed by the 13-bit address bus
+    in mc6847_desc_t.vidmem instead, and a whole row of video bytes will
+    be read directly from memory at the start of each scanline. Data bus
+    bits which are hardwired to the INV, A/S or INT/EXT pins (like on the
+    Acorn Atom) can be described with mc6847_desc_t.data_pins.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -257,10 +267,18 @@ typedef struct {
     int tick_hz;
     // pointer to an uint8_t framebuffer where video image is written to (must be at least 512*244 bytes)
     chips_range_t framebuffer;
-    // memory-fetch callback
+    // memory-fetch callback (optional if vidmem is provided)
     mc6847_fetch_t fetch_cb;
     // optional user-data for the fetch callback
     void* user_data;
+    // optional linear video memory (at least 8 KBytes), used instead of fetch_cb
+    chips_range_t vidmem;
+    // data bus bits wired to the INV, A/S and INT/EXT pins (only with vidmem, 0 if not wired)
+    struct {
+        uint8_t inv;
+        uint8_t as;
+        uint8_t intext;
+    } data_pins;
 } mc6847_desc_t;
 
 // the mc6847 state struct
@@ -277,15 +295,33 @@ typedef struct {
 
     // true during field-sync
     bool fs;
+    // incremented when the line counter wraps around
+    uint32_t frame_count;
 
     // the fetch callback function
     mc6847_fetch_t fetch_cb;
     // optional user-data for the fetch-callback
     void* user_data;
+    // optional linear video memory, used instead of fetch_cb if set
+    const uint8_t* vidmem;
+    // data bus bits wired to the INV, A/S and INT/EXT pins
+    uint8_t data_pins_inv;
+    uint8_t data_pins_as;
+    uint8_t data_pins_intext;
     // pointer to uint8_t buffer where decoded video image is written too
     uint8_t* fb;
+    // framebuffer rows changed since last chips_dirty_lines_clear()
+    chips_dirty_lines_t dirty_lines;
+    // skip framebuffer writes (set by the host system)
+    bool headless;
     // hardware colors
     uint32_t hwcolors[MC6847_HWCOLOR_NUM];
+    // pixel expansion lookup tables, indexed by CSS pin and pixel bit pattern
+    struct {
+        uint8_t alnum[2][256][8];   // font pattern => alphanumeric fg/bg pixels
+        uint8_t rg[2][256][8];      // video byte => resolution graphics pixels (1 dot per bit)
+        uint8_t cg[2][256][8];      // video byte => color graphics pixels (2 dots per 2 bits)
+    } lut;
 } mc6847_t;
 
 // initialize a new mc6847_t instance
@@ -298,6 +334,10 @@ uint64_t mc6847_tick(mc6847_t* vdg, uint64_t pins);
 void mc6847_snapshot_onsave(mc6847_t* snapshot);
 // fixup mc6847_t snapshot after loading
 void mc6847_snapshot_onload(mc6847_t* snapshot, mc6847_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the mc6847_t state (excluding host pointers)
+uint64_t mc6847_hash(const mc6847_t* vdg, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -311,19 +351,45 @@ void mc6847_snapshot_onload(mc6847_t* snapshot, mc6847_t* sys);
     #define CHIPS_ASSERT(c) assert(c)
 #endif
 
+#define _MC6847_VIDMEM_SIZE (0x2000)
 #define _MC6847_CLAMP(x) ((x)>255?255:(x))
 #define _MC6847_RGBA(r,g,b) (0xFF000000|_MC6847_CLAMP((r*4)/3)|(_MC6847_CLAMP((g*4)/3)<<8)|(_MC6847_CLAMP((b*4)/3)<<16))
 
+// build the pixel expansion lookup tables (the hardware color indices are fixed)
+static void _mc6847_init_luts(mc6847_t* vdg) {
+    for (size_t css = 0; css < 2; css++) {
+        const uint8_t alnum_fg = css ? MC6847_HWCOLOR_ALNUM_ORANGE : MC6847_HWCOLOR_ALNUM_GREEN;
+        const uint8_t alnum_bg = css ? MC6847_HWCOLOR_ALNUM_DARK_ORANGE : MC6847_HWCOLOR_ALNUM_DARK_GREEN;
+        const uint8_t rg_fg = css ? MC6847_HWCOLOR_GFX_BUFF : MC6847_HWCOLOR_GFX_GREEN;
+        const uint8_t cg_offset = css ? 4 : 0;
+        for (size_t m = 0; m < 256; m++) {
+            for (size_t p = 0; p < 8; p++) {
+                const bool bit = 0 != (m & (0x80>>p));
+                vdg->lut.alnum[css][m][p] = bit ? alnum_fg : alnum_bg;
+                vdg->lut.rg[css][m][p] = bit ? rg_fg : MC6847_HWCOLOR_BLACK;
+                vdg->lut.cg[css][m][p] = (uint8_t)(((m >> (6 - (p & 6))) & 3) + cg_offset);
+            }
+        }
+    }
+}
+
 void mc6847_init(mc6847_t* vdg, const mc6847_desc_t* desc) {
     CHIPS_ASSERT(vdg && desc);
     CHIPS_ASSERT(desc->framebuffer.ptr && (desc->framebuffer.size <= MC6847_FRAMEBUFFER_SIZE_BYTES));
-    CHIPS_ASSERT(desc->fetch_cb);
+    CHIPS_ASSERT(desc->fetch_cb || desc->vidmem.ptr);
+    CHIPS_ASSERT(!desc->vidmem.ptr || (desc->vidmem.size >= _MC6847_VIDMEM_SIZE));
     CHIPS_ASSERT((desc->tick_hz > 0) && (desc->tick_hz < MC6847_TICK_HZ));
 
     memset(vdg, 0, sizeof(*vdg));
     vdg->fb = desc->framebuffer.ptr;
+    chips_dirty_lines_set_all(&vdg->dirty_lines);
     vdg->fetch_cb = desc->fetch_cb;
     vdg->user_data = desc->user_data;
+    vdg->vidmem = (const uint8_t*) desc->vidmem.ptr;
+    vdg->data_pins_inv = desc->data_pins.inv;
+    vdg->data_pins_as = desc->data_pins.as;
+    vdg->data_pins_intext = desc->data_pins.intext;
+    _mc6847_init_luts(vdg);
 
     /* compute counter periods, the MC6847 is always clocked at 3.579 MHz,
        and the frequency of how the tick function is called must be
@@ -455,6 +521,71 @@ static const uint8_t _mc6847_font[64 * 12] = {
 };
 
 
+// 4 pixel bits => 8 pixel bits, each bit doubled (for 2-dot resolution graphics modes)
+static const uint8_t _mc6847_dup_bits[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+// 2x 2-bit colors => 8 bits, each 2-bit color doubled (for 4-dot color graphics mode CG1)
+static const uint8_t _mc6847_dup_colors[16] = {
+    0x00, 0x05, 0x0A, 0x0F, 0x50, 0x55, 0x5A, 0x5F,
+    0xA0, 0xA5, 0xAA, 0xAF, 0xF0, 0xF5, 0xFA, 0xFF,
+};
+
+/*
+    Read a row of video memory bytes, either directly from the linear
+    video memory, or through the fetch callback. The state of the pins
+    which may be driven by the fetched data (CSS, INV, A/S, INT/EXT) is
+    stored per byte in ctrl (may be 0 if not needed).
+
+    Returns the pin state after the last fetch.
+*/
+#define _MC6847_FETCH_CTRL_PINS (MC6847_CSS|MC6847_INV|MC6847_AS|MC6847_INTEXT)
+
+// apply the data bus bits which are wired to the INV, A/S and INT/EXT pins
+static inline uint64_t _mc6847_data_pins(const mc6847_t* vdg, uint64_t pins, uint8_t data) {
+    if (vdg->data_pins_inv) {
+        pins = (data & vdg->data_pins_inv) ? (pins | MC6847_INV) : (pins & ~MC6847_INV);
+    }
+    if (vdg->data_pins_as) {
+        pins = (data & vdg->data_pins_as) ? (pins | MC6847_AS) : (pins & ~MC6847_AS);
+    }
+    if (vdg->data_pins_intext) {
+        pins = (data & vdg->data_pins_intext) ? (pins | MC6847_INTEXT) : (pins & ~MC6847_INTEXT);
+    }
+    return pins;
+}
+
+static uint64_t _mc6847_fetch_row(mc6847_t* vdg, uint64_t pins, uint16_t addr, size_t num_bytes, uint8_t* data, uint64_t* ctrl) {
+    CHIPS_ASSERT((num_bytes > 0) && (num_bytes <= 32));
+    if (vdg->vidmem) {
+        CHIPS_ASSERT((addr + num_bytes) <= _MC6847_VIDMEM_SIZE);
+        memcpy(data, &vdg->vidmem[addr], num_bytes);
+        if (ctrl) {
+            for (size_t x = 0; x < num_bytes; x++) {
+                ctrl[x] = _mc6847_data_pins(vdg, pins, data[x]) & _MC6847_FETCH_CTRL_PINS;
+            }
+        }
+        // leave the pins in the same state as after the last callback fetch
+        MC6847_SET_ADDR(pins, addr + num_bytes - 1);
+        MC6847_SET_DATA(pins, data[num_bytes - 1]);
+        pins = _mc6847_data_pins(vdg, pins, data[num_bytes - 1]);
+    }
+    else {
+        void* ud = vdg->user_data;
+        for (size_t x = 0; x < num_bytes; x++) {
+            MC6847_SET_ADDR(pins, addr++);
+            pins = vdg->fetch_cb(pins, ud);
+            data[x] = MC6847_GET_DATA(pins);
+            if (ctrl) {
+                ctrl[x] = pins & _MC6847_FETCH_CTRL_PINS;
+            }
+        }
+    }
+    return pins;
+}
+
 static inline uint8_t _mc6847_border_color(uint64_t pins) {
     if (pins & MC6847_AG) {
         // a graphics mode, either green or buff, depending on CSS pin
@@ -467,22 +598,22 @@ static inline uint8_t _mc6847_border_color(uint64_t pins) {
 }
 
 static void _mc6847_decode_border(mc6847_t* vdg, uint64_t pins, size_t y) {
-    uint8_t* dst = &(vdg->fb[y * MC6847_FRAMEBUFFER_WIDTH]);
-    uint8_t c = _mc6847_border_color(pins);
-    for (size_t x = 0; x < MC6847_DISPLAY_WIDTH; x++) {
-        *dst++ = c;
-    }
+    uint8_t line[MC6847_DISPLAY_WIDTH];
+    memset(line, _mc6847_border_color(pins), sizeof(line));
+    chips_dirty_lines_copy(&vdg->dirty_lines, y, &(vdg->fb[y * MC6847_FRAMEBUFFER_WIDTH]), line, sizeof(line));
 }
 
 static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y) {
-    uint8_t* dst = &(vdg->fb[(y + MC6847_TOP_BORDER_LINES) * MC6847_FRAMEBUFFER_WIDTH]);
+    // decode into a line buffer first, so that unchanged rows aren't marked dirty
+    uint8_t line[MC6847_DISPLAY_WIDTH];
+    uint8_t* dst = line;
     uint8_t bc = _mc6847_border_color(pins);
-    void* ud = vdg->user_data;
+    const size_t css = (pins & MC6847_CSS) ? 1 : 0;
+    uint8_t data[32];
 
     // left border
-    for (size_t i = 0; i < MC6847_BORDER_PIXELS; i++) {
-        *dst++ = bc;
-    }
+    memset(dst, bc, MC6847_BORDER_PIXELS);
+    dst += MC6847_BORDER_PIXELS;
 
     // visible scanline
     if (pins & MC6847_AG) {
@@ -496,20 +627,20 @@ static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y)
                     10:    RG3, 128x192, 16 bytes per row
                     11:    RG6, 256x192, 32 bytes per row
             */
-            size_t dots_per_bit  = (sub_mode < 3) ? 2 : 1;
             size_t bytes_per_row = (sub_mode < 3) ? 16 : 32;
             size_t row_height = (pins & MC6847_GM2) ? 1 : (pins & MC6847_GM1) ? 2 : 3;
             uint16_t addr = (y / row_height) * bytes_per_row;
-            uint8_t fg_color = (pins & MC6847_CSS) ? MC6847_HWCOLOR_GFX_BUFF : MC6847_HWCOLOR_GFX_GREEN;
+            pins = _mc6847_fetch_row(vdg, pins, addr, bytes_per_row, data, 0);
+            const uint8_t* lut = &vdg->lut.rg[css][0][0];
             for (size_t x = 0; x < bytes_per_row; x++) {
-                MC6847_SET_ADDR(pins, addr++);
-                pins = vdg->fetch_cb(pins, ud);
-                uint8_t m = MC6847_GET_DATA(pins);
-                for (int p = 7; p >= 0; p--) {
-                    uint8_t c = ((m>>p) & 1) ? fg_color : MC6847_HWCOLOR_BLACK;
-                    for (size_t d = 0; d < dots_per_bit; d++) {
-                        *dst++ = c;
-                    }
+                const uint8_t m = data[x];
+                if (sub_mode < 3) {
+                    // 2 dots per bit
+                    memcpy(dst, &lut[_mc6847_dup_bits[m>>4] * 8], 8); dst += 8;
+                    memcpy(dst, &lut[_mc6847_dup_bits[m&15] * 8], 8); dst += 8;
+                }
+                else {
+                    memcpy(dst, &lut[m * 8], 8); dst += 8;
                 }
             }
         }
@@ -522,20 +653,20 @@ static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y)
                     10: CG3, 128x96, 32 bytes per row
                     11: CG6, 128x192, 32 bytes per row
             */
-            uint8_t color_offset = (pins & MC6847_CSS) ? 4 : 0;
-            size_t dots_per_2bit = (sub_mode == 0) ? 4 : 2;
             size_t bytes_per_row = (sub_mode == 0) ? 16 : 32;
             size_t row_height = (pins & MC6847_GM2) ? ((pins & MC6847_GM1) ? 1 : 2) : 3;
             uint16_t addr = (y / row_height) * bytes_per_row;
+            pins = _mc6847_fetch_row(vdg, pins, addr, bytes_per_row, data, 0);
+            const uint8_t* lut = &vdg->lut.cg[css][0][0];
             for (size_t x = 0; x < bytes_per_row; x++) {
-                MC6847_SET_ADDR(pins, addr++);
-                pins = vdg->fetch_cb(pins, ud);
-                uint8_t m = MC6847_GET_DATA(pins);
-                for (int p = 6; p >= 0; p -= 2) {
-                    const uint8_t c = ((m>>p) & 3) + color_offset;
-                    for (size_t d = 0; d < dots_per_2bit; d++) {
-                        *dst++ = c;
-                    }
+                const uint8_t m = data[x];
+                if (sub_mode == 0) {
+                    // 4 dots per 2 bits
+                    memcpy(dst, &lut[_mc6847_dup_colors[m>>4] * 8], 8); dst += 8;
+                    memcpy(dst, &lut[_mc6847_dup_colors[m&15] * 8], 8); dst += 8;
+                }
+                else {
+                    memcpy(dst, &lut[m * 8], 8); dst += 8;
                 }
             }
         }
@@ -550,16 +681,16 @@ static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y)
         // bit shifters to extract a 2x2 or 2x3 semigraphics 2-bit stack
         size_t shift_2x2 = (1 - (chr_y / 6))*2;
         size_t shift_2x3 = (2 - (chr_y / 4))*2;
-        uint8_t alnum_fg = (pins & MC6847_CSS) ? MC6847_HWCOLOR_ALNUM_ORANGE : MC6847_HWCOLOR_ALNUM_GREEN;
-        uint8_t alnum_bg = (pins & MC6847_CSS) ? MC6847_HWCOLOR_ALNUM_DARK_ORANGE : MC6847_HWCOLOR_ALNUM_DARK_GREEN;
+        const uint8_t* alnum_lut = &vdg->lut.alnum[css][0][0];
+        uint64_t ctrl[32];
+        pins = _mc6847_fetch_row(vdg, pins, addr, 32, data, ctrl);
         for (size_t x = 0; x < 32; x++) {
-            MC6847_SET_ADDR(pins, addr++);
-            pins = vdg->fetch_cb(pins, ud);
-            uint8_t chr = MC6847_GET_DATA(pins);
-            if (pins & MC6847_AS) {
+            const uint8_t chr = data[x];
+            const uint64_t chr_pins = ctrl[x];
+            if (chr_pins & MC6847_AS) {
                 // semigraphics mode
                 uint8_t fg_color;
-                if (pins & MC6847_INTEXT) {
+                if (chr_pins & MC6847_INTEXT) {
                     /*  2x3 semigraphics, 2 color sets at 4 colors (selected by CSS pin)
                         |C1|C0|L5|L4|L3|L2|L1|L0|
 
@@ -575,7 +706,7 @@ static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y)
                     // extract the 2 horizontal bits from one of the 3 stacks
                     m = (chr>>shift_2x3) & 3;
                     // 2 bits of color, CSS bit selects upper or lower half of color palette
-                    fg_color = ((chr>>6)&3) + ((pins & MC6847_CSS) ? 4:0);
+                    fg_color = ((chr>>6)&3) + ((chr_pins & MC6847_CSS) ? 4:0);
                 }
                 else {
                     /*  2x2 semigraphics, 8 colors + black
@@ -594,31 +725,29 @@ static uint64_t _mc6847_decode_scanline(mc6847_t* vdg, uint64_t pins, size_t y)
                     fg_color = (chr>>4) & 7;
                 }
                 // write the horizontal pixel blocks (2 blocks @ 4 pixel each)
-                for (int p = 1; p>=0; p--) {
-                    uint8_t c = (m & (1<<p)) ? fg_color : MC6847_HWCOLOR_BLACK;
-                    *dst++=c; *dst++=c; *dst++=c; *dst++=c;
-                }
+                memset(dst, (m & 2) ? fg_color : MC6847_HWCOLOR_BLACK, 4); dst += 4;
+                memset(dst, (m & 1) ? fg_color : MC6847_HWCOLOR_BLACK, 4); dst += 4;
             }
             else {
                 /*  alphanumeric mode
                     FIXME: INT_EXT (switch between internal and external font
                 */
-                uint8_t m = _mc6847_font[(chr&0x3F)*12 + chr_y];
-                if (pins & MC6847_INV) {
+                m = _mc6847_font[(chr&0x3F)*12 + chr_y];
+                if (chr_pins & MC6847_INV) {
                     m = ~m;
                 }
-                for (int p = 7; p >= 0; p--) {
-                    *dst++ = m & (1<<p) ? alnum_fg : alnum_bg;
-                }
+                memcpy(dst, &alnum_lut[m * 8], 8); dst += 8;
             }
         }
     }
 
     // right border
-    for (size_t i = 0; i < MC6847_BORDER_PIXELS; i++) {
-        *dst++ = bc;
-    }
+    memset(dst, bc, MC6847_BORDER_PIXELS);
+    dst += MC6847_BORDER_PIXELS;
+    CHIPS_ASSERT(dst == &line[MC6847_DISPLAY_WIDTH]);
 
+    const size_t fb_y = y + MC6847_TOP_BORDER_LINES;
+    chips_dirty_lines_copy(&vdg->dirty_lines, fb_y, &(vdg->fb[fb_y * MC6847_FRAMEBUFFER_WIDTH]), line, sizeof(line));
     return pins;
 }
 
@@ -649,9 +778,10 @@ uint64_t mc6847_tick(mc6847_t* vdg, uint64_t pins) {
             // rewind line counter, field sync off
             vdg->l_count = 0;
             vdg->fs = false;
+            vdg->frame_count++;
         }
-        if (vdg->l_count < MC6847_VBLANK_LINES) {
-            // inside vblank area, nothing to do
+        if (CHIPS_HEADLESS_SKIP(vdg->headless) || (vdg->l_count < MC6847_VBLANK_LINES)) {
+            // headless, or inside vblank area, nothing to do
         }
         else if (vdg->l_count < MC6847_DISPLAY_START) {
             // top border
@@ -677,6 +807,7 @@ void mc6847_snapshot_onsave(mc6847_t* snapshot) {
     CHIPS_ASSERT(snapshot);
     snapshot->fetch_cb = 0;
     snapshot->user_data = 0;
+    snapshot->vidmem = 0;
     snapshot->fb = 0;
 }
 
@@ -684,7 +815,20 @@ void mc6847_snapshot_onload(mc6847_t* snapshot, mc6847_t* sys) {
     CHIPS_ASSERT(snapshot && sys);
     snapshot->fetch_cb = sys->fetch_cb;
     snapshot->user_data = sys->user_data;
+    snapshot->vidmem = sys->vidmem;
     snapshot->fb = sys->fb;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t mc6847_hash(const mc6847_t* vdg, uint64_t h) {
+    CHIPS_ASSERT(vdg);
+    mc6847_t tmp;
+    memcpy(&tmp, vdg, sizeof(tmp));
+    mc6847_snapshot_onsave(&tmp);
+    tmp.headless = false;
+    memset(&tmp.dirty_lines, 0, sizeof(tmp.dirty_lines));
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 # endif // CHIPS_IMPL
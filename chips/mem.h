@@ -33,11 +33,63 @@
        initialize the mapping from the 16-bit address space to host memory
        locations.
     3. call **mem_rd()** and **mem_wr()** to read and write bytes from and
-       to the 16-bit address space
+       to the 16-bit address space, or **mem_read_range()** and
+       **mem_write_range()** to copy entire memory blocks (those are
+       split at page boundaries into memcpy's, so they are much faster than
+       calling mem_rd()/mem_wr() in a loop)
     4. if needed, call the functions from step (2) to change the memory
        mapping (for instance to switch memory banks in and out of the
        16-bit address space)
 
+    ## Prebuilt Page Rows
+
+    Systems which switch banks very frequently can avoid re-mapping
+    through mem_map_ram() and friends on each bank switch: map each
+    possible bank configuration once into a spare layer, copy the page
+    items out with **mem_get_pages()**, and on a bank switch copy the
+    prebuilt page items back into the actual layer with
+    **mem_map_pages()**. This only updates the CPU-visible page table
+    for the copied pages. Page items with a null read pointer are
+    unmapped.
+
+    Note that prebuilt page items contain host memory pointers, so
+    they must be built again after loading a snapshot.
+
+    ## Dirty Page Tracking
+
+    Optionally, a mem_t instance can record which 1 KByte pages of a
+    host memory region have been written to. This is useful to implement
+    incremental snapshots, rewind or cache invalidation without having
+    to scan or copy all of the emulated RAM.
+
+    Call **mem_track_dirty()** with a pointer to the host memory region
+    which should be tracked (usually the emulated system's RAM array,
+    including banked RAM which currently isn't CPU-visible):
+
+    ~~~C
+    mem_track_dirty(&sys->mem, &sys->ram[0][0], sizeof(sys->ram));
+    ~~~
+
+    The tracked region must be at most MEM_MAX_DIRTY_PAGES KBytes big,
+    and all mappings into the region must start at 1 KByte aligned
+    offsets from the region start.
+
+    After that, every write through **mem_wr()**, **mem_wr16()**,
+    **mem_write_range()** or **mem_layer_wr()** which hits the tracked
+    region will mark the *host memory page* as dirty (so that a write to
+    a bank that's mapped to different CPU addresses will always mark the
+    same dirty bit). Host page indices are counted in 1 KByte units from
+    the start of the tracked region.
+
+    Use **mem_is_dirty()** to check whether a host page has been written
+    to, and **mem_clear_dirty()** to reset all dirty bits. Call
+    mem_track_dirty() with a null pointer to switch tracking off again.
+
+    Dirty tracking only costs a single (well-predicted) branch per
+    memory write when switched off. Note that writes which bypass mem_t
+    (for instance writing directly into a system's RAM array) are not
+    recorded.
+
     ## Layers, Pages and mapping to CPU-visible addresses
 
     ****************************************************************************
@@ -120,18 +172,35 @@ extern "C" {
 #define MEM_NUM_PAGES (MEM_ADDR_RANGE / MEM_PAGE_SIZE)
 #define MEM_NUM_LAYERS (4U)
 
+/* max size of the host memory region for dirty tracking (in KBytes) */
+#define MEM_MAX_DIRTY_PAGES (256U)
+
 /* a memory page item maps a chunk of emulator memory to host memory */
 typedef struct {
     uint8_t* read_ptr;
     uint8_t* write_ptr;
+    /* 1-based host page index for dirty tracking, 0 if not tracked */
+    uint32_t dirty_page;
 } mem_page_t;
 
+/* an external host memory range for snapshot pointer conversion (e.g. a shared ROM image) */
+typedef struct {
+    const uint8_t* ptr;
+    uint32_t size;
+} mem_ext_range_t;
+
 /* a memory instance is a 2-dimensional table of memory pages */
 typedef struct {
     /* the pages that are actually visible to the emulated CPU */
     mem_page_t page_table[MEM_NUM_PAGES];
     /* memory-mapped layers, layer 0 is highest priority */
     mem_page_t layers[MEM_NUM_LAYERS][MEM_NUM_PAGES];
+    /* optional dirty page tracking */
+    struct {
+        uint8_t* base;      // start of tracked host memory region, 0 if not tracking
+        uint32_t num_pages; // size of tracked region in KBytes
+        uint32_t bits[MEM_MAX_DIRTY_PAGES / 32];
+    } dirty;
 } mem_t;
 
 /* initialize a new mem instance */
@@ -142,14 +211,24 @@ void mem_map_ram(mem_t* mem, size_t layer, uint16_t addr, uint32_t size, uint8_t
 void mem_map_rom(mem_t* mem, size_t layer, uint16_t addr, uint32_t size, const uint8_t* ptr);
 /* map a range of memory to different read/write pointers (e.g. for RAM behind ROM) */
 void mem_map_rw(mem_t* mem, size_t layer, uint16_t addr, uint32_t size, const uint8_t* read_ptr, uint8_t* write_ptr);
+/* get a range of page items from a layer (e.g. to prebuild page rows for mem_map_pages()) */
+void mem_get_pages(const mem_t* mem, size_t layer, uint16_t addr, mem_page_t* pages, size_t num_pages);
+/* copy a range of prebuilt page items into a layer, also updates the CPU-visible page-table */
+void mem_map_pages(mem_t* mem, size_t layer, uint16_t addr, const mem_page_t* pages, size_t num_pages);
 /* unmap all memory pages in a layer, also updates the CPU-visible page-table */
 void mem_unmap_layer(mem_t* mem, size_t layer);
 /* unmap all memory pages in all layers, also updates the CPU-visible page-table */
 void mem_unmap_all(mem_t* mem);
 /* get the host-memory read-ptr of an emulator memory address */
 uint8_t* mem_readptr(mem_t* mem, uint16_t addr);
-/* copy a range of bytes into memory via mem_wr() */
+/* copy a range of bytes into memory (same behaviour as mem_wr(), but page-by-page) */
 void mem_write_range(mem_t* mem, uint16_t addr, const uint8_t* src, uint32_t num_bytes);
+/* copy a range of bytes out of memory (same behaviour as mem_rd(), but page-by-page) */
+void mem_read_range(mem_t* mem, uint16_t addr, uint8_t* dst, uint32_t num_bytes);
+/* start dirty-tracking writes into a host memory region (pass a null ptr to stop tracking) */
+void mem_track_dirty(mem_t* mem, uint8_t* base, size_t size);
+/* clear all dirty bits */
+void mem_clear_dirty(mem_t* mem);
 
 /* read a byte at 16-bit address */
 static inline uint8_t mem_rd(mem_t* mem, uint16_t addr) {
@@ -157,7 +236,12 @@ static inline uint8_t mem_rd(mem_t* mem, uint16_t addr) {
 }
 /* write a byte to 16-bit address */
 static inline void mem_wr(mem_t* mem, uint16_t addr, uint8_t data) {
-    mem->page_table[addr>>MEM_PAGE_SHIFT].write_ptr[addr & MEM_PAGE_MASK] = data;
+    const mem_page_t* page = &mem->page_table[addr>>MEM_PAGE_SHIFT];
+    page->write_ptr[addr & MEM_PAGE_MASK] = data;
+    if (page->dirty_page) {
+        const uint32_t i = page->dirty_page - 1;
+        mem->dirty.bits[i>>5] |= 1U<<(i&31);
+    }
 }
 /* helper method to write a 16-bit value, does 2 mem_wr() */
 static inline void mem_wr16(mem_t* mem, uint16_t addr, uint16_t data) {
@@ -171,6 +255,16 @@ static inline uint16_t mem_rd16(mem_t* mem, uint16_t addr) {
     return (h<<8)|l;
 }
 
+/* test if a host memory page (1 KByte units from start of tracked region) has been written to */
+static inline bool mem_is_dirty(const mem_t* mem, uint32_t host_page) {
+    if (host_page < mem->dirty.num_pages) {
+        return 0 != (mem->dirty.bits[host_page>>5] & (1U<<(host_page&31)));
+    }
+    else {
+        return false;
+    }
+}
+
 /* read a byte from a specific layer (slow!) */
 uint8_t mem_layer_rd(mem_t* mem, size_t layer, uint16_t addr);
 /* write a byte to a specific layer (slow!) */
@@ -180,6 +274,10 @@ void mem_layer_wr(mem_t* mem, size_t layer, uint16_t addr, uint8_t data);
 void mem_snapshot_onsave(mem_t* snapshot, void* base);
 /* ...and the reverse */
 void mem_snapshot_onload(mem_t* snapshot, void* base);
+/* same as mem_snapshot_onsave(), but pointers into external memory ranges are converted to range-relative offsets */
+void mem_snapshot_onsave_ext(mem_t* snapshot, void* base, const mem_ext_range_t* ext, int num_ext);
+/* ...and the reverse, with the ext ranges of the system the snapshot is loaded into */
+void mem_snapshot_onload_ext(mem_t* snapshot, void* base, const mem_ext_range_t* ext, int num_ext);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -247,14 +345,29 @@ static void _mem_update_page_table(mem_t* m, size_t page_index) {
 
         m->page_table[page_index].read_ptr = m->layers[layer_index][page_index].read_ptr;
         m->page_table[page_index].write_ptr = m->layers[layer_index][page_index].write_ptr;
+        m->page_table[page_index].dirty_page = m->layers[layer_index][page_index].dirty_page;
     }
     else {
         /* no mapping exists for this page, set to special 'unmapped page' */
         m->page_table[page_index].read_ptr = _mem_unmapped_page;
         m->page_table[page_index].write_ptr = _mem_junk_page;
+        m->page_table[page_index].dirty_page = 0;
     }
 }
 
+/* compute the 1-based dirty-tracking page index of a host memory write pointer */
+static uint32_t _mem_dirty_page(mem_t* m, const uint8_t* write_ptr) {
+    if (m->dirty.base && write_ptr) {
+        if ((write_ptr >= m->dirty.base) && (write_ptr < (m->dirty.base + (m->dirty.num_pages * MEM_PAGE_SIZE)))) {
+            const size_t offset = (size_t)(write_ptr - m->dirty.base);
+            // tracked memory must be mapped at page-aligned offsets
+            CHIPS_ASSERT((offset & MEM_PAGE_MASK) == 0);
+            return (uint32_t)(offset >> MEM_PAGE_SHIFT) + 1;
+        }
+    }
+    return 0;
+}
+
 static void _mem_map(mem_t* m, size_t layer, uint16_t addr, uint32_t size, const uint8_t* read_ptr, uint8_t* write_ptr) {
     CHIPS_ASSERT(m);
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
@@ -276,6 +389,7 @@ static void _mem_map(mem_t* m, size_t layer, uint16_t addr, uint32_t size, const
         else {
             page->write_ptr = _mem_junk_page;
         }
+        page->dirty_page = _mem_dirty_page(m, page->write_ptr);
         _mem_update_page_table(m, page_index);
     }
 }
@@ -295,6 +409,36 @@ void mem_map_rw(mem_t* m, size_t layer, uint16_t addr, uint32_t size, const uint
     _mem_map(m, layer, addr, size, read_ptr, write_ptr);
 }
 
+void mem_get_pages(const mem_t* m, size_t layer, uint16_t addr, mem_page_t* pages, size_t num_pages) {
+    CHIPS_ASSERT(m && pages);
+    CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
+    CHIPS_ASSERT((addr & MEM_PAGE_MASK) == 0);
+    CHIPS_ASSERT(num_pages <= MEM_NUM_PAGES);
+    for (size_t i = 0; i < num_pages; i++) {
+        // the page_index will wrap-around
+        const size_t page_index = ((addr >> MEM_PAGE_SHIFT) + i) & (MEM_NUM_PAGES - 1);
+        pages[i].read_ptr = m->layers[layer][page_index].read_ptr;
+        pages[i].write_ptr = m->layers[layer][page_index].write_ptr;
+        pages[i].dirty_page = m->layers[layer][page_index].dirty_page;
+    }
+}
+
+void mem_map_pages(mem_t* m, size_t layer, uint16_t addr, const mem_page_t* pages, size_t num_pages) {
+    CHIPS_ASSERT(m && pages);
+    CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
+    CHIPS_ASSERT((addr & MEM_PAGE_MASK) == 0);
+    CHIPS_ASSERT(num_pages <= MEM_NUM_PAGES);
+    for (size_t i = 0; i < num_pages; i++) {
+        const size_t page_index = ((addr >> MEM_PAGE_SHIFT) + i) & (MEM_NUM_PAGES - 1);
+        mem_page_t* page = &m->layers[layer][page_index];
+        page->read_ptr = pages[i].read_ptr;
+        page->write_ptr = pages[i].write_ptr;
+        // dirty tracking may have changed since the page items were built
+        page->dirty_page = _mem_dirty_page(m, page->write_ptr);
+        _mem_update_page_table(m, page_index);
+    }
+}
+
 void mem_unmap_layer(mem_t* m, size_t layer) {
     CHIPS_ASSERT(m);
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
@@ -302,6 +446,7 @@ void mem_unmap_layer(mem_t* m, size_t layer) {
         mem_page_t* page = &m->layers[layer][page_index];
         page->read_ptr = 0;
         page->write_ptr = 0;
+        page->dirty_page = 0;
         _mem_update_page_table(m, page_index);
     }
 }
@@ -312,6 +457,7 @@ void mem_unmap_all(mem_t* m) {
             mem_page_t* page = &m->layers[layer_index][page_index];
             page->read_ptr = 0;
             page->write_ptr = 0;
+            page->dirty_page = 0;
         }
     }
     for (size_t page_index = 0; page_index < MEM_NUM_PAGES; page_index++) {
@@ -325,11 +471,71 @@ uint8_t* mem_readptr(mem_t* m, uint16_t addr) {
 }
 
 void mem_write_range(mem_t* m, uint16_t addr, const uint8_t* src, uint32_t num_bytes) {
-    for (size_t i = 0; i < num_bytes; i++) {
-        mem_wr(m, addr++, src[i]);
+    CHIPS_ASSERT(m && (src || (num_bytes == 0)));
+    while (num_bytes > 0) {
+        // copy up to the end of the current page, the address wraps around at 64 KByte
+        const uint32_t offset = addr & MEM_PAGE_MASK;
+        uint32_t num = MEM_PAGE_SIZE - offset;
+        if (num > num_bytes) {
+            num = num_bytes;
+        }
+        const mem_page_t* page = &m->page_table[addr>>MEM_PAGE_SHIFT];
+        memcpy(page->write_ptr + offset, src, num);
+        if (page->dirty_page) {
+            const uint32_t i = page->dirty_page - 1;
+            m->dirty.bits[i>>5] |= 1U<<(i&31);
+        }
+        addr += num;
+        src += num;
+        num_bytes -= num;
+    }
+}
+
+void mem_read_range(mem_t* m, uint16_t addr, uint8_t* dst, uint32_t num_bytes) {
+    CHIPS_ASSERT(m && (dst || (num_bytes == 0)));
+    while (num_bytes > 0) {
+        const uint32_t offset = addr & MEM_PAGE_MASK;
+        uint32_t num = MEM_PAGE_SIZE - offset;
+        if (num > num_bytes) {
+            num = num_bytes;
+        }
+        memcpy(dst, m->page_table[addr>>MEM_PAGE_SHIFT].read_ptr + offset, num);
+        addr += num;
+        dst += num;
+        num_bytes -= num;
     }
 }
 
+void mem_track_dirty(mem_t* m, uint8_t* base, size_t size) {
+    CHIPS_ASSERT(m);
+    if (base) {
+        CHIPS_ASSERT((size > 0) && ((size & MEM_PAGE_MASK) == 0));
+        CHIPS_ASSERT((size >> MEM_PAGE_SHIFT) <= MEM_MAX_DIRTY_PAGES);
+        m->dirty.base = base;
+        m->dirty.num_pages = (uint32_t)(size >> MEM_PAGE_SHIFT);
+    }
+    else {
+        m->dirty.base = 0;
+        m->dirty.num_pages = 0;
+    }
+    mem_clear_dirty(m);
+    // update existing mappings
+    for (size_t layer_index = 0; layer_index < MEM_NUM_LAYERS; layer_index++) {
+        for (size_t page_index = 0; page_index < MEM_NUM_PAGES; page_index++) {
+            mem_page_t* page = &m->layers[layer_index][page_index];
+            page->dirty_page = _mem_dirty_page(m, page->write_ptr);
+        }
+    }
+    for (size_t page_index = 0; page_index < MEM_NUM_PAGES; page_index++) {
+        _mem_update_page_table(m, page_index);
+    }
+}
+
+void mem_clear_dirty(mem_t* m) {
+    CHIPS_ASSERT(m);
+    memset(m->dirty.bits, 0, sizeof(m->dirty.bits));
+}
+
 uint8_t mem_layer_rd(mem_t* mem, size_t layer, uint16_t addr) {
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
     if (mem->layers[layer][addr>>MEM_PAGE_SHIFT].read_ptr) {
@@ -342,34 +548,60 @@ uint8_t mem_layer_rd(mem_t* mem, size_t layer, uint16_t addr) {
 
 void mem_layer_wr(mem_t* mem, size_t layer, uint16_t addr, uint8_t data) {
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
-    if (mem->layers[layer][addr>>MEM_PAGE_SHIFT].write_ptr) {
-        mem->layers[layer][addr>>MEM_PAGE_SHIFT].write_ptr[addr&MEM_PAGE_MASK] = data;
+    const mem_page_t* page = &mem->layers[layer][addr>>MEM_PAGE_SHIFT];
+    if (page->write_ptr) {
+        page->write_ptr[addr&MEM_PAGE_MASK] = data;
+        if (page->dirty_page) {
+            const uint32_t i = page->dirty_page - 1;
+            mem->dirty.bits[i>>5] |= 1U<<(i&31);
+        }
     }
 }
 
 #define MEM_SPECIAL_OFFSET_NULLPTR (-1)
 #define MEM_SPECIAL_OFFSET_UNMAPPED_PAGE (-2)
 #define MEM_SPECIAL_OFFSET_JUNK_PAGE (-3)
+// pointers into external ranges are encoded as MEM_SPECIAL_OFFSET_EXT - ((range_index<<20)|offset)
+#define MEM_SPECIAL_OFFSET_EXT (-0x10000000)
+#define MEM_EXT_OFFSET_SHIFT (20)
+#define MEM_EXT_OFFSET_MASK ((1<<MEM_EXT_OFFSET_SHIFT)-1)
 
-static void mem_ptr_to_offset(uint8_t** ptr_ptr, uint8_t* base) {
+static void mem_ptr_to_offset(uint8_t** ptr_ptr, uint8_t* base, const mem_ext_range_t* ext, int num_ext) {
     uint8_t* ptr = *ptr_ptr;
     if (ptr == 0) {
         *ptr_ptr = (uint8_t*)(intptr_t)MEM_SPECIAL_OFFSET_NULLPTR;
+        return;
     }
     else if (ptr == _mem_unmapped_page) {
         *ptr_ptr = (uint8_t*)(intptr_t)MEM_SPECIAL_OFFSET_UNMAPPED_PAGE;
+        return;
     }
     else if (ptr == _mem_junk_page) {
         *ptr_ptr = (uint8_t*)(intptr_t)MEM_SPECIAL_OFFSET_JUNK_PAGE;
+        return;
     }
-    else {
-        CHIPS_ASSERT(base <= *ptr_ptr);
-        *ptr_ptr = (uint8_t*) (*ptr_ptr - base);
+    for (int i = 0; i < num_ext; i++) {
+        if (ext[i].ptr && (ptr >= ext[i].ptr) && (ptr < (ext[i].ptr + ext[i].size))) {
+            CHIPS_ASSERT(ext[i].size <= MEM_EXT_OFFSET_MASK);
+            const intptr_t offset = (intptr_t)((i<<MEM_EXT_OFFSET_SHIFT) | (ptr - ext[i].ptr));
+            *ptr_ptr = (uint8_t*)(MEM_SPECIAL_OFFSET_EXT - offset);
+            return;
+        }
     }
+    CHIPS_ASSERT(base <= *ptr_ptr);
+    *ptr_ptr = (uint8_t*) (*ptr_ptr - base);
 }
 
-static void mem_offset_to_ptr(uint8_t** ptr_ptr, uint8_t* base) {
+static void mem_offset_to_ptr(uint8_t** ptr_ptr, uint8_t* base, const mem_ext_range_t* ext, int num_ext) {
     intptr_t offset = (intptr_t)*ptr_ptr;
+    if (offset <= MEM_SPECIAL_OFFSET_EXT) {
+        const intptr_t ext_offset = MEM_SPECIAL_OFFSET_EXT - offset;
+        const int i = (int)(ext_offset >> MEM_EXT_OFFSET_SHIFT);
+        CHIPS_ASSERT((i < num_ext) && ext[i].ptr);
+        (void)num_ext;
+        *ptr_ptr = (uint8_t*)(ext[i].ptr + (ext_offset & MEM_EXT_OFFSET_MASK));
+        return;
+    }
     switch (offset) {
         case MEM_SPECIAL_OFFSET_NULLPTR:
             *ptr_ptr = 0;
@@ -386,32 +618,42 @@ static void mem_offset_to_ptr(uint8_t** ptr_ptr, uint8_t* base) {
     }
 }
 
-void mem_snapshot_onsave(mem_t* snapshot, void* base) {
+void mem_snapshot_onsave_ext(mem_t* snapshot, void* base, const mem_ext_range_t* ext, int num_ext) {
     uint8_t* base8 = (uint8_t*)base;
     for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
-        mem_ptr_to_offset(&snapshot->page_table[page].read_ptr, base8);
-        mem_ptr_to_offset(&snapshot->page_table[page].write_ptr, base8);
+        mem_ptr_to_offset(&snapshot->page_table[page].read_ptr, base8, ext, num_ext);
+        mem_ptr_to_offset(&snapshot->page_table[page].write_ptr, base8, ext, num_ext);
     }
     for (size_t layer = 0; layer < MEM_NUM_LAYERS; layer++) {
         for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
-            mem_ptr_to_offset(&snapshot->layers[layer][page].read_ptr, base8);
-            mem_ptr_to_offset(&snapshot->layers[layer][page].write_ptr, base8);
+            mem_ptr_to_offset(&snapshot->layers[layer][page].read_ptr, base8, ext, num_ext);
+            mem_ptr_to_offset(&snapshot->layers[layer][page].write_ptr, base8, ext, num_ext);
         }
     }
+    mem_ptr_to_offset(&snapshot->dirty.base, base8, 0, 0);
 }
 
-void mem_snapshot_onload(mem_t* snapshot, void* base) {
+void mem_snapshot_onload_ext(mem_t* snapshot, void* base, const mem_ext_range_t* ext, int num_ext) {
     uint8_t* base8 = (uint8_t*)base;
     for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
-        mem_offset_to_ptr(&snapshot->page_table[page].read_ptr, base8);
-        mem_offset_to_ptr(&snapshot->page_table[page].write_ptr, base8);
+        mem_offset_to_ptr(&snapshot->page_table[page].read_ptr, base8, ext, num_ext);
+        mem_offset_to_ptr(&snapshot->page_table[page].write_ptr, base8, ext, num_ext);
     }
     for (size_t layer = 0; layer < MEM_NUM_LAYERS; layer++) {
         for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
-            mem_offset_to_ptr(&snapshot->layers[layer][page].read_ptr, base8);
-            mem_offset_to_ptr(&snapshot->layers[layer][page].write_ptr, base8);
+            mem_offset_to_ptr(&snapshot->layers[layer][page].read_ptr, base8, ext, num_ext);
+            mem_offset_to_ptr(&snapshot->layers[layer][page].write_ptr, base8, ext, num_ext);
         }
     }
+    mem_offset_to_ptr(&snapshot->dirty.base, base8, 0, 0);
+}
+
+void mem_snapshot_onsave(mem_t* snapshot, void* base) {
+    mem_snapshot_onsave_ext(snapshot, base, 0, 0);
+}
+
+void mem_snapshot_onload(mem_t* snapshot, void* base) {
+    mem_snapshot_onload_ext(snapshot, base, 0, 0);
 }
 
 #endif /* CHIPS_IMPL */
@@ -173,6 +173,7 @@ extern "C" {
 
 /* misc constants */
 #define UPD765_FIFO_SIZE (16)
+#define UPD765_BUFFER_SIZE (512)
 
 /* sector info block for the info callback */
 typedef struct {
@@ -209,6 +210,8 @@ typedef int (*upd765_seektrack_cb)(int drive, int track, void* user_data);
 typedef int (*upd765_seeksector_cb)(int drive, int side, upd765_sectorinfo_t* inout_info, void* user_data);
 /* callback to read the next sector data byte */
 typedef int (*upd765_read_cb)(int drive, int side, void* user_data, uint8_t* out_data);
+/* optional callback to read up to max_bytes of the current sector at once (see upd765_desc_t) */
+typedef int (*upd765_readbytes_cb)(int drive, int side, void* user_data, uint8_t* dst, int max_bytes, int* out_num_bytes);
 /* callback to read info about first sector on current reack */
 typedef int (*upd765_trackinfo_cb)(int drive, int side, void* user_data, upd765_sectorinfo_t* out_info);
 /* callback to get info about disk drive (called on SENSE_DRIVE_STATUS command) */
@@ -219,6 +222,7 @@ typedef struct {
     upd765_seektrack_cb seektrack_cb;
     upd765_seeksector_cb seeksector_cb;
     upd765_read_cb read_cb;
+    upd765_readbytes_cb readbytes_cb;   /* optional, if provided, sector data is read in chunks of up to UPD765_BUFFER_SIZE bytes */
     upd765_trackinfo_cb trackinfo_cb;
     upd765_driveinfo_cb driveinfo_cb;
     void* user_data;
@@ -238,10 +242,17 @@ typedef struct {
     upd765_driveinfo_t drive_info;      /* only valid after SENSE_DRIVE_CMD */
     uint8_t st[4];
 
+    /* sector data buffer for readbytes_cb */
+    int buf_pos;                /* next byte in buffer */
+    int buf_num;                /* number of valid bytes in buffer */
+    int buf_res;                /* readbytes_cb result for the buffered bytes */
+    uint8_t buf[UPD765_BUFFER_SIZE];
+
     /* callback functions */
     upd765_seektrack_cb seektrack_cb;
     upd765_seeksector_cb seeksector_cb;
     upd765_read_cb read_cb;
+    upd765_readbytes_cb readbytes_cb;
     upd765_trackinfo_cb trackinfo_cb;
     upd765_driveinfo_cb driveinfo_cb;
     void* user_data;
@@ -261,6 +272,10 @@ uint64_t upd765_iorq(upd765_t* upd, uint64_t pins);
 void upd765_snapshot_onsave(upd765_t* snapshot);
 // fixup upd765_t snapshot after loading
 void upd765_snapshot_onload(upd765_t* snapshot, upd765_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the upd765_t state (excluding host pointers)
+uint64_t upd765_hash(const upd765_t* upd, uint64_t h);
+#endif
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -411,6 +426,9 @@ static void _upd765_cmd(upd765_t* upd) {
                 const int side = (upd->st[0] & 4) >> 2;
                 const int res = upd->seeksector_cb(fdd_index, side, &upd->sector_info, upd->user_data);
                 if (UPD765_RESULT_SUCCESS == res) {
+                    upd->buf_pos = 0;
+                    upd->buf_num = 0;
+                    upd->buf_res = UPD765_RESULT_SUCCESS;
                     _upd765_to_phase_exec(upd);
                 }
                 else {
@@ -556,7 +574,27 @@ static uint8_t _upd765_exec_rd(upd765_t* upd) {
                 /* read next sector data byte from FDD */
                 const int fdd_index = upd->st[0] & 3;
                 const int side = (upd->st[0] & 4) >> 2;
-                const int res = upd->read_cb(fdd_index, side, upd->user_data, &data);
+                int res;
+                if (upd->readbytes_cb) {
+                    /* serve the data byte from the buffer, refill when empty */
+                    if ((upd->buf_pos == upd->buf_num) && (upd->buf_res == UPD765_RESULT_SUCCESS)) {
+                        upd->buf_pos = 0;
+                        upd->buf_res = upd->readbytes_cb(fdd_index, side, upd->user_data, upd->buf, UPD765_BUFFER_SIZE, &upd->buf_num);
+                        if ((upd->buf_num == 0) && (upd->buf_res == UPD765_RESULT_SUCCESS)) {
+                            upd->buf_res = UPD765_RESULT_NOT_FOUND;
+                        }
+                    }
+                    if (upd->buf_pos < upd->buf_num) {
+                        data = upd->buf[upd->buf_pos++];
+                        res = (upd->buf_pos < upd->buf_num) ? UPD765_RESULT_SUCCESS : upd->buf_res;
+                    }
+                    else {
+                        res = upd->buf_res;
+                    }
+                }
+                else {
+                    res = upd->read_cb(fdd_index, side, upd->user_data, &data);
+                }
                 if (res != UPD765_RESULT_SUCCESS) {
                     if (res & UPD765_RESULT_NOT_READY) {
                         upd->st[0] |= UPD765_ST0_NR;
@@ -658,6 +696,7 @@ void upd765_init(upd765_t* upd, const upd765_desc_t* desc) {
     upd->seektrack_cb = desc->seektrack_cb;
     upd->seeksector_cb = desc->seeksector_cb;
     upd->read_cb = desc->read_cb;
+    upd->readbytes_cb = desc->readbytes_cb;
     upd->trackinfo_cb = desc->trackinfo_cb;
     upd->driveinfo_cb = desc->driveinfo_cb;
     upd->user_data = desc->user_data;
@@ -697,6 +736,7 @@ void upd765_snapshot_onsave(upd765_t* snapshot) {
     snapshot->seektrack_cb = 0;
     snapshot->seeksector_cb = 0;
     snapshot->read_cb = 0;
+    snapshot->readbytes_cb = 0;
     snapshot->trackinfo_cb = 0;
     snapshot->driveinfo_cb = 0;
     snapshot->user_data = 0;
@@ -707,8 +747,19 @@ void upd765_snapshot_onload(upd765_t* snapshot, upd765_t* sys) {
     snapshot->seektrack_cb = sys->seektrack_cb;
     snapshot->seeksector_cb = sys->seeksector_cb;
     snapshot->read_cb = sys->read_cb;
+    snapshot->readbytes_cb = sys->readbytes_cb;
     snapshot->trackinfo_cb = sys->trackinfo_cb;
     snapshot->driveinfo_cb = sys->driveinfo_cb;
     snapshot->user_data = sys->user_data;
 }
+
+#if defined(CHIPS_HASH_SEED)
+uint64_t upd765_hash(const upd765_t* upd, uint64_t h) {
+    CHIPS_ASSERT(upd);
+    upd765_t tmp;
+    memcpy(&tmp, upd, sizeof(tmp));
+    upd765_snapshot_onsave(&tmp);
+    return CHIPS_HASH(h, tmp);
+}
+#endif
 #endif /* CHIPS_IMPL */
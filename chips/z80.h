@@ -16,6 +16,49 @@
     #define CHIPS_ASSERT(x) your_own_asset_macro(x)
     ~~~
 
+    Optionally define the following before including the implementation to
+    look up the sign, zero and undocumented flags of the 8-bit arithmetic
+    instructions, and the complete flags of INC/DEC in small precomputed
+    tables (768 bytes) instead of computing them:
+    ~~~C
+    #define Z80_USE_FLAG_TABLES
+    ~~~
+
+    Optionally define one or more of the following before including the
+    implementation to compile a leaner but less accurate decoder, for
+    systems and workloads which don't depend on the respective feature:
+
+    ~~~C
+    #define Z80_NO_WAIT
+    ~~~
+        The WAIT pin is ignored, memory and IO machine cycles are never
+        stretched by wait states.
+
+    ~~~C
+    #define Z80_NO_UNDOC_FLAGS
+    ~~~
+        The undocumented flag bits XF and YF are not computed by most
+        instructions, their value is undefined.
+
+    ~~~C
+    #define Z80_NO_MEMPTR
+    ~~~
+        The internal MEMPTR register (WZ) is only updated where the decoder
+        needs it as temporary register (for instance for the target address
+        of jumps and the address of 16-bit loads), the pure MEMPTR side
+        effects are skipped. The only visible effect is on the undocumented
+        XF and YF flags of BIT n,(HL).
+
+    ~~~C
+    #define Z80_NO_RETI
+    ~~~
+        The virtual RETI pin isn't set when a RETI instruction is decoded,
+        only use this if no interrupt daisy chain is connected.
+
+    All those are defined per compilation unit (the Z80 implementation
+    is shared by all systems in the same compilation unit). The default
+    decoder models everything.
+
     ## Emulated Pins
     ***********************************
     *           +-----------+         *
@@ -63,6 +106,21 @@
         Helper function to detect whether the z80_t instance has completed
         an instruction.
 
+    ~~~C
+    uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks)
+    ~~~
+        Fast-forward a CPU which sits in the HALT state, instead of
+        ticking it through the 4-cycle HALT opcode refetch loop. This only
+        has an effect when z80_opdone() is true, the Z80_HALT pin is set and
+        no NMI is pending, otherwise the function returns 0. The number of
+        skipped ticks is num_ticks rounded down to a multiple of 4, and
+        the only CPU state which changes is the R register. The caller is
+        responsible for making sure that no interrupt is requested during the
+        skipped ticks, and that the system doesn't insert wait states
+        into the refetch cycles. Returns the number of skipped ticks, all
+        other pins remain unchanged (the memory reads of the skipped HALT
+        refetch cycles don't have side effects on most systems).
+
     ## HOWTO
 
     Initialize a new z80_t instance and start ticking it:
@@ -375,6 +433,12 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins);
 uint64_t z80_prefetch(z80_t* cpu, uint16_t new_pc);
 // return true when full instruction has finished
 bool z80_opdone(z80_t* cpu);
+// fast-forward a halted CPU, returns number of skipped ticks (multiple of 4)
+uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks);
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+// save or load the CPU state in a streaming snapshot (only if chips_common.h is included before z80.h)
+void z80_stream(z80_t* cpu, chips_stream_t* stream);
+#endif
 
 #ifdef __cplusplus
 } // extern C
@@ -396,6 +460,25 @@ bool z80_opdone(z80_t* cpu);
 #define _Z80_UNREACHABLE
 #endif
 
+// optional reduced-accuracy features
+#if defined(Z80_NO_UNDOC_FLAGS)
+#define _Z80_XF (0)
+#define _Z80_YF (0)
+#else
+#define _Z80_XF Z80_XF
+#define _Z80_YF Z80_YF
+#endif
+#if defined(Z80_NO_MEMPTR)
+#define _Z80_MEMPTR(x)
+#else
+#define _Z80_MEMPTR(x) x
+#endif
+#if defined(Z80_NO_RETI)
+#define _Z80_RETI (0)
+#else
+#define _Z80_RETI Z80_RETI
+#endif
+
 // values for hlx_idx for mapping HL, IX or IY, used as index into hlx[]
 #define _Z80_MAP_HL (0)
 #define _Z80_MAP_IX (1)
@@ -426,6 +509,52 @@ bool z80_opdone(z80_t* cpu) {
     return ((cpu->pins & (Z80_M1|Z80_RD)) == (Z80_M1|Z80_RD)) && !cpu->prefix_active;
 }
 
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+// NOTE: the decoder step is specific to the generated decoder, a change in
+// the generated step numbering must bump the section version
+void z80_stream(z80_t* cpu, chips_stream_t* s) {
+    CHIPS_ASSERT(cpu && s);
+    chips_stream_begin(s, CHIPS_STREAM_TAG('Z','8','0',' '), 1);
+    chips_stream_u16(s, &cpu->step);
+    chips_stream_u16(s, &cpu->addr);
+    chips_stream_u8(s, &cpu->dlatch);
+    chips_stream_u8(s, &cpu->opcode);
+    chips_stream_u8(s, &cpu->hlx_idx);
+    chips_stream_bool(s, &cpu->prefix_active);
+    chips_stream_u64(s, &cpu->pins);
+    chips_stream_u64(s, &cpu->int_bits);
+    chips_stream_u16(s, &cpu->pc);
+    chips_stream_u16(s, &cpu->af);
+    chips_stream_u16(s, &cpu->bc);
+    chips_stream_u16(s, &cpu->de);
+    chips_stream_u16(s, &cpu->hl);
+    chips_stream_u16(s, &cpu->ix);
+    chips_stream_u16(s, &cpu->iy);
+    chips_stream_u16(s, &cpu->wz);
+    chips_stream_u16(s, &cpu->sp);
+    chips_stream_u16(s, &cpu->ir);
+    chips_stream_u16(s, &cpu->af2);
+    chips_stream_u16(s, &cpu->bc2);
+    chips_stream_u16(s, &cpu->de2);
+    chips_stream_u16(s, &cpu->hl2);
+    chips_stream_u8(s, &cpu->im);
+    chips_stream_bool(s, &cpu->iff1);
+    chips_stream_bool(s, &cpu->iff2);
+    chips_stream_end(s);
+}
+#endif
+
+uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks) {
+    if (!(cpu->pins & Z80_HALT) || !z80_opdone(cpu) || (cpu->int_bits & Z80_NMI)) {
+        return 0;
+    }
+    // each HALT opcode refetch takes 4 clock cycles and has one refresh cycle
+    const uint32_t num_fetches = num_ticks >> 2;
+    cpu->r = (cpu->r & 0x80) | ((cpu->r + num_fetches) & 0x7F);
+    cpu->int_bits = 0;
+    return num_fetches << 2;
+}
+
 static inline uint64_t _z80_halt(z80_t* cpu, uint64_t pins) {
     cpu->pc--;
     return pins | Z80_HALT;
@@ -451,13 +580,82 @@ static const uint8_t _z80_szp_flags[256] = {
   0xa4,0xa0,0xa0,0xa4,0xa0,0xa4,0xa4,0xa0,0xa8,0xac,0xac,0xa8,0xac,0xa8,0xa8,0xac,
 };
 
+#if defined(Z80_USE_FLAG_TABLES)
+// sign+zero+undocumented flags lookup table
+static const uint8_t _z80_szyx_flags[256] = {
+  0x40,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+};
+
+// INC r flags (without carry), indexed by result
+static const uint8_t _z80_inc8_flags[256] = {
+  0x50,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x30,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x30,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,
+  0x30,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x30,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x28,0x28,0x28,0x28,0x28,0x28,0x28,0x28,
+  0x94,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0x90,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0xb0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0xb0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0x90,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0x90,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x88,0x88,0x88,0x88,0x88,0x88,0x88,0x88,
+  0xb0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+  0xb0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa0,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,0xa8,
+};
+
+// DEC r flags (without carry), indexed by result
+static const uint8_t _z80_dec8_flags[256] = {
+  0x42,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x1a,
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x1a,
+  0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x3a,
+  0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x3a,
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x1a,
+  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x1a,
+  0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x3a,
+  0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x22,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x2a,0x3e,
+  0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x9a,
+  0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x9a,
+  0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xba,
+  0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xba,
+  0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x9a,
+  0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x82,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x8a,0x9a,
+  0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xba,
+  0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xa2,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xba,
+};
+#endif
+
 static inline uint8_t _z80_sz_flags(uint8_t val) {
     return (val != 0) ? (val & Z80_SF) : Z80_ZF;
 }
 
+static inline uint8_t _z80_szyx(uint8_t val) {
+    #if defined(Z80_USE_FLAG_TABLES)
+    return _z80_szyx_flags[val];
+    #else
+    return _z80_sz_flags(val) | (val & (_Z80_YF|_Z80_XF));
+    #endif
+}
+
 static inline uint8_t _z80_szyxch_flags(uint8_t acc, uint8_t val, uint32_t res) {
-    return _z80_sz_flags(res) |
-        (res & (Z80_YF|Z80_XF)) |
+    return _z80_szyx((uint8_t)res) |
         ((res >> 8) & Z80_CF) |
         ((acc ^ val ^ res) & Z80_HF);
 }
@@ -473,14 +671,14 @@ static inline uint8_t _z80_sub_flags(uint8_t acc, uint8_t val, uint32_t res) {
 static inline uint8_t _z80_cp_flags(uint8_t acc, uint8_t val, uint32_t res) {
     return Z80_NF |
         _z80_sz_flags(res) |
-        (val & (Z80_YF|Z80_XF)) |
+        (val & (_Z80_YF|_Z80_XF)) |
         ((res >> 8) & Z80_CF) |
         ((acc ^ val ^ res) & Z80_HF) |
         ((((val ^ acc) & (res ^ acc)) >> 5) & Z80_VF);
 }
 
 static inline uint8_t _z80_sziff2_flags(z80_t* cpu, uint8_t val) {
-    return (cpu->f & Z80_CF) | _z80_sz_flags(val) | (val & (Z80_YF|Z80_XF)) | (cpu->iff2 ? Z80_PF : 0);
+    return (cpu->f & Z80_CF) | _z80_szyx(val) | (cpu->iff2 ? Z80_PF : 0);
 }
 
 static inline void _z80_add8(z80_t* cpu, uint8_t val) {
@@ -535,21 +733,29 @@ static inline void _z80_neg8(z80_t* cpu) {
 
 static inline uint8_t _z80_inc8(z80_t* cpu, uint8_t val) {
     uint8_t res = val + 1;
-    uint8_t f = _z80_sz_flags(res) | (res & (Z80_XF|Z80_YF)) | ((res ^ val) & Z80_HF);
+    #if defined(Z80_USE_FLAG_TABLES)
+    cpu->f = _z80_inc8_flags[res] | (cpu->f & Z80_CF);
+    #else
+    uint8_t f = _z80_szyx(res) | ((res ^ val) & Z80_HF);
     if (res == 0x80) {
         f |= Z80_VF;
     }
     cpu->f = f | (cpu->f & Z80_CF);
+    #endif
     return res;
 }
 
 static inline uint8_t _z80_dec8(z80_t* cpu, uint8_t val) {
     uint8_t res = val - 1;
-    uint8_t f = Z80_NF | _z80_sz_flags(res) | (res & (Z80_XF|Z80_YF)) | ((res ^ val) & Z80_HF);
+    #if defined(Z80_USE_FLAG_TABLES)
+    cpu->f = _z80_dec8_flags[res] | (cpu->f & Z80_CF);
+    #else
+    uint8_t f = Z80_NF | _z80_szyx(res) | ((res ^ val) & Z80_HF);
     if (res == 0x7F) {
         f |= Z80_VF;
     }
     cpu->f = f | (cpu->f & Z80_CF);
+    #endif
     return res;
 }
 
@@ -574,25 +780,25 @@ static inline void _z80_exx(z80_t* cpu) {
 
 static inline void _z80_rlca(z80_t* cpu) {
     uint8_t res = (cpu->a << 1) | (cpu->a >> 7);
-    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rrca(z80_t* cpu) {
     uint8_t res = (cpu->a >> 1) | (cpu->a << 7);
-    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rla(z80_t* cpu) {
     uint8_t res = (cpu->a << 1) | (cpu->f & Z80_CF);
-    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rra(z80_t* cpu) {
     uint8_t res = (cpu->a >> 1) | ((cpu->f & Z80_CF) << 7);
-    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
@@ -623,51 +829,51 @@ static inline void _z80_daa(z80_t* cpu) {
 
 static inline void _z80_cpl(z80_t* cpu) {
     cpu->a ^= 0xFF;
-    cpu->f= (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) |Z80_HF|Z80_NF| (cpu->a & (Z80_YF|Z80_XF));
+    cpu->f= (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) |Z80_HF|Z80_NF| (cpu->a & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_scf(z80_t* cpu) {
-    cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | Z80_CF | (cpu->a & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | Z80_CF | (cpu->a & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_ccf(z80_t* cpu) {
-    cpu->f = ((cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | ((cpu->f & Z80_CF)<<4) | (cpu->a & (Z80_YF|Z80_XF))) ^ Z80_CF;
+    cpu->f = ((cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | ((cpu->f & Z80_CF)<<4) | (cpu->a & (_Z80_YF|_Z80_XF))) ^ Z80_CF;
 }
 
 static inline void _z80_add16(z80_t* cpu, uint16_t val) {
     const uint16_t acc = cpu->hlx[cpu->hlx_idx].hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc + val;
     cpu->hlx[cpu->hlx_idx].hl = res;
     cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_VF)) |
              (((acc ^ res ^ val)>>8)&Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_YF|Z80_XF));
+             ((res >> 8) & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_adc16(z80_t* cpu, uint16_t val) {
     // NOTE: adc is ED-prefixed, so they are never rewired to IX/IY
     const uint16_t acc = cpu->hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc + val + (cpu->f & Z80_CF);
     cpu->hl = res;
     cpu->f = (((val ^ acc ^ 0x8000) & (val ^ res) & 0x8000) >> 13) |
              (((acc ^ res ^ val) >>8 ) & Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_SF|Z80_YF|Z80_XF)) |
+             ((res >> 8) & (Z80_SF|_Z80_YF|_Z80_XF)) |
              ((res & 0xFFFF) ? 0 : Z80_ZF);
 }
 
 static inline void _z80_sbc16(z80_t* cpu, uint16_t val) {
     // NOTE: sbc is ED-prefixed, so they are never rewired to IX/IY
     const uint16_t acc = cpu->hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc - val - (cpu->f & Z80_CF);
     cpu->hl = res;
     cpu->f = (Z80_NF | (((val ^ acc) & (acc ^ res) & 0x8000) >> 13)) |
              (((acc ^ res ^ val) >> 8) & Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_SF|Z80_YF|Z80_XF)) |
+             ((res >> 8) & (Z80_SF|_Z80_YF|_Z80_XF)) |
              ((res & 0xFFFF) ? 0 : Z80_ZF);
 }
 
@@ -675,8 +881,8 @@ static inline bool _z80_ldi_ldd(z80_t* cpu, uint8_t val) {
     const uint8_t res = cpu->a + val;
     cpu->bc -= 1;
     cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_CF)) |
-             ((res & 2) ? Z80_YF : 0) |
-             ((res & 8) ? Z80_XF : 0) |
+             ((res & 2) ? _Z80_YF : 0) |
+             ((res & 8) ? _Z80_XF : 0) |
              (cpu->bc ? Z80_VF : 0);
     return cpu->bc != 0;
 }
@@ -689,8 +895,8 @@ static inline bool _z80_cpi_cpd(z80_t* cpu, uint8_t val) {
         f |= Z80_HF;
         res--;
     }
-    if (res & 2) { f |= Z80_YF; }
-    if (res & 8) { f |= Z80_XF; }
+    if (res & 2) { f |= _Z80_YF; }
+    if (res & 8) { f |= _Z80_XF; }
     if (cpu->bc) { f |= Z80_VF; }
     cpu->f = f;
     return (cpu->bc != 0) && !(f & Z80_ZF);
@@ -698,7 +904,7 @@ static inline bool _z80_cpi_cpd(z80_t* cpu, uint8_t val) {
 
 static inline bool _z80_ini_ind(z80_t* cpu, uint8_t val, uint8_t c) {
     const uint8_t b = cpu->b;
-    uint8_t f = _z80_sz_flags(b) | (b & (Z80_XF|Z80_YF));
+    uint8_t f = _z80_szyx(b);
     if (val & Z80_SF) { f |= Z80_NF; }
     uint32_t t = (uint32_t)c + val;
     if (t & 0x100) { f |= Z80_HF|Z80_CF; }
@@ -709,7 +915,7 @@ static inline bool _z80_ini_ind(z80_t* cpu, uint8_t val, uint8_t c) {
 
 static inline bool _z80_outi_outd(z80_t* cpu, uint8_t val) {
     const uint8_t b = cpu->b;
-    uint8_t f = _z80_sz_flags(b) | (b & (Z80_XF|Z80_YF));
+    uint8_t f = _z80_szyx(b);
     if (val & Z80_SF) { f |= Z80_NF; }
     uint32_t t = (uint32_t)cpu->l + val;
     if (t & 0x0100) { f |= Z80_HF|Z80_CF; }
@@ -841,10 +1047,10 @@ static inline bool _z80_cb_action(z80_t* cpu, uint8_t z0, uint8_t z1) {
             res = val & (1<<y);
             cpu->f = (cpu->f & Z80_CF) | Z80_HF | (res ? (res & Z80_SF) : (Z80_ZF|Z80_PF));
             if (z0 == 6) {
-                cpu->f |= (cpu->wz >> 8) & (Z80_YF|Z80_XF);
+                cpu->f |= (cpu->wz >> 8) & (_Z80_YF|_Z80_XF);
             }
             else {
-                cpu->f |= val & (Z80_YF|Z80_XF);
+                cpu->f |= val & (_Z80_YF|_Z80_XF);
             }
             break;
         case 2: // res
@@ -880,7 +1086,7 @@ static inline bool _z80_cb_action(z80_t* cpu, uint8_t z0, uint8_t z1) {
 static inline void _z80_ddfdcb_addr(z80_t* cpu, uint64_t pins) {
     uint8_t d = _z80_get_db(pins);
     cpu->addr = cpu->hlx[cpu->hlx_idx].hl + (int8_t)d;
-    cpu->wz = cpu->addr;
+    _Z80_MEMPTR(cpu->wz = cpu->addr);
 }
 
 // special case opstate table slots
@@ -1802,7 +2008,11 @@ uint64_t z80_prefetch(z80_t* cpu, uint16_t new_pc) {
 #define _mwrite(ab,d)   _sadx(ab,d,Z80_MREQ|Z80_WR)
 #define _ioread(ab)     _sax(ab,Z80_IORQ|Z80_RD)
 #define _iowrite(ab,d)  _sadx(ab,d,Z80_IORQ|Z80_WR)
+#if defined(Z80_NO_WAIT)
+#define _wait()
+#else
 #define _wait()         {if(pins&Z80_WAIT)goto track_int_bits;}
+#endif
 #define _cc_nz          (!(cpu->f&Z80_ZF))
 #define _cc_z           (cpu->f&Z80_ZF)
 #define _cc_nc          (!(cpu->f&Z80_CF))
@@ -1840,7 +2050,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //--- mread
         case 6: goto step_next;
         case 7: _wait();_mread(cpu->pc++); goto step_next;
-        case 8: cpu->addr += (int8_t)_gd(); cpu->wz = cpu->addr; goto step_next;
+        case 8: cpu->addr += (int8_t)_gd(); _Z80_MEMPTR(cpu->wz = cpu->addr); goto step_next;
         //--- filler ticks
         case 9: goto step_next;
         case 10: goto step_next;
@@ -1855,7 +2065,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //--- mread for d offset
         case 14: goto step_next;
         case 15: _wait();_mread(cpu->pc++); goto step_next;
-        case 16: cpu->addr += (int8_t)_gd(); cpu->wz = cpu->addr; goto step_next;
+        case 16: cpu->addr += (int8_t)_gd(); _Z80_MEMPTR(cpu->wz = cpu->addr); goto step_next;
         //--- mread for n
         case 17: goto step_next;
         case 18: _wait();_mread(cpu->pc++); goto step_next;
@@ -1907,7 +2117,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //  02: LD (BC),A (M:2 T:7)
         // -- mwrite
         case   36: goto step_next;
-        case   37: _wait();_mwrite(cpu->bc,cpu->a);cpu->wzl=cpu->c+1;cpu->wzh=cpu->a;goto step_next;
+        case   37: _wait();_mwrite(cpu->bc,cpu->a);_Z80_MEMPTR(cpu->wzl=cpu->c+1;cpu->wzh=cpu->a);goto step_next;
         case   38: goto step_next;
         // -- overlapped
         case   39: goto fetch_next;
@@ -1959,7 +2169,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- mread
         case   59: goto step_next;
         case   60: _wait();_mread(cpu->bc);goto step_next;
-        case   61: cpu->a=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case   61: cpu->a=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case   62: goto fetch_next;
         
@@ -1998,7 +2208,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case   75: _wait();_mread(cpu->pc++);goto step_next;
         case   76: cpu->dlatch=_gd();if(--cpu->b==0){_skip(5);};goto step_next;
         // -- generic
-        case   77: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case   77: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case   78: goto step_next;
         case   79: goto step_next;
         case   80: goto step_next;
@@ -2021,7 +2231,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //  12: LD (DE),A (M:2 T:7)
         // -- mwrite
         case   90: goto step_next;
-        case   91: _wait();_mwrite(cpu->de,cpu->a);cpu->wzl=cpu->e+1;cpu->wzh=cpu->a;goto step_next;
+        case   91: _wait();_mwrite(cpu->de,cpu->a);_Z80_MEMPTR(cpu->wzl=cpu->e+1;cpu->wzh=cpu->a);goto step_next;
         case   92: goto step_next;
         // -- overlapped
         case   93: goto fetch_next;
@@ -2059,7 +2269,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  105: _wait();_mread(cpu->pc++);goto step_next;
         case  106: cpu->dlatch=_gd();goto step_next;
         // -- generic
-        case  107: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case  107: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case  108: goto step_next;
         case  109: goto step_next;
         case  110: goto step_next;
@@ -2083,7 +2293,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- mread
         case  121: goto step_next;
         case  122: _wait();_mread(cpu->de);goto step_next;
-        case  123: cpu->a=_gd();cpu->wz=cpu->de+1;goto step_next;
+        case  123: cpu->a=_gd();_Z80_MEMPTR(cpu->wz=cpu->de+1);goto step_next;
         // -- overlapped
         case  124: goto fetch_next;
         
@@ -2120,7 +2330,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  136: _wait();_mread(cpu->pc++);goto step_next;
         case  137: cpu->dlatch=_gd();if(!(_cc_nz)){_skip(5);};goto step_next;
         // -- generic
-        case  138: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case  138: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case  139: goto step_next;
         case  140: goto step_next;
         case  141: goto step_next;
@@ -2193,7 +2403,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  175: _wait();_mread(cpu->pc++);goto step_next;
         case  176: cpu->dlatch=_gd();if(!(_cc_z)){_skip(5);};goto step_next;
         // -- generic
-        case  177: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case  177: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case  178: goto step_next;
         case  179: goto step_next;
         case  180: goto step_next;
@@ -2266,7 +2476,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  215: _wait();_mread(cpu->pc++);goto step_next;
         case  216: cpu->dlatch=_gd();if(!(_cc_nc)){_skip(5);};goto step_next;
         // -- generic
-        case  217: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case  217: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case  218: goto step_next;
         case  219: goto step_next;
         case  220: goto step_next;
@@ -2297,7 +2507,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  235: cpu->wzh=_gd();goto step_next;
         // -- mwrite
         case  236: goto step_next;
-        case  237: _wait();_mwrite(cpu->wz++,cpu->a);cpu->wzh=cpu->a;goto step_next;
+        case  237: _wait();_mwrite(cpu->wz++,cpu->a);_Z80_MEMPTR(cpu->wzh=cpu->a);goto step_next;
         case  238: goto step_next;
         // -- overlapped
         case  239: goto fetch_next;
@@ -2357,7 +2567,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  268: _wait();_mread(cpu->pc++);goto step_next;
         case  269: cpu->dlatch=_gd();if(!(_cc_c)){_skip(5);};goto step_next;
         // -- generic
-        case  270: cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;goto step_next;
+        case  270: cpu->pc+=(int8_t)cpu->dlatch;_Z80_MEMPTR(cpu->wz=cpu->pc);goto step_next;
         case  271: goto step_next;
         case  272: goto step_next;
         case  273: goto step_next;
@@ -3281,7 +3491,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case  649: goto step_next;
         case  650: _iowrite(cpu->wz,cpu->a);goto step_next;
-        case  651: _wait();cpu->wzl++;goto step_next;
+        case  651: _wait();_Z80_MEMPTR(cpu->wzl++);goto step_next;
         case  652: goto step_next;
         // -- overlapped
         case  653: goto fetch_next;
@@ -3830,7 +4040,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case  959: goto step_next;
         case  960: goto step_next;
         case  961: _wait();_ioread(cpu->bc);goto step_next;
-        case  962: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case  962: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case  963: cpu->b=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -3838,7 +4048,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case  964: goto step_next;
         case  965: _iowrite(cpu->bc,cpu->b);goto step_next;
-        case  966: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case  966: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case  967: goto step_next;
         // -- overlapped
         case  968: goto fetch_next;
@@ -3906,7 +4116,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1001: goto step_next;
         case 1002: goto step_next;
         case 1003: _wait();_ioread(cpu->bc);goto step_next;
-        case 1004: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1004: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1005: cpu->c=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -3914,7 +4124,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1006: goto step_next;
         case 1007: _iowrite(cpu->bc,cpu->c);goto step_next;
-        case 1008: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1008: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1009: goto step_next;
         // -- overlapped
         case 1010: goto fetch_next;
@@ -3955,7 +4165,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- mread
         case 1032: goto step_next;
         case 1033: _wait();_mread(cpu->sp++);goto step_next;
-        case 1034: cpu->wzl=_gd();pins|=Z80_RETI;goto step_next;
+        case 1034: cpu->wzl=_gd();pins|=_Z80_RETI;goto step_next;
         // -- mread
         case 1035: goto step_next;
         case 1036: _wait();_mread(cpu->sp++);goto step_next;
@@ -3978,7 +4188,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1042: goto step_next;
         case 1043: goto step_next;
         case 1044: _wait();_ioread(cpu->bc);goto step_next;
-        case 1045: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1045: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1046: cpu->d=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -3986,7 +4196,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1047: goto step_next;
         case 1048: _iowrite(cpu->bc,cpu->d);goto step_next;
-        case 1049: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1049: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1050: goto step_next;
         // -- overlapped
         case 1051: goto fetch_next;
@@ -4038,7 +4248,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1076: goto step_next;
         case 1077: goto step_next;
         case 1078: _wait();_ioread(cpu->bc);goto step_next;
-        case 1079: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1079: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1080: cpu->e=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -4046,7 +4256,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1081: goto step_next;
         case 1082: _iowrite(cpu->bc,cpu->e);goto step_next;
-        case 1083: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1083: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1084: goto step_next;
         // -- overlapped
         case 1085: goto fetch_next;
@@ -4098,7 +4308,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1110: goto step_next;
         case 1111: goto step_next;
         case 1112: _wait();_ioread(cpu->bc);goto step_next;
-        case 1113: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1113: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1114: cpu->h=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -4106,7 +4316,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1115: goto step_next;
         case 1116: _iowrite(cpu->bc,cpu->h);goto step_next;
-        case 1117: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1117: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1118: goto step_next;
         // -- overlapped
         case 1119: goto fetch_next;
@@ -4159,7 +4369,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1148: goto step_next;
         // -- mwrite
         case 1149: goto step_next;
-        case 1150: _wait();_mwrite(cpu->hl,cpu->dlatch);cpu->wz=cpu->hl+1;goto step_next;
+        case 1150: _wait();_mwrite(cpu->hl,cpu->dlatch);_Z80_MEMPTR(cpu->wz=cpu->hl+1);goto step_next;
         case 1151: goto step_next;
         // -- overlapped
         case 1152: goto fetch_next;
@@ -4169,7 +4379,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1153: goto step_next;
         case 1154: goto step_next;
         case 1155: _wait();_ioread(cpu->bc);goto step_next;
-        case 1156: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1156: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1157: cpu->l=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -4177,7 +4387,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1158: goto step_next;
         case 1159: _iowrite(cpu->bc,cpu->l);goto step_next;
-        case 1160: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1160: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1161: goto step_next;
         // -- overlapped
         case 1162: goto fetch_next;
@@ -4230,7 +4440,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1191: goto step_next;
         // -- mwrite
         case 1192: goto step_next;
-        case 1193: _wait();_mwrite(cpu->hl,cpu->dlatch);cpu->wz=cpu->hl+1;goto step_next;
+        case 1193: _wait();_mwrite(cpu->hl,cpu->dlatch);_Z80_MEMPTR(cpu->wz=cpu->hl+1);goto step_next;
         case 1194: goto step_next;
         // -- overlapped
         case 1195: goto fetch_next;
@@ -4240,7 +4450,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1196: goto step_next;
         case 1197: goto step_next;
         case 1198: _wait();_ioread(cpu->bc);goto step_next;
-        case 1199: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1199: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1200: _z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -4248,7 +4458,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1201: goto step_next;
         case 1202: _iowrite(cpu->bc,0);goto step_next;
-        case 1203: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1203: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1204: goto step_next;
         // -- overlapped
         case 1205: goto fetch_next;
@@ -4294,7 +4504,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1228: goto step_next;
         case 1229: goto step_next;
         case 1230: _wait();_ioread(cpu->bc);goto step_next;
-        case 1231: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;goto step_next;
+        case 1231: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         // -- overlapped
         case 1232: cpu->a=_z80_in(cpu,cpu->dlatch);goto fetch_next;
         
@@ -4302,7 +4512,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1233: goto step_next;
         case 1234: _iowrite(cpu->bc,cpu->a);goto step_next;
-        case 1235: _wait();cpu->wz=cpu->bc+1;goto step_next;
+        case 1235: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);goto step_next;
         case 1236: goto step_next;
         // -- overlapped
         case 1237: goto fetch_next;
@@ -4364,7 +4574,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1270: _wait();_mread(cpu->hl++);goto step_next;
         case 1271: cpu->dlatch=_gd();goto step_next;
         // -- generic
-        case 1272: cpu->wz++;_z80_cpi_cpd(cpu,cpu->dlatch);goto step_next;
+        case 1272: _Z80_MEMPTR(cpu->wz++);_z80_cpi_cpd(cpu,cpu->dlatch);goto step_next;
         case 1273: goto step_next;
         case 1274: goto step_next;
         case 1275: goto step_next;
@@ -4379,7 +4589,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1279: goto step_next;
         case 1280: goto step_next;
         case 1281: _wait();_ioread(cpu->bc);goto step_next;
-        case 1282: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->b--;;goto step_next;
+        case 1282: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);cpu->b--;;goto step_next;
         // -- mwrite
         case 1283: goto step_next;
         case 1284: _wait();_mwrite(cpu->hl++,cpu->dlatch);_z80_ini_ind(cpu,cpu->dlatch,cpu->c+1);goto step_next;
@@ -4397,7 +4607,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1291: goto step_next;
         case 1292: _iowrite(cpu->bc,cpu->dlatch);goto step_next;
-        case 1293: _wait();cpu->wz=cpu->bc+1;_z80_outi_outd(cpu,cpu->dlatch);goto step_next;
+        case 1293: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);_z80_outi_outd(cpu,cpu->dlatch);goto step_next;
         case 1294: goto step_next;
         // -- overlapped
         case 1295: goto fetch_next;
@@ -4423,7 +4633,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1306: _wait();_mread(cpu->hl--);goto step_next;
         case 1307: cpu->dlatch=_gd();goto step_next;
         // -- generic
-        case 1308: cpu->wz--;_z80_cpi_cpd(cpu,cpu->dlatch);goto step_next;
+        case 1308: _Z80_MEMPTR(cpu->wz--);_z80_cpi_cpd(cpu,cpu->dlatch);goto step_next;
         case 1309: goto step_next;
         case 1310: goto step_next;
         case 1311: goto step_next;
@@ -4438,7 +4648,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1315: goto step_next;
         case 1316: goto step_next;
         case 1317: _wait();_ioread(cpu->bc);goto step_next;
-        case 1318: cpu->dlatch=_gd();cpu->wz=cpu->bc-1;cpu->b--;;goto step_next;
+        case 1318: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc-1);cpu->b--;;goto step_next;
         // -- mwrite
         case 1319: goto step_next;
         case 1320: _wait();_mwrite(cpu->hl--,cpu->dlatch);_z80_ini_ind(cpu,cpu->dlatch,cpu->c-1);goto step_next;
@@ -4456,7 +4666,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1327: goto step_next;
         case 1328: _iowrite(cpu->bc,cpu->dlatch);goto step_next;
-        case 1329: _wait();cpu->wz=cpu->bc-1;_z80_outi_outd(cpu,cpu->dlatch);goto step_next;
+        case 1329: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc-1);_z80_outi_outd(cpu,cpu->dlatch);goto step_next;
         case 1330: goto step_next;
         // -- overlapped
         case 1331: goto fetch_next;
@@ -4474,7 +4684,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1338: if(!_z80_ldi_ldd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1339: goto step_next;
         // -- generic
-        case 1340: cpu->wz=--cpu->pc;--cpu->pc;;goto step_next;
+        case 1340: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;;goto step_next;
         case 1341: goto step_next;
         case 1342: goto step_next;
         case 1343: goto step_next;
@@ -4488,13 +4698,13 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1347: _wait();_mread(cpu->hl++);goto step_next;
         case 1348: cpu->dlatch=_gd();goto step_next;
         // -- generic
-        case 1349: cpu->wz++;if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
+        case 1349: _Z80_MEMPTR(cpu->wz++);if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1350: goto step_next;
         case 1351: goto step_next;
         case 1352: goto step_next;
         case 1353: goto step_next;
         // -- generic
-        case 1354: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1354: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1355: goto step_next;
         case 1356: goto step_next;
         case 1357: goto step_next;
@@ -4509,13 +4719,13 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1361: goto step_next;
         case 1362: goto step_next;
         case 1363: _wait();_ioread(cpu->bc);goto step_next;
-        case 1364: cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->b--;;goto step_next;
+        case 1364: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc+1);cpu->b--;;goto step_next;
         // -- mwrite
         case 1365: goto step_next;
         case 1366: _wait();_mwrite(cpu->hl++,cpu->dlatch);if (!_z80_ini_ind(cpu,cpu->dlatch,cpu->c+1)){_skip(5);};goto step_next;
         case 1367: goto step_next;
         // -- generic
-        case 1368: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1368: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1369: goto step_next;
         case 1370: goto step_next;
         case 1371: goto step_next;
@@ -4533,10 +4743,10 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1378: goto step_next;
         case 1379: _iowrite(cpu->bc,cpu->dlatch);goto step_next;
-        case 1380: _wait();cpu->wz=cpu->bc+1;if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
+        case 1380: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc+1);if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1381: goto step_next;
         // -- generic
-        case 1382: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1382: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1383: goto step_next;
         case 1384: goto step_next;
         case 1385: goto step_next;
@@ -4557,7 +4767,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1394: if(!_z80_ldi_ldd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1395: goto step_next;
         // -- generic
-        case 1396: cpu->wz=--cpu->pc;--cpu->pc;;goto step_next;
+        case 1396: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;;goto step_next;
         case 1397: goto step_next;
         case 1398: goto step_next;
         case 1399: goto step_next;
@@ -4571,13 +4781,13 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1403: _wait();_mread(cpu->hl--);goto step_next;
         case 1404: cpu->dlatch=_gd();goto step_next;
         // -- generic
-        case 1405: cpu->wz--;if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
+        case 1405: _Z80_MEMPTR(cpu->wz--);if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1406: goto step_next;
         case 1407: goto step_next;
         case 1408: goto step_next;
         case 1409: goto step_next;
         // -- generic
-        case 1410: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1410: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1411: goto step_next;
         case 1412: goto step_next;
         case 1413: goto step_next;
@@ -4592,13 +4802,13 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         case 1417: goto step_next;
         case 1418: goto step_next;
         case 1419: _wait();_ioread(cpu->bc);goto step_next;
-        case 1420: cpu->dlatch=_gd();cpu->wz=cpu->bc-1;cpu->b--;;goto step_next;
+        case 1420: cpu->dlatch=_gd();_Z80_MEMPTR(cpu->wz=cpu->bc-1);cpu->b--;;goto step_next;
         // -- mwrite
         case 1421: goto step_next;
         case 1422: _wait();_mwrite(cpu->hl--,cpu->dlatch);if (!_z80_ini_ind(cpu,cpu->dlatch,cpu->c-1)){_skip(5);};goto step_next;
         case 1423: goto step_next;
         // -- generic
-        case 1424: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1424: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1425: goto step_next;
         case 1426: goto step_next;
         case 1427: goto step_next;
@@ -4616,10 +4826,10 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         // -- iowrite
         case 1434: goto step_next;
         case 1435: _iowrite(cpu->bc,cpu->dlatch);goto step_next;
-        case 1436: _wait();cpu->wz=cpu->bc-1;if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
+        case 1436: _wait();_Z80_MEMPTR(cpu->wz=cpu->bc-1);if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(5);};goto step_next;
         case 1437: goto step_next;
         // -- generic
-        case 1438: cpu->wz=--cpu->pc;--cpu->pc;goto step_next;
+        case 1438: _Z80_MEMPTR(cpu->wz=cpu->pc-1);cpu->pc-=2;goto step_next;
         case 1439: goto step_next;
         case 1440: goto step_next;
         case 1441: goto step_next;
@@ -4755,7 +4965,10 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
     }
 fetch_next: pins = _z80_fetch(cpu, pins);
 step_next:  cpu->step += 1;
-track_int_bits: {
+#if !defined(Z80_NO_WAIT)
+track_int_bits:
+#endif
+    {
         // track NMI 0 => 1 edge and current INT pin state, this will track the
         // relevant interrupt status up to the last instruction cycle and will
         // be checked in the first M1 cycle (during _fetch)
@@ -4789,5 +5002,9 @@ track_int_bits: {
 #undef _cc_pe
 #undef _cc_p
 #undef _cc_m
+#undef _Z80_XF
+#undef _Z80_YF
+#undef _Z80_MEMPTR
+#undef _Z80_RETI
 
 #endif // CHIPS_IMPL
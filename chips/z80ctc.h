@@ -94,6 +94,23 @@
         - **Z80CTC_INT**: if the CTC wants to request an interrupt
         - **Z80CTC_ZCTO0..ZCTO2**: when the channels 0..2 are in counter mode and the countdown reaches 0
         - **Z80CTC_IEIO**: enable or disable interrupts for daisychain downstream chips
+
+    ~~~C
+    uint32_t z80ctc_idle_ticks(const z80ctc_t* ctc)
+    ~~~
+        Returns the number of following ticks which don't need to be
+        performed with z80ctc_tick() as long as the CPU doesn't access the
+        CTC. This is 0 if a channel is in counter mode or waiting for an
+        external trigger, or if an interrupt is pending, otherwise it's the
+        number of ticks until the next timer channel reaches zero. Use this
+        with the event scheduler in chips_common.h.
+
+    ~~~C
+    void z80ctc_advance(z80ctc_t* ctc, uint32_t num_ticks)
+    ~~~
+        Advance the timer channels by a number of skipped ticks, num_ticks
+        must not be greater than the value returned by z80ctc_idle_ticks()
+        after the last z80ctc_tick().
 #*/
 /*
     zlib/libpng license
@@ -211,6 +228,7 @@ typedef struct {
 // Z80 CTC state
 typedef struct {
     z80ctc_channel_t chn[Z80CTC_NUM_CHANNELS];
+    bool int_active;    // false if int_state of all channels is zero (daisy chain can be skipped)
     uint64_t pins;
 } z80ctc_t;
 
@@ -225,6 +243,10 @@ void z80ctc_init(z80ctc_t* ctc);
 void z80ctc_reset(z80ctc_t* ctc);
 // tick the CTC instance
 uint64_t z80ctc_tick(z80ctc_t* ctc, uint64_t pins);
+// get number of ticks the CTC doesn't need to be ticked
+uint32_t z80ctc_idle_ticks(const z80ctc_t* ctc);
+// catch up with skipped ticks
+void z80ctc_advance(z80ctc_t* ctc, uint32_t num_ticks);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -267,6 +289,7 @@ void z80ctc_reset(z80ctc_t* ctc) {
         chn->prescaler_mask = 0x0F;
         chn->int_state = 0;
     }
+    ctc->int_active = false;
 }
 
 /*
@@ -278,6 +301,7 @@ static uint64_t _z80ctc_counter_zero(z80ctc_t* ctc, z80ctc_channel_t* chn, uint6
     if (chn->control & Z80CTC_CTRL_EI) {
         // interrupt enabled, request an interrupt
         chn->int_state |= Z80CTC_INT_NEEDED;
+        ctc->int_active = true;
     }
     // last channel doesn't have a ZCTO pin
     if (chn_id < 3) {
@@ -410,6 +434,11 @@ static uint64_t _z80ctc_tick(z80ctc_t* ctc, uint64_t pins) {
 
 // interrupt daisy chain handling
 static uint64_t _z80ctc_int(z80ctc_t* ctc, uint64_t pins) {
+    // fast path: no channel takes part in interrupt handling, IEIO and RETI pass through unchanged
+    if (!ctc->int_active) {
+        return pins;
+    }
+    uint8_t int_state = 0;
     for (int i = 0; i < Z80CTC_NUM_CHANNELS; i++) {
         z80ctc_channel_t* chn = &ctc->chn[i];
 
@@ -464,7 +493,9 @@ static uint64_t _z80ctc_int(z80ctc_t* ctc, uint64_t pins) {
                 pins &= ~Z80CTC_INT;
             }
         }
+        int_state |= chn->int_state;
     }
+    ctc->int_active = (int_state != 0);
     return pins;
 }
 
@@ -478,4 +509,56 @@ uint64_t z80ctc_tick(z80ctc_t* ctc, uint64_t pins) {
     return pins;
 }
 
+// true if a channel is counting down in timer mode
+static inline bool _z80ctc_timer_running(const z80ctc_channel_t* chn) {
+    return (chn->control & (Z80CTC_CTRL_MODE|Z80CTC_CTRL_RESET|Z80CTC_CTRL_CONST_FOLLOWS)) == Z80CTC_CTRL_MODE_TIMER;
+}
+
+// number of ticks until the first down counter decrement of a timer channel
+static inline uint32_t _z80ctc_first_decrement(const z80ctc_channel_t* chn) {
+    const uint32_t p = chn->prescaler & chn->prescaler_mask;
+    return (p != 0) ? p : (chn->prescaler_mask + 1U);
+}
+
+uint32_t z80ctc_idle_ticks(const z80ctc_t* ctc) {
+    CHIPS_ASSERT(ctc);
+    uint32_t idle = 0xFFFFFFFF;
+    for (int chn_id = 0; chn_id < Z80CTC_NUM_CHANNELS; chn_id++) {
+        const z80ctc_channel_t* chn = &ctc->chn[chn_id];
+        if ((chn->int_state != 0) || chn->waiting_for_trigger || ((chn->control & Z80CTC_CTRL_MODE) == Z80CTC_CTRL_MODE_COUNTER)) {
+            // needs to see every tick for the daisychain or external trigger pins
+            return 0;
+        }
+        if (_z80ctc_timer_running(chn)) {
+            // a down counter value of 0 means 256
+            const uint32_t counter = (chn->down_counter != 0) ? chn->down_counter : 256;
+            const uint32_t ticks_to_zero = _z80ctc_first_decrement(chn) + (counter - 1) * (chn->prescaler_mask + 1U);
+            if ((ticks_to_zero - 1) < idle) {
+                idle = ticks_to_zero - 1;
+            }
+        }
+    }
+    return idle;
+}
+
+void z80ctc_advance(z80ctc_t* ctc, uint32_t num_ticks) {
+    CHIPS_ASSERT(ctc);
+    if (0 == num_ticks) {
+        return;
+    }
+    for (int chn_id = 0; chn_id < Z80CTC_NUM_CHANNELS; chn_id++) {
+        z80ctc_channel_t* chn = &ctc->chn[chn_id];
+        if (_z80ctc_timer_running(chn)) {
+            const uint32_t first = _z80ctc_first_decrement(chn);
+            if (num_ticks >= first) {
+                const uint32_t num_decrements = 1 + (num_ticks - first) / (chn->prescaler_mask + 1U);
+                CHIPS_ASSERT((chn->down_counter == 0) || (num_decrements < chn->down_counter));
+                chn->down_counter -= (uint8_t)num_decrements;
+            }
+            chn->prescaler -= (uint8_t)num_ticks;
+        }
+    }
+    ctc->pins &= ~(Z80CTC_ZCTO0|Z80CTC_ZCTO1|Z80CTC_ZCTO2);
+}
+
 #endif /* CHIPS_IMPL */
@@ -277,6 +277,7 @@ typedef struct {
 typedef struct {
     z80pio_port_t port[Z80PIO_NUM_PORTS];
     bool reset_active;  /* currently in reset state? (until a control word is received) */
+    bool int_active;    /* false if int_state of both ports is zero (daisy chain can be skipped) */
     uint64_t pins;      /* last pin state (useful for debugging) */
 } z80pio_t;
 
@@ -303,6 +304,10 @@ void z80pio_init(z80pio_t* pio);
 void z80pio_reset(z80pio_t* pio);
 /* tick the Z80 PIO instance */
 uint64_t z80pio_tick(z80pio_t* pio, uint64_t pins);
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+/* save or load the PIO state in a streaming snapshot (only if chips_common.h is included before z80pio.h) */
+void z80pio_stream(z80pio_t* pio, chips_stream_t* stream);
+#endif
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -345,6 +350,7 @@ void z80pio_reset(z80pio_t* pio) {
         pio->port[p].int_state = 0;
     }
     pio->reset_active = true;
+    pio->int_active = false;
 }
 
 /* new control word received from CPU */
@@ -526,6 +532,11 @@ uint64_t _z80pio_iorq(z80pio_t* pio, uint64_t pins) {
 
 // handle the interrupt daisy chain protocol
 uint64_t _z80pio_int(z80pio_t* pio, uint64_t pins) {
+    // fast path: no port takes part in interrupt handling, IEIO and RETI pass through unchanged
+    if (!pio->int_active) {
+        return pins;
+    }
+    uint8_t int_state = 0;
     for (int i = 0; i < Z80PIO_NUM_PORTS; i++) {
         z80pio_port_t* p = &pio->port[i];
         // on RETI, only the highest priority interrupt that's currently being
@@ -579,7 +590,9 @@ uint64_t _z80pio_int(z80pio_t* pio, uint64_t pins) {
                 pins &= ~Z80PIO_INT;
             }
         }
+        int_state |= p->int_state;
     }
+    pio->int_active = (int_state != 0);
     return pins;
 }
 
@@ -611,6 +624,7 @@ void _z80pio_read_port_inputs(z80pio_t* pio, uint64_t pins) {
                 else if ((ictrl == 0x60) && (val == mask)) match = true;
                 if (!p->bctrl_match && match && p->int_enabled) {
                     p->int_state |= Z80PIO_INT_NEEDED;
+                    pio->int_active = true;
                 }
                 p->bctrl_match = match;
             }
@@ -654,4 +668,31 @@ uint64_t z80pio_tick(z80pio_t* pio, uint64_t pins) {
     return pins;
 }
 
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+void z80pio_stream(z80pio_t* pio, chips_stream_t* s) {
+    CHIPS_ASSERT(pio && s);
+    chips_stream_begin(s, CHIPS_STREAM_TAG('P','I','O',' '), 1);
+    for (int i = 0; i < Z80PIO_NUM_PORTS; i++) {
+        z80pio_port_t* p = &pio->port[i];
+        chips_stream_u8(s, &p->input);
+        chips_stream_u8(s, &p->output);
+        chips_stream_u8(s, &p->mode);
+        chips_stream_u8(s, &p->io_select);
+        chips_stream_u8(s, &p->int_vector);
+        chips_stream_u8(s, &p->int_control);
+        chips_stream_u8(s, &p->int_mask);
+        chips_stream_u8(s, &p->int_state);
+        chips_stream_bool(s, &p->int_enabled);
+        chips_stream_bool(s, &p->expect_io_select);
+        chips_stream_bool(s, &p->expect_int_mask);
+        chips_stream_bool(s, &p->bctrl_match);
+    }
+    chips_stream_bool(s, &pio->reset_active);
+    chips_stream_u64(s, &pio->pins);
+    chips_stream_end(s);
+    // not part of the stream, derived from the port interrupt states
+    pio->int_active = (pio->port[0].int_state | pio->port[1].int_state) != 0;
+}
+#endif
+
 #endif /* CHIPS_IMPL */
@@ -21,6 +21,35 @@
     CHIPS_ASSERT(c)
     ~~~
 
+    Optionally define one or more of the following before including the
+    implementation to compile a smaller decoder for systems which don't
+    need the respective feature:
+
+    ~~~C
+    #define M6502_NO_UNDOC
+    ~~~
+        The undocumented instructions (except the JAM opcodes) are removed
+        from the decoder, executing one of them jams the CPU.
+
+    ~~~C
+    #define M6502_NO_BCD
+    ~~~
+        The decimal mode is removed from ADC, SBC and ARR (like the
+        2A03 in the NES), same as setting m6502_desc_t.bcd_disabled
+        but without the runtime check.
+
+    ~~~C
+    #define M6502_NO_IO_PORT
+    ~~~
+        The m6502_tick() function doesn't update the M6510 port pins (P0..P5)
+        and doesn't reset the IO port on RES, use this when no m6510 IO
+        port is emulated (m6510_iorq() is never called).
+
+    Those are defined per compilation unit, so all systems which are
+    implemented in the same compilation unit share the same decoder (for
+    instance the C64 and its 1541 floppy drive). The m6502x.h decoder
+    uses the ADC/SBC helpers of m6502.h and thus shares M6502_NO_BCD.
+
     ## Emulated Pins
 
     ***********************************
@@ -358,6 +387,10 @@ uint64_t m6510_iorq(m6502_t* cpu, uint64_t pins);
 void m6502_snapshot_onsave(m6502_t* snapshot);
 // fixup m6502_t snapshot after loading
 void m6502_snapshot_onload(m6502_t* snapshot, m6502_t* sys);
+#if defined(CHIPS_HASH_SEED)
+// continue a state hash with the m6502_t state (excluding host pointers)
+uint64_t m6502_hash(const m6502_t* cpu, uint64_t h);
+#endif
 
 /* register access functions */
 void m6502_set_a(m6502_t* cpu, uint8_t v);
@@ -418,9 +451,14 @@ uint16_t m6502_pc(m6502_t* cpu) { return cpu->PC; }
 
 /* helper macros and functions for code-generated instruction decoder */
 #define _M6502_NZ(p,v) ((p&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+#if defined(M6502_NO_BCD)
+#define _M6502_BCD(cpu) (false)
+#else
+#define _M6502_BCD(cpu) ((cpu)->bcd_enabled && ((cpu)->P & M6502_DF))
+#endif
 
 static inline void _m6502_adc(m6502_t* cpu, uint8_t val) {
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         /* decimal mode (credit goes to MAME) */
         uint8_t c = cpu->P & M6502_CF ? 1 : 0;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
@@ -462,7 +500,7 @@ static inline void _m6502_adc(m6502_t* cpu, uint8_t val) {
 }
 
 static inline void _m6502_sbc(m6502_t* cpu, uint8_t val) {
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         /* decimal mode (credit goes to MAME) */
         uint8_t c = cpu->P & M6502_CF ? 0 : 1;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
@@ -561,7 +599,7 @@ static inline void _m6502_arr(m6502_t* cpu) {
        by the Wolfgang Lorenz C64 test suite
        implementation taken from MAME
     */
-    if (cpu->bcd_enabled && (cpu->P & M6502_DF)) {
+    if (_M6502_BCD(cpu)) {
         bool c = cpu->P & M6502_CF;
         cpu->P &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
         uint8_t a = cpu->A>>1;
@@ -612,6 +650,7 @@ static inline void _m6502_sbx(m6502_t* cpu, uint8_t v) {
     cpu->X = (uint8_t)t;
 }
 #undef _M6502_NZ
+#undef _M6502_BCD
 
 uint64_t m6502_init(m6502_t* c, const m6502_desc_t* desc) {
     CHIPS_ASSERT(c && desc);
@@ -677,6 +716,16 @@ void m6502_snapshot_onload(m6502_t* snapshot, m6502_t* sys) {
     snapshot->user_data = sys->user_data;
 }
 
+#if defined(CHIPS_HASH_SEED)
+uint64_t m6502_hash(const m6502_t* cpu, uint64_t h) {
+    CHIPS_ASSERT(cpu);
+    m6502_t tmp;
+    memcpy(&tmp, cpu, sizeof(tmp));
+    m6502_snapshot_onsave(&tmp);
+    return CHIPS_HASH(h, tmp);
+}
+#endif
+
 /* set 16-bit address in 64-bit pin mask */
 #define _SA(addr) pins=(pins&~0xFFFF)|((addr)&0xFFFFULL)
 /* extract 16-bit addess from pin mask */
@@ -720,7 +769,9 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
 
         // RDY pin is only checked during read cycles
         if ((pins & (M6502_RW|M6502_RDY)) == (M6502_RW|M6502_RDY)) {
+            #if !defined(M6502_NO_IO_PORT)
             M6510_SET_PORT(pins, c->io_pins);
+            #endif
             c->PINS = pins;
             c->irq_pip <<= 1;
             return pins;
@@ -746,10 +797,12 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
             }
             if (0 != (pins & M6502_RES)) {
                 c->brk_flags |= M6502_BRK_RESET;
+                #if !defined(M6502_NO_IO_PORT)
                 c->io_ddr = 0;
                 c->io_out = 0;
                 c->io_inp = 0;
                 c->io_pins = 0;
+                #endif
             }
             c->irq_pip &= 0x3FF;
             c->nmi_pip &= 0x3FF;
@@ -769,8 +822,15 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
     _RD();
     switch (c->IR++) {
 $decode_block
+#if defined(M6502_NO_UNDOC)
+        default:
+            // a compiled-out undocumented instruction, same as the JAM opcodes
+            _SAD(0xFFFF,0xFF);c->IR--;break;
+#endif
     }
+    #if !defined(M6502_NO_IO_PORT)
     M6510_SET_PORT(pins, c->io_pins);
+    #endif
     c->PINS = pins;
     c->irq_pip <<= 1;
     c->nmi_pip <<= 1;
@@ -781,6 +841,7 @@ $decode_block
 #endif
 
 #undef _SA
+#undef _GA
 #undef _SAD
 #undef _FETCH
 #undef _SD
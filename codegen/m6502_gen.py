@@ -3,9 +3,12 @@
 #   Generate instruction decoder for m6502.h emulator.
 #-------------------------------------------------------------------------------
 from string import Template
+import re
 
 InpPath = 'm6502.template.h'
 OutPath = '../chips/m6502.h'
+LanesInpPath = 'm6502x.template.h'
+LanesOutPath = '../chips/m6502x.h'
 
 # flag bits
 CF = (1<<0)
@@ -116,6 +119,7 @@ class opcode:
     def __init__(self, op):
         self.code = op
         self.cmt = None
+        self.undoc = False
         self.i = 0
         self.src = [None] * 8
     def t(self, src):
@@ -132,16 +136,40 @@ def l(s) :
     global out_lines
     out_lines += s + '\n'
 
+lanes_out_lines = ''
+def ll(s) :
+    global lanes_out_lines
+    lanes_out_lines += s + '\n'
+
+#-------------------------------------------------------------------------------
+#   convert a decoder step from m6502_t to the m6502x_t lane arrays
+#
+def lanes_src(src):
+    src = re.sub(r'c->(\w+)', r'c->\1[i]', src)
+    src = re.sub(r'_m6502_(\w+)\(c,', r'_m6502x_\1(c,i,', src)
+    src = re.sub(r'_m6502_(\w+)\(c\)', r'_m6502x_\1(c,i)', src)
+    return src
+
 #-------------------------------------------------------------------------------
 def write_op(op):
     if not op.cmt:
         op.cmt = '???'
+    # undocumented instructions can be compiled out with M6502_NO_UNDOC,
+    # they end up in the JAM fallback of the decoder switch
+    if op.undoc:
+        l('#if !defined(M6502_NO_UNDOC)')
     l('    /* {} */'.format(op.cmt if op.cmt else '???'))
     for t in range(0, 8):
         if t < op.i:
             l('        case (0x{:02X}<<3)|{}: {}break;'.format(op.code, t, op.src[t]))
         else:
             l('        case (0x{:02X}<<3)|{}: assert(false);break;'.format(op.code, t))
+    if op.undoc:
+        l('#endif')
+    ll('    /* {} */'.format(op.cmt if op.cmt else '???'))
+    for t in range(0, 8):
+        src = lanes_src(op.src[t]) if t < op.i else 'assert(false);'
+        ll('        case (0x{:02X}<<3)|{}: for (int i = i0; i < i1; i++) {{ _BEGIN(){}_END() }} break;'.format(op.code, t, src))
 
 #-------------------------------------------------------------------------------
 def cmt(o,cmd):
@@ -157,6 +185,7 @@ def cmt(o,cmd):
 def u_cmt(o,cmd):
     cmt(o,cmd)
     o.cmt += ' (undoc)'
+    o.undoc = True
 
 #-------------------------------------------------------------------------------
 def invalid_opcode(op):
@@ -689,6 +718,8 @@ def x_las(o):
 def x_jam(o):
     # undocumented JAM, next opcode byte read, data and addr bus set to all 1, execution stops
     u_cmt(o, 'JAM')
+    # JAM stays in when undocumented instructions are compiled out
+    o.undoc = False
     o.t('_SA(c->PC);')
     o.t('_SAD(0xFFFF,0xFF);c->IR--;')
 
@@ -850,11 +881,18 @@ def enc_op(op):
 #-------------------------------------------------------------------------------
 #   execution starts here
 #
-for op in range(0, 256):
-    write_op(enc_op(op))
+ops_list = [enc_op(op) for op in range(0, 256)]
+for op in ops_list:
+    write_op(op)
 
 with open(InpPath, 'r') as inf:
     templ = Template(inf.read())
     c_src = templ.safe_substitute(decode_block=out_lines)
     with open(OutPath, 'w') as outf:
         outf.write(c_src)
+
+with open(LanesInpPath, 'r') as inf:
+    templ = Template(inf.read())
+    c_src = templ.safe_substitute(decode_block=lanes_out_lines)
+    with open(LanesOutPath, 'w') as outf:
+        outf.write(c_src)
@@ -0,0 +1,415 @@
+#pragma once
+/*#
+    # m6502x.h
+
+    Multi-lane MOS Technology 6502 CPU emulator for running many
+    identical machines in lockstep.
+
+    Project repo: https://github.com/floooh/chips/
+
+    NOTE: this file is code-generated from m6502x.template.h and m6502_gen.py
+    in the 'codegen' directory.
+
+    Do this:
+    ~~~C
+    #define CHIPS_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    You need to include the following header before including m6502x.h,
+    and in the implementation file, the m6502.h implementation must
+    be included before the m6502x.h implementation:
+
+        - m6502.h
+
+    Optionally provide the following macros with your own implementation
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+
+    ## Overview
+
+    m6502x.h is the same cycle-stepped 6502 emulation as m6502.h, but
+    instead of one CPU state, the m6502x_t struct holds the register
+    state of up to M6502X_MAX_LANES CPUs ('lanes') in a structure-of-arrays
+    layout, and m6502x_tick() ticks all lanes with a single call.
+
+    Decoder steps are dispatched once for each run of adjacent lanes which
+    are at the same decoder step (e.g. all lanes execute the same code
+    with different input data), the decoder step is then executed in a
+    tight loop over the lanes' register arrays which the compiler can
+    vectorize. When lanes diverge, m6502x_tick() automatically
+    falls back to dispatching smaller runs of lanes, down to one dispatch
+    per lane.
+
+    Each lane is bit-identical with a m6502_t instance created with the same
+    bcd_disabled setting. The 6510 IO port is not supported.
+
+    ## Functions
+
+    ~~~C
+    void m6502x_init(m6502x_t* cpu, const m6502x_desc_t* desc, uint64_t* pins)
+    ~~~
+        Initialize a m6502x_t instance, the desc structure provides
+        initialization attributes:
+            ~~~C
+            typedef struct {
+                int num_lanes;      // number of CPU lanes (1..M6502X_MAX_LANES)
+                bool bcd_disabled;  // set to true if BCD mode is disabled
+            } m6502x_desc_t;
+            ~~~
+        The pins argument must point to an array of num_lanes pin masks,
+        which will be initialized with the initial pin state of each lane.
+
+    ~~~C
+    void m6502x_tick(m6502x_t* cpu, uint64_t* pins)
+    ~~~
+        Tick all lanes for one clock cycle. The pins array holds one pin mask
+        per lane which is both the input and output of the tick function,
+        memory requests must be handled per lane exactly like with m6502_tick().
+
+    ~~~C
+    void m6502x_get_lane(const m6502x_t* cpu, int lane, m6502_t* out)
+    void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* src)
+    ~~~
+        Copy the CPU state of a lane into a m6502_t, or overwrite the
+        state of a lane from a m6502_t (for instance to seed all lanes
+        from a snapshot, or to inspect a lane in the debugging UI).
+
+    ## HOWTO
+
+    Run many VIC-20-style machines in lockstep with per-lane memory:
+    ~~~C
+        static m6502x_t cpu;
+        uint64_t pins[NUM_LANES];
+        m6502x_init(&cpu, &(m6502x_desc_t){ .num_lanes = NUM_LANES }, pins);
+        while (...) {
+            m6502x_tick(&cpu, pins);
+            for (int i = 0; i < NUM_LANES; i++) {
+                const uint16_t addr = M6502_GET_ADDR(pins[i]);
+                if (pins[i] & M6502_RW) {
+                    M6502_SET_DATA(pins[i], mem[i][addr]);
+                }
+                else {
+                    mem[i][addr] = M6502_GET_DATA(pins[i]);
+                }
+            }
+        }
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define M6502X_MAX_LANES (64)
+
+/* the desc structure provided to m6502x_init() */
+typedef struct {
+    int num_lanes;      /* number of CPU lanes (1..M6502X_MAX_LANES) */
+    bool bcd_disabled;  /* set to true if BCD mode is disabled */
+} m6502x_desc_t;
+
+/* multi-lane CPU state, each array item is one lane */
+typedef struct {
+    int num_lanes;
+    uint8_t bcd_enabled;
+    uint16_t IR[M6502X_MAX_LANES];
+    uint16_t PC[M6502X_MAX_LANES];
+    uint16_t AD[M6502X_MAX_LANES];
+    uint8_t A[M6502X_MAX_LANES];
+    uint8_t X[M6502X_MAX_LANES];
+    uint8_t Y[M6502X_MAX_LANES];
+    uint8_t S[M6502X_MAX_LANES];
+    uint8_t P[M6502X_MAX_LANES];
+    uint64_t PINS[M6502X_MAX_LANES];
+    uint16_t irq_pip[M6502X_MAX_LANES];
+    uint16_t nmi_pip[M6502X_MAX_LANES];
+    uint8_t brk_flags[M6502X_MAX_LANES];
+} m6502x_t;
+
+/* initialize a new m6502x instance, and initial pin masks (one per lane) */
+void m6502x_init(m6502x_t* cpu, const m6502x_desc_t* desc, uint64_t* pins);
+/* execute one tick on all lanes */
+void m6502x_tick(m6502x_t* cpu, uint64_t* pins);
+/* copy the state of one lane into a m6502_t */
+void m6502x_get_lane(const m6502x_t* cpu, int lane, m6502_t* out);
+/* overwrite the state of one lane from a m6502_t */
+void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* src);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void m6502x_init(m6502x_t* c, const m6502x_desc_t* desc, uint64_t* pins) {
+    CHIPS_ASSERT(c && desc && pins);
+    CHIPS_ASSERT((desc->num_lanes > 0) && (desc->num_lanes <= M6502X_MAX_LANES));
+    memset(c, 0, sizeof(*c));
+    c->num_lanes = desc->num_lanes;
+    c->bcd_enabled = !desc->bcd_disabled;
+    for (int i = 0; i < c->num_lanes; i++) {
+        c->P[i] = M6502_ZF;
+        c->PINS[i] = M6502_RW | M6502_SYNC | M6502_RES;
+        pins[i] = c->PINS[i];
+    }
+}
+
+void m6502x_get_lane(const m6502x_t* c, int i, m6502_t* out) {
+    CHIPS_ASSERT(c && out && (i >= 0) && (i < c->num_lanes));
+    memset(out, 0, sizeof(*out));
+    out->IR = c->IR[i];
+    out->PC = c->PC[i];
+    out->AD = c->AD[i];
+    out->A = c->A[i];
+    out->X = c->X[i];
+    out->Y = c->Y[i];
+    out->S = c->S[i];
+    out->P = c->P[i];
+    out->PINS = c->PINS[i];
+    out->irq_pip = c->irq_pip[i];
+    out->nmi_pip = c->nmi_pip[i];
+    out->brk_flags = c->brk_flags[i];
+    out->bcd_enabled = c->bcd_enabled;
+}
+
+void m6502x_set_lane(m6502x_t* c, int i, const m6502_t* src) {
+    CHIPS_ASSERT(c && src && (i >= 0) && (i < c->num_lanes));
+    c->IR[i] = src->IR;
+    c->PC[i] = src->PC;
+    c->AD[i] = src->AD;
+    c->A[i] = src->A;
+    c->X[i] = src->X;
+    c->Y[i] = src->Y;
+    c->S[i] = src->S;
+    c->P[i] = src->P;
+    c->PINS[i] = src->PINS;
+    c->irq_pip[i] = src->irq_pip;
+    c->nmi_pip[i] = src->nmi_pip;
+    c->brk_flags[i] = src->brk_flags;
+}
+
+/* ALU helpers, these forward to the m6502.h implementation through
+   a temporary m6502_t which the compiler resolves into registers
+*/
+static inline void _m6502x_adc(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_adc(&t, v);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_sbc(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_sbc(&t, v);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_cmp(m6502x_t* c, int i, uint8_t r, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    _m6502_cmp(&t, r, v);
+    c->P[i] = t.P;
+}
+
+static inline uint8_t _m6502x_asl(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_asl(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_lsr(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_lsr(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_rol(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_rol(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline uint8_t _m6502x_ror(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.P = c->P[i];
+    v = _m6502_ror(&t, v);
+    c->P[i] = t.P;
+    return v;
+}
+
+static inline void _m6502x_bit(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i];
+    _m6502_bit(&t, v);
+    c->P[i] = t.P;
+}
+
+static inline void _m6502x_arr(m6502x_t* c, int i) {
+    m6502_t t; t.A = c->A[i]; t.P = c->P[i]; t.bcd_enabled = c->bcd_enabled;
+    _m6502_arr(&t);
+    c->A[i] = t.A; c->P[i] = t.P;
+}
+
+static inline void _m6502x_sbx(m6502x_t* c, int i, uint8_t v) {
+    m6502_t t; t.A = c->A[i]; t.X = c->X[i]; t.P = c->P[i];
+    _m6502_sbx(&t, v);
+    c->X[i] = t.X; c->P[i] = t.P;
+}
+
+/* set 16-bit address in 64-bit pin mask */
+#define _SA(addr) pins[i]=(pins[i]&~0xFFFF)|((addr)&0xFFFFULL)
+/* extract 16-bit addess from pin mask */
+#define _GA() ((uint16_t)(pins[i]&0xFFFFULL))
+/* set 16-bit address and 8-bit data in 64-bit pin mask */
+#define _SAD(addr,data) pins[i]=(pins[i]&~0xFFFFFF)|((((data)&0xFF)<<16)&0xFF0000ULL)|((addr)&0xFFFFULL)
+/* fetch next opcode byte */
+#define _FETCH() _SA(c->PC[i]);_ON(M6502_SYNC);
+/* set 8-bit data in 64-bit pin mask */
+#define _SD(data) pins[i]=((pins[i]&~0xFF0000ULL)|(((data&0xFF)<<16)&0xFF0000ULL))
+/* extract 8-bit data from 64-bit pin mask */
+#define _GD() ((uint8_t)((pins[i]&0xFF0000ULL)>>16))
+/* enable control pins */
+#define _ON(m) pins[i]|=(m)
+/* disable control pins */
+#define _OFF(m) pins[i]&=~(m)
+/* a memory read tick */
+#define _RD() _ON(M6502_RW);
+/* a memory write tick */
+#define _WR() _OFF(M6502_RW);
+/* set N and Z flags depending on value */
+#define _NZ(v) c->P[i]=((c->P[i]&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+/* start of a lane's decoder step: advance the step counter, reads are default, writes are special */
+#define _BEGIN() c->IR[i]++;_RD();
+/* end of a lane's decoder step (there's no 6510 IO port, so the port bits are cleared) */
+#define _END() pins[i]&=~M6510_PORT_BITS;c->PINS[i]=pins[i];c->irq_pip[i]<<=1;c->nmi_pip[i]<<=1;
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4244)   /* conversion from 'uint16_t' to 'uint8_t', possible loss of data */
+#endif
+
+/* interrupt detection, RDY and instruction fetch for one lane, same as
+   the code at the start of m6502_tick(), returns false if the lane
+   is stalled by the RDY pin in this tick
+*/
+static inline bool _m6502x_begin_tick(m6502x_t* c, uint64_t* pins, int i) {
+    if (pins[i] & (M6502_SYNC|M6502_IRQ|M6502_NMI|M6502_RDY|M6502_RES)) {
+        // NMI is edge-triggered
+        if (0 != ((pins[i] & (pins[i] ^ c->PINS[i])) & M6502_NMI)) {
+            c->nmi_pip[i] |= 0x100;
+        }
+        // IRQ test is level triggered
+        if ((pins[i] & M6502_IRQ) && (0 == (c->P[i] & M6502_IF))) {
+            c->irq_pip[i] |= 0x100;
+        }
+        // RDY pin is only checked during read cycles
+        if ((pins[i] & (M6502_RW|M6502_RDY)) == (M6502_RW|M6502_RDY)) {
+            pins[i] &= ~M6510_PORT_BITS;
+            c->PINS[i] = pins[i];
+            c->irq_pip[i] <<= 1;
+            return false;
+        }
+        if (pins[i] & M6502_SYNC) {
+            // load new instruction into 'instruction register' and restart tick counter
+            c->IR[i] = _GD()<<3;
+            _OFF(M6502_SYNC);
+            if (0 != (c->irq_pip[i] & 0x400)) {
+                c->brk_flags[i] |= M6502_BRK_IRQ;
+            }
+            if (0 != (c->nmi_pip[i] & 0xFC00)) {
+                c->brk_flags[i] |= M6502_BRK_NMI;
+            }
+            if (0 != (pins[i] & M6502_RES)) {
+                c->brk_flags[i] |= M6502_BRK_RESET;
+            }
+            c->irq_pip[i] &= 0x3FF;
+            c->nmi_pip[i] &= 0x3FF;
+            // if interrupt or reset was requested, force a BRK instruction
+            if (c->brk_flags[i]) {
+                c->IR[i] = 0;
+                c->P[i] &= ~M6502_BF;
+                pins[i] &= ~M6502_RES;
+            }
+            else {
+                c->PC[i]++;
+            }
+        }
+    }
+    return true;
+}
+
+/* execute the decoder step 'ir' on the lanes i0..i1 (exclusive) */
+static void _m6502x_step(m6502x_t* c, uint64_t* pins, uint16_t ir, int i0, int i1) {
+    switch (ir) {
+$decode_block
+    }
+}
+
+void m6502x_tick(m6502x_t* c, uint64_t* pins) {
+    const int num_lanes = c->num_lanes;
+    bool active[M6502X_MAX_LANES];
+    for (int i = 0; i < num_lanes; i++) {
+        active[i] = _m6502x_begin_tick(c, pins, i);
+    }
+    // dispatch each run of adjacent active lanes at the same decoder step once
+    int i0 = 0;
+    while (i0 < num_lanes) {
+        if (!active[i0]) {
+            i0++;
+            continue;
+        }
+        const uint16_t ir = c->IR[i0];
+        int i1 = i0 + 1;
+        while ((i1 < num_lanes) && active[i1] && (c->IR[i1] == ir)) {
+            i1++;
+        }
+        _m6502x_step(c, pins, ir, i0, i1);
+        i0 = i1;
+    }
+}
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#undef _SA
+#undef _GA
+#undef _SAD
+#undef _FETCH
+#undef _SD
+#undef _GD
+#undef _ON
+#undef _OFF
+#undef _RD
+#undef _WR
+#undef _NZ
+#undef _BEGIN
+#undef _END
+#endif /* CHIPS_IMPL */
@@ -16,6 +16,49 @@
     #define CHIPS_ASSERT(x) your_own_asset_macro(x)
     ~~~
 
+    Optionally define the following before including the implementation to
+    look up the sign, zero and undocumented flags of the 8-bit arithmetic
+    instructions, and the complete flags of INC/DEC in small precomputed
+    tables (768 bytes) instead of computing them:
+    ~~~C
+    #define Z80_USE_FLAG_TABLES
+    ~~~
+
+    Optionally define one or more of the following before including the
+    implementation to compile a leaner but less accurate decoder, for
+    systems and workloads which don't depend on the respective feature:
+
+    ~~~C
+    #define Z80_NO_WAIT
+    ~~~
+        The WAIT pin is ignored, memory and IO machine cycles are never
+        stretched by wait states.
+
+    ~~~C
+    #define Z80_NO_UNDOC_FLAGS
+    ~~~
+        The undocumented flag bits XF and YF are not computed by most
+        instructions, their value is undefined.
+
+    ~~~C
+    #define Z80_NO_MEMPTR
+    ~~~
+        The internal MEMPTR register (WZ) is only updated where the decoder
+        needs it as temporary register (for instance for the target address
+        of jumps and the address of 16-bit loads), the pure MEMPTR side
+        effects are skipped. The only visible effect is on the undocumented
+        XF and YF flags of BIT n,(HL).
+
+    ~~~C
+    #define Z80_NO_RETI
+    ~~~
+        The virtual RETI pin isn't set when a RETI instruction is decoded,
+        only use this if no interrupt daisy chain is connected.
+
+    All those are defined per compilation unit (the Z80 implementation
+    is shared by all systems in the same compilation unit). The default
+    decoder models everything.
+
     ## Emulated Pins
     ***********************************
     *           +-----------+         *
@@ -63,6 +106,21 @@
         Helper function to detect whether the z80_t instance has completed
         an instruction.
 
+    ~~~C
+    uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks)
+    ~~~
+        Fast-forward a CPU which sits in the HALT state, instead of
+        ticking it through the 4-cycle HALT opcode refetch loop. This only
+        has an effect when z80_opdone() is true, the Z80_HALT pin is set and
+        no NMI is pending, otherwise the function returns 0. The number of
+        skipped ticks is num_ticks rounded down to a multiple of 4, and
+        the only CPU state which changes is the R register. The caller is
+        responsible for making sure that no interrupt is requested during the
+        skipped ticks, and that the system doesn't insert wait states
+        into the refetch cycles. Returns the number of skipped ticks, all
+        other pins remain unchanged (the memory reads of the skipped HALT
+        refetch cycles don't have side effects on most systems).
+
     ## HOWTO
 
     Initialize a new z80_t instance and start ticking it:
@@ -375,6 +433,12 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins);
 uint64_t z80_prefetch(z80_t* cpu, uint16_t new_pc);
 // return true when full instruction has finished
 bool z80_opdone(z80_t* cpu);
+// fast-forward a halted CPU, returns number of skipped ticks (multiple of 4)
+uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks);
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+// save or load the CPU state in a streaming snapshot (only if chips_common.h is included before z80.h)
+void z80_stream(z80_t* cpu, chips_stream_t* stream);
+#endif
 
 #ifdef __cplusplus
 } // extern C
@@ -396,6 +460,25 @@ bool z80_opdone(z80_t* cpu);
 #define _Z80_UNREACHABLE
 #endif
 
+// optional reduced-accuracy features
+#if defined(Z80_NO_UNDOC_FLAGS)
+#define _Z80_XF (0)
+#define _Z80_YF (0)
+#else
+#define _Z80_XF Z80_XF
+#define _Z80_YF Z80_YF
+#endif
+#if defined(Z80_NO_MEMPTR)
+#define _Z80_MEMPTR(x)
+#else
+#define _Z80_MEMPTR(x) x
+#endif
+#if defined(Z80_NO_RETI)
+#define _Z80_RETI (0)
+#else
+#define _Z80_RETI Z80_RETI
+#endif
+
 // values for hlx_idx for mapping HL, IX or IY, used as index into hlx[]
 #define _Z80_MAP_HL (0)
 #define _Z80_MAP_IX (1)
@@ -426,6 +509,52 @@ bool z80_opdone(z80_t* cpu) {
     return ((cpu->pins & (Z80_M1|Z80_RD)) == (Z80_M1|Z80_RD)) && !cpu->prefix_active;
 }
 
+#if defined(CHIPS_STREAM_FORMAT_VERSION)
+// NOTE: the decoder step is specific to the generated decoder, a change in
+// the generated step numbering must bump the section version
+void z80_stream(z80_t* cpu, chips_stream_t* s) {
+    CHIPS_ASSERT(cpu && s);
+    chips_stream_begin(s, CHIPS_STREAM_TAG('Z','8','0',' '), 1);
+    chips_stream_u16(s, &cpu->step);
+    chips_stream_u16(s, &cpu->addr);
+    chips_stream_u8(s, &cpu->dlatch);
+    chips_stream_u8(s, &cpu->opcode);
+    chips_stream_u8(s, &cpu->hlx_idx);
+    chips_stream_bool(s, &cpu->prefix_active);
+    chips_stream_u64(s, &cpu->pins);
+    chips_stream_u64(s, &cpu->int_bits);
+    chips_stream_u16(s, &cpu->pc);
+    chips_stream_u16(s, &cpu->af);
+    chips_stream_u16(s, &cpu->bc);
+    chips_stream_u16(s, &cpu->de);
+    chips_stream_u16(s, &cpu->hl);
+    chips_stream_u16(s, &cpu->ix);
+    chips_stream_u16(s, &cpu->iy);
+    chips_stream_u16(s, &cpu->wz);
+    chips_stream_u16(s, &cpu->sp);
+    chips_stream_u16(s, &cpu->ir);
+    chips_stream_u16(s, &cpu->af2);
+    chips_stream_u16(s, &cpu->bc2);
+    chips_stream_u16(s, &cpu->de2);
+    chips_stream_u16(s, &cpu->hl2);
+    chips_stream_u8(s, &cpu->im);
+    chips_stream_bool(s, &cpu->iff1);
+    chips_stream_bool(s, &cpu->iff2);
+    chips_stream_end(s);
+}
+#endif
+
+uint32_t z80_skip_halt(z80_t* cpu, uint32_t num_ticks) {
+    if (!(cpu->pins & Z80_HALT) || !z80_opdone(cpu) || (cpu->int_bits & Z80_NMI)) {
+        return 0;
+    }
+    // each HALT opcode refetch takes 4 clock cycles and has one refresh cycle
+    const uint32_t num_fetches = num_ticks >> 2;
+    cpu->r = (cpu->r & 0x80) | ((cpu->r + num_fetches) & 0x7F);
+    cpu->int_bits = 0;
+    return num_fetches << 2;
+}
+
 static inline uint64_t _z80_halt(z80_t* cpu, uint64_t pins) {
     cpu->pc--;
     return pins | Z80_HALT;
@@ -433,31 +562,36 @@ static inline uint64_t _z80_halt(z80_t* cpu, uint64_t pins) {
 
 // sign+zero+parity lookup table
 static const uint8_t _z80_szp_flags[256] = {
-  0x44,0x00,0x00,0x04,0x00,0x04,0x04,0x00,0x08,0x0c,0x0c,0x08,0x0c,0x08,0x08,0x0c,
-  0x00,0x04,0x04,0x00,0x04,0x00,0x00,0x04,0x0c,0x08,0x08,0x0c,0x08,0x0c,0x0c,0x08,
-  0x20,0x24,0x24,0x20,0x24,0x20,0x20,0x24,0x2c,0x28,0x28,0x2c,0x28,0x2c,0x2c,0x28,
-  0x24,0x20,0x20,0x24,0x20,0x24,0x24,0x20,0x28,0x2c,0x2c,0x28,0x2c,0x28,0x28,0x2c,
-  0x00,0x04,0x04,0x00,0x04,0x00,0x00,0x04,0x0c,0x08,0x08,0x0c,0x08,0x0c,0x0c,0x08,
-  0x04,0x00,0x00,0x04,0x00,0x04,0x04,0x00,0x08,0x0c,0x0c,0x08,0x0c,0x08,0x08,0x0c,
-  0x24,0x20,0x20,0x24,0x20,0x24,0x24,0x20,0x28,0x2c,0x2c,0x28,0x2c,0x28,0x28,0x2c,
-  0x20,0x24,0x24,0x20,0x24,0x20,0x20,0x24,0x2c,0x28,0x28,0x2c,0x28,0x2c,0x2c,0x28,
-  0x80,0x84,0x84,0x80,0x84,0x80,0x80,0x84,0x8c,0x88,0x88,0x8c,0x88,0x8c,0x8c,0x88,
-  0x84,0x80,0x80,0x84,0x80,0x84,0x84,0x80,0x88,0x8c,0x8c,0x88,0x8c,0x88,0x88,0x8c,
-  0xa4,0xa0,0xa0,0xa4,0xa0,0xa4,0xa4,0xa0,0xa8,0xac,0xac,0xa8,0xac,0xa8,0xa8,0xac,
-  0xa0,0xa4,0xa4,0xa0,0xa4,0xa0,0xa0,0xa4,0xac,0xa8,0xa8,0xac,0xa8,0xac,0xac,0xa8,
-  0x84,0x80,0x80,0x84,0x80,0x84,0x84,0x80,0x88,0x8c,0x8c,0x88,0x8c,0x88,0x88,0x8c,
-  0x80,0x84,0x84,0x80,0x84,0x80,0x80,0x84,0x8c,0x88,0x88,0x8c,0x88,0x8c,0x8c,0x88,
-  0xa0,0xa4,0xa4,0xa0,0xa4,0xa0,0xa0,0xa4,0xac,0xa8,0xa8,0xac,0xa8,0xac,0xac,0xa8,
-  0xa4,0xa0,0xa0,0xa4,0xa0,0xa4,0xa4,0xa0,0xa8,0xac,0xac,0xa8,0xac,0xa8,0xa8,0xac,
-};
+$szp_flags};
+
+#if defined(Z80_USE_FLAG_TABLES)
+// sign+zero+undocumented flags lookup table
+static const uint8_t _z80_szyx_flags[256] = {
+$szyx_flags};
+
+// INC r flags (without carry), indexed by result
+static const uint8_t _z80_inc8_flags[256] = {
+$inc8_flags};
+
+// DEC r flags (without carry), indexed by result
+static const uint8_t _z80_dec8_flags[256] = {
+$dec8_flags};
+#endif
 
 static inline uint8_t _z80_sz_flags(uint8_t val) {
     return (val != 0) ? (val & Z80_SF) : Z80_ZF;
 }
 
+static inline uint8_t _z80_szyx(uint8_t val) {
+    #if defined(Z80_USE_FLAG_TABLES)
+    return _z80_szyx_flags[val];
+    #else
+    return _z80_sz_flags(val) | (val & (_Z80_YF|_Z80_XF));
+    #endif
+}
+
 static inline uint8_t _z80_szyxch_flags(uint8_t acc, uint8_t val, uint32_t res) {
-    return _z80_sz_flags(res) |
-        (res & (Z80_YF|Z80_XF)) |
+    return _z80_szyx((uint8_t)res) |
         ((res >> 8) & Z80_CF) |
         ((acc ^ val ^ res) & Z80_HF);
 }
@@ -473,14 +607,14 @@ static inline uint8_t _z80_sub_flags(uint8_t acc, uint8_t val, uint32_t res) {
 static inline uint8_t _z80_cp_flags(uint8_t acc, uint8_t val, uint32_t res) {
     return Z80_NF |
         _z80_sz_flags(res) |
-        (val & (Z80_YF|Z80_XF)) |
+        (val & (_Z80_YF|_Z80_XF)) |
         ((res >> 8) & Z80_CF) |
         ((acc ^ val ^ res) & Z80_HF) |
         ((((val ^ acc) & (res ^ acc)) >> 5) & Z80_VF);
 }
 
 static inline uint8_t _z80_sziff2_flags(z80_t* cpu, uint8_t val) {
-    return (cpu->f & Z80_CF) | _z80_sz_flags(val) | (val & (Z80_YF|Z80_XF)) | (cpu->iff2 ? Z80_PF : 0);
+    return (cpu->f & Z80_CF) | _z80_szyx(val) | (cpu->iff2 ? Z80_PF : 0);
 }
 
 static inline void _z80_add8(z80_t* cpu, uint8_t val) {
@@ -535,21 +669,29 @@ static inline void _z80_neg8(z80_t* cpu) {
 
 static inline uint8_t _z80_inc8(z80_t* cpu, uint8_t val) {
     uint8_t res = val + 1;
-    uint8_t f = _z80_sz_flags(res) | (res & (Z80_XF|Z80_YF)) | ((res ^ val) & Z80_HF);
+    #if defined(Z80_USE_FLAG_TABLES)
+    cpu->f = _z80_inc8_flags[res] | (cpu->f & Z80_CF);
+    #else
+    uint8_t f = _z80_szyx(res) | ((res ^ val) & Z80_HF);
     if (res == 0x80) {
         f |= Z80_VF;
     }
     cpu->f = f | (cpu->f & Z80_CF);
+    #endif
     return res;
 }
 
 static inline uint8_t _z80_dec8(z80_t* cpu, uint8_t val) {
     uint8_t res = val - 1;
-    uint8_t f = Z80_NF | _z80_sz_flags(res) | (res & (Z80_XF|Z80_YF)) | ((res ^ val) & Z80_HF);
+    #if defined(Z80_USE_FLAG_TABLES)
+    cpu->f = _z80_dec8_flags[res] | (cpu->f & Z80_CF);
+    #else
+    uint8_t f = Z80_NF | _z80_szyx(res) | ((res ^ val) & Z80_HF);
     if (res == 0x7F) {
         f |= Z80_VF;
     }
     cpu->f = f | (cpu->f & Z80_CF);
+    #endif
     return res;
 }
 
@@ -574,25 +716,25 @@ static inline void _z80_exx(z80_t* cpu) {
 
 static inline void _z80_rlca(z80_t* cpu) {
     uint8_t res = (cpu->a << 1) | (cpu->a >> 7);
-    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rrca(z80_t* cpu) {
     uint8_t res = (cpu->a >> 1) | (cpu->a << 7);
-    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rla(z80_t* cpu) {
     uint8_t res = (cpu->a << 1) | (cpu->f & Z80_CF);
-    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = ((cpu->a >> 7) & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
 static inline void _z80_rra(z80_t* cpu) {
     uint8_t res = (cpu->a >> 1) | ((cpu->f & Z80_CF) << 7);
-    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->a & Z80_CF) | (cpu->f & (Z80_SF|Z80_ZF|Z80_PF)) | (res & (_Z80_YF|_Z80_XF));
     cpu->a = res;
 }
 
@@ -623,51 +765,51 @@ static inline void _z80_daa(z80_t* cpu) {
 
 static inline void _z80_cpl(z80_t* cpu) {
     cpu->a ^= 0xFF;
-    cpu->f= (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) |Z80_HF|Z80_NF| (cpu->a & (Z80_YF|Z80_XF));
+    cpu->f= (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) |Z80_HF|Z80_NF| (cpu->a & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_scf(z80_t* cpu) {
-    cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | Z80_CF | (cpu->a & (Z80_YF|Z80_XF));
+    cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | Z80_CF | (cpu->a & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_ccf(z80_t* cpu) {
-    cpu->f = ((cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | ((cpu->f & Z80_CF)<<4) | (cpu->a & (Z80_YF|Z80_XF))) ^ Z80_CF;
+    cpu->f = ((cpu->f & (Z80_SF|Z80_ZF|Z80_PF|Z80_CF)) | ((cpu->f & Z80_CF)<<4) | (cpu->a & (_Z80_YF|_Z80_XF))) ^ Z80_CF;
 }
 
 static inline void _z80_add16(z80_t* cpu, uint16_t val) {
     const uint16_t acc = cpu->hlx[cpu->hlx_idx].hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc + val;
     cpu->hlx[cpu->hlx_idx].hl = res;
     cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_VF)) |
              (((acc ^ res ^ val)>>8)&Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_YF|Z80_XF));
+             ((res >> 8) & (_Z80_YF|_Z80_XF));
 }
 
 static inline void _z80_adc16(z80_t* cpu, uint16_t val) {
     // NOTE: adc is ED-prefixed, so they are never rewired to IX/IY
     const uint16_t acc = cpu->hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc + val + (cpu->f & Z80_CF);
     cpu->hl = res;
     cpu->f = (((val ^ acc ^ 0x8000) & (val ^ res) & 0x8000) >> 13) |
              (((acc ^ res ^ val) >>8 ) & Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_SF|Z80_YF|Z80_XF)) |
+             ((res >> 8) & (Z80_SF|_Z80_YF|_Z80_XF)) |
              ((res & 0xFFFF) ? 0 : Z80_ZF);
 }
 
 static inline void _z80_sbc16(z80_t* cpu, uint16_t val) {
     // NOTE: sbc is ED-prefixed, so they are never rewired to IX/IY
     const uint16_t acc = cpu->hl;
-    cpu->wz = acc + 1;
+    _Z80_MEMPTR(cpu->wz = acc + 1);
     const uint32_t res = acc - val - (cpu->f & Z80_CF);
     cpu->hl = res;
     cpu->f = (Z80_NF | (((val ^ acc) & (acc ^ res) & 0x8000) >> 13)) |
              (((acc ^ res ^ val) >> 8) & Z80_HF) |
              ((res >> 16) & Z80_CF) |
-             ((res >> 8) & (Z80_SF|Z80_YF|Z80_XF)) |
+             ((res >> 8) & (Z80_SF|_Z80_YF|_Z80_XF)) |
              ((res & 0xFFFF) ? 0 : Z80_ZF);
 }
 
@@ -675,8 +817,8 @@ static inline bool _z80_ldi_ldd(z80_t* cpu, uint8_t val) {
     const uint8_t res = cpu->a + val;
     cpu->bc -= 1;
     cpu->f = (cpu->f & (Z80_SF|Z80_ZF|Z80_CF)) |
-             ((res & 2) ? Z80_YF : 0) |
-             ((res & 8) ? Z80_XF : 0) |
+             ((res & 2) ? _Z80_YF : 0) |
+             ((res & 8) ? _Z80_XF : 0) |
              (cpu->bc ? Z80_VF : 0);
     return cpu->bc != 0;
 }
@@ -689,8 +831,8 @@ static inline bool _z80_cpi_cpd(z80_t* cpu, uint8_t val) {
         f |= Z80_HF;
         res--;
     }
-    if (res & 2) { f |= Z80_YF; }
-    if (res & 8) { f |= Z80_XF; }
+    if (res & 2) { f |= _Z80_YF; }
+    if (res & 8) { f |= _Z80_XF; }
     if (cpu->bc) { f |= Z80_VF; }
     cpu->f = f;
     return (cpu->bc != 0) && !(f & Z80_ZF);
@@ -698,7 +840,7 @@ static inline bool _z80_cpi_cpd(z80_t* cpu, uint8_t val) {
 
 static inline bool _z80_ini_ind(z80_t* cpu, uint8_t val, uint8_t c) {
     const uint8_t b = cpu->b;
-    uint8_t f = _z80_sz_flags(b) | (b & (Z80_XF|Z80_YF));
+    uint8_t f = _z80_szyx(b);
     if (val & Z80_SF) { f |= Z80_NF; }
     uint32_t t = (uint32_t)c + val;
     if (t & 0x100) { f |= Z80_HF|Z80_CF; }
@@ -709,7 +851,7 @@ static inline bool _z80_ini_ind(z80_t* cpu, uint8_t val, uint8_t c) {
 
 static inline bool _z80_outi_outd(z80_t* cpu, uint8_t val) {
     const uint8_t b = cpu->b;
-    uint8_t f = _z80_sz_flags(b) | (b & (Z80_XF|Z80_YF));
+    uint8_t f = _z80_szyx(b);
     if (val & Z80_SF) { f |= Z80_NF; }
     uint32_t t = (uint32_t)cpu->l + val;
     if (t & 0x0100) { f |= Z80_HF|Z80_CF; }
@@ -841,10 +983,10 @@ static inline bool _z80_cb_action(z80_t* cpu, uint8_t z0, uint8_t z1) {
             res = val & (1<<y);
             cpu->f = (cpu->f & Z80_CF) | Z80_HF | (res ? (res & Z80_SF) : (Z80_ZF|Z80_PF));
             if (z0 == 6) {
-                cpu->f |= (cpu->wz >> 8) & (Z80_YF|Z80_XF);
+                cpu->f |= (cpu->wz >> 8) & (_Z80_YF|_Z80_XF);
             }
             else {
-                cpu->f |= val & (Z80_YF|Z80_XF);
+                cpu->f |= val & (_Z80_YF|_Z80_XF);
             }
             break;
         case 2: // res
@@ -880,7 +1022,7 @@ static inline bool _z80_cb_action(z80_t* cpu, uint8_t z0, uint8_t z1) {
 static inline void _z80_ddfdcb_addr(z80_t* cpu, uint64_t pins) {
     uint8_t d = _z80_get_db(pins);
     cpu->addr = cpu->hlx[cpu->hlx_idx].hl + (int8_t)d;
-    cpu->wz = cpu->addr;
+    _Z80_MEMPTR(cpu->wz = cpu->addr);
 }
 
 // special case opstate table slots
@@ -1027,7 +1169,11 @@ uint64_t z80_prefetch(z80_t* cpu, uint16_t new_pc) {
 #define _mwrite(ab,d)   _sadx(ab,d,Z80_MREQ|Z80_WR)
 #define _ioread(ab)     _sax(ab,Z80_IORQ|Z80_RD)
 #define _iowrite(ab,d)  _sadx(ab,d,Z80_IORQ|Z80_WR)
+#if defined(Z80_NO_WAIT)
+#define _wait()
+#else
 #define _wait()         {if(pins&Z80_WAIT)goto track_int_bits;}
+#endif
 #define _cc_nz          (!(cpu->f&Z80_ZF))
 #define _cc_z           (cpu->f&Z80_ZF)
 #define _cc_nc          (!(cpu->f&Z80_CF))
@@ -1065,7 +1211,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //--- mread
         case 6: goto step_next;
         case 7: _wait();_mread(cpu->pc++); goto step_next;
-        case 8: cpu->addr += (int8_t)_gd(); cpu->wz = cpu->addr; goto step_next;
+        case 8: cpu->addr += (int8_t)_gd(); _Z80_MEMPTR(cpu->wz = cpu->addr); goto step_next;
         //--- filler ticks
         case 9: goto step_next;
         case 10: goto step_next;
@@ -1080,7 +1226,7 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins) {
         //--- mread for d offset
         case 14: goto step_next;
         case 15: _wait();_mread(cpu->pc++); goto step_next;
-        case 16: cpu->addr += (int8_t)_gd(); cpu->wz = cpu->addr; goto step_next;
+        case 16: cpu->addr += (int8_t)_gd(); _Z80_MEMPTR(cpu->wz = cpu->addr); goto step_next;
         //--- mread for n
         case 17: goto step_next;
         case 18: _wait();_mread(cpu->pc++); goto step_next;
@@ -1117,7 +1263,10 @@ $decode_block
     }
 fetch_next: pins = _z80_fetch(cpu, pins);
 step_next:  cpu->step += 1;
-track_int_bits: {
+#if !defined(Z80_NO_WAIT)
+track_int_bits:
+#endif
+    {
         // track NMI 0 => 1 edge and current INT pin state, this will track the
         // relevant interrupt status up to the last instruction cycle and will
         // be checked in the first M1 cycle (during _fetch)
@@ -1151,5 +1300,9 @@ track_int_bits: {
 #undef _cc_pe
 #undef _cc_p
 #undef _cc_m
+#undef _Z80_XF
+#undef _Z80_YF
+#undef _Z80_MEMPTR
+#undef _Z80_RETI
 
 #endif // CHIPS_IMPL
@@ -409,6 +409,27 @@ def optable_to_string(type):
         res += f'  // {op_index&0xFF:02X}: {op.name} (M:{len(op.mcycles)-1} T:{op.num_cycles} steps:{op.num_steps})\n'
     return res
 
+# flag lookup tables, (the CPU flag bits are S Z Y H X P/V N C)
+SF = 0x80; ZF = 0x40; YF = 0x20; HF = 0x10; XF = 0x08; PF = 0x04; VF = 0x04; NF = 0x02
+
+def szyx(v):
+    return (v & (SF|YF|XF)) | (ZF if v == 0 else 0)
+
+def szp(v):
+    return szyx(v) | (PF if (bin(v).count('1') & 1) == 0 else 0)
+
+def inc8(res):
+    return szyx(res) | (HF if (res & 0x0F) == 0 else 0) | (VF if res == 0x80 else 0)
+
+def dec8(res):
+    return NF | szyx(res) | (HF if (res & 0x0F) == 0x0F else 0) | (VF if res == 0x7F else 0)
+
+def flagtable_to_string(func):
+    res = ''
+    for i in range(0, 256, 16):
+        res += '  ' + ''.join(f'0x{func(v):02x},' for v in range(i, i+16)) + '\n'
+    return res
+
 def write_result():
     with open(TEMPL_PATH, 'r') as templf:
         templ = Template(templf.read())
@@ -417,7 +438,11 @@ def write_result():
             optable = optable_to_string('main'),
             ddfd_optable = optable_to_string('ddfd'),
             ed_optable = optable_to_string('ed'),
-            special_optable = optable_to_string('special'))
+            special_optable = optable_to_string('special'),
+            szp_flags = flagtable_to_string(szp),
+            szyx_flags = flagtable_to_string(szyx),
+            inc8_flags = flagtable_to_string(inc8),
+            dec8_flags = flagtable_to_string(dec8))
 
         with open(OUT_PATH, 'w') as outf:
             outf.write(c_src)
@@ -34,6 +34,20 @@
 
     FIXME!
 
+    ## State Hash
+
+    atom_state_hash() hashes the CPU, VDG, PPI, VIA, beeper and keyboard
+    state, the tape position and the RAM, e.g. to detect desyncs between
+    two emulator instances. After the first call, RAM writes are
+    dirty-tracked in atom_t.mem, and only written RAM pages are rehashed.
+
+    ## Observation
+
+    atom_observe() returns a pointer to the 40 KByte RAM ("ram", this
+    includes the video RAM at 0x8000), the display info and the m6502_t
+    CPU state (see chips_observation_t in chips_common.h). The vblank
+    callback in atom_desc_t is invoked when the MC6847 starts a new frame.
+
     ## TODO
 
     - handle shift key (some games use this as jump button)
@@ -67,7 +81,7 @@ extern "C" {
 #endif
 
 // bump snapshot version when memory layout of atom_t changes
-#define ATOM_SNAPSHOT_VERSION (1)
+#define ATOM_SNAPSHOT_VERSION (2)
 
 #define ATOM_FREQUENCY (1000000)
 #define ATOM_MAX_AUDIO_SAMPLES (1024)       // max number of audio samples in internal sample buffer
@@ -91,7 +105,9 @@ typedef enum {
 typedef struct {
     atom_joystick_type_t joystick_type;     // what joystick type to emulate, default is ATOM_JOYSTICK_NONE
     chips_debug_t debug;
+    chips_headless_t headless;              // optional headless video mode (see chips_common.h)
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank;         // optional per-frame callback (see 'Observation')
     struct {
         chips_range_t abasic;
         chips_range_t afloat;
@@ -107,7 +123,11 @@ typedef struct {
     m6522_t via;
     beeper_t beeper;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
+    uint64_t frame_us_rem;      // fractional remainder of the ticks-to-us conversion in atom_exec_frame()
     bool valid;
     int counter_2_4khz;
     int period_2_4khz;
@@ -126,6 +146,7 @@ typedef struct {
         float sample_buffer[ATOM_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[0xA000];
+    chips_page_hashes_t ram_hashes;     // cached RAM page hashes for atom_state_hash()
     uint8_t rom_abasic[0x2000];
     uint8_t rom_afloat[0x1000];
     uint8_t rom_dosrom[0x1000];
@@ -146,8 +167,12 @@ void atom_discard(atom_t* sys);
 void atom_reset(atom_t* sys);
 // query display information, can be called with nullptr
 chips_display_info_t atom_display_info(atom_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t atom_observe(atom_t* sys);
 // run Atom instance for a number of microseconds
 uint32_t atom_exec(atom_t* sys, uint32_t micro_seconds);
+// run the emulation until the end of the current video frame, returns number of ticks
+uint32_t atom_exec_frame(atom_t* sys);
 // send a key down event
 void atom_key_down(atom_t* sys, int key_code);
 // send a key up event
@@ -166,6 +191,8 @@ void atom_remove_tape(atom_t* sys);
 uint32_t atom_save_snapshot(atom_t* sys, atom_t* dst);
 // load snapshot, returns false if snapshot version doesn't match
 bool atom_load_snapshot(atom_t* sys, uint32_t version, atom_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t atom_state_hash(atom_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -181,7 +208,6 @@ bool atom_load_snapshot(atom_t* sys, uint32_t version, atom_t* src);
 
 #define _ATOM_ROM_DOSROM_SIZE (0x1000)
 
-static uint64_t _atom_vdg_fetch(uint64_t pins, void* user_data);
 static void _atom_init_keymap(atom_t* sys);
 static void _atom_init_memorymap(atom_t* sys);
 static uint64_t _atom_osload(atom_t* sys, uint64_t pins);
@@ -198,6 +224,8 @@ void atom_init(atom_t* sys, const atom_desc_t* desc) {
     sys->audio.num_samples = _ATOM_DEFAULT(desc->audio.num_samples, ATOM_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= ATOM_MAX_AUDIO_SAMPLES);
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
     sys->period_2_4khz = ATOM_FREQUENCY / 4800;
 
     // copy ROM fonts
@@ -216,8 +244,22 @@ void atom_init(atom_t* sys, const atom_desc_t* desc) {
             .ptr = &sys->fb,
             .size = sizeof(sys->fb),
         },
-        .fetch_cb = _atom_vdg_fetch,
-        .user_data = sys,
+        // video memory is at 0x8000 in the CPU address range
+        .vidmem = {
+            .ptr = &sys->ram[0x8000],
+            .size = 0x2000,
+        },
+        /*  the upper 2 databus bits are directly wired to MC6847 pins:
+            bit 7 -> INV pin (in text mode, invert pixel pattern)
+            bit 6 -> A/S and INT/EXT pin, A/S actives semigraphics mode
+                     and INT/EXT selects the 2x3 semigraphics pattern
+                     (so 4x4 semigraphics isn't possible)
+        */
+        .data_pins = {
+            .inv = (1<<7),
+            .as = (1<<6),
+            .intext = (1<<6),
+        },
     });
     i8255_init(&sys->ppi);
     m6522_init(&sys->via);
@@ -249,6 +291,7 @@ void atom_reset(atom_t* sys) {
 }
 
 uint64_t _atom_tick(atom_t* sys, uint64_t cpu_pins) {
+    sys->tick++;
     // tick the CPU
     cpu_pins = m6502_tick(&sys->cpu, cpu_pins);
 
@@ -262,13 +305,7 @@ uint64_t _atom_tick(atom_t* sys, uint64_t cpu_pins) {
     // update beeper
     if (beeper_tick(&sys->beeper)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
-        }
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->beeper.sample, sys->tick);
     }
 
     // address decoding
@@ -392,6 +429,7 @@ uint64_t _atom_tick(atom_t* sys, uint64_t cpu_pins) {
        so no point in looking at the returned pin mask
     */
     mc6847_tick(&sys->vdg, vdg_pins);
+    chips_vblank_update(&sys->vblank, sys->vdg.frame_count);
 
     /* check if the trapped OSLoad function was hit to implement tape file loading
         http://ladybug.xs4all.nl/arlet/fpga/6502/kernel.dis
@@ -406,45 +444,49 @@ uint64_t _atom_tick(atom_t* sys, uint64_t cpu_pins) {
     return cpu_pins;
 }
 
-uint32_t atom_exec(atom_t* sys, uint32_t micro_seconds) {
-    CHIPS_ASSERT(sys && sys->valid);
-    uint32_t num_ticks = clk_us_to_ticks(ATOM_FREQUENCY, micro_seconds);
+// run for num_ticks, or until the VDG starts a new frame if to_frame_end is true
+static uint32_t _atom_run(atom_t* sys, uint32_t num_ticks, bool to_frame_end) {
+    const uint32_t frame_count = sys->vdg.frame_count;
     uint64_t pins = sys->pins;
+    uint32_t ticks = 0;
     if (0 == sys->debug.callback.func) {
         // run without debug hook
-        for (uint32_t ticks = 0; ticks < num_ticks; ticks++) {
+        for (; (ticks < num_ticks) && (!to_frame_end || (frame_count == sys->vdg.frame_count)); ticks++) {
             pins = _atom_tick(sys, pins);
         }
     }
     else {
-        // run with debug hook]
-        for (uint32_t ticks = 0; (ticks < num_ticks) && !(*sys->debug.stopped); ticks++) {
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
+        for (; (ticks < num_ticks) && (!to_frame_end || (frame_count == sys->vdg.frame_count)) && !(*sys->debug.stopped); ticks++) {
             pins = _atom_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, M6502_GET_ADDR(pins), pins & M6502_SYNC, pins & M6502_RW, !(pins & M6502_RW))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    return ticks;
+}
+
+uint32_t atom_exec(atom_t* sys, uint32_t micro_seconds) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->vdg.headless = chips_headless_update(&sys->headless);
+    uint32_t num_ticks = clk_us_to_ticks(ATOM_FREQUENCY, micro_seconds);
+    _atom_run(sys, num_ticks, false);
     kbd_update(&sys->kbd, micro_seconds);
     return num_ticks;
 }
 
-uint64_t _atom_vdg_fetch(uint64_t pins, void* user_data) {
-    atom_t* sys = (atom_t*) user_data;
-    const uint16_t addr = MC6847_GET_ADDR(pins);
-    uint8_t data = sys->ram[(addr + 0x8000) & 0xFFFF];
-    MC6847_SET_DATA(pins, data);
-
-    /*  the upper 2 databus bits are directly wired to MC6847 pins:
-        bit 7 -> INV pin (in text mode, invert pixel pattern)
-        bit 6 -> A/S and INT/EXT pin, A/S actives semigraphics mode
-                 and INT/EXT selects the 2x3 semigraphics pattern
-                 (so 4x4 semigraphics isn't possible)
-    */
-    if (data & (1<<7)) { pins |= MC6847_INV; }
-    else               { pins &= ~MC6847_INV; }
-    if (data & (1<<6)) { pins |= (MC6847_AS|MC6847_INTEXT); }
-    else               { pins &= ~(MC6847_AS|MC6847_INTEXT); }
-    return pins;
+uint32_t atom_exec_frame(atom_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->vdg.headless = chips_headless_update(&sys->headless);
+    // safety limit of two NTSC frames
+    const uint32_t max_ticks = clk_us_to_ticks(ATOM_FREQUENCY, 2 * 16667);
+    const uint32_t num_ticks = _atom_run(sys, max_ticks, true);
+    kbd_update(&sys->kbd, clk_ticks_to_us(ATOM_FREQUENCY, num_ticks, &sys->frame_us_rem));
+    return num_ticks;
 }
 
 void atom_key_down(atom_t* sys, int key_code) {
@@ -659,9 +701,8 @@ uint64_t _atom_osload(atom_t* sys, uint64_t pins) {
                 addr = mem_rd16(&sys->mem, 0xCB);
             }
             if ((sys->tape.pos + hdr->length) <= sys->tape.size) {
-                for (int i = 0; i < hdr->length; i++) {
-                    mem_wr(&sys->mem, addr++, sys->tape.buf[sys->tape.pos++]);
-                }
+                mem_write_range(&sys->mem, addr, &sys->tape.buf[sys->tape.pos], hdr->length);
+                sys->tape.pos += hdr->length;
                 success = true;
             }
         }
@@ -705,6 +746,8 @@ chips_display_info_t atom_display_info(atom_t* sys) {
                 .height = MC6847_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->vdg.dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = MC6847_FRAMEBUFFER_SIZE_BYTES,
@@ -726,10 +769,23 @@ chips_display_info_t atom_display_info(atom_t* sys) {
     return res;
 }
 
+chips_observation_t atom_observe(atom_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .display = atom_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_M6502, .state = &sys->cpu },
+    };
+}
+
 uint32_t atom_save_snapshot(atom_t* sys, atom_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     m6502_snapshot_onsave(&dst->cpu);
     mc6847_snapshot_onsave(&dst->vdg);
@@ -745,12 +801,43 @@ bool atom_load_snapshot(atom_t* sys, uint32_t version, atom_t* src) {
     static atom_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     m6502_snapshot_onload(&im.cpu, &sys->cpu);
     mc6847_snapshot_onload(&im.vdg, &sys->vdg);
     mem_snapshot_onload(&im.mem, sys);
+    chips_dirty_lines_set_all(&im.vdg.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
     *sys = im;
     return true;
 }
 
+uint64_t atom_state_hash(atom_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != sys->ram) {
+        mem_track_dirty(&sys->mem, sys->ram, sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = m6502_hash(&sys->cpu, h);
+    h = mc6847_hash(&sys->vdg, h);
+    h = CHIPS_HASH(h, sys->ppi);
+    h = CHIPS_HASH(h, sys->via);
+    h = CHIPS_HASH(h, sys->beeper);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->counter_2_4khz);
+    h = CHIPS_HASH(h, sys->state_2_4khz);
+    h = CHIPS_HASH(h, sys->kbd_joymask);
+    h = CHIPS_HASH(h, sys->joy_joymask);
+    h = CHIPS_HASH(h, sys->mmc_cmd);
+    h = CHIPS_HASH(h, sys->mmc_latch);
+    h = CHIPS_HASH(h, sys->tape.size);
+    h = CHIPS_HASH(h, sys->tape.pos);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return h;
+}
+
 #endif /* CHIPS_IMPL */
@@ -33,6 +33,34 @@
         - https://floooh.github.io/2018/10/06/bombjack.html
         - https://github.com/floooh/emu-info/blob/master/misc/bombjack-schematics.pdf
 
+    ## Decoupled Boards
+
+    By default, bombjack_exec() runs the main board and the sound board
+    interleaved in half-frame slices. The main board only talks to the sound
+    board through the sound latch, so with `bombjack_desc_t.decoupled` set,
+    each board instead runs for the whole bombjack_exec() slice on its own:
+    the main board records its sound latch writes with a tick timestamp, and
+    the sound board then replays them at the same (scaled) point in time of
+    its slice, so each command arrives at the right time even when the main
+    board writes several commands in one slice (up to BOMBJACK_MAX_LATCH_WRITES,
+    after that the last queued write is replaced). The main board never
+    reads back from the sound board, so no other synchronization is needed.
+
+    ## State Hash
+
+    bombjack_state_hash() hashes the state of both boards (CPUs, sound
+    chips, IO registers, palette), the sound latch and the main and sound
+    RAM, for instance to detect when two emulator instances diverge.
+
+    ## Observation
+
+    bombjack_observe() returns pointers to the main board RAM ("main_ram",
+    0x8000..0x9BFF including video, color and sprite RAM) and the sound
+    board RAM ("sound_ram"), the display info and the main board's z80_t
+    CPU state (see chips_observation_t in chips_common.h). The vblank
+    callback in bombjack_desc_t is invoked at the start of the main board's
+    vertical blanking interval.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -61,10 +89,11 @@ extern "C" {
 #endif
 
 // increase when bombjack_t memory layout changes
-#define BOMBJACK_SNAPSHOT_VERSION (2)
+#define BOMBJACK_SNAPSHOT_VERSION (3)
 
 #define BOMBJACK_MAX_AUDIO_SAMPLES (1024)
 #define BOMBJACK_DEFAULT_AUDIO_SAMPLES (128)
+#define BOMBJACK_MAX_LATCH_WRITES (16)    // max number of queued sound latch writes per slice (see 'Decoupled Boards')
 #define BOMBJACK_FRAMEBUFFER_WIDTH (256)
 #define BOMBJACK_FRAMEBUFFER_HEIGHT (288) // save space for sprites
 #define BOMBJACK_FRAMEBUFFER_SIZE_BYTES (BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_FRAMEBUFFER_HEIGHT * 4)
@@ -141,6 +170,9 @@ typedef struct {
 // configuration parameters for bombjack_init()
 typedef struct {
     bombjack_debug_t debug;
+    chips_headless_t headless;  // optional headless video mode (see chips_common.h)
+    bool decoupled;             // run each board for a whole slice (see 'Decoupled Boards')
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
     chips_audio_desc_t audio;
     struct {
         chips_range_t main_0000_1FFF;    // main-board ROM 0x0000..0x1FFF
@@ -178,6 +210,7 @@ typedef struct {
         mem_t mem;
         uint32_t palette[128];
         uint64_t pins;
+        uint64_t tick;          // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     } mainboard;
     struct {
         z80_t cpu;
@@ -186,8 +219,18 @@ typedef struct {
         int vsync_count;
         mem_t mem;
         uint64_t pins;
+        uint64_t tick;          // free-running sound board tick counter
     } soundboard;
     uint8_t sound_latch;        // shared latch, written by main board, read by sound board
+    struct {
+        bool decoupled;         // see 'Decoupled Boards'
+        uint32_t tick;          // main board tick in the current slice
+        int num;                // number of queued latch writes
+        struct {
+            uint32_t tick;
+            uint8_t data;
+        } writes[BOMBJACK_MAX_LATCH_WRITES];
+    } latch;
 
     bool valid;
 
@@ -208,6 +251,9 @@ typedef struct {
         float sample_buffer[BOMBJACK_MAX_AUDIO_SAMPLES];
     } audio;
 
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
+
     struct {
         bombjack_debug_t debug;
         bool draw_background_layer;
@@ -216,6 +262,10 @@ typedef struct {
         bool clear_background_layer;
     } dbg;
 
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
+    uint64_t row_hashes[BOMBJACK_FRAMEBUFFER_HEIGHT];   // framebuffer row hashes of the previous frame
+    bool bg_cache_valid;    // cleared when the background image or the tile/map ROMs change
+    uint8_t bg_cache[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT];  // background layer as palette indices
     alignas(64) uint32_t fb[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_FRAMEBUFFER_HEIGHT];
 } bombjack_t;
 
@@ -227,12 +277,16 @@ void bombjack_discard(bombjack_t* sys);
 void bombjack_reset(bombjack_t* sys);
 // query display attributes and framebuffer content (can be called with nullptr)
 chips_display_info_t bombjack_display_info(bombjack_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t bombjack_observe(bombjack_t* sys);
 // run bombjack instance for given amount of microseconds
 uint32_t bombjack_exec(bombjack_t* sys, uint32_t micro_seconds);
 // take a snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t bombjack_save_snapshot(bombjack_t* sys, bombjack_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t bombjack_state_hash(bombjack_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -262,6 +316,10 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
     memset(sys, 0, sizeof(bombjack_t));
     sys->valid = true;
     sys->dbg.debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    sys->latch.decoupled = desc->decoupled;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
     sys->dbg.draw_background_layer = true;
     sys->dbg.draw_foreground_layer = true;
     sys->dbg.draw_sprite_layer = true;
@@ -328,6 +386,7 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
         .tick_hz = 1500000,
         .sound_hz = _bombjack_def(desc->audio.sample_rate, 44100),
         .magnitude = 0.2f,
+        .lazy = true,
     };
     for (size_t i = 0; i < 3; i++) {
         ay38910_init(&sys->soundboard.psg[i], &psg_desc);
@@ -481,12 +540,25 @@ static inline void _bombjack_update_palette_cache(bombjack_t* sys, uint16_t addr
     B800:       sound command latch,
 
 */
+// record a sound latch write for the sound board (see 'Decoupled Boards')
+static void _bombjack_latch_queue(bombjack_t* sys, uint8_t data) {
+    if (sys->latch.num == BOMBJACK_MAX_LATCH_WRITES) {
+        // queue full, the last write is overwritten just like the latch itself
+        sys->latch.num--;
+    }
+    sys->latch.writes[sys->latch.num].tick = sys->latch.tick;
+    sys->latch.writes[sys->latch.num].data = data;
+    sys->latch.num++;
+}
+
 static uint64_t _bombjack_tick_mainboard(bombjack_t* sys, uint64_t pins) {
+    sys->mainboard.tick++;
     // activate NMI pin during VBLANK
     sys->mainboard.vsync_count--;
     if (sys->mainboard.vsync_count < 0) {
         sys->mainboard.vsync_count += _BOMBJACK_VSYNC_PERIOD_4MHZ;
         sys->mainboard.vblank_count = _BOMBJACK_VBLANK_DURATION_4MHZ;
+        chips_vblank_notify(&sys->vblank);
     }
     if (sys->mainboard.vblank_count != 0) {
         sys->mainboard.vblank_count--;
@@ -503,6 +575,7 @@ static uint64_t _bombjack_tick_mainboard(bombjack_t* sys, uint64_t pins) {
 
     // tick the CPU
     pins = z80_tick(&sys->mainboard.cpu, pins);
+    sys->latch.tick++;
 
     /* handle memory requests
 
@@ -525,7 +598,10 @@ static uint64_t _bombjack_tick_mainboard(bombjack_t* sys, uint64_t pins) {
             }
             else if (addr == 0x9E00) {
                 // background image selection
-                sys->mainboard.bg_image = data;
+                if (data != sys->mainboard.bg_image) {
+                    sys->mainboard.bg_image = data;
+                    sys->bg_cache_valid = false;
+                }
             }
             else if (addr == 0xB000) {
                 // NMI mask
@@ -534,7 +610,12 @@ static uint64_t _bombjack_tick_mainboard(bombjack_t* sys, uint64_t pins) {
             // FIXME: 0xB004: flip screen
             else if (addr == 0xB800) {
                 // shared sound latch
-                sys->sound_latch = data;
+                if (sys->latch.decoupled) {
+                    _bombjack_latch_queue(sys, data);
+                }
+                else {
+                    sys->sound_latch = data;
+                }
             }
         }
         else if (pins & Z80_RD) {
@@ -591,6 +672,7 @@ static uint64_t _bombjack_tick_mainboard(bombjack_t* sys, uint64_t pins) {
     80 .. 81:       3rd AY-3-8910
 */
 static uint64_t _bombjack_tick_soundboard(bombjack_t* sys, uint64_t pins) {
+    sys->soundboard.tick++;
     /* vsync triggers a flip-flop connected to the CPU's NMI, the flip-flop
        is reset on a read from address 0x6000 (this read happens in the
        interrupt service routine
@@ -657,13 +739,9 @@ static uint64_t _bombjack_tick_soundboard(bombjack_t* sys, uint64_t pins) {
             float s = sys->soundboard.psg[0].sample +
                       sys->soundboard.psg[1].sample +
                       sys->soundboard.psg[2].sample;
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = s * sys->audio.volume;
-            if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
-                sys->audio.sample_pos = 0;
-            }
+            // timestamp in main board ticks (4 MHz vs 3 MHz)
+            const uint64_t tick = (sys->soundboard.tick * 4) / 3;
+            chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, s * sys->audio.volume, tick);
         }
     }
     return pins;
@@ -729,8 +807,9 @@ static uint64_t _bombjack_tick_soundboard(bombjack_t* sys, uint64_t pins) {
 #define BOMBJACK_GATHER16(rom,off) \
     ((uint16_t)rom[0+off]<<8)|((uint16_t)rom[8+off])
 
-static void _bombjack_decode_background(bombjack_t* sys) {
-    uint32_t* ptr = sys->fb;
+// render the background image into the palette-index cache
+static void _bombjack_update_background_cache(bombjack_t* sys) {
+    uint8_t* ptr = sys->bg_cache;
     uint16_t img_base_addr = (sys->mainboard.bg_image & 7) * 0x0200;
     bool img_valid = (sys->mainboard.bg_image & 0x10) != 0;
     for (size_t y = 0; y < 16; y++) {
@@ -756,7 +835,7 @@ static void _bombjack_decode_background(bombjack_t* sys) {
                 }
                 for (int xx = 15; xx >= 0; xx--) {
                     uint8_t pen = ((bm2>>xx)&1) | (((bm1>>xx)&1)<<1) | (((bm0>>xx)&1)<<2);
-                    *ptr++ = sys->mainboard.palette[color_block | pen];
+                    *ptr++ = color_block | pen;
                 }
                 ptr += flip_y ? -272 : 240;
             }
@@ -769,7 +848,20 @@ static void _bombjack_decode_background(bombjack_t* sys) {
         }
         ptr += (15 * BOMBJACK_FRAMEBUFFER_WIDTH);
     }
-    CHIPS_ASSERT(ptr == &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT]);
+    CHIPS_ASSERT(ptr == &sys->bg_cache[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT]);
+    sys->bg_cache_valid = true;
+}
+
+// the background only changes with the background image, so only the palette lookup is done per frame
+static void _bombjack_decode_background(bombjack_t* sys) {
+    if (!sys->bg_cache_valid) {
+        _bombjack_update_background_cache(sys);
+    }
+    const uint8_t* src = sys->bg_cache;
+    uint32_t* dst = sys->fb;
+    for (size_t i = 0; i < BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT; i++) {
+        dst[i] = sys->mainboard.palette[src[i]];
+    }
 }
 
 /* render foreground tiles
@@ -957,10 +1049,106 @@ static void _bombjack_decode_video(bombjack_t* sys) {
     if (sys->dbg.draw_sprite_layer) {
         _bombjack_decode_sprites(sys);
     }
+    // the whole frame is redrawn, compare row hashes to find the changed rows
+    chips_dirty_lines_update_hashed(&sys->dirty_lines, sys->row_hashes, sys->fb, BOMBJACK_FRAMEBUFFER_WIDTH * sizeof(uint32_t), BOMBJACK_FRAMEBUFFER_HEIGHT);
+}
+
+// run the main board for a number of ticks
+static void _bombjack_exec_mainboard(bombjack_t* sys, uint32_t num_ticks) {
+    uint64_t pins = sys->mainboard.pins;
+    if (0 == sys->dbg.debug.mainboard.callback.func) {
+        // run without debug callback
+        for (uint32_t tick = 0; tick < num_ticks; tick++) {
+            pins = _bombjack_tick_mainboard(sys, pins);
+        }
+    }
+    else {
+        // run with debug callback, if a breakpoint map is attached, only
+        // call the debug callback when a breakpoint is hit
+        const chips_breakmap_t* map = sys->dbg.debug.mainboard.breakmap;
+        for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->dbg.debug.mainboard.stopped); tick++) {
+            pins = _bombjack_tick_mainboard(sys, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->mainboard.cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->dbg.debug.mainboard.callback.func(sys->dbg.debug.mainboard.callback.user_data, pins);
+            }
+        }
+    }
+    sys->mainboard.pins = pins;
+}
+
+// run the sound board for a number of ticks, returns false if stopped in the debugger
+static bool _bombjack_exec_soundboard(bombjack_t* sys, uint32_t num_ticks) {
+    uint64_t pins = sys->soundboard.pins;
+    bool running = true;
+    if (0 == sys->dbg.debug.soundboard.callback.func) {
+        // run without debug callback
+        for (uint32_t tick = 0; tick < num_ticks; tick++) {
+            pins = _bombjack_tick_soundboard(sys, pins);
+        }
+    }
+    else {
+        // run with debug callback, if a breakpoint map is attached, only
+        // call the debug callback when a breakpoint is hit
+        const chips_breakmap_t* map = sys->dbg.debug.soundboard.breakmap;
+        for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->dbg.debug.soundboard.stopped); tick++) {
+            pins = _bombjack_tick_soundboard(sys, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->soundboard.cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->dbg.debug.soundboard.callback.func(sys->dbg.debug.soundboard.callback.user_data, pins);
+            }
+        }
+        running = !(*sys->dbg.debug.soundboard.stopped);
+    }
+    sys->soundboard.pins = pins;
+    return running;
+}
+
+/* run the sound board for a whole slice, and apply the latch writes
+   which were queued by the main board at the same relative point in time
+*/
+static void _bombjack_exec_soundboard_decoupled(bombjack_t* sys, uint32_t mb_num_ticks, uint32_t sb_num_ticks) {
+    uint32_t tick = 0;
+    int i = 0;
+    bool running = true;
+    for (; running && (i < sys->latch.num); i++) {
+        const uint32_t at = (uint32_t)(((uint64_t)sys->latch.writes[i].tick * sb_num_ticks) / mb_num_ticks);
+        if (at > tick) {
+            running = _bombjack_exec_soundboard(sys, at - tick);
+            tick = at;
+        }
+        sys->sound_latch = sys->latch.writes[i].data;
+    }
+    if (running) {
+        if (tick < sb_num_ticks) {
+            _bombjack_exec_soundboard(sys, sb_num_ticks - tick);
+        }
+    }
+    else if (i < sys->latch.num) {
+        // stopped in the debugger, leave the most recent command in the latch
+        sys->sound_latch = sys->latch.writes[sys->latch.num - 1].data;
+    }
+    sys->latch.num = 0;
 }
 
 uint32_t bombjack_exec(bombjack_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
+    chips_headless_update(&sys->headless);
+    if (sys->latch.decoupled) {
+        // run each board for the whole slice (see 'Decoupled Boards')
+        const uint32_t mb_num_ticks = clk_us_to_ticks(_BOMBJACK_MAINBOARD_FREQUENCY, micro_seconds);
+        const uint32_t sb_num_ticks = clk_us_to_ticks(_BOMBJACK_SOUNDBOARD_FREQUENCY, micro_seconds);
+        sys->latch.tick = 0;
+        sys->latch.num = 0;
+        _bombjack_exec_mainboard(sys, mb_num_ticks);
+        if (mb_num_ticks > 0) {
+            _bombjack_exec_soundboard_decoupled(sys, mb_num_ticks, sb_num_ticks);
+        }
+        if (!sys->headless.skip) {
+            _bombjack_decode_video(sys);
+        }
+        return mb_num_ticks + sb_num_ticks;
+    }
     /* Run the main board and sound board interleaved for half a frame.
        This simplifies the communication via the sound latch (the main CPU
        writes a command byte to the sound latch, the sound board reads
@@ -983,43 +1171,13 @@ uint32_t bombjack_exec(bombjack_t* sys, uint32_t micro_seconds) {
     const uint32_t sb_num_ticks = clk_us_to_ticks(_BOMBJACK_SOUNDBOARD_FREQUENCY, slice_us);
     for (size_t i = 0; i < 2; i++) {
         // tick the main board for one half frame
-        {
-            uint64_t pins = sys->mainboard.pins;
-            if (0 == sys->dbg.debug.mainboard.callback.func) {
-                // run without debug callback
-                for (uint32_t tick = 0; tick < mb_num_ticks; tick++) {
-                    pins = _bombjack_tick_mainboard(sys, pins);
-                }
-            }
-            else {
-                // run with debug callback
-                for (uint32_t tick = 0; (tick < mb_num_ticks) && !(*sys->dbg.debug.mainboard.stopped); tick++) {
-                    pins = _bombjack_tick_mainboard(sys, pins);
-                    sys->dbg.debug.mainboard.callback.func(sys->dbg.debug.mainboard.callback.user_data, pins);
-                }
-            }
-            sys->mainboard.pins = pins;
-        }
+        _bombjack_exec_mainboard(sys, mb_num_ticks);
         // tick the sound board for one half frame
-        {
-            uint64_t pins = sys->soundboard.pins;
-            if (0 == sys->dbg.debug.soundboard.callback.func) {
-                // run without debug callback
-                for (uint32_t tick = 0; tick < sb_num_ticks; tick++) {
-                    pins = _bombjack_tick_soundboard(sys, pins);
-                }
-            }
-            else {
-                // run with debug callback
-                for (uint32_t tick = 0; (tick < sb_num_ticks) && !(*sys->dbg.debug.soundboard.stopped); tick++) {
-                    pins = _bombjack_tick_soundboard(sys, pins);
-                    sys->dbg.debug.soundboard.callback.func(sys->dbg.debug.soundboard.callback.user_data, pins);
-                }
-            }
-            sys->soundboard.pins = pins;
-        }
+        _bombjack_exec_soundboard(sys, sb_num_ticks);
+    }
+    if (!sys->headless.skip) {
+        _bombjack_decode_video(sys);
     }
-    _bombjack_decode_video(sys);
     return 2 * (mb_num_ticks + sb_num_ticks);
 }
 
@@ -1031,6 +1189,8 @@ chips_display_info_t bombjack_display_info(bombjack_t* sys) {
                 .height = BOMBJACK_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 4,
+            .tick = sys ? sys->mainboard.tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = BOMBJACK_FRAMEBUFFER_SIZE_BYTES,
@@ -1048,11 +1208,25 @@ chips_display_info_t bombjack_display_info(bombjack_t* sys) {
     return res;
 }
 
+chips_observation_t bombjack_observe(bombjack_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 2,
+        .ram = {
+            { .name = "main_ram", .mem = { .ptr = sys->main_ram, .size = sizeof(sys->main_ram) } },
+            { .name = "sound_ram", .mem = { .ptr = sys->sound_ram, .size = sizeof(sys->sound_ram) } },
+        },
+        .display = bombjack_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->mainboard.cpu },
+    };
+}
+
 uint32_t bombjack_save_snapshot(bombjack_t* sys, bombjack_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->dbg.debug.mainboard);
     chips_debug_snapshot_onsave(&dst->dbg.debug.soundboard);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     for (size_t i = 0; i < 3; i++) {
         ay38910_snapshot_onsave(&dst->soundboard.psg[i]);
@@ -1071,14 +1245,46 @@ bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src)
     im = *src;
     chips_debug_snapshot_onload(&im.dbg.debug.mainboard, &sys->dbg.debug.mainboard);
     chips_debug_snapshot_onload(&im.dbg.debug.soundboard, &sys->dbg.debug.soundboard);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
+    im.latch.decoupled = sys->latch.decoupled;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     for (size_t i = 0; i < 3; i++) {
         ay38910_snapshot_onload(&im.soundboard.psg[i], &sys->soundboard.psg[i]);
     }
     mem_snapshot_onload(&im.mainboard.mem, sys);
     mem_snapshot_onload(&im.soundboard.mem, sys);
+    chips_dirty_lines_set_all(&im.dirty_lines);
     *sys = im;
     return true;
 }
 
+uint64_t bombjack_state_hash(bombjack_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->mainboard.cpu);
+    h = CHIPS_HASH(h, sys->mainboard.p1);
+    h = CHIPS_HASH(h, sys->mainboard.p2);
+    h = CHIPS_HASH(h, sys->mainboard.sys);
+    h = CHIPS_HASH(h, sys->mainboard.dsw1);
+    h = CHIPS_HASH(h, sys->mainboard.dsw2);
+    h = CHIPS_HASH(h, sys->mainboard.nmi_mask);
+    h = CHIPS_HASH(h, sys->mainboard.bg_image);
+    h = CHIPS_HASH(h, sys->mainboard.vsync_count);
+    h = CHIPS_HASH(h, sys->mainboard.vblank_count);
+    h = CHIPS_HASH(h, sys->mainboard.palette);
+    h = CHIPS_HASH(h, sys->mainboard.pins);
+    h = CHIPS_HASH(h, sys->soundboard.cpu);
+    for (size_t i = 0; i < 3; i++) {
+        h = ay38910_hash(&sys->soundboard.psg[i], h);
+    }
+    h = CHIPS_HASH(h, sys->soundboard.tick_count);
+    h = CHIPS_HASH(h, sys->soundboard.vsync_count);
+    h = CHIPS_HASH(h, sys->soundboard.pins);
+    h = CHIPS_HASH(h, sys->sound_latch);
+    h = CHIPS_HASH(h, sys->main_ram);
+    h = CHIPS_HASH(h, sys->sound_ram);
+    return h;
+}
+
 #endif // CHIPS_IMPL
@@ -67,6 +67,27 @@
     The motor may also be switched on/off by the computer system through
     the cassette port's MOTOR pin.
 
+    ## KERNAL Tape Format
+
+    For tape load traps, c1530_read_block() decodes the next data block
+    in the standard Commodore KERNAL encoding directly from the TAP pulses
+    (starting at the current tape position):
+
+    - a pilot tone of short pulses
+    - each byte starts with a (long, medium) marker followed by 8 data bits
+      (LSB first) and an odd-parity check bit, each bit is a pulse pair,
+      (short, medium) for a 0 bit and (medium, short) for a 1 bit
+    - the first 9 bytes of a block are the countdown sequence 89..81 (or
+      09..01 for the repeated copy of the block), and the last byte
+      is the XOR checksum of the data bytes
+    - the block ends with a (long, short) marker
+
+    c1530_read_block() returns the number of data bytes (not including
+    the countdown and checksum), or -1 if no valid block could be decoded.
+    The tape position is advanced past the block, callers which want
+    to fall back to regular playback should save and restore
+    c1530_t.pos around the call.
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -138,10 +159,16 @@ void c1530_play(c1530_t* sys);
 void c1530_stop(c1530_t* sys);
 /* return true if tape motor is on */
 bool c1530_is_motor_on(c1530_t* sys);
+/* decode the next KERNAL-format block into buf (may be 0), returns number of data bytes or -1 */
+int c1530_read_block(c1530_t* sys, uint8_t* buf, int buf_size, bool* out_repeat);
 // prepare c1530_t snapshot for saving
 void c1530_snapshot_onsave(c1530_t* snapshot);
 // fixup c1530_t snapshot after loading
 void c1530_snapshot_onload(c1530_t* snapshot, c1530_t* sys);
+// copy the tape state from src into dst (only the used part of the tape image is copied)
+void c1530_copy_state(c1530_t* dst, const c1530_t* src);
+// continue a state hash with the tape position (the tape image isn't hashed)
+uint64_t c1530_hash(const c1530_t* sys, uint64_t h);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -269,6 +296,145 @@ void c1530_tick(c1530_t* sys) {
     }
 }
 
+/* pulse lengths of the KERNAL tape encoding (in TAP units of 8 cycles) */
+#define _C1530_PULSE_SHORT  (0)
+#define _C1530_PULSE_MEDIUM (1)
+#define _C1530_PULSE_LONG   (2)
+#define _C1530_PULSE_PAUSE  (3)
+#define _C1530_PULSE_END    (4)
+#define _C1530_MIN_PILOT    (64)
+
+/* read and classify the next pulse */
+static int _c1530_read_pulse(c1530_t* sys) {
+    if (sys->pos >= sys->size) {
+        return _C1530_PULSE_END;
+    }
+    uint32_t len = sys->buf[sys->pos++];
+    if (len == 0) {
+        if ((sys->pos + 3) > sys->size) {
+            sys->pos = sys->size;
+            return _C1530_PULSE_END;
+        }
+        len = sys->buf[sys->pos] | (sys->buf[sys->pos + 1]<<8) | (sys->buf[sys->pos + 2]<<16);
+        len /= 8;
+        sys->pos += 3;
+    }
+    if (len < 0x39) {
+        return _C1530_PULSE_SHORT;
+    }
+    else if (len < 0x4C) {
+        return _C1530_PULSE_MEDIUM;
+    }
+    else if (len < 0x70) {
+        return _C1530_PULSE_LONG;
+    }
+    else {
+        return _C1530_PULSE_PAUSE;
+    }
+}
+
+/* read the 8 data bits and check bit of a byte, returns -1 on error */
+static int _c1530_read_byte(c1530_t* sys) {
+    int data = 0;
+    int check = 1;
+    for (int i = 0; i < 9; i++) {
+        const int p0 = _c1530_read_pulse(sys);
+        const int p1 = _c1530_read_pulse(sys);
+        int bit;
+        if ((p0 == _C1530_PULSE_SHORT) && (p1 == _C1530_PULSE_MEDIUM)) {
+            bit = 0;
+        }
+        else if ((p0 == _C1530_PULSE_MEDIUM) && (p1 == _C1530_PULSE_SHORT)) {
+            bit = 1;
+        }
+        else {
+            return -1;
+        }
+        if (i < 8) {
+            data |= bit << i;
+            check ^= bit;
+        }
+        else if (bit != check) {
+            return -1;
+        }
+    }
+    return data;
+}
+
+int c1530_read_block(c1530_t* sys, uint8_t* buf, int buf_size, bool* out_repeat) {
+    CHIPS_ASSERT(sys && sys->valid && out_repeat);
+    *out_repeat = false;
+    // skip to the end of the next pilot tone, this also consumes the first start marker's long pulse
+    int pilot = 0;
+    for (;;) {
+        const int p = _c1530_read_pulse(sys);
+        if (p == _C1530_PULSE_END) {
+            return -1;
+        }
+        else if (p == _C1530_PULSE_SHORT) {
+            pilot++;
+        }
+        else if ((p == _C1530_PULSE_LONG) && (pilot >= _C1530_MIN_PILOT)) {
+            break;
+        }
+        else {
+            pilot = 0;
+        }
+    }
+    // read bytes until the end-of-data marker, the last byte is the checksum
+    int num_bytes = 0;
+    int num_data = 0;
+    int last = -1;
+    uint8_t checksum = 0;
+    for (;;) {
+        if ((num_bytes > 0) && (_c1530_read_pulse(sys) != _C1530_PULSE_LONG)) {
+            break;
+        }
+        const int p = _c1530_read_pulse(sys);
+        if (p == _C1530_PULSE_SHORT) {
+            break;
+        }
+        else if (p != _C1530_PULSE_MEDIUM) {
+            return -1;
+        }
+        const int data = _c1530_read_byte(sys);
+        if (data < 0) {
+            return -1;
+        }
+        if (num_bytes < 9) {
+            // countdown sequence 89..81 (first copy) or 09..01 (repeated copy)
+            if ((data & 0x7F) != (9 - num_bytes)) {
+                return -1;
+            }
+            if (num_bytes == 0) {
+                *out_repeat = 0 == (data & 0x80);
+            }
+            else if (((data & 0x80) == 0) != *out_repeat) {
+                return -1;
+            }
+        }
+        else {
+            // store the previous byte, so that the checksum isn't written to buf
+            if (last >= 0) {
+                if (buf) {
+                    if (num_data >= buf_size) {
+                        return -1;
+                    }
+                    buf[num_data] = (uint8_t)last;
+                }
+                checksum ^= (uint8_t)last;
+                num_data++;
+            }
+            last = data;
+        }
+        num_bytes++;
+    }
+    if ((last < 0) || (checksum != last)) {
+        return -1;
+    }
+    return num_data;
+}
+
 void c1530_snapshot_onsave(c1530_t* snapshot) {
     CHIPS_ASSERT(snapshot);
     snapshot->cas_port = 0;
@@ -279,4 +445,19 @@ void c1530_snapshot_onload(c1530_t* snapshot, c1530_t* sys) {
     snapshot->cas_port = sys->cas_port;
 }
 
+void c1530_copy_state(c1530_t* dst, const c1530_t* src) {
+    CHIPS_ASSERT(dst && dst->valid && src && src->valid);
+    dst->size = src->size;
+    dst->pos = src->pos;
+    dst->pulse_count = src->pulse_count;
+    memcpy(dst->buf, src->buf, src->size);
+}
+
+uint64_t c1530_hash(const c1530_t* sys, uint64_t h) {
+    CHIPS_ASSERT(sys && sys->valid);
+    h = CHIPS_HASH(h, sys->size);
+    h = CHIPS_HASH(h, sys->pos);
+    return CHIPS_HASH(h, sys->pulse_count);
+}
+
 #endif /* CHIPS_IMPL */
@@ -25,6 +25,54 @@
     - chips/m6522.h
     - chips/mem.h
 
+    ## Drive Sleep
+
+    While the drive ROM sits in its idle loop and nothing happens on the
+    IEC bus, ticking the drive CPU is wasted work. c1541_tick() detects
+    this situation (an opcode fetch inside the address range
+    C1541_IDLE_START..C1541_IDLE_END while the IEC port byte is unchanged)
+    and puts the drive to sleep. A sleeping drive only compares the
+    shared IEC port byte against the value it went to sleep with, and
+    resumes ticking at the exact instruction fetch where it stopped as soon
+    as the byte changes (or the drive is reset).
+
+    The default idle range covers the DOS 2.6 idle loop, override
+    C1541_IDLE_START and C1541_IDLE_END before including this file when
+    running a different drive ROM (setting C1541_IDLE_START above
+    C1541_IDLE_END disables drive sleep).
+
+    The number of skipped ticks is accumulated in c1541_t.sleep_ticks
+    so that time-based drive state can be caught up lazily.
+
+    ## Burst Execution
+
+    c1541_run() runs the drive for a number of ticks in one go, with the
+    IEC port byte treated as constant for the duration of the burst. This
+    gives the same result as calling c1541_tick() once per tick, as long
+    as the host system brings the drive up to date with c1541_run() before
+    each change of the shared IEC port byte. Once the drive falls asleep
+    in the middle of a burst, the rest of the burst is skipped in a single
+    step.
+
+    ## Virtual Drive
+
+    The c1541_vdrive_t is an alternative to the true-drive emulation for
+    software which only uses the regular KERNAL file API (LOAD, SAVE, OPEN,
+    CHRIN, ...) and doesn't need exact IEC timing. Instead of running the
+    drive CPU, the host system traps its KERNAL serial bus routines and
+    forwards the bus commands to the virtual drive, which serves them as a
+    minimal DOS directly on a D64 image:
+
+    - reading and writing PRG, SEQ and USR files by name (with '*' and '?'
+      wildcards, and "@0:" save-with-replace)
+    - loading the directory with "$"
+    - the command channel 15 with the DOS status message and the I, V,
+      S (scratch) and UJ commands
+
+    The D64 image is owned by the caller and must remain valid while it is
+    inserted, SAVE writes directly into the image. Fast loaders which talk
+    to the drive CPU directly won't work with the virtual drive.
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -60,10 +108,20 @@ extern "C" {
 
 #define C1541_FREQUENCY (1000000)
 
+// address range of the drive ROM idle loop (see 'Drive Sleep')
+#ifndef C1541_IDLE_START
+#define C1541_IDLE_START (0xEBFF)
+#endif
+#ifndef C1541_IDLE_END
+#define C1541_IDLE_END (0xEC9F)
+#endif
+
 // config params for c1541_init()
 typedef struct {
     // pointer to a shared byte with IEC serial bus line state
     uint8_t* iec_port;
+    // if true, map ROM pages directly from the roms buffers (no copy)
+    bool shared_roms;
     // rom images
     struct {
         chips_range_t c000_dfff;
@@ -79,9 +137,16 @@ typedef struct {
     m6522_t via_1;
     m6522_t via_2;
     bool valid;
+    bool sleeping;              // true while the drive sits in its idle loop
+    uint8_t iec_last;           // IEC port state seen by the last tick
+    uint64_t sleep_ticks;       // number of ticks skipped while sleeping
     mem_t mem;
+    bool shared_roms;           // ROM pages are mapped from caller-owned buffers
+    const uint8_t* rom_ptr[2];  // C000..DFFF and E000..FFFF ROM images
     uint8_t ram[0x0800];
+    #if !defined(CHIPS_SHARED_ROMS)
     uint8_t rom[0x4000];
+    #endif
 } c1541_t;
 
 // initialize a new c1541_t instance
@@ -92,6 +157,8 @@ void c1541_discard(c1541_t* sys);
 void c1541_reset(c1541_t* sys);
 // tick a c1541_t instance forward
 void c1541_tick(c1541_t* sys);
+// run a c1541_t instance for a number of ticks with unchanged IEC port (see 'Burst Execution')
+void c1541_run(c1541_t* sys, uint32_t num_ticks);
 // insert a disc image file (.d64)
 void c1541_insert_disc(c1541_t* sys, chips_range_t data);
 // remove current disc
@@ -100,6 +167,111 @@ void c1541_remove_disc(c1541_t* sys);
 void c1541_snapshot_onsave(c1541_t* snapshot, void* base);
 // prepare a c1541_t snapshot for loading
 void c1541_snapshot_onload(c1541_t* snapshot, c1541_t* sys, void* base);
+// copy the drive state from src into dst without the ROM images (both must be initialized identically)
+void c1541_copy_state(c1541_t* dst, void* dst_base, c1541_t* src, void* src_base);
+// continue a state hash with the drive CPU, VIA and RAM state
+uint64_t c1541_hash(const c1541_t* sys, uint64_t h);
+
+/*
+    Virtual drive (see 'Virtual Drive' in the header documentation)
+
+    A c1541_vdrive_t is a high-level stand-in for the true-drive emulation
+    which serves files straight out of a D64 disc image. It speaks the
+    IEC bus protocol at the command level: the host system intercepts its
+    serial bus primitives (LISTEN, TALK, SECOND, CIOUT, ACPTR, ...) and
+    forwards them to the c1541_vdrive_*() bus functions below, no drive
+    CPU is running at all.
+*/
+#define C1541_D64_SIZE          (174848)    // 35-track D64 image
+#define C1541_D64_SIZE_ERRORS   (175531)    // 35-track D64 image with error bytes
+#define C1541_VDRIVE_MAX_NAME   (40)        // max length of file names and DOS commands
+#define C1541_VDRIVE_NUM_CHANNELS (16)
+
+// DOS status codes of the virtual drive
+#define C1541_VDRIVE_STATUS_OK              (0)
+#define C1541_VDRIVE_STATUS_SCRATCHED       (1)
+#define C1541_VDRIVE_STATUS_SYNTAX_ERROR    (31)
+#define C1541_VDRIVE_STATUS_FILE_NOT_OPEN   (61)
+#define C1541_VDRIVE_STATUS_FILE_NOT_FOUND  (62)
+#define C1541_VDRIVE_STATUS_FILE_EXISTS     (63)
+#define C1541_VDRIVE_STATUS_DISK_FULL       (72)
+#define C1541_VDRIVE_STATUS_DOS_VERSION     (73)
+#define C1541_VDRIVE_STATUS_NOT_READY       (74)
+
+// a virtual drive channel (one per secondary address)
+typedef struct {
+    bool open;
+    bool write;             // channel was opened for writing
+    bool dir;               // channel streams a directory listing
+    bool eof;               // all data has been read
+    uint8_t track;          // current sector
+    uint8_t sector;
+    uint16_t pos;           // read/write position in current sector (or line buffer)
+    uint16_t len;           // number of valid bytes in line buffer
+    uint16_t blocks;        // number of blocks written so far
+    uint8_t entry_track;    // directory sector and entry index of the file
+    uint8_t entry_sector;   // (or the directory iteration state)
+    uint8_t entry_index;
+    uint8_t buf[40];        // directory listing line buffer
+} c1541_vchannel_t;
+
+// virtual drive state
+typedef struct {
+    bool valid;
+    uint8_t* disc;          // caller-owned D64 image (must remain valid while inserted)
+    size_t disc_size;
+    // IEC bus state
+    bool listening;
+    bool talking;
+    uint8_t cmd;            // secondary address command (0x60: data, 0xE0: close, 0xF0: open)
+    uint8_t sa;             // current secondary address
+    uint8_t name_len;       // file name or DOS command received over the bus
+    uint8_t name[C1541_VDRIVE_MAX_NAME];
+    // DOS status (read through channel 15)
+    uint8_t status;
+    uint8_t status_track;
+    uint8_t status_pos;
+    c1541_vchannel_t chn[C1541_VDRIVE_NUM_CHANNELS];
+} c1541_vdrive_t;
+
+// initialize a virtual drive
+void c1541_vdrive_init(c1541_vdrive_t* vd);
+// reset a virtual drive (closes all channels, keeps the disc inserted)
+void c1541_vdrive_reset(c1541_vdrive_t* vd);
+// insert a D64 disc image (caller-owned, written to by SAVE)
+bool c1541_vdrive_insert_disc(c1541_vdrive_t* vd, chips_range_t data);
+// remove current disc
+void c1541_vdrive_remove_disc(c1541_vdrive_t* vd);
+// return true if a disc is inserted
+bool c1541_vdrive_disc_inserted(c1541_vdrive_t* vd);
+// open a channel with a file name (or execute a DOS command on channel 15)
+bool c1541_vdrive_open(c1541_vdrive_t* vd, uint8_t sa, const uint8_t* name, int name_len);
+// close a channel
+void c1541_vdrive_close(c1541_vdrive_t* vd, uint8_t sa);
+// read next byte from a channel, returns -1 if no data, sets *eoi on the last byte
+int c1541_vdrive_read(c1541_vdrive_t* vd, uint8_t sa, bool* eoi);
+// write a byte to a channel opened for writing
+bool c1541_vdrive_write(c1541_vdrive_t* vd, uint8_t sa, uint8_t data);
+// IEC bus: the drive was addressed with LISTEN
+void c1541_vdrive_listen(c1541_vdrive_t* vd);
+// IEC bus: the drive was addressed with TALK
+void c1541_vdrive_talk(c1541_vdrive_t* vd);
+// IEC bus: secondary address after LISTEN or TALK (0x60|sa, 0xE0|sa or 0xF0|sa)
+void c1541_vdrive_second(c1541_vdrive_t* vd, uint8_t cmd);
+// IEC bus: receive a byte from the host while listening
+void c1541_vdrive_send(c1541_vdrive_t* vd, uint8_t data);
+// IEC bus: send a byte to the host while talking, returns -1 if no data
+int c1541_vdrive_receive(c1541_vdrive_t* vd, bool* eoi);
+// IEC bus: UNLISTEN
+void c1541_vdrive_unlisten(c1541_vdrive_t* vd);
+// IEC bus: UNTALK
+void c1541_vdrive_untalk(c1541_vdrive_t* vd);
+// prepare a c1541_vdrive_t snapshot for saving
+void c1541_vdrive_snapshot_onsave(c1541_vdrive_t* snapshot);
+// fixup a c1541_vdrive_t snapshot after loading
+void c1541_vdrive_snapshot_onload(c1541_vdrive_t* snapshot, c1541_vdrive_t* sys);
+// continue a state hash with the bus and channel state (the disc image isn't hashed)
+uint64_t c1541_vdrive_hash(const c1541_vdrive_t* vd, uint64_t h);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -118,12 +290,31 @@ void c1541_init(c1541_t* sys, const c1541_desc_t* desc) {
 
     memset(sys, 0, sizeof(c1541_t));
     sys->valid = true;
+    sys->iec = desc->iec_port;
+    if (sys->iec) {
+        sys->iec_last = *sys->iec;
+    }
 
-    // copy ROM images
+    // copy or share ROM images
     CHIPS_ASSERT(desc->roms.c000_dfff.ptr && (0x2000 == desc->roms.c000_dfff.size));
     CHIPS_ASSERT(desc->roms.e000_ffff.ptr && (0x2000 == desc->roms.e000_ffff.size));
-    memcpy(&sys->rom[0x0000], desc->roms.c000_dfff.ptr, 0x2000);
-    memcpy(&sys->rom[0x2000], desc->roms.e000_ffff.ptr, 0x2000);
+    #if defined(CHIPS_SHARED_ROMS)
+    sys->shared_roms = true;
+    #else
+    sys->shared_roms = desc->shared_roms;
+    #endif
+    if (sys->shared_roms) {
+        sys->rom_ptr[0] = (const uint8_t*) desc->roms.c000_dfff.ptr;
+        sys->rom_ptr[1] = (const uint8_t*) desc->roms.e000_ffff.ptr;
+    }
+    #if !defined(CHIPS_SHARED_ROMS)
+    else {
+        memcpy(&sys->rom[0x0000], desc->roms.c000_dfff.ptr, 0x2000);
+        memcpy(&sys->rom[0x2000], desc->roms.e000_ffff.ptr, 0x2000);
+        sys->rom_ptr[0] = &sys->rom[0x0000];
+        sys->rom_ptr[1] = &sys->rom[0x2000];
+    }
+    #endif
 
     // initialize the hardware
     m6502_desc_t cpu_desc;
@@ -135,7 +326,8 @@ void c1541_init(c1541_t* sys, const c1541_desc_t* desc) {
     // setup memory map
     mem_init(&sys->mem);
     mem_map_ram(&sys->mem, 0, 0x0000, 0x0800, sys->ram);
-    mem_map_rom(&sys->mem, 0, 0xC000, 0x4000, sys->rom);
+    mem_map_rom(&sys->mem, 0, 0xC000, 0x2000, sys->rom_ptr[0]);
+    mem_map_rom(&sys->mem, 0, 0xE000, 0x2000, sys->rom_ptr[1]);
 }
 
 void c1541_discard(c1541_t* sys) {
@@ -146,11 +338,24 @@ void c1541_discard(c1541_t* sys) {
 void c1541_reset(c1541_t* sys) {
     CHIPS_ASSERT(sys && sys->valid);
     sys->pins |= M6502_RES;
+    sys->sleeping = false;
     m6522_reset(&sys->via_1);
     m6522_reset(&sys->via_2);
 }
 
 void c1541_tick(c1541_t* sys) {
+    // a sleeping drive only waits for activity on the IEC port
+    const uint8_t iec = sys->iec ? *sys->iec : 0;
+    const bool iec_changed = iec != sys->iec_last;
+    sys->iec_last = iec;
+    if (sys->sleeping) {
+        if (!iec_changed) {
+            sys->sleep_ticks++;
+            return;
+        }
+        sys->sleeping = false;
+    }
+
     uint64_t pins = sys->pins;
 
     pins = m6502_tick(&sys->cpu, pins);
@@ -163,9 +368,24 @@ void c1541_tick(c1541_t* sys) {
         mem_wr(&sys->mem, addr, M6502_GET_DATA(pins));
     }
 
+    // go to sleep on an opcode fetch inside the ROM idle loop
+    if ((pins & M6502_SYNC) && !iec_changed && (addr >= C1541_IDLE_START) && (addr <= C1541_IDLE_END)) {
+        sys->sleeping = true;
+    }
     sys->pins = pins;
 }
 
+void c1541_run(c1541_t* sys, uint32_t num_ticks) {
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        if (sys->sleeping && (sys->iec_last == (sys->iec ? *sys->iec : 0))) {
+            // the IEC port can't change during the burst, sleep through the rest
+            sys->sleep_ticks += num_ticks - i;
+            return;
+        }
+        c1541_tick(sys);
+    }
+}
+
 void c1541_insert_disc(c1541_t* sys, chips_range_t data) {
     // FIXME
     (void)sys;
@@ -181,14 +401,709 @@ void c1541_snapshot_onsave(c1541_t* snapshot, void* base) {
     CHIPS_ASSERT(snapshot && base);
     snapshot->iec = 0;
     m6502_snapshot_onsave(&snapshot->cpu);
-    mem_snapshot_onsave(&snapshot->mem, base);
+    const mem_ext_range_t roms[2] = { { snapshot->rom_ptr[0], 0x2000 }, { snapshot->rom_ptr[1], 0x2000 } };
+    mem_snapshot_onsave_ext(&snapshot->mem, base, roms, 2);
+    snapshot->rom_ptr[0] = snapshot->rom_ptr[1] = 0;
 }
 
 void c1541_snapshot_onload(c1541_t* snapshot, c1541_t* sys, void* base) {
     CHIPS_ASSERT(snapshot && sys && base);
     snapshot->iec = sys->iec;
     m6502_snapshot_onload(&snapshot->cpu, &sys->cpu);
-    mem_snapshot_onload(&snapshot->mem, base);
+    const mem_ext_range_t roms[2] = { { sys->rom_ptr[0], 0x2000 }, { sys->rom_ptr[1], 0x2000 } };
+    mem_snapshot_onload_ext(&snapshot->mem, base, roms, 2);
+    snapshot->shared_roms = sys->shared_roms;
+    snapshot->rom_ptr[0] = sys->rom_ptr[0];
+    snapshot->rom_ptr[1] = sys->rom_ptr[1];
+}
+
+void c1541_copy_state(c1541_t* dst, void* dst_base, c1541_t* src, void* src_base) {
+    CHIPS_ASSERT(dst && dst->valid && dst_base && src && src->valid && src_base);
+    uint8_t* iec = dst->iec;
+    m6502_t cpu = dst->cpu;
+    memcpy(dst, src, offsetof(c1541_t, shared_roms));
+    memcpy(dst->ram, src->ram, sizeof(dst->ram));
+    dst->iec = iec;
+    m6502_snapshot_onload(&dst->cpu, &cpu);
+    // rebase the memory map from src to dst
+    const mem_ext_range_t src_roms[2] = { { src->rom_ptr[0], 0x2000 }, { src->rom_ptr[1], 0x2000 } };
+    const mem_ext_range_t dst_roms[2] = { { dst->rom_ptr[0], 0x2000 }, { dst->rom_ptr[1], 0x2000 } };
+    mem_snapshot_onsave_ext(&dst->mem, src_base, src_roms, 2);
+    mem_snapshot_onload_ext(&dst->mem, dst_base, dst_roms, 2);
+}
+
+uint64_t c1541_hash(const c1541_t* sys, uint64_t h) {
+    CHIPS_ASSERT(sys && sys->valid);
+    h = m6502_hash(&sys->cpu, h);
+    h = CHIPS_HASH(h, sys->via_1);
+    h = CHIPS_HASH(h, sys->via_2);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->sleeping);
+    h = CHIPS_HASH(h, sys->iec_last);
+    h = CHIPS_HASH(h, sys->sleep_ticks);
+    return CHIPS_HASH(h, sys->ram);
+}
+
+/*-- virtual drive -----------------------------------------------------------*/
+#define _C1541_DIR_TRACK (18)
+
+static int _c1541_d64_num_sectors(int track) {
+    return (track <= 17) ? 21 : ((track <= 24) ? 19 : ((track <= 30) ? 18 : 17));
+}
+
+// return pointer to a 256-byte sector in the disc image, or 0 if invalid
+static uint8_t* _c1541_d64_sector(c1541_vdrive_t* vd, int track, int sector) {
+    if (!vd->disc || (track < 1) || (track > 35) || (sector < 0) || (sector >= _c1541_d64_num_sectors(track))) {
+        return 0;
+    }
+    size_t index = (size_t)sector;
+    for (int t = 1; t < track; t++) {
+        index += (size_t)_c1541_d64_num_sectors(t);
+    }
+    return vd->disc + index * 256;
+}
+
+// allocate a free block in the BAM, the directory track is only used for directory sectors
+static bool _c1541_bam_alloc(c1541_vdrive_t* vd, bool dir, uint8_t* out_track, uint8_t* out_sector) {
+    uint8_t* bam = _c1541_d64_sector(vd, _C1541_DIR_TRACK, 0);
+    for (int dist = dir ? 0 : 1; dist < (dir ? 1 : 18); dist++) {
+        for (int i = 0; i < 2; i++) {
+            const int track = i ? (_C1541_DIR_TRACK + dist) : (_C1541_DIR_TRACK - dist);
+            if ((track < 1) || (track > 35)) {
+                continue;
+            }
+            uint8_t* entry = bam + 4 * track;
+            if (entry[0] == 0) {
+                continue;
+            }
+            for (int sector = 0; sector < _c1541_d64_num_sectors(track); sector++) {
+                const uint8_t mask = 1 << (sector & 7);
+                if (entry[1 + (sector >> 3)] & mask) {
+                    entry[1 + (sector >> 3)] &= ~mask;
+                    entry[0]--;
+                    *out_track = (uint8_t)track;
+                    *out_sector = (uint8_t)sector;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static void _c1541_bam_free(c1541_vdrive_t* vd, int track, int sector) {
+    if (_c1541_d64_sector(vd, track, sector)) {
+        uint8_t* entry = _c1541_d64_sector(vd, _C1541_DIR_TRACK, 0) + 4 * track;
+        const uint8_t mask = 1 << (sector & 7);
+        if (0 == (entry[1 + (sector >> 3)] & mask)) {
+            entry[1 + (sector >> 3)] |= mask;
+            entry[0]++;
+        }
+    }
+}
+
+// number of free blocks (not counting the directory track)
+static uint16_t _c1541_bam_blocks_free(c1541_vdrive_t* vd) {
+    const uint8_t* bam = _c1541_d64_sector(vd, _C1541_DIR_TRACK, 0);
+    uint16_t num = 0;
+    for (int track = 1; track <= 35; track++) {
+        if (track != _C1541_DIR_TRACK) {
+            num += bam[4 * track];
+        }
+    }
+    return num;
+}
+
+// match a file name pattern (with '*' and '?' wildcards) against a 0xA0-padded directory name
+static bool _c1541_name_match(const uint8_t* pattern, int len, const uint8_t* name) {
+    for (int i = 0; i < 16; i++) {
+        if (i == len) {
+            return name[i] == 0xA0;
+        }
+        if (pattern[i] == '*') {
+            return true;
+        }
+        if (name[i] == 0xA0) {
+            return false;
+        }
+        if ((pattern[i] != '?') && (pattern[i] != name[i])) {
+            return false;
+        }
+    }
+    return (len == 16) || ((len > 16) && (pattern[16] == '*'));
+}
+
+// find a closed file matching a name pattern, or a free directory slot if pattern is 0
+static uint8_t* _c1541_dir_find(c1541_vdrive_t* vd, const uint8_t* pattern, int len, uint8_t* out_track, uint8_t* out_sector, uint8_t* out_index) {
+    int track = _C1541_DIR_TRACK;
+    int sector = 1;
+    // the directory can't be longer than the directory track (protects against loops)
+    for (int num_sectors = 0; num_sectors < 19; num_sectors++) {
+        uint8_t* sec = _c1541_d64_sector(vd, track, sector);
+        if (!sec) {
+            return 0;
+        }
+        for (int i = 0; i < 8; i++) {
+            uint8_t* entry = sec + i * 32;
+            const uint8_t type = entry[2];
+            const bool found = pattern ?
+                ((type & 0x80) && (type & 0x07) && _c1541_name_match(pattern, len, entry + 5)) :
+                (type == 0);
+            if (found) {
+                *out_track = (uint8_t)track;
+                *out_sector = (uint8_t)sector;
+                *out_index = (uint8_t)i;
+                return entry;
+            }
+        }
+        if (sec[0] == 0) {
+            // end of directory chain, extend directory when looking for a free slot
+            uint8_t t, s;
+            if (pattern || !_c1541_bam_alloc(vd, true, &t, &s)) {
+                return 0;
+            }
+            uint8_t* new_sec = _c1541_d64_sector(vd, t, s);
+            if (!new_sec) {
+                return 0;
+            }
+            sec[0] = t;
+            sec[1] = s;
+            memset(new_sec, 0, 256);
+            new_sec[1] = 0xFF;
+            // continue the scan in the new directory sector
+            track = t;
+            sector = s;
+            continue;
+        }
+        track = sec[0];
+        sector = sec[1];
+    }
+    return 0;
+}
+
+// free the blocks of a file and delete its directory entry
+static void _c1541_scratch(c1541_vdrive_t* vd, uint8_t* entry) {
+    int track = entry[3];
+    int sector = entry[4];
+    for (int i = 0; i < 683; i++) {
+        const uint8_t* sec = _c1541_d64_sector(vd, track, sector);
+        if (!sec) {
+            break;
+        }
+        _c1541_bam_free(vd, track, sector);
+        track = sec[0];
+        sector = sec[1];
+    }
+    entry[2] = 0;
+}
+
+static void _c1541_vdrive_set_status(c1541_vdrive_t* vd, uint8_t status, uint8_t track) {
+    vd->status = status;
+    vd->status_track = track;
+    vd->status_pos = 0;
+}
+
+// copy a 0xA0-padded disc name into a buffer, return number of bytes written
+static int _c1541_copy_name(uint8_t* dst, const uint8_t* src, bool pad) {
+    int i = 0;
+    for (; (i < 16) && (src[i] != 0xA0); i++) {
+        dst[i] = src[i];
+    }
+    if (pad) {
+        for (; i < 16; i++) {
+            dst[i] = ' ';
+        }
+    }
+    return i;
+}
+
+// generate the next line of a directory listing in the channel's line buffer
+static void _c1541_dir_next_line(c1541_vdrive_t* vd, c1541_vchannel_t* ch) {
+    uint8_t* buf = ch->buf;
+    int n = 0;
+    ch->pos = 0;
+    ch->len = 0;
+    if (ch->entry_track == 0) {
+        // first line: load address and disc header
+        const uint8_t* bam = _c1541_d64_sector(vd, _C1541_DIR_TRACK, 0);
+        buf[n++] = 0x01; buf[n++] = 0x04;
+        buf[n++] = 0x01; buf[n++] = 0x01;
+        buf[n++] = 0x00; buf[n++] = 0x00;
+        buf[n++] = 0x12; buf[n++] = '"';
+        n += _c1541_copy_name(&buf[n], bam + 0x90, true);
+        buf[n++] = '"'; buf[n++] = ' ';
+        buf[n++] = bam[0xA2]; buf[n++] = bam[0xA3]; buf[n++] = ' ';
+        buf[n++] = bam[0xA5]; buf[n++] = bam[0xA6];
+        buf[n++] = 0;
+        ch->entry_track = _C1541_DIR_TRACK;
+        ch->entry_sector = 1;
+        ch->entry_index = 0;
+        ch->len = (uint16_t)n;
+        return;
+    }
+    // next file entry
+    while (ch->entry_track != 0xFF) {
+        const uint8_t* sec = _c1541_d64_sector(vd, ch->entry_track, ch->entry_sector);
+        if (!sec || (ch->entry_index >= 8)) {
+            // (blocks counts the visited directory sectors to protect against loops)
+            if (sec && (sec[0] != 0) && (ch->blocks++ < 19)) {
+                ch->entry_track = sec[0];
+                ch->entry_sector = sec[1];
+                ch->entry_index = 0;
+            }
+            else {
+                ch->entry_track = 0xFF;
+            }
+            continue;
+        }
+        const uint8_t* entry = sec + 32 * ch->entry_index++;
+        const uint8_t type = entry[2];
+        if ((type & 0x07) == 0) {
+            continue;
+        }
+        static const char* types[8] = { "DEL", "SEQ", "PRG", "USR", "REL", "???", "???", "???" };
+        const uint16_t blocks = entry[30] | (entry[31] << 8);
+        buf[n++] = 0x01; buf[n++] = 0x01;
+        buf[n++] = (uint8_t)blocks; buf[n++] = (uint8_t)(blocks >> 8);
+        for (int i = (blocks < 10) ? 3 : ((blocks < 100) ? 2 : 1); i > 0; i--) {
+            buf[n++] = ' ';
+        }
+        buf[n++] = '"';
+        const int len = _c1541_copy_name(&buf[n], entry + 5, false);
+        n += len;
+        buf[n++] = '"';
+        for (int i = len; i < 16; i++) {
+            buf[n++] = ' ';
+        }
+        buf[n++] = (type & 0x80) ? ' ' : '*';
+        for (int i = 0; i < 3; i++) {
+            buf[n++] = (uint8_t)types[type & 0x07][i];
+        }
+        buf[n++] = (type & 0x40) ? '<' : ' ';
+        buf[n++] = 0;
+        ch->len = (uint16_t)n;
+        return;
+    }
+    // last line: blocks free, followed by the end-of-program marker
+    if (!ch->eof) {
+        static const char* blocks_free = "BLOCKS FREE.";
+        const uint16_t blocks = _c1541_bam_blocks_free(vd);
+        buf[n++] = 0x01; buf[n++] = 0x01;
+        buf[n++] = (uint8_t)blocks; buf[n++] = (uint8_t)(blocks >> 8);
+        for (int i = 0; blocks_free[i]; i++) {
+            buf[n++] = (uint8_t)blocks_free[i];
+        }
+        buf[n++] = 0;
+        buf[n++] = 0;
+        buf[n++] = 0;
+        ch->eof = true;
+        ch->len = (uint16_t)n;
+    }
+}
+
+static void _c1541_vdrive_command(c1541_vdrive_t* vd, const uint8_t* cmd, int len) {
+    // ignore trailing carriage returns
+    while ((len > 0) && (cmd[len - 1] == 0x0D)) {
+        len--;
+    }
+    if (len == 0) {
+        return;
+    }
+    if ((cmd[0] == 'I') || (cmd[0] == 'V')) {
+        _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_OK, 0);
+    }
+    else if ((cmd[0] == 'U') && (len > 1) && ((cmd[1] == 'J') || (cmd[1] == 'I') || (cmd[1] == ':'))) {
+        c1541_vdrive_reset(vd);
+    }
+    else if (cmd[0] == 'S') {
+        int i = 1;
+        while ((i < len) && (cmd[i] != ':')) {
+            i++;
+        }
+        uint8_t num = 0;
+        if (vd->disc && (i < len)) {
+            uint8_t t, s, idx;
+            uint8_t* entry;
+            while ((num < 144) && (entry = _c1541_dir_find(vd, &cmd[i + 1], len - i - 1, &t, &s, &idx))) {
+                _c1541_scratch(vd, entry);
+                num++;
+            }
+        }
+        _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_SCRATCHED, num);
+    }
+    else {
+        _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_SYNTAX_ERROR, 0);
+    }
+}
+
+void c1541_vdrive_init(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd);
+    memset(vd, 0, sizeof(c1541_vdrive_t));
+    vd->valid = true;
+    _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_DOS_VERSION, 0);
+}
+
+void c1541_vdrive_reset(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    for (int i = 0; i < C1541_VDRIVE_NUM_CHANNELS; i++) {
+        c1541_vdrive_close(vd, (uint8_t)i);
+    }
+    vd->listening = vd->talking = false;
+    vd->cmd = vd->sa = vd->name_len = 0;
+    _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_DOS_VERSION, 0);
+}
+
+bool c1541_vdrive_insert_disc(c1541_vdrive_t* vd, chips_range_t data) {
+    CHIPS_ASSERT(vd && vd->valid && data.ptr);
+    c1541_vdrive_remove_disc(vd);
+    if ((data.size != C1541_D64_SIZE) && (data.size != C1541_D64_SIZE_ERRORS)) {
+        return false;
+    }
+    vd->disc = (uint8_t*) data.ptr;
+    vd->disc_size = data.size;
+    _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_OK, 0);
+    return true;
+}
+
+void c1541_vdrive_remove_disc(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    if (vd->disc) {
+        for (int i = 0; i < C1541_VDRIVE_NUM_CHANNELS; i++) {
+            c1541_vdrive_close(vd, (uint8_t)i);
+        }
+    }
+    vd->disc = 0;
+    vd->disc_size = 0;
+}
+
+bool c1541_vdrive_disc_inserted(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    return 0 != vd->disc;
+}
+
+bool c1541_vdrive_open(c1541_vdrive_t* vd, uint8_t sa, const uint8_t* name, int name_len) {
+    CHIPS_ASSERT(vd && vd->valid && name && (sa < C1541_VDRIVE_NUM_CHANNELS));
+    if (sa == 15) {
+        _c1541_vdrive_command(vd, name, name_len);
+        return true;
+    }
+    c1541_vdrive_close(vd, sa);
+    if (!vd->disc) {
+        _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_NOT_READY, 0);
+        return false;
+    }
+
+    // parse "[@][0]:name[,type][,mode]"
+    bool replace = false;
+    if ((name_len > 0) && (name[0] == '@')) {
+        replace = true;
+        name++; name_len--;
+    }
+    for (int i = 0; (i < name_len) && (i < 2); i++) {
+        if (name[i] == ':') {
+            name += i + 1; name_len -= i + 1;
+            break;
+        }
+    }
+    int len = 0;
+    while ((len < name_len) && (name[len] != ',')) {
+        len++;
+    }
+    uint8_t type = 0x02;
+    bool write = (sa == 1);
+    for (int i = len; i < (name_len - 1); i++) {
+        if (name[i] == ',') {
+            switch (name[i + 1]) {
+                case 'S': type = 0x01; break;
+                case 'P': type = 0x02; break;
+                case 'U': type = 0x03; break;
+                case 'W': write = true; break;
+                case 'R': write = false; break;
+                default: break;
+            }
+        }
+    }
+
+    c1541_vchannel_t* ch = &vd->chn[sa];
+    memset(ch, 0, sizeof(c1541_vchannel_t));
+    if ((len == 1) && (name[0] == '$') && !write) {
+        ch->open = true;
+        ch->dir = true;
+        _c1541_dir_next_line(vd, ch);
+    }
+    else if (write) {
+        uint8_t t, s, idx;
+        uint8_t* entry = _c1541_dir_find(vd, name, len, &t, &s, &idx);
+        if (entry) {
+            if (!replace) {
+                _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_FILE_EXISTS, 0);
+                return false;
+            }
+            _c1541_scratch(vd, entry);
+        }
+        entry = _c1541_dir_find(vd, 0, 0, &ch->entry_track, &ch->entry_sector, &ch->entry_index);
+        if (!entry || !_c1541_bam_alloc(vd, false, &ch->track, &ch->sector)) {
+            _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_DISK_FULL, 0);
+            return false;
+        }
+        memset(entry + 2, 0, 30);
+        entry[2] = type;
+        entry[3] = ch->track;
+        entry[4] = ch->sector;
+        for (int i = 0; i < 16; i++) {
+            entry[5 + i] = (i < len) ? name[i] : 0xA0;
+        }
+        ch->open = true;
+        ch->write = true;
+        ch->pos = 2;
+    }
+    else {
+        uint8_t* entry = (len > 0) ? _c1541_dir_find(vd, name, len, &ch->entry_track, &ch->entry_sector, &ch->entry_index) : 0;
+        if (!entry) {
+            _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_FILE_NOT_FOUND, 0);
+            return false;
+        }
+        ch->open = true;
+        ch->track = entry[3];
+        ch->sector = entry[4];
+        ch->pos = 2;
+    }
+    _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_OK, 0);
+    return true;
+}
+
+void c1541_vdrive_close(c1541_vdrive_t* vd, uint8_t sa) {
+    CHIPS_ASSERT(vd && vd->valid && (sa < C1541_VDRIVE_NUM_CHANNELS));
+    c1541_vchannel_t* ch = &vd->chn[sa];
+    if (ch->open && ch->write) {
+        // terminate the sector chain and close the directory entry
+        uint8_t* sec = _c1541_d64_sector(vd, ch->track, ch->sector);
+        uint8_t* dir = _c1541_d64_sector(vd, ch->entry_track, ch->entry_sector);
+        if (sec && dir) {
+            sec[0] = 0;
+            sec[1] = (uint8_t)(ch->pos - 1);
+            ch->blocks++;
+            uint8_t* entry = dir + 32 * ch->entry_index;
+            entry[2] |= 0x80;
+            entry[30] = (uint8_t)ch->blocks;
+            entry[31] = (uint8_t)(ch->blocks >> 8);
+        }
+    }
+    memset(ch, 0, sizeof(c1541_vchannel_t));
+}
+
+int c1541_vdrive_read(c1541_vdrive_t* vd, uint8_t sa, bool* eoi) {
+    CHIPS_ASSERT(vd && vd->valid && eoi && (sa < C1541_VDRIVE_NUM_CHANNELS));
+    *eoi = false;
+    if (sa == 15) {
+        // the command channel reads the DOS status message
+        static const struct { uint8_t code; const char* msg; } msgs[] = {
+            { C1541_VDRIVE_STATUS_OK, " OK" },
+            { C1541_VDRIVE_STATUS_SCRATCHED, "FILES SCRATCHED" },
+            { C1541_VDRIVE_STATUS_SYNTAX_ERROR, "SYNTAX ERROR" },
+            { C1541_VDRIVE_STATUS_FILE_NOT_OPEN, "FILE NOT OPEN" },
+            { C1541_VDRIVE_STATUS_FILE_NOT_FOUND, "FILE NOT FOUND" },
+            { C1541_VDRIVE_STATUS_FILE_EXISTS, "FILE EXISTS" },
+            { C1541_VDRIVE_STATUS_DISK_FULL, "DISK FULL" },
+            { C1541_VDRIVE_STATUS_DOS_VERSION, "CBM DOS V2.6 1541" },
+            { C1541_VDRIVE_STATUS_NOT_READY, "DRIVE NOT READY" },
+        };
+        const char* msg = "";
+        for (size_t i = 0; i < sizeof(msgs) / sizeof(msgs[0]); i++) {
+            if (msgs[i].code == vd->status) {
+                msg = msgs[i].msg;
+            }
+        }
+        uint8_t buf[40];
+        int n = 0;
+        buf[n++] = (uint8_t)('0' + vd->status / 10);
+        buf[n++] = (uint8_t)('0' + vd->status % 10);
+        buf[n++] = ',';
+        for (int i = 0; msg[i] && (n < 32); i++) {
+            buf[n++] = (uint8_t)msg[i];
+        }
+        buf[n++] = ',';
+        buf[n++] = (uint8_t)('0' + (vd->status_track / 10) % 10);
+        buf[n++] = (uint8_t)('0' + vd->status_track % 10);
+        buf[n++] = ',';
+        buf[n++] = '0';
+        buf[n++] = '0';
+        buf[n++] = 0x0D;
+        const uint8_t data = buf[vd->status_pos++];
+        if (vd->status_pos >= n) {
+            // after the message has been read, the status is reset to OK
+            *eoi = true;
+            _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_OK, 0);
+        }
+        return data;
+    }
+    c1541_vchannel_t* ch = &vd->chn[sa];
+    if (!ch->open || ch->write || (ch->eof && !ch->dir) || !vd->disc) {
+        return -1;
+    }
+    if (ch->dir) {
+        if (ch->pos >= ch->len) {
+            return -1;
+        }
+        const uint8_t data = ch->buf[ch->pos++];
+        if (ch->pos >= ch->len) {
+            if (ch->eof) {
+                *eoi = true;
+            }
+            else {
+                _c1541_dir_next_line(vd, ch);
+            }
+        }
+        return data;
+    }
+    const uint8_t* sec = _c1541_d64_sector(vd, ch->track, ch->sector);
+    if (!sec) {
+        ch->eof = true;
+        return -1;
+    }
+    // in the last sector of a file, the link sector byte is the index of the last valid byte
+    const uint16_t last = (sec[0] == 0) ? sec[1] : 255;
+    if (ch->pos > last) {
+        ch->eof = true;
+        return -1;
+    }
+    const uint8_t data = sec[ch->pos];
+    if (ch->pos < last) {
+        ch->pos++;
+    }
+    else if (sec[0] == 0) {
+        ch->eof = true;
+        *eoi = true;
+    }
+    else {
+        ch->track = sec[0];
+        ch->sector = sec[1];
+        ch->pos = 2;
+    }
+    return data;
+}
+
+bool c1541_vdrive_write(c1541_vdrive_t* vd, uint8_t sa, uint8_t data) {
+    CHIPS_ASSERT(vd && vd->valid && (sa < C1541_VDRIVE_NUM_CHANNELS));
+    c1541_vchannel_t* ch = &vd->chn[sa];
+    if (!ch->open || !ch->write) {
+        _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_FILE_NOT_OPEN, 0);
+        return false;
+    }
+    uint8_t* sec = _c1541_d64_sector(vd, ch->track, ch->sector);
+    if (!sec) {
+        return false;
+    }
+    if (ch->pos > 255) {
+        // current sector is full, link to a newly allocated sector
+        uint8_t t, s;
+        if (!_c1541_bam_alloc(vd, false, &t, &s)) {
+            _c1541_vdrive_set_status(vd, C1541_VDRIVE_STATUS_DISK_FULL, 0);
+            return false;
+        }
+        sec[0] = t;
+        sec[1] = s;
+        ch->blocks++;
+        ch->track = t;
+        ch->sector = s;
+        ch->pos = 2;
+        sec = _c1541_d64_sector(vd, t, s);
+    }
+    sec[ch->pos++] = data;
+    return true;
+}
+
+void c1541_vdrive_listen(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    vd->listening = true;
+    vd->talking = false;
+    vd->cmd = 0;
+    vd->name_len = 0;
+}
+
+void c1541_vdrive_talk(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    vd->talking = true;
+    vd->listening = false;
+    vd->cmd = 0;
+}
+
+void c1541_vdrive_second(c1541_vdrive_t* vd, uint8_t cmd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    if (!(vd->listening || vd->talking)) {
+        return;
+    }
+    vd->cmd = cmd & 0xF0;
+    vd->sa = cmd & 0x0F;
+    vd->name_len = 0;
+    if (vd->listening && (vd->cmd == 0xE0)) {
+        c1541_vdrive_close(vd, vd->sa);
+    }
+}
+
+void c1541_vdrive_send(c1541_vdrive_t* vd, uint8_t data) {
+    CHIPS_ASSERT(vd && vd->valid);
+    if (!vd->listening) {
+        return;
+    }
+    if ((vd->cmd == 0xF0) || (vd->sa == 15)) {
+        if (vd->name_len < C1541_VDRIVE_MAX_NAME) {
+            vd->name[vd->name_len++] = data;
+        }
+    }
+    else if (vd->cmd == 0x60) {
+        c1541_vdrive_write(vd, vd->sa, data);
+    }
+}
+
+int c1541_vdrive_receive(c1541_vdrive_t* vd, bool* eoi) {
+    CHIPS_ASSERT(vd && vd->valid && eoi);
+    *eoi = false;
+    if (!vd->talking) {
+        return -1;
+    }
+    return c1541_vdrive_read(vd, vd->sa, eoi);
+}
+
+void c1541_vdrive_unlisten(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    if (vd->listening) {
+        if (vd->cmd == 0xF0) {
+            c1541_vdrive_open(vd, vd->sa, vd->name, vd->name_len);
+        }
+        else if ((vd->sa == 15) && (vd->name_len > 0)) {
+            _c1541_vdrive_command(vd, vd->name, vd->name_len);
+        }
+    }
+    vd->listening = false;
+    vd->cmd = 0;
+    vd->name_len = 0;
+}
+
+void c1541_vdrive_untalk(c1541_vdrive_t* vd) {
+    CHIPS_ASSERT(vd && vd->valid);
+    vd->talking = false;
+    vd->cmd = 0;
+}
+
+void c1541_vdrive_snapshot_onsave(c1541_vdrive_t* snapshot) {
+    CHIPS_ASSERT(snapshot);
+    snapshot->disc = 0;
+}
+
+uint64_t c1541_vdrive_hash(const c1541_vdrive_t* vd, uint64_t h) {
+    CHIPS_ASSERT(vd);
+    c1541_vdrive_t tmp;
+    memcpy(&tmp, vd, sizeof(tmp));
+    c1541_vdrive_snapshot_onsave(&tmp);
+    return CHIPS_HASH(h, tmp);
+}
+
+void c1541_vdrive_snapshot_onload(c1541_vdrive_t* snapshot, c1541_vdrive_t* sys) {
+    CHIPS_ASSERT(snapshot && sys);
+    // the disc image is caller-owned, keep whatever disc is currently inserted
+    snapshot->disc = sys->disc;
+    snapshot->disc_size = sys->disc_size;
 }
 
 #endif // CHIPS_IMPL
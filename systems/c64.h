@@ -18,6 +18,9 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Optionally define CHIPS_SHARED_ROMS before including c64.h to remove the
+    embedded ROM image arrays from c64_t (see 'Shared ROM Images' below).
+
     You need to include the following headers before including c64.h:
 
     - chips/chips_common.h
@@ -32,13 +35,171 @@
     - chips/m6522.h
     - systems/c1541.h
 
+    ## Shared ROM Images
+
+    By default c64_init() copies the ROM images from c64_desc_t.roms into
+    the c64_t struct (and the c1541_t struct). When running many emulator
+    instances side by side, set c64_desc_t.shared_roms to true, this maps
+    the ROM pages directly from the caller-owned buffers in c64_desc_t.roms
+    without copying. Those buffers must remain valid and unchanged until
+    the c64_t instance is discarded.
+
+    If CHIPS_SHARED_ROMS is defined, the embedded ROM arrays are removed
+    from c64_t and c1541_t altogether and c64_desc_t.shared_roms is implied.
+
+    ## Fast State Copy
+
+    c64_copy_state(dst, src) copies the emulation state of one instance
+    into another without going through an intermediate snapshot, for
+    instance to keep a secondary instance in sync for run-ahead (see
+    util/runahead.h). Both instances must have been initialized with the
+    same c64_desc_t configuration. The ROM images and the framebuffer are
+    not copied, only the used part of the tape image is copied, and dst
+    keeps its own debug, headless, turbo, audio and vblank callback setup.
+    The virtual drive's disc image is caller-owned and not copied either,
+    dst keeps whatever disc is inserted into it (NOTE: if both instances
+    use the same disc image, disc writes from the secondary instance end up
+    in that image too).
+
+    ## Cloning
+
+    c64_clone(dst, tmpl, desc) creates a ready-to-run instance from an
+    initialized template instance (for instance one which has already
+    booted to the BASIC prompt) without calling c64_init() and without
+    emulating the boot process. The template is copied as a whole (including
+    RAM, ROM images, framebuffer and tape image), and the internal pointers
+    (CPU and VIC-II callback context, memory maps, ROM pointers, drive
+    ports) are rebased from the template to dst. Use one template for many
+    clones:
+
+    ~~~C
+    static c64_t tmpl;
+    c64_init(&tmpl, &desc);
+    // ...run tmpl until it has reached the BASIC prompt
+    c64_clone(&sys, &tmpl, &(c64_clone_desc_t){
+        .audio_callback = { .func = my_audio_callback, .user_data = my_session },
+    });
+    ~~~
+
+    The debug hook, audio callback and vblank callback are taken from
+    c64_clone_desc_t, dst keeps the template's headless setup and has no
+    triple buffer or raw video log attached. Shared ROM buffers (see 'Shared ROM Images') are
+    shared with the template. A disc inserted into the template's virtual
+    drive is not inserted into dst (insert one with c64_insert_disc()), and
+    text queued with c64_type_text() isn't typed into dst.
+
+    ## State Hash
+
+    c64_state_hash() hashes the emulation state of the C64 (CPU, CIAs, VIC,
+    SID, keyboard, color RAM and main RAM) and of the connected C1541,
+    virtual drive or datasette, but not disc or tape images. The main RAM
+    is hashed incrementally: the first call switches on dirty tracking in
+    c64_t.mem_cpu, and later calls only rehash the written RAM pages.
+
+    ## Observation
+
+    c64_observe() returns pointers to the main RAM ("ram", 64 KBytes) and
+    color RAM ("color_ram", 1 KByte, only the lower 4 bits are used), the
+    display info and the m6502_t CPU state (see chips_observation_t in
+    chips_common.h). The vblank callback in c64_desc_t is invoked when the
+    VIC-II's raster counter wraps around to line 0.
+
+    ## Virtual Drive
+
+    As a high-speed alternative to the C1541 true-drive emulation, set
+    c64_desc_t.vdrive_enabled to true to connect a c1541_vdrive_t as
+    device 8 (see systems/c1541.h). The virtual drive works by trapping
+    the standard KERNAL routines: LOAD and SAVE to/from device 8 are
+    performed in a single step, and the serial bus primitives (LISTEN,
+    TALK, SECOND, TKSA, CIOUT, ACPTR, UNLSN, UNTLK) are forwarded to the
+    virtual drive so that OPEN, CHKIN, CHRIN, CHROUT and CLOSE work on
+    files and on the command channel.
+
+    The traps are only active while the KERNAL ROM is mapped in and assume
+    the entry points of the stock 901227-03 KERNAL. The drive CPU isn't
+    emulated at all, so fast loaders need the true-drive emulation
+    (c64_desc_t.c1541_enabled). Both can't be enabled at the same time.
+
+    Use c64_insert_disc() to insert a D64 image, the image data is owned
+    by the caller and must remain valid while the disc is inserted.
+
+    ## Drive Interleaving
+
+    With the true-drive emulation enabled, the C1541 isn't ticked in
+    lockstep with the C64. Instead the drive ticks are counted and the
+    drive runs in bursts of up to C64_C1541_BURST_TICKS ticks (see 'Burst
+    Execution' in systems/c1541.h), and at the end of each c64_exec() slice.
+    The only state shared by both sides is the c64_t.iec_port byte, so any
+    code which changes it must call _c64_sync_c1541() first, this keeps the
+    IEC-visible timing exact.
+
+    ## Tape Turbo
+
+    Set c64_desc_t.c1530_turbo to true to speed up tape loading: while the
+    datasette motor is running (and the tape isn't at its end), c64_exec()
+    keeps running past the requested time slice (up to
+    C64_TAPE_TURBO_FACTOR times as many ticks) with the video decoding
+    switched off (as in headless mode), and the SID is only ticked for
+    register accesses, so no audio samples are generated. c64_exec()
+    returns the number of ticks actually executed. c64_exec_frame() runs
+    up to C64_TAPE_TURBO_FACTOR video frames in tape turbo mode.
+
+    Additionally, set c64_desc_t.c1530_load_trap to true to shortcut the
+    KERNAL tape LOAD routine: when a program is loaded from device 1, the
+    next matching file in the standard KERNAL tape encoding is decoded
+    directly from the TAP pulses into memory (see 'KERNAL Tape Format'
+    in c1530.h). If the file can't be decoded (for instance because it
+    uses a custom turbo loader), the regular KERNAL routine runs instead.
+
+    ## Text Input
+
+    c64_type_text() queues a caller-owned ASCII text (for instance a BASIC
+    listing pasted into the host window) which must remain valid until
+    c64_is_typing_text() returns false. Instead of pressing keys, the text
+    is written straight into the KERNAL keyboard buffer at 0277: whenever
+    the buffer is empty at the start of c64_exec() or c64_exec_frame(), up
+    to 10 characters are copied into it, so that typing is only limited by
+    how fast the program reading the keyboard buffer consumes them.
+
+    Letters are typed unshifted regardless of their case (listings are
+    usually stored as upper-case ASCII), newlines become RETURN, and
+    characters without a PETSCII equivalent are dropped.
+
+    ## Turbo Mode
+
+    c64_set_turbo() switches on turbo mode at run time (see chips_turbo_t
+    in chips_common.h), c64_exec() and c64_exec_frame() then run the given
+    number of time slices or frames, and only the last one produces video
+    and audio output. c64_turbo_speed() returns the speed factor achieved
+    in the last call. Tape turbo mode works on top of this.
+
+    ## Raw Video Log
+
+    If c64_desc_t.vidlog points to a chips_vidlog_t (see chips_common.h),
+    the VIC-II records its register writes at the raster position, and
+    changes of the VIC bank selected through CIA-2 port A are recorded as
+    register C64_VIDLOG_REG_BANK. Each published frame comes with a copy
+    of the video memory in this layout:
+
+    - 0x00000..0x0FFFF: the 64 KByte RAM
+    - 0x10000..0x10FFF: the character ROM (seen by the VIC-II at 0x1000 and 0x9000)
+    - 0x11000..0x113FF: the color RAM
+
+    ## Profiling
+
+    When compiled with CHIPS_PROFILE, c64_profile_info() returns per-tick
+    host cycle budgets for the drives, the CPU, the SID, the CIAs, the
+    VIC-II and the memory/IO decoding, access counts for the memory and
+    IO devices and the host cycles per exec call (see chips_profile_t in
+    chips_common.h).
+
     ## The Commodore C64
 
     TODO!
 
     ## TODO:
 
-    - floppy disc support
+    - floppy disc support for the true-drive emulation
 
     ## Tests Status
 
@@ -252,11 +413,16 @@ extern "C" {
 #endif
 
 // bump snapshot version when c64_t memory layout changes
-#define C64_SNAPSHOT_VERSION (1)
+#define C64_SNAPSHOT_VERSION (2)
 
 #define C64_FREQUENCY (985248)              // clock frequency in Hz
 #define C64_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
+#define C64_TAPE_TURBO_FACTOR (64)          // max speedup of c64_exec() in tape turbo mode
 #define C64_DEFAULT_AUDIO_SAMPLES (128)     // default number of samples in internal sample buffer
+#ifndef C64_C1541_BURST_TICKS
+#define C64_C1541_BURST_TICKS (512)         // max number of C1541 ticks run in one burst (see 'Drive Interleaving')
+#endif
+#define C64_VIDLOG_REG_BANK (0x3F)          // raw video log register number of the 16 KByte VIC bank (0..3)
 
 // C64 joystick types
 typedef enum {
@@ -322,10 +488,18 @@ typedef enum {
 // config parameters for c64_init()
 typedef struct {
     bool c1530_enabled;     // true to enable the C1530 datassette emulation
+    bool c1530_turbo;       // true to run uncapped while the tape motor is on (see 'Tape Turbo')
+    bool c1530_load_trap;   // true to shortcut KERNAL tape LOAD of standard-encoded files
     bool c1541_enabled;     // true to enable the C1541 floppy drive emulation
+    bool vdrive_enabled;    // true to enable the KERNAL-trap virtual floppy drive (see 'Virtual Drive')
     c64_joystick_type_t joystick_type;  // default is C64_JOYSTICK_NONE
     chips_debug_t debug;    // optional debugging hook
+    chips_headless_t headless;  // optional headless video mode (see chips_common.h)
+    chips_triple_buffer_t* triple_buffer;   // optional framebuffer hand-off to a render thread (see chips_common.h)
+    chips_vidlog_t* vidlog;     // optional raw video log (see 'Raw Video Log')
     chips_audio_desc_t audio;   // audio output options
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
+    bool shared_roms;       // if true, map ROM pages directly from the roms buffers (no copy)
     // ROM images
     struct {
         chips_range_t chars;     // 4 KByte character ROM dump
@@ -339,7 +513,15 @@ typedef struct {
     } roms;
 } c64_desc_t;
 
-// C64 emulator state
+// per-instance host hooks for c64_clone()
+typedef struct {
+    chips_debug_t debug;                    // optional debugging hook
+    chips_audio_callback_t audio_callback;  // optional audio output callback
+    chips_vblank_callback_t vblank;         // optional per-frame callback
+} c64_clone_desc_t;
+
+// C64 emulator state, the state accessed in each tick comes first,
+// large or rarely accessed buffers are placed at the end
 typedef struct {
     m6502_t cpu;
     m6526_t cia_1;
@@ -347,23 +529,35 @@ typedef struct {
     m6569_t vic;
     m6581_t sid;
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
+    chips_sched_t sched;        // skips CIA and SID ticks while the chips are idle
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
+    uint64_t frame_us_rem;      // fractional remainder of the ticks-to-us conversion in c64_exec_frame()
 
     c64_joystick_type_t joystick_type;
+    bool tape_turbo;            // tape turbo mode enabled
+    bool tape_turbo_active;     // true while c64_exec() runs in tape turbo mode
+    bool tape_load_trap;        // KERNAL tape LOAD trap enabled
+    bool kernal_traps;          // true if any KERNAL trap is enabled
     bool io_mapped;             // true when D000..DFFF has IO area mapped in
     uint8_t cas_port;           // cassette port, shared with c1530_t if datasette is connected
     uint8_t iec_port;           // IEC serial port, shared with c1541_t if connected
+    uint32_t c1541_ticks;       // C1541 ticks not yet executed (see 'Drive Interleaving')
     uint8_t cpu_port;           // last state of CPU port (for memory mapping)
     uint8_t kbd_joy1_mask;      // current joystick-1 state from keyboard-joystick emulation
     uint8_t kbd_joy2_mask;      // current joystick-2 state from keyboard-joystick emulation
     uint8_t joy_joy1_mask;      // current joystick-1 state from c64_joystick()
     uint8_t joy_joy2_mask;      // current joystick-2 state from c64_joystick()
     uint16_t vic_bank_select;   // upper 4 address bits from CIA-2 port A
+    uint8_t io_map[256];        // device selected by CPU accesses per 256-byte page (see _c64_update_memory_map())
 
     kbd_t kbd;                  // keyboard matrix state
     mem_t mem_cpu;              // CPU-visible memory mapping
     mem_t mem_vic;              // VIC-visible memory mapping
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_turbo_t turbo;
 
     struct {
         chips_audio_callback_t callback;
@@ -371,16 +565,28 @@ typedef struct {
         int sample_pos;
         float sample_buffer[C64_MAX_AUDIO_SAMPLES];
     } audio;
+    chips_text_input_t text_input;  // queued text for c64_type_text()
 
     uint8_t color_ram[1024];        // special static color ram
     uint8_t ram[1<<16];             // general ram
+    chips_page_hashes_t ram_hashes; // cached RAM page hashes for c64_state_hash()
+    bool shared_roms;               // ROM pages are mapped from caller-owned buffers
+    const uint8_t* rom_char_ptr;    // ROM images, pointing into rom_xxx[] or to shared buffers
+    const uint8_t* rom_basic_ptr;
+    const uint8_t* rom_kernal_ptr;
+    #if !defined(CHIPS_SHARED_ROMS)
     uint8_t rom_char[0x1000];       // 4 KB character ROM image
     uint8_t rom_basic[0x2000];      // 8 KB BASIC ROM image
     uint8_t rom_kernal[0x2000];     // 8 KB KERNAL V3 ROM image
+    #endif
+    c1541_t c1541;      // optional floppy drive
+    c1541_vdrive_t vdrive;  // optional virtual floppy drive
     alignas(64) uint8_t fb[M6569_FRAMEBUFFER_SIZE_BYTES];
 
-    c1530_t c1530;      // optional datassette
-    c1541_t c1541;      // optional floppy drive
+    c1530_t c1530;      // optional datassette (mostly the tape buffer)
+    #if defined(CHIPS_PROFILE)
+    chips_profile_t profile;
+    #endif
 } c64_t;
 
 // initialize a new C64 instance
@@ -391,8 +597,16 @@ void c64_discard(c64_t* sys);
 void c64_reset(c64_t* sys);
 // get framebuffer and display attributes
 chips_display_info_t c64_display_info(c64_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t c64_observe(c64_t* sys);
 // tick C64 instance for a given number of microseconds, return number of ticks executed
 uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds);
+// run C64 emulation until the end of the current video frame, returns number of ticks
+uint32_t c64_exec_frame(c64_t* sys);
+// set the turbo mode speed factor (see 'Turbo Mode'), 0 or 1 to switch turbo mode off
+void c64_set_turbo(c64_t* sys, uint32_t factor);
+// get the achieved speed factor of the last exec call
+float c64_turbo_speed(c64_t* sys);
 // send a key-down event to the C64
 void c64_key_down(c64_t* sys, int key_code);
 // send a key-up event to the C64
@@ -417,10 +631,26 @@ void c64_tape_play(c64_t* sys);
 void c64_tape_stop(c64_t* sys);
 // return true if tape motor is on
 bool c64_is_tape_motor_on(c64_t* sys);
+// insert a .D64 disc image (c1541 or vdrive must be enabled)
+bool c64_insert_disc(c64_t* sys, chips_range_t data);
+// remove the current disc
+void c64_remove_disc(c64_t* sys);
+// return true if a disc is inserted into the virtual drive
+bool c64_disc_inserted(c64_t* sys);
+// type a caller-owned ASCII text through the KERNAL keyboard buffer (see 'Text Input')
+void c64_type_text(c64_t* sys, chips_range_t text);
+// return true while queued text is left to type
+bool c64_is_typing_text(c64_t* sys);
 // save a snapshot, patches pointers to zero and offsets, returns snapshot version
 uint32_t c64_save_snapshot(c64_t* sys, c64_t* dst);
 // load a snapshot, returns false if snapshot versions don't match
 bool c64_load_snapshot(c64_t* sys, uint32_t version, c64_t* src);
+// fast copy of the emulation state into another instance (see 'Fast State Copy')
+void c64_copy_state(c64_t* dst, c64_t* src);
+// create a new instance from an initialized template instance (see 'Cloning')
+void c64_clone(c64_t* dst, const c64_t* tmpl, const c64_clone_desc_t* desc);
+// hash the emulation state (see 'State Hash')
+uint64_t c64_state_hash(c64_t* sys);
 // perform a RUN BASIC call
 void c64_basic_run(c64_t* sys);
 // perform a LOAD BASIC call
@@ -429,6 +659,10 @@ void c64_basic_load(c64_t* sys);
 void c64_basic_syscall(c64_t* sys, uint16_t addr);
 // returns the SYS call return address (can be used to set a breakpoint)
 uint16_t c64_syscall_return_addr(void);
+#if defined(CHIPS_PROFILE)
+// get the profiling results (reset with chips_profile_reset())
+chips_profile_t* c64_profile_info(c64_t* sys);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -453,26 +687,82 @@ static uint16_t _c64_vic_fetch(uint16_t addr, void* user_data);
 static void _c64_update_memory_map(c64_t* sys);
 static void _c64_init_key_map(c64_t* sys);
 static void _c64_init_memory_map(c64_t* sys);
+static uint64_t _c64_kernal_trap(c64_t* sys, uint64_t pins, uint16_t addr);
 
 #define _C64_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
+// profiling sections and counters (only used with CHIPS_PROFILE)
+enum {
+    _C64_PROF_DRIVES,
+    _C64_PROF_CPU,
+    _C64_PROF_SID,
+    _C64_PROF_CIA,
+    _C64_PROF_VIC,
+    _C64_PROF_MEMIO,
+};
+enum {
+    _C64_PROF_MEM_RD,
+    _C64_PROF_MEM_WR,
+    _C64_PROF_IO_VIC,
+    _C64_PROF_IO_SID,
+    _C64_PROF_IO_CIA_1,
+    _C64_PROF_IO_CIA_2,
+    _C64_PROF_IO_COLOR,
+};
+
+// devices in the c64_t.io_map table
+#define _C64_IODEV_MEM      (0)     // memory access through mem_cpu
+#define _C64_IODEV_VIC      (1)     // VIC-II (D000..D3FF)
+#define _C64_IODEV_SID      (2)     // SID (D400..D7FF)
+#define _C64_IODEV_COLOR    (3)     // color RAM (D800..DBFF)
+#define _C64_IODEV_CIA_1    (4)     // CIA-1 (DC00..DCFF)
+#define _C64_IODEV_CIA_2    (5)     // CIA-2 (DD00..DDFF)
+#define _C64_IODEV_NONE     (6)     // expansion port IO area (DE00..DFFF), not connected
+
+// event scheduler slots
+#define _C64_SCHED_CIA_1 (0)
+#define _C64_SCHED_CIA_2 (1)
+#define _C64_SCHED_SID (2)
+#define _C64_NUM_SCHED_SLOTS (3)
+
 void c64_init(c64_t* sys, const c64_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
     if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
+    CHIPS_ASSERT(!(desc->c1541_enabled && desc->vdrive_enabled));
 
     memset(sys, 0, sizeof(c64_t));
     sys->valid = true;
     sys->joystick_type = desc->joystick_type;
+    #if defined(CHIPS_PROFILE)
+    static const char* prof_sections[] = { "Drives", "CPU", "SID", "CIA", "VIC-II", "Memory/IO", 0 };
+    static const char* prof_counters[] = { "Mem Read", "Mem Write", "VIC-II", "SID", "CIA-1", "CIA-2", "Color RAM", 0 };
+    chips_profile_init(&sys->profile, prof_sections, prof_counters);
+    #endif
     sys->debug = desc->debug;
+    sys->headless = desc->headless;
     sys->audio.callback = desc->audio.callback;
+    sys->vblank.callback = desc->vblank;
     sys->audio.num_samples = _C64_DEFAULT(desc->audio.num_samples, C64_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= C64_MAX_AUDIO_SAMPLES);
-    CHIPS_ASSERT(desc->roms.chars.ptr && (desc->roms.chars.size == sizeof(sys->rom_char)));
-    CHIPS_ASSERT(desc->roms.basic.ptr && (desc->roms.basic.size == sizeof(sys->rom_basic)));
-    CHIPS_ASSERT(desc->roms.kernal.ptr && (desc->roms.kernal.size == sizeof(sys->rom_kernal)));
-    memcpy(sys->rom_char, desc->roms.chars.ptr, sizeof(sys->rom_char));
-    memcpy(sys->rom_basic, desc->roms.basic.ptr, sizeof(sys->rom_basic));
-    memcpy(sys->rom_kernal, desc->roms.kernal.ptr, sizeof(sys->rom_kernal));
+    CHIPS_ASSERT(desc->roms.chars.ptr && (desc->roms.chars.size == 0x1000));
+    CHIPS_ASSERT(desc->roms.basic.ptr && (desc->roms.basic.size == 0x2000));
+    CHIPS_ASSERT(desc->roms.kernal.ptr && (desc->roms.kernal.size == 0x2000));
+    sys->rom_char_ptr = (const uint8_t*) desc->roms.chars.ptr;
+    sys->rom_basic_ptr = (const uint8_t*) desc->roms.basic.ptr;
+    sys->rom_kernal_ptr = (const uint8_t*) desc->roms.kernal.ptr;
+    #if defined(CHIPS_SHARED_ROMS)
+    sys->shared_roms = true;
+    #else
+    sys->shared_roms = desc->shared_roms;
+    if (!sys->shared_roms) {
+        memcpy(sys->rom_char, sys->rom_char_ptr, sizeof(sys->rom_char));
+        sys->rom_char_ptr = sys->rom_char;
+        memcpy(sys->rom_basic, sys->rom_basic_ptr, sizeof(sys->rom_basic));
+        sys->rom_basic_ptr = sys->rom_basic;
+        memcpy(sys->rom_kernal, sys->rom_kernal_ptr, sizeof(sys->rom_kernal));
+        sys->rom_kernal_ptr = sys->rom_kernal;
+    }
+    #endif
 
     // initialize the hardware
     sys->cpu_port = 0xF7;       // for initial memory mapping
@@ -488,6 +778,7 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
     });
     m6526_init(&sys->cia_1);
     m6526_init(&sys->cia_2);
+    chips_sched_init(&sys->sched, _C64_NUM_SCHED_SLOTS);
     m6569_init(&sys->vic, &(m6569_desc_t){
         .fetch_cb = _c64_vic_fetch,
         .framebuffer = {
@@ -501,11 +792,23 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
             .height = _C64_SCREEN_HEIGHT,
         },
         .user_data = sys,
+        .triple_buffer = desc->triple_buffer,
+        .vidlog = desc->vidlog,
     });
+    if (desc->triple_buffer) {
+        desc->triple_buffer->clock = &sys->tick;
+    }
+    if (desc->vidlog) {
+        chips_vidlog_set_range(desc->vidlog, 0, sys->ram, sizeof(sys->ram));
+        chips_vidlog_set_range(desc->vidlog, 1, sys->rom_char_ptr, 0x1000);
+        chips_vidlog_set_range(desc->vidlog, 2, sys->color_ram, sizeof(sys->color_ram));
+        chips_vidlog_write(desc->vidlog, 0, 0, C64_VIDLOG_REG_BANK, (uint8_t)(sys->vic_bank_select >> 14));
+    }
     m6581_init(&sys->sid, &(m6581_desc_t){
         .tick_hz = C64_FREQUENCY,
         .sound_hz = _C64_DEFAULT(desc->audio.sample_rate, 44100),
         .magnitude = _C64_DEFAULT(desc->audio.volume, 1.0f),
+        .lazy = true,
     });
     _c64_init_key_map(sys);
     _c64_init_memory_map(sys);
@@ -513,16 +816,23 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
         c1530_init(&sys->c1530, &(c1530_desc_t){
             .cas_port = &sys->cas_port,
         });
+        sys->tape_turbo = desc->c1530_turbo;
+        sys->tape_load_trap = desc->c1530_load_trap;
     }
     if (desc->c1541_enabled) {
         c1541_init(&sys->c1541, &(c1541_desc_t){
             .iec_port = &sys->iec_port,
+            .shared_roms = sys->shared_roms,
             .roms = {
                 .c000_dfff = desc->roms.c1541.c000_dfff,
                 .e000_ffff = desc->roms.c1541.e000_ffff
             },
         });
     }
+    if (desc->vdrive_enabled) {
+        c1541_vdrive_init(&sys->vdrive);
+    }
+    sys->kernal_traps = sys->vdrive.valid || sys->tape_load_trap;
 }
 
 void c64_discard(c64_t* sys) {
@@ -547,18 +857,221 @@ void c64_reset(c64_t* sys) {
     sys->pins |= M6502_RES;
     m6526_reset(&sys->cia_1);
     m6526_reset(&sys->cia_2);
+    chips_sched_init(&sys->sched, _C64_NUM_SCHED_SLOTS);
     m6569_reset(&sys->vic);
     m6581_reset(&sys->sid);
+    if (sys->vdrive.valid) {
+        c1541_vdrive_reset(&sys->vdrive);
+    }
+}
+
+/* tick the SID, returns the CPU pins
+
+    The SID is skipped while it's idle and not accessed by the CPU (in tape
+    turbo mode and in the skipped slices of turbo mode it's only ticked for
+    register accesses, see m6581.h 'Silent Mode').
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick_sid(c64_t* sys, uint64_t pins, uint64_t sid_pins) {
+    if ((sid_pins & M6581_CS) || (!sys->tape_turbo_active && !sys->sid.silent && chips_sched_due(&sys->sched, _C64_SCHED_SID))) {
+        const uint32_t skipped_ticks = chips_sched_sync(&sys->sched, _C64_SCHED_SID);
+        m6581_advance(&sys->sid, sys->tape_turbo_active ? 0 : skipped_ticks);
+        sid_pins = m6581_tick(&sys->sid, sid_pins);
+        if (sid_pins & M6581_SAMPLE) {
+            // new audio sample ready
+            chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->sid.sample, sys->tick);
+        }
+        if ((sid_pins & (M6581_CS|M6581_RW)) == (M6581_CS|M6581_RW)) {
+            pins = M6502_COPY_DATA(pins, sid_pins);
+        }
+        chips_sched_set(&sys->sched, _C64_SCHED_SID, m6581_idle_ticks(&sys->sid));
+    }
+    return pins;
+}
+
+/* tick CIA-1, returns the CPU pins
+
+    In Port A:
+        joystick 2 input
+    In Port B:
+        combined keyboard matrix columns and joystick 1
+    Cas Port Read => Flag pin
+
+    Out Port A:
+        write keyboard matrix lines
+
+    IRQ pin is connected to the CPU IRQ pin
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick_cia_1(c64_t* sys, uint64_t pins, uint64_t cia1_pins) {
+    // cassette port READ pin is connected to CIA-1 FLAG pin
+    const uint8_t pa = ~(sys->kbd_joy2_mask|sys->joy_joy2_mask);
+    const uint8_t pb = ~(kbd_scan_columns(&sys->kbd) | sys->kbd_joy1_mask | sys->joy_joy1_mask);
+    const bool cas_read = 0 != (sys->cas_port & C64_CASPORT_READ);
+    // the CIA is skipped while it's idle, not selected and its inputs don't change
+    if ((cia1_pins & M6526_CS) || chips_sched_due(&sys->sched, _C64_SCHED_CIA_1) ||
+        (pa != sys->cia_1.pa.inp) || (pb != sys->cia_1.pb.inp) || (cas_read != sys->cia_1.intr.flag))
+    {
+        m6526_advance(&sys->cia_1, chips_sched_sync(&sys->sched, _C64_SCHED_CIA_1));
+        M6526_SET_PAB(cia1_pins, pa, pb);
+        if (cas_read) {
+            cia1_pins |= M6526_FLAG;
+        }
+        cia1_pins = m6526_tick(&sys->cia_1, cia1_pins);
+        chips_sched_set(&sys->sched, _C64_SCHED_CIA_1, m6526_idle_ticks(&sys->cia_1));
+    }
+    else {
+        cia1_pins = sys->cia_1.pins & (M6526_PA_PINS|M6526_PB_PINS|M6526_IRQ);
+    }
+    const uint8_t kbd_lines = ~M6526_GET_PA(cia1_pins);
+    kbd_set_active_lines(&sys->kbd, kbd_lines);
+    if (cia1_pins & M6502_IRQ) {
+        pins |= M6502_IRQ;
+    }
+    if ((cia1_pins & (M6526_CS|M6526_RW)) == (M6526_CS|M6526_RW)) {
+        pins = M6502_COPY_DATA(pins, cia1_pins);
+    }
+    return pins;
+}
+
+/* tick CIA-2, returns the CPU pins
+
+    In Port A:
+        bits 0..5: output (see cia2_out)
+        bits 6..7: serial bus input, not implemented
+    In Port B:
+        RS232 / user functionality (not implemented)
+
+    Out Port A:
+        bits 0..1: VIC-II bank select:
+            00: bank 3 C000..FFFF
+            01: bank 2 8000..BFFF
+            10: bank 1 4000..7FFF
+            11: bank 0 0000..3FFF
+        bit 2: RS-232 TXD Outout (not implemented)
+        bit 3..5: serial bus output (not implemented)
+        bit 6..7: input (see cia2_in)
+    Out Port B:
+        RS232 / user functionality (not implemented)
+
+    CIA-2 IRQ pin connected to CPU NMI pin
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick_cia_2(c64_t* sys, uint64_t pins, uint64_t cia2_pins) {
+    if ((cia2_pins & M6526_CS) || chips_sched_due(&sys->sched, _C64_SCHED_CIA_2) ||
+        (0xFF != sys->cia_2.pa.inp) || (0xFF != sys->cia_2.pb.inp) || sys->cia_2.intr.flag)
+    {
+        m6526_advance(&sys->cia_2, chips_sched_sync(&sys->sched, _C64_SCHED_CIA_2));
+        M6526_SET_PAB(cia2_pins, 0xFF, 0xFF);
+        cia2_pins = m6526_tick(&sys->cia_2, cia2_pins);
+        chips_sched_set(&sys->sched, _C64_SCHED_CIA_2, m6526_idle_ticks(&sys->cia_2));
+    }
+    else {
+        cia2_pins = sys->cia_2.pins & (M6526_PA_PINS|M6526_PB_PINS|M6526_IRQ);
+    }
+    const uint16_t vic_bank_select = ((~M6526_GET_PA(cia2_pins))&3)<<14;
+    if (sys->vic.crt.vidlog && (vic_bank_select != sys->vic_bank_select)) {
+        chips_vidlog_write(sys->vic.crt.vidlog, sys->vic.rs.h_count, sys->vic.rs.v_count, C64_VIDLOG_REG_BANK, (uint8_t)(vic_bank_select >> 14));
+    }
+    sys->vic_bank_select = vic_bank_select;
+    if (cia2_pins & M6502_IRQ) {
+        pins |= M6502_NMI;
+    }
+    if ((cia2_pins & (M6526_CS|M6526_RW)) == (M6526_CS|M6526_RW)) {
+        pins = M6502_COPY_DATA(pins, cia2_pins);
+    }
+    return pins;
+}
+
+/* tick the VIC-II display chip, returns the CPU pins
+
+    - the VIC-II IRQ pin is connected to the CPU IRQ pin and goes
+    active when the VIC-II requests a rasterline interrupt
+    - the VIC-II BA pin is connected to the CPU RDY pin, and stops
+    the CPU on the first CPU read access after BA goes active
+    - the VIC-II AEC pin is connected to the CPU AEC pin, currently
+    this goes active during a badline, but is not checked
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick_vic(c64_t* sys, uint64_t pins, uint64_t vic_pins) {
+    vic_pins = m6569_tick(&sys->vic, vic_pins);
+    chips_vblank_update(&sys->vblank, sys->vic.rs.frame_count);
+    pins |= (vic_pins & (M6502_IRQ|M6502_RDY|M6510_AEC));
+    if ((vic_pins & (M6569_CS|M6569_RW)) == (M6569_CS|M6569_RW)) {
+        pins = M6502_COPY_DATA(pins, vic_pins);
+    }
+    return pins;
+}
+
+// run the C1541 for the pending drive ticks, must be called before the IEC port changes
+static void _c64_sync_c1541(c64_t* sys) {
+    if (sys->c1541_ticks > 0) {
+        c1541_run(&sys->c1541, sys->c1541_ticks);
+        sys->c1541_ticks = 0;
+    }
 }
 
-static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
+static CHIPS_FORCE_INLINE void _c64_tick_drives(c64_t* sys, bool has_c1530, bool has_c1541) {
     // FIXME: move datasette and floppy tick to end
-    if (sys->c1530.valid) {
+    if (has_c1530) {
         c1530_tick(&sys->c1530);
     }
-    if (sys->c1541.valid) {
-        c1541_tick(&sys->c1541);
+    if (has_c1541) {
+        // the drive runs in bursts (see 'Drive Interleaving')
+        if (++sys->c1541_ticks == C64_C1541_BURST_TICKS) {
+            _c64_sync_c1541(sys);
+        }
+    }
+}
+
+/* tick the system while the VIC-II stalls the CPU in a memory read
+
+    While the RDY pin is active in a CPU read cycle (during bad lines and
+    sprite DMA), the CPU only samples its interrupt pins and repeats the
+    read cycle. If the stalled read goes to RAM or ROM (and isn't an opcode
+    fetch which might be trapped), the data bus still holds the result of
+    the same read in the previous tick, so address decoding and the memory
+    access can be skipped.
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick_stalled(c64_t* sys, uint64_t pins, bool has_c1530, bool has_c1541) {
+    CHIPS_PROFILE_TICK_BEGIN(&sys->profile);
+    _c64_tick_drives(sys, has_c1530, has_c1541);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_DRIVES);
+
+    // the CPU returns early from the stalled read cycle
+    pins = m6502_tick(&sys->cpu, pins);
+    pins &= ~(M6502_IRQ|M6502_NMI|M6502_RDY|M6510_AEC);
+    const uint64_t chip_pins = pins & M6502_PIN_MASK;
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_CPU);
+
+    pins = _c64_tick_sid(sys, pins, chip_pins);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_SID);
+
+    pins = _c64_tick_cia_1(sys, pins, chip_pins);
+    pins = _c64_tick_cia_2(sys, pins, chip_pins);
+    // the RESTORE key is connected to the NMI line
+    if(sys->kbd.scanout_column_masks[8] & 1) {
+        pins |= M6502_NMI;
+    }
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_CIA);
+
+    pins = _c64_tick_vic(sys, pins, chip_pins);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_VIC);
+
+    chips_sched_tick(&sys->sched);
+    CHIPS_PROFILE_TICK_END(&sys->profile, _C64_PROF_MEMIO);
+    return pins;
+}
+
+/* the system tick function, has_c1530 and has_c1541 are compile-time
+    constants in the specialized tick functions below
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick(c64_t* sys, uint64_t pins, bool has_c1530, bool has_c1541) {
+    sys->tick++;
+    if (((pins & (M6502_RDY|M6502_RW|M6502_SYNC)) == (M6502_RDY|M6502_RW)) &&
+        !M6510_CHECK_IO(pins) && (sys->io_map[M6502_GET_ADDR(pins) >> 8] == _C64_IODEV_MEM))
+    {
+        return _c64_tick_stalled(sys, pins, has_c1530, has_c1541);
     }
+    CHIPS_PROFILE_TICK_BEGIN(&sys->profile);
+    _c64_tick_drives(sys, has_c1530, has_c1541);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_DRIVES);
 
     // tick the CPU
     pins = m6502_tick(&sys->cpu, pins);
@@ -584,137 +1097,34 @@ static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
             cpu_io_access = true;
         }
         else {
-            if (sys->io_mapped && ((addr & 0xF000) == 0xD000)) {
-                if (addr < 0xD400) {
-                    // VIC-II (D000..D3FF)
-                    vic_pins |= M6569_CS;
-                }
-                else if (addr < 0xD800) {
-                    // SID (D400..D7FF)
-                    sid_pins |= M6581_CS;
-                }
-                else if (addr < 0xDC00) {
-                    // read or write the special color Static-RAM bank (D800..DBFF)
-                    color_ram_access = true;
-                }
-                else if (addr < 0xDD00) {
-                    // CIA-1 (DC00..DCFF)
-                    cia1_pins |= M6526_CS;
-                }
-                else if (addr < 0xDE00) {
-                    // CIA-2 (DD00..DDFF)
-                    cia2_pins |= M6526_CS;
-                }
-            }
-            else {
-                mem_access = true;
-            }
-        }
-    }
-
-    // tick the SID
-    {
-        sid_pins = m6581_tick(&sys->sid, sid_pins);
-        if (sid_pins & M6581_SAMPLE) {
-            // new audio sample ready
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->sid.sample;
-            if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
-                sys->audio.sample_pos = 0;
+            switch (sys->io_map[addr >> 8]) {
+                case _C64_IODEV_MEM:    mem_access = true; break;
+                case _C64_IODEV_VIC:    vic_pins |= M6569_CS; CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_IO_VIC); break;
+                case _C64_IODEV_SID:    sid_pins |= M6581_CS; CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_IO_SID); break;
+                // read or write the special color Static-RAM bank
+                case _C64_IODEV_COLOR:  color_ram_access = true; CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_IO_COLOR); break;
+                case _C64_IODEV_CIA_1:  cia1_pins |= M6526_CS; CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_IO_CIA_1); break;
+                case _C64_IODEV_CIA_2:  cia2_pins |= M6526_CS; CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_IO_CIA_2); break;
+                default: break;
             }
         }
-        if ((sid_pins & (M6581_CS|M6581_RW)) == (M6581_CS|M6581_RW)) {
-            pins = M6502_COPY_DATA(pins, sid_pins);
-        }
     }
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_CPU);
 
-    /* tick CIA-1:
-
-        In Port A:
-            joystick 2 input
-        In Port B:
-            combined keyboard matrix columns and joystick 1
-        Cas Port Read => Flag pin
-
-        Out Port A:
-            write keyboard matrix lines
-
-        IRQ pin is connected to the CPU IRQ pin
-    */
-    {
-        // cassette port READ pin is connected to CIA-1 FLAG pin
-        const uint8_t pa = ~(sys->kbd_joy2_mask|sys->joy_joy2_mask);
-        const uint8_t pb = ~(kbd_scan_columns(&sys->kbd) | sys->kbd_joy1_mask | sys->joy_joy1_mask);
-        M6526_SET_PAB(cia1_pins, pa, pb);
-        if (sys->cas_port & C64_CASPORT_READ) {
-            cia1_pins |= M6526_FLAG;
-        }
-        cia1_pins = m6526_tick(&sys->cia_1, cia1_pins);
-        const uint8_t kbd_lines = ~M6526_GET_PA(cia1_pins);
-        kbd_set_active_lines(&sys->kbd, kbd_lines);
-        if (cia1_pins & M6502_IRQ) {
-            pins |= M6502_IRQ;
-        }
-        if ((cia1_pins & (M6526_CS|M6526_RW)) == (M6526_CS|M6526_RW)) {
-            pins = M6502_COPY_DATA(pins, cia1_pins);
-        }
-    }
+    pins = _c64_tick_sid(sys, pins, sid_pins);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_SID);
 
-    /* tick CIA-2
-        In Port A:
-            bits 0..5: output (see cia2_out)
-            bits 6..7: serial bus input, not implemented
-        In Port B:
-            RS232 / user functionality (not implemented)
-
-        Out Port A:
-            bits 0..1: VIC-II bank select:
-                00: bank 3 C000..FFFF
-                01: bank 2 8000..BFFF
-                10: bank 1 4000..7FFF
-                11: bank 0 0000..3FFF
-            bit 2: RS-232 TXD Outout (not implemented)
-            bit 3..5: serial bus output (not implemented)
-            bit 6..7: input (see cia2_in)
-        Out Port B:
-            RS232 / user functionality (not implemented)
-
-        CIA-2 IRQ pin connected to CPU NMI pin
-    */
-    {
-        M6526_SET_PAB(cia2_pins, 0xFF, 0xFF);
-        cia2_pins = m6526_tick(&sys->cia_2, cia2_pins);
-        sys->vic_bank_select = ((~M6526_GET_PA(cia2_pins))&3)<<14;
-        if (cia2_pins & M6502_IRQ) {
-            pins |= M6502_NMI;
-        }
-        if ((cia2_pins & (M6526_CS|M6526_RW)) == (M6526_CS|M6526_RW)) {
-            pins = M6502_COPY_DATA(pins, cia2_pins);
-        }
-    }
+    pins = _c64_tick_cia_1(sys, pins, cia1_pins);
+    pins = _c64_tick_cia_2(sys, pins, cia2_pins);
 
     // the RESTORE key, along with CIA-2 IRQ, is connected to the NMI line,
     if(sys->kbd.scanout_column_masks[8] & 1) {
         pins |= M6502_NMI;
     }
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_CIA);
 
-    /* tick the VIC-II display chip:
-        - the VIC-II IRQ pin is connected to the CPU IRQ pin and goes
-        active when the VIC-II requests a rasterline interrupt
-        - the VIC-II BA pin is connected to the CPU RDY pin, and stops
-        the CPU on the first CPU read access after BA goes active
-        - the VIC-II AEC pin is connected to the CPU AEC pin, currently
-        this goes active during a badline, but is not checked
-    */
-    {
-        vic_pins = m6569_tick(&sys->vic, vic_pins);
-        pins |= (vic_pins & (M6502_IRQ|M6502_RDY|M6510_AEC));
-        if ((vic_pins & (M6569_CS|M6569_RW)) == (M6569_CS|M6569_RW)) {
-            pins = M6502_COPY_DATA(pins, vic_pins);
-        }
-    }
+    pins = _c64_tick_vic(sys, pins, vic_pins);
+    CHIPS_PROFILE_MARK(&sys->profile, _C64_PROF_VIC);
 
     /* remaining CPU IO and memory accesses, those don't fit into the
        "universal tick model" (yet?)
@@ -734,16 +1144,44 @@ static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
     else if (mem_access) {
         if (pins & M6502_RW) {
             // memory read
+            CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_MEM_RD);
             M6502_SET_DATA(pins, mem_rd(&sys->mem_cpu, addr));
         }
         else {
             // memory write
+            CHIPS_PROFILE_COUNT(&sys->profile, _C64_PROF_MEM_WR);
             mem_wr(&sys->mem_cpu, addr, M6502_GET_DATA(pins));
         }
     }
+
+    // intercept KERNAL routines for the virtual drive and tape load trap
+    if (sys->kernal_traps && (pins & M6502_SYNC) && (sys->cpu_port & C64_CPUPORT_HIRAM) && (addr >= 0xED09)) {
+        pins = _c64_kernal_trap(sys, pins, addr);
+    }
+    chips_sched_tick(&sys->sched);
+    CHIPS_PROFILE_TICK_END(&sys->profile, _C64_PROF_MEMIO);
     return pins;
 }
 
+/* tick functions specialized for the optional datasette and floppy drive,
+    so that the checks for absent hardware disappear from the inner loop
+*/
+typedef uint64_t (*_c64_tick_func_t)(c64_t* sys, uint64_t pins);
+static uint64_t _c64_tick_basic(c64_t* sys, uint64_t pins)      { return _c64_tick(sys, pins, false, false); }
+static uint64_t _c64_tick_c1530(c64_t* sys, uint64_t pins)      { return _c64_tick(sys, pins, true, false); }
+static uint64_t _c64_tick_c1541(c64_t* sys, uint64_t pins)      { return _c64_tick(sys, pins, false, true); }
+static uint64_t _c64_tick_c1530_c1541(c64_t* sys, uint64_t pins) { return _c64_tick(sys, pins, true, true); }
+
+// select the tick function for the attached drives
+static _c64_tick_func_t _c64_tick_func(const c64_t* sys) {
+    if (sys->c1530.valid) {
+        return sys->c1541.valid ? _c64_tick_c1530_c1541 : _c64_tick_c1530;
+    }
+    else {
+        return sys->c1541.valid ? _c64_tick_c1541 : _c64_tick_basic;
+    }
+}
+
 static uint8_t _c64_cpu_port_in(void* user_data) {
     c64_t* sys = (c64_t*) user_data;
     /*
@@ -807,7 +1245,7 @@ static uint16_t _c64_vic_fetch(uint16_t addr, void* user_data) {
 
 static void _c64_update_memory_map(c64_t* sys) {
     sys->io_mapped = false;
-    uint8_t* read_ptr;
+    const uint8_t* read_ptr;
     // shortcut if HIRAM and LORAM is 0, everything is RAM
     if ((sys->cpu_port & (C64_CPUPORT_HIRAM|C64_CPUPORT_LORAM)) == 0) {
         mem_map_ram(&sys->mem_cpu, 0, 0xA000, 0x6000, sys->ram+0xA000);
@@ -815,7 +1253,7 @@ static void _c64_update_memory_map(c64_t* sys) {
     else {
         // A000..BFFF is either RAM-behind-BASIC-ROM or RAM
         if ((sys->cpu_port & (C64_CPUPORT_HIRAM|C64_CPUPORT_LORAM)) == (C64_CPUPORT_HIRAM|C64_CPUPORT_LORAM)) {
-            read_ptr = sys->rom_basic;
+            read_ptr = sys->rom_basic_ptr;
         }
         else {
             read_ptr = sys->ram + 0xA000;
@@ -824,7 +1262,7 @@ static void _c64_update_memory_map(c64_t* sys) {
 
         // E000..FFFF is either RAM-behind-KERNAL-ROM or RAM
         if (sys->cpu_port & C64_CPUPORT_HIRAM) {
-            read_ptr = sys->rom_kernal;
+            read_ptr = sys->rom_kernal_ptr;
         }
         else {
             read_ptr = sys->ram + 0xE000;
@@ -836,9 +1274,22 @@ static void _c64_update_memory_map(c64_t* sys) {
             sys->io_mapped = true;
         }
         else {
-            mem_map_rw(&sys->mem_cpu, 0, 0xD000, 0x1000, sys->rom_char, sys->ram+0xD000);
+            mem_map_rw(&sys->mem_cpu, 0, 0xD000, 0x1000, sys->rom_char_ptr, sys->ram+0xD000);
         }
     }
+
+    // update the IO device map for the D000..DFFF pages
+    if (sys->io_mapped) {
+        memset(&sys->io_map[0xD0], _C64_IODEV_VIC, 4);
+        memset(&sys->io_map[0xD4], _C64_IODEV_SID, 4);
+        memset(&sys->io_map[0xD8], _C64_IODEV_COLOR, 4);
+        sys->io_map[0xDC] = _C64_IODEV_CIA_1;
+        sys->io_map[0xDD] = _C64_IODEV_CIA_2;
+        memset(&sys->io_map[0xDE], _C64_IODEV_NONE, 2);
+    }
+    else {
+        memset(&sys->io_map[0xD0], _C64_IODEV_MEM, 16);
+    }
 }
 
 static void _c64_init_memory_map(c64_t* sys) {
@@ -876,8 +1327,8 @@ static void _c64_init_memory_map(c64_t* sys) {
        character ROMS at 0x1000.0x1FFF and 0x9000..0x9FFF
     */
     mem_map_ram(&sys->mem_vic, 1, 0x0000, 0x10000, sys->ram);
-    mem_map_rom(&sys->mem_vic, 0, 0x1000, 0x1000, sys->rom_char);
-    mem_map_rom(&sys->mem_vic, 0, 0x9000, 0x1000, sys->rom_char);
+    mem_map_rom(&sys->mem_vic, 0, 0x1000, 0x1000, sys->rom_char_ptr);
+    mem_map_rom(&sys->mem_vic, 0, 0x9000, 0x1000, sys->rom_char_ptr);
 }
 
 static void _c64_init_key_map(c64_t* sys) {
@@ -950,26 +1401,167 @@ static void _c64_init_key_map(c64_t* sys) {
     kbd_register_key(&sys->kbd, C64_KEY_F8      , 3, 0, 1);    // F8
 }
 
-uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds) {
-    CHIPS_ASSERT(sys && sys->valid);
-    uint32_t num_ticks = clk_us_to_ticks(C64_FREQUENCY, micro_seconds);
+// true while the tape turbo mode should be active
+static inline bool _c64_tape_turbo(c64_t* sys) {
+    return sys->tape_turbo && !(sys->cas_port & C64_CASPORT_MOTOR) && (sys->c1530.pos < sys->c1530.size);
+}
+
+/* run for num_ticks (or up to max_ticks in tape turbo mode), stop early at
+    the end of the current video frame if to_frame_end is true
+*/
+static uint32_t _c64_run(c64_t* sys, uint32_t num_ticks, uint32_t max_ticks, bool to_frame_end) {
+    const uint32_t frame_count = sys->vic.rs.frame_count;
+    const _c64_tick_func_t tick = _c64_tick_func(sys);
     uint64_t pins = sys->pins;
+    uint32_t ticks = 0;
     if (0 == sys->debug.callback.func) {
         // run without debug callback
-        for (uint32_t ticks = 0; ticks < num_ticks; ticks++) {
-            pins = _c64_tick(sys, pins);
+        for (; ((ticks < num_ticks) || ((ticks < max_ticks) && _c64_tape_turbo(sys))) &&
+               (!to_frame_end || (frame_count == sys->vic.rs.frame_count)); ticks++)
+        {
+            pins = tick(sys, pins);
         }
     }
     else {
-        // run with debug callback
-        for (uint32_t ticks = 0; (ticks < num_ticks) && !(*sys->debug.stopped); ticks++) {
-            pins = _c64_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+        // run with debug callback, if a breakpoint map is attached, only
+        // call the debug callback when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
+        for (; ((ticks < num_ticks) || ((ticks < max_ticks) && _c64_tape_turbo(sys))) &&
+               (!to_frame_end || (frame_count == sys->vic.rs.frame_count)) && !(*sys->debug.stopped); ticks++)
+        {
+            pins = tick(sys, pins);
+            if (!map || chips_breakmap_hit(map, M6502_GET_ADDR(pins), pins & M6502_SYNC, pins & M6502_RW, !(pins & M6502_RW))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    return ticks;
+}
+
+// bring the CIAs and the C1541 up to date for debugging UIs and snapshots
+static void _c64_exec_done(c64_t* sys) {
+    _c64_sync_c1541(sys);
+    m6526_advance(&sys->cia_1, chips_sched_sync(&sys->sched, _C64_SCHED_CIA_1));
+    m6526_advance(&sys->cia_2, chips_sched_sync(&sys->sched, _C64_SCHED_CIA_2));
+    // in tape turbo mode, the SID doesn't count the skipped ticks
+    const uint32_t sid_ticks = chips_sched_sync(&sys->sched, _C64_SCHED_SID);
+    m6581_advance(&sys->sid, sys->tape_turbo_active ? 0 : sid_ticks);
+    if (sys->sid.silent) {
+        // bring the SID generators up to date before audio output is switched on again
+        m6581_sync(&sys->sid);
+    }
+    sys->tape_turbo_active = false;
+}
+
+// refill the empty KERNAL keyboard buffer from the text input queue
+static void _c64_text_input(c64_t* sys) {
+    chips_text_input_t* ti = &sys->text_input;
+    if (!chips_text_input_pending(ti) || (mem_rd(&sys->mem_cpu, 0xC6) != 0)) {
+        return;
+    }
+    // the buffer at 0277 has room for 10 characters, 0289 may limit this further
+    uint8_t max_len = mem_rd(&sys->mem_cpu, 0x0289);
+    if ((max_len == 0) || (max_len > 10)) {
+        max_len = 10;
+    }
+    uint8_t num = 0;
+    while ((num < max_len) && chips_text_input_pending(ti)) {
+        int c = chips_text_input_next(ti);
+        if (c == '\n') {
+            c = 0x0D;
+        }
+        else if ((c >= 'a') && (c <= 'z')) {
+            c -= 0x20;
+        }
+        else if ((c < 0x20) || (c > 0x5F)) {
+            continue;
+        }
+        mem_wr(&sys->mem_cpu, 0x0277 + num++, (uint8_t)c);
+    }
+    if (num > 0) {
+        mem_wr(&sys->mem_cpu, 0xC6, num);
+    }
+}
+
+// run one slice of c64_exec(), in turbo mode all but the last slice skip video and audio output
+static uint32_t _c64_exec_slice(c64_t* sys, uint32_t micro_seconds) {
+    sys->vic.headless = sys->turbo.skip || chips_headless_update(&sys->headless);
+    sys->sid.silent = sys->turbo.skip;
+    _c64_text_input(sys);
+    uint32_t num_ticks = clk_us_to_ticks(C64_FREQUENCY, micro_seconds);
+    // in tape turbo mode, keep running beyond num_ticks until the tape motor stops
+    uint32_t max_ticks = num_ticks;
+    sys->tape_turbo_active = _c64_tape_turbo(sys);
+    if (sys->tape_turbo_active) {
+        max_ticks = num_ticks * C64_TAPE_TURBO_FACTOR;
+        sys->vic.headless = true;
+    }
+    const uint32_t ticks = _c64_run(sys, num_ticks, max_ticks, false);
+    _c64_exec_done(sys);
     kbd_update(&sys->kbd, micro_seconds);
-    return num_ticks;
+    return ticks;
+}
+
+uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds) {
+    CHIPS_ASSERT(sys && sys->valid);
+    CHIPS_PROFILE_EXEC_BEGIN(&sys->profile);
+    const uint32_t num_slices = chips_turbo_slices(&sys->turbo);
+    uint32_t ticks = 0;
+    for (uint32_t i = 0; (i < num_slices) && ((0 == i) || !(sys->debug.stopped && *sys->debug.stopped)); i++) {
+        sys->turbo.skip = (i + 1) < num_slices;
+        ticks += _c64_exec_slice(sys, micro_seconds);
+    }
+    chips_turbo_done(&sys->turbo, ticks, clk_us_to_ticks(C64_FREQUENCY, micro_seconds));
+    CHIPS_PROFILE_EXEC_END(&sys->profile, ticks);
+    return ticks;
+}
+
+// run one video frame of c64_exec_frame()
+static uint32_t _c64_exec_frame_slice(c64_t* sys) {
+    sys->vic.headless = sys->turbo.skip || chips_headless_update(&sys->headless);
+    sys->sid.silent = sys->turbo.skip;
+    _c64_text_input(sys);
+    // safety limit of two frames
+    const uint32_t max_frame_ticks = 2 * M6569_HTOTAL * M6569_VTOTAL;
+    // in tape turbo mode, keep running whole frames until the tape motor stops
+    int num_frames = 1;
+    sys->tape_turbo_active = _c64_tape_turbo(sys);
+    if (sys->tape_turbo_active) {
+        num_frames = C64_TAPE_TURBO_FACTOR;
+        sys->vic.headless = true;
+    }
+    uint32_t ticks = 0;
+    for (int i = 0; (i < num_frames) && ((0 == i) || _c64_tape_turbo(sys)); i++) {
+        ticks += _c64_run(sys, max_frame_ticks, max_frame_ticks, true);
+    }
+    _c64_exec_done(sys);
+    kbd_update(&sys->kbd, clk_ticks_to_us(C64_FREQUENCY, ticks, &sys->frame_us_rem));
+    return ticks;
+}
+
+uint32_t c64_exec_frame(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    CHIPS_PROFILE_EXEC_BEGIN(&sys->profile);
+    const uint32_t num_slices = chips_turbo_slices(&sys->turbo);
+    uint32_t ticks = 0;
+    for (uint32_t i = 0; (i < num_slices) && ((0 == i) || !(sys->debug.stopped && *sys->debug.stopped)); i++) {
+        sys->turbo.skip = (i + 1) < num_slices;
+        ticks += _c64_exec_frame_slice(sys);
+    }
+    chips_turbo_done(&sys->turbo, ticks, M6569_HTOTAL * M6569_VTOTAL);
+    CHIPS_PROFILE_EXEC_END(&sys->profile, ticks);
+    return ticks;
+}
+
+void c64_set_turbo(c64_t* sys, uint32_t factor) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->turbo.factor = factor;
+}
+
+float c64_turbo_speed(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->turbo.speed;
 }
 
 void c64_key_down(c64_t* sys, int key_code) {
@@ -1063,9 +1655,8 @@ bool c64_quickload(c64_t* sys, chips_range_t data) {
     const uint16_t start_addr = ptr[1]<<8 | ptr[0];
     ptr += 2;
     const uint16_t end_addr = start_addr + (data.size - 2);
-    uint16_t addr = start_addr;
-    while (addr < end_addr) {
-        mem_wr(&sys->mem_cpu, addr++, *ptr++);
+    if (end_addr > start_addr) {
+        mem_write_range(&sys->mem_cpu, start_addr, ptr, end_addr - start_addr);
     }
 
     // update the BASIC pointers
@@ -1108,6 +1699,327 @@ bool c64_is_tape_motor_on(c64_t* sys) {
     return c1530_is_motor_on(&sys->c1530);
 }
 
+bool c64_insert_disc(c64_t* sys, chips_range_t data) {
+    CHIPS_ASSERT(sys && sys->valid && (sys->c1541.valid || sys->vdrive.valid));
+    if (sys->vdrive.valid) {
+        return c1541_vdrive_insert_disc(&sys->vdrive, data);
+    }
+    c1541_insert_disc(&sys->c1541, data);
+    return true;
+}
+
+void c64_remove_disc(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid && (sys->c1541.valid || sys->vdrive.valid));
+    if (sys->vdrive.valid) {
+        c1541_vdrive_remove_disc(&sys->vdrive);
+    }
+    else {
+        c1541_remove_disc(&sys->c1541);
+    }
+}
+
+bool c64_disc_inserted(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->vdrive.valid && c1541_vdrive_disc_inserted(&sys->vdrive);
+}
+
+void c64_type_text(c64_t* sys, chips_range_t text) {
+    CHIPS_ASSERT(sys && sys->valid);
+    chips_text_input_start(&sys->text_input, text);
+}
+
+bool c64_is_typing_text(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return chips_text_input_pending(&sys->text_input);
+}
+
+/*
+    KERNAL traps (virtual drive and tape load)
+
+    The trap handlers run at the opcode fetch of a KERNAL routine's entry
+    point, perform the routine natively and return to the caller through
+    a simulated RTS.
+*/
+#define _C64_VDRIVE_DEVICE (8)
+
+// KERNAL status byte (ST) and the zero page file parameters
+#define _C64_KERNAL_ST      (0x90)
+#define _C64_KERNAL_FNLEN   (0xB7)
+#define _C64_KERNAL_SA      (0xB9)
+#define _C64_KERNAL_FA      (0xBA)
+#define _C64_KERNAL_FNADR   (0xBB)
+#define _C64_KERNAL_STAL    (0xC1)
+#define _C64_KERNAL_MEMUSS  (0xC3)
+#define _C64_KERNAL_EAL     (0xAE)
+
+// KERNAL error codes returned in A with carry set
+#define _C64_KERNAL_ERR_FILE_NOT_FOUND (4)
+#define _C64_KERNAL_ERR_MISSING_FILE_NAME (8)
+
+// continue with an RTS, carry flag signals an error
+static uint64_t _c64_kernal_return(c64_t* sys, uint64_t pins, bool carry) {
+    const uint8_t s = sys->cpu.S;
+    const uint16_t lo = mem_rd(&sys->mem_cpu, 0x0100 | (uint8_t)(s + 1));
+    const uint16_t hi = mem_rd(&sys->mem_cpu, 0x0100 | (uint8_t)(s + 2));
+    sys->cpu.S = s + 2;
+    sys->cpu.P = carry ? (sys->cpu.P | M6502_CF) : (sys->cpu.P & ~M6502_CF);
+    const uint16_t pc = ((hi << 8) | lo) + 1;
+    M6502_SET_ADDR(pins, pc);
+    M6502_SET_DATA(pins, mem_rd(&sys->mem_cpu, pc));
+    m6502_set_pc(&sys->cpu, pc);
+    return pins;
+}
+
+static uint64_t _c64_kernal_error(c64_t* sys, uint64_t pins, uint8_t err) {
+    m6502_set_a(&sys->cpu, err);
+    return _c64_kernal_return(sys, pins, true);
+}
+
+// copy the current KERNAL file name, returns its length
+static int _c64_kernal_file_name(c64_t* sys, uint8_t* buf) {
+    int len = mem_rd(&sys->mem_cpu, _C64_KERNAL_FNLEN);
+    if (len > C1541_VDRIVE_MAX_NAME) {
+        len = C1541_VDRIVE_MAX_NAME;
+    }
+    const uint16_t addr = mem_rd16(&sys->mem_cpu, _C64_KERNAL_FNADR);
+    for (int i = 0; i < len; i++) {
+        buf[i] = mem_rd(&sys->mem_cpu, (uint16_t)(addr + i));
+    }
+    return len;
+}
+
+// LOAD/VERIFY from the virtual drive in one go (A: 0 = load, else verify)
+static uint64_t _c64_vdrive_load(c64_t* sys, uint64_t pins) {
+    c1541_vdrive_t* vd = &sys->vdrive;
+    mem_t* mem = &sys->mem_cpu;
+    const bool verify = 0 != m6502_a(&sys->cpu);
+    uint8_t name[C1541_VDRIVE_MAX_NAME];
+    const int name_len = _c64_kernal_file_name(sys, name);
+    mem_wr(mem, _C64_KERNAL_ST, 0);
+    if (name_len == 0) {
+        return _c64_kernal_error(sys, pins, _C64_KERNAL_ERR_MISSING_FILE_NAME);
+    }
+    if (!c1541_vdrive_open(vd, 0, name, name_len)) {
+        return _c64_kernal_error(sys, pins, _C64_KERNAL_ERR_FILE_NOT_FOUND);
+    }
+    bool eoi = false;
+    const int lo = c1541_vdrive_read(vd, 0, &eoi);
+    const int hi = eoi ? -1 : c1541_vdrive_read(vd, 0, &eoi);
+    if ((lo < 0) || (hi < 0)) {
+        c1541_vdrive_close(vd, 0);
+        return _c64_kernal_error(sys, pins, _C64_KERNAL_ERR_FILE_NOT_FOUND);
+    }
+    // secondary address 0 relocates to the address in X/Y
+    uint16_t addr = (uint16_t)((hi << 8) | lo);
+    if (mem_rd(mem, _C64_KERNAL_SA) == 0) {
+        addr = mem_rd16(mem, _C64_KERNAL_MEMUSS);
+    }
+    uint8_t st = 0;
+    while (!eoi) {
+        const int data = c1541_vdrive_read(vd, 0, &eoi);
+        if (data < 0) {
+            break;
+        }
+        if (verify) {
+            if (mem_rd(mem, addr) != data) {
+                st |= 0x10;
+            }
+        }
+        else {
+            mem_wr(mem, addr, (uint8_t)data);
+        }
+        addr++;
+    }
+    c1541_vdrive_close(vd, 0);
+    mem_wr16(mem, _C64_KERNAL_EAL, addr);
+    mem_wr(mem, _C64_KERNAL_ST, st | 0x40);
+    m6502_set_x(&sys->cpu, (uint8_t)addr);
+    m6502_set_y(&sys->cpu, (uint8_t)(addr >> 8));
+    return _c64_kernal_return(sys, pins, false);
+}
+
+// SAVE the memory range (STAL)..(EAL) to the virtual drive
+static uint64_t _c64_vdrive_save(c64_t* sys, uint64_t pins) {
+    c1541_vdrive_t* vd = &sys->vdrive;
+    mem_t* mem = &sys->mem_cpu;
+    uint8_t name[C1541_VDRIVE_MAX_NAME];
+    const int name_len = _c64_kernal_file_name(sys, name);
+    mem_wr(mem, _C64_KERNAL_ST, 0);
+    if (name_len == 0) {
+        return _c64_kernal_error(sys, pins, _C64_KERNAL_ERR_MISSING_FILE_NAME);
+    }
+    // like on a real drive, write errors are only reported through the DOS status
+    if (c1541_vdrive_open(vd, 1, name, name_len)) {
+        const uint16_t start = mem_rd16(mem, _C64_KERNAL_STAL);
+        const uint16_t end = mem_rd16(mem, _C64_KERNAL_EAL);
+        bool ok = c1541_vdrive_write(vd, 1, (uint8_t)start) && c1541_vdrive_write(vd, 1, (uint8_t)(start >> 8));
+        for (uint16_t addr = start; ok && (addr != end); addr++) {
+            ok = c1541_vdrive_write(vd, 1, mem_rd(mem, addr));
+        }
+        c1541_vdrive_close(vd, 1);
+    }
+    return _c64_kernal_return(sys, pins, false);
+}
+
+/*
+    KERNAL tape LOAD trap: decode the next matching file in the standard
+    KERNAL tape encoding into memory, or let the KERNAL routine run if
+    that isn't possible
+*/
+static uint64_t _c64_tape_load(c64_t* sys, uint64_t pins) {
+    c1530_t* tape = &sys->c1530;
+    mem_t* mem = &sys->mem_cpu;
+    const uint32_t start_pos = tape->pos;
+    if (m6502_a(&sys->cpu) != 0) {
+        // VERIFY isn't trapped
+        return pins;
+    }
+    uint8_t name[C1541_VDRIVE_MAX_NAME];
+    const int name_len = _c64_kernal_file_name(sys, name);
+    uint8_t hdr[192];
+    bool repeat = false;
+    // find the next program header block with a matching file name
+    bool found = false;
+    while (!found) {
+        const int len = c1530_read_block(tape, hdr, sizeof(hdr), &repeat);
+        if ((len < 0) || (hdr[0] == 5)) {
+            // no more blocks or end-of-tape header
+            tape->pos = start_pos;
+            return pins;
+        }
+        if (repeat || (len != (int)sizeof(hdr)) || ((hdr[0] != 1) && (hdr[0] != 3))) {
+            continue;
+        }
+        found = true;
+        for (int i = 0; (i < name_len) && (i < 16); i++) {
+            if (name[i] != hdr[5 + i]) {
+                found = false;
+                break;
+            }
+        }
+    }
+    const uint16_t start = hdr[1] | (hdr[2]<<8);
+    const uint16_t end = hdr[3] | (hdr[4]<<8);
+    // relocatable programs (type 1) are loaded to X/Y with secondary address 0
+    uint16_t addr = start;
+    if ((hdr[0] == 1) && (mem_rd(mem, _C64_KERNAL_SA) == 0)) {
+        addr = mem_rd16(mem, _C64_KERNAL_MEMUSS);
+    }
+    const int len = (int)end - (int)start;
+    // the data block is the next block which isn't a repeated copy, validate before loading
+    uint32_t data_pos;
+    int data_len;
+    do {
+        data_pos = tape->pos;
+        data_len = c1530_read_block(tape, 0, 0, &repeat);
+    } while ((data_len >= 0) && repeat);
+    if ((len <= 0) || (data_len != len) || (((int)addr + len) > 0x10000)) {
+        tape->pos = start_pos;
+        return pins;
+    }
+    tape->pos = data_pos;
+    c1530_read_block(tape, &sys->ram[addr], len, &repeat);
+    chips_page_hashes_invalidate(&sys->ram_hashes);
+    // skip the repeated copy of the data block
+    data_pos = tape->pos;
+    if ((c1530_read_block(tape, 0, 0, &repeat) < 0) || !repeat) {
+        tape->pos = data_pos;
+    }
+    tape->pulse_count = 0;
+    // the KERNAL keeps the header in the cassette buffer
+    const uint16_t tape_buf = mem_rd16(mem, 0xB2);
+    for (int i = 0; i < (int)sizeof(hdr); i++) {
+        mem_wr(mem, (uint16_t)(tape_buf + i), hdr[i]);
+    }
+    addr += (uint16_t)len;
+    mem_wr16(mem, _C64_KERNAL_EAL, addr);
+    mem_wr(mem, _C64_KERNAL_ST, 0);
+    m6502_set_x(&sys->cpu, (uint8_t)addr);
+    m6502_set_y(&sys->cpu, (uint8_t)(addr >> 8));
+    return _c64_kernal_return(sys, pins, false);
+}
+
+static uint64_t _c64_kernal_trap(c64_t* sys, uint64_t pins, uint16_t addr) {
+    c1541_vdrive_t* vd = &sys->vdrive;
+    const uint8_t a = m6502_a(&sys->cpu);
+    if (!vd->valid && (addr != 0xF4A5)) {
+        return pins;
+    }
+    switch (addr) {
+        case 0xED09:    // TALK
+            if (a != _C64_VDRIVE_DEVICE) {
+                return pins;
+            }
+            c1541_vdrive_talk(vd);
+            break;
+        case 0xED0C:    // LISTEN
+            if (a != _C64_VDRIVE_DEVICE) {
+                return pins;
+            }
+            c1541_vdrive_listen(vd);
+            break;
+        case 0xEDB9:    // SECOND
+        case 0xEDC7:    // TKSA
+            if (!(vd->listening || vd->talking)) {
+                return pins;
+            }
+            c1541_vdrive_second(vd, a);
+            break;
+        case 0xEDDD:    // CIOUT
+            if (!vd->listening) {
+                return pins;
+            }
+            c1541_vdrive_send(vd, a);
+            break;
+        case 0xEE13:    // ACPTR
+            if (!vd->talking) {
+                return pins;
+            }
+            else {
+                bool eoi = false;
+                const int data = c1541_vdrive_receive(vd, &eoi);
+                uint8_t st = mem_rd(&sys->mem_cpu, _C64_KERNAL_ST);
+                if (data < 0) {
+                    // nothing to send, same as a read timeout on a real drive
+                    st |= 0x02;
+                    m6502_set_a(&sys->cpu, 0x0D);
+                }
+                else {
+                    st |= eoi ? 0x40 : 0x00;
+                    m6502_set_a(&sys->cpu, (uint8_t)data);
+                }
+                mem_wr(&sys->mem_cpu, _C64_KERNAL_ST, st);
+            }
+            break;
+        case 0xEDEF:    // UNTLK
+            if (!vd->talking) {
+                return pins;
+            }
+            c1541_vdrive_untalk(vd);
+            break;
+        case 0xEDFE:    // UNLSN
+            if (!vd->listening) {
+                return pins;
+            }
+            c1541_vdrive_unlisten(vd);
+            break;
+        case 0xF4A5:    // LOAD (through ILOAD vector)
+            switch (mem_rd(&sys->mem_cpu, _C64_KERNAL_FA)) {
+                case 1:  return sys->tape_load_trap ? _c64_tape_load(sys, pins) : pins;
+                case _C64_VDRIVE_DEVICE: return vd->valid ? _c64_vdrive_load(sys, pins) : pins;
+                default: return pins;
+            }
+        case 0xF5ED:    // SAVE (through ISAVE vector)
+            if (mem_rd(&sys->mem_cpu, _C64_KERNAL_FA) != _C64_VDRIVE_DEVICE) {
+                return pins;
+            }
+            return _c64_vdrive_save(sys, pins);
+        default:
+            return pins;
+    }
+    return _c64_kernal_return(sys, pins, false);
+}
+
 chips_display_info_t c64_display_info(c64_t* sys) {
     chips_display_info_t res = {
         .frame = {
@@ -1116,10 +2028,13 @@ chips_display_info_t c64_display_info(c64_t* sys) {
                 .height = M6569_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = (sys && !sys->vic.crt.triple_buffer) ? &sys->vic.crt.dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = M6569_FRAMEBUFFER_SIZE_BYTES,
-            }
+            },
+            .triple_buffer = sys ? sys->vic.crt.triple_buffer : 0,
         },
         .palette = m6569_dbg_palette(),
     };
@@ -1138,17 +2053,43 @@ chips_display_info_t c64_display_info(c64_t* sys) {
     return res;
 }
 
+// ROM image ranges for snapshot pointer conversion
+static void _c64_rom_ranges(const c64_t* sys, mem_ext_range_t* roms) {
+    roms[0].ptr = sys->rom_char_ptr;   roms[0].size = 0x1000;
+    roms[1].ptr = sys->rom_basic_ptr;  roms[1].size = 0x2000;
+    roms[2].ptr = sys->rom_kernal_ptr; roms[2].size = 0x2000;
+}
+
+chips_observation_t c64_observe(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 2,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+            { .name = "color_ram", .mem = { .ptr = sys->color_ram, .size = sizeof(sys->color_ram) } },
+        },
+        .display = c64_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_M6502, .state = &sys->cpu },
+    };
+}
+
 uint32_t c64_save_snapshot(c64_t* sys, c64_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     m6502_snapshot_onsave(&dst->cpu);
     m6569_snapshot_onsave(&dst->vic);
-    mem_snapshot_onsave(&dst->mem_cpu, sys);
-    mem_snapshot_onsave(&dst->mem_vic, sys);
+    mem_ext_range_t roms[3];
+    _c64_rom_ranges(sys, roms);
+    mem_snapshot_onsave_ext(&dst->mem_cpu, sys, roms, 3);
+    mem_snapshot_onsave_ext(&dst->mem_vic, sys, roms, 3);
+    dst->rom_char_ptr = dst->rom_basic_ptr = dst->rom_kernal_ptr = 0;
     c1530_snapshot_onsave(&dst->c1530);
     c1541_snapshot_onsave(&dst->c1541, sys);
+    c1541_vdrive_snapshot_onsave(&dst->vdrive);
+    chips_text_input_snapshot_onsave(&dst->text_input);
     return C64_SNAPSHOT_VERSION;
 }
 
@@ -1160,17 +2101,168 @@ bool c64_load_snapshot(c64_t* sys, uint32_t version, c64_t* src) {
     static c64_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    im.headless = sys->headless;
+    im.turbo = sys->turbo;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
     m6502_snapshot_onload(&im.cpu, &sys->cpu);
     m6569_snapshot_onload(&im.vic, &sys->vic);
-    mem_snapshot_onload(&im.mem_cpu, sys);
-    mem_snapshot_onload(&im.mem_vic, sys);
+    mem_ext_range_t roms[3];
+    _c64_rom_ranges(sys, roms);
+    mem_snapshot_onload_ext(&im.mem_cpu, sys, roms, 3);
+    mem_snapshot_onload_ext(&im.mem_vic, sys, roms, 3);
+    im.shared_roms = sys->shared_roms;
+    im.rom_char_ptr = sys->rom_char_ptr;
+    im.rom_basic_ptr = sys->rom_basic_ptr;
+    im.rom_kernal_ptr = sys->rom_kernal_ptr;
     c1530_snapshot_onload(&im.c1530, &sys->c1530);
     c1541_snapshot_onload(&im.c1541, &sys->c1541, sys);
+    c1541_vdrive_snapshot_onload(&im.vdrive, &sys->vdrive);
+    chips_text_input_snapshot_onload(&im.text_input, &sys->text_input);
+    chips_dirty_lines_set_all(&im.vic.crt.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
+    #if defined(CHIPS_PROFILE)
+    im.profile = sys->profile;
+    #endif
     *sys = im;
     return true;
 }
 
+void c64_copy_state(c64_t* dst, c64_t* src) {
+    CHIPS_ASSERT(dst && dst->valid && src && src->valid && (dst != src));
+    CHIPS_ASSERT((dst->c1530.valid == src->c1530.valid) && (dst->c1541.valid == src->c1541.valid));
+    const chips_debug_t debug = dst->debug;
+    const chips_headless_t headless = dst->headless;
+    const chips_turbo_t turbo = dst->turbo;
+    const chips_audio_callback_t audio_callback = dst->audio.callback;
+    const chips_vblank_callback_t vblank = dst->vblank.callback;
+    m6502_t cpu = dst->cpu;
+    m6569_t vic = dst->vic;
+    // everything up to the ROM pointers, this includes the RAM
+    memcpy(dst, src, offsetof(c64_t, shared_roms));
+    dst->debug = debug;
+    dst->headless = headless;
+    dst->turbo = turbo;
+    dst->audio.callback = audio_callback;
+    dst->vblank.callback = vblank;
+    m6502_snapshot_onload(&dst->cpu, &cpu);
+    m6569_snapshot_onload(&dst->vic, &vic);
+    // rebase the memory maps from src to dst
+    mem_ext_range_t src_roms[3], dst_roms[3];
+    _c64_rom_ranges(src, src_roms);
+    _c64_rom_ranges(dst, dst_roms);
+    mem_snapshot_onsave_ext(&dst->mem_cpu, src, src_roms, 3);
+    mem_snapshot_onload_ext(&dst->mem_cpu, dst, dst_roms, 3);
+    mem_snapshot_onsave_ext(&dst->mem_vic, src, src_roms, 3);
+    mem_snapshot_onload_ext(&dst->mem_vic, dst, dst_roms, 3);
+    if (src->c1530.valid) {
+        c1530_copy_state(&dst->c1530, &src->c1530);
+    }
+    if (src->c1541.valid) {
+        c1541_copy_state(&dst->c1541, dst, &src->c1541, src);
+    }
+    if (src->vdrive.valid) {
+        uint8_t* disc = dst->vdrive.disc;
+        const size_t disc_size = dst->vdrive.disc_size;
+        dst->vdrive = src->vdrive;
+        dst->vdrive.disc = disc;
+        dst->vdrive.disc_size = disc_size;
+    }
+    chips_dirty_lines_set_all(&dst->vic.crt.dirty_lines);
+}
+
+// rebase a pointer into the template instance to the same location in the clone
+static const uint8_t* _c64_clone_ptr(c64_t* dst, const c64_t* tmpl, const uint8_t* ptr) {
+    const uint8_t* base = (const uint8_t*) tmpl;
+    if ((ptr >= base) && (ptr < (base + sizeof(c64_t)))) {
+        return ((const uint8_t*)dst) + (ptr - base);
+    }
+    return ptr;
+}
+
+void c64_clone(c64_t* dst, const c64_t* tmpl, const c64_clone_desc_t* desc) {
+    CHIPS_ASSERT(dst && tmpl && tmpl->valid && desc && (dst != tmpl));
+    if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
+    memcpy(dst, tmpl, sizeof(c64_t));
+    dst->debug = desc->debug;
+    dst->audio.callback = desc->audio_callback;
+    dst->vblank.callback = desc->vblank;
+    dst->cpu.user_data = dst;
+    dst->vic.mem.user_data = dst;
+    dst->vic.crt.fb = dst->fb;
+    dst->vic.crt.triple_buffer = 0;
+    dst->vic.crt.vidlog = 0;
+    // rebase the ROM pointers and memory maps (shared ROM buffers stay in place)
+    dst->rom_char_ptr = _c64_clone_ptr(dst, tmpl, tmpl->rom_char_ptr);
+    dst->rom_basic_ptr = _c64_clone_ptr(dst, tmpl, tmpl->rom_basic_ptr);
+    dst->rom_kernal_ptr = _c64_clone_ptr(dst, tmpl, tmpl->rom_kernal_ptr);
+    mem_ext_range_t tmpl_roms[3], dst_roms[3];
+    _c64_rom_ranges(tmpl, tmpl_roms);
+    _c64_rom_ranges(dst, dst_roms);
+    mem_snapshot_onsave_ext(&dst->mem_cpu, (void*)tmpl, tmpl_roms, 3);
+    mem_snapshot_onload_ext(&dst->mem_cpu, dst, dst_roms, 3);
+    mem_snapshot_onsave_ext(&dst->mem_vic, (void*)tmpl, tmpl_roms, 3);
+    mem_snapshot_onload_ext(&dst->mem_vic, dst, dst_roms, 3);
+    if (dst->c1530.valid) {
+        dst->c1530.cas_port = &dst->cas_port;
+    }
+    if (dst->c1541.valid) {
+        c1541_t* drv = &dst->c1541;
+        drv->iec = &dst->iec_port;
+        drv->rom_ptr[0] = _c64_clone_ptr(dst, tmpl, tmpl->c1541.rom_ptr[0]);
+        drv->rom_ptr[1] = _c64_clone_ptr(dst, tmpl, tmpl->c1541.rom_ptr[1]);
+        const mem_ext_range_t tmpl_drv_roms[2] = { { tmpl->c1541.rom_ptr[0], 0x2000 }, { tmpl->c1541.rom_ptr[1], 0x2000 } };
+        const mem_ext_range_t dst_drv_roms[2] = { { drv->rom_ptr[0], 0x2000 }, { drv->rom_ptr[1], 0x2000 } };
+        mem_snapshot_onsave_ext(&drv->mem, (void*)tmpl, tmpl_drv_roms, 2);
+        mem_snapshot_onload_ext(&drv->mem, dst, dst_drv_roms, 2);
+    }
+    if (dst->vdrive.valid) {
+        // the disc image is caller-owned, dst starts with no disc inserted
+        c1541_vdrive_remove_disc(&dst->vdrive);
+    }
+    chips_text_input_stop(&dst->text_input);
+    chips_dirty_lines_set_all(&dst->vic.crt.dirty_lines);
+}
+
+uint64_t c64_state_hash(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem_cpu.dirty.base != sys->ram) {
+        mem_track_dirty(&sys->mem_cpu, sys->ram, sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = m6502_hash(&sys->cpu, h);
+    h = CHIPS_HASH(h, sys->cia_1);
+    h = CHIPS_HASH(h, sys->cia_2);
+    h = m6569_hash(&sys->vic, h);
+    h = CHIPS_HASH(h, sys->sid);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->sched);
+    h = CHIPS_HASH(h, sys->io_mapped);
+    h = CHIPS_HASH(h, sys->cas_port);
+    h = CHIPS_HASH(h, sys->iec_port);
+    h = CHIPS_HASH(h, sys->cpu_port);
+    h = CHIPS_HASH(h, sys->kbd_joy1_mask);
+    h = CHIPS_HASH(h, sys->kbd_joy2_mask);
+    h = CHIPS_HASH(h, sys->joy_joy1_mask);
+    h = CHIPS_HASH(h, sys->joy_joy2_mask);
+    h = CHIPS_HASH(h, sys->vic_bank_select);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->color_ram);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem_cpu.dirty.bits);
+    mem_clear_dirty(&sys->mem_cpu);
+    if (sys->c1541.valid) {
+        h = c1541_hash(&sys->c1541, h);
+    }
+    if (sys->vdrive.valid) {
+        h = c1541_vdrive_hash(&sys->vdrive, h);
+    }
+    if (sys->c1530.valid) {
+        h = c1530_hash(&sys->c1530, h);
+    }
+    return h;
+}
+
 void c64_basic_run(c64_t* sys) {
     CHIPS_ASSERT(sys);
     // write RUN into the keyboard buffer
@@ -1216,4 +2308,11 @@ void c64_basic_syscall(c64_t* sys, uint16_t addr) {
 uint16_t c64_syscall_return_addr(void) {
     return 0xA7EA;
 }
+
+#if defined(CHIPS_PROFILE)
+chips_profile_t* c64_profile_info(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return &sys->profile;
+}
+#endif
 #endif /* CHIPS_IMPL */
@@ -18,6 +18,13 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Optionally define CHIPS_SHARED_ROMS before including cpc.h to remove the
+    embedded ROM image arrays from cpc_t (see 'Shared ROM Images' below).
+
+    Optionally define CHIPS_SHARED_DISCS before including fdd.h and cpc.h to
+    remove the embedded disc image buffer from cpc_t (see 'Shared Disc
+    Images' below).
+
     You need to include the following headers before including cpc.h:
 
     - chips/chips_common.h
@@ -33,6 +40,95 @@
     - chips/fdd.h
     - chips/fdd_cpc.h
 
+    ## Shared ROM Images
+
+    By default cpc_init() copies the ROM images from cpc_desc_t.roms into
+    the cpc_t struct. When running many emulator instances side by side,
+    set cpc_desc_t.shared_roms to true, this maps the ROM pages directly
+    from the caller-owned buffers in cpc_desc_t.roms without copying. Those
+    buffers must remain valid and unchanged until the cpc_t instance is
+    discarded.
+
+    If CHIPS_SHARED_ROMS is defined, the embedded ROM arrays are removed
+    from cpc_t altogether and cpc_desc_t.shared_roms is implied.
+
+    ## Shared Disc Images
+
+    By default cpc_insert_disc() copies the .dsk image into the floppy
+    drive's data buffer in cpc_t. With cpc_desc_t.shared_discs set to true,
+    the drive references the caller-owned image data instead (for instance
+    a memory-mapped file), the data must remain valid and unchanged until
+    the disc is removed or another disc is inserted. Sectors written by
+    the emulated system are copied on write, and snapshots only contain
+    those copied sectors (see 'Shared Disc Images' in fdd.h).
+
+    If CHIPS_SHARED_DISCS is defined, the disc image buffer is removed from
+    cpc_t altogether (shrinking both cpc_t and snapshots by about 1 MByte)
+    and cpc_desc_t.shared_discs is implied.
+
+    ## Fast State Copy
+
+    cpc_copy_state(dst, src) copies the emulation state of one instance
+    into another without going through an intermediate snapshot, for
+    instance to keep a secondary instance in sync for run-ahead (see
+    util/runahead.h). Both instances must have been initialized with the
+    same cpc_desc_t configuration. The ROM images and the framebuffer are
+    not copied, only the used part of the disc image is copied (nothing
+    but the written sectors for shared discs), and dst keeps its own debug,
+    headless, turbo and audio callback setup.
+
+    ## Text Input
+
+    cpc_type_text() queues a caller-owned ASCII text which must remain
+    valid until cpc_is_typing_text() returns false. The location of the
+    firmware's key buffer differs between the ROM versions, so the text is
+    typed by pressing and releasing one key after another on the keyboard
+    matrix, each for CPC_TEXT_INPUT_KEY_US (two keyboard scans of the
+    firmware, so that repeated characters are recognized as separate key
+    presses). Newlines become RETURN, characters without a key are dropped.
+    Don't press keys with cpc_key_down() while text is typed.
+
+    ## State Hash
+
+    cpc_state_hash() hashes the CPU, chip, keyboard and floppy drive state
+    and the RAM banks (but not the disc image data), e.g. for netplay desync
+    detection. From the first call on, writes into the RAM banks are
+    dirty-tracked in cpc_t.mem, so each call only rehashes the 1 KByte RAM
+    pages which have been written since the previous call.
+
+    ## Observation
+
+    cpc_observe() returns a pointer to the RAM banks ("ram", 8 banks of
+    16 KBytes, on the CPC 464 only the first 4 banks are used), the
+    display info and the z80_t CPU state (see chips_observation_t in
+    chips_common.h). The vblank callback in cpc_desc_t is invoked when the
+    gate array's CRT beam returns to the top of the screen.
+
+    ## Turbo Mode
+
+    cpc_set_turbo() switches on turbo mode at run time (see chips_turbo_t
+    in chips_common.h), cpc_exec() and cpc_exec_frame() then run the given
+    number of time slices or frames, and only the last one produces video
+    and audio output. cpc_turbo_speed() returns the speed factor achieved
+    in the last call.
+
+    ## Raw Video Log
+
+    If cpc_desc_t.vidlog points to a chips_vidlog_t (see chips_common.h),
+    the gate array records ink, border and config register writes, and
+    CRTC register writes are recorded as AM40010_VIDLOG_REG_CRTC0 + reg.
+    Each published frame comes with a copy of the 64 KByte RAM the gate
+    array reads video memory from. Enable the headless mode to skip pixel
+    decoding while the picture is reconstructed from the log.
+
+    ## Profiling
+
+    When compiled with CHIPS_PROFILE, cpc_profile_info() returns per-tick
+    host cycle budgets for the CPU, the memory/IO decoding, the gate array
+    (video), the PSG (audio) and the CRTC, access counts for the memory and
+    IO devices and the host cycles per exec call (see chips_profile_t in
+    chips_common.h).
+
     ## The Amstrad CPC 464
 
     FIXME!
@@ -78,11 +174,12 @@ extern "C" {
 #endif
 
 // bump when cpc_t memory layout changes
-#define CPC_SNAPSHOT_VERSION (0x0001)
+#define CPC_SNAPSHOT_VERSION (0x0002)
 
 #define CPC_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
 #define CPC_DEFAULT_AUDIO_SAMPLES (128)     // default number of samples in internal sample buffer
 #define CPC_MAX_TAPE_SIZE (128*1024)        // max size of tape file in bytes
+#define CPC_TEXT_INPUT_KEY_US (38000)       // key press and release duration for cpc_type_text() (just under 2 frames)
 
 // CPC model types
 typedef enum {
@@ -111,7 +208,13 @@ typedef struct {
     cpc_type_t type;                // default is the CPC 6128
     cpc_joystick_type_t joystick_type;
     chips_debug_t debug;
+    chips_headless_t headless;      // optional headless video mode (see chips_common.h)
+    chips_triple_buffer_t* triple_buffer;   // optional framebuffer hand-off to a render thread (see chips_common.h)
+    chips_vidlog_t* vidlog;         // optional raw video log (see 'Raw Video Log')
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
+    bool shared_roms;               // if true, map ROM pages directly from the roms buffers (no copy)
+    bool shared_discs;              // if true, reference inserted disc images instead of copying them
 
     // ROM images
     struct {
@@ -134,7 +237,8 @@ typedef struct {
     } roms;
 } cpc_desc_t;
 
-// CPC emulator state
+// CPC emulator state, the state accessed in each tick comes first,
+// large or rarely accessed buffers are placed at the end
 typedef struct {
     z80_t cpu;
     ay38910_t psg;
@@ -148,12 +252,19 @@ typedef struct {
     uint8_t kbd_joymask;
     uint8_t joy_joymask;
 
-    kbd_t kbd;
     mem_t mem;
+    chips_iomap_t iomap;    // IO port (upper 8 address bits) to device select bits
 
     uint64_t pins;
+    uint64_t tick;          // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
+    uint64_t frame_us_rem;  // fractional remainder of the ticks-to-us conversion in cpc_exec_frame()
+    kbd_t kbd;
+    chips_text_input_t text_input;  // queued text for cpc_type_text()
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
+    chips_turbo_t turbo;
 
     struct {
         chips_audio_callback_t callback;
@@ -161,12 +272,23 @@ typedef struct {
         int sample_pos;
         float sample_buffer[CPC_MAX_AUDIO_SAMPLES];
     } audio;
+    bool shared_roms;               // ROM pages are mapped from caller-owned buffers
+    bool shared_discs;              // inserted disc images are referenced, not copied
+    const uint8_t* rom_os_ptr;      // ROM images, pointing into rom_xxx[] or to shared buffers
+    const uint8_t* rom_basic_ptr;
+    const uint8_t* rom_amsdos_ptr;
     uint8_t ram[8][0x4000];
+    chips_page_hashes_t ram_hashes; // cached RAM page hashes for cpc_state_hash()
+    #if !defined(CHIPS_SHARED_ROMS)
     uint8_t rom_os[0x4000];
     uint8_t rom_basic[0x4000];
     uint8_t rom_amsdos[0x4000];
+    #endif
     alignas(64) uint8_t fb[AM40010_FRAMEBUFFER_SIZE_BYTES];
     fdd_t fdd;
+    #if defined(CHIPS_PROFILE)
+    chips_profile_t profile;
+    #endif
 } cpc_t;
 
 // initialize a new CPC instance
@@ -177,12 +299,24 @@ void cpc_discard(cpc_t* cpc);
 void cpc_reset(cpc_t* cpc);
 // get display requirements and framebuffer content, may be called with nullptr
 chips_display_info_t cpc_display_info(cpc_t* cpc);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t cpc_observe(cpc_t* sys);
 // run CPC instance for given amount of micro_seconds, returns number of ticks executed
 uint32_t cpc_exec(cpc_t* cpc, uint32_t micro_seconds);
+// run CPC emulation until the end of the current video frame, returns number of ticks
+uint32_t cpc_exec_frame(cpc_t* cpc);
+// set the turbo mode speed factor (see 'Turbo Mode'), 0 or 1 to switch turbo mode off
+void cpc_set_turbo(cpc_t* sys, uint32_t factor);
+// get the achieved speed factor of the last exec call
+float cpc_turbo_speed(cpc_t* sys);
 // send a key down event
 void cpc_key_down(cpc_t* cpc, int key_code);
 // send a key up event
 void cpc_key_up(cpc_t* cpc, int key_code);
+// type a caller-owned ASCII text by pressing keys (see 'Text Input')
+void cpc_type_text(cpc_t* sys, chips_range_t text);
+// return true while queued text is left to type
+bool cpc_is_typing_text(cpc_t* sys);
 // enable/disable joystick emulation
 void cpc_set_joystick_type(cpc_t* sys, cpc_joystick_type_t type);
 // get current joystick emulation type
@@ -197,7 +331,7 @@ bool cpc_quickload(cpc_t* cpc, chips_range_t data, bool start);
 uint16_t cpc_quickload_exec_addr(chips_range_t data);
 // return the return-address for a quickloaded file
 uint16_t cpc_quickload_return_addr(cpc_t* cpc);
-// insert a disk image file (.dsk)
+// insert a disk image file (.dsk), copied or referenced depending on cpc_desc_t.shared_discs
 bool cpc_insert_disc(cpc_t* cpc, chips_range_t data);
 // remove current disc
 void cpc_remove_disc(cpc_t* cpc);
@@ -211,6 +345,14 @@ bool cpc_video_debugging_enabled(cpc_t* cpc);
 uint32_t cpc_save_snapshot(cpc_t* sys, cpc_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool cpc_load_snapshot(cpc_t* sys, uint32_t version, cpc_t* src);
+// fast copy of the emulation state into another instance (see 'Fast State Copy')
+void cpc_copy_state(cpc_t* dst, cpc_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t cpc_state_hash(cpc_t* sys);
+#if defined(CHIPS_PROFILE)
+// get the profiling results (reset with chips_profile_reset())
+chips_profile_t* cpc_profile_info(cpc_t* sys);
+#endif
 
 #ifdef __cplusplus
 } // extern "C"
@@ -234,11 +376,52 @@ static void _cpc_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_
 static int _cpc_fdc_seektrack(int drive, int track, void* user_data);
 static int _cpc_fdc_seeksector(int drive, int side, upd765_sectorinfo_t* inout_info, void* user_data);
 static int _cpc_fdc_read(int drive, int side, void* user_data, uint8_t* out_data);
+static int _cpc_fdc_readbytes(int drive, int side, void* user_data, uint8_t* dst, int max_bytes, int* out_num_bytes);
 static int _cpc_fdc_trackinfo(int drive, int side, void* user_data, upd765_sectorinfo_t* out_info);
 static void _cpc_fdc_driveinfo(int drive, void* user_data, upd765_driveinfo_t* out_info);
 
 #define _CPC_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
+// IO port select bits in the IO port select table
+#define _CPC_IOSEL_PPI          (1<<0)
+#define _CPC_IOSEL_CRTC         (1<<1)
+#define _CPC_IOSEL_FDC_MOTOR    (1<<2)
+#define _CPC_IOSEL_FDC          (1<<3)
+
+// profiling sections and counters (only used with CHIPS_PROFILE)
+enum {
+    _CPC_PROF_CPU,
+    _CPC_PROF_MEMIO,
+    _CPC_PROF_GA,
+    _CPC_PROF_PSG,
+    _CPC_PROF_CRTC,
+};
+enum {
+    _CPC_PROF_MEM_RD,
+    _CPC_PROF_MEM_WR,
+    _CPC_PROF_IO,
+    _CPC_PROF_IO_PPI,
+    _CPC_PROF_IO_PSG,
+    _CPC_PROF_IO_CRTC,
+    _CPC_PROF_IO_FDC,
+};
+
+/* the CPC only decodes the upper 8 address bits (plus A7 for the
+   floppy controller), and only partially, so that several devices
+   can be selected by the same IO request
+*/
+static void _cpc_init_iomap(cpc_t* sys) {
+    chips_iomap_clear(&sys->iomap);
+    // ~A11: i8255 PPI
+    chips_iomap_add(&sys->iomap, 0x08, 0x00, _CPC_IOSEL_PPI);
+    // ~A14: MC6845 CRTC
+    chips_iomap_add(&sys->iomap, 0x40, 0x00, _CPC_IOSEL_CRTC);
+    // ~A10 & ~A8 (& ~A7): floppy motor control
+    chips_iomap_add(&sys->iomap, 0x05, 0x00, _CPC_IOSEL_FDC_MOTOR);
+    // ~A10 & A8 (& ~A7): floppy controller status/data register
+    chips_iomap_add(&sys->iomap, 0x05, 0x01, _CPC_IOSEL_FDC);
+}
+
 void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
     if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
@@ -246,6 +429,14 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
     memset(sys, 0, sizeof(cpc_t));
     sys->valid = true;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    _cpc_init_iomap(sys);
+    #if defined(CHIPS_PROFILE)
+    static const char* prof_sections[] = { "CPU", "Memory/IO", "Gate Array", "PSG", "CRTC", 0 };
+    static const char* prof_counters[] = { "Mem Read", "Mem Write", "IO Request", "PPI", "PSG", "CRTC", "FDC", 0 };
+    chips_profile_init(&sys->profile, prof_sections, prof_counters);
+    #endif
+    sys->headless = desc->headless;
     sys->type = desc->type;
     sys->joystick_type = desc->joystick_type;
     sys->audio.callback = desc->audio.callback;
@@ -254,21 +445,41 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
     if (CPC_TYPE_464 == desc->type) {
         CHIPS_ASSERT(desc->roms.cpc464.os.ptr && (desc->roms.cpc464.os.size == 0x4000));
         CHIPS_ASSERT(desc->roms.cpc464.basic.ptr && (desc->roms.cpc464.basic.size == 0x4000));
-        memcpy(sys->rom_os, desc->roms.cpc464.os.ptr, 0x4000);
-        memcpy(sys->rom_basic, desc->roms.cpc464.basic.ptr, 0x4000);
+        sys->rom_os_ptr = (const uint8_t*) desc->roms.cpc464.os.ptr;
+        sys->rom_basic_ptr = (const uint8_t*) desc->roms.cpc464.basic.ptr;
     } else if (CPC_TYPE_6128 == desc->type) {
         CHIPS_ASSERT(desc->roms.cpc6128.os.ptr && (desc->roms.cpc6128.os.size == 0x4000));
         CHIPS_ASSERT(desc->roms.cpc6128.basic.ptr && (desc->roms.cpc6128.basic.size == 0x4000));
         CHIPS_ASSERT(desc->roms.cpc6128.amsdos.ptr && (desc->roms.cpc6128.amsdos.size == 0x4000));
-        memcpy(sys->rom_os, desc->roms.cpc6128.os.ptr, 0x4000);
-        memcpy(sys->rom_basic, desc->roms.cpc6128.basic.ptr, 0x4000);
-        memcpy(sys->rom_amsdos, desc->roms.cpc6128.amsdos.ptr, 0x4000);
+        sys->rom_os_ptr = (const uint8_t*) desc->roms.cpc6128.os.ptr;
+        sys->rom_basic_ptr = (const uint8_t*) desc->roms.cpc6128.basic.ptr;
+        sys->rom_amsdos_ptr = (const uint8_t*) desc->roms.cpc6128.amsdos.ptr;
     } else { // KC Compact
         CHIPS_ASSERT(desc->roms.kcc.os.ptr && (desc->roms.kcc.os.size == 0x4000));
         CHIPS_ASSERT(desc->roms.kcc.basic.ptr && (desc->roms.kcc.basic.size == 0x4000));
-        memcpy(sys->rom_os, desc->roms.kcc.os.ptr, 0x4000);
-        memcpy(sys->rom_basic, desc->roms.kcc.basic.ptr, 0x4000);
+        sys->rom_os_ptr = (const uint8_t*) desc->roms.kcc.os.ptr;
+        sys->rom_basic_ptr = (const uint8_t*) desc->roms.kcc.basic.ptr;
     }
+    #if defined(CHIPS_SHARED_DISCS)
+    sys->shared_discs = true;
+    #else
+    sys->shared_discs = desc->shared_discs;
+    #endif
+    #if defined(CHIPS_SHARED_ROMS)
+    sys->shared_roms = true;
+    #else
+    sys->shared_roms = desc->shared_roms;
+    if (!sys->shared_roms) {
+        memcpy(sys->rom_os, sys->rom_os_ptr, 0x4000);
+        sys->rom_os_ptr = sys->rom_os;
+        memcpy(sys->rom_basic, sys->rom_basic_ptr, 0x4000);
+        sys->rom_basic_ptr = sys->rom_basic;
+        if (sys->rom_amsdos_ptr) {
+            memcpy(sys->rom_amsdos, sys->rom_amsdos_ptr, 0x4000);
+            sys->rom_amsdos_ptr = sys->rom_amsdos;
+        }
+    }
+    #endif
 
     // initialize the hardware
     sys->pins = z80_init(&sys->cpu);
@@ -280,7 +491,8 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
         .tick_hz = _CPC_FREQUENCY / 4,
         .sound_hz = _CPC_DEFAULT(desc->audio.sample_rate, 44100),
         .magnitude = _CPC_DEFAULT(desc->audio.volume, 0.5f),
-        .user_data = sys
+        .user_data = sys,
+        .lazy = true
     });
     mc6845_init(&sys->crtc, MC6845_TYPE_UM6845R);
     mem_init(&sys->mem);
@@ -296,12 +508,18 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
             .ptr = &sys->fb[0],
             .size = sizeof(sys->fb),
         },
+        .triple_buffer = desc->triple_buffer,
+        .vidlog = desc->vidlog,
         .user_data = sys,
     });
+    if (desc->triple_buffer) {
+        desc->triple_buffer->clock = &sys->tick;
+    }
     upd765_init(&sys->fdc, &(upd765_desc_t){
         .seektrack_cb = _cpc_fdc_seektrack,
         .seeksector_cb = _cpc_fdc_seeksector,
         .read_cb = _cpc_fdc_read,
+        .readbytes_cb = _cpc_fdc_readbytes,
         .trackinfo_cb = _cpc_fdc_trackinfo,
         .driveinfo_cb = _cpc_fdc_driveinfo,
         .user_data = sys,
@@ -329,22 +547,29 @@ void cpc_reset(cpc_t* sys) {
 }
 
 static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
+    sys->tick++;
+    CHIPS_PROFILE_TICK_BEGIN(&sys->profile);
     cpu_pins = z80_tick(&sys->cpu, cpu_pins);
+    CHIPS_PROFILE_MARK(&sys->profile, _CPC_PROF_CPU);
 
     // memory and IO requests
     if (cpu_pins & Z80_MREQ) {
         const uint16_t addr = Z80_GET_ADDR(cpu_pins);
         if (cpu_pins & Z80_RD) {
+            CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_MEM_RD);
             Z80_SET_DATA(cpu_pins, mem_rd(&sys->mem, addr));
         } else if (cpu_pins & Z80_WR) {
+            CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_MEM_WR);
             mem_wr(&sys->mem, addr, Z80_GET_DATA(cpu_pins));
         }
     } else if ((cpu_pins & (Z80_M1|Z80_IORQ)) == Z80_IORQ) {
+        CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_IO);
         /* CPU IO address decoding
 
             For address decoding, see the main board schematics!
             also: http://cpcwiki.eu/index.php/Default_I/O_Port_Summary
         */
+        const uint8_t io_sel = chips_iomap_select(&sys->iomap, (uint8_t)(Z80_GET_ADDR(cpu_pins) >> 8));
 
         /*
             Z80 to i8255 PPI pin connections:
@@ -379,8 +604,9 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
             i8255 Port C:
                 PC0..PC3: select keyboard matrix line
         */
-        if ((cpu_pins & Z80_A11) == 0) {
+        if (io_sel & _CPC_IOSEL_PPI) {
             // i8255 in/out
+            CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_IO_PPI);
             uint64_t ppi_pins = (cpu_pins & Z80_PIN_MASK & ~(I8255_PC_PINS|I8255_A1|I8255_A0)) | I8255_CS;
             if (cpu_pins & Z80_A9) { ppi_pins |= I8255_A1; }
             if (cpu_pins & Z80_A8) { ppi_pins |= I8255_A0; }
@@ -405,6 +631,7 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
             }
             // update PSG state
             if ((ppi_pins & (I8255_PC7|I8255_PC6)) != 0) {
+                CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_IO_PSG);
                 uint64_t ay_pins = 0;
                 if (ppi_pins & I8255_PC7) { ay_pins |= AY38910_BDIR; }
                 if (ppi_pins & I8255_PC6) { ay_pins |= AY38910_BC1; }
@@ -440,22 +667,30 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
                 A8  -> RS
             D0..D7  -> D0..D7
         */
-        if ((cpu_pins & Z80_A14) == 0) {
+        if (io_sel & _CPC_IOSEL_CRTC) {
             // 6845 in/out
+            CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_IO_CRTC);
             uint64_t crtc_pins = (cpu_pins & Z80_PIN_MASK)|MC6845_CS;
             if (cpu_pins & Z80_A9) { crtc_pins |= MC6845_RW; }
             if (cpu_pins & Z80_A8) { crtc_pins |= MC6845_RS; }
             cpu_pins = mc6845_iorq(&sys->crtc, crtc_pins) & Z80_PIN_MASK;
+            if (sys->ga.vidlog && ((crtc_pins & (MC6845_RS|MC6845_RW)) == MC6845_RS) && (sys->crtc.sel < 18)) {
+                chips_vidlog_write(sys->ga.vidlog, (uint16_t)sys->ga.crt.h_pos, (uint16_t)sys->ga.crt.v_pos,
+                    AM40010_VIDLOG_REG_CRTC0 + sys->crtc.sel, sys->crtc.reg[sys->crtc.sel]);
+            }
         }
         // Floppy Disk Interface
-        if ((cpu_pins & (Z80_A10|Z80_A8|Z80_A7)) == 0) {
-            if (cpu_pins & Z80_WR) {
-                fdd_motor(&sys->fdd, 0 != (Z80_GET_DATA(cpu_pins) & 1));
+        if (0 == (cpu_pins & Z80_A7)) {
+            if (io_sel & _CPC_IOSEL_FDC_MOTOR) {
+                if (cpu_pins & Z80_WR) {
+                    fdd_motor(&sys->fdd, 0 != (Z80_GET_DATA(cpu_pins) & 1));
+                }
+            } else if (io_sel & _CPC_IOSEL_FDC) {
+                // floppy controller status/data register
+                CHIPS_PROFILE_COUNT(&sys->profile, _CPC_PROF_IO_FDC);
+                uint64_t fdc_pins = UPD765_CS | (cpu_pins & Z80_PIN_MASK);
+                cpu_pins = upd765_iorq(&sys->fdc, fdc_pins) & Z80_PIN_MASK;
             }
-        } else if ((cpu_pins & (Z80_A10|Z80_A8|Z80_A7)) == Z80_A8) {
-            // floppy controller status/data register
-            uint64_t fdc_pins = UPD765_CS | (cpu_pins & Z80_PIN_MASK);
-            cpu_pins = upd765_iorq(&sys->fdc, fdc_pins) & Z80_PIN_MASK;
         }
     }
 
@@ -464,7 +699,10 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
        (see _cpc_cclk callback). The returned CPU pin mask
        will have the WAIT and INT pin set as needed.
     */
+    CHIPS_PROFILE_MARK(&sys->profile, _CPC_PROF_MEMIO);
     cpu_pins = am40010_tick(&sys->ga, cpu_pins) & Z80_PIN_MASK;
+    chips_vblank_update(&sys->vblank, sys->ga.crt.frame_count);
+    CHIPS_PROFILE_TICK_END(&sys->profile, _CPC_PROF_GA);
     return cpu_pins;
 }
 
@@ -473,20 +711,17 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
 */
 static uint64_t _cpc_cclk(void* user_data) {
     cpc_t* sys = (cpc_t*) user_data;
+    // the gate array work up to here is charged to the gate array
+    CHIPS_PROFILE_MARK(&sys->profile, _CPC_PROF_GA);
     // tick the sound chip...
-    if (ay38910_tick(&sys->psg)) {
+    if (ay38910_tick(&sys->psg) && !sys->turbo.skip) {
         // new sound sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->psg.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                // new sample packet is ready
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
-        }
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->psg.sample, sys->tick);
     }
+    CHIPS_PROFILE_MARK(&sys->profile, _CPC_PROF_PSG);
     // tick the CRTC and return its pin mask
     uint64_t crtc_pins = mc6845_tick(&sys->crtc);
+    CHIPS_PROFILE_MARK(&sys->profile, _CPC_PROF_CRTC);
     return crtc_pins;
 }
 
@@ -545,12 +780,12 @@ static void _cpc_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_
     const uint8_t* rom1_ptr;
     if (CPC_TYPE_6128 == sys->type) {
         ram_config_index = ram_config & 7;
-        rom0_ptr = sys->rom_os;
-        rom1_ptr = (rom_select == 7) ? sys->rom_amsdos : sys->rom_basic;
+        rom0_ptr = sys->rom_os_ptr;
+        rom1_ptr = (rom_select == 7) ? sys->rom_amsdos_ptr : sys->rom_basic_ptr;
     } else {
         ram_config_index = 0;
-        rom0_ptr = sys->rom_os;
-        rom1_ptr = sys->rom_basic;
+        rom0_ptr = sys->rom_os_ptr;
+        rom1_ptr = sys->rom_basic_ptr;
     }
     const int i0 = _cpc_ram_config[ram_config_index][0];
     const int i1 = _cpc_ram_config[ram_config_index][1];
@@ -579,27 +814,121 @@ static void _cpc_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_
     }
 }
 
-uint32_t cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
-    CHIPS_ASSERT(sys && sys->valid);
-    const uint32_t num_ticks = clk_us_to_ticks(_CPC_FREQUENCY, micro_seconds);
+// run for num_ticks, or until the CRT starts a new frame if to_frame_end is true
+static uint32_t _cpc_run(cpc_t* sys, uint32_t num_ticks, bool to_frame_end) {
+    const uint32_t frame_count = sys->ga.crt.frame_count;
     uint64_t pins = sys->pins;
+    uint32_t tick = 0;
     if (0 == sys->debug.callback.func) {
         // run without debug hook
-        for (uint32_t tick = 0; tick < num_ticks; tick++) {
+        for (; (tick < num_ticks) && (!to_frame_end || (frame_count == sys->ga.crt.frame_count)); tick++) {
             pins = _cpc_tick(sys, pins);
         }
     } else {
-        // run with debug hook
-        for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
+        for (; (tick < num_ticks) && (!to_frame_end || (frame_count == sys->ga.crt.frame_count)) && !(*sys->debug.stopped); tick++) {
             pins = _cpc_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    return tick;
+}
+
+// press or release the next key of the text input queue
+static void _cpc_text_input(cpc_t* sys, uint32_t micro_seconds) {
+    chips_text_input_t* ti = &sys->text_input;
+    if ((0 == ti->key) && !chips_text_input_pending(ti)) {
+        return;
+    }
+    if (ti->delay_us > micro_seconds) {
+        ti->delay_us -= micro_seconds;
+        return;
+    }
+    ti->delay_us = CPC_TEXT_INPUT_KEY_US;
+    if (ti->key) {
+        kbd_key_up(&sys->kbd, ti->key);
+        ti->key = 0;
+        return;
+    }
+    while (chips_text_input_pending(ti)) {
+        int c = chips_text_input_next(ti);
+        if (c == '\n') {
+            c = 0x0D;
+        }
+        if ((c < KBD_MAX_KEYS) && (sys->kbd.key_masks[c] != 0)) {
+            kbd_key_down(&sys->kbd, c);
+            ti->key = c;
+            break;
+        }
+    }
+}
+
+// run one slice of cpc_exec() or one video frame of cpc_exec_frame()
+static uint32_t _cpc_exec_slice(cpc_t* sys, uint32_t micro_seconds, bool frame) {
+    sys->ga.headless = sys->turbo.skip || chips_headless_update(&sys->headless);
+    sys->psg.silent = sys->turbo.skip;
+    uint32_t num_ticks;
+    if (frame) {
+        /* the CRT starts a new frame after 312 lines of 64us at the latest,
+            even if the CRTC doesn't produce a vsync, allow up to two frames
+        */
+        const uint32_t max_ticks = clk_us_to_ticks(_CPC_FREQUENCY, 2 * 312 * 64);
+        num_ticks = _cpc_run(sys, max_ticks, true);
+        micro_seconds = clk_ticks_to_us(_CPC_FREQUENCY, num_ticks, &sys->frame_us_rem);
+    }
+    else {
+        num_ticks = clk_us_to_ticks(_CPC_FREQUENCY, micro_seconds);
+        _cpc_run(sys, num_ticks, false);
+    }
+    _cpc_text_input(sys, micro_seconds);
     kbd_update(&sys->kbd, micro_seconds);
     return num_ticks;
 }
 
+// run all turbo mode slices (just one if turbo mode is off)
+static uint32_t _cpc_exec(cpc_t* sys, uint32_t micro_seconds, bool frame) {
+    const uint32_t num_slices = chips_turbo_slices(&sys->turbo);
+    uint32_t num_ticks = 0;
+    for (uint32_t i = 0; (i < num_slices) && ((0 == i) || !(sys->debug.stopped && *sys->debug.stopped)); i++) {
+        sys->turbo.skip = (i + 1) < num_slices;
+        num_ticks += _cpc_exec_slice(sys, micro_seconds, frame);
+    }
+    chips_turbo_done(&sys->turbo, num_ticks, clk_us_to_ticks(_CPC_FREQUENCY, frame ? (312 * 64) : micro_seconds));
+    return num_ticks;
+}
+
+uint32_t cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
+    CHIPS_ASSERT(sys && sys->valid);
+    CHIPS_PROFILE_EXEC_BEGIN(&sys->profile);
+    const uint32_t num_ticks = _cpc_exec(sys, micro_seconds, false);
+    CHIPS_PROFILE_EXEC_END(&sys->profile, num_ticks);
+    return num_ticks;
+}
+
+uint32_t cpc_exec_frame(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    CHIPS_PROFILE_EXEC_BEGIN(&sys->profile);
+    const uint32_t num_ticks = _cpc_exec(sys, 0, true);
+    CHIPS_PROFILE_EXEC_END(&sys->profile, num_ticks);
+    return num_ticks;
+}
+
+void cpc_set_turbo(cpc_t* sys, uint32_t factor) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->turbo.factor = factor;
+}
+
+float cpc_turbo_speed(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->turbo.speed;
+}
+
 void cpc_key_down(cpc_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     if (sys->joystick_type == CPC_JOYSTICK_DIGITAL) {
@@ -632,6 +961,16 @@ void cpc_key_up(cpc_t* sys, int key_code) {
     }
 }
 
+void cpc_type_text(cpc_t* sys, chips_range_t text) {
+    CHIPS_ASSERT(sys && sys->valid);
+    chips_text_input_start(&sys->text_input, text);
+}
+
+bool cpc_is_typing_text(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (0 != sys->text_input.key) || chips_text_input_pending(&sys->text_input);
+}
+
 void cpc_set_joystick_type(cpc_t* sys, cpc_joystick_type_t type) {
     CHIPS_ASSERT(sys && sys->valid);
     sys->joystick_type = type;
@@ -816,6 +1155,7 @@ static bool _cpc_load_sna(cpc_t* sys, chips_range_t data) {
     for (int i = 0; i < 16; i++) {
         sys->ga.regs.ink[i] = hdr->pens[i] & 0x1F;
     }
+    sys->ga.video.pixel_lut_valid = false;
     sys->ga.regs.border = hdr->pens[16] & 0x1F;
     sys->ga.regs.inksel = hdr->selected_pen & 0x1F;
     sys->ga.regs.config = hdr->gate_array_config & 0x3F;
@@ -827,6 +1167,20 @@ static bool _cpc_load_sna(cpc_t* sys, chips_range_t data) {
         sys->crtc.reg[i] = hdr->crtc_regs[i];
     }
     sys->crtc.sel = hdr->crtc_selected;
+    sys->crtc.span_end = 0;
+    if (sys->ga.vidlog) {
+        // the registers have been loaded directly, record their new values
+        const uint16_t x = (uint16_t)sys->ga.crt.h_pos;
+        const uint16_t y = (uint16_t)sys->ga.crt.v_pos;
+        for (int i = 0; i < 16; i++) {
+            chips_vidlog_write(sys->ga.vidlog, x, y, AM40010_VIDLOG_REG_INK0 + i, sys->ga.regs.ink[i]);
+        }
+        chips_vidlog_write(sys->ga.vidlog, x, y, AM40010_VIDLOG_REG_BORDER, sys->ga.regs.border);
+        chips_vidlog_write(sys->ga.vidlog, x, y, AM40010_VIDLOG_REG_CONFIG, sys->ga.regs.config);
+        for (int i = 0; i < 18; i++) {
+            chips_vidlog_write(sys->ga.vidlog, x, y, AM40010_VIDLOG_REG_CRTC0 + i, sys->crtc.reg[i]);
+        }
+    }
 
     sys->ppi.pa.outp = hdr->ppi_a;
     sys->ppi.pb.outp = hdr->ppi_b;
@@ -873,9 +1227,7 @@ static bool _cpc_load_bin(cpc_t* sys, chips_range_t data, bool start) {
     const uint16_t load_addr = (hdr->load_addr_h<<8)|hdr->load_addr_l;
     const uint16_t start_addr = (hdr->start_addr_h<<8)|hdr->start_addr_l;
     const uint16_t len = (hdr->length_h<<8)|hdr->length_l;
-    for (uint16_t i = 0; i < len; i++) {
-        mem_wr(&sys->mem, load_addr+i, *ptr++);
-    }
+    mem_write_range(&sys->mem, load_addr, ptr, len);
     if (start) {
         // write CALL &xxxx into BASIC line buffer
         const char* to_hex = "0123456789ABCDEF";
@@ -909,6 +1261,8 @@ static bool _cpc_load_bin(cpc_t* sys, chips_range_t data, bool start) {
 
 bool cpc_quickload(cpc_t* sys, chips_range_t data, bool start) {
     CHIPS_ASSERT(sys && sys->valid && data.ptr && (data.size > 0));
+    // RAM is written directly, bypassing dirty tracking
+    chips_page_hashes_invalidate(&sys->ram_hashes);
     if (_cpc_is_valid_sna(data)) {
         return _cpc_load_sna(sys, data);
     } else if (_cpc_is_valid_bin(data)) {
@@ -984,6 +1338,16 @@ static int _cpc_fdc_read(int drive, int side, void* user_data, uint8_t* out_data
     }
 }
 
+static int _cpc_fdc_readbytes(int drive, int side, void* user_data, uint8_t* dst, int max_bytes, int* out_num_bytes) {
+    if (0 == drive) {
+        cpc_t* sys = (cpc_t*) user_data;
+        return fdd_read_bytes(&sys->fdd, side, dst, max_bytes, out_num_bytes);
+    } else {
+        *out_num_bytes = 0;
+        return UPD765_RESULT_NOT_READY;
+    }
+}
+
 static int _cpc_fdc_trackinfo(int drive, int side, void* user_data, upd765_sectorinfo_t* out_info) {
     CHIPS_ASSERT((side >= 0) && (side < 2));
     if (0 == drive) {
@@ -1025,7 +1389,12 @@ static void _cpc_fdc_driveinfo(int drive, void* user_data, upd765_driveinfo_t* o
 
 bool cpc_insert_disc(cpc_t* sys, chips_range_t data) {
     CHIPS_ASSERT(sys && sys->valid);
-    return fdd_cpc_insert_dsk(&sys->fdd, data);
+    if (sys->shared_discs) {
+        return fdd_cpc_insert_dsk_shared(&sys->fdd, data);
+    }
+    else {
+        return fdd_cpc_insert_dsk(&sys->fdd, data);
+    }
 }
 
 void cpc_remove_disc(cpc_t* sys) {
@@ -1046,10 +1415,13 @@ chips_display_info_t cpc_display_info(cpc_t* sys) {
                 .height = AM40010_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = (sys && !sys->ga.triple_buffer) ? &sys->ga.dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = AM40010_FRAMEBUFFER_SIZE_BYTES,
-            }
+            },
+            .triple_buffer = sys ? sys->ga.triple_buffer : 0,
         },
         .screen = {
             .x = 0,
@@ -1067,15 +1439,40 @@ chips_display_info_t cpc_display_info(cpc_t* sys) {
     return res;
 }
 
+// ROM image ranges for snapshot pointer conversion
+static void _cpc_rom_ranges(const cpc_t* sys, mem_ext_range_t* roms) {
+    roms[0].ptr = sys->rom_os_ptr;     roms[0].size = 0x4000;
+    roms[1].ptr = sys->rom_basic_ptr;  roms[1].size = 0x4000;
+    roms[2].ptr = sys->rom_amsdos_ptr; roms[2].size = 0x4000;
+}
+
+chips_observation_t cpc_observe(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .display = cpc_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t cpc_save_snapshot(cpc_t* sys, cpc_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     ay38910_snapshot_onsave(&dst->psg);
     upd765_snapshot_onsave(&dst->fdc);
+    fdd_snapshot_onsave(&dst->fdd);
     am40010_snapshot_onsave(&dst->ga);
-    mem_snapshot_onsave(&dst->mem, sys);
+    chips_text_input_snapshot_onsave(&dst->text_input);
+    mem_ext_range_t roms[3];
+    _cpc_rom_ranges(sys, roms);
+    mem_snapshot_onsave_ext(&dst->mem, sys, roms, 3);
+    dst->rom_os_ptr = dst->rom_basic_ptr = dst->rom_amsdos_ptr = 0;
     return CPC_SNAPSHOT_VERSION;
 }
 
@@ -1087,13 +1484,93 @@ bool cpc_load_snapshot(cpc_t* sys, uint32_t version, cpc_t* src) {
     static cpc_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
+    im.turbo = sys->turbo;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     ay38910_snapshot_onload(&im.psg, &sys->psg);
     upd765_snapshot_onload(&im.fdc, &sys->fdc);
+    fdd_snapshot_onload(&im.fdd, &sys->fdd);
     am40010_snapshot_onload(&im.ga, &sys->ga);
-    mem_snapshot_onload(&im.mem, sys);
+    chips_text_input_snapshot_onload(&im.text_input, &sys->text_input);
+    mem_ext_range_t roms[3];
+    _cpc_rom_ranges(sys, roms);
+    mem_snapshot_onload_ext(&im.mem, sys, roms, 3);
+    im.shared_roms = sys->shared_roms;
+    im.shared_discs = sys->shared_discs;
+    im.rom_os_ptr = sys->rom_os_ptr;
+    im.rom_basic_ptr = sys->rom_basic_ptr;
+    im.rom_amsdos_ptr = sys->rom_amsdos_ptr;
+    chips_dirty_lines_set_all(&im.ga.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
+    #if defined(CHIPS_PROFILE)
+    im.profile = sys->profile;
+    #endif
     *sys = im;
     return true;
 }
 
+void cpc_copy_state(cpc_t* dst, cpc_t* src) {
+    CHIPS_ASSERT(dst && dst->valid && src && src->valid && (dst != src));
+    CHIPS_ASSERT(dst->type == src->type);
+    const chips_debug_t debug = dst->debug;
+    const chips_headless_t headless = dst->headless;
+    const chips_turbo_t turbo = dst->turbo;
+    const chips_audio_callback_t audio_callback = dst->audio.callback;
+    const chips_vblank_callback_t vblank = dst->vblank.callback;
+    ay38910_t psg = dst->psg;
+    upd765_t fdc = dst->fdc;
+    am40010_t ga = dst->ga;
+    // everything up to the ROM pointers, the RAM banks and the floppy drive
+    memcpy(dst, src, offsetof(cpc_t, shared_roms));
+    memcpy(dst->ram, src->ram, sizeof(dst->ram));
+    fdd_copy_state(&dst->fdd, &src->fdd);
+    dst->debug = debug;
+    dst->headless = headless;
+    dst->turbo = turbo;
+    dst->audio.callback = audio_callback;
+    dst->vblank.callback = vblank;
+    ay38910_snapshot_onload(&dst->psg, &psg);
+    upd765_snapshot_onload(&dst->fdc, &fdc);
+    am40010_snapshot_onload(&dst->ga, &ga);
+    // rebase the memory map from src to dst
+    mem_ext_range_t src_roms[3], dst_roms[3];
+    _cpc_rom_ranges(src, src_roms);
+    _cpc_rom_ranges(dst, dst_roms);
+    mem_snapshot_onsave_ext(&dst->mem, src, src_roms, 3);
+    mem_snapshot_onload_ext(&dst->mem, dst, dst_roms, 3);
+    chips_dirty_lines_set_all(&dst->ga.dirty_lines);
+    dst->ram_hashes = src->ram_hashes;
+}
+
+uint64_t cpc_state_hash(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != &sys->ram[0][0]) {
+        mem_track_dirty(&sys->mem, &sys->ram[0][0], sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = ay38910_hash(&sys->psg, h);
+    h = CHIPS_HASH(h, sys->crtc);
+    h = CHIPS_HASH(h, sys->ppi);
+    h = upd765_hash(&sys->fdc, h);
+    h = am40010_hash(&sys->ga, h);
+    h = fdd_hash(&sys->fdd, h);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->kbd_joymask);
+    h = CHIPS_HASH(h, sys->joy_joymask);
+    h = CHIPS_HASH(h, sys->pins);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return h;
+}
+
+#if defined(CHIPS_PROFILE)
+chips_profile_t* cpc_profile_info(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return &sys->profile;
+}
+#endif
+
 #endif /* CHIPS_IMPL */
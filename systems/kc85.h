@@ -21,6 +21,9 @@
     CHIPS_ASSERT(c)
         your own assert macro (default: assert(c))
 
+    Optionally define CHIPS_SHARED_ROMS before including kc85.h to remove the
+    embedded ROM image arrays from kc85_t (see 'Shared ROM Images' below).
+
     You need to include the following headers before including kc85.h:
 
     - chips/chips_common.h
@@ -32,6 +35,19 @@
     - chips/mem.h
     - chips/clk.h
 
+    ## Shared ROM Images
+
+    By default kc85_init() copies the ROM images from kc85_desc_t.roms into
+    the kc85_t struct. When running many emulator instances side by side,
+    set kc85_desc_t.shared_roms to true, this maps the ROM pages directly
+    from the caller-owned buffers in kc85_desc_t.roms without copying. Those
+    buffers must remain valid and unchanged until the kc85_t instance is
+    discarded. ROM modules in the expansion slots are still copied into the
+    kc85_t struct.
+
+    If CHIPS_SHARED_ROMS is defined, the embedded ROM arrays are removed
+    from kc85_t altogether and kc85_desc_t.shared_roms is implied.
+
     ## The KC85/2
 
     This was the ur-model of the KC85 family designed and manufactured
@@ -229,6 +245,47 @@
         - bits 2..6:    unused
         - bit 7:        enable the 4 KByte CAOS ROM bank at C000
 
+    ## Tape Load Trap
+
+    The cassette interface isn't emulated, but a tape made of concatenated
+    KCC or KC-TAP files can be inserted with kc85_insert_tape(). While a
+    tape is inserted and the CAOS ROM is mapped, the CAOS program call
+    entry at F003 (CALL F003h followed by the UP number byte) is trapped,
+    and the LOAD call (UP number 10h) is satisfied directly: the next file
+    on the tape is copied into memory, the carry flag is cleared, and
+    execution continues behind the UP number byte, or at the file's
+    start address if the file has one (with the caller's return address
+    pushed on the stack). If no valid file is left on the tape, the carry
+    flag is set instead. All other program calls run through CAOS as usual.
+
+    ## Text Input
+
+    kc85_type_text() queues a caller-owned ASCII text which must remain
+    valid until kc85_is_typing_text() returns false. The characters are
+    patched into the CAOS keyboard variables the same way as regular key
+    presses (see 'KEYBOARD INPUT' in the implementation), but without the
+    key-repeat handling: at the end of kc85_exec(), the next character is
+    passed to CAOS as soon as it has read the previous one. Newlines become
+    ENTER, other control characters are dropped. While text is queued, the
+    keyboard is ignored.
+
+    ## State Hash
+
+    kc85_state_hash() hashes the emulation state (CPU, CTC, PIO, video and
+    keyboard state, the RAM banks and the used part of the expansion
+    module buffer), for instance to compare the state of two netplay
+    peers. The first call switches on dirty tracking of the RAM banks in
+    kc85_t.mem, so that later calls only need to rehash written RAM pages.
+
+    ## Observation
+
+    kc85_observe() returns pointers to the RAM banks ("ram", 8 banks of
+    16 KBytes which include the video RAM, not all of them are used on
+    each model) and the expansion module buffer ("exp_buf", RAM and ROM
+    of the inserted modules), the display info and the z80_t CPU state
+    (see chips_observation_t in chips_common.h). The vblank callback in
+    kc85_desc_t is invoked when the video scanline counter wraps around.
+
     ## TODO:
 
     - optionally proper keyboard emulation (the current implementation
@@ -285,12 +342,15 @@ extern "C" {
 #define KC85_IRM0_PAGE (4)
 
 // bump this whenever the kc85_t struct layout changes
-#define KC85_SNAPSHOT_VERSION (KC85_TYPE_ID | 0x0002)
+#define KC85_SNAPSHOT_VERSION (KC85_TYPE_ID | 0x0003)
 
 #define KC85_MAX_AUDIO_SAMPLES (1024U)      // max number of audio samples in internal sample buffer
 #define KC85_DEFAULT_AUDIO_SAMPLES (128)    // default number of samples in internal sample buffer
 #define KC85_EXP_NUM_SLOTS (2U)             // 2 expansion slots in main unit, each needs one mem_t layer!
 #define KC85_EXP_BUFSIZE (KC85_EXP_NUM_SLOTS*64U*1024U) // expansion system buffer size (64 KB per slot)
+#define KC85_NUM_BANK_REGIONS (4)           // 16 KByte regions of the base unit memory map with prebuilt page rows
+#define KC85_MAX_BANK_STATES (9)            // max number of bank switching states per region
+#define KC85_BANK_REGION_PAGES (0x4000 / MEM_PAGE_SIZE)
 
 #define KC85_FRAMEBUFFER_WIDTH (512)   // multiple of 256
 #define KC85_FRAMEBUFFER_HEIGHT (256)  // FIXME: allow border?
@@ -341,11 +401,16 @@ typedef struct {
 // config parameters for kc85_init()
 typedef struct {
     chips_debug_t debug;
+    chips_headless_t headless;  // optional headless video mode (see chips_common.h)
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
 
     // an optional callback to be invoked after a snapshot file is loaded to apply patches
     kc85_patch_callback_t patch_callback;
 
+    // if true, map ROM pages directly from the roms buffers (no copy)
+    bool shared_roms;
+
     // ROM images
     struct {
         #if defined(CHIPS_KC85_TYPE_2)
@@ -401,7 +466,8 @@ typedef struct {
     uint32_t buf_top;                       // offset of free area in expansion buffer (kc85_t.exp_buf[])
 } kc85_exp_t;
 
-// KC85 emulator state
+// KC85 emulator state, the state accessed in each tick comes first,
+// large or rarely accessed buffers are placed at the end
 typedef struct {
     z80_t cpu;
     mem_t mem;
@@ -420,13 +486,18 @@ typedef struct {
     beeper_t beeper_2;
     z80pio_t pio;
     kc85_exp_t exp;         // expansion module system
+    uint8_t bank_state[KC85_NUM_BANK_REGIONS];  // currently mapped bank state per 16 KByte region
 
     uint64_t pins;
+    uint64_t tick;          // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     uint64_t freq_hz;
-    kbd_t kbd;
+    chips_iomap_t iomap;    // IO port to device select bits
 
+    kbd_t kbd;
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
 
     struct {
         chips_audio_callback_t callback;
@@ -435,8 +506,17 @@ typedef struct {
         float sample_buffer[KC85_MAX_AUDIO_SAMPLES];
     } audio;
     kc85_patch_callback_t patch_callback;
-
+    chips_tape_t tape;                  // optional tape for the CAOS LOAD trap
+    chips_text_input_t text_input;      // queued text for kc85_type_text()
+    mem_page_t bank_rows[KC85_NUM_BANK_REGIONS][KC85_MAX_BANK_STATES][KC85_BANK_REGION_PAGES];    // prebuilt layer 0 page items
+
+    bool shared_roms;                   // ROM pages are mapped from caller-owned buffers
+    const uint8_t* rom_basic_ptr;       // ROM images, pointing into rom_xxx[] or to shared buffers
+    const uint8_t* rom_caos_c_ptr;
+    const uint8_t* rom_caos_e_ptr;
     uint8_t ram[8][0x4000];             // up to 8 16-KByte RAM banks
+    chips_page_hashes_t ram_hashes;     // cached RAM page hashes for kc85_state_hash()
+    #if !defined(CHIPS_SHARED_ROMS)
     #if defined(CHIPS_KC85_TYPE_3) || defined(CHIPS_KC85_TYPE_4)
         uint8_t rom_basic[0x2000];          // 8 KByte BASIC ROM (KC85/3 and /4 only)
     #endif
@@ -444,7 +524,9 @@ typedef struct {
         uint8_t rom_caos_c[0x1000];         // 4 KByte CAOS ROM at 0xC000 (KC85/4 only)
     #endif
     uint8_t rom_caos_e[0x2000];         // 8 KByte CAOS ROM at 0xE000
+    #endif
     uint8_t exp_buf[KC85_EXP_BUFSIZE];  // expansion system RAM/ROM
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
     alignas(64) uint8_t fb[KC85_FRAMEBUFFER_SIZE_BYTES];
 } kc85_t;
 
@@ -456,6 +538,8 @@ void kc85_discard(kc85_t* sys);
 void kc85_reset(kc85_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t kc85_display_info(kc85_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t kc85_observe(kc85_t* sys);
 // run KC85 emulation for a given number of microseconds, returns number of ticks executed
 uint32_t kc85_exec(kc85_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -498,10 +582,22 @@ uint16_t kc85_kcc_exec_addr(chips_range_t data);
 uint16_t kc85_quickload_return_addr(void);
 // load a .KCC or .TAP snapshot file into the emulator and optionally try to start
 bool kc85_quickload(kc85_t* sys, chips_range_t data, bool start);
+// insert a tape of concatenated .KCC or .TAP files for the LOAD trap (data must remain valid until removed)
+void kc85_insert_tape(kc85_t* sys, chips_range_t data);
+// remove the tape
+void kc85_remove_tape(kc85_t* sys);
+// return true if a tape is inserted
+bool kc85_tape_inserted(kc85_t* sys);
+// type a caller-owned ASCII text through the CAOS keyboard variables (see 'Text Input')
+void kc85_type_text(kc85_t* sys, chips_range_t text);
+// return true while queued text is left to type
+bool kc85_is_typing_text(kc85_t* sys);
 // take snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t kc85_save_snapshot(kc85_t* sys, kc85_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool kc85_load_snapshot(kc85_t* sys, uint32_t version, const kc85_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t kc85_state_hash(kc85_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -539,28 +635,32 @@ bool kc85_load_snapshot(kc85_t* sys, uint32_t version, const kc85_t* src);
          0x84:   (KC85/4 only) control the vide memory bank switching
          0x86:   (KC85/4 only) control RAM block at 0x4000 and ROM switching
 */
-// IO area 0x80..0x8F
-#define _KC85_IO_SEL_MASK (Z80_M1|Z80_IORQ|Z80_A7|Z80_A6|Z80_A5|Z80_A4)
-#define _KC85_IO_SEL_PINS (Z80_IORQ|Z80_A7)
-// CTC ports 0x8C..0x8F
-#define _KC85_CTC_SEL_MASK (_KC85_IO_SEL_MASK|Z80_A3|Z80_A2)
-#define _KC85_CTC_SEL_PINS (_KC85_IO_SEL_PINS|Z80_A3|Z80_A2)
-// PIO ports 0x88..0x8B
-#define _KC85_PIO_SEL_MASK (_KC85_IO_SEL_MASK|Z80_A3|Z80_A2)
-#define _KC85_PIO_SEL_PINS (_KC85_IO_SEL_PINS|Z80_A3)
-// expansion module system port 0x80
-#define _KC85_EXP_SEL_MASK (_KC85_IO_SEL_MASK|Z80_A3|Z80_A2|Z80_A1|Z80_A0)
-#define _KC85_EXP_SEL_PINS (_KC85_IO_SEL_PINS)
-#if defined(CHIPS_KC85_TYPE_4)
-// KC85/4 port 0x84
-#define _KC85_IO84_SEL_MASK (_KC85_IO_SEL_MASK|Z80_A3|Z80_A2|Z80_A1|Z80_A0)
-#define _KC85_IO84_SEL_PINS (_KC85_IO_SEL_PINS|Z80_A2)
-// KC85/4 port 0x86
-#define _KC85_IO86_SEL_MASK (_KC85_IO_SEL_MASK|Z80_A3|Z80_A2|Z80_A1|Z80_A0)
-#define _KC85_IO86_SEL_PINS (_KC85_IO_SEL_PINS|Z80_A2|Z80_A1)
-#endif
+// IO port select bits in the IO port select table
+#define _KC85_IOSEL_CTC     (1<<0)
+#define _KC85_IOSEL_PIO     (1<<1)
+#define _KC85_IOSEL_EXP     (1<<2)
+#define _KC85_IOSEL_IO84    (1<<3)
+#define _KC85_IOSEL_IO86    (1<<4)
+
+// fill the IO port select table, only the IO area 0x80..0x8F is used
+static void _kc85_init_iomap(kc85_t* sys) {
+    chips_iomap_clear(&sys->iomap);
+    // CTC ports 0x8C..0x8F
+    chips_iomap_add(&sys->iomap, 0xFC, 0x8C, _KC85_IOSEL_CTC);
+    // PIO ports 0x88..0x8B
+    chips_iomap_add(&sys->iomap, 0xFC, 0x88, _KC85_IOSEL_PIO);
+    // expansion module system port 0x80
+    chips_iomap_add(&sys->iomap, 0xFF, 0x80, _KC85_IOSEL_EXP);
+    #if defined(CHIPS_KC85_TYPE_4)
+    // KC85/4 ports 0x84 and 0x86
+    chips_iomap_add(&sys->iomap, 0xFF, 0x84, _KC85_IOSEL_IO84);
+    chips_iomap_add(&sys->iomap, 0xFF, 0x86, _KC85_IOSEL_IO86);
+    #endif
+}
 
 static void _kc85_update_memory_map(kc85_t* sys);
+static void _kc85_update_bank_rows(kc85_t* sys);
+static void _kc85_init_bank_rows(kc85_t* sys);
 static void _kc85_init_memory_map(kc85_t* sys);
 static void _kc85_handle_keyboard(kc85_t* sys);
 
@@ -590,26 +690,47 @@ void kc85_init(kc85_t* sys, const kc85_desc_t* desc) {
     sys->freq_hz = KC85_FREQUENCY;
     sys->patch_callback = desc->patch_callback;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
+    _kc85_init_iomap(sys);
 
-    // copy ROM images
+    // copy or share ROM images
     #if defined(CHIPS_KC85_TYPE_2)
         // KC85/2 only has an 8 KByte OS ROM
-        CHIPS_ASSERT(desc->roms.caos22.ptr && (desc->roms.caos22.size == sizeof(sys->rom_caos_e)));
-        memcpy(sys->rom_caos_e, desc->roms.caos22.ptr, sizeof(sys->rom_caos_e));
+        CHIPS_ASSERT(desc->roms.caos22.ptr && (desc->roms.caos22.size == 0x2000));
+        sys->rom_caos_e_ptr = (const uint8_t*) desc->roms.caos22.ptr;
     #elif defined(CHIPS_KC85_TYPE_3)
         // KC85/3 has 8 KByte BASIC ROM and 8 KByte OS ROM
-        CHIPS_ASSERT(desc->roms.kcbasic.ptr && (desc->roms.kcbasic.size == sizeof(sys->rom_basic)));
-        memcpy(sys->rom_basic, desc->roms.kcbasic.ptr, sizeof(sys->rom_basic));
-        CHIPS_ASSERT(desc->roms.caos31.ptr && (desc->roms.caos31.size == sizeof(sys->rom_caos_e)));
-        memcpy(sys->rom_caos_e, desc->roms.caos31.ptr, sizeof(sys->rom_caos_e));
+        CHIPS_ASSERT(desc->roms.kcbasic.ptr && (desc->roms.kcbasic.size == 0x2000));
+        sys->rom_basic_ptr = (const uint8_t*) desc->roms.kcbasic.ptr;
+        CHIPS_ASSERT(desc->roms.caos31.ptr && (desc->roms.caos31.size == 0x2000));
+        sys->rom_caos_e_ptr = (const uint8_t*) desc->roms.caos31.ptr;
     #else
         // KC85/4 has 8 KByte BASIC ROM, and 2 OS ROMs (4 KB and 8 KB)
-        CHIPS_ASSERT(desc->roms.kcbasic.ptr && (desc->roms.kcbasic.size == sizeof(sys->rom_basic)));
-        memcpy(sys->rom_basic, desc->roms.kcbasic.ptr, sizeof(sys->rom_basic));
-        CHIPS_ASSERT(desc->roms.caos42c.ptr && (desc->roms.caos42c.size == sizeof(sys->rom_caos_c)));
-        memcpy(sys->rom_caos_c, desc->roms.caos42c.ptr, sizeof(sys->rom_caos_c));
-        CHIPS_ASSERT(desc->roms.caos42e.ptr && (desc->roms.caos42e.size == sizeof(sys->rom_caos_e)));
-        memcpy(sys->rom_caos_e, desc->roms.caos42e.ptr, sizeof(sys->rom_caos_e));
+        CHIPS_ASSERT(desc->roms.kcbasic.ptr && (desc->roms.kcbasic.size == 0x2000));
+        sys->rom_basic_ptr = (const uint8_t*) desc->roms.kcbasic.ptr;
+        CHIPS_ASSERT(desc->roms.caos42c.ptr && (desc->roms.caos42c.size == 0x1000));
+        sys->rom_caos_c_ptr = (const uint8_t*) desc->roms.caos42c.ptr;
+        CHIPS_ASSERT(desc->roms.caos42e.ptr && (desc->roms.caos42e.size == 0x2000));
+        sys->rom_caos_e_ptr = (const uint8_t*) desc->roms.caos42e.ptr;
+    #endif
+    #if defined(CHIPS_SHARED_ROMS)
+        sys->shared_roms = true;
+    #else
+        sys->shared_roms = desc->shared_roms;
+        if (!sys->shared_roms) {
+            #if !defined(CHIPS_KC85_TYPE_2)
+                memcpy(sys->rom_basic, sys->rom_basic_ptr, sizeof(sys->rom_basic));
+                sys->rom_basic_ptr = sys->rom_basic;
+            #endif
+            #if defined(CHIPS_KC85_TYPE_4)
+                memcpy(sys->rom_caos_c, sys->rom_caos_c_ptr, sizeof(sys->rom_caos_c));
+                sys->rom_caos_c_ptr = sys->rom_caos_c;
+            #endif
+            memcpy(sys->rom_caos_e, sys->rom_caos_e_ptr, sizeof(sys->rom_caos_e));
+            sys->rom_caos_e_ptr = sys->rom_caos_e;
+        }
     #endif
 
     // fill RAM with noise (only KC85/2 and /3)
@@ -750,6 +871,7 @@ static inline uint64_t _kc85_update_raster_counters(kc85_t* sys, uint64_t pins)
         sys->video.v_count++;
         if (sys->video.v_count == KC85_NUM_SCANLINES) {
             sys->video.v_count = 0;
+            chips_vblank_notify(&sys->vblank);
         }
     }
     return pins;
@@ -758,7 +880,7 @@ static inline uint64_t _kc85_update_raster_counters(kc85_t* sys, uint64_t pins)
 #if defined(CHIPS_KC85_TYPE_2) || defined(CHIPS_KC85_TYPE_3)
 static uint64_t _kc85_tick_video(kc85_t* sys, uint64_t pins) {
     // every 2 CPU ticks, 8 pixels are decoded
-    if (sys->video.h_tick & 1) {
+    if ((sys->video.h_tick & 1) && !sys->headless.skip) {
         uint16_t x = sys->video.h_tick>>1;
         uint16_t y = sys->video.v_count;
         if ((y < 256) && (x < 40)) {
@@ -782,8 +904,9 @@ static uint64_t _kc85_tick_video(kc85_t* sys, uint64_t pins) {
             // same as (pins & Z80_WR) && (addr >= 0x8000) && (addr < 0xC000)
             bool cpu_access = (pins & (Z80_WR | 0xC000)) == (Z80_WR | 0x8000);
             uint8_t pixel_bits = (fg_blank || cpu_access) ? 0 : sys->ram[KC85_IRM0_PAGE][pixel_offset];
-            uint8_t* dst = &(sys->fb[y*KC85_FRAMEBUFFER_WIDTH + x*8]);
-            _kc85_decode_8pixels(dst, pixel_bits, color_bits);
+            uint8_t pixels[8];
+            _kc85_decode_8pixels(pixels, pixel_bits, color_bits);
+            chips_dirty_lines_copy(&sys->dirty_lines, y, &(sys->fb[y*KC85_FRAMEBUFFER_WIDTH + x*8]), pixels, sizeof(pixels));
         }
     }
     return _kc85_update_raster_counters(sys, pins);
@@ -815,118 +938,217 @@ static inline void _kc85_decode_hicolor_8pixels(uint8_t* dst, uint8_t p0, uint8_
 
 static uint64_t _kc85_tick_video(kc85_t* sys, uint64_t pins) {
     // decode 8 pixels every second tick
-    if (sys->video.h_tick & 1) {
+    if ((sys->video.h_tick & 1) && !sys->headless.skip) {
         uint16_t x = sys->video.h_tick>>1;
         uint16_t y = sys->video.v_count;
         if ((y < 256) && (x < 40)) {
             size_t irm_index = (sys->io84 & 1) * 2;
             size_t offset = (x<<8) | y;
             uint8_t color_bits = sys->ram[KC85_IRM0_PAGE + irm_index + 1][offset];
-            uint8_t* dst = &sys->fb[y * KC85_FRAMEBUFFER_WIDTH + x * 8];
+            uint8_t pixels[8];
             if (sys->io84 & KC85_IO84_HICOLOR) {
                 // regular KC85/4 video mode
                 bool fg_blank = 0 != (color_bits & (sys->flip_flops>>(Z80CTC_BIT_ZCTO2-7)) & (sys->pio_pins>>(Z80PIO_PIN_PB7-7)) & (1<<7));
                 uint8_t pixel_bits = fg_blank ? 0 : sys->ram[KC85_IRM0_PAGE + irm_index][offset];
-                _kc85_decode_8pixels(dst, pixel_bits, color_bits);
+                _kc85_decode_8pixels(pixels, pixel_bits, color_bits);
             }
             else {
                 // hicolor mode
                 uint8_t p0 = sys->ram[KC85_IRM0_PAGE + irm_index][offset];
                 uint8_t p1 = color_bits;
-                _kc85_decode_hicolor_8pixels(dst, p0, p1);
+                _kc85_decode_hicolor_8pixels(pixels, p0, p1);
             }
+            chips_dirty_lines_copy(&sys->dirty_lines, y, &sys->fb[y * KC85_FRAMEBUFFER_WIDTH + x * 8], pixels, sizeof(pixels));
         }
     }
     return _kc85_update_raster_counters(sys, pins);
 }
 #endif
 
-static void _kc85_update_memory_map(kc85_t* sys) {
-    mem_unmap_layer(&sys->mem, 0);
+/*
+    The base unit memory mapping in layer 0 is switched in 16 KByte
+    regions. Each region only has a few possible bank states (derived
+    from the memory bits in PIO port A, and on the KC85/4 in the IO84
+    and IO86 latches). The page items of all states are prebuilt by
+    _kc85_init_bank_rows(), so that a bank switch only copies the
+    prebuilt page rows of the regions whose state has changed into
+    layer 0.
+*/
+static uint8_t _kc85_bank_state(const kc85_t* sys, int region) {
     const uint64_t pio_pins = sys->pio_pins;
-
-    // all models have 16 KB builtin RAM at 0x0000 and 8 KB ROM at 0xE000
-    if (pio_pins & KC85_PIO_RAM) {
-        if (pio_pins & KC85_PIO_RAM_RO) {
-            mem_map_ram(&sys->mem, 0, 0x0000, 0x4000, sys->ram[0]);
-        }
-        else {
-            mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->ram[0]);
+    switch (region) {
+        // all models have 16 KB builtin RAM at 0x0000
+        case 0:
+            return (pio_pins & KC85_PIO_RAM) ? ((pio_pins & KC85_PIO_RAM_RO) ? 2 : 1) : 0;
+        // KC85/4: 16 KB RAM at 0x4000
+        case 1:
+            #if defined(CHIPS_KC85_TYPE_4)
+                return (sys->io86 & KC85_IO86_RAM4) ? ((sys->io86 & KC85_IO86_RAM4_RO) ? 2 : 1) : 0;
+            #else
+                return 0;
+            #endif
+        // video RAM at 0x8000, KC85/4: video RAM on top of 2 RAM banks
+        case 2:
+            #if defined(CHIPS_KC85_TYPE_4)
+                if (pio_pins & KC85_PIO_IRM) {
+                    return 5 + ((sys->io84 & 6)>>1);
+                }
+                else if (pio_pins & KC85_PIO_RAM8) {
+                    return 1 + ((sys->io84 & KC85_IO84_SEL_RAM8) ? 2 : 0) + ((pio_pins & KC85_PIO_RAM8_RO) ? 1 : 0);
+                }
+                else {
+                    return 0;
+                }
+            #else
+                return (pio_pins & KC85_PIO_IRM) ? 1 : 0;
+            #endif
+        // BASIC ROM (KC85/3 and /4), CAOS-C ROM (KC85/4) and CAOS-E ROM
+        default: {
+            uint8_t state = (pio_pins & KC85_PIO_CAOS_ROM) ? 4 : 0;
+            #if !defined(CHIPS_KC85_TYPE_2)
+                if (pio_pins & KC85_PIO_BASIC_ROM) { state |= 1; }
+            #endif
+            #if defined(CHIPS_KC85_TYPE_4)
+                if (sys->io86 & KC85_IO86_CAOS_ROM_C) { state |= 2; }
+            #endif
+            return state;
         }
     }
-    if (pio_pins & KC85_PIO_CAOS_ROM) {
-        mem_map_rom(&sys->mem, 0, 0xE000, 0x2000, sys->rom_caos_e);
-    }
-
-    // KC85/3 and KC85/4: builtin 8 KB BASIC ROM at 0xC000
-    #if !defined(CHIPS_KC85_TYPE_2)
-        if (pio_pins & KC85_PIO_BASIC_ROM) {
-            mem_map_rom(&sys->mem, 0, 0xC000, 0x2000, sys->rom_basic);
-        }
-    #endif
+}
 
-    #if !defined(CHIPS_KC85_TYPE_4) // KC85/2 and /3
-        // 16 KB Video RAM at 0x8000
-        if (pio_pins & KC85_PIO_IRM) {
-            mem_map_ram(&sys->mem, 0, 0x8000, 0x4000, sys->ram[KC85_IRM0_PAGE]);
-        }
-    #else // KC84/4
-        // 16 KB RAM at 0x4000
-        if (sys->io86 & KC85_IO86_RAM4) {
-            if (sys->io86 & KC85_IO86_RAM4_RO) {
-                mem_map_ram(&sys->mem, 0, 0x4000, 0x4000, sys->ram[1]);
-            }
-            else {
-                mem_map_rom(&sys->mem, 0, 0x4000, 0x4000, sys->ram[1]);
+// map a 16 KByte region of the base unit for a bank state (see _kc85_bank_state())
+static void _kc85_map_bank_region(kc85_t* sys, size_t layer, int region, uint8_t state) {
+    switch (region) {
+        case 0:
+            if (state == 2) {
+                mem_map_ram(&sys->mem, layer, 0x0000, 0x4000, sys->ram[0]);
             }
-        }
-        // 16 KB RAM at 0x8000 (2 banks)
-        if (pio_pins & KC85_PIO_RAM8) {
-            // select one of two RAM banks
-            uint8_t* ram8_ptr = (sys->io84 & KC85_IO84_SEL_RAM8) ? sys->ram[3] : sys->ram[2];
-            if (pio_pins & KC85_PIO_RAM8_RO) {
-                mem_map_ram(&sys->mem, 0, 0x8000, 0x4000, ram8_ptr);
+            else if (state == 1) {
+                mem_map_rom(&sys->mem, layer, 0x0000, 0x4000, sys->ram[0]);
             }
-            else {
-                mem_map_rom(&sys->mem, 0, 0x8000, 0x4000, ram8_ptr);
+            break;
+        case 1:
+            #if defined(CHIPS_KC85_TYPE_4)
+                if (state == 2) {
+                    mem_map_ram(&sys->mem, layer, 0x4000, 0x4000, sys->ram[1]);
+                }
+                else if (state == 1) {
+                    mem_map_rom(&sys->mem, layer, 0x4000, 0x4000, sys->ram[1]);
+                }
+            #endif
+            break;
+        case 2:
+            #if !defined(CHIPS_KC85_TYPE_4) // KC85/2 and /3
+                // 16 KB Video RAM at 0x8000
+                if (state == 1) {
+                    mem_map_ram(&sys->mem, layer, 0x8000, 0x4000, sys->ram[KC85_IRM0_PAGE]);
+                }
+            #else // KC85/4
+                if (state >= 5) {
+                    /* video memory is 4 banks, 2 for pixels, 2 for colors,
+                       on the KC85, an access to IRM banks other than the
+                       first is only possible for the first 10 KByte until
+                       A800, memory access to the remaining 6 KBytes
+                       (A800 to BFFF) is always forced to the first IRM bank
+                       by the address decoder hardware (see KC85/4 service manual)
+                    */
+                    uint8_t* irm_ptr = sys->ram[KC85_IRM0_PAGE + (state - 5)];
+                    mem_map_ram(&sys->mem, layer, 0x8000, 0x2800, irm_ptr);
+                    mem_map_ram(&sys->mem, layer, 0xA800, 0x1800, sys->ram[KC85_IRM0_PAGE] + 0x2800);
+                }
+                else if (state >= 1) {
+                    // 16 KB RAM at 0x8000 (2 banks)
+                    uint8_t* ram8_ptr = ((state - 1) & 2) ? sys->ram[3] : sys->ram[2];
+                    if ((state - 1) & 1) {
+                        mem_map_ram(&sys->mem, layer, 0x8000, 0x4000, ram8_ptr);
+                    }
+                    else {
+                        mem_map_rom(&sys->mem, layer, 0x8000, 0x4000, ram8_ptr);
+                    }
+                }
+            #endif
+            break;
+        default:
+            #if !defined(CHIPS_KC85_TYPE_2)
+                if (state & 1) {
+                    mem_map_rom(&sys->mem, layer, 0xC000, 0x2000, sys->rom_basic_ptr);
+                }
+            #endif
+            #if defined(CHIPS_KC85_TYPE_4)
+                // 4 KB CAOS-C ROM at 0xC000 (on top of BASIC)
+                if (state & 2) {
+                    mem_map_rom(&sys->mem, layer, 0xC000, 0x1000, sys->rom_caos_c_ptr);
+                }
+            #endif
+            if (state & 4) {
+                mem_map_rom(&sys->mem, layer, 0xE000, 0x2000, sys->rom_caos_e_ptr);
             }
+            break;
+    }
+}
+
+/* prebuild the layer 0 page items of all bank states, this must be called
+   again whenever the host memory location of the RAM or ROMs changes
+   (e.g. after loading a snapshot)
+*/
+static void _kc85_init_bank_rows(kc85_t* sys) {
+    // the page items are built in the lowest priority layer, which isn't used by modules
+    const size_t layer = MEM_NUM_LAYERS - 1;
+    CHIPS_ASSERT(layer > KC85_EXP_NUM_SLOTS);
+    for (int region = 0; region < KC85_NUM_BANK_REGIONS; region++) {
+        for (int state = 0; state < KC85_MAX_BANK_STATES; state++) {
+            mem_unmap_layer(&sys->mem, layer);
+            _kc85_map_bank_region(sys, layer, region, (uint8_t)state);
+            mem_get_pages(&sys->mem, layer, (uint16_t)(region * 0x4000), sys->bank_rows[region][state], KC85_BANK_REGION_PAGES);
         }
-        /* video memory is 4 banks, 2 for pixels, 2 for colors,
-            the area at 0xA800 to 0xBFFF is always mapped to IRM0!
-        */
-        if (pio_pins & KC85_PIO_IRM) {
-            uint32_t irm_index = (sys->io84 & 6)>>1;
-            uint8_t* irm_ptr = sys->ram[KC85_IRM0_PAGE + irm_index];
-            /* on the KC85, an access to IRM banks other than the
-              first is only possible for the first 10 KByte until
-              A800, memory access to the remaining 6 KBytes
-              (A800 to BFFF) is always forced to the first IRM bank
-              by the address decoder hardware (see KC85/4 service manual)
-            */
-            mem_map_ram(&sys->mem, 0, 0x8000, 0x2800, irm_ptr);
-
-            // always force access to 0xA800 and above to the first IRM bank
-            mem_map_ram(&sys->mem, 0, 0xA800, 0x1800, sys->ram[KC85_IRM0_PAGE] + 0x2800);
-       }
-       // 4 KB CAOS-C ROM at 0xC000 (on top of BASIC)
-       if (sys->io86 & KC85_IO86_CAOS_ROM_C) {
-           mem_map_rom(&sys->mem, 0, 0xC000, 0x1000, sys->rom_caos_c);
-       }
-    #endif // KC85/4
+    }
+    mem_unmap_layer(&sys->mem, layer);
+}
+
+// bank switching in the base unit, only copies the page rows of changed regions
+static void _kc85_update_bank_rows(kc85_t* sys) {
+    for (int region = 0; region < KC85_NUM_BANK_REGIONS; region++) {
+        const uint8_t state = _kc85_bank_state(sys, region);
+        CHIPS_ASSERT(state < KC85_MAX_BANK_STATES);
+        if (state != sys->bank_state[region]) {
+            sys->bank_state[region] = state;
+            mem_map_pages(&sys->mem, 0, (uint16_t)(region * 0x4000), sys->bank_rows[region][state], KC85_BANK_REGION_PAGES);
+        }
+    }
+}
+
+static void _kc85_update_memory_map(kc85_t* sys) {
+    // force an update of all regions
+    memset(sys->bank_state, 0xFF, sizeof(sys->bank_state));
+    _kc85_update_bank_rows(sys);
 
     // let the module system update it's memory mapping
     _kc85_exp_update_memory_mapping(sys);
 }
 
+// CAOS program call entry and LOAD UP number
+#define _KC85_CAOS_PV1_ADDR (0xF003)
+#define _KC85_CAOS_UP_LOAD  (0x10)
+#define _KC85_FETCH_PINS    (Z80_M1|Z80_MREQ|Z80_RD)
+
+static uint64_t _kc85_tape_trap(kc85_t* sys, uint64_t pins);
+
 static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
+    sys->tick++;
     // tick the CPU
     pins = z80_tick(&sys->cpu, pins) & Z80_PIN_MASK;
 
+    // IO address decoding, only the lower 8 address bits are decoded
+    const uint8_t io_sel = ((pins & (Z80_IORQ|Z80_M1)) == Z80_IORQ) ? chips_iomap_select(&sys->iomap, (uint8_t)Z80_GET_ADDR(pins)) : 0;
+
     // handle memory requests
     if (pins & Z80_MREQ) {
         const uint16_t addr = Z80_GET_ADDR(pins);
         if (pins & Z80_RD) {
             Z80_SET_DATA(pins, mem_rd(&sys->mem, addr));
+            if ((addr == _KC85_CAOS_PV1_ADDR) && sys->tape.ptr && ((pins & _KC85_FETCH_PINS) == _KC85_FETCH_PINS)) {
+                pins = _kc85_tape_trap(sys, pins);
+            }
         }
         else if (pins & Z80_WR) {
             mem_wr(&sys->mem, addr, Z80_GET_DATA(pins));
@@ -940,7 +1162,7 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
     {
         // set virtual IEIO pin because CTC is highest priority interrupt device
         pins |= Z80_IEIO;
-        if ((pins & _KC85_CTC_SEL_MASK) == _KC85_CTC_SEL_PINS) {
+        if (io_sel & _KC85_IOSEL_CTC) {
             pins |= Z80CTC_CE;
         }
         if (pins & Z80_A0) { pins |= Z80CTC_CS0; }
@@ -952,9 +1174,10 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
     }
 
     // tick the PIO
-    bool memory_mapping_dirty = false;
+    bool memory_mapping_dirty = false;  // base unit bank switching
+    bool exp_mapping_dirty = false;     // expansion module control byte written
     {
-        if ((pins & _KC85_PIO_SEL_MASK) == _KC85_PIO_SEL_PINS) {
+        if (io_sel & _KC85_IOSEL_PIO) {
             pins |= Z80PIO_CE;
         }
         if (pins & Z80_A0) { pins |= Z80PIO_BASEL; }
@@ -989,23 +1212,17 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
     beeper_tick(&sys->beeper_1);
     if (beeper_tick(&sys->beeper_2)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper_1.sample + sys->beeper_2.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
-        }
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->beeper_1.sample + sys->beeper_2.sample, sys->tick);
     }
 
     // IO port 0x80: expansion module control, high byte of
     // port address contains module slot address
-    if ((pins & _KC85_EXP_SEL_MASK) == _KC85_EXP_SEL_PINS) {
+    if (io_sel & _KC85_IOSEL_EXP) {
         const uint8_t slot_addr = pins>>Z80_PIN_A8;
         if (pins & Z80_WR) {
             // write new control byte and update the memory mapping
             const uint8_t data = Z80_GET_DATA(pins);
-            memory_mapping_dirty |= _kc85_exp_write_ctrl(sys, slot_addr, data);
+            exp_mapping_dirty |= _kc85_exp_write_ctrl(sys, slot_addr, data);
         }
         else if (pins & Z80_RD) {
             // read module id in slot
@@ -1015,14 +1232,14 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
 
     // KC85/4 ports 0x84 and 0x86, these are write-only 8-bit latches
     #if defined(CHIPS_KC85_TYPE_4)
-    if ((pins & _KC85_IO84_SEL_MASK) == _KC85_IO84_SEL_PINS) {
+    if (io_sel & _KC85_IOSEL_IO84) {
         if (pins & Z80_WR) {
             const uint8_t data = Z80_GET_DATA(pins);
             memory_mapping_dirty |= (data ^ sys->io84) & KC85_IO84_MEMORY_BITS;
             sys->io84 = data;
         }
     }
-    if ((pins & _KC85_IO86_SEL_MASK) == _KC85_IO86_SEL_PINS) {
+    if (io_sel & _KC85_IOSEL_IO86) {
         if (pins & Z80_WR) {
             const uint8_t data = Z80_GET_DATA(pins);
             memory_mapping_dirty |= (data ^ sys->io86) & KC85_IO86_MEMORY_BITS;
@@ -1032,13 +1249,17 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
     #endif
 
     if (memory_mapping_dirty) {
-        _kc85_update_memory_map(sys);
+        _kc85_update_bank_rows(sys);
+    }
+    if (exp_mapping_dirty) {
+        _kc85_exp_update_memory_mapping(sys);
     }
     return pins;
 }
 
 uint32_t kc85_exec(kc85_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
+    chips_headless_update(&sys->headless);
     const uint32_t num_ticks = clk_us_to_ticks(sys->freq_hz, micro_seconds);
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
@@ -1048,10 +1269,15 @@ uint32_t kc85_exec(kc85_t* sys, uint32_t micro_seconds) {
         }
     }
     else {
-        // run with debug hook
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
             pins = _kc85_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
@@ -1062,6 +1288,7 @@ uint32_t kc85_exec(kc85_t* sys, uint32_t micro_seconds) {
 
 static void _kc85_init_memory_map(kc85_t* sys) {
     mem_init(&sys->mem);
+    _kc85_init_bank_rows(sys);
     sys->pio_pins = KC85_PIO_RAM | KC85_PIO_RAM_RO | KC85_PIO_IRM | KC85_PIO_CAOS_ROM;
     _kc85_update_memory_map(sys);
 }
@@ -1084,11 +1311,36 @@ static void _kc85_init_memory_map(kc85_t* sys) {
 #define _KC85_KBD_SHORT_REPEAT_COUNT (8)
 #define _KC85_KBD_LONG_REPEAT_COUNT (60)
 
+// pass the next queued text character to CAOS once it has read the previous one
+static void _kc85_handle_text_input(kc85_t* sys) {
+    const uint16_t ix = sys->cpu.ix;
+    const uint8_t flags = mem_rd(&sys->mem, ix+0x8);
+    if (flags & _KC85_KBD_KEYREADY) {
+        return;
+    }
+    int c;
+    do {
+        c = chips_text_input_next(&sys->text_input);
+        if (c == '\n') {
+            c = 0x0D;
+        }
+    } while ((c >= 0) && (c != 0x0D) && ((c < 0x20) || (c > 0x7E)));
+    if (c >= 0) {
+        mem_wr(&sys->mem, ix+0xD, (uint8_t)c);
+        mem_wr(&sys->mem, ix+0x8, (flags & ~(_KC85_KBD_TIMEOUT|_KC85_KBD_REPEAT)) | _KC85_KBD_KEYREADY);
+        mem_wr(&sys->mem, ix+0xA, 0);
+    }
+}
+
 static void _kc85_handle_keyboard(kc85_t* sys) {
     // don't do anything if interrupts disabled, IX might point to the wrong base address!
     if (!sys->cpu.iff1) {
         return;
     }
+    if (chips_text_input_pending(&sys->text_input)) {
+        _kc85_handle_text_input(sys);
+        return;
+    }
 
     // get the first valid key code from the key buffer
     uint8_t key_code = 0;
@@ -1429,7 +1681,7 @@ bool kc85_remove_module(kc85_t* sys, uint8_t slot_addr) {
 
 static bool _kc85_exp_write_ctrl(kc85_t* sys, uint8_t slot_addr, uint8_t ctrl_byte) {
     kc85_slot_t* slot = kc85_slot_by_addr(sys, slot_addr);
-    if (slot) {
+    if (slot && (slot->ctrl != ctrl_byte)) {
         slot->ctrl = ctrl_byte;
         return true;
     }
@@ -1577,8 +1829,8 @@ static bool _kc85_load_kcc(kc85_t* sys, chips_range_t data, bool start) {
     uint16_t addr = hdr->load_addr_h<<8 | hdr->load_addr_l;
     uint16_t end_addr  = hdr->end_addr_h<<8 | hdr->end_addr_l;
     const uint8_t* ptr = (const uint8_t*)data.ptr + sizeof(_kc85_kcc_header);
-    while (addr < end_addr) {
-        mem_wr(&sys->mem, addr++, *ptr++);
+    if (end_addr > addr) {
+        mem_write_range(&sys->mem, addr, ptr, end_addr - addr);
     }
     _kc85_invoke_patch_callback(sys, hdr);
     if (start && (hdr->num_addr > 2)) {
@@ -1635,9 +1887,9 @@ static bool _kc85_load_kctap(kc85_t* sys, chips_range_t data, bool start) {
     while (addr < end_addr) {
         /* each block is 1 lead-byte + 128 bytes data */
         ptr++;
-        for (size_t i = 0; i < 128; i++) {
-            mem_wr(&sys->mem, addr++, *ptr++);
-        }
+        mem_write_range(&sys->mem, addr, ptr, 128);
+        addr += 128;
+        ptr += 128;
     }
     _kc85_invoke_patch_callback(sys, &hdr->kcc);
     /* if file has an exec-address, start the program */
@@ -1647,6 +1899,99 @@ static bool _kc85_load_kctap(kc85_t* sys, chips_range_t data, bool start) {
     return true;
 }
 
+/* return the size of the KCC or KC-TAP file at the start of data on a tape, or 0 if
+    there's no valid file, both formats store the data in 128-byte blocks
+*/
+static size_t _kc85_tape_file_size(chips_range_t data, bool* is_kctap) {
+    if (kc85_is_valid_kctap(data)) {
+        const _kc85_kctap_header* hdr = (const _kc85_kctap_header*)data.ptr;
+        const size_t num_bytes = (hdr->kcc.end_addr_h<<8 | hdr->kcc.end_addr_l) - (hdr->kcc.load_addr_h<<8 | hdr->kcc.load_addr_l);
+        // each data block is 1 lead-byte + 128 bytes data
+        const size_t size = sizeof(_kc85_kctap_header) + ((num_bytes + 127) / 128) * 129;
+        *is_kctap = true;
+        return (size <= data.size) ? size : 0;
+    }
+    else if (kc85_is_valid_kcc(data)) {
+        const _kc85_kcc_header* hdr = (const _kc85_kcc_header*)data.ptr;
+        const size_t num_bytes = (hdr->end_addr_h<<8 | hdr->end_addr_l) - (hdr->load_addr_h<<8 | hdr->load_addr_l);
+        // the last block of the last file on the tape may be truncated
+        const size_t size = sizeof(_kc85_kcc_header) + ((num_bytes + 127) & ~(size_t)127);
+        *is_kctap = false;
+        return (size <= data.size) ? size : data.size;
+    }
+    else {
+        return 0;
+    }
+}
+
+/* called on the opcode fetch at the CAOS program call entry, the return
+    address on the stack points to the UP number byte
+*/
+static uint64_t _kc85_tape_trap(kc85_t* sys, uint64_t pins) {
+    if (0 == (sys->pio_pins & KC85_PIO_CAOS_ROM)) {
+        return pins;
+    }
+    const uint16_t ret_addr = mem_rd16(&sys->mem, sys->cpu.sp);
+    if (mem_rd(&sys->mem, ret_addr) != _KC85_CAOS_UP_LOAD) {
+        // not a LOAD call, continue with the fetched opcode
+        return pins;
+    }
+    const chips_range_t data = chips_tape_remaining(&sys->tape);
+    bool is_kctap = false;
+    const size_t size = _kc85_tape_file_size(data, &is_kctap);
+    if (0 == size) {
+        sys->cpu.f |= Z80_CF;
+        sys->cpu.sp += 2;
+        return z80_prefetch(&sys->cpu, ret_addr + 1);
+    }
+    const chips_range_t file = { .ptr = data.ptr, .size = size };
+    const _kc85_kcc_header* hdr;
+    if (is_kctap) {
+        _kc85_load_kctap(sys, file, false);
+        hdr = &((const _kc85_kctap_header*)file.ptr)->kcc;
+    }
+    else {
+        _kc85_load_kcc(sys, file, false);
+        hdr = (const _kc85_kcc_header*)file.ptr;
+    }
+    chips_tape_skip(&sys->tape, size);
+    sys->cpu.f &= ~Z80_CF;
+    if (hdr->num_addr > 2) {
+        // autostart, the program returns to the caller of LOAD
+        mem_wr16(&sys->mem, sys->cpu.sp, ret_addr + 1);
+        return z80_prefetch(&sys->cpu, hdr->exec_addr_h<<8 | hdr->exec_addr_l);
+    }
+    else {
+        sys->cpu.sp += 2;
+        return z80_prefetch(&sys->cpu, ret_addr + 1);
+    }
+}
+
+void kc85_insert_tape(kc85_t* sys, chips_range_t data) {
+    CHIPS_ASSERT(sys && sys->valid && data.ptr);
+    chips_tape_insert(&sys->tape, data);
+}
+
+void kc85_remove_tape(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    chips_tape_remove(&sys->tape);
+}
+
+bool kc85_tape_inserted(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return 0 != sys->tape.ptr;
+}
+
+void kc85_type_text(kc85_t* sys, chips_range_t text) {
+    CHIPS_ASSERT(sys && sys->valid);
+    chips_text_input_start(&sys->text_input, text);
+}
+
+bool kc85_is_typing_text(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return chips_text_input_pending(&sys->text_input);
+}
+
 bool kc85_quickload(kc85_t* sys, chips_range_t data, bool start) {
     CHIPS_ASSERT(sys && sys->valid && data.ptr);
     /* first check for KC-TAP format, since this can be properly identified */
@@ -1725,6 +2070,8 @@ chips_display_info_t kc85_display_info(kc85_t* sys) {
                 .height = KC85_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = KC85_FRAMEBUFFER_SIZE_BYTES
@@ -1745,14 +2092,41 @@ chips_display_info_t kc85_display_info(kc85_t* sys) {
     return res;
 }
 
+// ROM image ranges for snapshot pointer conversion
+static void _kc85_rom_ranges(const kc85_t* sys, mem_ext_range_t* roms) {
+    roms[0].ptr = sys->rom_basic_ptr;  roms[0].size = 0x2000;
+    roms[1].ptr = sys->rom_caos_c_ptr; roms[1].size = 0x1000;
+    roms[2].ptr = sys->rom_caos_e_ptr; roms[2].size = 0x2000;
+}
+
+chips_observation_t kc85_observe(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 2,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+            { .name = "exp_buf", .mem = { .ptr = sys->exp_buf, .size = sizeof(sys->exp_buf) } },
+        },
+        .display = kc85_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t kc85_save_snapshot(kc85_t* sys, kc85_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     dst->patch_callback.func = 0;
     dst->patch_callback.user_data = 0;
-    mem_snapshot_onsave(&dst->mem, sys);
+    chips_tape_snapshot_onsave(&dst->tape);
+    chips_text_input_snapshot_onsave(&dst->text_input);
+    mem_ext_range_t roms[3];
+    _kc85_rom_ranges(sys, roms);
+    mem_snapshot_onsave_ext(&dst->mem, sys, roms, 3);
+    dst->rom_basic_ptr = dst->rom_caos_c_ptr = dst->rom_caos_e_ptr = 0;
+    memset(dst->bank_rows, 0, sizeof(dst->bank_rows));
     return KC85_SNAPSHOT_VERSION;
 }
 
@@ -1766,11 +2140,53 @@ bool kc85_load_snapshot(kc85_t* sys, uint32_t version, const kc85_t* src) {
     static kc85_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     im.patch_callback = sys->patch_callback;
-    mem_snapshot_onload(&im.mem, sys);
+    chips_tape_snapshot_onload(&im.tape, &sys->tape);
+    chips_text_input_snapshot_onload(&im.text_input, &sys->text_input);
+    mem_ext_range_t roms[3];
+    _kc85_rom_ranges(sys, roms);
+    mem_snapshot_onload_ext(&im.mem, sys, roms, 3);
+    im.shared_roms = sys->shared_roms;
+    im.rom_basic_ptr = sys->rom_basic_ptr;
+    im.rom_caos_c_ptr = sys->rom_caos_c_ptr;
+    im.rom_caos_e_ptr = sys->rom_caos_e_ptr;
+    chips_dirty_lines_set_all(&im.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
     *sys = im;
+    _kc85_init_bank_rows(sys);
     return true;
 }
 
+uint64_t kc85_state_hash(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != &sys->ram[0][0]) {
+        mem_track_dirty(&sys->mem, &sys->ram[0][0], sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->video);
+    h = CHIPS_HASH(h, sys->pio_pins);
+    #if defined(CHIPS_KC85_TYPE_4)
+    h = CHIPS_HASH(h, sys->io84);
+    h = CHIPS_HASH(h, sys->io86);
+    #endif
+    h = CHIPS_HASH(h, sys->ctc);
+    h = CHIPS_HASH(h, sys->flip_flops);
+    h = CHIPS_HASH(h, sys->beeper_1);
+    h = CHIPS_HASH(h, sys->beeper_2);
+    h = CHIPS_HASH(h, sys->pio);
+    h = CHIPS_HASH(h, sys->exp);
+    h = CHIPS_HASH(h, sys->bank_state);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->tape.pos);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return chips_hash(h, sys->exp_buf, sys->exp.buf_top);
+}
+
 #endif /* CHIPS_IMPL */
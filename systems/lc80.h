@@ -50,6 +50,38 @@
 
     TODO: more details about the hardware and emulator
 
+    ## Display
+
+    The 6 LED digits are multiplexed: the CPU selects one digit at a time
+    through System PIO port B and outputs its segments on port A. The
+    vqe23[] pin state follows this scan directly, so it flickers between
+    digits and shows transient garbage while the CPU switches over.
+
+    In addition, the emulator accumulates how long each segment is lit
+    during an lc80_exec() call (only when the PIO outputs change, not on
+    every tick), and at the end of the call it latches every segment which
+    was lit for at least 1/LC80_DISPLAY_MIN_DUTY of the time. Call
+    lc80_display() to get the latched state: one byte per digit from left
+    to right, with the segments in the LC80_VQE23_A1..P1 bit layout
+    (active-high: a set bit is a lit segment), and a changed flag which is
+    only set when the visible digits differ from the previous lc80_exec()
+    call. A frontend only needs to redraw the display (and a headless test
+    rig can compare display states) when the flag is set.
+
+    ## State Hash
+
+    lc80_state_hash() returns a hash over the CPU, CTC, PIO, beeper and
+    keyboard state and the 1 KB RAM (e.g. to detect when two emulator
+    instances get out of sync).
+
+    ## Observation
+
+    lc80_observe() returns a pointer to the 1 KByte RAM ("ram") and the
+    z80_t CPU state (see chips_observation_t in chips_common.h), the LC80
+    has no framebuffer (use lc80_display() for the LED digits). The vblank
+    callback in lc80_desc_t is invoked at the end of each lc80_exec() call
+    after the display state has been latched.
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -77,7 +109,7 @@ extern "C" {
 #endif
 
 // bump this whenever the lc80_t struct layout changes
-#define LC80_SNAPSHOT_VERSION (0x0001)
+#define LC80_SNAPSHOT_VERSION (0x0002)
 
 // key codes (for lc80_key(), lc80_key_down(), lc80_key_up()
 #define LC80_KEY_0      ('0')
@@ -185,13 +217,23 @@ extern "C" {
 #define LC80_VQE23_K1    (1ULL<<16)
 #define LC80_VQE23_K2    (1ULL<<17)
 
+#define LC80_DISPLAY_NUM_DIGITS (6)
+#define LC80_DISPLAY_MIN_DUTY (32)  // segments lit for less than 1/32 of the time are filtered out (see 'Display')
+
 #define LC80_MAX_AUDIO_SAMPLES (1024)
 #define LC80_DEFAULT_AUDIO_SAMPLES (128)
 
+// latched LED display state (see 'Display')
+typedef struct {
+    uint8_t digits[LC80_DISPLAY_NUM_DIGITS];    // lit segments from left to right (LC80_VQE23_A1..P1 bits)
+    bool changed;                               // true if the digits changed in the last lc80_exec() call
+} lc80_display_t;
+
 // config parameters for lc80_init()
 typedef struct {
     chips_debug_t debug;
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
     chips_range_t rom;
 } lc80_desc_t;
 
@@ -206,12 +248,24 @@ typedef struct {
     uint32_t u214[2];           // pin state of the 2 U214D RAM chips
     uint32_t ds8205[2];         // pin state of the 2 DS8205 3-to-8 decoders (equiv LS138)
     uint8_t pio_b;              // last PIO port B state
+    struct {
+        uint8_t pio_a;          // last PIO port A state (segments, active-low)
+        uint8_t pio_b;          // last PIO port B state (digit select, active-low)
+        uint32_t tick;          // ticks in the current lc80_exec() call
+        uint32_t last_tick;     // tick of the last PIO output change
+        uint32_t on_ticks[LC80_DISPLAY_NUM_DIGITS][8];  // accumulated on-time per digit and PIO port A bit
+        lc80_display_t state;   // the latched display state
+    } display;
     beeper_t beeper;
     bool reset;
     bool nmi;
 
     bool valid;
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
+    chips_sched_t sched;        // skips CTC ticks while the CTC is idle
+    chips_iomap_t iomap;        // IO port to chip-enable select bits
     chips_debug_t debug;
 
     kbd_t kbd;
@@ -237,6 +291,9 @@ void lc80_key_up(lc80_t* sys, int key_code);
 void lc80_key(lc80_t* sys, int key_code);       // down + up
 uint32_t lc80_save_snapshot(lc80_t* sys, lc80_t* dst);  // capture snapshot, return snapshot layout version
 bool lc80_load_snapshot(lc80_t* sys, uint32_t version, lc80_t* src);    // load snapshot, return false if version didn't match
+uint64_t lc80_state_hash(lc80_t* sys);  // hash the emulation state (see 'State Hash')
+lc80_display_t lc80_display(const lc80_t* sys);     // get the latched LED display state (see 'Display')
+chips_observation_t lc80_observe(lc80_t* sys);      // get pointers to the RAM and CPU state (see 'Observation')
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -252,6 +309,25 @@ bool lc80_load_snapshot(lc80_t* sys, uint32_t version, lc80_t* src);    // load
 
 #define _LC80_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
+// event scheduler slots
+#define _LC80_SCHED_CTC (0)
+#define _LC80_NUM_SCHED_SLOTS (1)
+
+// IO port select bits in the IO port select table
+#define _LC80_IOSEL_CTC     (1<<0)
+#define _LC80_IOSEL_PIO_USR (1<<1)
+#define _LC80_IOSEL_PIO_SYS (1<<2)
+
+/* the CE pins of the CTC and PIOs are directly connected to the
+   inverted address bus pins A4 (CTC), A2 (user PIO) and A3 (system PIO)
+*/
+static void _lc80_init_iomap(lc80_t* sys) {
+    chips_iomap_clear(&sys->iomap);
+    chips_iomap_add(&sys->iomap, 0x10, 0x00, _LC80_IOSEL_CTC);
+    chips_iomap_add(&sys->iomap, 0x04, 0x00, _LC80_IOSEL_PIO_USR);
+    chips_iomap_add(&sys->iomap, 0x08, 0x00, _LC80_IOSEL_PIO_SYS);
+}
+
 void lc80_init(lc80_t* sys, const lc80_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
     if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
@@ -259,6 +335,8 @@ void lc80_init(lc80_t* sys, const lc80_desc_t* desc) {
     memset(sys, 0, sizeof(lc80_t));
     sys->valid = true;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    _lc80_init_iomap(sys);
 
     CHIPS_ASSERT(desc->rom.ptr && (desc->rom.size == sizeof(sys->rom)));
     memcpy(sys->rom, desc->rom.ptr, sizeof(sys->rom));
@@ -266,11 +344,14 @@ void lc80_init(lc80_t* sys, const lc80_desc_t* desc) {
     sys->freq_hz = 900000;
     z80_init(&sys->cpu);
     z80ctc_init(&sys->ctc);
+    chips_sched_init(&sys->sched, _LC80_NUM_SCHED_SLOTS);
     z80pio_init(&sys->pio_sys);
     z80pio_init(&sys->pio_usr);
     for (int i = 0; i < 3; i++) {
         sys->vqe23[i] = 0x0000FFFF;
     }
+    sys->display.pio_a = 0xFF;
+    sys->display.pio_b = 0xFF;
     sys->audio.callback = desc->audio.callback;
     sys->audio.num_samples = _LC80_DEFAULT(desc->audio.num_samples, LC80_DEFAULT_AUDIO_SAMPLES);
     beeper_init(&sys->beeper, &(beeper_desc_t){
@@ -325,6 +406,7 @@ void lc80_reset(lc80_t* sys) {
     sys->nmi = false;
     z80_reset(&sys->cpu);
     z80ctc_reset(&sys->ctc);
+    chips_sched_init(&sys->sched, _LC80_NUM_SCHED_SLOTS);
     z80pio_reset(&sys->pio_sys);
     z80pio_reset(&sys->pio_usr);
     beeper_reset(&sys->beeper);
@@ -379,8 +461,58 @@ static uint32_t _lc80_vqe23_write(uint32_t vqe23, int digit, uint8_t data) {
     return vqe23;
 }
 
+// add the on-time since the last PIO change to the currently lit segments
+static void _lc80_display_accumulate(lc80_t* sys) {
+    const uint32_t ticks = sys->display.tick - sys->display.last_tick;
+    sys->display.last_tick = sys->display.tick;
+    const uint8_t segs = ~sys->display.pio_a;
+    if ((0 == ticks) || (0 == segs)) {
+        return;
+    }
+    // digit select lines are bits 2..7 of port B, from the rightmost to the leftmost digit
+    for (int i = 0; i < LC80_DISPLAY_NUM_DIGITS; i++) {
+        if (0 == (sys->display.pio_b & (1<<(7-i)))) {
+            for (int bit = 0; bit < 8; bit++) {
+                if (segs & (1<<bit)) {
+                    sys->display.on_ticks[i][bit] += ticks;
+                }
+            }
+        }
+    }
+}
+
+// latch the segments which were lit long enough during the last lc80_exec() call
+static void _lc80_display_latch(lc80_t* sys) {
+    // PIO port A bit for each segment A..G,P (see _lc80_vqe23_write())
+    static const uint8_t seg_bits[8] = { 2, 0, 5, 7, 6, 1, 3, 4 };
+    _lc80_display_accumulate(sys);
+    const uint32_t num_ticks = sys->display.tick;
+    if (0 == num_ticks) {
+        sys->display.state.changed = false;
+        return;
+    }
+    bool changed = false;
+    for (int i = 0; i < LC80_DISPLAY_NUM_DIGITS; i++) {
+        uint8_t digit = 0;
+        for (int seg = 0; seg < 8; seg++) {
+            if ((uint64_t)sys->display.on_ticks[i][seg_bits[seg]] * LC80_DISPLAY_MIN_DUTY >= num_ticks) {
+                digit |= 1<<seg;
+            }
+        }
+        if (digit != sys->display.state.digits[i]) {
+            sys->display.state.digits[i] = digit;
+            changed = true;
+        }
+    }
+    sys->display.state.changed = changed;
+    memset(sys->display.on_ticks, 0, sizeof(sys->display.on_ticks));
+    sys->display.tick = 0;
+    sys->display.last_tick = 0;
+}
+
 // LC80 CPU tick callback
 uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
+    sys->tick++;
     pins = z80_tick(&sys->cpu, pins);
 
     /* Address decoding via the two DS8205 3-to-8 decoders (LS138 clones)
@@ -454,18 +586,27 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
         sys->u214[1] = (pins & (Z80_WR | 0x0003FF)) | ((pins & 0xF00000)>>4);
     }
 
-    // tick CTC first (because it's the highest priority daisychain device
+    // chip-enable decoding for the CTC and PIOs (the chips check IORQ themselves)
+    const uint8_t io_sel = chips_iomap_select(&sys->iomap, (uint8_t)Z80_GET_ADDR(pins));
+
+    // tick CTC first (because it's the highest priority daisychain device),
+    // the CTC is skipped while it's idle and not accessed by the CPU
     {
         pins |= Z80_IEIO;
-        if (0 == (pins & Z80_A4)) { pins |= Z80CTC_CE; };
-        if (pins & Z80_A0) { pins |= Z80CTC_CS0; }
-        if (pins & Z80_A1) { pins |= Z80CTC_CS1; }
-        pins = z80ctc_tick(&sys->ctc, pins) & Z80_PIN_MASK;
+        const bool ctc_iorq = ((pins & (Z80_IORQ|Z80_M1)) == Z80_IORQ) && (io_sel & _LC80_IOSEL_CTC);
+        if (ctc_iorq || chips_sched_due(&sys->sched, _LC80_SCHED_CTC)) {
+            z80ctc_advance(&sys->ctc, chips_sched_sync(&sys->sched, _LC80_SCHED_CTC));
+            if (io_sel & _LC80_IOSEL_CTC) { pins |= Z80CTC_CE; };
+            if (pins & Z80_A0) { pins |= Z80CTC_CS0; }
+            if (pins & Z80_A1) { pins |= Z80CTC_CS1; }
+            pins = z80ctc_tick(&sys->ctc, pins) & Z80_PIN_MASK;
+            chips_sched_set(&sys->sched, _LC80_SCHED_CTC, z80ctc_idle_ticks(&sys->ctc));
+        }
     }
 
     // tick user PIO (next in daisychain priority)
     {
-        if (0 == (pins & Z80_A2)) { pins |= Z80PIO_CE; }
+        if (io_sel & _LC80_IOSEL_PIO_USR) { pins |= Z80PIO_CE; }
         if (pins & Z80_A0) { pins |= Z80PIO_BASEL; }
         if (pins & Z80_A1) { pins |= Z80PIO_CDSEL; }
         // bits 4..7 of port B are keyboard matrix lines
@@ -477,7 +618,7 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
 
     // tick system PIO (lowest daisychain priority)
     {
-        if (0 == (pins & Z80_A3)) { pins |= Z80PIO_CE; }
+        if (io_sel & _LC80_IOSEL_PIO_SYS) { pins |= Z80PIO_CE; }
         if (pins & Z80_A0) { pins |= Z80PIO_BASEL; }
         if (pins & Z80_A1) { pins |= Z80PIO_CDSEL; }
         Z80PIO_SET_PAB(pins, 0xFF, 0xFF);
@@ -540,6 +681,14 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
             }
         }
 
+        // accumulate the segment on-time for the latched display state
+        sys->display.tick++;
+        if ((pio_a != sys->display.pio_a) || (pio_b != sys->display.pio_b)) {
+            _lc80_display_accumulate(sys);
+            sys->display.pio_a = pio_a;
+            sys->display.pio_b = pio_b;
+        }
+
         /* bits 2..7 of port B also double as input to the keyboard matrix */
         uint8_t kbd_columns = ~(pio_b >> 2) & 0x3F;
         kbd_set_active_columns(&sys->kbd, kbd_columns);
@@ -550,13 +699,7 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
     // tick beeper
     if (beeper_tick(&sys->beeper)) {
         /* new audio sample ready */
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
-        }
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->beeper.sample, sys->tick);
     }
     if (sys->nmi) {
         pins |= Z80_NMI;
@@ -564,6 +707,7 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
     else {
         pins &= ~Z80_NMI;
     }
+    chips_sched_tick(&sys->sched);
     return pins;
 }
 
@@ -578,13 +722,22 @@ uint32_t lc80_exec(lc80_t* sys, uint32_t micro_seconds) {
         }
     }
     else {
-        // run with debugger hook
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
             pins = _lc80_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    // bring the CTC up to date for debugging UIs and snapshots
+    z80ctc_advance(&sys->ctc, chips_sched_sync(&sys->sched, _LC80_SCHED_CTC));
+    _lc80_display_latch(sys);
+    chips_vblank_notify(&sys->vblank);
     if (sys->nmi) {
         sys->nmi = false;
     }
@@ -623,10 +776,22 @@ void lc80_key(lc80_t* sys, int key_code) {
     lc80_key_up(sys, key_code);
 }
 
+chips_observation_t lc80_observe(lc80_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t lc80_save_snapshot(lc80_t* sys, lc80_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     return LC80_SNAPSHOT_VERSION;
 }
@@ -639,9 +804,38 @@ bool lc80_load_snapshot(lc80_t* sys, uint32_t version, lc80_t* src) {
     static lc80_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     *sys = im;
     return true;
 }
 
+lc80_display_t lc80_display(const lc80_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->display.state;
+}
+
+uint64_t lc80_state_hash(lc80_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->ctc);
+    h = CHIPS_HASH(h, sys->pio_sys);
+    h = CHIPS_HASH(h, sys->pio_usr);
+    h = CHIPS_HASH(h, sys->vqe23);
+    h = CHIPS_HASH(h, sys->u505);
+    h = CHIPS_HASH(h, sys->u214);
+    h = CHIPS_HASH(h, sys->ds8205);
+    h = CHIPS_HASH(h, sys->pio_b);
+    h = CHIPS_HASH(h, sys->display.state.digits);
+    h = CHIPS_HASH(h, sys->beeper);
+    h = CHIPS_HASH(h, sys->reset);
+    h = CHIPS_HASH(h, sys->nmi);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->sched);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->ram);
+    return h;
+}
+
 #endif /* CHIPS_IMPL */
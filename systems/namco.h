@@ -40,6 +40,30 @@
     https://github.com/floooh/chips-test/blob/master/examples/sokol/pacman.c
     https://github.com/floooh/chips-test/blob/master/examples/sokol/pengo.c
 
+    ## Sound
+
+    The waveform sound generator runs at 96 kHz, but the voice registers
+    only change on CPU writes. Instead of stepping the voices on every CPU
+    tick, the elapsed ticks are counted and the voices are rendered as a
+    block whenever an output sample is due, or right before a write to a
+    sound register or the sound-enable latch. The 4-bit wave ROM is
+    pre-decoded into signed sample values at init time. The output is
+    identical to stepping the voices on every tick.
+
+    ## State Hash
+
+    namco_state_hash() hashes the CPU, IO registers, sound voices and the
+    video, color and main RAM. The RAM areas are small enough to be hashed
+    completely on each call.
+
+    ## Observation
+
+    namco_observe() returns pointers to the main RAM ("main_ram"), video
+    RAM ("video_ram"), color RAM ("color_ram") and sprite coordinates
+    ("sprite_coords"), the display info and the z80_t CPU state (see
+    chips_observation_t in chips_common.h). The vblank callback in
+    namco_desc_t is invoked together with the VSYNC interrupt request.
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -68,7 +92,7 @@ extern "C" {
 #endif
 
 // increase when namco_t memory layout changes
-#define NAMCO_SNAPSHOT_VERSION (1)
+#define NAMCO_SNAPSHOT_VERSION (2)
 
 #define NAMCO_MAX_AUDIO_SAMPLES (1024)
 #define NAMCO_DEFAULT_AUDIO_SAMPLES (128)
@@ -97,7 +121,9 @@ extern "C" {
 // configuration parameters for namco_init()
 typedef struct {
     chips_debug_t debug;
+    chips_headless_t headless;  // optional headless video mode (see chips_common.h)
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
     struct {
         // common ROM areas for Pacman and Pengo
         struct {
@@ -143,6 +169,9 @@ typedef struct {
         float sample_div  ; // oversampling divider
     } voice[3];
     uint8_t rom[2][0x0100]; // wave table ROM
+    int8_t wave[8][32];     // signed 4-bit samples decoded from rom[0]
+    uint32_t lazy_ticks;    // CPU ticks not yet rendered into the voices
+    uint32_t lazy_sample_ticks; // CPU ticks until the next output sample
     int num_samples;
     int sample_pos;
     chips_audio_callback_t callback;
@@ -158,6 +187,7 @@ typedef struct {
     uint8_t dsw1;   // dip-switches as-is (active-high)
     uint8_t dsw2;   // Pengo only
     uint64_t pins;
+    uint64_t tick;          // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     int vsync_count;
     uint8_t int_vector;     // IM2 interrupt vector set with OUT on port 0
     uint8_t int_enable;
@@ -170,6 +200,8 @@ typedef struct {
 
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
 
     namco_sound_t sound;
     uint8_t video_ram[0x0400];
@@ -180,6 +212,11 @@ typedef struct {
     uint8_t rom_prom[0x0420];       // palette and color lookup ROM
     uint32_t hw_colors[32];         // decoded color palette from palette ROM
     uint8_t palette_cache[512];     // palette indirection table, Pacman: 256 entries , Pengo: 512 entries
+    bool gfx_cache_valid;           // clear after modifying rom_gfx to rebuild the tile and sprite caches
+    uint8_t gfx_tiles[2][256][64];  // pre-decoded 8x8 tiles (2-bit pixels) per tile bank
+    uint8_t gfx_sprites[2][2][64][256]; // pre-decoded 16x16 sprites (2-bit pixels) per tile bank, unflipped and x-flipped
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
+    uint64_t row_hashes[NAMCO_FRAMEBUFFER_HEIGHT];  // framebuffer row hashes of the previous frame
     alignas(64) uint8_t fb[NAMCO_FRAMEBUFFER_SIZE_BYTES];   // indices into palette
 } namco_t;
 
@@ -191,6 +228,8 @@ void namco_discard(namco_t* sys);
 void namco_reset(namco_t* sys);
 // query display, framebuffer and color palette (note: palette requires a valid sys ptr!)
 chips_display_info_t namco_display_info(namco_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t namco_observe(namco_t* sys);
 // run namco_t instance for given amount of microseconds, return number of ticks executed
 uint32_t namco_exec(namco_t* sys, uint32_t micro_seconds);
 // set input bits
@@ -201,6 +240,8 @@ void namco_input_clear(namco_t* sys, uint32_t mask);
 uint32_t namco_save_snapshot(namco_t* sys, namco_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool namco_load_snapshot(namco_t* sys, uint32_t version, namco_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t namco_state_hash(namco_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -384,6 +425,8 @@ bool namco_load_snapshot(namco_t* sys, uint32_t version, namco_t* src);
 static void _namco_sound_init(namco_t* sys, const namco_desc_t* desc);
 static void _namco_sound_wr(namco_t* sys, uint16_t addr, uint8_t data);
 static void _namco_sound_tick(namco_t* sys);
+static void _namco_sound_sync(namco_t* sys);
+static void _namco_decode_gfx(namco_t* sys);
 
 #define _namco_def(val, def) (val == 0 ? def : val)
 
@@ -394,6 +437,9 @@ void namco_init(namco_t* sys, const namco_desc_t* desc) {
     memset(sys, 0, sizeof(namco_t));
     sys->valid = true;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
     sys->vsync_count = NAMCO_VSYNC_PERIOD;
     _namco_sound_init(sys, desc);
     sys->pins = z80_init(&sys->cpu);
@@ -413,6 +459,9 @@ void namco_init(namco_t* sys, const namco_desc_t* desc) {
     memcpy(&sys->rom_prom[0], desc->roms.common.prom_0000_001F.ptr, 0x0020);
     memcpy(sys->sound.rom[0], desc->roms.common.sound_0000_00FF.ptr, 0x0100);
     memcpy(sys->sound.rom[1], desc->roms.common.sound_0100_01FF.ptr, 0x0100);
+    for (int i = 0; i < 0x0100; i++) {
+        sys->sound.wave[i >> 5][i & 0x1F] = (int8_t)((sys->sound.rom[0][i] & 0xF) - 8);
+    }
     #if defined(NAMCO_PENGO)
     CHIPS_ASSERT(desc->roms.pengo.cpu_4000_4FFF.ptr && (desc->roms.pengo.cpu_4000_4FFF.size == 0x1000));
     CHIPS_ASSERT(desc->roms.pengo.cpu_5000_5FFF.ptr && (desc->roms.pengo.cpu_5000_5FFF.size == 0x1000));
@@ -521,6 +570,9 @@ void namco_init(namco_t* sys, const namco_desc_t* desc) {
         sys->palette_cache[i] = pal_index;
         sys->palette_cache[256 + i] = 0x10 | pal_index;
     }
+
+    // the tile ROM never changes, so expand tiles and sprites only once
+    _namco_decode_gfx(sys);
 }
 
 void namco_discard(namco_t* sys) {
@@ -534,10 +586,12 @@ void namco_reset(namco_t* sys) {
 }
 
 static uint64_t _namco_tick(namco_t* sys, uint64_t pins) {
+    sys->tick++;
     // update the vsync counter and trigger VSYNC interrupt
     sys->vsync_count--;
     if (sys->vsync_count < 0) {
         sys->vsync_count += NAMCO_VSYNC_PERIOD;
+        chips_vblank_notify(&sys->vblank);
         if (sys->int_enable) {
             pins |= Z80_INT;
         }
@@ -564,6 +618,7 @@ static uint64_t _namco_tick(namco_t* sys, uint64_t pins) {
                     sys->int_enable = data & 1;
                 }
                 else if (addr == NAMCO_ADDR_SOUND_ENABLE) {
+                    _namco_sound_sync(sys);
                     sys->sound_enable = data & 1;
                 }
                 else if (addr == NAMCO_ADDR_FLIP_SCREEN) {
@@ -653,64 +708,62 @@ static uint16_t _namco_video_offset(uint32_t x, uint32_t y) {
     return offset;
 }
 
-// 8x4 video tile decoder (used both for background tiles and sprites)
-static inline void _namco_8x4(
-    uint8_t* fb,
-    uint8_t* tile_base,
-    uint8_t* pal_base,
-    uint8_t* pal_rom,
-    uint32_t tile_stride,
-    uint32_t tile_offset,
-    uint32_t px,
-    uint32_t py,
-    uint8_t char_code,
-    uint8_t color_code,
-    bool opaque,
-    bool flip_x,
-    bool flip_y)
-{
-    uint32_t xor_x = flip_x ? 3 : 0;
-    uint32_t xor_y = flip_y ? 7 : 0;
-    for (uint32_t yy = 0; yy < 8; yy++) {
-        uint32_t y = py + (yy ^ xor_y);
-        if (y >= NAMCO_DISPLAY_HEIGHT) {
-            continue;
-        }
-        int tile_index = char_code * tile_stride + tile_offset + yy;
-        for (uint32_t xx = 0; xx < 4; xx++) {
-            uint32_t x = px + (xx ^ xor_x);
-            if (x >= NAMCO_DISPLAY_WIDTH) {
-                continue;
+// expand the tile ROM bit-planes into 1 byte per pixel (values 0..3),
+// sprites are additionally stored x-flipped, y-flipping only reverses
+// the row order when drawing
+static void _namco_decode_gfx(namco_t* sys) {
+    for (uint32_t bank = 0; bank < 2; bank++) {
+        const uint8_t* tile_rom = &sys->rom_gfx[bank * 0x2000];
+        for (uint32_t code = 0; code < 256; code++) {
+            uint8_t* dst = sys->gfx_tiles[bank][code];
+            for (uint32_t y = 0; y < 8; y++) {
+                for (uint32_t x = 0; x < 8; x++) {
+                    // left half of a tile is in the second 8 bytes
+                    uint8_t b = tile_rom[code*16 + ((x < 4) ? 8 : 0) + y];
+                    uint32_t xx = x & 3;
+                    dst[y*8 + x] = (((b>>(7-xx))&1)<<1) | ((b>>(3-xx))&1);
+                }
             }
-            uint8_t p2_hi = (tile_base[tile_index]>>(7-xx)) & 1;
-            uint8_t p2_lo = (tile_base[tile_index]>>(3-xx)) & 1;
-            uint8_t p2 = (p2_hi<<1)|p2_lo;
-            uint8_t hw_color = pal_base[(color_code<<2)|p2];
-            if (opaque || (pal_rom[hw_color] != 0)) {
-                fb[y * NAMCO_FRAMEBUFFER_WIDTH + x] = hw_color;
+        }
+        const uint8_t* sprite_rom = &sys->rom_gfx[bank * 0x2000 + 0x1000];
+        static const uint8_t strip_offset[2][4] = { { 8, 16, 24, 0 }, { 40, 48, 56, 32 } };
+        for (uint32_t code = 0; code < 64; code++) {
+            uint8_t* dst = sys->gfx_sprites[bank][0][code];
+            uint8_t* dst_flip_x = sys->gfx_sprites[bank][1][code];
+            for (uint32_t y = 0; y < 16; y++) {
+                for (uint32_t x = 0; x < 16; x++) {
+                    uint8_t b = sprite_rom[code*64 + strip_offset[y>>3][x>>2] + (y & 7)];
+                    uint32_t xx = x & 3;
+                    uint8_t p = (((b>>(7-xx))&1)<<1) | ((b>>(3-xx))&1);
+                    dst[y*16 + x] = p;
+                    dst_flip_x[y*16 + (15 - x)] = p;
+                }
             }
         }
     }
+    sys->gfx_cache_valid = true;
 }
 
 // decode background tiles
 static void _namco_decode_chars(namco_t* sys) {
-    uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
-    uint8_t* tile_base = &sys->rom_gfx[0x0000] + (sys->tile_select * 0x2000);
+    const uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
     for (uint32_t y = 0; y < 28; y++) {
         for (uint32_t x = 0; x < 36; x++) {
             uint16_t offset = _namco_video_offset(x, y);
-            uint8_t char_code = sys->video_ram[offset];
-            uint8_t color_code = sys->color_ram[offset] & 0x1F;
-            _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 16, 8, x*8, y*8, char_code, color_code, true, false, false);
-            _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 16, 0, x*8+4, y*8, char_code, color_code, true, false, false);
+            const uint8_t* src = sys->gfx_tiles[sys->tile_select][sys->video_ram[offset]];
+            const uint8_t* colors = &pal_base[(sys->color_ram[offset] & 0x1F)<<2];
+            uint8_t* dst = &sys->fb[(y*8) * NAMCO_FRAMEBUFFER_WIDTH + x*8];
+            for (uint32_t yy = 0; yy < 8; yy++, src += 8, dst += NAMCO_FRAMEBUFFER_WIDTH) {
+                for (uint32_t xx = 0; xx < 8; xx++) {
+                    dst[xx] = colors[src[xx]];
+                }
+            }
         }
     }
 }
 
 static void _namco_decode_sprites(namco_t* sys) {
-    uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
-    uint8_t* tile_base = &sys->rom_gfx[0x1000] + (sys->tile_select * 0x2000);
+    const uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
     #if defined(NAMCO_PACMAN)
     const int max_sprite = 6;
     const int min_sprite = 1;
@@ -722,35 +775,49 @@ static void _namco_decode_sprites(namco_t* sys) {
         uint32_t py = sys->sprite_coords[sprite_index*2 + 0] - 31;
         uint32_t px = 272 - sys->sprite_coords[sprite_index*2 + 1];
         uint8_t shape = sys->main_ram[NAMCO_ADDR_SPRITES_ATTR + sprite_index*2 + 0];
-        uint8_t char_code = shape>>2;
         uint8_t color_code = sys->main_ram[NAMCO_ADDR_SPRITES_ATTR + sprite_index*2 + 1];
         bool flip_x = shape & 1;
         bool flip_y = shape & 2;
-        uint32_t fy0 = flip_y ? 8 : 0;
-        uint32_t fy1 = flip_y ? 0 : 8;
-        uint32_t fx0 = flip_x ? 12: 0;
-        uint32_t fx1 = flip_x ? 8 : 4;
-        uint32_t fx2 = flip_x ? 4 : 8;
-        uint32_t fx3 = flip_x ? 0 :12;
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 8,  px+fx0, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 16, px+fx1, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 24, px+fx2, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 0,  px+fx3, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 40, px+fx0, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 48, px+fx1, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 56, px+fx2, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 32, px+fx3, py+fy1, char_code, color_code, false, flip_x, flip_y);
+        const uint8_t* src = sys->gfx_sprites[sys->tile_select][flip_x ? 1 : 0][shape>>2];
+        // a pixel is transparent if its hardware color is black
+        uint8_t colors[4];
+        bool opaque[4];
+        for (uint32_t i = 0; i < 4; i++) {
+            colors[i] = pal_base[((color_code<<2)|i) & 0x7F];
+            opaque[i] = sys->rom_prom[colors[i]] != 0;
+        }
+        for (uint32_t yy = 0; yy < 16; yy++) {
+            uint32_t y = py + (flip_y ? (15 - yy) : yy);
+            if (y >= NAMCO_DISPLAY_HEIGHT) {
+                continue;
+            }
+            const uint8_t* row = &src[yy * 16];
+            uint8_t* dst = &sys->fb[y * NAMCO_FRAMEBUFFER_WIDTH];
+            for (uint32_t xx = 0; xx < 16; xx++) {
+                uint32_t x = px + xx;
+                uint8_t p = row[xx];
+                if ((x < NAMCO_DISPLAY_WIDTH) && opaque[p]) {
+                    dst[x] = colors[p];
+                }
+            }
+        }
     }
 }
 
 void _namco_decode_video(namco_t* sys) {
     CHIPS_ASSERT(sys && sys->valid);
+    if (!sys->gfx_cache_valid) {
+        _namco_decode_gfx(sys);
+    }
     _namco_decode_chars(sys);
     _namco_decode_sprites(sys);
+    // the whole frame is redrawn, compare row hashes to find the changed rows
+    chips_dirty_lines_update_hashed(&sys->dirty_lines, sys->row_hashes, sys->fb, NAMCO_FRAMEBUFFER_WIDTH, NAMCO_FRAMEBUFFER_HEIGHT);
 }
 
 uint32_t namco_exec(namco_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
+    chips_headless_update(&sys->headless);
     const uint32_t num_ticks = clk_us_to_ticks(NAMCO_CPU_CLOCK, micro_seconds);
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
@@ -760,14 +827,21 @@ uint32_t namco_exec(namco_t* sys, uint32_t micro_seconds) {
         }
     }
     else {
-        // run with debug hook
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
             pins = _namco_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
-    _namco_decode_video(sys);
+    if (!sys->headless.skip) {
+        _namco_decode_video(sys);
+    }
     return num_ticks;
 }
 
@@ -878,6 +952,7 @@ static void _namco_sound_init(namco_t* sys, const namco_desc_t* desc) {
     snd->tick_counter = NAMCO_SOUND_PERIOD;
     snd->sample_period = (NAMCO_CPU_CLOCK * NAMCO_SAMPLE_SCALE) / _namco_def(desc->audio.sample_rate, 44100);
     snd->sample_counter = sys->sound.sample_period;
+    snd->lazy_sample_ticks = (uint32_t)(snd->sample_counter / NAMCO_SAMPLE_SCALE) + 1;
     snd->volume = _namco_def(desc->audio.volume, 1.0f);
     snd->num_samples = _namco_def(desc->audio.num_samples, NAMCO_DEFAULT_AUDIO_SAMPLES);
     snd->callback = desc->audio.callback;
@@ -890,6 +965,7 @@ static void _namco_sound_init(namco_t* sys, const namco_desc_t* desc) {
 #define _NAMCO_SET_NIBBLE_4(val, data) (val=(val&~0xF0000)|((data&0xF)<<16))
 
 static void _namco_sound_wr(namco_t* sys, uint16_t addr, uint8_t data) {
+    _namco_sound_sync(sys);
     namco_sound_t* snd = &sys->sound;
     switch (addr) {
         case NAMCO_ADDR_SOUND_V1_FC0:       _NAMCO_SET_NIBBLE_0(snd->voice[0].counter, data); break;
@@ -927,49 +1003,67 @@ static void _namco_sound_wr(namco_t* sys, uint16_t addr, uint8_t data) {
     }
 }
 
-static void _namco_sound_tick(namco_t* sys) {
+// render the CPU ticks since the last sync into the voices
+static void _namco_sound_sync(namco_t* sys) {
     namco_sound_t* snd = &sys->sound;
-    // tick the sound chip?
-    snd->tick_counter--;
-    if (snd->tick_counter < 0) {
-        // handle 96KHz tick
-        snd->tick_counter += NAMCO_SOUND_PERIOD / NAMCO_SOUND_OVERSAMPLE;
-        for (int i = 0; i < 3; i++) {
-            if ((snd->voice[i].frequency > 0) && (sys->sound_enable & 1)) {
-                snd->voice[i].counter += (snd->voice[i].frequency / NAMCO_SOUND_OVERSAMPLE);
-                /* lookup current 4-bit sample from waveform number and the topmost 5
-                   bits of the 20-bit sample counter, multiple with 4-bit volume
-                */
-                uint32_t smp_index = ((snd->voice[i].waveform<<5) | ((snd->voice[i].counter>>15) & 0x1F)) & 0xFF;
-                // integer sample value now 7-bits plus sign bit
-                int val = (((int)(snd->rom[0][smp_index] & 0xF)) - 8) * snd->voice[i].volume;
-                snd->voice[i].sample += (float)val;
+    const int num_ticks = (int)snd->lazy_ticks;
+    if (num_ticks == 0) {
+        return;
+    }
+    snd->lazy_ticks = 0;
+    snd->sample_counter -= num_ticks * NAMCO_SAMPLE_SCALE;
+    if (snd->sample_counter >= 0) {
+        snd->lazy_sample_ticks = (uint32_t)(snd->sample_counter / NAMCO_SAMPLE_SCALE) + 1;
+    }
+    // number of 96KHz ticks in the block
+    const int step_period = NAMCO_SOUND_PERIOD / NAMCO_SOUND_OVERSAMPLE;
+    snd->tick_counter -= num_ticks;
+    if (snd->tick_counter >= 0) {
+        return;
+    }
+    const int num_steps = (step_period - 1 - snd->tick_counter) / step_period;
+    snd->tick_counter += num_steps * step_period;
+    for (int i = 0; i < 3; i++) {
+        if ((snd->voice[i].frequency > 0) && (sys->sound_enable & 1)) {
+            /* lookup the 4-bit samples from the waveform number and the topmost 5
+               bits of the 20-bit sample counter, the sum is multiplied with the
+               4-bit volume (exact integer math, so block size doesn't matter)
+            */
+            const int8_t* wave = snd->wave[snd->voice[i].waveform & 7];
+            const uint32_t step = snd->voice[i].frequency / NAMCO_SOUND_OVERSAMPLE;
+            uint32_t counter = snd->voice[i].counter;
+            int sum = 0;
+            for (int s = 0; s < num_steps; s++) {
+                counter += step;
+                sum += wave[(counter >> 15) & 0x1F];
             }
-            snd->voice[i].sample_div += 128.0f;
+            snd->voice[i].counter = counter;
+            snd->voice[i].sample += (float)(sum * snd->voice[i].volume);
         }
+        snd->voice[i].sample_div += 128.0f * (float)num_steps;
     }
+}
 
+static void _namco_sound_tick(namco_t* sys) {
+    namco_sound_t* snd = &sys->sound;
     // generate a new sample?
-    snd->sample_counter -= NAMCO_SAMPLE_SCALE;
-    if (snd->sample_counter < 0) {
-        snd->sample_counter += snd->sample_period;
-        float sm = 0.0f;
-        for (int i = 0; i < 3; i++) {
-            if (snd->voice[i].sample_div > 0.0f) {
-                sm += snd->voice[i].sample / snd->voice[i].sample_div;
-                snd->voice[i].sample = 0.0f;
-                snd->voice[i].sample_div = 0.0f;
-            }
-        }
-        sm *= snd->volume * 0.33333f;
-        snd->sample_buffer[snd->sample_pos++] = sm;
-        if (snd->sample_pos == snd->num_samples) {
-            if (snd->callback.func) {
-                snd->callback.func(snd->sample_buffer, snd->num_samples, snd->callback.user_data);
-            }
-            snd->sample_pos = 0;
+    if (++snd->lazy_ticks < snd->lazy_sample_ticks) {
+        return;
+    }
+    _namco_sound_sync(sys);
+    CHIPS_ASSERT(snd->sample_counter < 0);
+    snd->sample_counter += snd->sample_period;
+    snd->lazy_sample_ticks = (uint32_t)(snd->sample_counter / NAMCO_SAMPLE_SCALE) + 1;
+    float sm = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        if (snd->voice[i].sample_div > 0.0f) {
+            sm += snd->voice[i].sample / snd->voice[i].sample_div;
+            snd->voice[i].sample = 0.0f;
+            snd->voice[i].sample_div = 0.0f;
         }
     }
+    sm *= snd->volume * 0.33333f;
+    chips_audio_put(&snd->callback, snd->sample_buffer, snd->num_samples, &snd->sample_pos, sm, sys->tick);
 }
 
 chips_display_info_t namco_display_info(namco_t* sys) {
@@ -980,6 +1074,8 @@ chips_display_info_t namco_display_info(namco_t* sys) {
                 .height = NAMCO_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = NAMCO_FRAMEBUFFER_SIZE_BYTES,
@@ -1002,10 +1098,26 @@ chips_display_info_t namco_display_info(namco_t* sys) {
     return res;
 }
 
+chips_observation_t namco_observe(namco_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 4,
+        .ram = {
+            { .name = "main_ram", .mem = { .ptr = sys->main_ram, .size = sizeof(sys->main_ram) } },
+            { .name = "video_ram", .mem = { .ptr = sys->video_ram, .size = sizeof(sys->video_ram) } },
+            { .name = "color_ram", .mem = { .ptr = sys->color_ram, .size = sizeof(sys->color_ram) } },
+            { .name = "sprite_coords", .mem = { .ptr = sys->sprite_coords, .size = sizeof(sys->sprite_coords) } },
+        },
+        .display = namco_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t namco_save_snapshot(namco_t* sys, namco_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->sound.callback);
     mem_snapshot_onsave(&dst->mem, sys);
     return NAMCO_SNAPSHOT_VERSION;
@@ -1019,10 +1131,41 @@ bool namco_load_snapshot(namco_t* sys, uint32_t version, namco_t* src) {
     static namco_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
     chips_audio_callback_snapshot_onload(&im.sound.callback, &sys->sound.callback);
     mem_snapshot_onload(&im.mem, sys);
+    chips_dirty_lines_set_all(&im.dirty_lines);
     *sys = im;
     return true;
 }
 
+uint64_t namco_state_hash(namco_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    _namco_sound_sync(sys);
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->in0);
+    h = CHIPS_HASH(h, sys->in1);
+    h = CHIPS_HASH(h, sys->dsw1);
+    h = CHIPS_HASH(h, sys->dsw2);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->vsync_count);
+    h = CHIPS_HASH(h, sys->int_vector);
+    h = CHIPS_HASH(h, sys->int_enable);
+    h = CHIPS_HASH(h, sys->sound_enable);
+    h = CHIPS_HASH(h, sys->flip_screen);
+    h = CHIPS_HASH(h, sys->pal_select);
+    h = CHIPS_HASH(h, sys->clut_select);
+    h = CHIPS_HASH(h, sys->tile_select);
+    h = CHIPS_HASH(h, sys->sprite_coords);
+    h = CHIPS_HASH(h, sys->sound.tick_counter);
+    h = CHIPS_HASH(h, sys->sound.sample_counter);
+    h = CHIPS_HASH(h, sys->sound.voice);
+    h = CHIPS_HASH(h, sys->video_ram);
+    h = CHIPS_HASH(h, sys->color_ram);
+    h = CHIPS_HASH(h, sys->main_ram);
+    return h;
+}
+
 #endif // CHIPS_IMPL
@@ -29,6 +29,42 @@
     - chips/clk.h
     - systems/c1530.h
 
+    ## Tape Turbo
+
+    Set vic20_desc_t.c1530_turbo to true to speed up tape loading: while
+    the datasette motor is running (and the tape isn't at its end),
+    vic20_exec() keeps running past the requested time slice (up to
+    VIC20_TAPE_TURBO_FACTOR times as many ticks) with the video decoding
+    switched off (as in headless mode) and without audio output.
+    vic20_exec() returns the number of ticks actually executed.
+    vic20_exec_frame() runs up to VIC20_TAPE_TURBO_FACTOR video frames in
+    tape turbo mode.
+
+    ## State Hash
+
+    vic20_state_hash() hashes the CPU, VIA, VIC and keyboard state, the
+    datasette state (if enabled) and all RAM areas (color RAM, the
+    builtin RAM and the expansion RAM blocks). The RAM is scattered over
+    several small arrays, so it is simply hashed completely on each call.
+
+    ## Observation
+
+    vic20_observe() returns pointers to the color RAM ("color_ram"), the
+    builtin RAM ("ram0" at 0x0000, "ram1" at 0x1000), the optional 3K
+    expansion RAM ("ram_3k" at 0x0400) and the optional 8K expansion RAM
+    blocks ("ram_exp"), the display info and the m6502_t CPU state (see
+    chips_observation_t in chips_common.h). The vblank callback in
+    vic20_desc_t is invoked when the VIC-I's raster counter wraps around.
+
+    ## Raw Video Log
+
+    If vic20_desc_t.vidlog points to a chips_vidlog_t (see chips_common.h),
+    the VIC-I records its register writes at the raster position. Each
+    published frame comes with a copy of the 16 KByte VIC address space
+    (character ROM, and the RAM blocks of the current memory configuration)
+    followed by the 1 KByte color RAM (the vram buffer must be at least
+    17 KBytes big).
+
     ## The Commodore VIC-20
 
 
@@ -65,10 +101,11 @@ extern "C" {
 #endif
 
 // bump snapshot version when vic20_t memory layout changes
-#define VIC20_SNAPSHOT_VERSION (1)
+#define VIC20_SNAPSHOT_VERSION (2)
 
 #define VIC20_FREQUENCY (1108404)
 #define VIC20_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
+#define VIC20_TAPE_TURBO_FACTOR (64)          // max speedup of vic20_exec() in tape turbo mode
 #define VIC20_DEFAULT_AUDIO_SAMPLES (128)     // default number of samples in internal sample buffer
 
 // VIC-20 joystick types (only one joystick supported)
@@ -110,10 +147,15 @@ typedef enum {
 // config parameters for vic20_init()
 typedef struct {
     bool c1530_enabled;             // set to true to enable C1530 datassette emulation
+    bool c1530_turbo;               // true to run uncapped while the tape motor is on (see 'Tape Turbo')
     vic20_joystick_type_t joystick_type;    // default is VIC20_JOYSTICK_NONE
     vic20_memory_config_t mem_config;       // default is VIC20_MEMCONFIG_STANDARD
     chips_debug_t debug;            // optional debugging hook
+    chips_headless_t headless;      // optional headless video mode (see chips_common.h)
+    chips_triple_buffer_t* triple_buffer;   // optional framebuffer hand-off to a render thread (see chips_common.h)
+    chips_vidlog_t* vidlog;         // optional raw video log (see 'Raw Video Log')
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
     struct {
         chips_range_t chars;    // 4 KByte character ROM dump
         chips_range_t basic;    // 8 KByte BASIC dump
@@ -128,9 +170,14 @@ typedef struct {
     m6522_t via_2;
     m6561_t vic;
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
+    chips_sched_t sched;        // skips VIA ticks while the VIAs are idle
+    uint64_t frame_us_rem;      // fractional remainder of the ticks-to-us conversion in vic20_exec_frame()
 
     vic20_joystick_type_t joystick_type;
     vic20_memory_config_t mem_config;
+    bool tape_turbo;            // tape turbo mode enabled
+    bool tape_turbo_active;     // true while vic20_exec() runs in tape turbo mode
     uint8_t cas_port;           // cassette port, shared with c1530_t if datasette is connected
     uint8_t iec_port;           // IEC serial port, shared with c1541_t if connected
     uint8_t kbd_joy_mask;       // current joystick state from keyboard-joystick emulation
@@ -143,6 +190,8 @@ typedef struct {
     mem_t mem_vic;              // VIC-visible memory mapping
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
 
     struct {
         chips_audio_callback_t callback;
@@ -174,8 +223,12 @@ void vic20_discard(vic20_t* sys);
 void vic20_reset(vic20_t* sys);
 // query display information
 chips_display_info_t vic20_display_info(vic20_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t vic20_observe(vic20_t* sys);
 // tick VIC-20 instance for a given number of microseconds, return number of executed ticks
 uint32_t vic20_exec(vic20_t* sys, uint32_t micro_seconds);
+// run VIC-20 emulation until the end of the current video frame, returns number of ticks
+uint32_t vic20_exec_frame(vic20_t* sys);
 // send a key-down event to the VIC-20
 void vic20_key_down(vic20_t* sys, int key_code);
 // send a key-up event to the VIC-20
@@ -208,6 +261,8 @@ bool vic20_is_tape_motor_on(vic20_t* sys);
 uint32_t vic20_save_snapshot(vic20_t* sys, vic20_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool vic20_load_snapshot(vic20_t* sys, uint32_t version, vic20_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t vic20_state_hash(vic20_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -226,11 +281,18 @@ bool vic20_load_snapshot(vic20_t* sys, uint32_t version, vic20_t* src);
 #define _VIC20_SCREEN_X (32)
 #define _VIC20_SCREEN_Y (8)
 
-static uint16_t _vic20_vic_fetch(uint16_t addr, void* user_data);
 static void _vic20_init_key_map(vic20_t* sys);
 
 #define _VIC20_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
+// VIA output pins which are reused while a VIA tick is skipped
+#define _VIC20_VIA_OUT_PINS (M6522_PA_PINS|M6522_PB_PINS|M6522_CA_PINS|M6522_CB_PINS|M6522_IRQ)
+
+// event scheduler slots
+#define _VIC20_SCHED_VIA_1 (0)
+#define _VIC20_SCHED_VIA_2 (1)
+#define _VIC20_NUM_SCHED_SLOTS (2)
+
 void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
     if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
@@ -242,6 +304,8 @@ void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
     sys->via1_joy_mask = M6522_PA2|M6522_PA3|M6522_PA4|M6522_PA5;
     sys->via2_joy_mask = M6522_PB7;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
     sys->audio.callback = desc->audio.callback;
     sys->audio.num_samples = _VIC20_DEFAULT(desc->audio.num_samples, VIC20_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= VIC20_MAX_AUDIO_SAMPLES);
@@ -258,8 +322,24 @@ void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
     sys->pins = m6502_init(&sys->cpu, &(m6502_desc_t){0});
     m6522_init(&sys->via_1);
     m6522_init(&sys->via_2);
+    chips_sched_init(&sys->sched, _VIC20_NUM_SCHED_SLOTS);
+    /*
+        the VIC reads video memory directly, with the same layout as the
+        mem_vic mapping below, and the color RAM on the upper 4 data bits
+    */
+    m6561_vidmem_t vidmem = { .color_ram = sys->color_ram };
+    for (size_t i = 0; i < 4; i++) {
+        vidmem.pages[0x0 + i] = &sys->rom_char[i * M6561_VIDMEM_PAGE_SIZE];
+        vidmem.pages[0xC + i] = &sys->ram1[i * M6561_VIDMEM_PAGE_SIZE];
+    }
+    vidmem.pages[0x8] = sys->ram0;
+    if (desc->mem_config == VIC20_MEMCONFIG_MAX) {
+        for (size_t i = 0; i < 3; i++) {
+            vidmem.pages[0x9 + i] = &sys->ram_3k[i * M6561_VIDMEM_PAGE_SIZE];
+        }
+    }
     m6561_init(&sys->vic, &(m6561_desc_t){
-        .fetch_cb = _vic20_vic_fetch,
+        .vidmem = vidmem,
         .framebuffer = {
             .ptr = sys->fb,
             .size = sizeof(sys->fb)
@@ -270,11 +350,15 @@ void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
             .width = _VIC20_SCREEN_WIDTH,
             .height = _VIC20_SCREEN_HEIGHT,
         },
-        .user_data = sys,
+        .triple_buffer = desc->triple_buffer,
+        .vidlog = desc->vidlog,
         .tick_hz = VIC20_FREQUENCY,
         .sound_hz = _VIC20_DEFAULT(desc->audio.sample_rate, 44100),
         .sound_magnitude = _VIC20_DEFAULT(desc->audio.volume, 1.0f),
     });
+    if (desc->triple_buffer) {
+        desc->triple_buffer->clock = &sys->tick;
+    }
     _vic20_init_key_map(sys);
 
     /*
@@ -358,6 +442,7 @@ void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
         c1530_init(&sys->c1530, &(c1530_desc_t){
             .cas_port = &sys->cas_port,
         });
+        sys->tape_turbo = desc->c1530_turbo;
     }
 }
 
@@ -379,14 +464,18 @@ void vic20_reset(vic20_t* sys) {
     sys->cas_port = VIC20_CASPORT_MOTOR|VIC20_CASPORT_SENSE;
     m6522_reset(&sys->via_1);
     m6522_reset(&sys->via_2);
+    chips_sched_init(&sys->sched, _VIC20_NUM_SCHED_SLOTS);
     m6561_reset(&sys->vic);
     if (sys->c1530.valid) {
         c1530_reset(&sys->c1530);
     }
 }
 
-static uint64_t _vic20_tick(vic20_t* sys, uint64_t pins) {
-
+/* the system tick function, has_c1530 is a compile-time constant in the
+    specialized tick functions below
+*/
+static CHIPS_FORCE_INLINE uint64_t _vic20_tick(vic20_t* sys, uint64_t pins, bool has_c1530) {
+    sys->tick++;
     // tick the CPU
     pins = m6502_tick(&sys->cpu, pins);
 
@@ -464,7 +553,15 @@ static uint64_t _vic20_tick(vic20_t* sys, uint64_t pins) {
         if (sys->cas_port & VIC20_CASPORT_SENSE) {
             via1_pins |= M6522_PA6;
         }
-        via1_pins = m6522_tick(&sys->via_1, via1_pins);
+        // the VIA is skipped while it's idle, not selected and its inputs don't change
+        if ((via1_pins & M6522_CS1) || chips_sched_due(&sys->sched, _VIC20_SCHED_VIA_1) || m6522_inputs_changed(&sys->via_1, via1_pins)) {
+            m6522_advance(&sys->via_1, chips_sched_sync(&sys->sched, _VIC20_SCHED_VIA_1));
+            via1_pins = m6522_tick(&sys->via_1, via1_pins);
+            chips_sched_set(&sys->sched, _VIC20_SCHED_VIA_1, m6522_idle_ticks(&sys->via_1));
+        }
+        else {
+            via1_pins = sys->via_1.pins & _VIC20_VIA_OUT_PINS;
+        }
         if (via1_pins & M6522_CA2) {
             sys->cas_port |= VIC20_CASPORT_MOTOR;
         }
@@ -505,7 +602,14 @@ static uint64_t _vic20_tick(vic20_t* sys, uint64_t pins) {
         if (sys->cas_port & VIC20_CASPORT_READ) {
             via2_pins |= M6522_CA1;
         }
-        via2_pins = m6522_tick(&sys->via_2, via2_pins);
+        if ((via2_pins & M6522_CS1) || chips_sched_due(&sys->sched, _VIC20_SCHED_VIA_2) || m6522_inputs_changed(&sys->via_2, via2_pins)) {
+            m6522_advance(&sys->via_2, chips_sched_sync(&sys->sched, _VIC20_SCHED_VIA_2));
+            via2_pins = m6522_tick(&sys->via_2, via2_pins);
+            chips_sched_set(&sys->sched, _VIC20_SCHED_VIA_2, m6522_idle_ticks(&sys->via_2));
+        }
+        else {
+            via2_pins = sys->via_2.pins & _VIC20_VIA_OUT_PINS;
+        }
         uint8_t kbd_cols = ~M6522_GET_PB(via2_pins);
         kbd_set_active_columns(&sys->kbd, kbd_cols);
         if (via2_pins & M6522_IRQ) {
@@ -519,53 +623,111 @@ static uint64_t _vic20_tick(vic20_t* sys, uint64_t pins) {
     // tick the VIC
     {
         vic_pins = m6561_tick(&sys->vic, vic_pins);
+        chips_vblank_update(&sys->vblank, sys->vic.rs.frame_count);
         if ((vic_pins & (M6561_CS|M6561_RW)) == (M6561_CS|M6561_RW)) {
             pins = M6502_COPY_DATA(pins, vic_pins);
         }
-        if (vic_pins & M6561_SAMPLE) {
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->vic.sound.sample;
-            if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
-                sys->audio.sample_pos = 0;
-            }
+        if ((vic_pins & M6561_SAMPLE) && !sys->tape_turbo_active) {
+            chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->vic.sound.sample, sys->tick);
         }
     }
 
     // optionally tick the C1530 datassette
-    if (sys->c1530.valid) {
+    if (has_c1530) {
         c1530_tick(&sys->c1530);
     }
+    chips_sched_tick(&sys->sched);
     return pins;
 }
 
-uint32_t vic20_exec(vic20_t* sys, uint32_t micro_seconds) {
-    CHIPS_ASSERT(sys && sys->valid);
-    uint32_t num_ticks = clk_us_to_ticks(VIC20_FREQUENCY, micro_seconds);
+/* tick functions specialized for the optional datasette, so that the
+    check for absent hardware disappears from the inner loop
+*/
+typedef uint64_t (*_vic20_tick_func_t)(vic20_t* sys, uint64_t pins);
+static uint64_t _vic20_tick_basic(vic20_t* sys, uint64_t pins) { return _vic20_tick(sys, pins, false); }
+static uint64_t _vic20_tick_c1530(vic20_t* sys, uint64_t pins) { return _vic20_tick(sys, pins, true); }
+
+// true while the tape turbo mode should be active
+static inline bool _vic20_tape_turbo(vic20_t* sys) {
+    return sys->tape_turbo && !(sys->cas_port & VIC20_CASPORT_MOTOR) && (sys->c1530.pos < sys->c1530.size);
+}
+
+/* run for num_ticks (or up to max_ticks in tape turbo mode), stop early at
+    the end of the current video frame if to_frame_end is true
+*/
+static uint32_t _vic20_run(vic20_t* sys, uint32_t num_ticks, uint32_t max_ticks, bool to_frame_end) {
+    const uint32_t frame_count = sys->vic.rs.frame_count;
+    const _vic20_tick_func_t tick = sys->c1530.valid ? _vic20_tick_c1530 : _vic20_tick_basic;
     uint64_t pins = sys->pins;
+    uint32_t ticks = 0;
     if (0 == sys->debug.callback.func) {
         // run without debug callback
-        for (uint32_t ticks = 0; ticks < num_ticks; ticks++) {
-            pins = _vic20_tick(sys, pins);
+        for (; ((ticks < num_ticks) || ((ticks < max_ticks) && _vic20_tape_turbo(sys))) &&
+               (!to_frame_end || (frame_count == sys->vic.rs.frame_count)); ticks++)
+        {
+            pins = tick(sys, pins);
         }
     }
     else {
-        // run with debug callback
-        for (uint32_t ticks = 0; (ticks < num_ticks) && !(*sys->debug.stopped); ticks++) {
-            pins = _vic20_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+        // run with debug callback, if a breakpoint map is attached, only
+        // call the debug callback when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
+        for (; ((ticks < num_ticks) || ((ticks < max_ticks) && _vic20_tape_turbo(sys))) &&
+               (!to_frame_end || (frame_count == sys->vic.rs.frame_count)) && !(*sys->debug.stopped); ticks++)
+        {
+            pins = tick(sys, pins);
+            if (!map || chips_breakmap_hit(map, M6502_GET_ADDR(pins), pins & M6502_SYNC, pins & M6502_RW, !(pins & M6502_RW))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    return ticks;
+}
+
+// bring the VIAs up to date for debugging UIs and snapshots
+static void _vic20_exec_done(vic20_t* sys) {
+    m6522_advance(&sys->via_1, chips_sched_sync(&sys->sched, _VIC20_SCHED_VIA_1));
+    m6522_advance(&sys->via_2, chips_sched_sync(&sys->sched, _VIC20_SCHED_VIA_2));
+    sys->tape_turbo_active = false;
+}
+
+uint32_t vic20_exec(vic20_t* sys, uint32_t micro_seconds) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->vic.headless = chips_headless_update(&sys->headless);
+    uint32_t num_ticks = clk_us_to_ticks(VIC20_FREQUENCY, micro_seconds);
+    // in tape turbo mode, keep running beyond num_ticks until the tape motor stops
+    uint32_t max_ticks = num_ticks;
+    sys->tape_turbo_active = _vic20_tape_turbo(sys);
+    if (sys->tape_turbo_active) {
+        max_ticks = num_ticks * VIC20_TAPE_TURBO_FACTOR;
+        sys->vic.headless = true;
+    }
+    const uint32_t ticks = _vic20_run(sys, num_ticks, max_ticks, false);
+    _vic20_exec_done(sys);
     kbd_update(&sys->kbd, micro_seconds);
-    return num_ticks;
+    return ticks;
 }
 
-static uint16_t _vic20_vic_fetch(uint16_t addr, void* user_data) {
-    vic20_t* sys = (vic20_t*) user_data;
-    uint16_t data = (sys->color_ram[addr & 0x03FF]<<8) | mem_rd(&sys->mem_vic, addr);
-    return data;
+uint32_t vic20_exec_frame(vic20_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->vic.headless = chips_headless_update(&sys->headless);
+    // safety limit of two PAL frames
+    const uint32_t max_frame_ticks = clk_us_to_ticks(VIC20_FREQUENCY, 2 * 20000);
+    // in tape turbo mode, keep running whole frames until the tape motor stops
+    int num_frames = 1;
+    sys->tape_turbo_active = _vic20_tape_turbo(sys);
+    if (sys->tape_turbo_active) {
+        num_frames = VIC20_TAPE_TURBO_FACTOR;
+        sys->vic.headless = true;
+    }
+    uint32_t ticks = 0;
+    for (int i = 0; (i < num_frames) && ((0 == i) || _vic20_tape_turbo(sys)); i++) {
+        ticks += _vic20_run(sys, max_frame_ticks, max_frame_ticks, true);
+    }
+    _vic20_exec_done(sys);
+    kbd_update(&sys->kbd, clk_ticks_to_us(VIC20_FREQUENCY, ticks, &sys->frame_us_rem));
+    return ticks;
 }
 
 static void _vic20_init_key_map(vic20_t* sys) {
@@ -635,9 +797,8 @@ bool vic20_quickload(vic20_t* sys, chips_range_t data) {
     const uint16_t start_addr = ptr[1]<<8 | ptr[0];
     ptr += 2;
     const uint16_t end_addr = start_addr + (data.size - 2);
-    uint16_t addr = start_addr;
-    while (addr < end_addr) {
-        mem_wr(&sys->mem_cpu, addr++, *ptr++);
+    if (end_addr > start_addr) {
+        mem_write_range(&sys->mem_cpu, start_addr, ptr, end_addr - start_addr);
     }
     return true;
 }
@@ -656,9 +817,8 @@ bool vic20_insert_rom_cartridge(vic20_t* sys, chips_range_t data) {
     const uint16_t start_addr = ptr[1]<<8 | ptr[0];
     ptr += 2;
     const uint16_t end_addr = start_addr + (data.size - 2);
-    uint16_t addr = start_addr;
-    while (addr < end_addr) {
-        mem_wr(&sys->mem_cart, addr++, *ptr++);
+    if (end_addr > start_addr) {
+        mem_write_range(&sys->mem_cart, start_addr, ptr, end_addr - start_addr);
     }
 
     // map the ROM cartridge into the CPU's memory layer 0
@@ -807,10 +967,13 @@ chips_display_info_t vic20_display_info(vic20_t* sys) {
                 .height = M6561_FRAMEBUFFER_HEIGHT,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = (sys && !sys->vic.crt.triple_buffer) ? &sys->vic.crt.dirty_lines : 0,
             .buffer = {
                 .ptr = sys ? sys->fb : 0,
                 .size = M6561_FRAMEBUFFER_SIZE_BYTES,
-            }
+            },
+            .triple_buffer = sys ? sys->vic.crt.triple_buffer : 0,
         },
         .palette = m6561_palette(),
     };
@@ -829,10 +992,27 @@ chips_display_info_t vic20_display_info(vic20_t* sys) {
     return res;
 }
 
+chips_observation_t vic20_observe(vic20_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 5,
+        .ram = {
+            { .name = "color_ram", .mem = { .ptr = sys->color_ram, .size = sizeof(sys->color_ram) } },
+            { .name = "ram0", .mem = { .ptr = sys->ram0, .size = sizeof(sys->ram0) } },
+            { .name = "ram_3k", .mem = { .ptr = sys->ram_3k, .size = sizeof(sys->ram_3k) } },
+            { .name = "ram1", .mem = { .ptr = sys->ram1, .size = sizeof(sys->ram1) } },
+            { .name = "ram_exp", .mem = { .ptr = sys->ram_exp, .size = sizeof(sys->ram_exp) } },
+        },
+        .display = vic20_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_M6502, .state = &sys->cpu },
+    };
+}
+
 uint32_t vic20_save_snapshot(vic20_t* sys, vic20_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     m6502_snapshot_onsave(&dst->cpu);
     m6561_snapshot_onsave(&dst->vic);
@@ -851,6 +1031,8 @@ bool vic20_load_snapshot(vic20_t* sys, uint32_t version, vic20_t* src) {
     static vic20_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     m6502_snapshot_onload(&im.cpu, &sys->cpu);
     m6561_snapshot_onload(&im.vic, &sys->vic);
@@ -858,8 +1040,35 @@ bool vic20_load_snapshot(vic20_t* sys, uint32_t version, vic20_t* src) {
     mem_snapshot_onload(&im.mem_cpu, sys);
     mem_snapshot_onload(&im.mem_vic, sys);
     mem_snapshot_onload(&im.mem_cart, sys);
+    chips_dirty_lines_set_all(&im.vic.crt.dirty_lines);
     *sys = im;
     return true;
 }
 
+uint64_t vic20_state_hash(vic20_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    uint64_t h = CHIPS_HASH_SEED;
+    h = m6502_hash(&sys->cpu, h);
+    h = CHIPS_HASH(h, sys->via_1);
+    h = CHIPS_HASH(h, sys->via_2);
+    h = m6561_hash(&sys->vic, h);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->sched);
+    h = CHIPS_HASH(h, sys->mem_config);
+    h = CHIPS_HASH(h, sys->cas_port);
+    h = CHIPS_HASH(h, sys->iec_port);
+    h = CHIPS_HASH(h, sys->kbd_joy_mask);
+    h = CHIPS_HASH(h, sys->joy_joy_mask);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->color_ram);
+    h = CHIPS_HASH(h, sys->ram0);
+    h = CHIPS_HASH(h, sys->ram_3k);
+    h = CHIPS_HASH(h, sys->ram1);
+    h = CHIPS_HASH(h, sys->ram_exp);
+    if (sys->c1530.valid) {
+        h = c1530_hash(&sys->c1530, h);
+    }
+    return h;
+}
+
 #endif // CHIPS_IMPL
@@ -40,6 +40,44 @@
 
     No cassette-tape / beeper sound emulated!
 
+    ## Tape Load Trap
+
+    Instead of emulating the cassette interface, a tape made of
+    concatenated "KC .z80" files (without padding) can be inserted with
+    z1013_insert_tape(). While a tape is inserted, the monitor's system
+    call entry at RST 20h is trapped, and the CLOAD call (function byte 09h after the RST
+    instruction) is satisfied directly: the next file on the tape is
+    copied into memory at the load address from its header, the carry
+    flag is cleared and execution continues behind the function byte. If
+    no valid file is left on the tape, the carry flag is set instead.
+    All other system calls run through the monitor as usual.
+
+    ## Streaming Snapshots
+
+    z1013_save_stream() and z1013_load_stream() save and load the emulator
+    state as a portable streaming snapshot (see chips_stream_t in
+    chips_common.h), for instance to write the state into a file or to
+    send it to another host. The RAM, ROM and framebuffer contents are
+    stored as separate blob sections which can be left out via the
+    stream's skip mask. Streams can only be loaded into a Z1013 of the
+    same model, the inserted tape isn't part of the stream (only the tape
+    position). If loading fails, the emulator state remains unchanged.
+
+    ## State Hash
+
+    z1013_state_hash() returns a hash over the CPU, PIO and keyboard state
+    and the RAM, e.g. to check that two emulator instances are still in
+    sync. The RAM hash is maintained incrementally via dirty tracking in
+    z1013_t.mem (switched on by the first call).
+
+    ## Observation
+
+    z1013_observe() returns a pointer to the 64 KByte RAM ("ram", this
+    includes the video RAM at 0xEC00), the display info and the z80_t CPU
+    state (see chips_observation_t in chips_common.h). The video memory is
+    decoded at the end of z1013_exec(), so the vblank callback in
+    z1013_desc_t is invoked after that, once per exec call.
+
     ## TODO: add hardware/software reference links
 
     ## TODO: Describe Usage
@@ -73,7 +111,7 @@ extern "C" {
 #endif
 
 // bump this whenever the z1013_t struct layout changes
-#define Z1013_SNAPSHOT_VERSION (0x0001)
+#define Z1013_SNAPSHOT_VERSION (0x0002)
 
 #define Z1013_FRAMEBUFFER_WIDTH (256)
 #define Z1013_FRAMEBUFFER_HEIGHT (256)
@@ -92,6 +130,8 @@ typedef enum {
 typedef struct {
     z1013_type_t type;          // default is Z1013_TYPE_64
     chips_debug_t debug;        // optional debug callback and userdata ptr
+    chips_headless_t headless;  // optional headless video mode (see chips_common.h)
+    chips_vblank_callback_t vblank; // optional per-frame callback (see 'Observation')
 
     // ROM images
     struct {
@@ -107,16 +147,25 @@ typedef struct {
     mem_t mem;
     z80pio_t pio;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     z1013_type_t type;
     bool valid;
     uint16_t kbd_request_line_mask;
     int kbd_request_line_hilo_shift;
     kbd_t kbd;
+    chips_iomap_t iomap;                // IO port to device select bits
     uint64_t freq_hz;
     uint8_t ram[1<<16];
+    chips_page_hashes_t ram_hashes;     // cached RAM page hashes for z1013_state_hash()
     uint8_t rom_os[2048];
     uint8_t rom_font[2048];
+    chips_tape_t tape;                  // optional tape for the CLOAD trap
+    bool vidmem_shadow_valid;           // false if all character cells must be decoded
+    uint8_t vidmem_shadow[32*32];       // video memory content at the last decode
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
     alignas(64) uint8_t fb[Z1013_FRAMEBUFFER_SIZE_BYTES];
 } z1013_t;
 
@@ -128,6 +177,8 @@ void z1013_discard(z1013_t* sys);
 void z1013_reset(z1013_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t z1013_display_info(z1013_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t z1013_observe(z1013_t* sys);
 // run the Z1013 instance for a given number of microseconds, returns number of executed ticks
 uint32_t z1013_exec(z1013_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -136,10 +187,22 @@ void z1013_key_down(z1013_t* sys, int key_code);
 void z1013_key_up(z1013_t* sys, int key_code);
 // load a "KC .z80" file into the emulator
 bool z1013_quickload(z1013_t* sys, chips_range_t data);
+// insert a tape of concatenated "KC .z80" files for the CLOAD trap (data must remain valid until removed)
+void z1013_insert_tape(z1013_t* sys, chips_range_t data);
+// remove the tape
+void z1013_remove_tape(z1013_t* sys);
+// return true if a tape is inserted
+bool z1013_tape_inserted(z1013_t* sys);
 // take snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t z1013_save_snapshot(z1013_t* sys, z1013_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src);
+// save the emulator state into a streaming snapshot, returns false on error
+bool z1013_save_stream(z1013_t* sys, chips_stream_t* stream);
+// load the emulator state from a streaming snapshot, returns false on error
+bool z1013_load_stream(z1013_t* sys, chips_stream_t* stream);
+// hash the emulation state (see 'State Hash')
+uint64_t z1013_state_hash(z1013_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -153,6 +216,11 @@ bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src);
 #define CHIPS_ASSERT(c) assert(c)
 #endif
 
+// monitor system call entry (RST 20h) and CLOAD function byte
+#define _Z1013_RST20_ADDR   (0x0020)
+#define _Z1013_MON_CLOAD    (0x09)
+#define _Z1013_FETCH_PINS   (Z80_M1|Z80_MREQ|Z80_RD)
+
 /*
     IO address decoding.
 
@@ -183,10 +251,14 @@ bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src);
     in that order. Next the CPU reads back the keyboard matrix lines
     in 2 steps of 4 bits each from PIO port B.
 */
-#define _Z1013_PIO_SEL_MASK (Z80_IORQ|Z80_A4|Z80_A3|Z80_A2)
-#define _Z1013_PIO_SEL_PINS (Z80_IORQ)
-#define _Z1013_PORT8_SEL_MASK (Z80_IORQ|Z80_WR|Z80_A4|Z80_A3|Z80_A2)
-#define _Z1013_PORT8_SEL_PINS (Z80_IORQ|Z80_WR|Z80_A3)
+#define _Z1013_IOSEL_PIO    (1<<0)
+#define _Z1013_IOSEL_PORT8  (1<<1)
+
+static void _z1013_init_iomap(z1013_t* sys) {
+    chips_iomap_clear(&sys->iomap);
+    chips_iomap_add(&sys->iomap, 0x1C, 0x00, _Z1013_IOSEL_PIO);
+    chips_iomap_add(&sys->iomap, 0x1C, 0x08, _Z1013_IOSEL_PORT8);
+}
 
 void z1013_init(z1013_t* sys, const z1013_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
@@ -197,6 +269,10 @@ void z1013_init(z1013_t* sys, const z1013_desc_t* desc) {
     sys->valid = true;
     sys->freq_hz = (Z1013_TYPE_01 == desc->type) ? 1000000 : 2000000;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
+    _z1013_init_iomap(sys);
 
     // copy ROM dumps
     CHIPS_ASSERT(desc->roms.font.ptr && (desc->roms.font.size == sizeof(sys->rom_font)));
@@ -320,14 +396,23 @@ void z1013_reset(z1013_t* sys) {
     sys->pins = z80_prefetch(&sys->cpu, 0xF000);
 }
 
+static uint64_t _z1013_tape_trap(z1013_t* sys, uint64_t pins);
+
 static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
+    sys->tick++;
     pins = z80_tick(&sys->cpu, pins) & Z80_PIN_MASK;
 
+    // IO address decoding, only A0..A4 are decoded
+    const uint8_t io_sel = (pins & Z80_IORQ) ? chips_iomap_select(&sys->iomap, (uint8_t)Z80_GET_ADDR(pins)) : 0;
+
     // handle memory requests
     if (pins & Z80_MREQ) {
         const uint16_t addr = Z80_GET_ADDR(pins);
         if (pins & Z80_RD) {
             Z80_SET_DATA(pins, mem_rd(&sys->mem, addr));
+            if ((addr == _Z1013_RST20_ADDR) && sys->tape.ptr && ((pins & _Z1013_FETCH_PINS) == _Z1013_FETCH_PINS)) {
+                pins = _z1013_tape_trap(sys, pins);
+            }
         }
         else if (pins & Z80_WR) {
             mem_wr(&sys->mem, addr, Z80_GET_DATA(pins));
@@ -336,7 +421,7 @@ static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
 
     // tick the PIO, no interrupts on the Z1013
     {
-        if ((pins & _Z1013_PIO_SEL_MASK) == _Z1013_PIO_SEL_PINS) {
+        if (io_sel & _Z1013_IOSEL_PIO) {
             pins |= Z80PIO_CE;
         }
         if (pins & Z80_A0) { pins |= Z80PIO_CDSEL; }
@@ -355,7 +440,7 @@ static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
 
     // 8-bit write-only latch at port address 8 to store the requested
     // keyboard column for the next keyboard scan
-    if ((pins & _Z1013_PORT8_SEL_MASK) == _Z1013_PORT8_SEL_PINS) {
+    if ((io_sel & _Z1013_IOSEL_PORT8) && (pins & Z80_WR)) {
         uint8_t column_mask = 1 << (Z80_GET_DATA(pins) & 7);
         sys->kbd_request_line_mask = ~kbd_test_lines(&sys->kbd, column_mask);
     }
@@ -363,8 +448,9 @@ static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
     return pins & Z80_PIN_MASK;
 }
 
-/* since the Z1013 didn't have any sort of programmable video output,
-    we're cheating a bit and decode the entire frame in one go
+/* decode the 32x32 character video memory into the framebuffer, only
+    the character cells which have changed since the last decode are
+    decoded (compared against a shadow copy of the video memory)
 */
 static void _z1013_decode_vidmem(z1013_t* sys) {
     static const uint32_t lut32[16] = {
@@ -373,23 +459,37 @@ static void _z1013_decode_vidmem(z1013_t* sys) {
         0x00000001, 0x01000001, 0x00010001, 0x01010001,
         0x00000101, 0x01000101, 0x00010101, 0x01010101,
     };
-    uint32_t* dst32 = (uint32_t*) sys->fb;
     const uint8_t* src = &sys->ram[0xEC00];   // the 32x32 framebuffer starts at EC00
     const uint8_t* font = sys->rom_font;
-    for (size_t y = 0; y < 32; y++) {
-        for (size_t py = 0; py < 8; py++) {
-            for (size_t x = 0; x < 32; x++) {
-                uint8_t chr = src[(y<<5) + x];
-                uint8_t pixels = font[(chr<<3)|py];
-                *dst32++ = lut32[pixels >> 4];
-                *dst32++ = lut32[pixels & 0xF];
+    uint8_t* shadow = sys->vidmem_shadow;
+    const bool all = !sys->vidmem_shadow_valid;
+    for (size_t y = 0; y < 32; y++, src += 32, shadow += 32) {
+        if (!all && (0 == memcmp(src, shadow, 32))) {
+            continue;
+        }
+        for (size_t x = 0; x < 32; x++) {
+            const uint8_t chr = src[x];
+            if (!all && (chr == shadow[x])) {
+                continue;
+            }
+            shadow[x] = chr;
+            uint32_t* dst32 = (uint32_t*) &sys->fb[(y<<3) * Z1013_FRAMEBUFFER_WIDTH + (x<<3)];
+            for (size_t py = 0; py < 8; py++, dst32 += Z1013_FRAMEBUFFER_WIDTH / 4) {
+                const uint8_t pixels = font[(chr<<3)|py];
+                dst32[0] = lut32[pixels >> 4];
+                dst32[1] = lut32[pixels & 0xF];
             }
         }
+        for (size_t py = 0; py < 8; py++) {
+            chips_dirty_lines_set(&sys->dirty_lines, (y<<3) | py);
+        }
     }
+    sys->vidmem_shadow_valid = true;
 }
 
 uint32_t z1013_exec(z1013_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
+    chips_headless_update(&sys->headless);
     const uint32_t num_ticks = clk_us_to_ticks(sys->freq_hz, micro_seconds);
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
@@ -399,15 +499,23 @@ uint32_t z1013_exec(z1013_t* sys, uint32_t micro_seconds) {
         }
     }
     else {
-        // run with debug hook
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
         for (uint32_t ticks = 0; (ticks < num_ticks) && !(*sys->debug.stopped); ticks++) {
             pins = _z1013_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
     kbd_update(&sys->kbd, micro_seconds);
-    _z1013_decode_vidmem(sys);
+    if (!sys->headless.skip) {
+        _z1013_decode_vidmem(sys);
+    }
+    chips_vblank_notify(&sys->vblank);
     return num_ticks;
 }
 
@@ -434,6 +542,66 @@ typedef struct {
     uint8_t name[16];
 } _z1013_kcz80_header;
 
+// validate a KC .z80 file header and return the number of data bytes, or 0 if not valid
+static size_t _z1013_kcz80_size(chips_range_t data) {
+    if (data.size < sizeof(_z1013_kcz80_header)) {
+        return 0;
+    }
+    const _z1013_kcz80_header* hdr = (const _z1013_kcz80_header*)data.ptr;
+    if ((hdr->d3[0] != 0xD3) || (hdr->d3[1] != 0xD3) || (hdr->d3[2] != 0xD3)) {
+        return 0;
+    }
+    const int addr = hdr->load_addr_h<<8 | hdr->load_addr_l;
+    const int end_addr = hdr->end_addr_h<<8 | hdr->end_addr_l;
+    if (end_addr <= addr) {
+        return 0;
+    }
+    return (size_t)(end_addr - addr);
+}
+
+/* called on the opcode fetch at the RST 20h entry, the return address
+    on the stack points to the system call's function byte
+*/
+static uint64_t _z1013_tape_trap(z1013_t* sys, uint64_t pins) {
+    const uint16_t ret_addr = mem_rd16(&sys->mem, sys->cpu.sp);
+    if (mem_rd(&sys->mem, ret_addr) != _Z1013_MON_CLOAD) {
+        // not a CLOAD call, continue with the fetched opcode
+        return pins;
+    }
+    const chips_range_t data = chips_tape_remaining(&sys->tape);
+    const size_t num_bytes = _z1013_kcz80_size(data);
+    if (num_bytes > 0) {
+        const _z1013_kcz80_header* hdr = (const _z1013_kcz80_header*)data.ptr;
+        const uint8_t* ptr = (const uint8_t*)data.ptr + sizeof(_z1013_kcz80_header);
+        const size_t avail = data.size - sizeof(_z1013_kcz80_header);
+        const size_t num_copy = (num_bytes < avail) ? num_bytes : avail;
+        mem_write_range(&sys->mem, hdr->load_addr_h<<8 | hdr->load_addr_l, ptr, num_copy);
+        chips_tape_skip(&sys->tape, sizeof(_z1013_kcz80_header) + num_bytes);
+        sys->cpu.f &= ~Z80_CF;
+    }
+    else {
+        sys->cpu.f |= Z80_CF;
+    }
+    // return to the caller behind the function byte
+    sys->cpu.sp += 2;
+    return z80_prefetch(&sys->cpu, ret_addr + 1);
+}
+
+void z1013_insert_tape(z1013_t* sys, chips_range_t data) {
+    CHIPS_ASSERT(sys && sys->valid && data.ptr);
+    chips_tape_insert(&sys->tape, data);
+}
+
+void z1013_remove_tape(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    chips_tape_remove(&sys->tape);
+}
+
+bool z1013_tape_inserted(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return 0 != sys->tape.ptr;
+}
+
 bool z1013_quickload(z1013_t* sys, chips_range_t data) {
     CHIPS_ASSERT(sys && sys->valid && data.ptr);
     if (data.size < sizeof(_z1013_kcz80_header)) {
@@ -481,6 +649,8 @@ chips_display_info_t z1013_display_info(z1013_t* sys) {
                 .size = Z1013_FRAMEBUFFER_SIZE_BYTES,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
         },
         .screen = {
             .x = 0,
@@ -497,10 +667,24 @@ chips_display_info_t z1013_display_info(z1013_t* sys) {
     return res;
 }
 
+chips_observation_t z1013_observe(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .display = z1013_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t z1013_save_snapshot(z1013_t* sys, z1013_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
+    chips_tape_snapshot_onsave(&dst->tape);
     mem_snapshot_onsave(&dst->mem, sys);
     return Z1013_SNAPSHOT_VERSION;
 }
@@ -514,9 +698,85 @@ bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src) {
     static z1013_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
+    chips_tape_snapshot_onload(&im.tape, &sys->tape);
     mem_snapshot_onload(&im.mem, sys);
+    chips_dirty_lines_set_all(&im.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
+    *sys = im;
+    return true;
+}
+
+static void _z1013_stream(z1013_t* sys, chips_stream_t* s) {
+    chips_stream_header(s, CHIPS_STREAM_TAG('Z','1','0','1'));
+    chips_stream_begin(s, CHIPS_STREAM_TAG('S','Y','S',' '), 1);
+    uint8_t type = (uint8_t)sys->type;
+    chips_stream_u8(s, &type);
+    if (type != (uint8_t)sys->type) {
+        // the memory map depends on the model
+        s->error = true;
+    }
+    chips_stream_u64(s, &sys->pins);
+    chips_stream_u16(s, &sys->kbd_request_line_mask);
+    chips_stream_int(s, &sys->kbd_request_line_hilo_shift);
+    uint64_t tape_pos = sys->tape.pos;
+    chips_stream_u64(s, &tape_pos);
+    sys->tape.pos = (size_t)tape_pos;
+    chips_stream_end(s);
+    z80_stream(&sys->cpu, s);
+    z80pio_stream(&sys->pio, s);
+    kbd_stream(&sys->kbd, s);
+    chips_stream_blob(s, CHIPS_STREAM_TAG('R','A','M',' '), CHIPS_STREAM_RAM, sys->ram, sizeof(sys->ram));
+    chips_stream_blob(s, CHIPS_STREAM_TAG('O','S',' ',' '), CHIPS_STREAM_ROM, sys->rom_os, sizeof(sys->rom_os));
+    chips_stream_blob(s, CHIPS_STREAM_TAG('F','O','N','T'), CHIPS_STREAM_ROM, sys->rom_font, sizeof(sys->rom_font));
+    chips_stream_blob(s, CHIPS_STREAM_TAG('F','B',' ',' '), CHIPS_STREAM_FRAMEBUFFER, sys->fb, sizeof(sys->fb));
+    chips_stream_finish(s);
+}
+
+bool z1013_save_stream(z1013_t* sys, chips_stream_t* stream) {
+    CHIPS_ASSERT(sys && sys->valid && stream && !stream->loading);
+    _z1013_stream(sys, stream);
+    return chips_stream_ok(stream);
+}
+
+bool z1013_load_stream(z1013_t* sys, chips_stream_t* stream) {
+    CHIPS_ASSERT(sys && sys->valid && stream && stream->loading);
+    // load into an intermediate copy, skipped blobs keep the current content
+    static z1013_t im;
+    im = *sys;
+    _z1013_stream(&im, stream);
+    if (!chips_stream_ok(stream)) {
+        return false;
+    }
+    if (im.tape.pos > im.tape.size) {
+        im.tape.pos = im.tape.size;
+    }
+    im.vidmem_shadow_valid = false;
+    chips_dirty_lines_set_all(&im.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
+    // the memory map of the copy still points into the system's memory
     *sys = im;
     return true;
 }
 
+uint64_t z1013_state_hash(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != sys->ram) {
+        mem_track_dirty(&sys->mem, sys->ram, sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->pio);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->kbd_request_line_mask);
+    h = CHIPS_HASH(h, sys->kbd_request_line_hilo_shift);
+    h = CHIPS_HASH(h, sys->tape.pos);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return h;
+}
+
 #endif // CHIPS_IMPL
@@ -50,6 +50,21 @@
     plus a blinking flag. This video extension was already available on the
     Z9001 though.
 
+    ## State Hash
+
+    z9001_state_hash() hashes the CPU, PIO, CTC, beeper and keyboard state
+    and the RAM (for instance for netplay desync detection). The first
+    call switches on RAM dirty tracking in z9001_t.mem, after that only
+    written RAM pages are hashed again.
+
+    ## Observation
+
+    z9001_observe() returns a pointer to the 64 KByte RAM ("ram", this
+    includes the color and ASCII video RAM), the display info and the
+    z80_t CPU state (see chips_observation_t in chips_common.h). The video
+    memory is decoded at the end of z9001_exec(), so the vblank callback in
+    z9001_desc_t is invoked after that, once per exec call.
+
     ## TODO:
     - enable/disable audio on PIO1-A bit 7
     - border color
@@ -88,7 +103,7 @@ extern "C" {
 #endif
 
 // bump this whenever the z9001_t struct layout changes
-#define Z9001_SNAPSHOT_VERSION (0x0001)
+#define Z9001_SNAPSHOT_VERSION (0x0002)
 
 #define Z9001_MAX_AUDIO_SAMPLES (1024)      // max number of audio samples in internal sample buffer
 #define Z9001_DEFAULT_AUDIO_SAMPLES (128)   // default number of samples in internal sample buffer
@@ -108,7 +123,9 @@ typedef enum {
 typedef struct {
     z9001_type_t type;                  // default is Z9001_TYPE_Z9001
     chips_debug_t debug;                // optional debug hook
+    chips_headless_t headless;          // optional headless video mode (see chips_common.h)
     chips_audio_desc_t audio;
+    chips_vblank_callback_t vblank;     // optional per-frame callback (see 'Observation')
     struct {
         // Z9001 ROM images
         struct {
@@ -137,15 +154,19 @@ typedef struct {
     uint8_t blink_flip_flop;    // bit 7 0=>1=>0
     z9001_type_t type;
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     uint64_t ctc_zcto2;         // pin mask to store state of CTC ZCTO2
     uint32_t blink_counter;
     // FIXME: uint8_t border_color;
     mem_t mem;
     kbd_t kbd;
+    chips_iomap_t iomap;        // IO port to device select bits
 
     bool valid;
     bool z9001_has_basic_rom;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
 
     struct {
         chips_audio_callback_t callback;
@@ -154,8 +175,13 @@ typedef struct {
         float sample_buffer[Z9001_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[1<<16];
+    chips_page_hashes_t ram_hashes;     // cached RAM page hashes for z9001_state_hash()
     uint8_t rom[0x4000];
     uint8_t rom_font[0x0800];   // 2 KB font ROM (not mapped into CPU address space)
+    bool vidmem_shadow_valid;           // false if all character cells must be decoded
+    uint8_t vidmem_shadow[24*40];       // character codes at the last decode
+    uint8_t colmem_shadow[24*40];       // effective (blink-resolved) colors at the last decode
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
     alignas(64) uint8_t fb[Z9001_FRAMEBUFFER_SIZE_BYTES];
 } z9001_t;
 
@@ -167,6 +193,8 @@ void z9001_discard(z9001_t* sys);
 void z9001_reset(z9001_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t z9001_display_info(z9001_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t z9001_observe(z9001_t* sys);
 // run Z9001 instance for a given number of microseconds, return number of executed ticks
 uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -179,6 +207,8 @@ bool z9001_quickload(z9001_t* sys, chips_range_t data);
 uint32_t z9001_save_snapshot(z9001_t* sys, z9001_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool z9001_load_snapshot(z9001_t* sys, uint32_t version, const z9001_t* src);
+// hash the emulation state (see 'State Hash')
+uint64_t z9001_state_hash(z9001_t* sys);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -203,18 +233,20 @@ static inline uint32_t _z9001_xorshift32(uint32_t x) {
 #define _Z9001_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 #define _Z9001_FREQUENCY (2457600)
 
-// IO address decoding masks and pins
-#define _Z9001_IO_SEL_MASK (Z80_IORQ|Z80_M1|Z80_A7|Z80_A6)
-#define _Z9001_IO_SEL_PINS (Z80_IORQ|Z80_A7)
-// CTC is mapped to ports 0x80 to 0x87 (each port is mapped twice)
-#define _Z9001_CTC_SEL_MASK (_Z9001_IO_SEL_MASK|Z80_A5|Z80_A4|Z80_A3)
-#define _Z9001_CTC_SEL_PINS (_Z9001_IO_SEL_PINS)
-// PIO1 is mapped to ports 0x88 to 0x8F (each port is mapped twice)
-#define _Z9001_PIO1_SEL_MASK (_Z9001_IO_SEL_MASK|Z80_A5|Z80_A4|Z80_A3)
-#define _Z9001_PIO1_SEL_PINS (_Z9001_IO_SEL_PINS|Z80_A3)
-// PIO2 is mapped to ports 0x90 to 0x97 (each port is mapped twice)
-#define _Z9001_PIO2_SEL_MASK (_Z9001_IO_SEL_MASK|Z80_A5|Z80_A4|Z80_A3)
-#define _Z9001_PIO2_SEL_PINS (_Z9001_IO_SEL_PINS|Z80_A4)
+// IO port select bits in the IO port select table
+#define _Z9001_IOSEL_CTC    (1<<0)
+#define _Z9001_IOSEL_PIO1   (1<<1)
+#define _Z9001_IOSEL_PIO2   (1<<2)
+
+static void _z9001_init_iomap(z9001_t* sys) {
+    chips_iomap_clear(&sys->iomap);
+    // CTC is mapped to ports 0x80 to 0x87 (each port is mapped twice)
+    chips_iomap_add(&sys->iomap, 0xF8, 0x80, _Z9001_IOSEL_CTC);
+    // PIO1 is mapped to ports 0x88 to 0x8F (each port is mapped twice)
+    chips_iomap_add(&sys->iomap, 0xF8, 0x88, _Z9001_IOSEL_PIO1);
+    // PIO2 is mapped to ports 0x90 to 0x97 (each port is mapped twice)
+    chips_iomap_add(&sys->iomap, 0xF8, 0x90, _Z9001_IOSEL_PIO2);
+}
 
 void z9001_init(z9001_t* sys, const z9001_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
@@ -222,8 +254,12 @@ void z9001_init(z9001_t* sys, const z9001_desc_t* desc) {
 
     memset(sys, 0, sizeof(z9001_t));
     sys->valid = true;
+    _z9001_init_iomap(sys);
     sys->type = desc->type;
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
     if (desc->type == Z9001_TYPE_Z9001) {
         CHIPS_ASSERT(desc->roms.z9001.font.ptr && (desc->roms.z9001.font.size == sizeof(sys->rom_font)));
         memcpy(sys->rom_font, desc->roms.z9001.font.ptr, sizeof(sys->rom_font));
@@ -374,8 +410,12 @@ void z9001_reset(z9001_t* sys) {
 }
 
 static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
+    sys->tick++;
     pins = z80_tick(&sys->cpu, pins);
 
+    // IO address decoding, only the lower 8 address bits are decoded
+    const uint8_t io_sel = ((pins & (Z80_IORQ|Z80_M1)) == Z80_IORQ) ? chips_iomap_select(&sys->iomap, (uint8_t)Z80_GET_ADDR(pins)) : 0;
+
     // handle memory requests
     if (pins & Z80_MREQ) {
         const uint16_t addr = Z80_GET_ADDR(pins);
@@ -390,8 +430,7 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
     // tick PIO-1 (highest priority daisychain device)
     {
         pins |= Z80_IEIO;
-        // PIO1 is mapped to ports 0x88 to 0x8F (each port is mapped twice)
-        if ((pins & _Z9001_PIO1_SEL_MASK) == _Z9001_PIO1_SEL_PINS) {
+        if (io_sel & _Z9001_IOSEL_PIO1) {
             pins |= Z80PIO_CE;
         }
         if (pins & Z80_A0) { pins |= Z80PIO_BASEL; }
@@ -414,8 +453,7 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
 
     // tick PIO-2
     {
-        // PIO2 is mapped to ports 0x90 to 0x97 (each port is mapped twice)
-        if ((pins & _Z9001_PIO2_SEL_MASK) == _Z9001_PIO2_SEL_PINS) {
+        if (io_sel & _Z9001_IOSEL_PIO2) {
             pins |= Z80PIO_CE;
         }
         if (pins & Z80_A0) { pins |= Z80PIO_BASEL; }
@@ -441,8 +479,7 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
            this is why we need to preserve the CTC ZCTO2 state between ticks
         */
         pins |= sys->ctc_zcto2;
-        // CTC is mapped to ports 0x80 to 0x87 (each port is mapped twice)
-        if ((pins & _Z9001_CTC_SEL_MASK) == _Z9001_CTC_SEL_PINS) {
+        if (io_sel & _Z9001_IOSEL_CTC) {
             pins |= Z80CTC_CE;
         }
         if (pins & Z80_A0) { pins |= Z80CTC_CS0; };
@@ -460,13 +497,7 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
     // tick the beeper
     if (beeper_tick(&sys->beeper)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
-        }
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sys->beeper.sample, sys->tick);
     }
 
     /* the blink flip flop is controlled by a 'bisync' video signal
@@ -498,50 +529,57 @@ static inline void _z9001_decode_8pixels(uint8_t* dst, uint8_t pixels, uint8_t c
     dst32[1] = bg32 ^ (xor32 & lut32[pixels & 0xf]);
 }
 
+/* decode the 40x24 character video memory into the framebuffer, only
+    the character cells which have changed since the last decode are
+    decoded (compared against a shadow copy of the character codes and
+    the effective colors, so that blinking cells are updated when the
+    blink flip-flop toggles)
+*/
 static void _z9001_decode_vidmem(z9001_t* sys) {
     // FIXME: there's also a 40x20 video mode
     const uint8_t* vidmem = &sys->ram[0xEC00];     // 1 KB ASCII buffer at EC00
     const uint8_t* colmem = &sys->ram[0xE800];     // 1 KB color buffer at E800
+    const uint8_t* font = sys->rom_font;
+    const bool color = Z9001_TYPE_KC87 == sys->type;
+    const bool all = !sys->vidmem_shadow_valid;
     size_t offset = 0;
-    if (Z9001_TYPE_KC87 == sys->type) {
-        // KC87 with color module
-        const uint8_t* font = sys->rom_font;
-        for (size_t y = 0; y < 24; y++) {
-            for (size_t py = 0; py < 8; py++) {
-                uint8_t* dst = &sys->fb[(y * 8 + py) * Z9001_FRAMEBUFFER_WIDTH];
-                for (size_t x = 0; x < 40; x++, dst += 8) {
-                    uint8_t chr = vidmem[offset+x];
-                    uint8_t pixels = font[(chr<<3)|py];
-                    uint8_t colors = colmem[offset+x];
-                    if (colors & sys->blink_flip_flop & 0x80) {
-                        // blinking: swap back- and foreground color
-                        colors = ((colors & 7) << 4) | ((colors >> 4) & 7);
-                    }
-                    _z9001_decode_8pixels(dst, pixels, colors);
+    for (size_t y = 0; y < 24; y++, offset += 40) {
+        bool row_changed = false;
+        for (size_t x = 0; x < 40; x++) {
+            const uint8_t chr = vidmem[offset + x];
+            uint8_t colors = 0x70;  // monochrome Z9001
+            if (color) {
+                // KC87 with color module
+                colors = colmem[offset + x];
+                if (colors & sys->blink_flip_flop & 0x80) {
+                    // blinking: swap back- and foreground color
+                    colors = ((colors & 7) << 4) | ((colors >> 4) & 7);
                 }
             }
-            offset += 40;
+            if (!all && (chr == sys->vidmem_shadow[offset + x]) && (colors == sys->colmem_shadow[offset + x])) {
+                continue;
+            }
+            sys->vidmem_shadow[offset + x] = chr;
+            sys->colmem_shadow[offset + x] = colors;
+            row_changed = true;
+            // _z9001_decode_8pixels() does 32-bit writes, the framebuffer position is 8-byte aligned
+            uint8_t* dst = &sys->fb[(y * 8) * Z9001_FRAMEBUFFER_WIDTH + x * 8];
+            for (size_t py = 0; py < 8; py++, dst += Z9001_FRAMEBUFFER_WIDTH) {
+                _z9001_decode_8pixels(dst, font[(chr<<3)|py], colors);
+            }
         }
-    }
-    else {
-        // Z9001 monochrome display
-        const uint8_t* font = sys->rom_font;
-        for (size_t y = 0; y < 24; y++) {
+        if (row_changed) {
             for (size_t py = 0; py < 8; py++) {
-                uint8_t* dst = &sys->fb[(y * 8 + py) * Z9001_FRAMEBUFFER_WIDTH];
-                for (size_t x = 0; x < 40; x++, dst += 8) {
-                    uint8_t chr = vidmem[offset + x];
-                    uint8_t pixels = font[(chr<<3)|py];
-                    _z9001_decode_8pixels(dst, pixels, 0x70);
-                }
+                chips_dirty_lines_set(&sys->dirty_lines, y * 8 + py);
             }
-            offset += 40;
         }
     }
+    sys->vidmem_shadow_valid = true;
 }
 
 uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
+    chips_headless_update(&sys->headless);
     const uint32_t num_ticks = clk_us_to_ticks(_Z9001_FREQUENCY, micro_seconds);
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
@@ -551,15 +589,23 @@ uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds) {
         }
     }
     else {
-        // run with debug hook
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
             pins = _z9001_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
     kbd_update(&sys->kbd, micro_seconds);
-    _z9001_decode_vidmem(sys);
+    if (!sys->headless.skip) {
+        _z9001_decode_vidmem(sys);
+    }
+    chips_vblank_notify(&sys->vblank);
     return num_ticks;
 }
 
@@ -639,9 +685,9 @@ static bool _z9001_load_kcc(z9001_t* sys, chips_range_t data) {
     uint16_t addr = hdr->load_addr_h<<8 | hdr->load_addr_l;
     uint16_t end_addr  = hdr->end_addr_h<<8 | hdr->end_addr_l;
     ptr += sizeof(_z9001_kcc_header);
-    while (addr < end_addr) {
+    if (end_addr > addr) {
         // data is continuous
-        mem_wr(&sys->mem, addr++, *ptr++);
+        mem_write_range(&sys->mem, addr, ptr, end_addr - addr);
     }
     return false;
 }
@@ -695,9 +741,9 @@ static bool _z9001_load_kctap(z9001_t* sys, chips_range_t data) {
     while (addr < end_addr) {
         // each block is 1 lead-byte + 128 bytes data
         ptr++;
-        for (int i = 0; i < 128; i++) {
-            mem_wr(&sys->mem, addr++, *ptr++);
-        }
+        mem_write_range(&sys->mem, addr, ptr, 128);
+        addr += 128;
+        ptr += 128;
     }
     // if file has an exec-address, start the program
     if (hdr->kcc.num_addr > 2) {
@@ -743,6 +789,8 @@ chips_display_info_t z9001_display_info(z9001_t* sys) {
                 .size = Z9001_FRAMEBUFFER_SIZE_BYTES,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
         },
         .screen = {
             .x = 0,
@@ -759,10 +807,23 @@ chips_display_info_t z9001_display_info(z9001_t* sys) {
     return res;
 }
 
+chips_observation_t z9001_observe(z9001_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .display = z9001_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t z9001_save_snapshot(z9001_t* sys, z9001_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     mem_snapshot_onsave(&dst->mem, sys);
     return Z9001_SNAPSHOT_VERSION;
@@ -776,10 +837,36 @@ bool z9001_load_snapshot(z9001_t* sys, uint32_t version, const z9001_t* src) {
     static z9001_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     mem_snapshot_onload(&im.mem, sys);
+    chips_dirty_lines_set_all(&im.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
     *sys = im;
     return true;
 }
 
+uint64_t z9001_state_hash(z9001_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != sys->ram) {
+        mem_track_dirty(&sys->mem, sys->ram, sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->pio1);
+    h = CHIPS_HASH(h, sys->pio2);
+    h = CHIPS_HASH(h, sys->ctc);
+    h = CHIPS_HASH(h, sys->beeper);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->blink_flip_flop);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->ctc_zcto2);
+    h = CHIPS_HASH(h, sys->blink_counter);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return h;
+}
+
 #endif // CHIPS_IMPL
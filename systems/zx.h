@@ -18,6 +18,9 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Optionally define CHIPS_SHARED_ROMS before including zx.h to remove the
+    embedded ROM image arrays from zx_t (see 'Shared ROM Images' below).
+
     You need to include the following headers before including zx.h:
 
     - chips/chips_common.h
@@ -28,6 +31,91 @@
     - chips/kbd.h
     - chips/clk.h
 
+    ## Shared ROM Images
+
+    By default zx_init() copies the ROM images from zx_desc_t.roms into
+    the zx_t struct. When running many emulator instances side by side,
+    set zx_desc_t.shared_roms to true, this maps the ROM pages directly
+    from the caller-owned buffers in zx_desc_t.roms without copying. Those
+    buffers must remain valid and unchanged until the zx_t instance is
+    discarded (and they should be shared between all instances).
+
+    If CHIPS_SHARED_ROMS is defined, the embedded ROM arrays are removed
+    from zx_t altogether and zx_desc_t.shared_roms is implied.
+
+    ## Fast State Copy
+
+    zx_copy_state(dst, src) copies the emulation state of one instance
+    into another without going through an intermediate snapshot, for
+    instance to keep a secondary instance in sync for run-ahead (see
+    util/runahead.h). Both instances must have been initialized with the
+    same zx_desc_t configuration. The ROM images and the framebuffer are
+    not copied, and dst keeps its own debug, headless, turbo, audio and
+    vblank callback setup (so a secondary instance without audio callback
+    stays silent).
+
+    ## Cloning
+
+    zx_clone(dst, tmpl, desc) creates a ready-to-run instance from an
+    initialized template instance (for instance one which has already
+    booted to the BASIC prompt) without calling zx_init() and without
+    emulating the boot process. The template is copied as a whole, and the
+    memory map and ROM pointers are rebased from the template to dst:
+
+    ~~~C
+    static zx_t tmpl;
+    zx_init(&tmpl, &desc);
+    // ...run tmpl until it has reached the BASIC prompt
+    zx_clone(&sys, &tmpl, &(zx_clone_desc_t){
+        .audio_callback = { .func = my_audio_callback, .user_data = my_session },
+    });
+    ~~~
+
+    The debug hook, audio callback and vblank callback are taken from
+    zx_clone_desc_t, dst keeps the template's headless setup and has no
+    raw video log attached.
+    Shared ROM buffers (see 'Shared ROM Images') are shared with the template.
+
+    ## State Hash
+
+    zx_state_hash() returns a hash of the emulation state (CPU, sound
+    chip and keyboard state, ULA state and RAM), for instance to detect
+    desyncs between netplay peers which run the same emulation. The first
+    call starts dirty tracking of RAM writes in zx_t.mem (see
+    mem_track_dirty()), after that only RAM pages which have been written
+    to since the previous call are rehashed.
+
+    ## Observation
+
+    zx_observe() returns a pointer to the RAM banks ("ram", 8 banks of
+    16 KBytes, the ZX Spectrum 48K only uses the first 3), the display
+    info and the z80_t CPU state (see chips_observation_t in
+    chips_common.h). The vblank callback in zx_desc_t (and
+    zx_clone_desc_t) is invoked when the ULA starts a new frame.
+
+    ## Turbo Mode
+
+    zx_set_turbo() switches on turbo mode at run time (see chips_turbo_t
+    in chips_common.h), zx_exec() and zx_exec_frame() then run the given
+    number of time slices or frames, and only the last one produces video
+    and audio output. zx_turbo_speed() returns the speed factor achieved
+    in the last call.
+
+    ## Raw Video Log
+
+    If zx_desc_t.vidlog points to a chips_vidlog_t (see chips_common.h),
+    border color and displayed screen changes are recorded with the beam
+    position (x: tick in the scanline, y: scanline in the frame), and the
+    flash state is part of each frame's start registers. The vram copy of a
+    published frame is one screen of ZX_VIDLOG_SCREEN_SIZE bytes (bitmap and
+    attributes) on the 48K, and the screens in RAM bank 5 and 7 on the
+    ZX128 (so the vram buffer must be at least twice as big).
+
+    zx_vidlog_decode() is a reference decoder which reconstructs the last
+    published frame in the framebuffer layout of zx_t.fb. If the CPU didn't
+    write the displayed screen while the frame was running, the result
+    matches the regular scanline decoder.
+
     ## The ZX Spectrum 48K
 
     TODO!
@@ -69,7 +157,7 @@ extern "C" {
 #endif
 
 // bump this whenever the zx_t struct layout changes
-#define ZX_SNAPSHOT_VERSION (0x0001)
+#define ZX_SNAPSHOT_VERSION (0x0002)
 
 #define ZX_MAX_AUDIO_SAMPLES (1024)      // max number of audio samples in internal sample buffer
 #define ZX_DEFAULT_AUDIO_SAMPLES (128)   // default number of samples in internal sample buffer
@@ -78,6 +166,12 @@ extern "C" {
 #define ZX_FRAMEBUFFER_SIZE_BYTES (ZX_FRAMEBUFFER_WIDTH * ZX_FRAMEBUFFER_HEIGHT)
 #define ZX_DISPLAY_WIDTH (320)
 #define ZX_DISPLAY_HEIGHT (256)
+#define ZX_VIDLOG_SCREEN_SIZE (0x1B00)      // size of one bitmap+attribute screen in the raw video log
+
+// raw video log register numbers (see 'Raw Video Log')
+#define ZX_VIDLOG_REG_BORDER    (0)     // border color (0..7)
+#define ZX_VIDLOG_REG_SCREEN    (1)     // displayed screen in the vram copy (0 or 1, ZX128 only)
+#define ZX_VIDLOG_REG_FLASH     (2)     // 1 if flashing attributes are currently inverted
 
 // ZX Spectrum models
 typedef enum {
@@ -105,6 +199,9 @@ typedef struct {
     zx_type_t type;                     // default is ZX_TYPE_48K
     zx_joystick_type_t joystick_type;   // what joystick to emulate, default is ZX_JOYSTICK_NONE
     chips_debug_t debug;                // optional debugger hook
+    chips_headless_t headless;          // optional headless video mode (see chips_common.h)
+    chips_vidlog_t* vidlog;             // optional raw video log (see 'Raw Video Log')
+    chips_vblank_callback_t vblank;     // optional per-frame callback (see 'Observation')
     struct {
         chips_audio_callback_t callback;
         int num_samples;
@@ -112,6 +209,7 @@ typedef struct {
         float beeper_volume;
         float ay_volume;
     } audio;
+    bool shared_roms;                   // if true, map ROM pages directly from the roms buffers (no copy)
     // ROM images
     struct {
         // ZX Spectrum 48K
@@ -122,6 +220,13 @@ typedef struct {
     } roms;
 } zx_desc_t;
 
+// per-instance host hooks for zx_clone()
+typedef struct {
+    chips_debug_t debug;                    // optional debugging hook
+    chips_audio_callback_t audio_callback;  // optional audio output callback
+    chips_vblank_callback_t vblank;         // optional per-frame callback
+} zx_clone_desc_t;
+
 // ZX emulator state
 typedef struct {
     z80_t cpu;
@@ -136,6 +241,7 @@ typedef struct {
     uint8_t last_mem_config;    // last out to 0x7FFD
     uint8_t last_fe_out;        // last out value to 0xFE port
     uint8_t blink_counter;      // incremented on each vblank
+    uint32_t frame_count;       // incremented on each vblank, used by zx_exec_frame()
     uint8_t border_color;
     int frame_scan_lines;
     int top_border_scanlines;
@@ -144,21 +250,34 @@ typedef struct {
     int scanline_y;
     int int_counter;
     uint32_t display_ram_bank;
+    uint64_t pixel_masks[256];  // bitmap byte => 8 expanded 0x00/0xFF pixel masks
     kbd_t kbd;
     mem_t mem;
     uint64_t pins;
+    uint64_t tick;              // free-running system tick counter (see 'A/V Timestamps' in chips_common.h)
     uint64_t freq_hz;
+    uint64_t frame_us_rem;      // fractional remainder of the ticks-to-us conversion in zx_exec_frame()
     bool valid;
     chips_debug_t debug;
+    chips_headless_t headless;
+    chips_vblank_t vblank;      // per-frame callback (see 'Observation')
+    chips_turbo_t turbo;
+    chips_vidlog_t* vidlog;
     struct {
         chips_audio_callback_t callback;
         int num_samples;
         int sample_pos;
         float sample_buffer[ZX_MAX_AUDIO_SAMPLES];
     } audio;
+    bool shared_roms;               // ROM pages are mapped from caller-owned buffers
+    const uint8_t* rom_ptr[2];      // ROM images, pointing into rom[] or to shared buffers
     uint8_t ram[8][0x4000];
+    #if !defined(CHIPS_SHARED_ROMS)
     uint8_t rom[2][0x4000];
+    #endif
     uint8_t junk[0x4000];
+    chips_page_hashes_t ram_hashes;     // cached RAM page hashes for zx_state_hash()
+    chips_dirty_lines_t dirty_lines;    // framebuffer rows changed since last chips_dirty_lines_clear()
     alignas(64) uint8_t fb[ZX_FRAMEBUFFER_SIZE_BYTES];
 } zx_t;
 
@@ -170,8 +289,16 @@ void zx_discard(zx_t* sys);
 void zx_reset(zx_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t zx_display_info(zx_t* sys);
+// get pointers to the RAM banks, display and CPU state (see 'Observation')
+chips_observation_t zx_observe(zx_t* sys);
 // run ZX Spectrum instance for a given number of microseconds, return number of ticks
 uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds);
+// run ZX Spectrum instance until the end of the current video frame, return number of ticks
+uint32_t zx_exec_frame(zx_t* sys);
+// set the turbo mode speed factor (see 'Turbo Mode'), 0 or 1 to switch turbo mode off
+void zx_set_turbo(zx_t* sys, uint32_t factor);
+// get the achieved speed factor of the last exec call
+float zx_turbo_speed(zx_t* sys);
 // send a key-down event
 void zx_key_down(zx_t* sys, int key_code);
 // send a key-up event
@@ -188,6 +315,14 @@ bool zx_quickload(zx_t* sys, chips_range_t data);
 uint32_t zx_save_snapshot(zx_t* sys, zx_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool zx_load_snapshot(zx_t* sys, uint32_t version, zx_t* src);
+// fast copy of the emulation state into another instance (see 'Fast State Copy')
+void zx_copy_state(zx_t* dst, zx_t* src);
+// create a new instance from an initialized template instance (see 'Cloning')
+void zx_clone(zx_t* dst, const zx_t* tmpl, const zx_clone_desc_t* desc);
+// hash the emulation state (see 'State Hash')
+uint64_t zx_state_hash(zx_t* sys);
+// reference decoder for the last frame published into a raw video log (see 'Raw Video Log')
+void zx_vidlog_decode(zx_type_t type, const chips_vidlog_t* log, uint8_t* fb);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -203,9 +338,18 @@ bool zx_load_snapshot(zx_t* sys, uint32_t version, zx_t* src);
 
 static void _zx_init_memory_map(zx_t* sys);
 static void _zx_init_keyboard_matrix(zx_t* sys);
+static void _zx_init_pixel_masks(zx_t* sys);
 
 #define _ZX_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
+// record a video register write in the optional raw video log
+static inline void _zx_vidlog(zx_t* sys, uint8_t reg, uint8_t val) {
+    if (sys->vidlog) {
+        const uint16_t x = (uint16_t)(sys->scanline_period - sys->scanline_counter);
+        chips_vidlog_write(sys->vidlog, x, (uint16_t)sys->scanline_y, reg, val);
+    }
+}
+
 #define _ZX_48K_FREQUENCY (3500000)
 #define _ZX_128_FREQUENCY (3546894)
 
@@ -222,14 +366,18 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
     sys->audio.num_samples = _ZX_DEFAULT(desc->audio.num_samples, ZX_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= ZX_MAX_AUDIO_SAMPLES);
     sys->debug = desc->debug;
+    sys->vblank.callback = desc->vblank;
+    sys->headless = desc->headless;
+    sys->vidlog = desc->vidlog;
+    chips_dirty_lines_set_all(&sys->dirty_lines);
 
     // initalize the hardware
     sys->border_color = 0;
     if (ZX_TYPE_128 == sys->type) {
         CHIPS_ASSERT(desc->roms.zx128_0.ptr && (desc->roms.zx128_0.size == 0x4000));
         CHIPS_ASSERT(desc->roms.zx128_1.ptr && (desc->roms.zx128_1.size == 0x4000));
-        memcpy(sys->rom[0], desc->roms.zx128_0.ptr, 0x4000);
-        memcpy(sys->rom[1], desc->roms.zx128_1.ptr, 0x4000);
+        sys->rom_ptr[0] = (const uint8_t*) desc->roms.zx128_0.ptr;
+        sys->rom_ptr[1] = (const uint8_t*) desc->roms.zx128_1.ptr;
         sys->display_ram_bank = 5;
         sys->frame_scan_lines = 311;
         sys->top_border_scanlines = 63;
@@ -237,12 +385,25 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
     }
     else {
         CHIPS_ASSERT(desc->roms.zx48k.ptr && (desc->roms.zx48k.size == 0x4000));
-        memcpy(sys->rom[0], desc->roms.zx48k.ptr, 0x4000);
+        sys->rom_ptr[0] = (const uint8_t*) desc->roms.zx48k.ptr;
         sys->display_ram_bank = 0;
         sys->frame_scan_lines = 312;
         sys->top_border_scanlines = 64;
         sys->scanline_period = 224;
     }
+    #if defined(CHIPS_SHARED_ROMS)
+    sys->shared_roms = true;
+    #else
+    sys->shared_roms = desc->shared_roms;
+    if (!sys->shared_roms) {
+        for (int i = 0; i < 2; i++) {
+            if (sys->rom_ptr[i]) {
+                memcpy(sys->rom[i], sys->rom_ptr[i], 0x4000);
+                sys->rom_ptr[i] = sys->rom[i];
+            }
+        }
+    }
+    #endif
     sys->scanline_counter = sys->scanline_period;
 
     sys->pins = z80_init(&sys->cpu);
@@ -258,11 +419,22 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
             .type = AY38910_TYPE_8912,
             .tick_hz = (int)sys->freq_hz / 2,
             .sound_hz = audio_hz,
-            .magnitude = _ZX_DEFAULT(desc->audio.ay_volume, 0.5f)
+            .magnitude = _ZX_DEFAULT(desc->audio.ay_volume, 0.5f),
+            .lazy = true
         });
     }
     _zx_init_memory_map(sys);
     _zx_init_keyboard_matrix(sys);
+    _zx_init_pixel_masks(sys);
+    if (sys->vidlog) {
+        if (ZX_TYPE_128 == sys->type) {
+            chips_vidlog_set_range(sys->vidlog, 0, sys->ram[5], ZX_VIDLOG_SCREEN_SIZE);
+            chips_vidlog_set_range(sys->vidlog, 1, sys->ram[7], ZX_VIDLOG_SCREEN_SIZE);
+        }
+        else {
+            chips_vidlog_set_range(sys->vidlog, 0, sys->ram[0], ZX_VIDLOG_SCREEN_SIZE);
+        }
+    }
 }
 
 void zx_discard(zx_t* sys) {
@@ -291,6 +463,8 @@ void zx_reset(zx_t* sys) {
         sys->display_ram_bank = 5;
     }
     _zx_init_memory_map(sys);
+    _zx_vidlog(sys, ZX_VIDLOG_REG_SCREEN, (sys->display_ram_bank == 7) ? 1 : 0);
+    _zx_vidlog(sys, ZX_VIDLOG_REG_FLASH, 0);
 }
 
 static bool _zx_decode_scanline(zx_t* sys) {
@@ -314,16 +488,16 @@ static bool _zx_decode_scanline(zx_t* sys) {
     */
     const int top_decode_line = sys->top_border_scanlines - 32;
     const int btm_decode_line = sys->top_border_scanlines + 192 + 32;
-    if ((sys->scanline_y >= top_decode_line) && (sys->scanline_y < btm_decode_line)) {
+    if (!sys->headless.skip && (sys->scanline_y >= top_decode_line) && (sys->scanline_y < btm_decode_line)) {
         const uint16_t y = sys->scanline_y - top_decode_line;
-        uint8_t* dst = &sys->fb[y * ZX_FRAMEBUFFER_WIDTH];
+        // decode into a line buffer first, so that unchanged rows aren't marked dirty
+        uint8_t line[ZX_DISPLAY_WIDTH];
+        uint8_t* dst = line;
         const uint8_t* vidmem_bank = sys->ram[sys->display_ram_bank];
         const bool blink = 0 != (sys->blink_counter & 0x10);
         if ((y < 32) || (y >= 224)) {
             // upper/lower border
-            for (int x = 0; x < ZX_DISPLAY_WIDTH; x++) {
-                *dst++ = sys->border_color;
-            }
+            memset(dst, sys->border_color, ZX_DISPLAY_WIDTH);
         }
         else {
             /* compute video memory Y offset (inside 256x192 area)
@@ -335,18 +509,21 @@ static bool _zx_decode_scanline(zx_t* sys) {
             const uint16_t y_offset = ((yy & 0xC0)<<5) | ((yy & 0x07)<<8) | ((yy & 0x38)<<2);
 
             // left border
-            for (int x = 0; x < (4*8); x++) {
-                *dst++ = sys->border_color;
-            }
-
-            // valid 256x192 vidmem area
-            for (uint16_t x = 0; x < 32; x++) {
-                const uint16_t pix_offset = y_offset | x;
-                const uint16_t clr_offset = 0x1800 + (((yy & ~0x7)<<2) | x);
+            memset(dst, sys->border_color, 4*8);
+            dst += 4*8;
 
+            /* valid 256x192 vidmem area, the 8 pixels of a bitmap byte are
+                expanded through a 0x00/0xFF mask table and blended with the
+                replicated ink and paper colors, which writes one 8-pixel
+                group at a time
+            */
+            const uint64_t splat = 0x0101010101010101ULL;
+            const uint8_t* pix_ptr = &vidmem_bank[y_offset];
+            const uint8_t* clr_ptr = &vidmem_bank[0x1800 + ((yy & ~0x7)<<2)];
+            for (uint16_t x = 0; x < 32; x++, dst += 8) {
                 // pixel mask and color attribute bytes
-                const uint8_t pix = vidmem_bank[pix_offset];
-                const uint8_t clr = vidmem_bank[clr_offset];
+                const uint8_t pix = pix_ptr[x];
+                const uint8_t clr = clr_ptr[x];
 
                 // foreground and background color
                 uint8_t fg, bg;
@@ -362,22 +539,28 @@ static bool _zx_decode_scanline(zx_t* sys) {
                 fg |= (clr & (1<<6)) >> 3;
                 bg |= (clr & (1<<6)) >> 3;
 
-                for (int px = 7; px >=0; px--) {
-                    *dst++ = pix & (1<<px) ? fg : bg;
-                }
+                const uint64_t mask = sys->pixel_masks[pix];
+                const uint64_t pixels = ((fg * splat) & mask) | ((bg * splat) & ~mask);
+                memcpy(dst, &pixels, 8);
             }
 
             // right border
-            for (int x = 0; x < (4*8); x++) {
-                *dst++ = sys->border_color;
-            }
+            memset(dst, sys->border_color, 4*8);
         }
+        chips_dirty_lines_copy(&sys->dirty_lines, y, &sys->fb[y * ZX_FRAMEBUFFER_WIDTH], line, sizeof(line));
     }
 
     if (sys->scanline_y++ >= sys->frame_scan_lines) {
         // start new frame, request vblank interrupt
         sys->scanline_y = 0;
         sys->blink_counter++;
+        sys->frame_count++;
+        if (sys->vidlog) {
+            // the flash state only changes between frames, so it isn't recorded as an event
+            sys->vidlog->regs[ZX_VIDLOG_REG_FLASH] = (sys->blink_counter & 0x10) ? 1 : 0;
+            chips_vidlog_publish(sys->vidlog);
+        }
+        chips_vblank_notify(&sys->vblank);
         return true;
     }
     else {
@@ -391,17 +574,18 @@ static void _zx_update_memory_map_zx128(zx_t* sys, uint8_t data) {
         sys->last_mem_config = data;
         // bit 3 defines the video scanout memory bank (5 or 7)
         sys->display_ram_bank = (data & (1<<3)) ? 7 : 5;
+        _zx_vidlog(sys, ZX_VIDLOG_REG_SCREEN, (data & (1<<3)) ? 1 : 0);
         // only last memory bank is mappable
         mem_map_ram(&sys->mem, 0, 0xC000, 0x4000, sys->ram[data & 0x7]);
 
         // ROM0 or ROM1
         if (data & (1<<4)) {
             // bit 4 set: ROM1
-            mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom[1]);
+            mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom_ptr[1]);
         }
         else {
             // bit 4 clear: ROM0
-            mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom[0]);
+            mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom_ptr[0]);
         }
     }
     if (data & (1<<5)) {
@@ -413,7 +597,24 @@ static void _zx_update_memory_map_zx128(zx_t* sys, uint8_t data) {
     }
 }
 
+// tick the AY and beeper, and forward audio samples
+static inline void _zx_tick_audio(zx_t* sys) {
+    // tick the AY at half frequency, use the buffered chip select
+    // pin mask so that the AY doesn't miss any IO requests
+    if (++sys->tick_count & 1) {
+        ay38910_tick(&sys->ay);
+    }
+
+    // tick the beeper
+    if (beeper_tick(&sys->beeper) && !sys->turbo.skip) {
+        // new sample ready (if this is not a ZX128, sys->ay.sample will be 0)
+        const float sample = sys->beeper.sample + sys->ay.sample;
+        chips_audio_put(&sys->audio.callback, sys->audio.sample_buffer, sys->audio.num_samples, &sys->audio.sample_pos, sample, sys->tick);
+    }
+}
+
 static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
+    sys->tick++;
     pins = z80_tick(&sys->cpu, pins);
 
     // video decoding and vblank interrupt
@@ -469,6 +670,7 @@ static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
                 // FIXME: bit 3: MIC output (CAS SAVE, 0=On, 1=Off)
                 const uint8_t data = Z80_GET_DATA(pins);
                 sys->border_color = data & 7;
+                _zx_vidlog(sys, ZX_VIDLOG_REG_BORDER, sys->border_color);
                 sys->last_fe_out = data;
                 beeper_set(&sys->beeper, 0 != (data & (1<<4)));
             }
@@ -491,49 +693,124 @@ static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
         }
     }
 
-    // tick the AY at half frequency, use the buffered chip select
-    // pin mask so that the AY doesn't miss any IO requests
-    if (++sys->tick_count & 1) {
-        ay38910_tick(&sys->ay);
-    }
+    _zx_tick_audio(sys);
+    return pins;
+}
 
-    // tick the beeper
-    if (beeper_tick(&sys->beeper)) {
-        // new sample ready (if this is not a ZX128, sys->ay.sample will be 0)
-        const float sample = sys->beeper.sample + sys->ay.sample;
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
-            sys->audio.sample_pos = 0;
+// fast-forward while the CPU is in HALT, returns number of skipped ticks
+static uint32_t _zx_skip_halt(zx_t* sys, uint64_t pins, uint32_t max_ticks) {
+    // the only interrupt source is the vblank interrupt which can only
+    // be requested at a scanline boundary, so it's safe to fast-forward
+    // the CPU up to the tick before the next scanline starts
+    if ((pins & (Z80_HALT|Z80_INT)) != Z80_HALT) {
+        return 0;
+    }
+    const uint32_t scanline_ticks = (uint32_t)(sys->scanline_counter - 1);
+    const uint32_t num_ticks = z80_skip_halt(&sys->cpu, (max_ticks < scanline_ticks) ? max_ticks : scanline_ticks);
+    if (num_ticks > 0) {
+        sys->scanline_counter -= (int)num_ticks;
+        for (uint32_t i = 0; i < num_ticks; i++) {
+            sys->tick++;
+            _zx_tick_audio(sys);
         }
     }
-    return pins;
+    return num_ticks;
 }
 
-uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds) {
-    CHIPS_ASSERT(sys && sys->valid);
-    const uint32_t num_ticks = clk_us_to_ticks(sys->freq_hz, micro_seconds);
+// run for num_ticks, or until the end of the current video frame if to_frame_end is true
+static uint32_t _zx_run(zx_t* sys, uint32_t num_ticks, bool to_frame_end) {
+    const uint32_t frame_count = sys->frame_count;
     uint64_t pins = sys->pins;
+    uint32_t tick = 0;
     if (0 == sys->debug.callback.func) {
-        // run without debug hook
-        for (uint32_t tick = 0; tick < num_ticks; tick++) {
-            pins = _zx_tick(sys, pins);
+        // run without debug hook, fast-forward while the CPU is halted
+        while ((tick < num_ticks) && (!to_frame_end || (frame_count == sys->frame_count))) {
+            const uint32_t skipped_ticks = _zx_skip_halt(sys, pins, num_ticks - tick);
+            if (skipped_ticks > 0) {
+                tick += skipped_ticks;
+            }
+            else {
+                pins = _zx_tick(sys, pins);
+                tick++;
+            }
         }
     }
     else {
-        // run with debug hook
-        for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
+        // run with debug hook, if a breakpoint map is attached, only
+        // call the debug hook when a breakpoint is hit
+        const chips_breakmap_t* map = sys->debug.breakmap;
+        for (; (tick < num_ticks) && (!to_frame_end || (frame_count == sys->frame_count)) && !(*sys->debug.stopped); tick++) {
             pins = _zx_tick(sys, pins);
-            sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            if (!map || chips_breakmap_hit(map, Z80_GET_ADDR(pins), z80_opdone(&sys->cpu),
+                (pins & (Z80_MREQ|Z80_RD)) == (Z80_MREQ|Z80_RD), (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR))) {
+                sys->debug.callback.func(sys->debug.callback.user_data, pins);
+            }
         }
     }
     sys->pins = pins;
+    return tick;
+}
+
+// run one slice of zx_exec() or one video frame of zx_exec_frame()
+static uint32_t _zx_exec_slice(zx_t* sys, uint32_t micro_seconds, bool frame) {
+    sys->ay.silent = sys->turbo.skip;
+    sys->beeper.silent = sys->turbo.skip;
+    if (sys->turbo.skip) {
+        sys->headless.skip = true;
+    }
+    else {
+        chips_headless_update(&sys->headless);
+    }
+    uint32_t num_ticks;
+    if (frame) {
+        // safety limit of two frames (a frame is frame_scan_lines+1 scanlines)
+        const uint32_t max_ticks = (uint32_t)(2 * (sys->frame_scan_lines + 1) * sys->scanline_period);
+        num_ticks = _zx_run(sys, max_ticks, true);
+        micro_seconds = clk_ticks_to_us(sys->freq_hz, num_ticks, &sys->frame_us_rem);
+    }
+    else {
+        num_ticks = clk_us_to_ticks(sys->freq_hz, micro_seconds);
+        _zx_run(sys, num_ticks, false);
+    }
     kbd_update(&sys->kbd, micro_seconds);
     return num_ticks;
 }
 
+// run all turbo mode slices (just one if turbo mode is off)
+static uint32_t _zx_exec(zx_t* sys, uint32_t micro_seconds, bool frame) {
+    const uint32_t num_slices = chips_turbo_slices(&sys->turbo);
+    uint32_t num_ticks = 0;
+    for (uint32_t i = 0; (i < num_slices) && ((0 == i) || !(sys->debug.stopped && *sys->debug.stopped)); i++) {
+        sys->turbo.skip = (i + 1) < num_slices;
+        num_ticks += _zx_exec_slice(sys, micro_seconds, frame);
+    }
+    const uint32_t requested_ticks = frame ?
+        (uint32_t)((sys->frame_scan_lines + 1) * sys->scanline_period) :
+        clk_us_to_ticks(sys->freq_hz, micro_seconds);
+    chips_turbo_done(&sys->turbo, num_ticks, requested_ticks);
+    return num_ticks;
+}
+
+uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return _zx_exec(sys, micro_seconds, false);
+}
+
+uint32_t zx_exec_frame(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return _zx_exec(sys, 0, true);
+}
+
+void zx_set_turbo(zx_t* sys, uint32_t factor) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->turbo.factor = factor;
+}
+
+float zx_turbo_speed(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->turbo.speed;
+}
+
 void zx_key_down(zx_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     switch (sys->joystick_type) {
@@ -665,13 +942,24 @@ static void _zx_init_memory_map(zx_t* sys) {
         mem_map_ram(&sys->mem, 0, 0x4000, 0x4000, sys->ram[5]);
         mem_map_ram(&sys->mem, 0, 0x8000, 0x4000, sys->ram[2]);
         mem_map_ram(&sys->mem, 0, 0xC000, 0x4000, sys->ram[0]);
-        mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom[0]);
+        mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom_ptr[0]);
     }
     else {
         mem_map_ram(&sys->mem, 0, 0x4000, 0x4000, sys->ram[0]);
         mem_map_ram(&sys->mem, 0, 0x8000, 0x4000, sys->ram[1]);
         mem_map_ram(&sys->mem, 0, 0xC000, 0x4000, sys->ram[2]);
-        mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom[0]);
+        mem_map_rom(&sys->mem, 0, 0x0000, 0x4000, sys->rom_ptr[0]);
+    }
+}
+
+// expand each bitmap byte into 8 mask bytes, leftmost pixel (bit 7) first in memory
+static void _zx_init_pixel_masks(zx_t* sys) {
+    for (int pix = 0; pix < 256; pix++) {
+        uint8_t mask[8];
+        for (int px = 0; px < 8; px++) {
+            mask[px] = (pix & (0x80>>px)) ? 0xFF : 0x00;
+        }
+        memcpy(&sys->pixel_masks[pix], mask, sizeof(mask));
     }
 }
 
@@ -796,6 +1084,8 @@ static bool _zx_overflow(const uint8_t* ptr, intptr_t num_bytes, const uint8_t*
 
 bool zx_quickload(zx_t* sys, chips_range_t data) {
     CHIPS_ASSERT(data.ptr && (data.size > 0));
+    // RAM is written directly, bypassing dirty tracking
+    chips_page_hashes_invalidate(&sys->ram_hashes);
     uint8_t* ptr = data.ptr;
     const uint8_t* end_ptr = ptr + data.size;
     if (_zx_overflow(ptr, sizeof(_zx_z80_header), end_ptr)) {
@@ -947,6 +1237,7 @@ bool zx_quickload(zx_t* sys, chips_range_t data) {
         sys->pins = z80_prefetch(&sys->cpu, (hdr->PC_h<<8)|hdr->PC_l);
     }
     sys->border_color = (hdr->flags0>>1) & 7;
+    _zx_vidlog(sys, ZX_VIDLOG_REG_BORDER, sys->border_color);
     return true;
 }
 
@@ -980,6 +1271,8 @@ chips_display_info_t zx_display_info(zx_t* sys) {
                 .size = ZX_FRAMEBUFFER_SIZE_BYTES,
             },
             .bytes_per_pixel = 1,
+            .tick = sys ? sys->tick : 0,
+            .dirty_lines = sys ? &sys->dirty_lines : 0,
         },
         .screen = {
             .x = 0,
@@ -996,13 +1289,29 @@ chips_display_info_t zx_display_info(zx_t* sys) {
     return res;
 }
 
+chips_observation_t zx_observe(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return (chips_observation_t){
+        .num_ram = 1,
+        .ram = {
+            { .name = "ram", .mem = { .ptr = sys->ram, .size = sizeof(sys->ram) } },
+        },
+        .display = zx_display_info(sys),
+        .cpu = { .type = CHIPS_OBSERVE_CPU_Z80, .state = &sys->cpu },
+    };
+}
+
 uint32_t zx_save_snapshot(zx_t* sys, zx_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
+    chips_vblank_snapshot_onsave(&dst->vblank);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
     ay38910_snapshot_onsave(&dst->ay);
-    mem_snapshot_onsave(&dst->mem, sys);
+    dst->vidlog = 0;
+    const mem_ext_range_t roms[2] = { { sys->rom_ptr[0], 0x4000 }, { sys->rom_ptr[1], 0x4000 } };
+    mem_snapshot_onsave_ext(&dst->mem, sys, roms, 2);
+    dst->rom_ptr[0] = dst->rom_ptr[1] = 0;
     return ZX_SNAPSHOT_VERSION;
 }
 
@@ -1014,11 +1323,159 @@ bool zx_load_snapshot(zx_t* sys, uint32_t version, zx_t* src) {
     static zx_t im;
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
+    chips_vblank_snapshot_onload(&im.vblank, &sys->vblank);
+    im.headless = sys->headless;
+    im.turbo = sys->turbo;
+    im.vidlog = sys->vidlog;
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     ay38910_snapshot_onload(&im.ay, &sys->ay);
-    mem_snapshot_onload(&im.mem, sys);
+    const mem_ext_range_t roms[2] = { { sys->rom_ptr[0], 0x4000 }, { sys->rom_ptr[1], 0x4000 } };
+    mem_snapshot_onload_ext(&im.mem, sys, roms, 2);
+    im.shared_roms = sys->shared_roms;
+    im.rom_ptr[0] = sys->rom_ptr[0];
+    im.rom_ptr[1] = sys->rom_ptr[1];
+    chips_dirty_lines_set_all(&im.dirty_lines);
+    chips_page_hashes_invalidate(&im.ram_hashes);
     *sys = im;
     return true;
 }
 
+void zx_vidlog_decode(zx_type_t type, const chips_vidlog_t* log, uint8_t* fb) {
+    CHIPS_ASSERT(log && log->vram.ptr && fb);
+    const chips_vidlog_frame_t* frame = chips_vidlog_last(log);
+    if (0 == frame) {
+        return;
+    }
+    // same decode window as _zx_decode_scanline()
+    const int top_decode_line = ((ZX_TYPE_128 == type) ? 63 : 64) - 32;
+    uint8_t border = frame->regs[ZX_VIDLOG_REG_BORDER];
+    uint8_t screen = frame->regs[ZX_VIDLOG_REG_SCREEN];
+    uint8_t flash = frame->regs[ZX_VIDLOG_REG_FLASH];
+    uint32_t ev_index = 0;
+    for (int y = 0; y < ZX_DISPLAY_HEIGHT; y++) {
+        // apply all register writes which happened before the scanline was decoded
+        const int scanline = top_decode_line + y;
+        while ((ev_index < frame->num_events) && (frame->events[ev_index].y <= scanline)) {
+            const chips_vidlog_event_t* ev = &frame->events[ev_index++];
+            switch (ev->reg) {
+                case ZX_VIDLOG_REG_BORDER: border = ev->val; break;
+                case ZX_VIDLOG_REG_SCREEN: screen = ev->val; break;
+                case ZX_VIDLOG_REG_FLASH:  flash = ev->val; break;
+                default: break;
+            }
+        }
+        uint8_t* dst = &fb[y * ZX_FRAMEBUFFER_WIDTH];
+        if ((y < 32) || (y >= 224)) {
+            memset(dst, border, ZX_DISPLAY_WIDTH);
+            continue;
+        }
+        const size_t screen_offset = (ZX_TYPE_128 == type) ? (screen & 1) * ZX_VIDLOG_SCREEN_SIZE : 0;
+        CHIPS_ASSERT(log->vram.size >= (screen_offset + ZX_VIDLOG_SCREEN_SIZE));
+        const uint8_t* vidmem = (const uint8_t*)log->vram.ptr + screen_offset;
+        const int yy = y - 32;
+        const uint8_t* pix_ptr = &vidmem[((yy & 0xC0)<<5) | ((yy & 0x07)<<8) | ((yy & 0x38)<<2)];
+        const uint8_t* clr_ptr = &vidmem[0x1800 + ((yy & ~0x7)<<2)];
+        memset(dst, border, 4*8);
+        dst += 4*8;
+        for (int x = 0; x < 32; x++) {
+            const uint8_t pix = pix_ptr[x];
+            const uint8_t clr = clr_ptr[x];
+            const bool inv = (clr & (1<<7)) && flash;
+            const uint8_t bright = (clr & (1<<6)) >> 3;
+            const uint8_t fg = (inv ? ((clr>>3) & 7) : (clr & 7)) | bright;
+            const uint8_t bg = (inv ? (clr & 7) : ((clr>>3) & 7)) | bright;
+            for (int bit = 7; bit >= 0; bit--) {
+                *dst++ = (pix & (1<<bit)) ? fg : bg;
+            }
+        }
+        memset(dst, border, 4*8);
+    }
+}
+
+void zx_copy_state(zx_t* dst, zx_t* src) {
+    CHIPS_ASSERT(dst && dst->valid && src && src->valid && (dst != src));
+    CHIPS_ASSERT(dst->type == src->type);
+    const chips_debug_t debug = dst->debug;
+    const chips_headless_t headless = dst->headless;
+    const chips_turbo_t turbo = dst->turbo;
+    chips_vidlog_t* vidlog = dst->vidlog;
+    const chips_audio_callback_t audio_callback = dst->audio.callback;
+    const chips_vblank_callback_t vblank = dst->vblank.callback;
+    ay38910_t ay = dst->ay;
+    // everything up to the ROM pointers, and the RAM banks
+    memcpy(dst, src, offsetof(zx_t, shared_roms));
+    memcpy(dst->ram, src->ram, sizeof(dst->ram));
+    dst->debug = debug;
+    dst->headless = headless;
+    dst->turbo = turbo;
+    dst->vidlog = vidlog;
+    dst->audio.callback = audio_callback;
+    dst->vblank.callback = vblank;
+    ay38910_snapshot_onload(&dst->ay, &ay);
+    // rebase the memory map from src to dst
+    const mem_ext_range_t src_roms[2] = { { src->rom_ptr[0], 0x4000 }, { src->rom_ptr[1], 0x4000 } };
+    const mem_ext_range_t dst_roms[2] = { { dst->rom_ptr[0], 0x4000 }, { dst->rom_ptr[1], 0x4000 } };
+    mem_snapshot_onsave_ext(&dst->mem, src, src_roms, 2);
+    mem_snapshot_onload_ext(&dst->mem, dst, dst_roms, 2);
+    chips_dirty_lines_set_all(&dst->dirty_lines);
+    dst->ram_hashes = src->ram_hashes;
+}
+
+// rebase a pointer into the template instance to the same location in the clone
+static const uint8_t* _zx_clone_ptr(zx_t* dst, const zx_t* tmpl, const uint8_t* ptr) {
+    const uint8_t* base = (const uint8_t*) tmpl;
+    if ((ptr >= base) && (ptr < (base + sizeof(zx_t)))) {
+        return ((const uint8_t*)dst) + (ptr - base);
+    }
+    return ptr;
+}
+
+void zx_clone(zx_t* dst, const zx_t* tmpl, const zx_clone_desc_t* desc) {
+    CHIPS_ASSERT(dst && tmpl && tmpl->valid && desc && (dst != tmpl));
+    if (desc->debug.callback.func) { CHIPS_ASSERT(desc->debug.stopped); }
+    memcpy(dst, tmpl, sizeof(zx_t));
+    dst->debug = desc->debug;
+    dst->audio.callback = desc->audio_callback;
+    dst->vblank.callback = desc->vblank;
+    dst->vidlog = 0;
+    // rebase the ROM pointers and memory map (shared ROM buffers stay in place)
+    dst->rom_ptr[0] = _zx_clone_ptr(dst, tmpl, tmpl->rom_ptr[0]);
+    dst->rom_ptr[1] = _zx_clone_ptr(dst, tmpl, tmpl->rom_ptr[1]);
+    const mem_ext_range_t tmpl_roms[2] = { { tmpl->rom_ptr[0], 0x4000 }, { tmpl->rom_ptr[1], 0x4000 } };
+    const mem_ext_range_t dst_roms[2] = { { dst->rom_ptr[0], 0x4000 }, { dst->rom_ptr[1], 0x4000 } };
+    mem_snapshot_onsave_ext(&dst->mem, (void*)tmpl, tmpl_roms, 2);
+    mem_snapshot_onload_ext(&dst->mem, dst, dst_roms, 2);
+    chips_dirty_lines_set_all(&dst->dirty_lines);
+}
+
+uint64_t zx_state_hash(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->mem.dirty.base != &sys->ram[0][0]) {
+        mem_track_dirty(&sys->mem, &sys->ram[0][0], sizeof(sys->ram));
+        chips_page_hashes_invalidate(&sys->ram_hashes);
+    }
+    uint64_t h = CHIPS_HASH_SEED;
+    h = CHIPS_HASH(h, sys->cpu);
+    h = CHIPS_HASH(h, sys->beeper);
+    h = ay38910_hash(&sys->ay, h);
+    h = CHIPS_HASH(h, sys->kbd);
+    h = CHIPS_HASH(h, sys->pins);
+    h = CHIPS_HASH(h, sys->memory_paging_disabled);
+    h = CHIPS_HASH(h, sys->kbd_joymask);
+    h = CHIPS_HASH(h, sys->joy_joymask);
+    h = CHIPS_HASH(h, sys->tick_count);
+    h = CHIPS_HASH(h, sys->last_mem_config);
+    h = CHIPS_HASH(h, sys->last_fe_out);
+    h = CHIPS_HASH(h, sys->blink_counter);
+    h = CHIPS_HASH(h, sys->frame_count);
+    h = CHIPS_HASH(h, sys->border_color);
+    h = CHIPS_HASH(h, sys->scanline_counter);
+    h = CHIPS_HASH(h, sys->scanline_y);
+    h = CHIPS_HASH(h, sys->int_counter);
+    h = CHIPS_HASH(h, sys->display_ram_bank);
+    h = chips_page_hashes_update(&sys->ram_hashes, h, sys->ram, sizeof(sys->ram), sys->mem.dirty.bits);
+    mem_clear_dirty(&sys->mem);
+    return h;
+}
+
 #endif // CHIPS_IMPL
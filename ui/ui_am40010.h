@@ -20,6 +20,7 @@
 
     Include the following headers before the including the *declaration*:
         - am40010.h
+        - ui_util.h
         - ui_chip.h
 
     Include the following headers before including the *implementation*:
@@ -31,6 +32,10 @@
     All string data provided to the ui_am40010_init() must remain alive until
     until ui_am40010_discard() is called!
 
+    To draw the window on a separate UI thread, enable state capture with
+    ui_am40010_set_capture() and call ui_am40010_capture() on the emulation
+    thread after each *_exec() (see 'State Capture' in ui_util.h).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -76,11 +81,17 @@ typedef struct ui_am40010_t {
     bool open;
     bool valid;
     ui_chip_t chip;
+    ui_util_capture_t capture;
+    am40010_t capture_buf[3];
 } ui_am40010_t;
 
 void ui_am40010_init(ui_am40010_t* win, ui_am40010_desc_t* desc);
 void ui_am40010_discard(ui_am40010_t* win);
 void ui_am40010_draw(ui_am40010_t* win);
+/* enable state capture with a capture interval, 0 disables (see 'State Capture' in ui_util.h) */
+void ui_am40010_set_capture(ui_am40010_t* win, int interval);
+/* emulation thread: capture the gate array state */
+void ui_am40010_capture(ui_am40010_t* win);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -118,9 +129,22 @@ void ui_am40010_discard(ui_am40010_t* win) {
     win->valid = false;
 }
 
-static void _ui_am40010_draw_hw_colors(ui_am40010_t* win) {
+void ui_am40010_set_capture(ui_am40010_t* win, int interval) {
+    CHIPS_ASSERT(win && win->valid);
+    ui_util_capture_init(&win->capture, &win->capture_buf[0], &win->capture_buf[1], &win->capture_buf[2], sizeof(am40010_t), win->am40010, interval);
+}
+
+void ui_am40010_capture(ui_am40010_t* win) {
+    CHIPS_ASSERT(win && win->valid);
+    void* buf = ui_util_capture_begin(&win->capture, win->open);
+    if (buf) {
+        memcpy(buf, win->am40010, sizeof(am40010_t));
+        ui_util_capture_end(&win->capture);
+    }
+}
+
+static void _ui_am40010_draw_hw_colors(const am40010_t* ga) {
     ImGui::Text("Hardware Colors:");
-    const am40010_t* ga = win->am40010;
     const ImVec2 size(18,18);
     for (int i = 0; i < 32; i++) {
         ImGui::PushID(i);
@@ -132,8 +156,7 @@ static void _ui_am40010_draw_hw_colors(ui_am40010_t* win) {
     }
 }
 
-static void _ui_am40010_draw_ink_colors(ui_am40010_t* win) {
-    am40010_t* ga = win->am40010;
+static void _ui_am40010_draw_ink_colors(const am40010_t* ga) {
     ImGui::Text("Ink Colors:");
     const ImVec2 size(18,18);
     for (int i = 0; i < 16; i++) {
@@ -146,15 +169,14 @@ static void _ui_am40010_draw_ink_colors(ui_am40010_t* win) {
     }
 }
 
-static void _ui_am40010_draw_border_color(ui_am40010_t* win) {
-    am40010_t* ga = win->am40010;
+static void _ui_am40010_draw_border_color(const am40010_t* ga) {
     ImGui::Text("Border Color:");
     const ImVec2 size(18,18);
     ImGui::ColorButton("##brd_color", ImColor(ga->hw_colors[ga->regs.border]), ImGuiColorEditFlags_NoAlpha, size);
 }
 
-static void _ui_am40010_draw_registers(ui_am40010_t* win) {
-    am40010_registers_t* r = &win->am40010->regs;
+static void _ui_am40010_draw_registers(const am40010_t* ga) {
+    const am40010_registers_t* r = &ga->regs;
     ImGui::Text("INKSEL %02X", r->inksel);
     ImGui::Text("BORDER %02X", r->border);
     ImGui::Text("INK   "); ImGui::SameLine();
@@ -174,8 +196,8 @@ static void _ui_am40010_draw_registers(ui_am40010_t* win) {
     ImGui::Text("  IRQRes   %s", (r->config & AM40010_CONFIG_IRQRESET) ? "ON":"OFF");
 }
 
-static void _ui_am40010_draw_sync_irq(ui_am40010_t* win) {
-    am40010_video_t* v = &win->am40010->video;
+static void _ui_am40010_draw_sync_irq(const am40010_t* ga) {
+    const am40010_video_t* v = &ga->video;
     ImGui::Text("Mode    %d", v->mode);
     ImGui::Text("IntCnt  %02X", v->intcnt);
     ImGui::Text("HSCount %02X", v->hscount);
@@ -184,9 +206,9 @@ static void _ui_am40010_draw_sync_irq(ui_am40010_t* win) {
     ImGui::Text("IRQ     %s", v->intr ? "ON":"OFF");
 }
 
-static void _ui_am40010_draw_video(ui_am40010_t* win) {
-    am40010_crt_t* crt = &win->am40010->crt;
-    uint64_t crtc_pins = win->am40010->crtc_pins;
+static void _ui_am40010_draw_video(const am40010_t* ga) {
+    const am40010_crt_t* crt = &ga->crt;
+    uint64_t crtc_pins = ga->crtc_pins;
     ImGui::Text("h_pos %X", crt->h_pos);
     ImGui::Text("v_pos %X", crt->v_pos);
     const uint16_t addr = ((crtc_pins & 0x3000) << 2) |     /* MA13,MA12 */
@@ -195,21 +217,22 @@ static void _ui_am40010_draw_video(ui_am40010_t* win) {
     ImGui::Text("addr  %04X", addr);
 }
 
-static void _ui_am40010_draw_state(ui_am40010_t* win) {
+static void _ui_am40010_draw_state(ui_am40010_t* win, const am40010_t* ga) {
+    // the debug visualization flag is written into the live state
     ImGui::Checkbox("Debug Visualization", &win->am40010->dbg_vis);
     if (ImGui::CollapsingHeader("Colors", ImGuiTreeNodeFlags_DefaultOpen)) {
-        _ui_am40010_draw_hw_colors(win);
-        _ui_am40010_draw_ink_colors(win);
-        _ui_am40010_draw_border_color(win);
+        _ui_am40010_draw_hw_colors(ga);
+        _ui_am40010_draw_ink_colors(ga);
+        _ui_am40010_draw_border_color(ga);
     }
     if (ImGui::CollapsingHeader("Registers", ImGuiTreeNodeFlags_DefaultOpen)) {
-        _ui_am40010_draw_registers(win);
+        _ui_am40010_draw_registers(ga);
     }
     if (ImGui::CollapsingHeader("Sync & IRQ", ImGuiTreeNodeFlags_DefaultOpen)) {
-        _ui_am40010_draw_sync_irq(win);
+        _ui_am40010_draw_sync_irq(ga);
     }
     if (ImGui::CollapsingHeader("Display", ImGuiTreeNodeFlags_DefaultOpen)) {
-        _ui_am40010_draw_video(win);
+        _ui_am40010_draw_video(ga);
     }
 }
 
@@ -220,13 +243,15 @@ void ui_am40010_draw(ui_am40010_t* win) {
     }
     ImGui::SetNextWindowPos(ImVec2(win->init_x, win->init_y), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(win->init_w, win->init_h), ImGuiCond_Once);
+    // draw from the captured state if enabled
+    const am40010_t* ga = win->capture.enabled ? (const am40010_t*) ui_util_capture_acquire(&win->capture) : win->am40010;
     if (ImGui::Begin(win->title, &win->open)) {
         ImGui::BeginChild("##chip", ImVec2(176, 0), true);
-        ui_chip_draw(&win->chip, win->am40010->pins);
+        ui_chip_draw(&win->chip, ga->pins);
         ImGui::EndChild();
         ImGui::SameLine();
         ImGui::BeginChild("##state", ImVec2(0, 0), true);
-        _ui_am40010_draw_state(win);
+        _ui_am40010_draw_state(win, ga);
         ImGui::EndChild();
     }
     ImGui::End();
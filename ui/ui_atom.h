@@ -69,6 +69,7 @@ typedef struct {
     ui_atom_boot_cb boot_cb;
     ui_dbg_texture_callbacks_t dbg_texture;     // texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;                // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                    // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;                // snapshot ui setup params
 } ui_atom_desc_t;
 
@@ -348,9 +349,11 @@ void ui_atom_init(ui_atom_t* ui, const ui_atom_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.m6502 = &ui->atom->cpu;
+        desc.tick = &ui->atom->tick;
         desc.read_cb = _ui_atom_mem_read;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->atom;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -468,6 +471,7 @@ void ui_atom_init(ui_atom_t* ui, const ui_atom_desc_t* ui_desc) {
 
 void ui_atom_discard(ui_atom_t* ui) {
     CHIPS_ASSERT(ui && ui->atom);
+    ui_snapshot_discard(&ui->snapshot);
     ui->atom = 0;
     ui_m6502_discard(&ui->cpu);
     ui_m6522_discard(&ui->via);
@@ -506,6 +510,7 @@ chips_debug_t ui_atom_get_debug(ui_atom_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
@@ -18,12 +18,19 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Include the following headers before the including the *declaration*:
+        - ui_util.h
+
     Include the following headers before including the *implementation*:
         - imgui.h
 
     All string data provided to the ui_audio_init() must remain alive until
     until ui_audio_discard() is called!
 
+    To draw the window on a separate UI thread, enable state capture with
+    ui_audio_set_capture() and call ui_audio_capture() on the emulation
+    thread after each *_exec() (see 'State Capture' in ui_util.h).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -49,6 +56,8 @@
 extern "C" {
 #endif
 
+#define UI_AUDIO_MAX_SAMPLES (1024)     /* max number of samples with state capture */
+
 /* setup parameters for ui_ay38910_init()
     NOTE: all string data must remain alive until ui_audio_discard()!
 */
@@ -61,6 +70,12 @@ typedef struct {
     bool open;                  /* initial open state */
 } ui_audio_desc_t;
 
+/* captured state (see ui_audio_set_capture()) */
+typedef struct {
+    int sample_pos;
+    float samples[UI_AUDIO_MAX_SAMPLES];
+} ui_audio_capture_t;
+
 typedef struct {
     const char* title;
     const float* sample_buffer;
@@ -70,11 +85,18 @@ typedef struct {
     uint32_t cursor_color;
     bool open;
     bool valid;
+    ui_util_capture_t capture;
+    ui_audio_capture_t capture_buf[3];
 } ui_audio_t;
 
 void ui_audio_init(ui_audio_t* win, const ui_audio_desc_t* desc);
 void ui_audio_discard(ui_audio_t* win);
+/* draw the window, sample_pos is ignored while state capture is enabled */
 void ui_audio_draw(ui_audio_t* win, int sample_pos);
+/* enable state capture with a capture interval, 0 disables (see 'State Capture' in ui_util.h) */
+void ui_audio_set_capture(ui_audio_t* win, int interval);
+/* emulation thread: capture the sample buffer and current sample position */
+void ui_audio_capture(ui_audio_t* win, int sample_pos);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -114,17 +136,39 @@ void ui_audio_discard(ui_audio_t* win) {
     win->valid = false;
 }
 
+void ui_audio_set_capture(ui_audio_t* win, int interval) {
+    CHIPS_ASSERT(win && win->valid);
+    CHIPS_ASSERT(win->num_samples <= UI_AUDIO_MAX_SAMPLES);
+    ui_util_capture_init(&win->capture, &win->capture_buf[0], &win->capture_buf[1], &win->capture_buf[2], sizeof(ui_audio_capture_t), 0, interval);
+}
+
+void ui_audio_capture(ui_audio_t* win, int sample_pos) {
+    CHIPS_ASSERT(win && win->valid);
+    ui_audio_capture_t* buf = (ui_audio_capture_t*) ui_util_capture_begin(&win->capture, win->open);
+    if (buf) {
+        buf->sample_pos = sample_pos;
+        memcpy(buf->samples, win->sample_buffer, win->num_samples * sizeof(float));
+        ui_util_capture_end(&win->capture);
+    }
+}
+
 void ui_audio_draw(ui_audio_t* win, int sample_pos) {
     CHIPS_ASSERT(win && win->valid && win->title && win->sample_buffer);
     if (!win->open) {
         return;
     }
+    const float* samples = win->sample_buffer;
+    if (win->capture.enabled) {
+        const ui_audio_capture_t* buf = (const ui_audio_capture_t*) ui_util_capture_acquire(&win->capture);
+        samples = buf->samples;
+        sample_pos = buf->sample_pos;
+    }
     ImGui::SetNextWindowPos(ImVec2(win->init_x, win->init_y), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(win->init_w, win->init_h), ImGuiCond_Once);
     if (ImGui::Begin(win->title, &win->open)) {
         ImVec2 pos = ImGui::GetCursorScreenPos();
         ImVec2 area = ImGui::GetContentRegionAvail();
-        ImGui::PlotLines("##samples", win->sample_buffer, win->num_samples, 0, 0, -1.0f, +1.0f, area);
+        ImGui::PlotLines("##samples", samples, win->num_samples, 0, 0, -1.0f, +1.0f, area);
         const ImGuiStyle& style = ImGui::GetStyle();
         float x0 = pos.x + style.FramePadding.x;
         float x1 = pos.x + area.x - style.FramePadding.x;
@@ -120,6 +120,8 @@ void ui_ay38910_discard(ui_ay38910_t* win) {
 
 static void _ui_ay38910_draw_state(ui_ay38910_t* win) {
     ay38910_t* ay = win->ay;
+    // in lazy mode the generator state might lag behind
+    ay38910_sync(ay);
     ImGui::Columns(4, "##ay_channels", false);
     ImGui::SetColumnWidth(0, 96);
     ImGui::SetColumnWidth(1, 40);
@@ -63,6 +63,7 @@ typedef struct {
     bombjack_t* sys;
     ui_dbg_texture_callbacks_t dbg_texture; // texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;            // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                // optional memory for the main CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;
 } ui_bombjack_desc_t;
 
@@ -230,6 +231,7 @@ static void _ui_bombjack_mem_write(int layer, uint16_t addr, uint8_t data, void*
         case _UI_BOMBJACK_MEMLAYER_TILES:
             if (addr < 0x6000) {
                 ui->bj->rom_tiles[addr/0x2000][addr&0x1FFF] = data;
+                ui->bj->bg_cache_valid = false;
             }
             break;
         case _UI_BOMBJACK_MEMLAYER_SPRITES:
@@ -240,6 +242,7 @@ static void _ui_bombjack_mem_write(int layer, uint16_t addr, uint8_t data, void*
         case _UI_BOMBJACK_MEMLAYER_MAPS:
             if (addr < 0x1000) {
                 ui->bj->rom_maps[0][addr] = data;
+                ui->bj->bg_cache_valid = false;
             }
             break;
     }
@@ -258,17 +261,22 @@ void ui_bombjack_init(ui_bombjack_t* ui, const ui_bombjack_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->bj->mainboard.cpu;
+        desc.tick = &ui->bj->mainboard.tick;
         desc.read_cb = _ui_bombjack_mem_read;
         desc.read_layer = _UI_BOMBJACK_MEMLAYER_MAIN;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui;
         ui_dbg_init(&ui->main.dbg, &desc);
         x += dx; desc.x = x;
         y += dy; desc.y = y;
         desc.title = "CPU Debugger (Sound)";
         desc.z80 = &ui->bj->soundboard.cpu;
+        desc.tick = &ui->bj->soundboard.tick;
         desc.read_layer = _UI_BOMBJACK_MEMLAYER_SOUND;
+        desc.trace.ptr = 0;
+        desc.trace.size = 0;
         ui_dbg_init(&ui->sound.dbg, &desc);
     }
     x += dx; y += dy;
@@ -402,6 +410,7 @@ void ui_bombjack_init(ui_bombjack_t* ui, const ui_bombjack_desc_t* ui_desc) {
 
 void ui_bombjack_discard(ui_bombjack_t* ui) {
     CHIPS_ASSERT(ui && ui->bj);
+    ui_snapshot_discard(&ui->snapshot);
     for (int i = 0; i < 24; i++) {
         ui->video.texture_cbs.destroy_cb(ui->video.tex_16x16[i]);
         ui->video.texture_cbs.destroy_cb(ui->video.tex_32x32[i]);
@@ -856,9 +865,11 @@ bombjack_debug_t ui_bombjack_get_debug(ui_bombjack_t* ui) {
     res.mainboard.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.mainboard.callback.user_data = &ui->main.dbg;
     res.mainboard.stopped = &ui->main.dbg.dbg.stopped;
+    res.mainboard.breakmap = &ui->main.dbg.dbg.breakmap;
     res.soundboard.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.soundboard.callback.user_data = &ui->sound.dbg;
     res.soundboard.stopped = &ui->sound.dbg.dbg.stopped;
+    res.soundboard.breakmap = &ui->sound.dbg.dbg.breakmap;
     return res;
 }
 
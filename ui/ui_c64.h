@@ -32,6 +32,7 @@
     - ui_m6569.h
     - ui_m6581.h
     - ui_audio.h
+    - ui_profile.h (only with CHIPS_PROFILE)
     - ui_dasm.h
     - ui_dbg.h
     - ui_memedit.h
@@ -74,6 +75,7 @@ typedef struct {
     ui_dbg_texture_callbacks_t dbg_texture; // texture create/update/destroy callbacks
     ui_dbg_debug_callbacks_t dbg_debug;
     ui_dbg_keys_desc_t dbg_keys;        // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;            // optional memory for the main CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;        // snapshot UI setup params
 } ui_c64_desc_t;
 
@@ -87,6 +89,9 @@ typedef struct {
     ui_m6581_t sid;
     ui_m6569_t vic;
     ui_audio_t audio;
+    #if defined(CHIPS_PROFILE)
+    ui_profile_t profile;
+    #endif
     ui_kbd_t kbd;
     ui_memmap_t memmap;
     ui_memedit_t memedit[4];
@@ -176,6 +181,9 @@ static void _ui_c64_draw_menu(ui_c64_t* ui) {
             ImGui::MenuItem("Stopwatch", 0, &ui->dbg.ui.show_stopwatch);
             ImGui::MenuItem("Execution History", 0, &ui->dbg.ui.show_history);
             ImGui::MenuItem("Memory Heatmap", 0, &ui->dbg.ui.show_heatmap);
+            #if defined(CHIPS_PROFILE)
+            ImGui::MenuItem("Tick Profile", 0, &ui->profile.open);
+            #endif
             if (ImGui::BeginMenu("Memory Editor")) {
                 ImGui::MenuItem("Window #1", 0, &ui->memedit[0].open);
                 ImGui::MenuItem("Window #2", 0, &ui->memedit[1].open);
@@ -240,15 +248,15 @@ static uint8_t _ui_c64_mem_read(int layer, uint16_t addr, void* user_data) {
         case _UI_C64_MEMLAYER_ROM:
             if ((addr >= 0xA000) && (addr < 0xC000)) {
                 /* BASIC ROM */
-                return c64->rom_basic[addr - 0xA000];
+                return c64->rom_basic_ptr[addr - 0xA000];
             }
             else if ((addr >= 0xD000) && (addr < 0xE000)) {
                 /* Character ROM */
-                return c64->rom_char[addr - 0xD000];
+                return c64->rom_char_ptr[addr - 0xD000];
             }
             else if (addr >= 0xE000) {
                 /* Kernal ROM */
-                return c64->rom_kernal[addr - 0xE000];
+                return c64->rom_kernal_ptr[addr - 0xE000];
             }
             else {
                 return 0xFF;
@@ -289,17 +297,21 @@ static void _ui_c64_mem_write(int layer, uint16_t addr, uint8_t data, void* user
             c64->ram[addr] = data;
             break;
         case _UI_C64_MEMLAYER_ROM:
+            /* shared ROM images are read-only */
+            if (c64->shared_roms) {
+                break;
+            }
             if ((addr >= 0xA000) && (addr < 0xC000)) {
                 /* BASIC ROM */
-                c64->rom_basic[addr - 0xA000] = data;
+                ((uint8_t*)c64->rom_basic_ptr)[addr - 0xA000] = data;
             }
             else if ((addr >= 0xD000) && (addr < 0xE000)) {
                 /* Character ROM */
-                c64->rom_char[addr - 0xD000] = data;
+                ((uint8_t*)c64->rom_char_ptr)[addr - 0xD000] = data;
             }
             else if (addr >= 0xE000) {
                 /* Kernal ROM */
-                c64->rom_kernal[addr - 0xE000] = data;
+                ((uint8_t*)c64->rom_kernal_ptr)[addr - 0xE000] = data;
             }
             break;
         case _UI_C64_MEMLAYER_1541:
@@ -552,6 +564,7 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.m6502 = &ui->c64->cpu;
+        desc.tick = &ui->c64->tick;
         desc.freq_hz = C64_FREQUENCY;
         desc.scanline_ticks = M6569_HTOTAL;
         desc.frame_ticks = M6569_HTOTAL * M6569_VTOTAL;
@@ -560,6 +573,7 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.debug_cbs = ui_desc->dbg_debug;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui;
         /* custom breakpoint types */
         desc.user_breaktypes[0].label = "Scanline at";
@@ -572,6 +586,7 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
             x += dx; y += dy;
             desc.title = "CPU Debugger (1541 Floppy)";
             desc.m6502 = &ui->c64->c1541.cpu;
+            desc.tick = 0;
             desc.x = x;
             desc.y = y;
             desc.read_cb = _ui_c64_c1541_mem_read;
@@ -580,6 +595,8 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
             desc.user_breaktypes[1].label = 0;
             desc.user_breaktypes[2].label = 0;
             desc.user_breaktypes[3].label = 0;
+            desc.trace.ptr = 0;
+            desc.trace.size = 0;
             ui_dbg_init(&ui->c1541_dbg, &desc);
         }
     }
@@ -651,6 +668,17 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
         desc.y = y;
         ui_audio_init(&ui->audio, &desc);
     }
+    #if defined(CHIPS_PROFILE)
+    x += dx; y += dy;
+    {
+        ui_profile_desc_t desc = {0};
+        desc.title = "Tick Profile";
+        desc.profile = c64_profile_info(ui->c64);
+        desc.x = x;
+        desc.y = y;
+        ui_profile_init(&ui->profile, &desc);
+    }
+    #endif
     x += dx; y += dy;
     {
         ui_kbd_desc_t desc = {0};
@@ -708,6 +736,7 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
 
 void ui_c64_discard(ui_c64_t* ui) {
     CHIPS_ASSERT(ui && ui->c64);
+    ui_snapshot_discard(&ui->snapshot);
     ui_m6502_discard(&ui->cpu);
     if (ui->c64->c1541.valid) {
         ui_m6502_discard(&ui->c1541_cpu);
@@ -718,6 +747,9 @@ void ui_c64_discard(ui_c64_t* ui) {
     ui_m6569_discard(&ui->vic);
     ui_kbd_discard(&ui->kbd);
     ui_audio_discard(&ui->audio);
+    #if defined(CHIPS_PROFILE)
+    ui_profile_discard(&ui->profile);
+    #endif
     ui_memmap_discard(&ui->memmap);
     for (int i = 0; i < 4; i++) {
         ui_memedit_discard(&ui->memedit[i]);
@@ -737,6 +769,9 @@ void ui_c64_draw(ui_c64_t* ui) {
         _ui_c64_update_memmap(ui);
     }
     ui_audio_draw(&ui->audio, ui->c64->audio.sample_pos);
+    #if defined(CHIPS_PROFILE)
+    ui_profile_draw(&ui->profile);
+    #endif
     ui_kbd_draw(&ui->kbd);
     ui_m6502_draw(&ui->cpu);
     if (ui->c64->c1541.valid) {
@@ -763,6 +798,7 @@ chips_debug_t ui_c64_get_debug(ui_c64_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
@@ -34,6 +34,7 @@
     - ui_am40010.h
     - ui_fdd.h
     - ui_audio.h
+    - ui_profile.h (only with CHIPS_PROFILE)
     - ui_dasm.h
     - ui_dbg.h
     - ui_memedit.h
@@ -74,6 +75,7 @@ typedef struct {
     ui_dbg_texture_callbacks_t dbg_texture;     // debug texture create/update/destroy callbacks
     ui_dbg_debug_callbacks_t dbg_debug;         // user-provided debugger callbacks
     ui_dbg_keys_desc_t dbg_keys;                // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                    // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;                // snapshot ui setup params
 } ui_cpc_desc_t;
 
@@ -89,6 +91,9 @@ typedef struct {
     ui_i8255_t ppi;
     ui_upd765_t upd;
     ui_audio_t audio;
+    #if defined(CHIPS_PROFILE)
+    ui_profile_t profile;
+    #endif
     ui_fdd_t fdd;
     ui_kbd_t kbd;
     ui_memmap_t memmap;
@@ -171,6 +176,9 @@ static void _ui_cpc_draw_menu(ui_cpc_t* ui) {
             ImGui::MenuItem("Stopwatch", 0, &ui->dbg.ui.show_stopwatch);
             ImGui::MenuItem("Execution History", 0, &ui->dbg.ui.show_history);
             ImGui::MenuItem("Memory Heatmap", 0, &ui->dbg.ui.show_heatmap);
+            #if defined(CHIPS_PROFILE)
+            ImGui::MenuItem("Tick Profile", 0, &ui->profile.open);
+            #endif
             if (ImGui::BeginMenu("Memory Editor")) {
                 ImGui::MenuItem("Window #1", 0, &ui->memedit[0].open);
                 ImGui::MenuItem("Window #2", 0, &ui->memedit[1].open);
@@ -266,22 +274,30 @@ static void _ui_cpc_update_memmap(ui_cpc_t* ui) {
     }
 }
 
-static uint8_t* _ui_cpc_memptr(cpc_t* cpc, int layer, uint16_t addr) {
+/* ROM images may be shared between instances and are read-only then */
+static uint8_t* _ui_cpc_romptr(cpc_t* cpc, const uint8_t* rom_ptr, uint16_t offset, bool write) {
+    if (write && cpc->shared_roms) {
+        return 0;
+    }
+    return (uint8_t*) &rom_ptr[offset];
+}
+
+static uint8_t* _ui_cpc_memptr(cpc_t* cpc, int layer, uint16_t addr, bool write) {
     CHIPS_ASSERT((layer >= _UI_CPC_MEMLAYER_GA) && (layer < _UI_CPC_MEMLAYER_NUM));
     if (layer == _UI_CPC_MEMLAYER_GA) {
         uint8_t* ram = &cpc->ram[0][0];
         return ram + addr;
     } else if (layer == _UI_CPC_MEMLAYER_ROMS) {
         if (addr < 0x4000) {
-            return &cpc->rom_os[addr];
+            return _ui_cpc_romptr(cpc, cpc->rom_os_ptr, addr, write);
         } else if (addr >= 0xC000) {
-            return &cpc->rom_basic[addr - 0xC000];
+            return _ui_cpc_romptr(cpc, cpc->rom_basic_ptr, addr - 0xC000, write);
         } else {
             return 0;
         }
     } else if (layer == _UI_CPC_MEMLAYER_AMSDOS) {
         if ((CPC_TYPE_6128 == cpc->type) && (addr >= 0xC000)) {
-            return &cpc->rom_amsdos[addr - 0xC000];
+            return _ui_cpc_romptr(cpc, cpc->rom_amsdos_ptr, addr - 0xC000, write);
         } else {
             return 0;
         }
@@ -323,7 +339,7 @@ static uint8_t _ui_cpc_mem_read(int layer, uint16_t addr, void* user_data) {
         /* CPU mapped RAM layer */
         return mem_rd(&cpc->mem, addr);
     } else {
-        uint8_t* ptr = _ui_cpc_memptr(cpc, layer, addr);
+        uint8_t* ptr = _ui_cpc_memptr(cpc, layer, addr, false);
         if (ptr) {
             return *ptr;
         } else {
@@ -339,7 +355,7 @@ static void _ui_cpc_mem_write(int layer, uint16_t addr, uint8_t data, void* user
     if (layer == _UI_CPC_MEMLAYER_CPU) {
         mem_wr(&cpc->mem, addr, data);
     } else {
-        uint8_t* ptr = _ui_cpc_memptr(cpc, layer, addr);
+        uint8_t* ptr = _ui_cpc_memptr(cpc, layer, addr, true);
         if (ptr) {
             *ptr = data;
         }
@@ -587,11 +603,13 @@ void ui_cpc_init(ui_cpc_t* ui, const ui_cpc_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->cpc->cpu;
+        desc.tick = &ui->cpc->tick;
         desc.read_cb = _ui_cpc_mem_read;
         desc.break_cb = _ui_cpc_eval_bp;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.debug_cbs = ui_desc->dbg_debug;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui;
         /* custom breakpoint types */
         desc.user_breaktypes[0].label = "Scanline at";
@@ -671,6 +689,17 @@ void ui_cpc_init(ui_cpc_t* ui, const ui_cpc_desc_t* ui_desc) {
         desc.y = y;
         ui_audio_init(&ui->audio, &desc);
     }
+    #if defined(CHIPS_PROFILE)
+    x += dx; y += dy;
+    {
+        ui_profile_desc_t desc = {0};
+        desc.title = "Tick Profile";
+        desc.profile = cpc_profile_info(ui->cpc);
+        desc.x = x;
+        desc.y = y;
+        ui_profile_init(&ui->profile, &desc);
+    }
+    #endif
     x += dx; y += dy;
     {
         ui_fdd_desc_t desc = {0};
@@ -737,6 +766,7 @@ void ui_cpc_init(ui_cpc_t* ui, const ui_cpc_desc_t* ui_desc) {
 
 void ui_cpc_discard(ui_cpc_t* ui) {
     CHIPS_ASSERT(ui && ui->cpc);
+    ui_snapshot_discard(&ui->snapshot);
     ui->cpc = 0;
     ui_z80_discard(&ui->cpu);
     ui_i8255_discard(&ui->ppi);
@@ -746,6 +776,9 @@ void ui_cpc_discard(ui_cpc_t* ui) {
     ui_am40010_discard(&ui->ga);
     ui_kbd_discard(&ui->kbd);
     ui_audio_discard(&ui->audio);
+    #if defined(CHIPS_PROFILE)
+    ui_profile_discard(&ui->profile);
+    #endif
     ui_fdd_discard(&ui->fdd);
     ui_memmap_discard(&ui->memmap);
     for (int i = 0; i < 4; i++) {
@@ -762,6 +795,9 @@ void ui_cpc_draw(ui_cpc_t* ui) {
         _ui_cpc_update_memmap(ui);
     }
     ui_audio_draw(&ui->audio, ui->cpc->audio.sample_pos);
+    #if defined(CHIPS_PROFILE)
+    ui_profile_draw(&ui->profile);
+    #endif
     ui_fdd_draw(&ui->fdd);
     ui_kbd_draw(&ui->kbd);
     ui_z80_draw(&ui->cpu);
@@ -784,6 +820,7 @@ chips_debug_t ui_cpc_get_debug(ui_cpc_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
@@ -68,6 +68,8 @@ typedef uint8_t (*ui_dasm_read_t)(int layer, uint16_t addr, void* user_data);
 #define UI_DASM_MAX_BINLEN (16)
 #define UI_DASM_NUM_LINES (512)
 #define UI_DASM_MAX_STACK (128)
+#define UI_DASM_CACHE_SIZE (1024)   /* must be 2^N */
+#define UI_DASM_CACHE_MAX_BYTES (4)
 
 /* CPU types */
 typedef enum {
@@ -75,6 +77,15 @@ typedef enum {
     UI_DASM_CPUTYPE_M6502 = 1,
 } ui_dasm_cputype_t;
 
+/* a cached disassembled instruction (num_bytes == 0: empty slot) */
+typedef struct {
+    uint16_t addr;
+    uint8_t layer;
+    uint8_t num_bytes;
+    uint8_t bytes[UI_DASM_CACHE_MAX_BYTES];
+    char str[UI_DASM_MAX_STRLEN];
+} ui_dasm_cache_line_t;
+
 /* setup parameters for ui_dasm_init()
 
     NOTE: all strings must be static!
@@ -114,6 +125,7 @@ typedef struct {
     uint16_t stack[UI_DASM_MAX_STACK];
     uint16_t highlight_addr;
     uint32_t highlight_color;
+    ui_dasm_cache_line_t cache[UI_DASM_CACHE_SIZE];    /* direct-mapped by address */
 } ui_dasm_t;
 
 void ui_dasm_init(ui_dasm_t* win, const ui_dasm_desc_t* desc);
@@ -190,10 +202,48 @@ static void _ui_dasm_out_cb(char c, void* user_data) {
     }
 }
 
+/*  check the disassembly cache for the instruction at the current address,
+    a cached line is only used if the instruction bytes in the current layer
+    still match, so that modified memory is disassembled again
+*/
+static bool _ui_dasm_cache_lookup(ui_dasm_t* win) {
+    const uint16_t addr = win->cur_addr;
+    const ui_dasm_cache_line_t* line = &win->cache[addr & (UI_DASM_CACHE_SIZE-1)];
+    if ((line->num_bytes == 0) || (line->addr != addr) || (line->layer != win->cur_layer)) {
+        return false;
+    }
+    for (int i = 0; i < line->num_bytes; i++) {
+        if (win->read_cb(win->cur_layer, (uint16_t)(addr + i), win->user_data) != line->bytes[i]) {
+            return false;
+        }
+    }
+    memcpy(win->bin_buf, line->bytes, line->num_bytes);
+    win->bin_pos = line->num_bytes;
+    memcpy(win->str_buf, line->str, UI_DASM_MAX_STRLEN);
+    win->cur_addr = (uint16_t)(addr + line->num_bytes);
+    return true;
+}
+
+static void _ui_dasm_cache_store(ui_dasm_t* win, uint16_t addr) {
+    if ((win->bin_pos > 0) && (win->bin_pos <= UI_DASM_CACHE_MAX_BYTES)) {
+        ui_dasm_cache_line_t* line = &win->cache[addr & (UI_DASM_CACHE_SIZE-1)];
+        line->addr = addr;
+        line->layer = (uint8_t) win->cur_layer;
+        line->num_bytes = (uint8_t) win->bin_pos;
+        memcpy(line->bytes, win->bin_buf, win->bin_pos);
+        memcpy(line->str, win->str_buf, UI_DASM_MAX_STRLEN);
+    }
+}
+
 /* disassemble the next instruction */
 static void _ui_dasm_disasm(ui_dasm_t* win) {
+    if (_ui_dasm_cache_lookup(win)) {
+        return;
+    }
+    const uint16_t addr = win->cur_addr;
     win->str_pos = 0;
     win->bin_pos = 0;
+    win->str_buf[0] = 0;
     #if defined(UI_DASM_USE_Z80) && defined(UI_DASM_USE_M6502)
     if (win->cpu_type == UI_DASM_CPUTYPE_Z80) {
         z80dasm_op(win->cur_addr, _ui_dasm_in_cb, _ui_dasm_out_cb, win);
@@ -206,6 +256,7 @@ static void _ui_dasm_disasm(ui_dasm_t* win) {
     #else
     m6502dasm_op(win->cur_addr, _ui_dasm_in_cb, _ui_dasm_out_cb, win);
     #endif
+    _ui_dasm_cache_store(win, addr);
 }
 
 /* check if the current Z80 or m6502 instruction contains a jump target */
@@ -29,6 +29,7 @@
 
         - imgui.h
         - ui_util.h
+        - chips_common.h
         - z80.h         (only if UI_DBG_USE_Z80 is defined)
         - z80dasm.h     (only if UI_DBG_USE_Z80 is defined)
         - m6502.h       (only if UI_DBG_USE_M6502 is defined)
@@ -37,6 +38,102 @@
     All strings provided to ui_dbg_init() must remain alive until
     ui_dbg_discard() is called!
 
+    ## Breakpoint Map
+
+    The debugger keeps a chips_breakmap_t (see chips_common.h) in sync with its
+    breakpoint list, this can be attached to the system's chips_debug_t
+    so that the system only calls ui_dbg_tick() when an execution or
+    memory-value breakpoint might trigger instead of on every tick.
+
+    The map switches to 'every instruction' mode while stepping over
+    instructions, while condition breakpoints are enabled, or while the
+    debugger window, the history window or the execution trace are active,
+    since those only need to see instruction starts. The ticks in between
+    are counted through the system tick counter in ui_dbg_desc_t.tick, so
+    the instruction tick counts and the stopwatch stay exact.
+
+    The map falls back to 'every tick' mode while single-stepping ticks,
+    while per-tick breakpoints (IRQ, NMI, IN, OUT, user breakpoints) are
+    enabled, or while the heatmap (which records memory accesses) or the
+    profiler are active. Without a system tick counter, the 'every
+    instruction' mode and the stopwatch also fall back to 'every tick'.
+
+    ## Breakpoint Conditions
+
+    Each breakpoint can have an optional condition expression, the breakpoint
+    only stops execution when its trigger fires (e.g. the PC reached the
+    breakpoint address) *and* the condition is true. The 'Condition'
+    breakpoint type has no trigger of its own, its condition is evaluated
+    at the start of each instruction:
+
+        A==3F && (HL)>80
+        X>=$10 || (0D020)!=0
+        HITS>=10
+
+    - numbers are hexadecimal, with an optional '$' or '0x' prefix, and must
+      start with a digit or a prefix (so that they can't be confused with
+      register names: 0A, $FF, 0xFF)
+    - registers: PC, A, F, B, C, D, E, H, L, AF, BC, DE, HL, IX, IY, SP, I,
+      R, WZ (Z80) or PC, A, X, Y, S, P (6502), PC is the address of the
+      current instruction
+    - HITS: the number of times the breakpoint's trigger has fired, including
+      the current hit (reset when the condition is changed)
+    - (expr): the memory byte at address expr (so parentheses can't be
+      used for grouping, use the operator precedence instead)
+    - operators (by increasing precedence): ||, &&, == != < > <= >=,
+      | ^ &, + -, unary ! and -
+
+    Conditions are compiled into a small stack-machine program when they
+    are edited. The enabled breakpoints are sorted into buckets by trigger
+    (execution, memory value and condition, per-tick events), so that for
+    instance the execution breakpoints are only looked at when the
+    breakpoint map says that the current PC has a breakpoint.
+
+    ## Execution Trace
+
+    The Execution History window only remembers the last
+    UI_DBG_NUM_HISTORY_ITEMS PCs. For a deeper history, provide memory
+    for an execution trace in ui_dbg_desc_t.trace (at least 2 blocks of
+    UI_DBG_TRACE_BLOCK_SIZE bytes). The trace records the PC, the CPU
+    registers and a tick stamp at the start of each instruction, and the
+    Execution History window then shows and searches the trace instead.
+
+    The trace memory is split into blocks. Each block starts with a full
+    item (keyframe), followed by delta-encoded items which only store the
+    changed registers, which takes about 4..8 bytes per instruction. When
+    the memory is full, the oldest block is dropped. While recording, the
+    debugger needs to see every tick for the tick stamps (the same as
+    when the history window is open).
+
+    ## Profiler
+
+    The Profiler window attributes executed CPU cycles to a call tree. The
+    profiler keeps a shadow call stack which is updated at the start of
+    each instruction:
+
+    - when the previous instruction was a CALL/RST (Z80) or JSR (6502)
+      which pushed a return address, a call frame is pushed
+    - when an interrupt was taken, an interrupt frame is pushed (on the
+      Z80 this is detected by the interrupt acknowledge cycle, or for NMIs
+      by the return address pushed at 0066, on the 6502 by the stack
+      pointer dropping by 3)
+    - frames are popped when the stack pointer moves above the return
+      address of the frame, this handles RET, RETI, RTS, RTI, conditional
+      returns and stack resets the same way
+
+    Each distinct call path is a node in a fixed-size node pool
+    (UI_DBG_PROF_MAX_NODES), calls which don't fit into the pool or the
+    shadow stack (UI_DBG_PROF_MAX_DEPTH) are attributed to their caller.
+
+    In exact mode, the ticks of each instruction are added to the current
+    node. In sampling mode, the current node is charged with N ticks
+    every N ticks instead. The report can be viewed as call tree or as
+    flat list of functions, and exported in the 'folded stacks' text format
+    used by flamegraph tools (one line per call path: 'root;1234;5678 ticks')
+    with ui_dbg_profiler_export() or the 'Copy' button.
+
+    While profiling, the debugger needs to see every tick.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -69,11 +166,22 @@ extern "C" {
 /* NOTE: keep all MAX and NUM values 2^N */
 #define UI_DBG_MAX_BREAKPOINTS (32)
 #define UI_DBG_MAX_USER_BREAKTYPES (8)  /* max number of user breakpoint types */
+#define UI_DBG_BP_MAX_EXPR (64)         /* max length of a breakpoint condition expression */
+#define UI_DBG_BP_MAX_PROG (32)         /* max number of ops in a compiled breakpoint condition */
+#define UI_DBG_BP_MAX_STACK (8)         /* max stack depth of a breakpoint condition */
 #define UI_DBG_STEP_TRAPID (128)        /* special trap id when step-mode active */
 #define UI_DBG_BP_BASE_TRAPID (UI_DBG_STEP_TRAPID+1)   /* first CPU trap-id used for breakpoints */
 #define UI_DBG_NUM_LINES (256)
 #define UI_DBG_NUM_BACKTRACE_LINES (UI_DBG_NUM_LINES/2)
 #define UI_DBG_NUM_HISTORY_ITEMS (256)
+#define UI_DBG_TRACE_BLOCK_SIZE (4096)  /* trace memory is split into blocks of this size */
+#define UI_DBG_PROF_MAX_NODES (1024)    /* max number of distinct call paths in the profiler */
+#define UI_DBG_PROF_MAX_DEPTH (64)      /* max depth of the profiler's shadow call stack */
+#if defined(UI_DBG_USE_Z80)
+#define UI_DBG_TRACE_NUM_REGS (13)      /* AF,HL,BC,DE,SP,WZ,IX,IY,AF',BC',DE',HL',I|IM|IFF */
+#else
+#define UI_DBG_TRACE_NUM_REGS (5)       /* A,X,Y,S,P */
+#endif
 
 /* breakpoint types */
 enum {
@@ -86,6 +194,7 @@ enum {
         UI_DBG_BREAKTYPE_OUT,   /* break on a Z80 out operation */
         UI_DBG_BREAKTYPE_IN,    /* break on a Z80 in operation */
     #endif
+    UI_DBG_BREAKTYPE_COND,      /* break when the condition expression is true */
     UI_DBG_BREAKTYPE_USER,      /* user breakpoint types start here */
 };
 #define UI_DBG_MAX_BREAKTYPES (UI_DBG_BREAKTYPE_USER + UI_DBG_MAX_USER_BREAKTYPES)
@@ -122,6 +231,11 @@ typedef struct ui_dbg_breakpoint_t {
     bool enabled;
     uint16_t addr;
     int val;
+    uint32_t hits;                          /* number of times the trigger has fired */
+    char expr[UI_DBG_BP_MAX_EXPR];          /* optional condition expression */
+    const char* expr_error;                 /* compile error message, or 0 */
+    int num_ops;                            /* number of ops in compiled condition, 0 if none */
+    uint32_t prog[UI_DBG_BP_MAX_PROG];      /* compiled condition */
 } ui_dbg_breakpoint_t;
 
 /* breakpoint type description */
@@ -204,6 +318,8 @@ typedef struct ui_dbg_desc_t {
     bool open;                      // initial open state
     ui_dbg_keys_desc_t keys;        // user-defined hotkeys
     ui_dbg_breaktype_t user_breaktypes[UI_DBG_MAX_USER_BREAKTYPES];  /* user-defined breakpoint types */
+    chips_range_t trace;            // optional memory for the execution trace (see 'Execution Trace')
+    const uint64_t* tick;           // optional system tick counter (see 'Breakpoint Map')
 } ui_dbg_desc_t;
 
 /* debugger state */
@@ -217,6 +333,8 @@ typedef struct ui_dbg_state_t {
     bool external_debugger_connected;
     int step_mode;
     uint64_t last_tick_pins;    // cpu pins in last tick
+    const uint64_t* tick;       // optional system tick counter
+    uint64_t last_tick;         // system tick in last ui_dbg_tick() call
     uint32_t frame_id;          // used in trap callback to detect when a new frame has started
     uint32_t cur_op_ticks;
     uint16_t cur_op_pc;         // PC of current instruction
@@ -225,6 +343,15 @@ typedef struct ui_dbg_state_t {
     int delete_breakpoint_index;
     int num_breakpoints;
     ui_dbg_breakpoint_t breakpoints[UI_DBG_MAX_BREAKPOINTS];
+    bool breakmap_recheck;      // a memory-value breakpoint address was written, check at next op
+    chips_breakmap_t breakmap;  // breakpoint bitmap, attach to chips_debug_t.breakmap
+    // indices of enabled breakpoints by trigger, updated with the breakmap
+    int num_exec_bps;           // execution breakpoints, only checked when the current PC is in the breakmap
+    uint8_t exec_bps[UI_DBG_MAX_BREAKPOINTS];
+    int num_op_bps;             // memory-value and condition breakpoints, checked at each instruction
+    uint8_t op_bps[UI_DBG_MAX_BREAKPOINTS];
+    int num_tick_bps;           // IRQ, NMI, IN and OUT breakpoints, checked at each tick
+    uint8_t tick_bps[UI_DBG_MAX_BREAKPOINTS];
 } ui_dbg_state_t;
 
 /* a displayed line */
@@ -247,6 +374,7 @@ typedef struct ui_dbg_uistate_t {
     bool show_ticks;
     bool show_history;
     bool show_stopwatch;
+    bool show_profiler;
     bool request_scroll;
     ui_dbg_keys_desc_t keys;
     ui_dbg_line_t line_array[UI_DBG_NUM_LINES];
@@ -286,9 +414,85 @@ typedef struct ui_dbg_history_t {
     uint16_t pos;
 } ui_dbg_history_t;
 
+/* a decoded execution trace item */
+typedef struct ui_dbg_trace_item_t {
+    uint64_t tick;                          /* tick stamp at the start of the instruction */
+    uint16_t pc;
+    uint16_t regs[UI_DBG_TRACE_NUM_REGS];   /* CPU registers before the instruction */
+} ui_dbg_trace_item_t;
+
+typedef struct ui_dbg_trace_t {
+    uint8_t* buf;               /* caller-provided trace memory */
+    uint32_t num_blocks;        /* number of UI_DBG_TRACE_BLOCK_SIZE blocks in buf */
+    uint32_t head;              /* block currently being written */
+    uint32_t num_used;          /* number of blocks holding items */
+    uint32_t pos;               /* write position in head block */
+    uint64_t num_items;         /* total number of recorded items, including dropped items */
+    uint64_t tick;              /* current tick stamp */
+    ui_dbg_trace_item_t last;   /* last recorded item, base for delta encoding */
+    bool recording;
+    uint64_t selected;          /* index of selected item in history window */
+    bool scroll_to_selected;
+    uint16_t find_pc;
+} ui_dbg_trace_t;
+
+/* profiler node kinds */
+enum {
+    UI_DBG_PROF_KIND_ROOT = 0,
+    UI_DBG_PROF_KIND_CALL,
+    UI_DBG_PROF_KIND_INT,
+};
+
+/* a profiler call tree node */
+typedef struct ui_dbg_prof_node_t {
+    uint16_t addr;          /* subroutine or interrupt handler address */
+    uint16_t parent;        /* parent node index */
+    uint16_t first_child;   /* first child node index, 0 if none (node 0 is the root) */
+    uint16_t next_sibling;  /* next sibling node index, 0 if none */
+    uint8_t kind;           /* UI_DBG_PROF_KIND_xxx */
+    uint32_t calls;
+    uint64_t self_ticks;
+    uint64_t total_ticks;   /* self ticks plus ticks of all children, updated in draw */
+} ui_dbg_prof_node_t;
+
+/* a shadow call stack frame */
+typedef struct ui_dbg_prof_frame_t {
+    uint16_t node;
+    uint16_t sp;            /* stack pointer after the return address was pushed */
+} ui_dbg_prof_frame_t;
+
+/* an entry in the flat profiler report */
+typedef struct ui_dbg_prof_func_t {
+    uint16_t addr;
+    uint8_t kind;
+    uint32_t calls;
+    uint64_t self_ticks;
+} ui_dbg_prof_func_t;
+
+typedef struct ui_dbg_profiler_t {
+    bool enabled;
+    bool sampling;              /* charge sample_interval ticks every sample_interval ticks */
+    bool flat_view;
+    bool nodes_full;            /* the node pool overflowed */
+    int sample_interval;
+    int sample_countdown;
+    uint16_t op_pc;             /* PC and SP at the start of the current instruction */
+    uint16_t op_sp;
+    bool op_valid;
+    bool int_ack;               /* Z80 interrupt acknowledge cycle seen in current instruction */
+    int depth;
+    ui_dbg_prof_frame_t stack[UI_DBG_PROF_MAX_DEPTH];
+    uint64_t total_ticks;
+    int num_nodes;
+    ui_dbg_prof_node_t nodes[UI_DBG_PROF_MAX_NODES];
+    int num_funcs;
+    ui_dbg_prof_func_t funcs[UI_DBG_PROF_MAX_NODES];
+} ui_dbg_profiler_t;
+
 enum {
     UI_DBG_DASM_LINE_MAX_BYTES = 8,
     UI_DBG_DASM_LINE_MAX_CHARS = 32,
+    UI_DBG_DASM_CACHE_SIZE = 1024,      // must be 2^N
 };
 
 typedef struct ui_dbg_dasm_line_t {
@@ -326,11 +530,14 @@ typedef struct ui_dbg_t {
     ui_dbg_debug_callbacks_t debug_cbs;
     void* user_data;
     ui_dbg_dasm_line_t dasm_line;
+    ui_dbg_dasm_line_t dasm_cache[UI_DBG_DASM_CACHE_SIZE];  // direct-mapped by address, num_bytes == 0 means empty
     ui_dbg_state_t dbg;
     ui_dbg_uistate_t ui;
     ui_dbg_heatmap_t heatmap;
     ui_dbg_history_t history;
+    ui_dbg_trace_t trace;
     ui_dbg_stopwatch_t stopwatch;
+    ui_dbg_profiler_t prof;
 } ui_dbg_t;
 
 // initialize a new ui_dbg_t instance
@@ -365,6 +572,10 @@ void ui_dbg_step_next(ui_dbg_t* win);
 void ui_dbg_step_into(ui_dbg_t* win);
 // request a disassembly at start address
 void ui_dbg_disassemble(ui_dbg_t* win, const ui_dbg_dasm_request_t* request);
+// set the condition of the execution breakpoint at address (see 'Breakpoint Conditions'), empty or null to clear
+bool ui_dbg_set_breakpoint_condition(ui_dbg_t* win, uint16_t addr, const char* expr);
+// write the profiler call tree in folded stacks format, returns required size (like snprintf)
+int ui_dbg_profiler_export(ui_dbg_t* win, char* buf, int buf_size);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -373,6 +584,8 @@ void ui_dbg_disassemble(ui_dbg_t* win, const ui_dbg_dasm_request_t* request);
 /*-- IMPLEMENTATION ----------------------------------------------------------*/
 #ifdef CHIPS_UI_IMPL
 #include <string.h>
+#include <stdio.h>  /* snprintf */
+#include <stdlib.h> /* qsort */
 #ifndef CHIPS_ASSERT
     #include <assert.h>
     #define CHIPS_ASSERT(c) assert(c)
@@ -420,8 +633,30 @@ static void _ui_dbg_dasm_out_cb(char c, void* user_data) {
     }
 }
 
+/*  check the disassembly cache for an instruction at address, a cached
+    line is only valid as long as the instruction bytes in memory are the
+    same as when it was disassembled, this catches self-modifying code,
+    loaded programs and bank switching without any explicit invalidation
+*/
+static bool _ui_dbg_dasm_cache_lookup(ui_dbg_t* win, uint16_t addr) {
+    const ui_dbg_dasm_line_t* line = &win->dasm_cache[addr & (UI_DBG_DASM_CACHE_SIZE-1)];
+    if ((line->num_bytes == 0) || (line->addr != addr)) {
+        return false;
+    }
+    for (int i = 0; i < line->num_bytes; i++) {
+        if (_ui_dbg_read_byte(win, (uint16_t)(addr + i)) != line->bytes[i]) {
+            return false;
+        }
+    }
+    win->dasm_line = *line;
+    return true;
+}
+
 // disassemble instruction at address
 static inline uint16_t _ui_dbg_disasm(ui_dbg_t* win, uint16_t addr) {
+    if (_ui_dbg_dasm_cache_lookup(win, addr)) {
+        return (uint16_t)(addr + win->dasm_line.num_bytes);
+    }
     memset(&win->dasm_line, 0, sizeof(win->dasm_line));
     win->dasm_line.addr = addr;
     #if defined(UI_DBG_USE_Z80)
@@ -431,6 +666,7 @@ static inline uint16_t _ui_dbg_disasm(ui_dbg_t* win, uint16_t addr) {
     #endif
     uint16_t next_addr = win->dasm_line.addr;
     win->dasm_line.addr = addr;
+    win->dasm_cache[addr & (UI_DBG_DASM_CACHE_SIZE-1)] = win->dasm_line;
     return next_addr;
 }
 
@@ -529,6 +765,70 @@ static bool _ui_dbg_is_controlflow_op(uint8_t opcode0, uint8_t opcode1) {
     #endif
 }
 
+/* rebuild the breakpoint map from the breakpoint list and current debugger state */
+static void _ui_dbg_breakmap_update(ui_dbg_t* win) {
+    chips_breakmap_t* map = &win->dbg.breakmap;
+    chips_breakmap_clear(map);
+    // these only need to see instruction starts
+    bool every_op = (win->dbg.step_mode == UI_DBG_STEPMODE_INTO) ||
+                    (win->dbg.step_mode == UI_DBG_STEPMODE_OVER) ||
+                    win->dbg.breakmap_recheck ||
+                    win->ui.open ||
+                    win->ui.show_history ||
+                    win->trace.recording;
+    // these need to see each tick
+    bool every_tick = (win->dbg.step_mode == UI_DBG_STEPMODE_TICK) ||
+                      win->ui.show_heatmap ||
+                      win->prof.enabled;
+    ui_dbg_state_t* dbg = &win->dbg;
+    dbg->num_exec_bps = dbg->num_op_bps = dbg->num_tick_bps = 0;
+    for (int i = 0; i < dbg->num_breakpoints; i++) {
+        const ui_dbg_breakpoint_t* bp = &dbg->breakpoints[i];
+        if (bp->enabled) {
+            switch (bp->type) {
+                case UI_DBG_BREAKTYPE_EXEC:
+                    chips_breakmap_set(map->exec, bp->addr);
+                    dbg->exec_bps[dbg->num_exec_bps++] = (uint8_t)i;
+                    break;
+                /* memory-value breakpoints can only change their state after a write */
+                case UI_DBG_BREAKTYPE_WORD:
+                    chips_breakmap_set(map->write, (uint16_t)(bp->addr + 1));
+                    chips_breakmap_set(map->write, bp->addr);
+                    dbg->op_bps[dbg->num_op_bps++] = (uint8_t)i;
+                    break;
+                case UI_DBG_BREAKTYPE_BYTE:
+                    chips_breakmap_set(map->write, bp->addr);
+                    dbg->op_bps[dbg->num_op_bps++] = (uint8_t)i;
+                    break;
+                /* all other breakpoint types must be evaluated per tick */
+                case UI_DBG_BREAKTYPE_COND:
+                    dbg->op_bps[dbg->num_op_bps++] = (uint8_t)i;
+                    every_op = true;
+                    break;
+                case UI_DBG_BREAKTYPE_IRQ:
+                case UI_DBG_BREAKTYPE_NMI:
+                #if defined(UI_DBG_USE_Z80)
+                case UI_DBG_BREAKTYPE_OUT:
+                case UI_DBG_BREAKTYPE_IN:
+                #endif
+                    dbg->tick_bps[dbg->num_tick_bps++] = (uint8_t)i;
+                    every_tick = true;
+                    break;
+                /* user breakpoints are evaluated in the per-tick user callback */
+                default:
+                    every_tick = true;
+                    break;
+            }
+        }
+    }
+    // without a system tick counter the skipped ticks can't be counted
+    if (0 == dbg->tick) {
+        every_tick |= every_op || win->ui.show_stopwatch;
+    }
+    map->every_op = every_op;
+    map->every_tick = every_tick;
+}
+
 static void _ui_dbg_break(ui_dbg_t* win) {
     win->dbg.stopped = true;
     win->dbg.step_mode = UI_DBG_STEPMODE_NONE;
@@ -541,6 +841,7 @@ static void _ui_dbg_break(ui_dbg_t* win) {
 static void _ui_dbg_continue(ui_dbg_t* win, bool invoke_continue_cb) {
     win->dbg.stopped = false;
     win->dbg.step_mode = UI_DBG_STEPMODE_NONE;
+    _ui_dbg_breakmap_update(win);
     if (invoke_continue_cb && win->debug_cbs.continued_cb) {
         win->debug_cbs.continued_cb();
     }
@@ -550,6 +851,7 @@ static void _ui_dbg_step_into(ui_dbg_t* win) {
     win->dbg.stopped = false;
     win->dbg.step_mode = UI_DBG_STEPMODE_INTO;
     win->ui.request_scroll = true;
+    _ui_dbg_breakmap_update(win);
 }
 
 static void _ui_dbg_step_over(ui_dbg_t* win) {
@@ -562,12 +864,356 @@ static void _ui_dbg_step_over(ui_dbg_t* win) {
     } else {
         win->dbg.step_mode = UI_DBG_STEPMODE_INTO;
     }
+    _ui_dbg_breakmap_update(win);
 }
 
 static void _ui_dbg_step_tick(ui_dbg_t* win) {
     win->dbg.stopped = false;
     win->dbg.step_mode = UI_DBG_STEPMODE_TICK;
     win->ui.request_scroll = true;
+    _ui_dbg_breakmap_update(win);
+}
+
+/*== EXECUTION TRACE =========================================================*/
+/* each block starts with a header (index of the first item and number of
+    items), followed by a keyframe item with all values, and delta-encoded
+    items:
+
+    - varint: bit mask of changed registers
+    - varint: tick delta
+    - varint: zigzag-encoded PC delta
+    - 16-bit little-endian value of each changed register
+*/
+#define _UI_DBG_TRACE_HEADER_SIZE (16)
+#define _UI_DBG_TRACE_KEYFRAME_SIZE (8 + 2 + 2 * UI_DBG_TRACE_NUM_REGS)
+#define _UI_DBG_TRACE_MAX_DELTA_SIZE (3 + 10 + 3 + 2 * UI_DBG_TRACE_NUM_REGS)
+#define _UI_DBG_TRACE_MAX_VISIBLE_ITEMS (256)
+
+typedef struct {
+    const uint8_t* ptr;     /* next encoded item in current block */
+    uint32_t block_index;   /* current block, 0 is the oldest block */
+    uint32_t left;          /* number of items left in current block */
+    uint64_t index;         /* index of current item */
+    ui_dbg_trace_item_t item;
+} _ui_dbg_trace_iter_t;
+
+static void _ui_dbg_trace_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
+    ui_dbg_trace_t* t = &win->trace;
+    if (desc->trace.ptr) {
+        CHIPS_ASSERT(desc->trace.size >= (2 * UI_DBG_TRACE_BLOCK_SIZE));
+        t->buf = (uint8_t*) desc->trace.ptr;
+        t->num_blocks = (uint32_t) (desc->trace.size / UI_DBG_TRACE_BLOCK_SIZE);
+        t->recording = true;
+    }
+}
+
+static void _ui_dbg_trace_reset(ui_dbg_t* win) {
+    ui_dbg_trace_t* t = &win->trace;
+    t->head = 0;
+    t->num_used = 0;
+    t->pos = 0;
+    t->num_items = 0;
+    t->tick = 0;
+    t->selected = 0;
+    t->scroll_to_selected = false;
+}
+
+static inline uint8_t* _ui_dbg_trace_block(ui_dbg_trace_t* t, uint32_t block_index) {
+    /* block_index 0 is the oldest block */
+    const uint32_t block = (t->head + t->num_blocks + 1 - t->num_used + block_index) % t->num_blocks;
+    return t->buf + (size_t)block * UI_DBG_TRACE_BLOCK_SIZE;
+}
+
+static inline uint64_t _ui_dbg_trace_block_first(ui_dbg_trace_t* t, uint32_t block_index) {
+    uint64_t first;
+    memcpy(&first, _ui_dbg_trace_block(t, block_index), sizeof(first));
+    return first;
+}
+
+/* index of the oldest item still in the trace */
+static inline uint64_t _ui_dbg_trace_first(ui_dbg_trace_t* t) {
+    return (t->num_used > 0) ? _ui_dbg_trace_block_first(t, 0) : 0;
+}
+
+static inline uint8_t* _ui_dbg_trace_put_varint(uint8_t* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static inline const uint8_t* _ui_dbg_trace_get_varint(const uint8_t* p, uint64_t* v) {
+    uint64_t res = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+        b = *p++;
+        res |= (uint64_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    *v = res;
+    return p;
+}
+
+static void _ui_dbg_trace_regs(ui_dbg_t* win, uint16_t* regs) {
+    #if defined(UI_DBG_USE_Z80)
+        const z80_t* c = win->dbg.z80;
+        regs[0] = c->af; regs[1] = c->hl; regs[2] = c->bc; regs[3] = c->de;
+        regs[4] = c->sp; regs[5] = c->wz; regs[6] = c->ix; regs[7] = c->iy;
+        regs[8] = c->af2; regs[9] = c->bc2; regs[10] = c->de2; regs[11] = c->hl2;
+        /* R is left out since it changes with every instruction */
+        regs[12] = (uint16_t)((c->i << 8) | (c->im << 2) | (c->iff2 ? 2 : 0) | (c->iff1 ? 1 : 0));
+    #elif defined(UI_DBG_USE_M6502)
+        const m6502_t* c = win->dbg.m6502;
+        regs[0] = c->A; regs[1] = c->X; regs[2] = c->Y; regs[3] = c->S; regs[4] = c->P;
+    #endif
+}
+
+static void _ui_dbg_trace_record(ui_dbg_t* win, uint16_t pc) {
+    ui_dbg_trace_t* t = &win->trace;
+    ui_dbg_trace_item_t item;
+    item.tick = t->tick;
+    item.pc = pc;
+    _ui_dbg_trace_regs(win, item.regs);
+    uint8_t* blk;
+    if ((t->num_used == 0) || ((t->pos + _UI_DBG_TRACE_MAX_DELTA_SIZE) > UI_DBG_TRACE_BLOCK_SIZE)) {
+        /* start a new block with a keyframe, drop the oldest block if full */
+        if (t->num_used > 0) {
+            t->head = (t->head + 1) % t->num_blocks;
+        }
+        if (t->num_used < t->num_blocks) {
+            t->num_used++;
+        }
+        blk = t->buf + (size_t)t->head * UI_DBG_TRACE_BLOCK_SIZE;
+        const uint32_t no_items = 0;
+        memcpy(blk, &t->num_items, 8);
+        memcpy(blk + 8, &no_items, 4);
+        uint8_t* p = blk + _UI_DBG_TRACE_HEADER_SIZE;
+        memcpy(p, &item.tick, 8);
+        memcpy(p + 8, &item.pc, 2);
+        memcpy(p + 10, item.regs, sizeof(item.regs));
+        t->pos = _UI_DBG_TRACE_HEADER_SIZE + _UI_DBG_TRACE_KEYFRAME_SIZE;
+    }
+    else {
+        blk = t->buf + (size_t)t->head * UI_DBG_TRACE_BLOCK_SIZE;
+        uint32_t mask = 0;
+        for (int i = 0; i < UI_DBG_TRACE_NUM_REGS; i++) {
+            if (item.regs[i] != t->last.regs[i]) {
+                mask |= 1U << i;
+            }
+        }
+        const int16_t pc_delta = (int16_t)(item.pc - t->last.pc);
+        uint8_t* p = blk + t->pos;
+        p = _ui_dbg_trace_put_varint(p, mask);
+        p = _ui_dbg_trace_put_varint(p, item.tick - t->last.tick);
+        p = _ui_dbg_trace_put_varint(p, (uint16_t)(((uint16_t)pc_delta << 1) ^ (uint16_t)(pc_delta >> 15)));
+        for (int i = 0; i < UI_DBG_TRACE_NUM_REGS; i++) {
+            if (mask & (1U << i)) {
+                *p++ = (uint8_t)item.regs[i];
+                *p++ = (uint8_t)(item.regs[i] >> 8);
+            }
+        }
+        t->pos = (uint32_t)(p - blk);
+    }
+    uint32_t count;
+    memcpy(&count, blk + 8, 4);
+    count++;
+    memcpy(blk + 8, &count, 4);
+    t->last = item;
+    t->num_items++;
+}
+
+static void _ui_dbg_trace_iter_load_block(ui_dbg_trace_t* t, _ui_dbg_trace_iter_t* it, uint32_t block_index) {
+    const uint8_t* blk = _ui_dbg_trace_block(t, block_index);
+    uint32_t count;
+    memcpy(&it->index, blk, 8);
+    memcpy(&count, blk + 8, 4);
+    const uint8_t* p = blk + _UI_DBG_TRACE_HEADER_SIZE;
+    memcpy(&it->item.tick, p, 8);
+    memcpy(&it->item.pc, p + 8, 2);
+    memcpy(it->item.regs, p + 10, sizeof(it->item.regs));
+    it->ptr = p + _UI_DBG_TRACE_KEYFRAME_SIZE;
+    it->block_index = block_index;
+    it->left = count - 1;
+}
+
+/* advance to the next item, returns false if there is no next item */
+static bool _ui_dbg_trace_iter_next(ui_dbg_trace_t* t, _ui_dbg_trace_iter_t* it) {
+    if (it->left > 0) {
+        uint64_t mask, tick_delta, pc_delta;
+        const uint8_t* p = it->ptr;
+        p = _ui_dbg_trace_get_varint(p, &mask);
+        p = _ui_dbg_trace_get_varint(p, &tick_delta);
+        p = _ui_dbg_trace_get_varint(p, &pc_delta);
+        for (int i = 0; i < UI_DBG_TRACE_NUM_REGS; i++) {
+            if (mask & (1U << i)) {
+                it->item.regs[i] = (uint16_t)(p[0] | (p[1] << 8));
+                p += 2;
+            }
+        }
+        it->item.tick += tick_delta;
+        it->item.pc = (uint16_t)(it->item.pc + (uint16_t)((pc_delta >> 1) ^ (0 - (pc_delta & 1))));
+        it->ptr = p;
+        it->left--;
+        it->index++;
+        return true;
+    }
+    else if ((it->block_index + 1) < t->num_used) {
+        _ui_dbg_trace_iter_load_block(t, it, it->block_index + 1);
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+/* position an iterator at item index (which must be in the trace) */
+static void _ui_dbg_trace_iter_init(ui_dbg_trace_t* t, _ui_dbg_trace_iter_t* it, uint64_t index) {
+    CHIPS_ASSERT((t->num_used > 0) && (index >= _ui_dbg_trace_first(t)) && (index < t->num_items));
+    /* binary search for the last block starting at or before index */
+    uint32_t lo = 0;
+    uint32_t hi = t->num_used - 1;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi + 1) / 2;
+        if (_ui_dbg_trace_block_first(t, mid) <= index) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    _ui_dbg_trace_iter_load_block(t, it, lo);
+    while (it->index < index) {
+        _ui_dbg_trace_iter_next(t, it);
+    }
+}
+
+/* search for an item with pc, older (dir < 0) or newer (dir > 0) than the selected item */
+static void _ui_dbg_trace_find(ui_dbg_t* win, uint16_t pc, int dir) {
+    ui_dbg_trace_t* t = &win->trace;
+    const uint64_t first = _ui_dbg_trace_first(t);
+    if ((t->num_items == 0) || (t->selected < first) || (t->selected >= t->num_items)) {
+        t->selected = (t->num_items > 0) ? (t->num_items - 1) : 0;
+    }
+    if (t->num_items == 0) {
+        return;
+    }
+    _ui_dbg_trace_iter_t it;
+    if (dir < 0) {
+        /* the encoding can only be decoded forward, remember the last hit before the selected item */
+        _ui_dbg_trace_iter_init(t, &it, first);
+        bool found = false;
+        uint64_t found_index = 0;
+        do {
+            if (it.index >= t->selected) {
+                break;
+            }
+            if (it.item.pc == pc) {
+                found = true;
+                found_index = it.index;
+            }
+        } while (_ui_dbg_trace_iter_next(t, &it));
+        if (found) {
+            t->selected = found_index;
+            t->scroll_to_selected = true;
+        }
+    }
+    else {
+        _ui_dbg_trace_iter_init(t, &it, t->selected);
+        while (_ui_dbg_trace_iter_next(t, &it)) {
+            if (it.item.pc == pc) {
+                t->selected = it.index;
+                t->scroll_to_selected = true;
+                break;
+            }
+        }
+    }
+}
+
+static void _ui_dbg_trace_draw_regs(const ui_dbg_trace_item_t* item) {
+    const uint16_t* r = item->regs;
+    #if defined(UI_DBG_USE_Z80)
+        ImGui::Text("AF=%04X BC=%04X DE=%04X HL=%04X IX=%04X IY=%04X SP=%04X", r[0], r[2], r[3], r[1], r[6], r[7], r[4]);
+    #elif defined(UI_DBG_USE_M6502)
+        ImGui::Text("A=%02X X=%02X Y=%02X S=%02X P=%02X", r[0], r[1], r[2], r[3], r[4]);
+    #endif
+}
+
+static void _ui_dbg_trace_draw(ui_dbg_t* win) {
+    ui_dbg_trace_t* t = &win->trace;
+    const uint64_t first = _ui_dbg_trace_first(t);
+    const uint64_t num_avail = t->num_items - first;
+    ImGui::Checkbox("Record", &t->recording);
+    ImGui::SameLine();
+    ImGui::Text("%llu items", (unsigned long long)num_avail);
+    ImGui::SameLine();
+    ImGui::PushItemWidth(ImGui::CalcTextSize("FFFF").x + 8);
+    t->find_pc = ui_util_input_u16("##find_pc", t->find_pc);
+    ImGui::PopItemWidth();
+    ImGui::SameLine();
+    if (ImGui::Button("<< Older")) {
+        _ui_dbg_trace_find(win, t->find_pc, -1);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Newer >>")) {
+        _ui_dbg_trace_find(win, t->find_pc, +1);
+    }
+    ImGui::Separator();
+
+    /* newest item in the first row */
+    const int num_rows = (num_avail > INT32_MAX) ? INT32_MAX : (int)num_avail;
+    ImGui::BeginChild("##trace", ImGui::GetContentRegionAvail(), false);
+    const float line_height = ImGui::GetTextLineHeightWithSpacing();
+    if (t->scroll_to_selected) {
+        t->scroll_to_selected = false;
+        if ((t->selected >= first) && (t->selected < t->num_items)) {
+            const float row = (float)(t->num_items - 1 - t->selected);
+            ImGui::SetScrollY(row * line_height - ImGui::GetWindowHeight() * 0.5f);
+        }
+    }
+    ImGuiListClipper clipper;
+    clipper.Begin(num_rows, line_height);
+    while (clipper.Step()) {
+        const int row0 = clipper.DisplayStart;
+        int row1 = clipper.DisplayEnd;
+        if ((row1 - row0) > _UI_DBG_TRACE_MAX_VISIBLE_ITEMS) {
+            row1 = row0 + _UI_DBG_TRACE_MAX_VISIBLE_ITEMS;
+        }
+        if (row0 >= row1) {
+            continue;
+        }
+        /* decode the visible items oldest to newest, and draw them newest first */
+        ui_dbg_trace_item_t items[_UI_DBG_TRACE_MAX_VISIBLE_ITEMS];
+        const uint64_t newest = t->num_items - 1 - (uint64_t)row0;
+        const uint64_t oldest = t->num_items - 1 - (uint64_t)(row1 - 1);
+        _ui_dbg_trace_iter_t it;
+        _ui_dbg_trace_iter_init(t, &it, oldest);
+        for (uint64_t i = oldest; i <= newest; i++) {
+            items[i - oldest] = it.item;
+            _ui_dbg_trace_iter_next(t, &it);
+        }
+        for (int row = row0; row < row1; row++) {
+            const uint64_t index = t->num_items - 1 - (uint64_t)row;
+            const ui_dbg_trace_item_t* item = &items[index - oldest];
+            ImGui::PushID(row);
+            char label[32];
+            snprintf(label, sizeof(label), "%12llu %04X", (unsigned long long)item->tick, item->pc);
+            if (ImGui::Selectable(label, t->selected == index, 0, ImVec2(ImGui::CalcTextSize(label).x, 0))) {
+                t->selected = index;
+                t->find_pc = item->pc;
+            }
+            ImGui::SameLine();
+            _ui_dbg_disasm(win, item->pc);
+            ImGui::Text(" %-20s", win->dasm_line.chars);
+            ImGui::SameLine();
+            _ui_dbg_trace_draw_regs(item);
+            ImGui::PopID();
+        }
+    }
+    clipper.End();
+    ImGui::EndChild();
 }
 
 /*== HISTORY =================================================================*/
@@ -595,6 +1241,13 @@ static void _ui_dbg_history_draw(ui_dbg_t* win) {
     }
     ImGui::SetNextWindowPos(ImVec2(win->ui.init_x + win->ui.init_w, win->ui.init_y + 64), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(win->ui.init_w, 376), ImGuiCond_Once);
+    if (win->trace.buf) {
+        if (ImGui::Begin("Execution History", &win->ui.show_history)) {
+            _ui_dbg_trace_draw(win);
+        }
+        ImGui::End();
+        return;
+    }
     if (ImGui::Begin("Execution History", &win->ui.show_history)) {
         const float line_height = ImGui::GetTextLineHeight();
         ImGui::SetNextWindowContentSize(ImVec2(0, UI_DBG_NUM_HISTORY_ITEMS * line_height));
@@ -660,6 +1313,335 @@ static void _ui_dbg_history_draw(ui_dbg_t* win) {
 }
 
 
+/*== BREAKPOINT CONDITIONS ===================================================*/
+/* compiled condition ops: (opcode << 16) | 16-bit argument */
+enum {
+    _UI_DBG_BPOP_NUM,   /* push argument */
+    _UI_DBG_BPOP_REG,   /* push register value, argument is _UI_DBG_BPREG_xxx */
+    _UI_DBG_BPOP_PEEK,  /* replace top of stack with memory byte at top of stack */
+    _UI_DBG_BPOP_NOT,
+    _UI_DBG_BPOP_NEG,
+    _UI_DBG_BPOP_LOR,   /* binary ops from here on */
+    _UI_DBG_BPOP_LAND,
+    _UI_DBG_BPOP_EQ,
+    _UI_DBG_BPOP_NE,
+    _UI_DBG_BPOP_LT,
+    _UI_DBG_BPOP_GT,
+    _UI_DBG_BPOP_LE,
+    _UI_DBG_BPOP_GE,
+    _UI_DBG_BPOP_OR,
+    _UI_DBG_BPOP_XOR,
+    _UI_DBG_BPOP_AND,
+    _UI_DBG_BPOP_ADD,
+    _UI_DBG_BPOP_SUB,
+};
+
+/* registers usable in conditions, names in same order */
+enum {
+    _UI_DBG_BPREG_PC,
+    _UI_DBG_BPREG_HITS,
+    #if defined(UI_DBG_USE_Z80)
+    _UI_DBG_BPREG_A, _UI_DBG_BPREG_F, _UI_DBG_BPREG_B, _UI_DBG_BPREG_C,
+    _UI_DBG_BPREG_D, _UI_DBG_BPREG_E, _UI_DBG_BPREG_H, _UI_DBG_BPREG_L,
+    _UI_DBG_BPREG_AF, _UI_DBG_BPREG_BC, _UI_DBG_BPREG_DE, _UI_DBG_BPREG_HL,
+    _UI_DBG_BPREG_IX, _UI_DBG_BPREG_IY, _UI_DBG_BPREG_SP,
+    _UI_DBG_BPREG_I, _UI_DBG_BPREG_R, _UI_DBG_BPREG_WZ,
+    #elif defined(UI_DBG_USE_M6502)
+    _UI_DBG_BPREG_A, _UI_DBG_BPREG_X, _UI_DBG_BPREG_Y, _UI_DBG_BPREG_S, _UI_DBG_BPREG_P,
+    #endif
+    _UI_DBG_BPREG_NUM,
+};
+static const char* _ui_dbg_bp_reg_names[_UI_DBG_BPREG_NUM] = {
+    "PC", "HITS",
+    #if defined(UI_DBG_USE_Z80)
+    "A", "F", "B", "C", "D", "E", "H", "L", "AF", "BC", "DE", "HL", "IX", "IY", "SP", "I", "R", "WZ",
+    #elif defined(UI_DBG_USE_M6502)
+    "A", "X", "Y", "S", "P",
+    #endif
+};
+
+typedef struct {
+    const char* src;
+    ui_dbg_breakpoint_t* bp;
+    int depth;          /* stack depth at current position */
+    const char* error;
+} _ui_dbg_bpc_t;
+
+static void _ui_dbg_bpc_lor(_ui_dbg_bpc_t* c);
+
+static inline bool _ui_dbg_bpc_is_alpha(char ch) {
+    return ((ch >= 'A') && (ch <= 'Z')) || ((ch >= 'a') && (ch <= 'z'));
+}
+
+static inline int _ui_dbg_bpc_hex_digit(char ch) {
+    if ((ch >= '0') && (ch <= '9')) return ch - '0';
+    if ((ch >= 'A') && (ch <= 'F')) return ch - 'A' + 10;
+    if ((ch >= 'a') && (ch <= 'f')) return ch - 'a' + 10;
+    return -1;
+}
+
+static inline char _ui_dbg_bpc_peek(_ui_dbg_bpc_t* c) {
+    while ((*c->src == ' ') || (*c->src == '\t')) {
+        c->src++;
+    }
+    return *c->src;
+}
+
+/* consume an operator token, but not if it's the prefix of a longer operator */
+static bool _ui_dbg_bpc_match(_ui_dbg_bpc_t* c, const char* tok, char not_next) {
+    if (c->error) {
+        return false;
+    }
+    _ui_dbg_bpc_peek(c);
+    const size_t len = strlen(tok);
+    if ((0 == strncmp(c->src, tok, len)) && ((not_next == 0) || (c->src[len] != not_next))) {
+        c->src += len;
+        return true;
+    }
+    return false;
+}
+
+static void _ui_dbg_bpc_emit(_ui_dbg_bpc_t* c, int op, uint16_t arg) {
+    if (c->error) {
+        return;
+    }
+    ui_dbg_breakpoint_t* bp = c->bp;
+    if (bp->num_ops >= UI_DBG_BP_MAX_PROG) {
+        c->error = "expression too long";
+        return;
+    }
+    if ((op == _UI_DBG_BPOP_NUM) || (op == _UI_DBG_BPOP_REG)) {
+        if (++c->depth > UI_DBG_BP_MAX_STACK) {
+            c->error = "expression too complex";
+            return;
+        }
+    } else if (op >= _UI_DBG_BPOP_LOR) {
+        c->depth--;
+    }
+    bp->prog[bp->num_ops++] = ((uint32_t)op << 16) | arg;
+}
+
+static void _ui_dbg_bpc_unary(_ui_dbg_bpc_t* c) {
+    if (c->error) {
+        return;
+    }
+    const char ch = _ui_dbg_bpc_peek(c);
+    if (ch == '!') {
+        c->src++;
+        _ui_dbg_bpc_unary(c);
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_NOT, 0);
+    } else if (ch == '-') {
+        c->src++;
+        _ui_dbg_bpc_unary(c);
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_NEG, 0);
+    } else if (ch == '(') {
+        c->src++;
+        _ui_dbg_bpc_lor(c);
+        if (!_ui_dbg_bpc_match(c, ")", 0)) {
+            if (!c->error) {
+                c->error = "missing ')'";
+            }
+            return;
+        }
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_PEEK, 0);
+    } else if ((ch == '$') || ((ch >= '0') && (ch <= '9'))) {
+        if (ch == '$') {
+            c->src++;
+        } else if ((c->src[0] == '0') && ((c->src[1] == 'x') || (c->src[1] == 'X'))) {
+            c->src += 2;
+        }
+        uint32_t val = 0;
+        int num_digits = 0;
+        int digit;
+        while ((digit = _ui_dbg_bpc_hex_digit(*c->src)) >= 0) {
+            val = (val << 4) | (uint32_t)digit;
+            c->src++;
+            num_digits++;
+        }
+        if ((num_digits == 0) || (val > 0xFFFF)) {
+            c->error = "invalid number";
+            return;
+        }
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_NUM, (uint16_t)val);
+    } else if (_ui_dbg_bpc_is_alpha(ch)) {
+        char name[8];
+        size_t len = 0;
+        while (_ui_dbg_bpc_is_alpha(*c->src) && (len < (sizeof(name) - 1))) {
+            char n = *c->src++;
+            name[len++] = ((n >= 'a') && (n <= 'z')) ? (char)(n - 'a' + 'A') : n;
+        }
+        name[len] = 0;
+        for (int i = 0; i < _UI_DBG_BPREG_NUM; i++) {
+            if (0 == strcmp(name, _ui_dbg_bp_reg_names[i])) {
+                _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_REG, (uint16_t)i);
+                return;
+            }
+        }
+        c->error = "unknown register";
+    } else {
+        c->error = (ch == 0) ? "unexpected end of expression" : "unexpected character";
+    }
+}
+
+static void _ui_dbg_bpc_sum(_ui_dbg_bpc_t* c) {
+    _ui_dbg_bpc_unary(c);
+    while (!c->error) {
+        if (_ui_dbg_bpc_match(c, "+", 0))      { _ui_dbg_bpc_unary(c); _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_ADD, 0); }
+        else if (_ui_dbg_bpc_match(c, "-", 0)) { _ui_dbg_bpc_unary(c); _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_SUB, 0); }
+        else break;
+    }
+}
+
+static void _ui_dbg_bpc_bits(_ui_dbg_bpc_t* c) {
+    _ui_dbg_bpc_sum(c);
+    while (!c->error) {
+        if (_ui_dbg_bpc_match(c, "|", '|'))      { _ui_dbg_bpc_sum(c); _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_OR, 0); }
+        else if (_ui_dbg_bpc_match(c, "^", 0))   { _ui_dbg_bpc_sum(c); _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_XOR, 0); }
+        else if (_ui_dbg_bpc_match(c, "&", '&')) { _ui_dbg_bpc_sum(c); _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_AND, 0); }
+        else break;
+    }
+}
+
+static void _ui_dbg_bpc_cmp(_ui_dbg_bpc_t* c) {
+    _ui_dbg_bpc_bits(c);
+    while (!c->error) {
+        int op;
+        if (_ui_dbg_bpc_match(c, "==", 0))      op = _UI_DBG_BPOP_EQ;
+        else if (_ui_dbg_bpc_match(c, "!=", 0)) op = _UI_DBG_BPOP_NE;
+        else if (_ui_dbg_bpc_match(c, "<=", 0)) op = _UI_DBG_BPOP_LE;
+        else if (_ui_dbg_bpc_match(c, ">=", 0)) op = _UI_DBG_BPOP_GE;
+        else if (_ui_dbg_bpc_match(c, "<", 0))  op = _UI_DBG_BPOP_LT;
+        else if (_ui_dbg_bpc_match(c, ">", 0))  op = _UI_DBG_BPOP_GT;
+        else break;
+        _ui_dbg_bpc_bits(c);
+        _ui_dbg_bpc_emit(c, op, 0);
+    }
+}
+
+static void _ui_dbg_bpc_land(_ui_dbg_bpc_t* c) {
+    _ui_dbg_bpc_cmp(c);
+    while (_ui_dbg_bpc_match(c, "&&", 0)) {
+        _ui_dbg_bpc_cmp(c);
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_LAND, 0);
+    }
+}
+
+static void _ui_dbg_bpc_lor(_ui_dbg_bpc_t* c) {
+    _ui_dbg_bpc_land(c);
+    while (_ui_dbg_bpc_match(c, "||", 0)) {
+        _ui_dbg_bpc_land(c);
+        _ui_dbg_bpc_emit(c, _UI_DBG_BPOP_LOR, 0);
+    }
+}
+
+/* compile the breakpoint's condition expression, returns false on error */
+static bool _ui_dbg_bp_compile(ui_dbg_breakpoint_t* bp) {
+    bp->num_ops = 0;
+    bp->expr_error = 0;
+    bp->hits = 0;
+    _ui_dbg_bpc_t c;
+    memset(&c, 0, sizeof(c));
+    c.src = bp->expr;
+    c.bp = bp;
+    if (_ui_dbg_bpc_peek(&c) == 0) {
+        /* no condition */
+        return true;
+    }
+    _ui_dbg_bpc_lor(&c);
+    if (!c.error && (_ui_dbg_bpc_peek(&c) != 0)) {
+        c.error = "unexpected character";
+    }
+    if (c.error) {
+        bp->num_ops = 0;
+        bp->expr_error = c.error;
+        return false;
+    }
+    return true;
+}
+
+static int _ui_dbg_bp_reg(ui_dbg_t* win, const ui_dbg_breakpoint_t* bp, int reg, uint16_t pc) {
+    #if defined(UI_DBG_USE_Z80)
+        const z80_t* cpu = win->dbg.z80;
+    #elif defined(UI_DBG_USE_M6502)
+        const m6502_t* cpu = win->dbg.m6502;
+    #endif
+    switch (reg) {
+        case _UI_DBG_BPREG_PC:      return pc;
+        case _UI_DBG_BPREG_HITS:    return (int) bp->hits;
+        #if defined(UI_DBG_USE_Z80)
+        case _UI_DBG_BPREG_A:       return cpu->af >> 8;
+        case _UI_DBG_BPREG_F:       return cpu->af & 0xFF;
+        case _UI_DBG_BPREG_B:       return cpu->bc >> 8;
+        case _UI_DBG_BPREG_C:       return cpu->bc & 0xFF;
+        case _UI_DBG_BPREG_D:       return cpu->de >> 8;
+        case _UI_DBG_BPREG_E:       return cpu->de & 0xFF;
+        case _UI_DBG_BPREG_H:       return cpu->hl >> 8;
+        case _UI_DBG_BPREG_L:       return cpu->hl & 0xFF;
+        case _UI_DBG_BPREG_AF:      return cpu->af;
+        case _UI_DBG_BPREG_BC:      return cpu->bc;
+        case _UI_DBG_BPREG_DE:      return cpu->de;
+        case _UI_DBG_BPREG_HL:      return cpu->hl;
+        case _UI_DBG_BPREG_IX:      return cpu->ix;
+        case _UI_DBG_BPREG_IY:      return cpu->iy;
+        case _UI_DBG_BPREG_SP:      return cpu->sp;
+        case _UI_DBG_BPREG_I:       return cpu->ir >> 8;
+        case _UI_DBG_BPREG_R:       return cpu->ir & 0xFF;
+        case _UI_DBG_BPREG_WZ:      return cpu->wz;
+        #elif defined(UI_DBG_USE_M6502)
+        case _UI_DBG_BPREG_A:       return cpu->A;
+        case _UI_DBG_BPREG_X:       return cpu->X;
+        case _UI_DBG_BPREG_Y:       return cpu->Y;
+        case _UI_DBG_BPREG_S:       return cpu->S;
+        case _UI_DBG_BPREG_P:       return cpu->P;
+        #endif
+        default:                    return 0;
+    }
+}
+
+/* called when the breakpoint's trigger fired, counts the hit and evaluates the condition */
+static bool _ui_dbg_bp_check_cond(ui_dbg_t* win, ui_dbg_breakpoint_t* bp, uint16_t pc) {
+    bp->hits++;
+    if (bp->num_ops == 0) {
+        /* no condition, only the 'Condition' type needs one */
+        return bp->type != UI_DBG_BREAKTYPE_COND;
+    }
+    int stack[UI_DBG_BP_MAX_STACK];
+    int sp = 0;
+    for (int i = 0; i < bp->num_ops; i++) {
+        const int op = (int)(bp->prog[i] >> 16);
+        const uint16_t arg = (uint16_t)bp->prog[i];
+        if (op >= _UI_DBG_BPOP_LOR) {
+            const int r = stack[--sp];
+            int* l = &stack[sp - 1];
+            switch (op) {
+                case _UI_DBG_BPOP_LOR:  *l = (*l != 0) || (r != 0); break;
+                case _UI_DBG_BPOP_LAND: *l = (*l != 0) && (r != 0); break;
+                case _UI_DBG_BPOP_EQ:   *l = *l == r; break;
+                case _UI_DBG_BPOP_NE:   *l = *l != r; break;
+                case _UI_DBG_BPOP_LT:   *l = *l < r; break;
+                case _UI_DBG_BPOP_GT:   *l = *l > r; break;
+                case _UI_DBG_BPOP_LE:   *l = *l <= r; break;
+                case _UI_DBG_BPOP_GE:   *l = *l >= r; break;
+                case _UI_DBG_BPOP_OR:   *l = *l | r; break;
+                case _UI_DBG_BPOP_XOR:  *l = *l ^ r; break;
+                case _UI_DBG_BPOP_AND:  *l = *l & r; break;
+                case _UI_DBG_BPOP_ADD:  *l = *l + r; break;
+                case _UI_DBG_BPOP_SUB:  *l = *l - r; break;
+            }
+        } else {
+            switch (op) {
+                case _UI_DBG_BPOP_NUM:  stack[sp++] = arg; break;
+                case _UI_DBG_BPOP_REG:  stack[sp++] = _ui_dbg_bp_reg(win, bp, arg, pc); break;
+                case _UI_DBG_BPOP_PEEK: stack[sp - 1] = _ui_dbg_read_byte(win, (uint16_t)stack[sp - 1]); break;
+                case _UI_DBG_BPOP_NOT:  stack[sp - 1] = !stack[sp - 1]; break;
+                case _UI_DBG_BPOP_NEG:  stack[sp - 1] = -stack[sp - 1]; break;
+            }
+        }
+    }
+    CHIPS_ASSERT(sp == 1);
+    return stack[0] != 0;
+}
+
 /*== DEBUGGER STATE ==========================================================*/
 static void _ui_dbg_dbgstate_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
     ui_dbg_state_t* dbg = &win->dbg;
@@ -670,6 +1652,8 @@ static void _ui_dbg_dbgstate_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
         CHIPS_ASSERT(desc->m6502);
         dbg->m6502 = desc->m6502;
     #endif
+    dbg->tick = desc->tick;
+    dbg->last_tick = desc->tick ? *desc->tick : 0;
     dbg->delete_breakpoint_index = -1;
 }
 
@@ -705,52 +1689,49 @@ static int _ui_dbg_eval_op_breakpoints(ui_dbg_t* win, int trap_id, uint16_t pc)
                 break;
         }
     } else {
-        for (int i = 0; (i < win->dbg.num_breakpoints) && (trap_id == 0); i++) {
-            const ui_dbg_breakpoint_t* bp = &win->dbg.breakpoints[i];
-            if (bp->enabled) {
-                switch (bp->type) {
-                    case UI_DBG_BREAKTYPE_EXEC:
-                        if (pc == bp->addr) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
+        ui_dbg_state_t* dbg = &win->dbg;
+        if (chips_breakmap_test(dbg->breakmap.exec, pc)) {
+            for (int j = 0; (j < dbg->num_exec_bps) && (trap_id == 0); j++) {
+                const int i = dbg->exec_bps[j];
+                ui_dbg_breakpoint_t* bp = &dbg->breakpoints[i];
+                if ((pc == bp->addr) && _ui_dbg_bp_check_cond(win, bp, pc)) {
+                    trap_id = UI_DBG_BP_BASE_TRAPID + i;
+                }
+            }
+        }
+        for (int j = 0; (j < dbg->num_op_bps) && (trap_id == 0); j++) {
+            const int i = dbg->op_bps[j];
+            ui_dbg_breakpoint_t* bp = &dbg->breakpoints[i];
+            switch (bp->type) {
+                case UI_DBG_BREAKTYPE_BYTE:
+                case UI_DBG_BREAKTYPE_WORD:
+                    {
+                        int val;
+                        if (bp->type == UI_DBG_BREAKTYPE_BYTE) {
+                            val = (int) _ui_dbg_read_byte(win, bp->addr);
+                        } else {
+                            val = (int) _ui_dbg_read_word(win, bp->addr);
                         }
-                        break;
-
-                    case UI_DBG_BREAKTYPE_BYTE:
-                        {
-                            int val = (int) _ui_dbg_read_byte(win, bp->addr);
-                            bool b = false;
-                            switch (bp->cond) {
-                                case UI_DBG_BREAKCOND_EQUAL:            b = val == bp->val; break;
-                                case UI_DBG_BREAKCOND_NONEQUAL:         b = val != bp->val; break;
-                                case UI_DBG_BREAKCOND_GREATER:          b = val > bp->val; break;
-                                case UI_DBG_BREAKCOND_LESS:             b = val < bp->val; break;
-                                case UI_DBG_BREAKCOND_GREATER_EQUAL:    b = val >= bp->val; break;
-                                case UI_DBG_BREAKCOND_LESS_EQUAL:       b = val <= bp->val; break;
-                            }
-                            if (b) {
-                                trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                            }
+                        bool b = false;
+                        switch (bp->cond) {
+                            case UI_DBG_BREAKCOND_EQUAL:            b = val == bp->val; break;
+                            case UI_DBG_BREAKCOND_NONEQUAL:         b = val != bp->val; break;
+                            case UI_DBG_BREAKCOND_GREATER:          b = val > bp->val; break;
+                            case UI_DBG_BREAKCOND_LESS:             b = val < bp->val; break;
+                            case UI_DBG_BREAKCOND_GREATER_EQUAL:    b = val >= bp->val; break;
+                            case UI_DBG_BREAKCOND_LESS_EQUAL:       b = val <= bp->val; break;
                         }
-                        break;
-
-                    case UI_DBG_BREAKTYPE_WORD:
-                        {
-                            uint16_t val = (int) _ui_dbg_read_word(win, bp->addr);
-                            bool b = false;
-                            switch (bp->cond) {
-                                case UI_DBG_BREAKCOND_EQUAL:            b = val == bp->val; break;
-                                case UI_DBG_BREAKCOND_NONEQUAL:         b = val != bp->val; break;
-                                case UI_DBG_BREAKCOND_GREATER:          b = val > bp->val; break;
-                                case UI_DBG_BREAKCOND_LESS:             b = val < bp->val; break;
-                                case UI_DBG_BREAKCOND_GREATER_EQUAL:    b = val >= bp->val; break;
-                                case UI_DBG_BREAKCOND_LESS_EQUAL:       b = val <= bp->val; break;
-                            }
-                            if (b) {
-                                trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                            }
+                        if (b && _ui_dbg_bp_check_cond(win, bp, pc)) {
+                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
                         }
-                        break;
-                }
+                    }
+                    break;
+
+                case UI_DBG_BREAKTYPE_COND:
+                    if (_ui_dbg_bp_check_cond(win, bp, pc)) {
+                        trap_id = UI_DBG_BP_BASE_TRAPID + i;
+                    }
+                    break;
             }
         }
     }
@@ -760,64 +1741,70 @@ static int _ui_dbg_eval_op_breakpoints(ui_dbg_t* win, int trap_id, uint16_t pc)
 //  evaluate per-tick breakpoints, only call this if is dbg.step_mode is UI_DBG_STEPMODE_NONE!
 static int _ui_dbg_eval_tick_breakpoints(ui_dbg_t* win, int trap_id, uint64_t pins) {
     uint64_t rising_pins = pins & (pins ^ win->dbg.last_tick_pins);
-    for (int i = 0; (i < win->dbg.num_breakpoints) && (trap_id == 0); i++) {
-        const ui_dbg_breakpoint_t* bp = &win->dbg.breakpoints[i];
-        if (bp->enabled) {
-            switch (bp->type) {
-                case UI_DBG_BREAKTYPE_IRQ:
-                    #if defined(UI_DBG_USE_Z80)
-                        if (Z80_INT & rising_pins) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    #elif defined(UI_DBG_USE_M6502)
-                        if (M6502_IRQ & rising_pins) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    #endif
-                    break;
-
-                case UI_DBG_BREAKTYPE_NMI:
-                    #if defined(UI_DBG_USE_Z80)
-                        if (Z80_NMI & rising_pins) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    #elif defined(UI_DBG_USE_M6502)
-                        if (M6502_NMI & rising_pins) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    #endif
-                    break;
-
+    for (int j = 0; (j < win->dbg.num_tick_bps) && (trap_id == 0); j++) {
+        const int i = win->dbg.tick_bps[j];
+        ui_dbg_breakpoint_t* bp = &win->dbg.breakpoints[i];
+        bool fired = false;
+        switch (bp->type) {
+            case UI_DBG_BREAKTYPE_IRQ:
                 #if defined(UI_DBG_USE_Z80)
-                case UI_DBG_BREAKTYPE_OUT:
-                    if ((pins & Z80_CTRL_PIN_MASK) == (Z80_IORQ|Z80_WR)) {
-                        const uint16_t mask = bp->val;
-                        if ((Z80_GET_ADDR(pins) & mask) == (bp->addr & mask)) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    }
-                    break;
+                    fired = 0 != (Z80_INT & rising_pins);
+                #elif defined(UI_DBG_USE_M6502)
+                    fired = 0 != (M6502_IRQ & rising_pins);
+                #endif
+                break;
 
-                case UI_DBG_BREAKTYPE_IN:
-                    if ((pins & Z80_CTRL_PIN_MASK) == (Z80_IORQ|Z80_RD)) {
-                        const uint16_t mask = bp->val;
-                        if ((Z80_GET_ADDR(pins) & mask) == (bp->addr & mask)) {
-                            trap_id = UI_DBG_BP_BASE_TRAPID + i;
-                        }
-                    }
-                    break;
+            case UI_DBG_BREAKTYPE_NMI:
+                #if defined(UI_DBG_USE_Z80)
+                    fired = 0 != (Z80_NMI & rising_pins);
+                #elif defined(UI_DBG_USE_M6502)
+                    fired = 0 != (M6502_NMI & rising_pins);
                 #endif
-            }
+                break;
+
+            #if defined(UI_DBG_USE_Z80)
+            case UI_DBG_BREAKTYPE_OUT:
+                if ((pins & Z80_CTRL_PIN_MASK) == (Z80_IORQ|Z80_WR)) {
+                    const uint16_t mask = bp->val;
+                    fired = (Z80_GET_ADDR(pins) & mask) == (bp->addr & mask);
+                }
+                break;
+
+            case UI_DBG_BREAKTYPE_IN:
+                if ((pins & Z80_CTRL_PIN_MASK) == (Z80_IORQ|Z80_RD)) {
+                    const uint16_t mask = bp->val;
+                    fired = (Z80_GET_ADDR(pins) & mask) == (bp->addr & mask);
+                }
+                break;
+            #endif
+        }
+        if (fired && _ui_dbg_bp_check_cond(win, bp, win->dbg.cur_op_pc)) {
+            trap_id = UI_DBG_BP_BASE_TRAPID + i;
         }
     }
 
     // call optional user-breakpoint evaluation callback
     if ((0 == trap_id) && win->break_cb) {
         trap_id = win->break_cb(win, trap_id, pins, win->user_data);
+        // the user callback doesn't know about conditions, check those here
+        const int i = trap_id - UI_DBG_BP_BASE_TRAPID;
+        if ((i >= 0) && (i < win->dbg.num_breakpoints)) {
+            if (!_ui_dbg_bp_check_cond(win, &win->dbg.breakpoints[i], win->dbg.cur_op_pc)) {
+                trap_id = 0;
+            }
+        }
     }
     return trap_id;
 }
 
+/* clear the condition of a new breakpoint */
+static void _ui_dbg_bp_clear_cond(ui_dbg_breakpoint_t* bp) {
+    bp->hits = 0;
+    bp->expr[0] = 0;
+    bp->expr_error = 0;
+    bp->num_ops = 0;
+}
+
 /* add an execution breakpoint */
 static bool _ui_dbg_bp_add_exec(ui_dbg_t* win, bool enabled, uint16_t addr) {
     if (win->dbg.num_breakpoints < UI_DBG_MAX_BREAKPOINTS) {
@@ -827,6 +1814,8 @@ static bool _ui_dbg_bp_add_exec(ui_dbg_t* win, bool enabled, uint16_t addr) {
         bp->addr = addr;
         bp->val = 0;
         bp->enabled = enabled;
+        _ui_dbg_bp_clear_cond(bp);
+        _ui_dbg_breakmap_update(win);
         return true;
     } else {
         /* no more breakpoint slots */
@@ -843,6 +1832,8 @@ static bool _ui_dbg_bp_add_byte(ui_dbg_t* win, bool enabled, uint16_t addr) {
         bp->addr = addr;
         bp->val = _ui_dbg_read_byte(win, addr);
         bp->enabled = enabled;
+        _ui_dbg_bp_clear_cond(bp);
+        _ui_dbg_breakmap_update(win);
         return true;
     } else {
         /* no more breakpoint slots */
@@ -859,6 +1850,8 @@ static bool _ui_dbg_bp_add_word(ui_dbg_t* win, bool enabled, uint16_t addr) {
         bp->addr = addr;
         bp->val = _ui_dbg_read_word(win, addr);
         bp->enabled = enabled;
+        _ui_dbg_bp_clear_cond(bp);
+        _ui_dbg_breakmap_update(win);
         return true;
     } else {
         /* no more breakpoint slots */
@@ -884,6 +1877,7 @@ static void _ui_dbg_bp_del(ui_dbg_t* win, int index) {
             win->dbg.breakpoints[i] = win->dbg.breakpoints[i+1];
         }
         win->dbg.num_breakpoints--;
+        _ui_dbg_breakmap_update(win);
     }
 }
 
@@ -913,6 +1907,7 @@ static void _ui_dbg_bp_disable_all(ui_dbg_t* win) {
     for (int i = 0; i < win->dbg.num_breakpoints; i++) {
         win->dbg.breakpoints[i].enabled = false;
     }
+    _ui_dbg_breakmap_update(win);
 }
 
 /* enable all breakpoints */
@@ -920,11 +1915,13 @@ static void _ui_dbg_bp_enable_all(ui_dbg_t* win) {
     for (int i = 0; i < win->dbg.num_breakpoints; i++) {
         win->dbg.breakpoints[i].enabled = true;
     }
+    _ui_dbg_breakmap_update(win);
 }
 
 /* delete all breakpoints */
 static void _ui_dbg_bp_delete_all(ui_dbg_t* win) {
     win->dbg.num_breakpoints = 0;
+    _ui_dbg_breakmap_update(win);
 }
 
 /* draw the "Delete all breakpoints" popup modal */
@@ -1048,6 +2045,27 @@ static void _ui_dbg_bp_draw(ui_dbg_t* win) {
                 }
             }
             ImGui::SameLine();
+            ImGui::TextUnformatted("if");
+            ImGui::SameLine();
+            ImGui::PushItemWidth(144);
+            if (bp->expr_error) {
+                ImGui::PushStyleColor(ImGuiCol_Text, 0xFF4040FF);
+            }
+            if (ImGui::InputText("##expr", bp->expr, sizeof(bp->expr))) {
+                _ui_dbg_bp_compile(bp);
+            }
+            if (bp->expr_error) {
+                ImGui::PopStyleColor();
+            }
+            ImGui::PopItemWidth();
+            if (ImGui::IsItemHovered()) {
+                if (bp->expr_error) {
+                    ImGui::SetTooltip("%s", bp->expr_error);
+                } else {
+                    ImGui::SetTooltip("Condition, e.g. A==3F && (HL)>80\nhits: %u", bp->hits);
+                }
+            }
+            ImGui::SameLine();
             if (ImGui::Button("Del")) {
                 del_bp_index = i;
             }
@@ -1350,6 +2368,364 @@ static void _ui_dbg_stopwatch_draw(ui_dbg_t* win) {
     ImGui::End();
 }
 
+/*== PROFILER ================================================================*/
+/* max length of a folded stacks line: all frames plus tick count */
+#define _UI_DBG_PROF_MAX_LINE ((UI_DBG_PROF_MAX_DEPTH + 1) * 6 + 24)
+
+static void _ui_dbg_prof_reset(ui_dbg_t* win) {
+    ui_dbg_profiler_t* p = &win->prof;
+    p->op_valid = false;
+    p->int_ack = false;
+    p->depth = 0;
+    p->total_ticks = 0;
+    p->nodes_full = false;
+    p->sample_countdown = p->sample_interval;
+    memset(p->nodes, 0, sizeof(p->nodes));
+    p->num_nodes = 1;   /* node 0 is the root */
+    p->num_funcs = 0;
+}
+
+static void _ui_dbg_prof_init(ui_dbg_t* win) {
+    win->prof.sample_interval = 64;
+    _ui_dbg_prof_reset(win);
+}
+
+static inline uint16_t _ui_dbg_prof_get_sp(ui_dbg_t* win) {
+    #if defined(UI_DBG_USE_Z80)
+        return win->dbg.z80->sp;
+    #elif defined(UI_DBG_USE_M6502)
+        return win->dbg.m6502->S;
+    #endif
+}
+
+static inline uint16_t _ui_dbg_prof_cur_node(ui_dbg_profiler_t* p) {
+    return (p->depth > 0) ? p->stack[p->depth - 1].node : 0;
+}
+
+/* find or create the child node of the current node */
+static uint16_t _ui_dbg_prof_child(ui_dbg_profiler_t* p, uint16_t addr, uint8_t kind) {
+    const uint16_t parent = _ui_dbg_prof_cur_node(p);
+    uint16_t i = p->nodes[parent].first_child;
+    while (i != 0) {
+        if ((p->nodes[i].addr == addr) && (p->nodes[i].kind == kind)) {
+            return i;
+        }
+        i = p->nodes[i].next_sibling;
+    }
+    if (p->num_nodes >= UI_DBG_PROF_MAX_NODES) {
+        /* node pool full, attribute to the caller */
+        p->nodes_full = true;
+        return parent;
+    }
+    i = (uint16_t) p->num_nodes++;
+    ui_dbg_prof_node_t* node = &p->nodes[i];
+    node->addr = addr;
+    node->kind = kind;
+    node->parent = parent;
+    node->next_sibling = p->nodes[parent].first_child;
+    p->nodes[parent].first_child = i;
+    return i;
+}
+
+static void _ui_dbg_prof_push(ui_dbg_profiler_t* p, uint16_t addr, uint8_t kind, uint16_t sp) {
+    if (p->depth < UI_DBG_PROF_MAX_DEPTH) {
+        const uint16_t node = _ui_dbg_prof_child(p, addr, kind);
+        p->nodes[node].calls++;
+        p->stack[p->depth].node = node;
+        p->stack[p->depth].sp = sp;
+        p->depth++;
+    }
+    /* otherwise the untracked frame is merged into the deepest tracked frame,
+       returns from it don't move the stack pointer above the tracked frames */
+}
+
+/* classify the previous instruction which dropped the stack pointer from old_sp to new_sp */
+static void _ui_dbg_prof_stack_dropped(ui_dbg_t* win, uint16_t pc, uint16_t old_sp, uint16_t new_sp) {
+    ui_dbg_profiler_t* p = &win->prof;
+    const uint8_t op = _ui_dbg_read_byte(win, p->op_pc);
+    const uint16_t dropped = old_sp - new_sp;
+    #if defined(UI_DBG_USE_Z80)
+        if (dropped == 2) {
+            /* an NMI pushes the address of the instruction which didn't execute (+1 when halted) */
+            if ((pc == 0x0066) && ((uint16_t)(_ui_dbg_read_word(win, new_sp) - p->op_pc) <= 1)) {
+                _ui_dbg_prof_push(p, pc, UI_DBG_PROF_KIND_INT, new_sp);
+            }
+            /* CALL nn, CALL cc,nn or RST n */
+            else if ((op == 0xCD) || ((op & 0xC7) == 0xC4) || ((op & 0xC7) == 0xC7)) {
+                _ui_dbg_prof_push(p, pc, UI_DBG_PROF_KIND_CALL, new_sp);
+            }
+        }
+    #elif defined(UI_DBG_USE_M6502)
+        /* the stack pointer is only 8 bits */
+        if ((dropped & 0xFF) == 2) {
+            if (op == 0x20) {
+                _ui_dbg_prof_push(p, pc, UI_DBG_PROF_KIND_CALL, new_sp);
+            }
+        }
+        else if ((dropped & 0xFF) == 3) {
+            /* IRQ, NMI or BRK */
+            _ui_dbg_prof_push(p, pc, UI_DBG_PROF_KIND_INT, new_sp);
+        }
+    #endif
+}
+
+/* update the shadow call stack after the previous instruction, which continued at pc with stack pointer sp */
+static void _ui_dbg_prof_stack_moved(ui_dbg_t* win, uint16_t pc, uint16_t sp) {
+    ui_dbg_profiler_t* p = &win->prof;
+    if (sp != p->op_sp) {
+        /* pop all frames whose return address has been popped */
+        while ((p->depth > 0) && (sp > p->stack[p->depth - 1].sp)) {
+            p->depth--;
+        }
+        if (sp < p->op_sp) {
+            _ui_dbg_prof_stack_dropped(win, pc, p->op_sp, sp);
+        }
+    }
+}
+
+/* called at the start of each instruction */
+static void _ui_dbg_prof_op(ui_dbg_t* win, uint16_t pc) {
+    ui_dbg_profiler_t* p = &win->prof;
+    const uint16_t sp = _ui_dbg_prof_get_sp(win);
+    if (p->op_valid) {
+        /* charge the previous instruction to the frame it executed in */
+        if (!p->sampling) {
+            p->nodes[_ui_dbg_prof_cur_node(p)].self_ticks += win->dbg.cur_op_ticks;
+            p->total_ticks += win->dbg.cur_op_ticks;
+        }
+        #if defined(UI_DBG_USE_Z80)
+        if (p->int_ack) {
+            /* a maskable interrupt doesn't start with an opcode fetch, so the
+               interrupted instruction and the interrupt are seen as one, first
+               handle the instruction which continued at the pushed return address
+            */
+            p->int_ack = false;
+            _ui_dbg_prof_stack_moved(win, _ui_dbg_read_word(win, sp), (uint16_t)(sp + 2));
+            _ui_dbg_prof_push(p, pc, UI_DBG_PROF_KIND_INT, sp);
+        }
+        else
+        #endif
+        {
+            _ui_dbg_prof_stack_moved(win, pc, sp);
+        }
+    }
+    p->op_pc = pc;
+    p->op_sp = sp;
+    p->op_valid = true;
+}
+
+/* called on each tick while profiling */
+static void _ui_dbg_prof_tick(ui_dbg_t* win, uint64_t pins) {
+    ui_dbg_profiler_t* p = &win->prof;
+    #if defined(UI_DBG_USE_Z80)
+        if ((pins & (Z80_M1|Z80_IORQ)) == (Z80_M1|Z80_IORQ)) {
+            p->int_ack = true;
+        }
+    #else
+        (void)pins;
+    #endif
+    if (p->sampling && (--p->sample_countdown <= 0)) {
+        /* charge the whole sample interval to the current frame */
+        p->sample_countdown = p->sample_interval;
+        p->nodes[_ui_dbg_prof_cur_node(p)].self_ticks += (uint64_t) p->sample_interval;
+        p->total_ticks += (uint64_t) p->sample_interval;
+    }
+}
+
+static void _ui_dbg_prof_update_totals(ui_dbg_t* win) {
+    ui_dbg_profiler_t* p = &win->prof;
+    for (int i = 0; i < p->num_nodes; i++) {
+        p->nodes[i].total_ticks = p->nodes[i].self_ticks;
+    }
+    /* child nodes are always created after their parent */
+    for (int i = p->num_nodes - 1; i > 0; i--) {
+        p->nodes[p->nodes[i].parent].total_ticks += p->nodes[i].total_ticks;
+    }
+}
+
+/* write a folded stacks line for a node with self ticks, returns length */
+static int _ui_dbg_prof_folded_line(ui_dbg_t* win, int node_index, char* buf, int buf_size) {
+    const ui_dbg_profiler_t* p = &win->prof;
+    const ui_dbg_prof_node_t* node = &p->nodes[node_index];
+    if (node->self_ticks == 0) {
+        return 0;
+    }
+    uint16_t path[UI_DBG_PROF_MAX_DEPTH + 1];
+    int depth = 0;
+    for (int i = node_index; (i != 0) && (depth < (UI_DBG_PROF_MAX_DEPTH + 1)); i = p->nodes[i].parent) {
+        path[depth++] = (uint16_t) i;
+    }
+    int len = snprintf(buf, (size_t)buf_size, "root");
+    while ((depth > 0) && (len < buf_size)) {
+        const ui_dbg_prof_node_t* n = &p->nodes[path[--depth]];
+        len += snprintf(buf + len, (size_t)(buf_size - len), (n->kind == UI_DBG_PROF_KIND_INT) ? ";int_%04X" : ";%04X", n->addr);
+    }
+    if (len < buf_size) {
+        len += snprintf(buf + len, (size_t)(buf_size - len), " %llu\n", (unsigned long long)node->self_ticks);
+    }
+    return (len < buf_size) ? len : (buf_size - 1);
+}
+
+static int _ui_dbg_prof_cmp_addr(const void* a, const void* b) {
+    const ui_dbg_prof_func_t* fa = (const ui_dbg_prof_func_t*) a;
+    const ui_dbg_prof_func_t* fb = (const ui_dbg_prof_func_t*) b;
+    const int ka = (fa->kind << 16) | fa->addr;
+    const int kb = (fb->kind << 16) | fb->addr;
+    return ka - kb;
+}
+
+static int _ui_dbg_prof_cmp_ticks(const void* a, const void* b) {
+    const ui_dbg_prof_func_t* fa = (const ui_dbg_prof_func_t*) a;
+    const ui_dbg_prof_func_t* fb = (const ui_dbg_prof_func_t*) b;
+    return (fa->self_ticks < fb->self_ticks) ? 1 : ((fa->self_ticks > fb->self_ticks) ? -1 : 0);
+}
+
+/* merge all nodes of the same function into the flat report */
+static void _ui_dbg_prof_update_flat(ui_dbg_t* win) {
+    ui_dbg_profiler_t* p = &win->prof;
+    for (int i = 0; i < p->num_nodes; i++) {
+        p->funcs[i].addr = p->nodes[i].addr;
+        p->funcs[i].kind = p->nodes[i].kind;
+        p->funcs[i].calls = p->nodes[i].calls;
+        p->funcs[i].self_ticks = p->nodes[i].self_ticks;
+    }
+    qsort(p->funcs, (size_t)p->num_nodes, sizeof(ui_dbg_prof_func_t), _ui_dbg_prof_cmp_addr);
+    int num = 0;
+    for (int i = 0; i < p->num_nodes; i++) {
+        if ((num > 0) && (0 == _ui_dbg_prof_cmp_addr(&p->funcs[num - 1], &p->funcs[i]))) {
+            p->funcs[num - 1].calls += p->funcs[i].calls;
+            p->funcs[num - 1].self_ticks += p->funcs[i].self_ticks;
+        }
+        else {
+            p->funcs[num++] = p->funcs[i];
+        }
+    }
+    p->num_funcs = num;
+    qsort(p->funcs, (size_t)p->num_funcs, sizeof(ui_dbg_prof_func_t), _ui_dbg_prof_cmp_ticks);
+}
+
+static const char* _ui_dbg_prof_label(char* buf, size_t buf_size, uint8_t kind, uint16_t addr) {
+    switch (kind) {
+        case UI_DBG_PROF_KIND_ROOT: snprintf(buf, buf_size, "root"); break;
+        case UI_DBG_PROF_KIND_INT:  snprintf(buf, buf_size, "int %04X", addr); break;
+        default:                    snprintf(buf, buf_size, "%04X", addr); break;
+    }
+    return buf;
+}
+
+static inline float _ui_dbg_prof_percent(ui_dbg_t* win, uint64_t ticks) {
+    return (win->prof.total_ticks > 0) ? (float)(((double)ticks * 100.0) / (double)win->prof.total_ticks) : 0.0f;
+}
+
+static void _ui_dbg_prof_draw_node(ui_dbg_t* win, uint16_t index) {
+    const ui_dbg_prof_node_t* node = &win->prof.nodes[index];
+    char label[16];
+    _ui_dbg_prof_label(label, sizeof(label), node->kind, node->addr);
+    ImGuiTreeNodeFlags flags = (node->first_child == 0) ? ImGuiTreeNodeFlags_Leaf : 0;
+    if (index == 0) {
+        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+    }
+    const bool open = ImGui::TreeNodeEx((void*)(uintptr_t)index, flags, "%s", label);
+    if ((node->kind == UI_DBG_PROF_KIND_CALL) && ImGui::IsItemHovered()) {
+        _ui_dbg_disasm(win, node->addr);
+        ImGui::SetTooltip("%04X: %s", node->addr, win->dasm_line.chars);
+    }
+    ImGui::NextColumn();
+    ImGui::Text("%5.1f%%", _ui_dbg_prof_percent(win, node->total_ticks)); ImGui::NextColumn();
+    ImGui::Text("%5.1f%%", _ui_dbg_prof_percent(win, node->self_ticks)); ImGui::NextColumn();
+    ImGui::Text("%u", node->calls); ImGui::NextColumn();
+    if (open) {
+        for (uint16_t i = node->first_child; i != 0; i = win->prof.nodes[i].next_sibling) {
+            _ui_dbg_prof_draw_node(win, i);
+        }
+        ImGui::TreePop();
+    }
+}
+
+static void _ui_dbg_prof_draw(ui_dbg_t* win) {
+    if (!win->ui.show_profiler) {
+        return;
+    }
+    ui_dbg_profiler_t* p = &win->prof;
+    ImGui::SetNextWindowPos(ImVec2(win->ui.init_x + win->ui.init_w, win->ui.init_y + 64), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(320, 400), ImGuiCond_Once);
+    if (ImGui::Begin("Profiler", &win->ui.show_profiler)) {
+        if (ImGui::Checkbox("Enabled", &p->enabled)) {
+            /* restart call tracking at the next instruction */
+            p->op_valid = false;
+            p->int_ack = false;
+            p->depth = 0;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+            _ui_dbg_prof_reset(win);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Copy")) {
+            _ui_dbg_prof_update_totals(win);
+            char line[_UI_DBG_PROF_MAX_LINE];
+            ImGui::LogToClipboard();
+            for (int i = 0; i < p->num_nodes; i++) {
+                if (_ui_dbg_prof_folded_line(win, i, line, sizeof(line)) > 0) {
+                    ImGui::LogText("%s", line);
+                }
+            }
+            ImGui::LogFinish();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Copy call stacks to clipboard\n(flamegraph 'folded' format)");
+        }
+        ImGui::Checkbox("Sampling", &p->sampling);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(96);
+        if (ImGui::InputInt("Interval", &p->sample_interval)) {
+            if (p->sample_interval < 1) {
+                p->sample_interval = 1;
+            }
+            p->sample_countdown = p->sample_interval;
+        }
+        if (ImGui::RadioButton("Tree", !p->flat_view)) {
+            p->flat_view = false;
+        }
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Flat", p->flat_view)) {
+            p->flat_view = true;
+        }
+        ImGui::SameLine();
+        ImGui::Text("%llu ticks, %d/%d nodes%s", (unsigned long long)p->total_ticks,
+            p->num_nodes, UI_DBG_PROF_MAX_NODES, p->nodes_full ? " (full)" : "");
+        ImGui::Separator();
+        ImGui::BeginChild("##prof", ImVec2(0, 0), false);
+        ImGui::Columns(4, "##prof_columns", false);
+        ImGui::SetColumnWidth(0, 136);
+        ImGui::SetColumnWidth(1, 56);
+        ImGui::SetColumnWidth(2, 56);
+        ImGui::Text(p->flat_view ? "Function" : "Call Tree"); ImGui::NextColumn();
+        ImGui::Text(p->flat_view ? "" : "Total"); ImGui::NextColumn();
+        ImGui::Text("Self"); ImGui::NextColumn();
+        ImGui::Text("Calls"); ImGui::NextColumn();
+        ImGui::Separator();
+        if (p->flat_view) {
+            _ui_dbg_prof_update_flat(win);
+            char label[16];
+            for (int i = 0; i < p->num_funcs; i++) {
+                const ui_dbg_prof_func_t* f = &p->funcs[i];
+                ImGui::Text("%s", _ui_dbg_prof_label(label, sizeof(label), f->kind, f->addr)); ImGui::NextColumn();
+                ImGui::NextColumn();
+                ImGui::Text("%5.1f%%", _ui_dbg_prof_percent(win, f->self_ticks)); ImGui::NextColumn();
+                ImGui::Text("%u", f->calls); ImGui::NextColumn();
+            }
+        }
+        else {
+            _ui_dbg_prof_update_totals(win);
+            _ui_dbg_prof_draw_node(win, 0);
+        }
+        ImGui::Columns();
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
+
 /*== UI HELPERS ==============================================================*/
 static void _ui_dbg_uistate_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
     ui_dbg_uistate_t* ui = &win->ui;
@@ -1388,6 +2764,9 @@ static void _ui_dbg_uistate_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
             case UI_DBG_BREAKTYPE_NMI:
                 bt->label = "NMI";
                 break;
+            case UI_DBG_BREAKTYPE_COND:
+                bt->label = "Condition";
+                break;
             #if defined(UI_DBG_USE_Z80)
             case UI_DBG_BREAKTYPE_OUT:
                 bt->label = "OUT at";
@@ -1470,6 +2849,7 @@ static void _ui_dbg_draw_menu(ui_dbg_t* win) {
             ImGui::MenuItem("Execution History", 0, &win->ui.show_history);
             ImGui::MenuItem("Breakpoints", 0, &win->ui.show_breakpoints);
             ImGui::MenuItem("Stopwatch", 0, &win->ui.show_stopwatch);
+            ImGui::MenuItem("Profiler", 0, &win->ui.show_profiler);
             ImGui::MenuItem("Registers", 0, &win->ui.show_regs);
             ImGui::MenuItem("Button Bar", 0, &win->ui.show_buttons);
             ImGui::MenuItem("Opcode Bytes", 0, &win->ui.show_bytes);
@@ -1795,6 +3175,12 @@ static void _ui_dbg_draw_main(ui_dbg_t* win) {
         bool visible_line = (line_i >= clipper.DisplayStart) && (line_i < clipper.DisplayEnd);
         uint16_t addr = win->ui.line_array[line_i].addr;
         bool is_pc_line = (addr == pc);
+        /* skip rendering if not in visible area, line addresses
+           come from the line array, so hidden lines don't need disassembly
+        */
+        if (!visible_line) {
+            continue;
+        }
         bool show_dasm = (line_i >= UI_DBG_NUM_BACKTRACE_LINES) || _ui_dbg_heatmap_is_opcode(win, addr);
         const uint16_t start_addr = addr;
         if (show_dasm) {
@@ -1804,11 +3190,6 @@ static void _ui_dbg_draw_main(ui_dbg_t* win) {
         }
         const int num_bytes = addr - start_addr;
 
-        /* skip rendering if not in visible area */
-        if (!visible_line) {
-            continue;
-        }
-
         /* show data bytes or potential but not verified instructions as dimmed */
         if (_ui_dbg_heatmap_is_opcode(win, start_addr) || (start_addr == pc)) {
             ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyle().Colors[ImGuiCol_Text]);
@@ -1949,7 +3330,9 @@ void ui_dbg_init(ui_dbg_t* win, ui_dbg_desc_t* desc) {
     _ui_dbg_dbgstate_init(win, desc);
     _ui_dbg_uistate_init(win, desc);
     _ui_dbg_heatmap_init(win);
+    _ui_dbg_trace_init(win, desc);
     _ui_dbg_stopwatch_init(win, desc);
+    _ui_dbg_prof_init(win);
 }
 
 void ui_dbg_discard(ui_dbg_t* win) {
@@ -1964,7 +3347,9 @@ void ui_dbg_reset(ui_dbg_t* win) {
     _ui_dbg_uistate_reset(win);
     _ui_dbg_heatmap_reset(win);
     _ui_dbg_history_reset(win);
+    _ui_dbg_trace_reset(win);
     _ui_dbg_stopwatch_reset(win);
+    _ui_dbg_prof_reset(win);
     if (win->debug_cbs.reset_cb) {
         win->debug_cbs.reset_cb();
     }
@@ -1976,12 +3361,28 @@ void ui_dbg_reboot(ui_dbg_t* win) {
     _ui_dbg_uistate_reboot(win);
     _ui_dbg_heatmap_reboot(win);
     _ui_dbg_history_reboot(win);
+    _ui_dbg_trace_reset(win);
+    _ui_dbg_prof_reset(win);
     if (win->debug_cbs.reboot_cb) {
         win->debug_cbs.reboot_cb();
     }
 }
 
 void ui_dbg_tick(ui_dbg_t* win, uint64_t pins) {
+    // count the ticks which the system didn't report through the breakpoint map
+    if (win->dbg.tick) {
+        const uint64_t tick = *win->dbg.tick;
+        if (tick > (win->dbg.last_tick + 1)) {
+            const uint64_t skipped_ticks = tick - win->dbg.last_tick - 1;
+            win->stopwatch.cur_ticks += skipped_ticks;
+            win->trace.tick += skipped_ticks;
+            // the instruction ticks are only known if each instruction start was reported
+            if (win->dbg.breakmap.every_op || win->dbg.breakmap.every_tick) {
+                win->dbg.cur_op_ticks += (uint32_t)skipped_ticks;
+            }
+        }
+        win->dbg.last_tick = tick;
+    }
     int trap_id = 0;
     if (win->dbg.step_mode == UI_DBG_STEPMODE_TICK) {
         trap_id = UI_DBG_STEP_TRAPID;
@@ -1992,11 +3393,32 @@ void ui_dbg_tick(ui_dbg_t* win, uint64_t pins) {
     #elif defined(UI_DBG_USE_Z80)
         const bool new_op = z80_opdone(win->dbg.z80);
     #endif
+    #if defined(UI_DBG_USE_M6502)
+        const bool mem_wr = !(pins & M6502_RW);
+    #elif defined(UI_DBG_USE_Z80)
+        const bool mem_wr = (pins & (Z80_MREQ|Z80_WR)) == (Z80_MREQ|Z80_WR);
+    #endif
+    if (mem_wr && chips_breakmap_test(win->dbg.breakmap.write, pins & 0xFFFF)) {
+        // a memory-value breakpoint address was written, evaluate
+        // the breakpoint at the start of the next instruction
+        win->dbg.breakmap_recheck = true;
+        win->dbg.breakmap.every_op = true;
+    }
     if (new_op) {
         const uint16_t pc = pins & 0xFFFF;
         trap_id = _ui_dbg_eval_op_breakpoints(win, trap_id, pc);
+        if (win->dbg.breakmap_recheck) {
+            win->dbg.breakmap_recheck = false;
+            _ui_dbg_breakmap_update(win);
+        }
         _ui_dbg_heatmap_record_op(win, pc);
         _ui_dbg_history_push(win, pc);
+        if (win->trace.recording) {
+            _ui_dbg_trace_record(win, pc);
+        }
+        if (win->prof.enabled) {
+            _ui_dbg_prof_op(win, pc);
+        }
         win->dbg.cur_op_ticks = 0;
         win->dbg.cur_op_pc = pc;
     }
@@ -2005,6 +3427,10 @@ void ui_dbg_tick(ui_dbg_t* win, uint64_t pins) {
     }
     _ui_dbg_heatmap_record_tick(win, pins);
     win->stopwatch.cur_ticks++;
+    win->trace.tick++;
+    if (win->prof.enabled) {
+        _ui_dbg_prof_tick(win, pins);
+    }
     win->dbg.cur_op_ticks++;
     win->dbg.last_tick_pins = pins;
 
@@ -2026,7 +3452,8 @@ void ui_dbg_tick(ui_dbg_t* win, uint64_t pins) {
 void ui_dbg_draw(ui_dbg_t* win) {
     CHIPS_ASSERT(win && win->valid && win->ui.title);
     win->dbg.frame_id++;
-    if (!(win->ui.open || win->ui.show_heatmap || win->ui.show_breakpoints || win->ui.show_history || win->ui.show_stopwatch)) {
+    _ui_dbg_breakmap_update(win);
+    if (!(win->ui.open || win->ui.show_heatmap || win->ui.show_breakpoints || win->ui.show_history || win->ui.show_stopwatch || win->ui.show_profiler)) {
         return;
     }
     _ui_dbg_dbgwin_draw(win);
@@ -2034,6 +3461,9 @@ void ui_dbg_draw(ui_dbg_t* win) {
     _ui_dbg_history_draw(win);
     _ui_dbg_bp_draw(win);
     _ui_dbg_stopwatch_draw(win);
+    _ui_dbg_prof_draw(win);
+    // pick up breakpoints edited in the UI
+    _ui_dbg_breakmap_update(win);
 }
 
 void ui_dbg_external_debugger_connected(ui_dbg_t* win) {
@@ -2055,6 +3485,7 @@ void ui_dbg_add_breakpoint(ui_dbg_t* win, uint16_t addr) {
     if (index < 0) {
         _ui_dbg_bp_add_exec(win, true, addr);
     }
+    _ui_dbg_breakmap_update(win);
 }
 
 void ui_dbg_remove_breakpoint(ui_dbg_t* win, uint16_t addr) {
@@ -2063,6 +3494,7 @@ void ui_dbg_remove_breakpoint(ui_dbg_t* win, uint16_t addr) {
     if (index >= 0) {
         _ui_dbg_bp_del(win, index);
     }
+    _ui_dbg_breakmap_update(win);
 }
 
 void ui_dbg_break(ui_dbg_t* win) {
@@ -2090,6 +3522,44 @@ void ui_dbg_step_into(ui_dbg_t* win) {
     _ui_dbg_step_into(win);
 }
 
+bool ui_dbg_set_breakpoint_condition(ui_dbg_t* win, uint16_t addr, const char* expr) {
+    CHIPS_ASSERT(win && win->valid);
+    const int index = _ui_dbg_bp_find(win, UI_DBG_BREAKTYPE_EXEC, addr);
+    if (index < 0) {
+        return false;
+    }
+    ui_dbg_breakpoint_t* bp = &win->dbg.breakpoints[index];
+    if (expr) {
+        CHIPS_ASSERT(strlen(expr) < sizeof(bp->expr));
+        strncpy(bp->expr, expr, sizeof(bp->expr) - 1);
+        bp->expr[sizeof(bp->expr) - 1] = 0;
+    } else {
+        bp->expr[0] = 0;
+    }
+    return _ui_dbg_bp_compile(bp);
+}
+
+int ui_dbg_profiler_export(ui_dbg_t* win, char* buf, int buf_size) {
+    CHIPS_ASSERT(win && win->valid);
+    CHIPS_ASSERT(buf || (buf_size == 0));
+    _ui_dbg_prof_update_totals(win);
+    int len = 0;
+    int copied = 0;
+    char line[_UI_DBG_PROF_MAX_LINE];
+    for (int i = 0; i < win->prof.num_nodes; i++) {
+        const int line_len = _ui_dbg_prof_folded_line(win, i, line, sizeof(line));
+        if ((len == copied) && ((len + line_len) < buf_size)) {
+            memcpy(buf + len, line, (size_t)line_len);
+            copied += line_len;
+        }
+        len += line_len;
+    }
+    if (buf_size > 0) {
+        buf[copied] = 0;
+    }
+    return len;
+}
+
 void ui_dbg_disassemble(ui_dbg_t* win, const ui_dbg_dasm_request_t* request) {
     CHIPS_ASSERT(win && win->valid);
     CHIPS_ASSERT(request);
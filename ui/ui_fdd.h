@@ -161,12 +161,13 @@ void ui_fdd_draw(ui_fdd_t* win) {
                                             sec->info.upd765.n,
                                             sec->info.upd765.st1,
                                             sec->info.upd765.st2);
+                                        const uint8_t* sec_data = fdd_sector_data(win->fdd, sec);
                                         int i = 0;
-                                        while (i < sec->data_size) {
+                                        while (sec_data && (i < sec->data_size)) {
                                             int j = 0;
                                             ImGui::Text("%04X:", i); ImGui::SameLine();
                                             for (; (j < bytes_per_line) && (i < sec->data_size); j++, i++) {
-                                                uint8_t val = win->fdd->data[i+sec->data_offset];
+                                                uint8_t val = sec_data[i];
                                                 if (isalnum((int)val)) {
                                                     buf[j] = val;
                                                 }
@@ -81,6 +81,7 @@ typedef struct {
     ui_dbg_texture_callbacks_t dbg_texture; // user-provided texture create/update/destroy callbacks
     ui_dbg_debug_callbacks_t dbg_debug;     // user-provided debugger callbacks
     ui_dbg_keys_desc_t dbg_keys;            // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;            // snapshot system creation params
 } ui_kc85_desc_t;
 
@@ -376,6 +377,7 @@ void ui_kc85_init(ui_kc85_t* ui, const ui_kc85_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->kc85->cpu;
+        desc.tick = &ui->kc85->tick;
         desc.freq_hz = KC85_FREQUENCY;
         desc.scanline_ticks = KC85_SCANLINE_TICKS;
         desc.frame_ticks = KC85_SCANLINE_TICKS * KC85_NUM_SCANLINES;
@@ -383,6 +385,7 @@ void ui_kc85_init(ui_kc85_t* ui, const ui_kc85_desc_t* ui_desc) {
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.debug_cbs = ui_desc->dbg_debug;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->kc85;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -493,6 +496,7 @@ void ui_kc85_init(ui_kc85_t* ui, const ui_kc85_desc_t* ui_desc) {
 
 void ui_kc85_discard(ui_kc85_t* ui) {
     CHIPS_ASSERT(ui && ui->kc85);
+    ui_snapshot_discard(&ui->snapshot);
     ui->kc85 = 0;
     ui_z80_discard(&ui->cpu);
     ui_z80pio_discard(&ui->pio);
@@ -531,6 +535,7 @@ chips_debug_t ui_kc85_get_debug(ui_kc85_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
@@ -67,6 +67,7 @@ typedef struct {
     ui_lc80_boot_t boot_cb; // user-provided callback to reboot to different config
     ui_dbg_texture_callbacks_t dbg_texture;     // texture create/update/destroy callback
     ui_dbg_keys_desc_t dbg_keys;                // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                    // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;                // snapshot system creation params
 } ui_lc80_desc_t;
 
@@ -219,14 +220,14 @@ static void _ui_lc80_draw_vqe23_segments(ImDrawList* l, const ImVec2& p, bool en
     const float dot_x = conf.display.dot_offset_x;
     const float dot_y = conf.display.dot_offset_y;
     const float dot_r = conf.display.dot_radius;
-    const ImU32 dot_color = (0 == (segs & 0x80)) ? conf.display.color_on : conf.display.color_off;
-    _ui_lc80_draw_seg_hori(l, ImVec2(p.x, p.y-seg_l), enabled && (0==(segs&0x01)), conf);
-    _ui_lc80_draw_seg_hori(l, p, enabled && (0==(segs&0x40)), conf);
-    _ui_lc80_draw_seg_hori(l, ImVec2(p.x, p.y+seg_l), enabled && (0==(segs&0x08)), conf);
-    _ui_lc80_draw_seg_vert(l, ImVec2(p.x - seg_lh, p.y - seg_lh), enabled && (0==(segs&0x20)), conf);
-    _ui_lc80_draw_seg_vert(l, ImVec2(p.x + seg_lh, p.y - seg_lh), enabled && (0==(segs&0x02)), conf);
-    _ui_lc80_draw_seg_vert(l, ImVec2(p.x - seg_lh, p.y + seg_lh), enabled && (0==(segs&0x10)), conf);
-    _ui_lc80_draw_seg_vert(l, ImVec2(p.x + seg_lh, p.y + seg_lh), enabled && (0==(segs&0x04)), conf);
+    const ImU32 dot_color = (0 != (segs & 0x80)) ? conf.display.color_on : conf.display.color_off;
+    _ui_lc80_draw_seg_hori(l, ImVec2(p.x, p.y-seg_l), enabled && (0!=(segs&0x01)), conf);
+    _ui_lc80_draw_seg_hori(l, p, enabled && (0!=(segs&0x40)), conf);
+    _ui_lc80_draw_seg_hori(l, ImVec2(p.x, p.y+seg_l), enabled && (0!=(segs&0x08)), conf);
+    _ui_lc80_draw_seg_vert(l, ImVec2(p.x - seg_lh, p.y - seg_lh), enabled && (0!=(segs&0x20)), conf);
+    _ui_lc80_draw_seg_vert(l, ImVec2(p.x + seg_lh, p.y - seg_lh), enabled && (0!=(segs&0x02)), conf);
+    _ui_lc80_draw_seg_vert(l, ImVec2(p.x - seg_lh, p.y + seg_lh), enabled && (0!=(segs&0x10)), conf);
+    _ui_lc80_draw_seg_vert(l, ImVec2(p.x + seg_lh, p.y + seg_lh), enabled && (0!=(segs&0x04)), conf);
     l->AddCircleFilled(ImVec2(p.x + dot_x, p.y + dot_y), dot_r, dot_color);
     l->AddCircle(ImVec2(p.x + dot_x, p.y + dot_y), dot_r, conf.display.color_outline);
     l->AddCircleFilled(ImVec2(p.x - dot_x, p.y - dot_y), dot_r, conf.display.color_off);
@@ -248,13 +249,14 @@ static void _ui_lc80_draw_vqe23_pins(ImDrawList* l, ui_chip_t* c, float x, float
     }
 }
 
-static void _ui_lc80_draw_vqe23(ImDrawList* l, ui_chip_t* c, float x, float y, uint32_t pins, const _ui_lc80_mb_config& conf) {
+static void _ui_lc80_draw_vqe23(ImDrawList* l, ui_chip_t* c, float x, float y, uint32_t pins, const uint8_t* digits, const _ui_lc80_mb_config& conf) {
     const float dx = conf.display.segment_length * 0.5f + conf.display.digit_padding;
     const ImVec2 p0(x - c->chip_width * 0.5f, y - c->chip_height * 0.5f);
     const ImVec2 p1(x + c->chip_width * 0.5f, y + c->chip_height * 0.5f);
     l->AddRectFilled(p0, p1, conf.display.color_background);
-    _ui_lc80_draw_vqe23_segments(l, ImVec2(x - dx, y), true, pins>>8, conf);
-    _ui_lc80_draw_vqe23_segments(l, ImVec2(x + dx, y), true, pins&0xFF, conf);
+    // segments come from the latched display state, pins from the live VQE23 state
+    _ui_lc80_draw_vqe23_segments(l, ImVec2(x - dx, y), true, digits[0], conf);
+    _ui_lc80_draw_vqe23_segments(l, ImVec2(x + dx, y), true, digits[1], conf);
     _ui_lc80_draw_vqe23_pins(l, c, x, y, pins);
 }
 
@@ -276,9 +278,10 @@ static void _ui_lc80_draw_display(ui_lc80_t* ui, const ImVec2 p, const _ui_lc80_
     _ui_lc80_draw_tape_led(l, ImVec2(p.x+16.0f, p.y+24.0f), 0==(ui->sys->pio_sys.port[Z80PIO_PORT_B].output&2), conf);
     _ui_lc80_draw_halt_led(l, ImVec2(p.x+16.0f, p.y+48.0f), 0!=(ui->sys->cpu.pins & Z80_HALT), conf);
     ImVec2 disp_pos(p.x + 84.0f, p.y + 48.0f);
-    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[2].chip, ui->mb.vqe23[2].pos.x, ui->mb.vqe23[2].pos.y, ui->sys->vqe23[2], conf);
-    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[1].chip, ui->mb.vqe23[1].pos.x, ui->mb.vqe23[1].pos.y, ui->sys->vqe23[1], conf);
-    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[0].chip, ui->mb.vqe23[0].pos.x, ui->mb.vqe23[0].pos.y, ui->sys->vqe23[0], conf);
+    const lc80_display_t disp = lc80_display(ui->sys);
+    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[2].chip, ui->mb.vqe23[2].pos.x, ui->mb.vqe23[2].pos.y, ui->sys->vqe23[2], &disp.digits[0], conf);
+    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[1].chip, ui->mb.vqe23[1].pos.x, ui->mb.vqe23[1].pos.y, ui->sys->vqe23[1], &disp.digits[2], conf);
+    _ui_lc80_draw_vqe23(l, &ui->mb.vqe23[0].chip, ui->mb.vqe23[0].pos.x, ui->mb.vqe23[0].pos.y, ui->sys->vqe23[0], &disp.digits[4], conf);
     _ui_lc80_set_pos(p.x, p.y + 104.0f);
 }
 
@@ -1056,9 +1059,11 @@ static void _ui_lc80_init_windows(ui_lc80_t* ui, const ui_lc80_desc_t* ui_desc)
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->sys->cpu;
+        desc.tick = &ui->sys->tick;
         desc.read_cb = _ui_lc80_mem_read;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->sys;
         ui_dbg_init(&ui->win.dbg, &desc);
     }
@@ -1147,6 +1152,7 @@ static void _ui_lc80_init_windows(ui_lc80_t* ui, const ui_lc80_desc_t* ui_desc)
 }
 
 static void _ui_lc80_discard_windows(ui_lc80_t* ui) {
+    ui_snapshot_discard(&ui->win.snapshot);
     ui_z80_discard(&ui->win.cpu);
     ui_z80pio_discard(&ui->win.pio_sys);
     ui_z80pio_discard(&ui->win.pio_usr);
@@ -1188,6 +1194,7 @@ chips_debug_t ui_lc80_get_debug(ui_lc80_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->win.dbg;
     res.stopped = &ui->win.dbg.dbg.stopped;
+    res.breakmap = &ui->win.dbg.dbg.breakmap;
     return res;
 }
 
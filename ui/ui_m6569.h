@@ -20,6 +20,7 @@
 
     Include the following headers before the including the *declaration*:
         - m6569.h
+        - ui_util.h
         - ui_chip.h
 
     Include the following headers before including the *implementation*:
@@ -31,6 +32,10 @@
     All strings provided to ui_m6569_init() must remain alive until
     ui_m6569_discard() is called!
 
+    To draw the window on a separate UI thread, enable state capture with
+    ui_m6569_set_capture() and call ui_m6569_capture() on the emulation
+    thread after each *_exec() (see 'State Capture' in ui_util.h).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -76,11 +81,17 @@ typedef struct ui_m6569_t {
     bool open;
     bool valid;
     ui_chip_t chip;
+    ui_util_capture_t capture;
+    m6569_t capture_buf[3];
 } ui_m6569_t;
 
 void ui_m6569_init(ui_m6569_t* win, const ui_m6569_desc_t* desc);
 void ui_m6569_discard(ui_m6569_t* win);
 void ui_m6569_draw(ui_m6569_t* win);
+/* enable state capture with a capture interval, 0 disables (see 'State Capture' in ui_util.h) */
+void ui_m6569_set_capture(ui_m6569_t* win, int interval);
+/* emulation thread: capture the VIC-II state */
+void ui_m6569_capture(ui_m6569_t* win);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -118,6 +129,20 @@ void ui_m6569_discard(ui_m6569_t* win) {
     win->valid = false;
 }
 
+void ui_m6569_set_capture(ui_m6569_t* win, int interval) {
+    CHIPS_ASSERT(win && win->valid);
+    ui_util_capture_init(&win->capture, &win->capture_buf[0], &win->capture_buf[1], &win->capture_buf[2], sizeof(m6569_t), win->vic, interval);
+}
+
+void ui_m6569_capture(ui_m6569_t* win) {
+    CHIPS_ASSERT(win && win->valid);
+    void* buf = ui_util_capture_begin(&win->capture, win->open);
+    if (buf) {
+        memcpy(buf, win->vic, sizeof(m6569_t));
+        ui_util_capture_end(&win->capture);
+    }
+}
+
 static void _ui_m6569_draw_hwcolors(void) {
     if (ImGui::CollapsingHeader("Hardware Colors")) {
         ImVec4 c;
@@ -144,9 +169,9 @@ static void _ui_m6569_draw_rgb(const char* label, uint32_t val) {
     ImGui::ColorButton("##rgbclr", ImColor(val | 0xFF000000), ImGuiColorEditFlags_NoAlpha, ImVec2(12,12));
 }
 
-static void _ui_m6569_draw_registers(const ui_m6569_t* win) {
+static void _ui_m6569_draw_registers(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Registers")) {
-        const m6569_registers_t* reg = &win->vic->reg;
+        const m6569_registers_t* reg = &vic->reg;
         for (int i = 0; i < M6569_NUM_MOBS; i++) {
             ImGui::Text("m%dx:%02X  m%dy:%02X", i, reg->mxy[i][0], i, reg->mxy[i][1]);
             if (((i+1) % 2) != 0) {
@@ -202,9 +227,9 @@ static void _ui_m6569_draw_registers(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_raster_unit(const ui_m6569_t* win) {
+static void _ui_m6569_draw_raster_unit(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Raster Unit")) {
-        const m6569_raster_unit_t* rs = &win->vic->rs;
+        const m6569_raster_unit_t* rs = &vic->rs;
         ImGui::Text("h_count:%02X v_count:%03X v_irq:%03X", rs->h_count, rs->v_count, rs->v_irqline);
         ImGui::Text("vc:%03X vc_base:%03X rc:%X", rs->vc, rs->vc_base, rs->rc);
         ImGui::Text("display:%s badline:%s", rs->display_state?"ON ":"OFF", rs->badline?"ON ":"OFF");
@@ -212,9 +237,9 @@ static void _ui_m6569_draw_raster_unit(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_memory_unit(const ui_m6569_t* win) {
+static void _ui_m6569_draw_memory_unit(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Memory Unit")) {
-        const m6569_memory_unit_t* mem = &win->vic->mem;
+        const m6569_memory_unit_t* mem = &vic->mem;
         ImGui::Text("c_addr_or:  %04X", mem->c_addr_or);
         ImGui::Text("g_addr_and: %04X", mem->g_addr_and);
         ImGui::Text("g_addr_or:  %04X", mem->g_addr_or);
@@ -223,9 +248,9 @@ static void _ui_m6569_draw_memory_unit(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_video_matrix(const ui_m6569_t* win) {
+static void _ui_m6569_draw_video_matrix(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Video Matrix")) {
-        const m6569_video_matrix_t* vm = &win->vic->vm;
+        const m6569_video_matrix_t* vm = &vic->vm;
         ImGui::Text("vmli:%02X", vm->vmli);
         ImGui::Text("line buffer:");
         for (int i = 0; i < 40; i++) {
@@ -237,9 +262,9 @@ static void _ui_m6569_draw_video_matrix(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_border_unit(const ui_m6569_t* win) {
+static void _ui_m6569_draw_border_unit(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Border Unit")) {
-        const m6569_border_unit_t* brd = &win->vic->brd;
+        const m6569_border_unit_t* brd = &vic->brd;
         ImGui::Text("left:%04X right:%04X", brd->left, brd->right);
         ImGui::Text("top:%04X bottom:%04X", brd->top, brd->bottom);
         ImGui::Text("main:%s vert:%s", brd->main?"ON ":"OFF", brd->vert?"ON ":"OFF");
@@ -247,9 +272,9 @@ static void _ui_m6569_draw_border_unit(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_graphics_unit(const ui_m6569_t* win) {
+static void _ui_m6569_draw_graphics_unit(const m6569_t* vic) {
     if (ImGui::CollapsingHeader("Graphics Unit")) {
-        const m6569_graphics_unit_t* gu = &win->vic->gunit;
+        const m6569_graphics_unit_t* gu = &vic->gunit;
         ImGui::Text("enabled:%s", gu->enabled?"YES":"NO "); ImGui::SameLine();
         ImGui::Text("mode:%X", gu->mode); ImGui::SameLine();
         ImGui::Text("c_data:%03X", gu->c_data);
@@ -264,12 +289,12 @@ static void _ui_m6569_draw_graphics_unit(const ui_m6569_t* win) {
     }
 }
 
-static void _ui_m6569_draw_sprite_units(const ui_m6569_t* win) {
+static void _ui_m6569_draw_sprite_units(const m6569_t* vic) {
     static const char* su_names[8] = {
         "Sprite Unit 0", "Sprite Unit 1", "Sprite Unit 2", "Sprite Unit 3",
         "Sprite Unit 4", "Sprite Unit 5", "Sprite Unit 6", "Sprite Unit 7",
     };
-    const m6569_sprite_unit_t* su = &win->vic->sunit;
+    const m6569_sprite_unit_t* su = &vic->sunit;
     for (int i = 0; i < 8; i++) {
         if (ImGui::CollapsingHeader(su_names[i])) {
             ImGui::Text("dma:%s", su->dma_enabled[i]?"ON ":"OFF"); ImGui::SameLine();
@@ -295,21 +320,23 @@ void ui_m6569_draw(ui_m6569_t* win) {
     }
     ImGui::SetNextWindowPos(ImVec2(win->init_x, win->init_y), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(win->init_w, win->init_h), ImGuiCond_Once);
+    // draw from the captured state if enabled, the debug visualization flag is written into the live state
+    const m6569_t* vic = win->capture.enabled ? (const m6569_t*) ui_util_capture_acquire(&win->capture) : win->vic;
     if (ImGui::Begin(win->title, &win->open)) {
         ImGui::BeginChild("##m6569_chip", ImVec2(176, 0), true);
-        ui_chip_draw(&win->chip, win->vic->pins);
+        ui_chip_draw(&win->chip, vic->pins);
         ImGui::EndChild();
         ImGui::SameLine();
         ImGui::BeginChild("##m6569_state", ImVec2(0, 0), true);
         ImGui::Checkbox("Debug Visualization", &win->vic->debug_vis);
         _ui_m6569_draw_hwcolors();
-        _ui_m6569_draw_registers(win);
-        _ui_m6569_draw_raster_unit(win);
-        _ui_m6569_draw_memory_unit(win);
-        _ui_m6569_draw_video_matrix(win);
-        _ui_m6569_draw_border_unit(win);
-        _ui_m6569_draw_graphics_unit(win);
-        _ui_m6569_draw_sprite_units(win);
+        _ui_m6569_draw_registers(vic);
+        _ui_m6569_draw_raster_unit(vic);
+        _ui_m6569_draw_memory_unit(vic);
+        _ui_m6569_draw_video_matrix(vic);
+        _ui_m6569_draw_border_unit(vic);
+        _ui_m6569_draw_graphics_unit(vic);
+        _ui_m6569_draw_sprite_units(vic);
         ImGui::EndChild();
     }
     ImGui::End();
@@ -120,6 +120,8 @@ void ui_m6581_discard(ui_m6581_t* win) {
 
 static void _ui_m6581_draw_state(ui_m6581_t* win) {
     m6581_t* sid = win->sid;
+    // in lazy mode the voice state might lag behind
+    m6581_sync(sid);
     const float cw0 = 96.0f;
     const float cw = 64.0f;
     ImGui::Columns(4, "##sid_channels", false);
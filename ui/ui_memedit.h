@@ -26,6 +26,13 @@
     All strings provided to ui_memedit_init() must remain alive until
     ui_memedit_discard() is called!
 
+    The visible rows are fetched once per frame into a shadow copy, either
+    through the optional read_range_cb (one call per row), or byte by byte
+    through read_cb. All drawing happens from the shadow copy, which is
+    also compared against the previous frame to highlight bytes that
+    have changed (fading out over UI_MEMEDIT_CHANGE_FRAMES frames). This
+    gives a cheap live view of which memory is currently being written.
+
     Includes a (slightly extended) version of imgui_memory_editor.h:
 
     https://github.com/ocornut/imgui_club/blob/master/imgui_memory_editor/imgui_memory_editor.h
@@ -62,10 +69,14 @@ typedef void MemoryEditor;
 #endif
 
 #define UI_MEMEDIT_MAX_LAYERS (16)
+#define UI_MEMEDIT_MAX_SIZE (1<<16)
+#define UI_MEMEDIT_CHANGE_FRAMES (32)
 
 /* callbacks for reading and writing bytes */
 typedef uint8_t (*ui_memedit_read_t)(int layer, uint16_t addr, void* user_data);
 typedef void (*ui_memedit_write_t)(int layer, uint16_t addr, uint8_t data, void* user_data);
+/* optional callback for reading a range of bytes */
+typedef void (*ui_memedit_read_range_t)(int layer, uint16_t addr, uint8_t* dst, int num_bytes, void* user_data);
 
 /* setup parameters for ui_memedit_init()
 
@@ -76,9 +87,11 @@ typedef struct {
     const char* layers[UI_MEMEDIT_MAX_LAYERS];   /* memory system layer names */
     ui_memedit_read_t read_cb;
     ui_memedit_write_t write_cb;
+    ui_memedit_read_range_t read_range_cb;  /* optional, fetch a whole row at once */
     size_t max_addr;
     int num_cols;       /* initial number of cols, default is 16 */
     bool hide_ascii;    /* initially hide the ASCII column */
+    bool hide_changes;  /* initially don't highlight changed bytes */
     bool hide_options;  /* hide the Options dropdown */
     bool hide_addr_input;   /* hide the address input field */
     void* user_data;
@@ -91,6 +104,7 @@ typedef struct {
     const char* title;
     ui_memedit_read_t read_cb;
     ui_memedit_write_t write_cb;
+    ui_memedit_read_range_t read_range_cb;
     void* user_data;
     float init_x, init_y;
     float init_w, init_h;
@@ -188,6 +202,14 @@ struct MemoryEditor
     int CurLayer;
     const char* Layers[UI_MEMEDIT_MAX_LAYERS];
     bool OptShowAddrInput;      // = true
+    bool OptShowChanges;        // = true   // highlight bytes which changed since the previous frame
+    ImU32 ChangeColor;          //          // background color of changed bytes (alpha fades out)
+    void (*ReadRangeFn)(const ImU8* data, size_t off, ImU8* dst, size_t num);  // = 0  // optional handler to read a row of bytes
+    ImU8 Shadow[UI_MEMEDIT_MAX_SIZE];       // visible bytes as fetched this frame
+    ImU8 ChangeAge[UI_MEMEDIT_MAX_SIZE];    // frames left to highlight a changed byte
+    size_t ShadowMin, ShadowMax;            // range of valid shadow bytes from previous frame
+    size_t VisibleMin, VisibleMax;          // range of shadow bytes fetched in current frame
+    int ShadowLayer;
     /*--- END ui_memedit.h changes ---*/
 
     // Settings
@@ -253,6 +275,14 @@ struct MemoryEditor
 
         /*--- BEGIN ui_memedit.h changes ---*/
         OptShowAddrInput = true;
+        OptShowChanges = true;
+        ChangeColor = IM_COL32(255, 64, 64, 160);
+        ReadRangeFn = NULL;
+        memset(Shadow, 0, sizeof(Shadow));
+        memset(ChangeAge, 0, sizeof(ChangeAge));
+        ShadowMin = ShadowMax = 0;
+        VisibleMin = VisibleMax = 0;
+        ShadowLayer = 0;
         NumLayers = 0;
         CurLayer = 0;
         for (int i = 0; i < UI_MEMEDIT_MAX_LAYERS; i++) {
@@ -268,6 +298,41 @@ struct MemoryEditor
         HighlightMax = addr_max;
     }
 
+    /*--- BEGIN ui_memedit.h changes ---*/
+    // fetch a row of bytes into the shadow buffer and update the change highlight
+    void FetchRow(const ImU8* mem_data, size_t addr, size_t num)
+    {
+        ImU8 row[64];
+        IM_ASSERT(num <= sizeof(row));
+        if (ReadRangeFn)
+            ReadRangeFn(mem_data, addr, row, num);
+        else if (ReadFn)
+            for (size_t i = 0; i < num; i++)
+                row[i] = ReadFn(mem_data, addr + i);
+        else
+            memcpy(row, mem_data + addr, num);
+        // bytes which weren't visible in the previous frame have no valid history
+        const bool layer_valid = (ShadowLayer == CurLayer);
+        for (size_t i = 0; i < num; i++)
+        {
+            const size_t a = addr + i;
+            if (layer_valid && (a >= ShadowMin) && (a < ShadowMax))
+            {
+                if (Shadow[a] != row[i])
+                    ChangeAge[a] = UI_MEMEDIT_CHANGE_FRAMES;
+                else if (ChangeAge[a] > 0)
+                    ChangeAge[a]--;
+            }
+            else
+                ChangeAge[a] = 0;
+            Shadow[a] = row[i];
+        }
+        if (VisibleMin == VisibleMax)
+            VisibleMin = addr;
+        VisibleMax = addr + num;
+    }
+    /*--- END ui_memedit.h changes ---*/
+
     struct Sizes
     {
         int     AddrDigitsCount;
@@ -393,11 +458,21 @@ struct MemoryEditor
         const char* format_byte = OptUpperCaseHex ? "%02X" : "%02x";
         const char* format_byte_space = OptUpperCaseHex ? "%02X " : "%02x ";
 
+        /*--- BEGIN ui_memedit.h changes ---*/
+        IM_ASSERT(mem_size <= UI_MEMEDIT_MAX_SIZE);
+        if (Cols > 64)
+            Cols = 64;
+        VisibleMin = VisibleMax = 0;
+        /*--- END ui_memedit.h changes ---*/
+
         while (clipper.Step())
             for (int line_i = clipper.DisplayStart; line_i < clipper.DisplayEnd; line_i++) // display only visible lines
             {
                 size_t addr = (size_t)(line_i * Cols);
                 ImGui::Text(format_address, s.AddrDigitsCount, base_display_addr + addr);
+                /*--- BEGIN ui_memedit.h changes ---*/
+                FetchRow(mem_data, addr, ((addr + Cols) <= mem_size) ? (size_t)Cols : (mem_size - addr));
+                /*--- END ui_memedit.h changes ---*/
 
                 // Draw Hexadecimal
                 for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
@@ -425,6 +500,15 @@ struct MemoryEditor
                         draw_list->AddRectFilled(pos, ImVec2(pos.x + highlight_width, pos.y + s.LineHeight), HighlightColor);
                     }
 
+                    /*--- BEGIN ui_memedit.h changes ---*/
+                    if (OptShowChanges && (ChangeAge[addr] > 0))
+                    {
+                        ImVec2 pos = ImGui::GetCursorScreenPos();
+                        const ImU32 alpha = (((ChangeColor >> IM_COL32_A_SHIFT) & 0xFF) * ChangeAge[addr]) / UI_MEMEDIT_CHANGE_FRAMES;
+                        const ImU32 color = (ChangeColor & ~IM_COL32_A_MASK) | (alpha << IM_COL32_A_SHIFT);
+                        draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth * 2, pos.y + s.LineHeight), color);
+                    }
+                    /*--- END ui_memedit.h changes ---*/
                     if (DataEditingAddr == addr)
                     {
                         // Display text input on current byte
@@ -434,7 +518,7 @@ struct MemoryEditor
                         {
                             ImGui::SetKeyboardFocusHere(0);
                             ImSnprintf(AddrInputBuf, sizeof(AddrInputBuf), format_data, s.AddrDigitsCount, base_display_addr + addr);
-                            ImSnprintf(DataInputBuf, sizeof(DataInputBuf), format_byte, ReadFn ? ReadFn(mem_data, addr) : mem_data[addr]);
+                            ImSnprintf(DataInputBuf, sizeof(DataInputBuf), format_byte, Shadow[addr]);
                         }
                         struct UserData
                         {
@@ -461,7 +545,7 @@ struct MemoryEditor
                         };
                         UserData user_data;
                         user_data.CursorPos = -1;
-                        ImSnprintf(user_data.CurrentBufOverwrite, sizeof(user_data.CurrentBufOverwrite), format_byte, ReadFn ? ReadFn(mem_data, addr) : mem_data[addr]);
+                        ImSnprintf(user_data.CurrentBufOverwrite, sizeof(user_data.CurrentBufOverwrite), format_byte, Shadow[addr]);
                         ImGuiInputTextFlags flags = ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll | ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_CallbackAlways;
 #if IMGUI_VERSION_NUM >= 18104
                         flags |= ImGuiInputTextFlags_AlwaysOverwrite;
@@ -491,7 +575,7 @@ struct MemoryEditor
                     else
                     {
                         // NB: The trailing space is not visible but ensure there's no gap that the mouse cannot click on.
-                        ImU8 b = ReadFn ? ReadFn(mem_data, addr) : mem_data[addr];
+                        ImU8 b = Shadow[addr];
 
                         if (OptShowHexII)
                         {
@@ -539,7 +623,7 @@ struct MemoryEditor
                             draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
                             draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_TextSelectedBg));
                         }
-                        unsigned char c = ReadFn ? ReadFn(mem_data, addr) : mem_data[addr];
+                        unsigned char c = Shadow[addr];
                         char display_c = (c < 32 || c >= 128) ? '.' : c;
                         draw_list->AddText(pos, (display_c == c) ? color_text : color_disabled, &display_c, &display_c + 1);
                         pos.x += s.GlyphWidth;
@@ -548,6 +632,11 @@ struct MemoryEditor
             }
         ImGui::PopStyleVar(2);
         ImGui::EndChild();
+        /*--- BEGIN ui_memedit.h changes ---*/
+        ShadowMin = VisibleMin;
+        ShadowMax = VisibleMax;
+        ShadowLayer = CurLayer;
+        /*--- END ui_memedit.h changes ---*/
 
         // Notify the main window of our ideal child content size (FIXME: we are missing an API to get the contents size from the child)
         ImGui::SetCursorPosX(s.WindowWidth);
@@ -595,6 +684,9 @@ struct MemoryEditor
             if (ImGui::Checkbox("Show Ascii", &OptShowAscii)) { ContentsWidthChanged = true; }
             ImGui::Checkbox("Grey out zeroes", &OptGreyOutZeroes);
             ImGui::Checkbox("Uppercase Hex", &OptUpperCaseHex);
+            /*--- BEGIN ui_memedit.h changes ---*/
+            ImGui::Checkbox("Highlight changes", &OptShowChanges);
+            /*--- END ui_memedit.h changes ---*/
 
             ImGui::EndPopup();
         }
@@ -888,6 +980,22 @@ static uint8_t _ui_memedit_readfn(const uint8_t* ptr, size_t off) {
     }
 }
 
+static void _ui_memedit_readrangefn(const uint8_t* ptr, size_t off, uint8_t* dst, size_t num) {
+    const ui_memedit_t* win = (ui_memedit_t*) ptr;
+    CHIPS_ASSERT(win && win->ed);
+    if (win->read_range_cb) {
+        win->read_range_cb(win->ed->CurLayer, (uint16_t)off, dst, (int)num, win->user_data);
+    }
+    else if (win->read_cb) {
+        for (size_t i = 0; i < num; i++) {
+            dst[i] = win->read_cb(win->ed->CurLayer, (uint16_t)(off + i), win->user_data);
+        }
+    }
+    else {
+        memset(dst, 0, num);
+    }
+}
+
 static void _ui_memedit_writefn(uint8_t* ptr, size_t off, uint8_t val) {
     /* we'll treat the "data ptr" as "user data" */
     const ui_memedit_t* win = (ui_memedit_t*) ptr;
@@ -905,21 +1013,25 @@ void ui_memedit_init(ui_memedit_t* win, const ui_memedit_desc_t* desc) {
     win->title = desc->title;
     win->read_cb = desc->read_cb;
     win->write_cb = desc->write_cb;
+    win->read_range_cb = desc->read_range_cb;
     win->user_data = desc->user_data;
     win->init_x = (float) desc->x;
     win->init_y = (float) desc->y;
     win->init_w = (float) ((desc->w == 0) ? 512 : desc->w);
     win->init_h = (float) ((desc->h == 0) ? 120 : desc->h);
     win->max_addr = (desc->max_addr == 0) ? (1<<16) : desc->max_addr;
+    CHIPS_ASSERT(win->max_addr <= UI_MEMEDIT_MAX_SIZE);
     win->open = desc->open;
     win->ed = new MemoryEditor;
     win->ed->Cols = (desc->num_cols == 0) ? win->ed->Cols : desc->num_cols;
     win->ed->OptShowOptions = !desc->hide_options;
     win->ed->OptShowAddrInput = !desc->hide_addr_input;
     win->ed->OptShowAscii = !desc->hide_ascii;
+    win->ed->OptShowChanges = !desc->hide_changes;
     win->ed->Open = win->open;
     win->ed->ReadFn = _ui_memedit_readfn;
     win->ed->WriteFn = _ui_memedit_writefn;
+    win->ed->ReadRangeFn = _ui_memedit_readrangefn;
     win->ed->OptAddrDigitsCount = 4;
     for (int i = 0; i < UI_MEMEDIT_MAX_LAYERS; i++) {
         if (desc->layers[i]) {
@@ -65,6 +65,7 @@ typedef struct {
     namco_t* sys;
     ui_dbg_texture_callbacks_t dbg_texture;         // user-provided texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;                    // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                        // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;                    // snapshot system creation params
 } ui_namco_desc_t;
 
@@ -179,6 +180,7 @@ static void _ui_namco_mem_write(int layer, uint16_t addr, uint8_t data, void* us
         case _UI_NAMCO_MEMLAYER_GFX:
             if (addr < sizeof(ui->sys->rom_gfx)) {
                 ui->sys->rom_gfx[addr] = data;
+                ui->sys->gfx_cache_valid = false;
             }
             break;
         case _UI_NAMCO_MEMLAYER_PROM:
@@ -209,10 +211,12 @@ void ui_namco_init(ui_namco_t* ui, const ui_namco_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->sys->cpu;
+        desc.tick = &ui->sys->tick;
         desc.read_cb = _ui_namco_mem_read;
         desc.read_layer = _UI_NAMCO_MEMLAYER_MAIN;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -288,6 +292,7 @@ void ui_namco_init(ui_namco_t* ui, const ui_namco_desc_t* ui_desc) {
 
 void ui_namco_discard(ui_namco_t* ui) {
     CHIPS_ASSERT(ui && ui->sys);
+    ui_snapshot_discard(&ui->snapshot);
     ui_dbg_discard(&ui->dbg);
     ui_memmap_discard(&ui->memmap);
     for (int i = 0; i < 4; i++) {
@@ -359,6 +364,7 @@ chips_debug_t ui_namco_get_debug(ui_namco_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 #endif // CHIPS_UI_IMPL
@@ -0,0 +1,186 @@
+#pragma once
+/*#
+    # ui_profile.h
+
+    Display the per-subsystem tick profiling results of an emulated system
+    (see chips_profile_t in chips_common.h).
+
+    Do this:
+    ~~~C
+    #define CHIPS_UI_IMPL
+    ~~~
+    before you include this file in *one* C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    Include the following headers before including the *implementation*:
+        - imgui.h
+        - chips_common.h
+
+    The window is only available when CHIPS_PROFILE is defined, otherwise
+    this header is empty.
+
+    All string data provided to the ui_profile_init() must remain alive until
+    until ui_profile_discard() is called!
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CHIPS_PROFILE)
+/* setup parameters for ui_profile_init()
+    NOTE: all string data must remain alive until ui_profile_discard()!
+*/
+typedef struct {
+    const char* title;          /* window title */
+    chips_profile_t* profile;   /* pointer to the system's profiling state */
+    int x, y;                   /* initial window position */
+    int w, h;                   /* initial window size or zero for default size */
+    bool open;                  /* initial open state */
+} ui_profile_desc_t;
+
+typedef struct {
+    const char* title;
+    chips_profile_t* profile;
+    float init_x, init_y;
+    float init_w, init_h;
+    bool open;
+    bool valid;
+} ui_profile_t;
+
+void ui_profile_init(ui_profile_t* win, const ui_profile_desc_t* desc);
+void ui_profile_discard(ui_profile_t* win);
+void ui_profile_draw(ui_profile_t* win);
+#endif /* CHIPS_PROFILE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION (include in C++ source) ----------------------------------*/
+#ifdef CHIPS_UI_IMPL
+#ifndef __cplusplus
+#error "implementation must be compiled as C++"
+#endif
+#if defined(CHIPS_PROFILE)
+#include <string.h> /* memset */
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void ui_profile_init(ui_profile_t* win, const ui_profile_desc_t* desc) {
+    CHIPS_ASSERT(win && desc);
+    CHIPS_ASSERT(desc->title);
+    CHIPS_ASSERT(desc->profile);
+    memset(win, 0, sizeof(ui_profile_t));
+    win->title = desc->title;
+    win->profile = desc->profile;
+    win->init_x = (float) desc->x;
+    win->init_y = (float) desc->y;
+    win->init_w = (float) ((desc->w == 0) ? 320 : desc->w);
+    win->init_h = (float) ((desc->h == 0) ? 400 : desc->h);
+    win->open = desc->open;
+    win->valid = true;
+}
+
+void ui_profile_discard(ui_profile_t* win) {
+    CHIPS_ASSERT(win && win->valid);
+    win->valid = false;
+}
+
+void ui_profile_draw(ui_profile_t* win) {
+    CHIPS_ASSERT(win && win->valid && win->title && win->profile);
+    if (!win->open) {
+        return;
+    }
+    ImGui::SetNextWindowPos(ImVec2(win->init_x, win->init_y), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(win->init_w, win->init_h), ImGuiCond_Once);
+    if (ImGui::Begin(win->title, &win->open)) {
+        chips_profile_t* prof = win->profile;
+        if (ImGui::Button("Reset")) {
+            chips_profile_reset(prof);
+        }
+        ImGui::SameLine();
+        ImGui::Text("%llu sampled ticks", (unsigned long long)prof->sampled_ticks);
+        ImGui::Separator();
+
+        // host cycles per emulated tick for each subsystem
+        uint64_t total_cycles = 0;
+        for (int i = 0; i < prof->num_sections; i++) {
+            total_cycles += prof->section_cycles[i];
+        }
+        const double num_sampled = (prof->sampled_ticks > 0) ? (double)prof->sampled_ticks : 1.0;
+        ImGui::Columns(3, "##sections", false);
+        ImGui::SetColumnWidth(0, 96);
+        ImGui::SetColumnWidth(1, 96);
+        ImGui::Text("Section"); ImGui::NextColumn();
+        ImGui::Text("Cycles/Tick"); ImGui::NextColumn();
+        ImGui::Text("Share"); ImGui::NextColumn();
+        for (int i = 0; i < prof->num_sections; i++) {
+            const uint64_t cycles = prof->section_cycles[i];
+            const float share = (total_cycles > 0) ? (float)((double)cycles / (double)total_cycles) : 0.0f;
+            ImGui::Text("%s", prof->section_names[i]); ImGui::NextColumn();
+            ImGui::Text("%.1f", (double)cycles / num_sampled); ImGui::NextColumn();
+            ImGui::Text("%.1f%%", share * 100.0f); ImGui::NextColumn();
+        }
+        ImGui::Text("Total"); ImGui::NextColumn();
+        ImGui::Text("%.1f", (double)total_cycles / num_sampled); ImGui::NextColumn();
+        ImGui::NextColumn();
+        ImGui::Columns();
+        ImGui::Separator();
+
+        // chip access counters, total and average per exec call
+        const double num_calls = (prof->exec_calls > 0) ? (double)prof->exec_calls : 1.0;
+        ImGui::Columns(3, "##counters", false);
+        ImGui::SetColumnWidth(0, 96);
+        ImGui::SetColumnWidth(1, 96);
+        ImGui::Text("Access"); ImGui::NextColumn();
+        ImGui::Text("Total"); ImGui::NextColumn();
+        ImGui::Text("Per Exec"); ImGui::NextColumn();
+        for (int i = 0; i < prof->num_counters; i++) {
+            ImGui::Text("%s", prof->counter_names[i]); ImGui::NextColumn();
+            ImGui::Text("%llu", (unsigned long long)prof->counters[i]); ImGui::NextColumn();
+            ImGui::Text("%.1f", (double)prof->counters[i] / num_calls); ImGui::NextColumn();
+        }
+        ImGui::Columns();
+        ImGui::Separator();
+
+        // host cycles per exec call
+        const double num_ticks = (prof->ticks > 0) ? (double)prof->ticks : 1.0;
+        ImGui::Text("Exec calls:       %llu", (unsigned long long)prof->exec_calls);
+        ImGui::Text("Last exec:        %llu cycles (%u ticks)", (unsigned long long)prof->last_exec_cycles, prof->last_exec_ticks);
+        ImGui::Text("Average exec:     %.0f cycles", (double)prof->exec_cycles / num_calls);
+        ImGui::Text("Cycles per tick:  %.1f", (double)prof->exec_cycles / num_ticks);
+    }
+    ImGui::End();
+}
+#endif /* CHIPS_PROFILE */
+#endif /* CHIPS_UI_IMPL */
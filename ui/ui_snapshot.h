@@ -23,6 +23,51 @@
 
         - imgui.h
 
+    ## Compressed Slots
+
+    By default the snapshot data is stored by the frontend in the save
+    callback, and the frontend provides a screenshot texture for each
+    slot with ui_snapshot_set_screenshot().
+
+    Alternatively, provide a memory buffer in ui_snapshot_desc_t.storage to
+    let ui_snapshot_t store the snapshots itself. Call ui_snapshot_store()
+    from the save callback, and ui_snapshot_fetch() from the load
+    callback:
+
+    ~~~C
+    static void save_snapshot(size_t slot_index) {
+        static zx_t snapshot;
+        uint32_t version = zx_save_snapshot(&state.zx, &snapshot);
+        ui_snapshot_store(&state.ui.snapshot, slot_index, version, &snapshot, sizeof(snapshot));
+        ui_snapshot_store_thumbnail(&state.ui.snapshot, slot_index, &(ui_snapshot_image_t){ ... });
+    }
+
+    static bool load_snapshot(size_t slot_index) {
+        static zx_t snapshot;
+        uint32_t version;
+        if (ui_snapshot_fetch(&state.ui.snapshot, slot_index, &version, &snapshot, sizeof(snapshot))) {
+            return zx_load_snapshot(&state.zx, version, &snapshot);
+        }
+        return false;
+    }
+    ~~~
+
+    Snapshots are compressed with a small LZ77 byte codec (snapshot images
+    are mostly zeros and repeated bytes and usually shrink by an order of
+    magnitude). The buffer is split into a staging area for one
+    uncompressed snapshot and equally sized compressed slot areas. If
+    storage.background is true, ui_snapshot_store() only copies the
+    snapshot into the staging area and the compression runs on a worker
+    thread (pthreads on POSIX platforms, link with -pthread, Win32 threads
+    on Windows). A slot which is still being compressed is waited for in
+    ui_snapshot_fetch(). If the compressed snapshot doesn't fit into its
+    slot area, the slot becomes empty.
+
+    ui_snapshot_store_thumbnail() downscales the framebuffer into a
+    UI_SNAPSHOT_THUMBNAIL_SIZE pixel thumbnail texture which is owned by
+    ui_snapshot_t (created through the desc.texture_cbs callbacks), instead
+    of keeping a full-size screenshot texture per slot.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -44,12 +89,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define UI_SNAPSHOT_MAX_SLOTS (8)
+#define UI_SNAPSHOT_THUMBNAIL_SIZE (64)        // long edge of a thumbnail in pixels, the short edge is 3/4
+#define UI_SNAPSHOT_LZ_HASH_BITS (12)
 
 // callback function to save snapshot to a numbered slot
 typedef void (*ui_snapshot_save_t)(size_t slot_index);
@@ -62,10 +112,34 @@ typedef struct {
     bool portrait;
 } ui_snapshot_screenshot_t;
 
+// thumbnail texture callbacks (same signatures as ui_dbg_texture_callbacks_t)
+typedef struct {
+    void* (*create_cb)(int w, int h);
+    void (*update_cb)(void* tex_handle, void* data, int data_byte_size);
+    void (*destroy_cb)(void* tex_handle);
+} ui_snapshot_texture_callbacks_t;
+
+// a source image for ui_snapshot_store_thumbnail()
+typedef struct {
+    const void* pixels;         // 8-bit palette indices (if palette is set), or RGBA8 pixels
+    const uint32_t* palette;    // optional 256-entry RGBA8 palette
+    int width;                  // width of the source image area in pixels
+    int height;                 // height of the source image area in pixels
+    int stride;                 // bytes per source row
+    bool portrait;
+} ui_snapshot_image_t;
+
 // a snapshot slot
 typedef struct {
     bool valid;
     ui_snapshot_screenshot_t screenshot;
+    // only with built-in storage:
+    bool pending;               // being compressed on the worker thread
+    uint32_t version;           // snapshot version passed to ui_snapshot_store()
+    size_t size;                // uncompressed snapshot size
+    size_t packed_size;         // compressed snapshot size
+    void* thumbnail;            // thumbnail texture (owned by ui_snapshot_t)
+    bool thumbnail_portrait;
 } ui_snapshot_slot_t;
 
 // initialization parameters
@@ -73,6 +147,14 @@ typedef struct {
     ui_snapshot_save_t save_cb;
     ui_snapshot_load_t load_cb;
     ui_snapshot_screenshot_t empty_slot_screenshot;
+    // optional built-in compressed slot storage
+    struct {
+        void* ptr;              // memory buffer for staging area and all slots
+        size_t size;
+        size_t snapshot_size;   // max size of an uncompressed snapshot
+        bool background;        // compress on a worker thread
+    } storage;
+    ui_snapshot_texture_callbacks_t texture_cbs;    // for thumbnails
 } ui_snapshot_desc_t;
 
 // snapshot system state
@@ -80,10 +162,39 @@ typedef struct {
     ui_snapshot_save_t save_cb;
     ui_snapshot_load_t load_cb;
     ui_snapshot_slot_t slots[UI_SNAPSHOT_MAX_SLOTS];
+    ui_snapshot_texture_callbacks_t texture_cbs;
+    struct {
+        bool valid;
+        bool background;
+        uint8_t* staging;       // uncompressed snapshot which is being compressed
+        size_t snapshot_size;
+        uint8_t* slot_ptr[UI_SNAPSHOT_MAX_SLOTS];
+        size_t slot_size;
+        uint32_t hash_table[1<<UI_SNAPSHOT_LZ_HASH_BITS];
+        // compression job, shared with the worker thread
+        int job_slot;
+        size_t job_size;
+        size_t job_result;
+        bool job_pending;       // job waits for or is running on the worker thread
+        bool job_done;          // job finished, result not yet picked up
+        bool quit;
+        #if defined(_WIN32)
+        void* thread;
+        void* lock;             // SRWLOCK
+        void* cond;             // CONDITION_VARIABLE
+        #else
+        pthread_t thread;
+        pthread_mutex_t lock;
+        pthread_cond_t cond;
+        #endif
+    } storage;
+    uint32_t thumbnail_pixels[UI_SNAPSHOT_THUMBNAIL_SIZE * UI_SNAPSHOT_THUMBNAIL_SIZE];
 } ui_snapshot_t;
 
 // initialize the snapshot instance
 void ui_snapshot_init(ui_snapshot_t* state, const ui_snapshot_desc_t* desc);
+// discard the snapshot instance (stops the worker thread and destroys thumbnails)
+void ui_snapshot_discard(ui_snapshot_t* state);
 // inject snap menu UI
 void ui_snapshot_menus(ui_snapshot_t* state);
 // called from UI when a snapshot should be saved
@@ -92,6 +203,12 @@ void ui_snapshot_save_slot(ui_snapshot_t* state, size_t slot_index);
 bool ui_snapshot_load_slot(ui_snapshot_t* state, size_t slot_index);
 // update snapshot info, returns previous slot info (usually called from within save callback)
 ui_snapshot_screenshot_t ui_snapshot_set_screenshot(ui_snapshot_t* state, size_t slot_index, ui_snapshot_screenshot_t screenshot);
+// built-in storage: compress a snapshot into a slot (usually called from within save callback)
+bool ui_snapshot_store(ui_snapshot_t* state, size_t slot_index, uint32_t version, const void* snapshot, size_t size);
+// built-in storage: decompress a slot's snapshot, returns false if the slot is empty
+bool ui_snapshot_fetch(ui_snapshot_t* state, size_t slot_index, uint32_t* out_version, void* dst, size_t dst_size);
+// set a slot's screenshot to a downscaled thumbnail of an image (requires texture callbacks)
+void ui_snapshot_store_thumbnail(ui_snapshot_t* state, size_t slot_index, const ui_snapshot_image_t* image);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -104,6 +221,248 @@ ui_snapshot_screenshot_t ui_snapshot_set_screenshot(ui_snapshot_t* state, size_t
     #include <assert.h>
     #define CHIPS_ASSERT(c) assert(c)
 #endif
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+#if defined(_WIN32)
+#define _ui_snapshot_lock(s)        AcquireSRWLockExclusive((PSRWLOCK)&(s)->storage.lock)
+#define _ui_snapshot_unlock(s)      ReleaseSRWLockExclusive((PSRWLOCK)&(s)->storage.lock)
+#define _ui_snapshot_wait(s)        SleepConditionVariableSRW((PCONDITION_VARIABLE)&(s)->storage.cond, (PSRWLOCK)&(s)->storage.lock, INFINITE, 0)
+#define _ui_snapshot_broadcast(s)   WakeAllConditionVariable((PCONDITION_VARIABLE)&(s)->storage.cond)
+#else
+#define _ui_snapshot_lock(s)        pthread_mutex_lock(&(s)->storage.lock)
+#define _ui_snapshot_unlock(s)      pthread_mutex_unlock(&(s)->storage.lock)
+#define _ui_snapshot_wait(s)        pthread_cond_wait(&(s)->storage.cond, &(s)->storage.lock)
+#define _ui_snapshot_broadcast(s)   pthread_cond_broadcast(&(s)->storage.cond)
+#endif
+
+/*
+    LZ77 byte codec, a sequence of:
+
+    - token byte: literal count in upper 4 bits, match length - 4 in lower 4 bits,
+      a nibble value of 15 is continued in extra bytes (added up until a byte < 255)
+    - extra literal count bytes, the literal bytes
+    - unless this is the last sequence: 16-bit little-endian match offset
+      and extra match length bytes
+*/
+#define _UI_SNAPSHOT_LZ_MIN_MATCH (4)
+#define _UI_SNAPSHOT_LZ_MAX_OFFSET (0xFFFF)
+
+static inline uint32_t _ui_snapshot_lz_read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t _ui_snapshot_lz_hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - UI_SNAPSHOT_LZ_HASH_BITS);
+}
+
+static uint8_t* _ui_snapshot_lz_put_len(uint8_t* op, const uint8_t* oend, size_t len) {
+    while (len >= 255) {
+        if (op >= oend) {
+            return 0;
+        }
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= oend) {
+        return 0;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+// emit one sequence, returns 0 if the output buffer is too small
+static uint8_t* _ui_snapshot_lz_put_seq(uint8_t* op, const uint8_t* oend, const uint8_t* lit, size_t num_lit, size_t offset, size_t match_len) {
+    if (op >= oend) {
+        return 0;
+    }
+    uint8_t* token = op++;
+    *token = (uint8_t)(((num_lit < 15) ? num_lit : 15) << 4);
+    if ((num_lit >= 15) && (0 == (op = _ui_snapshot_lz_put_len(op, oend, num_lit - 15)))) {
+        return 0;
+    }
+    if ((size_t)(oend - op) < num_lit) {
+        return 0;
+    }
+    memcpy(op, lit, num_lit);
+    op += num_lit;
+    if (match_len > 0) {
+        if ((oend - op) < 2) {
+            return 0;
+        }
+        *op++ = (uint8_t)offset;
+        *op++ = (uint8_t)(offset >> 8);
+        const size_t len = match_len - _UI_SNAPSHOT_LZ_MIN_MATCH;
+        *token |= (uint8_t)((len < 15) ? len : 15);
+        if ((len >= 15) && (0 == (op = _ui_snapshot_lz_put_len(op, oend, len - 15)))) {
+            return 0;
+        }
+    }
+    return op;
+}
+
+// returns compressed size, or 0 if the result doesn't fit into dst
+static size_t _ui_snapshot_lz_compress(uint32_t* hash_table, const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    memset(hash_table, 0, sizeof(uint32_t) << UI_SNAPSHOT_LZ_HASH_BITS);
+    const uint8_t* ip = src;
+    const uint8_t* lit = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dst_size;
+    while ((iend - ip) >= _UI_SNAPSHOT_LZ_MIN_MATCH) {
+        const uint32_t v = _ui_snapshot_lz_read32(ip);
+        const uint32_t h = _ui_snapshot_lz_hash(v);
+        // hash table entries are positions + 1, 0 is an empty entry
+        const size_t cand = hash_table[h];
+        hash_table[h] = (uint32_t)(ip - src) + 1;
+        if ((cand > 0) && (((size_t)(ip - src) + 1 - cand) <= _UI_SNAPSHOT_LZ_MAX_OFFSET) && (_ui_snapshot_lz_read32(src + cand - 1) == v)) {
+            const uint8_t* mp = src + cand - 1;
+            const uint8_t* mip = ip + _UI_SNAPSHOT_LZ_MIN_MATCH;
+            mp += _UI_SNAPSHOT_LZ_MIN_MATCH;
+            while ((mip < iend) && (*mip == *mp)) {
+                mip++;
+                mp++;
+            }
+            op = _ui_snapshot_lz_put_seq(op, oend, lit, (size_t)(ip - lit), (size_t)(mip - mp), (size_t)(mip - ip));
+            if (0 == op) {
+                return 0;
+            }
+            ip = lit = mip;
+        }
+        else {
+            ip++;
+        }
+    }
+    op = _ui_snapshot_lz_put_seq(op, oend, lit, (size_t)(iend - lit), 0, 0);
+    return op ? (size_t)(op - dst) : 0;
+}
+
+// returns false on corrupt data or if the decompressed size doesn't match dst_size
+static bool _ui_snapshot_lz_decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dst_size;
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+        size_t num_lit = token >> 4;
+        if (num_lit == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return false;
+                }
+                b = *ip++;
+                num_lit += b;
+            } while (b == 255);
+        }
+        if (((size_t)(iend - ip) < num_lit) || ((size_t)(oend - op) < num_lit)) {
+            return false;
+        }
+        memcpy(op, ip, num_lit);
+        ip += num_lit;
+        op += num_lit;
+        if (ip == iend) {
+            // last sequence has no match
+            break;
+        }
+        if ((iend - ip) < 2) {
+            return false;
+        }
+        const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t len = (token & 15);
+        if (len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return false;
+                }
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+        }
+        len += _UI_SNAPSHOT_LZ_MIN_MATCH;
+        if ((offset == 0) || (offset > (size_t)(op - dst)) || ((size_t)(oend - op) < len)) {
+            return false;
+        }
+        // byte-wise copy, matches may overlap
+        const uint8_t* mp = op - offset;
+        for (size_t i = 0; i < len; i++) {
+            *op++ = *mp++;
+        }
+    }
+    return op == oend;
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI _ui_snapshot_thread_func(LPVOID arg) {
+#else
+static void* _ui_snapshot_thread_func(void* arg) {
+#endif
+    ui_snapshot_t* state = (ui_snapshot_t*) arg;
+    for (;;) {
+        _ui_snapshot_lock(state);
+        while (!state->storage.job_pending && !state->storage.quit) {
+            _ui_snapshot_wait(state);
+        }
+        const bool quit = state->storage.quit;
+        const int slot_index = state->storage.job_slot;
+        const size_t size = state->storage.job_size;
+        _ui_snapshot_unlock(state);
+        if (quit) {
+            break;
+        }
+        const size_t result = _ui_snapshot_lz_compress(state->storage.hash_table,
+            state->storage.staging, size,
+            state->storage.slot_ptr[slot_index], state->storage.slot_size);
+        _ui_snapshot_lock(state);
+        state->storage.job_result = result;
+        state->storage.job_pending = false;
+        state->storage.job_done = true;
+        _ui_snapshot_broadcast(state);
+        _ui_snapshot_unlock(state);
+    }
+    return 0;
+}
+
+// pick up the result of a finished compression job
+static void _ui_snapshot_finish_job(ui_snapshot_t* state) {
+    ui_snapshot_slot_t* slot = &state->slots[state->storage.job_slot];
+    slot->pending = false;
+    slot->packed_size = state->storage.job_result;
+    if (0 == slot->packed_size) {
+        // didn't fit into the slot
+        slot->valid = false;
+    }
+    state->storage.job_done = false;
+    state->storage.job_slot = -1;
+}
+
+// poll for a finished job (wait == false) or wait for the current job to finish
+static void _ui_snapshot_sync(ui_snapshot_t* state, bool wait) {
+    if (!state->storage.valid || (state->storage.job_slot < 0)) {
+        return;
+    }
+    bool done;
+    _ui_snapshot_lock(state);
+    if (wait) {
+        while (state->storage.job_pending) {
+            _ui_snapshot_wait(state);
+        }
+    }
+    done = state->storage.job_done;
+    _ui_snapshot_unlock(state);
+    if (done) {
+        _ui_snapshot_finish_job(state);
+    }
+}
 
 void ui_snapshot_init(ui_snapshot_t* state, const ui_snapshot_desc_t* desc) {
     CHIPS_ASSERT(state && desc);
@@ -111,9 +470,62 @@ void ui_snapshot_init(ui_snapshot_t* state, const ui_snapshot_desc_t* desc) {
     memset(state, 0, sizeof(ui_snapshot_t));
     state->save_cb = desc->save_cb;
     state->load_cb = desc->load_cb;
+    state->texture_cbs = desc->texture_cbs;
     for (size_t i = 0; i < UI_SNAPSHOT_MAX_SLOTS; i++) {
         state->slots[i].screenshot = desc->empty_slot_screenshot;
     }
+    state->storage.job_slot = -1;
+    if (desc->storage.ptr) {
+        CHIPS_ASSERT(desc->storage.snapshot_size > 0);
+        CHIPS_ASSERT(desc->storage.size > (desc->storage.snapshot_size + UI_SNAPSHOT_MAX_SLOTS));
+        uint8_t* ptr = (uint8_t*) desc->storage.ptr;
+        state->storage.valid = true;
+        state->storage.staging = ptr;
+        state->storage.snapshot_size = desc->storage.snapshot_size;
+        state->storage.slot_size = (desc->storage.size - desc->storage.snapshot_size) / UI_SNAPSHOT_MAX_SLOTS;
+        for (size_t i = 0; i < UI_SNAPSHOT_MAX_SLOTS; i++) {
+            state->storage.slot_ptr[i] = ptr + desc->storage.snapshot_size + i * state->storage.slot_size;
+        }
+        state->storage.background = desc->storage.background;
+        if (state->storage.background) {
+            #if defined(_WIN32)
+                InitializeSRWLock((PSRWLOCK)&state->storage.lock);
+                InitializeConditionVariable((PCONDITION_VARIABLE)&state->storage.cond);
+                state->storage.thread = CreateThread(0, 0, _ui_snapshot_thread_func, state, 0, 0);
+                CHIPS_ASSERT(state->storage.thread);
+            #else
+                pthread_mutex_init(&state->storage.lock, 0);
+                pthread_cond_init(&state->storage.cond, 0);
+                const int res = pthread_create(&state->storage.thread, 0, _ui_snapshot_thread_func, state);
+                CHIPS_ASSERT(0 == res); (void)res;
+            #endif
+        }
+    }
+}
+
+void ui_snapshot_discard(ui_snapshot_t* state) {
+    CHIPS_ASSERT(state);
+    if (state->storage.valid && state->storage.background) {
+        _ui_snapshot_lock(state);
+        state->storage.quit = true;
+        _ui_snapshot_broadcast(state);
+        _ui_snapshot_unlock(state);
+        #if defined(_WIN32)
+            WaitForSingleObject((HANDLE)state->storage.thread, INFINITE);
+            CloseHandle((HANDLE)state->storage.thread);
+        #else
+            pthread_join(state->storage.thread, 0);
+            pthread_cond_destroy(&state->storage.cond);
+            pthread_mutex_destroy(&state->storage.lock);
+        #endif
+    }
+    state->storage.valid = false;
+    for (size_t i = 0; i < UI_SNAPSHOT_MAX_SLOTS; i++) {
+        if (state->slots[i].thumbnail) {
+            state->texture_cbs.destroy_cb(state->slots[i].thumbnail);
+            state->slots[i].thumbnail = 0;
+        }
+    }
 }
 
 static bool ui_snapshot_draw_menu_slot(const char* sel_id, ui_snapshot_screenshot_t screenshot) {
@@ -127,6 +539,7 @@ static bool ui_snapshot_draw_menu_slot(const char* sel_id, ui_snapshot_screensho
 
 void ui_snapshot_menus(ui_snapshot_t* state) {
     CHIPS_ASSERT(state);
+    _ui_snapshot_sync(state, false);
     if (ImGui::BeginMenu("Save Snapshot")) {
         for (size_t slot_index = 0; slot_index < UI_SNAPSHOT_MAX_SLOTS; slot_index++) {
             const ui_snapshot_screenshot_t screenshot = state->slots[slot_index].screenshot;
@@ -204,4 +617,106 @@ ui_snapshot_screenshot_t ui_snapshot_set_screenshot(ui_snapshot_t* state, size_t
     state->slots[slot_index].screenshot = screenshot;
     return prev_screenshot;
 }
+
+bool ui_snapshot_store(ui_snapshot_t* state, size_t slot_index, uint32_t version, const void* snapshot, size_t size) {
+    CHIPS_ASSERT(state && state->storage.valid && snapshot);
+    CHIPS_ASSERT(slot_index < UI_SNAPSHOT_MAX_SLOTS);
+    if (size > state->storage.snapshot_size) {
+        return false;
+    }
+    // the staging area is still in use by the previous compression job
+    _ui_snapshot_sync(state, true);
+    ui_snapshot_slot_t* slot = &state->slots[slot_index];
+    memcpy(state->storage.staging, snapshot, size);
+    slot->valid = true;
+    slot->pending = true;
+    slot->version = version;
+    slot->size = size;
+    slot->packed_size = 0;
+    state->storage.job_slot = (int)slot_index;
+    state->storage.job_size = size;
+    if (state->storage.background) {
+        _ui_snapshot_lock(state);
+        state->storage.job_pending = true;
+        _ui_snapshot_broadcast(state);
+        _ui_snapshot_unlock(state);
+        return true;
+    }
+    else {
+        state->storage.job_result = _ui_snapshot_lz_compress(state->storage.hash_table,
+            state->storage.staging, size,
+            state->storage.slot_ptr[slot_index], state->storage.slot_size);
+        _ui_snapshot_finish_job(state);
+        return slot->valid;
+    }
+}
+
+bool ui_snapshot_fetch(ui_snapshot_t* state, size_t slot_index, uint32_t* out_version, void* dst, size_t dst_size) {
+    CHIPS_ASSERT(state && state->storage.valid && out_version && dst);
+    CHIPS_ASSERT(slot_index < UI_SNAPSHOT_MAX_SLOTS);
+    ui_snapshot_slot_t* slot = &state->slots[slot_index];
+    if (slot->pending) {
+        _ui_snapshot_sync(state, true);
+    }
+    if (!slot->valid || (slot->packed_size == 0) || (dst_size < slot->size)) {
+        return false;
+    }
+    *out_version = slot->version;
+    return _ui_snapshot_lz_decompress(state->storage.slot_ptr[slot_index], slot->packed_size, (uint8_t*)dst, slot->size);
+}
+
+void ui_snapshot_store_thumbnail(ui_snapshot_t* state, size_t slot_index, const ui_snapshot_image_t* image) {
+    CHIPS_ASSERT(state && image && image->pixels && (image->width > 0) && (image->height > 0));
+    CHIPS_ASSERT(slot_index < UI_SNAPSHOT_MAX_SLOTS);
+    CHIPS_ASSERT(state->texture_cbs.create_cb && state->texture_cbs.update_cb && state->texture_cbs.destroy_cb);
+    ui_snapshot_slot_t* slot = &state->slots[slot_index];
+    const int tw = image->portrait ? (UI_SNAPSHOT_THUMBNAIL_SIZE * 3) / 4 : UI_SNAPSHOT_THUMBNAIL_SIZE;
+    const int th = image->portrait ? UI_SNAPSHOT_THUMBNAIL_SIZE : (UI_SNAPSHOT_THUMBNAIL_SIZE * 3) / 4;
+    if (slot->thumbnail && (slot->thumbnail_portrait != image->portrait)) {
+        state->texture_cbs.destroy_cb(slot->thumbnail);
+        slot->thumbnail = 0;
+    }
+    if (0 == slot->thumbnail) {
+        slot->thumbnail = state->texture_cbs.create_cb(tw, th);
+        slot->thumbnail_portrait = image->portrait;
+    }
+    // box-filter the source image down to the thumbnail size
+    const uint8_t* src = (const uint8_t*) image->pixels;
+    for (int y = 0; y < th; y++) {
+        const int y0 = (y * image->height) / th;
+        int y1 = ((y + 1) * image->height) / th;
+        if (y1 <= y0) {
+            y1 = y0 + 1;
+        }
+        for (int x = 0; x < tw; x++) {
+            const int x0 = (x * image->width) / tw;
+            int x1 = ((x + 1) * image->width) / tw;
+            if (x1 <= x0) {
+                x1 = x0 + 1;
+            }
+            uint32_t r = 0, g = 0, b = 0, n = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const uint8_t* row = src + sy * image->stride;
+                for (int sx = x0; sx < x1; sx++) {
+                    uint32_t c;
+                    if (image->palette) {
+                        c = image->palette[row[sx]];
+                    }
+                    else {
+                        memcpy(&c, row + sx * 4, sizeof(c));
+                    }
+                    r += c & 0xFF;
+                    g += (c >> 8) & 0xFF;
+                    b += (c >> 16) & 0xFF;
+                    n++;
+                }
+            }
+            state->thumbnail_pixels[y * tw + x] = 0xFF000000 | ((b / n) << 16) | ((g / n) << 8) | (r / n);
+        }
+    }
+    state->texture_cbs.update_cb(slot->thumbnail, state->thumbnail_pixels, tw * th * (int)sizeof(uint32_t));
+    slot->valid = true;
+    slot->screenshot.texture = slot->thumbnail;
+    slot->screenshot.portrait = image->portrait;
+}
 #endif
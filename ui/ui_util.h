@@ -18,11 +18,43 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    You need to include the following headers before including ui_util.h:
+
+        - chips/chips_common.h
+
     You need to include the following headers before including the
     *implementation*:
 
         - imgui.h
 
+    ## State Capture
+
+    Most chip windows read the emulator state directly while drawing,
+    which means that the UI must run on the same thread as the emulator.
+    Windows which support state capture (currently ui_audio_t, ui_m6569_t
+    and ui_am40010_t) can instead draw from a copy of the state:
+
+    - enable capturing with the window's ui_*_set_capture() function and a
+      capture interval (1: capture on each call, 2: every other call, ...,
+      0: disable capturing and draw from the live state again)
+    - on the emulation thread, call the window's ui_*_capture() function
+      after each *_exec(), this copies the state the window needs, but
+      only when the window is open and the capture interval is due, so
+      hidden windows cost nothing
+    - the UI thread calls the ui_*_draw() function as usual, which now
+      draws the most recent capture
+
+    The captured copies are handed over through a chips_triple_buffer_t,
+    so neither thread ever waits for the other. Controls which modify the
+    emulator (like the 'Debug Visualization' checkboxes) still write
+    directly into the live state.
+
+    A window implements state capture with a ui_util_capture_t and 3
+    equally sized capture buffers: ui_util_capture_begin() returns the
+    buffer to copy the state into (or a null pointer if no capture is due),
+    ui_util_capture_end() publishes it, and the draw function gets the most
+    recent capture with ui_util_capture_acquire().
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -43,11 +75,20 @@
 #*/
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* throttled state capture for drawing on a separate UI thread (see 'State Capture') */
+typedef struct {
+    chips_triple_buffer_t tb;
+    int interval;       /* capture on every Nth call to ui_util_capture_begin() */
+    int count;
+    bool enabled;
+} ui_util_capture_t;
+
 /* draw an 16-bit hex text input field */
 uint16_t ui_util_input_u16(const char* label, uint16_t val);
 /* draw an 8-bit hex text input field */
@@ -66,6 +107,14 @@ void ui_util_b32(const char* label, uint32_t val);
 uint32_t ui_util_color(int imgui_color);
 /* inject the common options menu */
 void ui_util_options_menu(void);
+/* setup a state capture with 3 caller-provided buffers, initialized from init (or zeroed), interval 0 disables capturing */
+void ui_util_capture_init(ui_util_capture_t* cap, void* buf0, void* buf1, void* buf2, size_t size, const void* init, int interval);
+/* emulation thread: returns the buffer to capture into, or a null pointer if the window is closed or no capture is due */
+void* ui_util_capture_begin(ui_util_capture_t* cap, bool open);
+/* emulation thread: publish the buffer returned by ui_util_capture_begin() */
+void ui_util_capture_end(ui_util_capture_t* cap);
+/* UI thread: get the most recent capture */
+const void* ui_util_capture_acquire(ui_util_capture_t* cap);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -189,6 +238,45 @@ void ui_util_options_menu(void) {
     ImGui::SameLine(ImGui::GetWindowWidth() - 120);
 }
 
+void ui_util_capture_init(ui_util_capture_t* cap, void* buf0, void* buf1, void* buf2, size_t size, const void* init, int interval) {
+    CHIPS_ASSERT(cap && buf0 && buf1 && buf2 && (size > 0) && (interval >= 0));
+    void* bufs[3] = { buf0, buf1, buf2 };
+    for (int i = 0; i < 3; i++) {
+        if (init) {
+            memcpy(bufs[i], init, size);
+        }
+        else {
+            memset(bufs[i], 0, size);
+        }
+    }
+    memset(cap, 0, sizeof(ui_util_capture_t));
+    chips_triple_buffer_init(&cap->tb, buf0, buf1, buf2, size);
+    cap->interval = interval;
+    cap->enabled = interval > 0;
+}
+
+void* ui_util_capture_begin(ui_util_capture_t* cap, bool open) {
+    CHIPS_ASSERT(cap);
+    if (!cap->enabled || !open) {
+        return 0;
+    }
+    if (++cap->count < cap->interval) {
+        return 0;
+    }
+    cap->count = 0;
+    return chips_triple_buffer_back(&cap->tb);
+}
+
+void ui_util_capture_end(ui_util_capture_t* cap) {
+    CHIPS_ASSERT(cap && cap->enabled);
+    chips_triple_buffer_publish(&cap->tb);
+}
+
+const void* ui_util_capture_acquire(ui_util_capture_t* cap) {
+    CHIPS_ASSERT(cap && cap->enabled);
+    return chips_triple_buffer_acquire(&cap->tb);
+}
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
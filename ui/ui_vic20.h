@@ -73,6 +73,7 @@ typedef struct {
     ui_vic20_boot_cb boot_cb;   // reboot callback function
     ui_dbg_texture_callbacks_t dbg_texture;     // user-provided texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;    // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;        // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;    // snapshot ui setup params
 } ui_vic20_desc_t;
 
@@ -401,10 +402,12 @@ void ui_vic20_init(ui_vic20_t* ui, const ui_vic20_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.m6502 = &ui->vic20->cpu;
+        desc.tick = &ui->vic20->tick;
         desc.read_cb = _ui_vic20_mem_read;
         desc.break_cb = _ui_vic20_eval_bp;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui;
         /* custom breakpoint types */
         desc.user_breaktypes[0].label = "Scanline at";
@@ -529,6 +532,7 @@ void ui_vic20_init(ui_vic20_t* ui, const ui_vic20_desc_t* ui_desc) {
 
 void ui_vic20_discard(ui_vic20_t* ui) {
     CHIPS_ASSERT(ui && ui->vic20);
+    ui_snapshot_discard(&ui->snapshot);
     ui->vic20 = 0;
     if (ui->c1530.valid) {
         ui_c1530_discard(&ui->c1530);
@@ -610,6 +614,7 @@ chips_debug_t ui_vic20_get_debug(ui_vic20_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
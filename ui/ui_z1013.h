@@ -66,6 +66,7 @@ typedef struct {
     ui_z1013_boot_t boot_cb; // user-provided callback to reboot to different config
     ui_dbg_texture_callbacks_t dbg_texture; // user-provided texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;            // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;    // snapshot system creation params
 } ui_z1013_desc_t;
 
@@ -283,9 +284,11 @@ void ui_z1013_init(ui_z1013_t* ui, const ui_z1013_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->z1013->cpu;
+        desc.tick = &ui->z1013->tick;
         desc.read_cb = _ui_z1013_mem_read;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->z1013;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -348,6 +351,7 @@ void ui_z1013_init(ui_z1013_t* ui, const ui_z1013_desc_t* ui_desc) {
 
 void ui_z1013_discard(ui_z1013_t* ui) {
     CHIPS_ASSERT(ui && ui->z1013);
+    ui_snapshot_discard(&ui->snapshot);
     ui->z1013 = 0;
     ui_z80_discard(&ui->cpu);
     ui_z80pio_discard(&ui->pio);
@@ -380,6 +384,7 @@ chips_debug_t ui_z1013_get_debug(ui_z1013_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
@@ -69,6 +69,7 @@ typedef struct {
     ui_z9001_boot_t boot_cb; // user-provided callback to reboot to different config
     ui_dbg_texture_callbacks_t dbg_texture; // user-provided texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;        // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;            // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;        // snapshot system creation params
 } ui_z9001_desc_t;
 
@@ -321,9 +322,11 @@ void ui_z9001_init(ui_z9001_t* ui, const ui_z9001_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->z9001->cpu;
+        desc.tick = &ui->z9001->tick;
         desc.read_cb = _ui_z9001_mem_read;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->z9001;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -422,6 +425,7 @@ void ui_z9001_init(ui_z9001_t* ui, const ui_z9001_desc_t* ui_desc) {
 
 void ui_z9001_discard(ui_z9001_t* ui) {
     CHIPS_ASSERT(ui && ui->z9001);
+    ui_snapshot_discard(&ui->snapshot);
     ui->z9001 = 0;
     ui_z80_discard(&ui->cpu);
     ui_z80pio_discard(&ui->pio[0]);
@@ -462,6 +466,7 @@ chips_debug_t ui_z9001_get_debug(ui_z9001_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 
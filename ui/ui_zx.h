@@ -67,6 +67,7 @@ typedef struct {
     ui_zx_boot_t boot_cb; // user-provided callback to reboot to different config
     ui_dbg_texture_callbacks_t dbg_texture; // user-provided texture create/update/destroy callbacks
     ui_dbg_keys_desc_t dbg_keys;            // user-defined hotkeys for ui_dbg_t
+    chips_range_t dbg_trace;                // optional memory for the CPU debugger's execution trace
     ui_snapshot_desc_t snapshot;            // snapshot system creation params
 } ui_zx_desc_t;
 
@@ -216,11 +217,19 @@ static void _ui_zx_update_memmap(ui_zx_t* ui) {
     }
 }
 
-static uint8_t* _ui_zx_memptr(zx_t* zx, int layer, uint16_t addr) {
+/* ROM images may be shared between instances and are read-only then */
+static uint8_t* _ui_zx_romptr(zx_t* zx, int rom_index, uint16_t addr, bool write) {
+    if (write && zx->shared_roms) {
+        return 0;
+    }
+    return (uint8_t*) &zx->rom_ptr[rom_index][addr];
+}
+
+static uint8_t* _ui_zx_memptr(zx_t* zx, int layer, uint16_t addr, bool write) {
     if (0 == layer) {
         /* ZX128 ROM, RAM 5, RAM 2, RAM 0 */
         if (addr < 0x4000) {
-            return &zx->rom[0][addr];
+            return _ui_zx_romptr(zx, 0, addr, write);
         }
         else if (addr < 0x8000) {
             return &zx->ram[5][addr - 0x4000];
@@ -235,7 +244,7 @@ static uint8_t* _ui_zx_memptr(zx_t* zx, int layer, uint16_t addr) {
     else if (1 == layer) {
         /* 48K ROM, RAM 1 */
         if (addr < 0x4000) {
-            return &zx->rom[1][addr];
+            return _ui_zx_romptr(zx, 1, addr, write);
         }
         else if (addr >= 0xC000) {
             return &zx->ram[1][addr - 0xC000];
@@ -258,7 +267,7 @@ static uint8_t _ui_zx_mem_read(int layer, uint16_t addr, void* user_data) {
         return mem_rd(&zx->mem, addr);
     }
     else {
-        uint8_t* ptr = _ui_zx_memptr(zx, layer-1, addr);
+        uint8_t* ptr = _ui_zx_memptr(zx, layer-1, addr, false);
         if (ptr) {
             return *ptr;
         }
@@ -275,7 +284,7 @@ static void _ui_zx_mem_write(int layer, uint16_t addr, uint8_t data, void* user_
         mem_wr(&zx->mem, addr, data);
     }
     else {
-        uint8_t* ptr = _ui_zx_memptr(zx, layer-1, addr);
+        uint8_t* ptr = _ui_zx_memptr(zx, layer-1, addr, true);
         if (ptr) {
             *ptr = data;
         }
@@ -354,9 +363,11 @@ void ui_zx_init(ui_zx_t* ui, const ui_zx_desc_t* ui_desc) {
         desc.x = x;
         desc.y = y;
         desc.z80 = &ui->zx->cpu;
+        desc.tick = &ui->zx->tick;
         desc.read_cb = _ui_zx_mem_read;
         desc.texture_cbs = ui_desc->dbg_texture;
         desc.keys = ui_desc->dbg_keys;
+        desc.trace = ui_desc->dbg_trace;
         desc.user_data = ui->zx;
         ui_dbg_init(&ui->dbg, &desc);
     }
@@ -456,6 +467,7 @@ void ui_zx_init(ui_zx_t* ui, const ui_zx_desc_t* ui_desc) {
 
 void ui_zx_discard(ui_zx_t* ui) {
     CHIPS_ASSERT(ui && ui->zx);
+    ui_snapshot_discard(&ui->snapshot);
     ui->zx = 0;
     ui_z80_discard(&ui->cpu);
     ui_ay38910_discard(&ui->ay);
@@ -492,6 +504,7 @@ chips_debug_t ui_zx_get_debug(ui_zx_t* ui) {
     res.callback.func = (chips_debug_func_t)ui_dbg_tick;
     res.callback.user_data = &ui->dbg;
     res.stopped = &ui->dbg.dbg.stopped;
+    res.breakmap = &ui->dbg.dbg.breakmap;
     return res;
 }
 #ifdef __clang__
@@ -0,0 +1,406 @@
+#pragma once
+/*#
+    # batch.h
+
+    Run many independent emulator instances on a pool of worker threads.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    BATCH_MAX_THREADS
+    ~~~
+        the max number of threads in the pool (default: 64)
+
+    You need to include the following headers before including batch.h:
+
+    - chips/chips_common.h
+
+    On POSIX platforms the implementation uses pthreads (link with
+    -pthread), on Windows the native Win32 threads.
+
+    ## Overview
+
+    Each call to a system's exec function (zx_exec(), cpc_exec(), c64_exec()...)
+    only touches the state of its own system instance, so any number of
+    instances can run in parallel on different threads. The batch runner
+    takes an array of batch items, each item pointing to a system instance,
+    the system's exec function and a time budget, and runs the exec function
+    of every item once per batch_run() call, spread over a pool of worker
+    threads. The instances can be of different system types.
+
+    The calling thread works as pool thread 0, so a pool with num_threads = 1
+    runs everything on the calling thread without starting any threads.
+
+    ## Scheduling
+
+    On each batch_run() call the items array is split into num_threads
+    contiguous ranges, pool thread N first works through range N. With an
+    unchanged items array the same instances are run by the same pool
+    thread on every call, so that an instance's state tends to stay in the
+    caches of the CPU core that thread runs on. A thread which is done with
+    its own range steals the remaining items of the other ranges, so that
+    the work stays balanced when some instances take longer than others
+    (e.g. because they're running a disc loader).
+
+    The batch runner doesn't pin pool threads to CPU cores, this is left to
+    the operating system scheduler.
+
+    ## Usage
+
+    Write a small exec wrapper per system type:
+
+    ~~~C
+    static uint32_t exec_zx(void* sys, uint32_t micro_seconds) {
+        return zx_exec((zx_t*)sys, micro_seconds);
+    }
+    static uint32_t exec_cpc(void* sys, uint32_t micro_seconds) {
+        return cpc_exec((cpc_t*)sys, micro_seconds);
+    }
+    ~~~
+
+    Initialize a batch runner with the number of pool threads, and an
+    optional callback which is called after each item has run:
+
+    ~~~C
+    static batch_t batch;
+    batch_init(&batch, &(batch_desc_t){
+        .num_threads = 8,
+        .done_cb = frame_done,
+        .user_data = ...,
+    });
+    ~~~
+
+    Setup the items array (the per-item budget and user_data can be
+    changed between batch_run() calls):
+
+    ~~~C
+    static batch_item_t items[NUM_INSTANCES];
+    for (int i = 0; i < NUM_ZX; i++) {
+        items[i] = (batch_item_t){ .sys = &zx[i], .exec = exec_zx, .micro_seconds = 20000 };
+    }
+    ...
+    ~~~
+
+    Once per frame, run all items, this blocks until every item has run:
+
+    ~~~C
+    batch_run(&batch, items, NUM_INSTANCES);
+    ~~~
+
+    After batch_run() returns, batch_item_t.num_ticks holds the number of
+    ticks the item's exec function has executed. The done callback is
+    called from the pool thread which ran the item, right after the item's
+    exec function returns, so it must be thread-safe:
+
+    ~~~C
+    static void frame_done(batch_item_t* item, int thread_index, void* user_data) {
+        // the item's system instance has completed its frame
+    }
+    ~~~
+
+    Finally discard the batch runner to stop the pool threads:
+
+    ~~~C
+    batch_discard(&batch);
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BATCH_MAX_THREADS
+#define BATCH_MAX_THREADS (64)
+#endif
+
+// a system exec function wrapper, returns the number of executed ticks
+typedef uint32_t (*batch_exec_t)(void* sys, uint32_t micro_seconds);
+
+// an item in a batch
+typedef struct {
+    void* sys;                  // the system instance
+    batch_exec_t exec;          // the system's exec function wrapper
+    uint32_t micro_seconds;     // time budget for the next batch_run()
+    void* user_data;            // optional user data
+    uint32_t num_ticks;         // out: number of ticks executed in the last batch_run()
+} batch_item_t;
+
+// optional callback which is called from a pool thread after an item's exec function has returned
+typedef void (*batch_done_t)(batch_item_t* item, int thread_index, void* user_data);
+
+// batch_init() parameters
+typedef struct {
+    int num_threads;            // number of pool threads including the calling thread (default: 1)
+    batch_done_t done_cb;       // optional frame-done callback
+    void* user_data;            // user data for the frame-done callback
+} batch_desc_t;
+
+// a pool thread's range of items, on its own cache line
+typedef struct {
+    uint32_t next;              // next unclaimed item index (atomic)
+    uint32_t end;               // end of range
+    uint8_t pad[56];
+} batch_range_t;
+
+typedef struct batch_t batch_t;
+
+// a pool thread
+typedef struct {
+    batch_t* batch;
+    int index;
+    #if defined(_WIN32)
+    void* thread;
+    #else
+    pthread_t thread;
+    #endif
+} batch_thread_t;
+
+// batch runner state
+struct batch_t {
+    bool valid;
+    int num_threads;
+    batch_done_t done_cb;
+    void* user_data;
+    batch_item_t* items;        // the items of the current batch_run()
+    uint32_t generation;        // incremented to start a batch_run() on the pool threads
+    int num_busy;               // number of pool threads still working on the current batch_run()
+    bool quit;
+    #if defined(_WIN32)
+    void* lock;                 // SRWLOCK
+    void* start_cond;           // CONDITION_VARIABLE
+    void* done_cond;            // CONDITION_VARIABLE
+    #else
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    #endif
+    batch_thread_t threads[BATCH_MAX_THREADS];
+    batch_range_t ranges[BATCH_MAX_THREADS];
+};
+
+// initialize a batch runner and start the pool threads
+void batch_init(batch_t* batch, const batch_desc_t* desc);
+// stop the pool threads
+void batch_discard(batch_t* batch);
+// run the exec function of each item once, blocks until all items have run
+void batch_run(batch_t* batch, batch_item_t* items, int num_items);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#endif
+
+#if defined(_MSC_VER)
+#define _BATCH_ATOMIC_FETCH_ADD(p) ((uint32_t)_InterlockedExchangeAdd((volatile long*)(p), 1))
+#else
+#define _BATCH_ATOMIC_FETCH_ADD(p) __atomic_fetch_add((p), 1, __ATOMIC_ACQ_REL)
+#endif
+
+#if defined(_WIN32)
+#define _batch_lock(b)          AcquireSRWLockExclusive((PSRWLOCK)&(b)->lock)
+#define _batch_unlock(b)        ReleaseSRWLockExclusive((PSRWLOCK)&(b)->lock)
+#define _batch_wait(b, c)       SleepConditionVariableSRW((PCONDITION_VARIABLE)&(b)->c, (PSRWLOCK)&(b)->lock, INFINITE, 0)
+#define _batch_signal(b, c)     WakeConditionVariable((PCONDITION_VARIABLE)&(b)->c)
+#define _batch_broadcast(b, c)  WakeAllConditionVariable((PCONDITION_VARIABLE)&(b)->c)
+#else
+#define _batch_lock(b)          pthread_mutex_lock(&(b)->lock)
+#define _batch_unlock(b)        pthread_mutex_unlock(&(b)->lock)
+#define _batch_wait(b, c)       pthread_cond_wait(&(b)->c, &(b)->lock)
+#define _batch_signal(b, c)     pthread_cond_signal(&(b)->c)
+#define _batch_broadcast(b, c)  pthread_cond_broadcast(&(b)->c)
+#endif
+
+// claim the next item of a range, returns false if the range is exhausted
+static inline bool _batch_claim(batch_range_t* range, uint32_t* out_index) {
+    const uint32_t index = _BATCH_ATOMIC_FETCH_ADD(&range->next);
+    if (index < range->end) {
+        *out_index = index;
+        return true;
+    }
+    return false;
+}
+
+static void _batch_run_item(batch_t* batch, int thread_index, uint32_t item_index) {
+    batch_item_t* item = &batch->items[item_index];
+    item->num_ticks = item->exec(item->sys, item->micro_seconds);
+    if (batch->done_cb) {
+        batch->done_cb(item, thread_index, batch->user_data);
+    }
+}
+
+// work through the thread's own range, then steal from the other ranges
+static void _batch_work(batch_t* batch, int thread_index) {
+    uint32_t item_index;
+    for (int i = 0; i < batch->num_threads; i++) {
+        batch_range_t* range = &batch->ranges[(thread_index + i) % batch->num_threads];
+        while (_batch_claim(range, &item_index)) {
+            _batch_run_item(batch, thread_index, item_index);
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI _batch_thread_func(LPVOID arg) {
+#else
+static void* _batch_thread_func(void* arg) {
+#endif
+    batch_thread_t* thread = (batch_thread_t*) arg;
+    batch_t* batch = thread->batch;
+    uint32_t generation = 0;
+    for (;;) {
+        _batch_lock(batch);
+        while ((generation == batch->generation) && !batch->quit) {
+            _batch_wait(batch, start_cond);
+        }
+        const bool quit = batch->quit;
+        generation = batch->generation;
+        _batch_unlock(batch);
+        if (quit) {
+            break;
+        }
+        _batch_work(batch, thread->index);
+        _batch_lock(batch);
+        if (--batch->num_busy == 0) {
+            _batch_signal(batch, done_cond);
+        }
+        _batch_unlock(batch);
+    }
+    return 0;
+}
+
+void batch_init(batch_t* batch, const batch_desc_t* desc) {
+    CHIPS_ASSERT(batch && desc);
+    CHIPS_ASSERT((desc->num_threads >= 0) && (desc->num_threads <= BATCH_MAX_THREADS));
+    memset(batch, 0, sizeof(batch_t));
+    batch->valid = true;
+    batch->num_threads = (desc->num_threads > 0) ? desc->num_threads : 1;
+    batch->done_cb = desc->done_cb;
+    batch->user_data = desc->user_data;
+    #if defined(_WIN32)
+        InitializeSRWLock((PSRWLOCK)&batch->lock);
+        InitializeConditionVariable((PCONDITION_VARIABLE)&batch->start_cond);
+        InitializeConditionVariable((PCONDITION_VARIABLE)&batch->done_cond);
+    #else
+        pthread_mutex_init(&batch->lock, 0);
+        pthread_cond_init(&batch->start_cond, 0);
+        pthread_cond_init(&batch->done_cond, 0);
+    #endif
+    // pool thread 0 is the thread calling batch_run()
+    for (int i = 1; i < batch->num_threads; i++) {
+        batch_thread_t* thread = &batch->threads[i];
+        thread->batch = batch;
+        thread->index = i;
+        #if defined(_WIN32)
+            thread->thread = CreateThread(0, 0, _batch_thread_func, thread, 0, 0);
+            CHIPS_ASSERT(thread->thread);
+        #else
+            const int res = pthread_create(&thread->thread, 0, _batch_thread_func, thread);
+            CHIPS_ASSERT(0 == res); (void)res;
+        #endif
+    }
+}
+
+void batch_discard(batch_t* batch) {
+    CHIPS_ASSERT(batch && batch->valid);
+    _batch_lock(batch);
+    batch->quit = true;
+    _batch_broadcast(batch, start_cond);
+    _batch_unlock(batch);
+    for (int i = 1; i < batch->num_threads; i++) {
+        #if defined(_WIN32)
+            WaitForSingleObject((HANDLE)batch->threads[i].thread, INFINITE);
+            CloseHandle((HANDLE)batch->threads[i].thread);
+        #else
+            pthread_join(batch->threads[i].thread, 0);
+        #endif
+    }
+    #if !defined(_WIN32)
+        pthread_cond_destroy(&batch->done_cond);
+        pthread_cond_destroy(&batch->start_cond);
+        pthread_mutex_destroy(&batch->lock);
+    #endif
+    batch->valid = false;
+}
+
+void batch_run(batch_t* batch, batch_item_t* items, int num_items) {
+    CHIPS_ASSERT(batch && batch->valid && (num_items >= 0));
+    CHIPS_ASSERT(items || (num_items == 0));
+    for (int i = 0; i < num_items; i++) {
+        CHIPS_ASSERT(items[i].sys && items[i].exec);
+    }
+    if (num_items == 0) {
+        return;
+    }
+    // split the items into one contiguous range per pool thread
+    batch->items = items;
+    const int num_threads = batch->num_threads;
+    for (int i = 0; i < num_threads; i++) {
+        batch->ranges[i].next = (uint32_t)(((int64_t)num_items * i) / num_threads);
+        batch->ranges[i].end = (uint32_t)(((int64_t)num_items * (i + 1)) / num_threads);
+    }
+    if (num_threads == 1) {
+        _batch_work(batch, 0);
+        return;
+    }
+    _batch_lock(batch);
+    batch->num_busy = num_threads - 1;
+    batch->generation++;
+    _batch_broadcast(batch, start_cond);
+    _batch_unlock(batch);
+    _batch_work(batch, 0);
+    _batch_lock(batch);
+    while (batch->num_busy > 0) {
+        _batch_wait(batch, done_cond);
+    }
+    _batch_unlock(batch);
+}
+#endif /* CHIPS_UTIL_IMPL */
@@ -0,0 +1,946 @@
+#pragma once
+/*#
+    # bench.h
+
+    Throughput benchmarks for the CPU cores, chips and whole systems.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    BENCH_MAX_RESULTS
+    ~~~
+        the max number of results in a bench_t (default: 32)
+
+    Select the chip benchmark kernels with the following defines, and
+    include the respective chip headers before including bench.h:
+
+    - BENCH_USE_Z80: z80.h
+    - BENCH_USE_M6502: m6502.h
+    - BENCH_USE_M6581: m6581.h
+    - BENCH_USE_AY38910: ay38910.h
+    - BENCH_USE_M6569: m6569.h
+    - BENCH_USE_AM40010: mc6845.h, am40010.h
+
+    You always need to include chips/chips_common.h before bench.h.
+
+    ## Overview
+
+    A benchmark is a run function which executes a number of ticks of
+    a chip (or anything else) and returns the number of ticks it has
+    actually executed:
+
+    ~~~C
+    uint32_t my_run(void* user_data, uint32_t num_ticks);
+    ~~~
+
+    bench_measure() calls the run function in chunks of BENCH_CHUNK_TICKS
+    ticks until at least the minimal measurement time has passed (after
+    one untimed warm-up chunk), and records the number of ticks, the
+    elapsed time, the emulated MHz (ticks per microsecond), the host
+    nanoseconds per tick and, if the chip's native frequency is known, the
+    real-time factor (how many times faster than the real chip).
+
+    bench_format() writes all results as JSON lines into a string buffer,
+    one object per benchmark, tagged with an optional revision string
+    (e.g. the git commit hash) so that results can be stored and compared
+    per commit:
+
+    ~~~
+    {"bench":"z80","revision":"5d1f457","ticks":123456789,"seconds":1.002,"mhz":123.21,"ns_per_tick":8.116,"realtime":30.80}
+    ~~~
+
+    The file output and the command line handling are left to the
+    calling program (for instance a chips-test benchmark target).
+
+    ## Chip Kernels
+
+    Each chip kernel has a state struct which contains the chip and all
+    the memory it needs (provided by the caller, nothing is allocated),
+    an init function and a run function which can be passed directly
+    to bench_measure():
+
+    - **bench_z80_t**: runs a CP/M program like ZEXDOC or ZEXALL (the
+      .COM image is loaded to 0x0100). The BDOS character- and string-
+      output calls are trapped and forwarded to an optional output callback,
+      when the program returns to CP/M via address 0x0000 it is restarted.
+    - **bench_m6502_t**: runs a 64 KByte memory image like Klaus Dormann's
+      6502 functional test, starting at a configurable address (default:
+      0x0400). When the program gets stuck in a trap (a jump or branch to
+      itself, which the test uses to signal both success and failure), the
+      trap address is recorded and the program restarted.
+    - **bench_m6581_t**: the SID playing a sawtooth, pulse and noise voice
+      through the low-pass filter.
+    - **bench_ay38910_t**: the AY-3-8910 playing three tone channels with
+      noise and envelope.
+    - **bench_m6569_t**: the VIC-II displaying a text screen with all
+      eight sprites, fetching from a 16 KByte RAM filled with pseudo-random
+      data.
+    - **bench_am40010_t**: the CPC gate array and CRTC decoding a mode 1
+      screen from pseudo-random video memory.
+
+    The CPU kernels serve memory requests from a flat 64 KByte array, so
+    the numbers measure the core itself and not a system's memory mapping.
+
+    ## System Benchmarks
+
+    bench_measure_system() runs a whole emulated system for a number of
+    frames through its exec function (wrapped the same way as for batch.h),
+    once with video decoding and once in headless mode (see
+    chips_headless_t), and stores one result per run with the variant
+    "video" or "headless". In addition to the tick-based numbers, system
+    results contain the frames per second, the size of the system instance
+    and the peak resident set size of the host process after the run (from
+    getrusage() or GetProcessMemoryInfo(), 0 if unavailable). The peak RSS is
+    a process-wide number, so to track it per system type run each system in
+    its own process.
+
+    Initialize the system with the standard ROMs and bring it into the
+    canned workload (for instance boot into BASIC and start a program
+    with the system's key input or a util/movie.h replay) before calling
+    bench_measure_system(), the exec wrapper can also feed input during
+    the measured frames:
+
+    ~~~C
+    static uint32_t exec_c64(void* sys, uint32_t micro_seconds) {
+        return c64_exec((c64_t*)sys, micro_seconds);
+    }
+    ...
+    bench_measure_system(&bench, &(bench_system_t){
+        .name = "c64",
+        .exec = exec_c64,
+        .sys = &c64,
+        .sys_size = sizeof(c64),
+        .headless = &c64.headless,
+        .num_frames = 500,
+        .frame_us = 19950,
+        .freq_hz = C64_FREQUENCY,
+    });
+    ~~~
+
+    ## Baselines
+
+    bench_compare() takes a baseline in the JSON lines format written by
+    bench_format() (for instance from an earlier commit), finds the matching
+    baseline entry for each result by name and variant, and flags a result
+    as regressed if its ns per tick exceeds the baseline by more than the
+    tolerance (a fraction, default: 0.1 for 10%). It returns the number of
+    regressed results, so a benchmark program can fail with a non-zero
+    exit code:
+
+    ~~~C
+    if (bench_compare(&bench, baseline_text, 0.1) > 0) {
+        return 10;
+    }
+    ~~~
+
+    After bench_compare(), bench_format() also writes the baseline ns per
+    tick, the relative change and the regression flag of each result.
+
+    ## Usage
+
+    ~~~C
+    #define CHIPS_IMPL
+    #define CHIPS_UTIL_IMPL
+    #define BENCH_USE_Z80
+    #include "chips/chips_common.h"
+    #include "chips/z80.h"
+    #include "util/bench.h"
+
+    static bench_t bench;
+    static bench_z80_t z80;
+
+    bench_init(&bench, &(bench_desc_t){ .revision = GIT_REVISION });
+    bench_z80_init(&z80, &(bench_z80_desc_t){ .image = { .ptr = zexdoc_com, .size = sizeof(zexdoc_com) } });
+    bench_measure(&bench, &(bench_item_t){
+        .name = "z80",
+        .run = bench_z80_run,
+        .user_data = &z80,
+        .freq_hz = 4000000,
+    });
+    char buf[4096];
+    bench_format(&bench, buf, sizeof(buf));
+    fputs(buf, stdout);
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdalign.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BENCH_MAX_RESULTS
+#define BENCH_MAX_RESULTS (32)
+#endif
+// number of ticks per run function call
+#define BENCH_CHUNK_TICKS (1<<16)
+// default minimal measurement time in seconds
+#define BENCH_DEFAULT_MIN_SECONDS (1.0)
+// default number of frames and frame duration for system benchmarks
+#define BENCH_DEFAULT_NUM_FRAMES (500)
+#define BENCH_DEFAULT_FRAME_US (20000)
+// default regression tolerance for bench_compare()
+#define BENCH_DEFAULT_TOLERANCE (0.1)
+
+// a benchmark run function, returns the number of executed ticks
+typedef uint32_t (*bench_run_t)(void* user_data, uint32_t num_ticks);
+
+// a benchmark to measure with bench_measure()
+typedef struct {
+    const char* name;       // benchmark name (static string)
+    bench_run_t run;        // the run function
+    void* user_data;        // user data for the run function
+    uint32_t freq_hz;       // optional native tick frequency, for the real-time factor
+} bench_item_t;
+
+// a system exec function wrapper, returns the number of executed ticks
+typedef uint32_t (*bench_exec_t)(void* sys, uint32_t micro_seconds);
+
+// a system to measure with bench_measure_system()
+typedef struct {
+    const char* name;               // benchmark name (static string)
+    bench_exec_t exec;              // the system's exec function wrapper
+    void* sys;                      // the system instance
+    size_t sys_size;                // optional size of the system instance in bytes
+    chips_headless_t* headless;     // the system's headless state, or null to skip the headless run
+    uint32_t num_frames;            // number of measured frames per run (default: 500)
+    uint32_t frame_us;              // duration of one frame in micro seconds (default: 20000)
+    uint32_t freq_hz;               // optional system clock frequency
+} bench_system_t;
+
+// a measurement result
+typedef struct {
+    const char* name;
+    const char* variant;    // "video" or "headless" for system results, otherwise null
+    uint64_t ticks;         // number of measured ticks
+    double seconds;         // elapsed host time
+    double mhz;             // emulated MHz (ticks per microsecond)
+    double ns_per_tick;     // host nanoseconds per tick
+    double realtime;        // times faster than the real chip (0 if freq_hz is unknown)
+    // system results only
+    uint32_t frames;        // number of measured frames
+    double fps;             // frames per second
+    size_t instance_bytes;  // size of the system instance
+    size_t peak_rss;        // peak resident set size of the host process in bytes
+    // after bench_compare()
+    double baseline_ns_per_tick;    // 0 if there was no baseline entry
+    bool regressed;
+} bench_result_t;
+
+// bench_init() parameters
+typedef struct {
+    const char* revision;   // optional revision string for the results (e.g. git commit hash)
+    double min_seconds;     // minimal measurement time per benchmark (default: 1 second)
+} bench_desc_t;
+
+// benchmark results
+typedef struct {
+    bool valid;
+    const char* revision;
+    double min_seconds;
+    int num_results;
+    bench_result_t results[BENCH_MAX_RESULTS];
+} bench_t;
+
+// initialize a bench_t instance
+void bench_init(bench_t* bench, const bench_desc_t* desc);
+// measure a benchmark and store its result, returns pointer to result
+const bench_result_t* bench_measure(bench_t* bench, const bench_item_t* item);
+// measure a system with and without video decoding, returns pointer to the first of the (up to two) results
+const bench_result_t* bench_measure_system(bench_t* bench, const bench_system_t* system);
+// compare results against a JSON lines baseline, returns the number of regressed results
+int bench_compare(bench_t* bench, const char* baseline, double tolerance);
+// write the results as JSON lines into a string buffer, returns the required buffer size
+size_t bench_format(const bench_t* bench, char* buf, size_t buf_size);
+// get the current host time in seconds (monotonic)
+double bench_now(void);
+// get the peak resident set size of the host process in bytes (0 if unavailable)
+size_t bench_peak_rss(void);
+
+// an optional character output callback for the CPU kernels
+typedef void (*bench_out_t)(char c, void* user_data);
+
+#if defined(BENCH_USE_Z80)
+// bench_z80_init() parameters
+typedef struct {
+    chips_range_t image;    // the CP/M .COM program image (loaded at 0x0100)
+    bench_out_t out_cb;     // optional BDOS character output callback
+    void* user_data;        // optional user data for the output callback
+} bench_z80_desc_t;
+
+typedef struct {
+    z80_t cpu;
+    uint64_t pins;
+    chips_range_t image;
+    bench_out_t out_cb;
+    void* user_data;
+    uint32_t num_restarts;  // number of times the program has returned to CP/M
+    uint8_t mem[1<<16];
+} bench_z80_t;
+
+void bench_z80_init(bench_z80_t* bench, const bench_z80_desc_t* desc);
+uint32_t bench_z80_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#if defined(BENCH_USE_M6502)
+// bench_m6502_init() parameters
+typedef struct {
+    chips_range_t image;    // the memory image (loaded at 0x0000, up to 64 KBytes)
+    uint16_t start_addr;    // the start address (default: 0x0400)
+} bench_m6502_desc_t;
+
+typedef struct {
+    m6502_t cpu;
+    uint64_t pins;
+    chips_range_t image;
+    uint16_t start_addr;
+    uint16_t last_pc;
+    uint16_t trap_addr;     // address of the last trap the program got stuck in
+    uint32_t num_restarts;  // number of times the program got stuck in a trap
+    uint8_t mem[1<<16];
+} bench_m6502_t;
+
+void bench_m6502_init(bench_m6502_t* bench, const bench_m6502_desc_t* desc);
+uint32_t bench_m6502_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#if defined(BENCH_USE_M6581)
+typedef struct {
+    m6581_t sid;
+} bench_m6581_t;
+
+void bench_m6581_init(bench_m6581_t* bench);
+uint32_t bench_m6581_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#if defined(BENCH_USE_AY38910)
+typedef struct {
+    ay38910_t ay;
+} bench_ay38910_t;
+
+void bench_ay38910_init(bench_ay38910_t* bench);
+uint32_t bench_ay38910_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#if defined(BENCH_USE_M6569)
+typedef struct {
+    m6569_t vic;
+    uint8_t color_ram[1024];
+    uint8_t mem[1<<14];
+    alignas(64) uint8_t fb[M6569_FRAMEBUFFER_SIZE_BYTES];
+} bench_m6569_t;
+
+void bench_m6569_init(bench_m6569_t* bench);
+uint32_t bench_m6569_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#if defined(BENCH_USE_AM40010)
+typedef struct {
+    am40010_t ga;
+    mc6845_t crtc;
+    uint8_t ram[4][0x4000];
+    alignas(64) uint8_t fb[AM40010_FRAMEBUFFER_SIZE_BYTES];
+} bench_am40010_t;
+
+void bench_am40010_init(bench_am40010_t* bench);
+uint32_t bench_am40010_run(void* user_data, uint32_t num_ticks);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#include <stdio.h>  // snprintf, vsnprintf
+#include <stdlib.h> // strtod
+#include <stdarg.h>
+#include <time.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+    #define _BENCH_HAS_RUSAGE (1)
+#endif
+
+double bench_now(void) {
+    #if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+    #elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+    #else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+    #endif
+}
+
+size_t bench_peak_rss(void) {
+    #if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return pmc.PeakWorkingSetSize;
+    }
+    return 0;
+    #elif defined(_BENCH_HAS_RUSAGE)
+    struct rusage ru;
+    if (0 != getrusage(RUSAGE_SELF, &ru)) {
+        return 0;
+    }
+    #if defined(__APPLE__)
+    return (size_t)ru.ru_maxrss;            // bytes on macOS
+    #else
+    return (size_t)ru.ru_maxrss * 1024;     // kilobytes on Linux and BSDs
+    #endif
+    #else
+    return 0;
+    #endif
+}
+
+void bench_init(bench_t* bench, const bench_desc_t* desc) {
+    CHIPS_ASSERT(bench && desc);
+    memset(bench, 0, sizeof(bench_t));
+    bench->valid = true;
+    bench->revision = desc->revision;
+    bench->min_seconds = (desc->min_seconds > 0.0) ? desc->min_seconds : BENCH_DEFAULT_MIN_SECONDS;
+}
+
+const bench_result_t* bench_measure(bench_t* bench, const bench_item_t* item) {
+    CHIPS_ASSERT(bench && bench->valid && item && item->name && item->run);
+    CHIPS_ASSERT(bench->num_results < BENCH_MAX_RESULTS);
+    // untimed warm-up chunk
+    item->run(item->user_data, BENCH_CHUNK_TICKS);
+    uint64_t ticks = 0;
+    const double start = bench_now();
+    double seconds;
+    do {
+        ticks += item->run(item->user_data, BENCH_CHUNK_TICKS);
+        seconds = bench_now() - start;
+    } while (seconds < bench->min_seconds);
+    bench_result_t* res = &bench->results[bench->num_results++];
+    res->name = item->name;
+    res->ticks = ticks;
+    res->seconds = seconds;
+    res->mhz = ((double)ticks / seconds) * 1.0e-6;
+    res->ns_per_tick = (ticks > 0) ? ((seconds * 1.0e9) / (double)ticks) : 0.0;
+    res->realtime = (item->freq_hz > 0) ? (((double)ticks / seconds) / (double)item->freq_hz) : 0.0;
+    return res;
+}
+
+static void _bench_system_run(bench_t* bench, const bench_system_t* system, const char* variant) {
+    CHIPS_ASSERT(bench->num_results < BENCH_MAX_RESULTS);
+    const uint32_t num_frames = (system->num_frames > 0) ? system->num_frames : BENCH_DEFAULT_NUM_FRAMES;
+    const uint32_t frame_us = (system->frame_us > 0) ? system->frame_us : BENCH_DEFAULT_FRAME_US;
+    uint64_t ticks = 0;
+    const double start = bench_now();
+    for (uint32_t i = 0; i < num_frames; i++) {
+        ticks += system->exec(system->sys, frame_us);
+    }
+    double seconds = bench_now() - start;
+    if (seconds <= 0.0) {
+        seconds = 1.0e-9;
+    }
+    bench_result_t* res = &bench->results[bench->num_results++];
+    res->name = system->name;
+    res->variant = variant;
+    res->ticks = ticks;
+    res->seconds = seconds;
+    res->mhz = ((double)ticks / seconds) * 1.0e-6;
+    res->ns_per_tick = (ticks > 0) ? ((seconds * 1.0e9) / (double)ticks) : 0.0;
+    res->realtime = ((double)num_frames * (double)frame_us * 1.0e-6) / seconds;
+    res->frames = num_frames;
+    res->fps = (double)num_frames / seconds;
+    res->instance_bytes = system->sys_size;
+    res->peak_rss = bench_peak_rss();
+}
+
+const bench_result_t* bench_measure_system(bench_t* bench, const bench_system_t* system) {
+    CHIPS_ASSERT(bench && bench->valid && system && system->name && system->exec && system->sys);
+    const bench_result_t* res = &bench->results[bench->num_results];
+    if (system->headless) {
+        const chips_headless_t orig = *system->headless;
+        system->headless->enabled = false;
+        _bench_system_run(bench, system, "video");
+        system->headless->enabled = true;
+        system->headless->interval = 0;
+        _bench_system_run(bench, system, "headless");
+        *system->headless = orig;
+    }
+    else {
+        _bench_system_run(bench, system, "video");
+    }
+    return res;
+}
+
+// find a string value in a JSON line, copies the value into dst
+static bool _bench_json_str(const char* line, const char* key, char* dst, size_t dst_size) {
+    const char* p = strstr(line, key);
+    if (!p) {
+        return false;
+    }
+    p += strlen(key);
+    size_t i = 0;
+    while (*p && (*p != '"') && (i < (dst_size - 1))) {
+        dst[i++] = *p++;
+    }
+    dst[i] = 0;
+    return true;
+}
+
+int bench_compare(bench_t* bench, const char* baseline, double tolerance) {
+    CHIPS_ASSERT(bench && bench->valid && baseline);
+    if (tolerance <= 0.0) {
+        tolerance = BENCH_DEFAULT_TOLERANCE;
+    }
+    for (int i = 0; i < bench->num_results; i++) {
+        bench->results[i].baseline_ns_per_tick = 0.0;
+        bench->results[i].regressed = false;
+    }
+    // one baseline entry per line
+    char line[512];
+    const char* p = baseline;
+    while (*p) {
+        size_t len = 0;
+        while (p[len] && (p[len] != '\n')) {
+            len++;
+        }
+        const size_t n = (len < (sizeof(line) - 1)) ? len : (sizeof(line) - 1);
+        memcpy(line, p, n);
+        line[n] = 0;
+        p += len;
+        if (*p) {
+            p++;
+        }
+        char name[64], variant[32];
+        if (!_bench_json_str(line, "\"bench\":\"", name, sizeof(name))) {
+            continue;
+        }
+        if (!_bench_json_str(line, "\"variant\":\"", variant, sizeof(variant))) {
+            variant[0] = 0;
+        }
+        const char* ns = strstr(line, "\"ns_per_tick\":");
+        if (!ns) {
+            continue;
+        }
+        const double base_ns = strtod(ns + strlen("\"ns_per_tick\":"), 0);
+        for (int i = 0; i < bench->num_results; i++) {
+            bench_result_t* res = &bench->results[i];
+            const char* res_variant = res->variant ? res->variant : "";
+            if ((0 == strcmp(res->name, name)) && (0 == strcmp(res_variant, variant))) {
+                res->baseline_ns_per_tick = base_ns;
+            }
+        }
+    }
+    int num_regressed = 0;
+    for (int i = 0; i < bench->num_results; i++) {
+        bench_result_t* res = &bench->results[i];
+        if ((res->baseline_ns_per_tick > 0.0) && (res->ns_per_tick > (res->baseline_ns_per_tick * (1.0 + tolerance)))) {
+            res->regressed = true;
+            num_regressed++;
+        }
+    }
+    return num_regressed;
+}
+
+static void _bench_printf(char* buf, size_t buf_size, size_t* pos, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    const int n = vsnprintf((*pos < buf_size) ? (buf + *pos) : 0, (*pos < buf_size) ? (buf_size - *pos) : 0, fmt, args);
+    va_end(args);
+    CHIPS_ASSERT(n >= 0);
+    *pos += (size_t)n;
+}
+
+size_t bench_format(const bench_t* bench, char* buf, size_t buf_size) {
+    CHIPS_ASSERT(bench && bench->valid);
+    CHIPS_ASSERT(buf || (buf_size == 0));
+    const char* rev = bench->revision ? bench->revision : "";
+    size_t pos = 0;
+    for (int i = 0; i < bench->num_results; i++) {
+        const bench_result_t* res = &bench->results[i];
+        _bench_printf(buf, buf_size, &pos, "{\"bench\":\"%s\",", res->name);
+        if (res->variant) {
+            _bench_printf(buf, buf_size, &pos, "\"variant\":\"%s\",", res->variant);
+        }
+        _bench_printf(buf, buf_size, &pos, "\"revision\":\"%s\",\"ticks\":%llu,\"seconds\":%.3f,\"mhz\":%.2f,\"ns_per_tick\":%.3f,\"realtime\":%.2f",
+            rev, (unsigned long long)res->ticks, res->seconds, res->mhz, res->ns_per_tick, res->realtime);
+        if (res->frames > 0) {
+            _bench_printf(buf, buf_size, &pos, ",\"frames\":%u,\"fps\":%.2f,\"instance_bytes\":%llu,\"peak_rss\":%llu",
+                res->frames, res->fps, (unsigned long long)res->instance_bytes, (unsigned long long)res->peak_rss);
+        }
+        if (res->baseline_ns_per_tick > 0.0) {
+            _bench_printf(buf, buf_size, &pos, ",\"baseline_ns_per_tick\":%.3f,\"change\":%.3f,\"regressed\":%s",
+                res->baseline_ns_per_tick, (res->ns_per_tick / res->baseline_ns_per_tick) - 1.0, res->regressed ? "true" : "false");
+        }
+        _bench_printf(buf, buf_size, &pos, "}\n");
+    }
+    if ((buf_size > 0) && (pos >= buf_size)) {
+        // truncated, but keep the buffer zero-terminated
+        buf[buf_size - 1] = 0;
+    }
+    return pos + 1;
+}
+
+#if defined(BENCH_USE_M6569) || defined(BENCH_USE_AM40010)
+// a simple deterministic pseudo-random fill for the video memory kernels
+static void _bench_fill(uint8_t* ptr, size_t num_bytes, uint32_t seed) {
+    uint32_t x = seed;
+    for (size_t i = 0; i < num_bytes; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        ptr[i] = (uint8_t)x;
+    }
+}
+#endif
+
+#if defined(BENCH_USE_Z80)
+static void _bench_z80_restart(bench_z80_t* bench) {
+    memset(bench->mem, 0, sizeof(bench->mem));
+    const size_t size = (bench->image.size < (0x10000 - 0x0100)) ? bench->image.size : (0x10000 - 0x0100);
+    memcpy(&bench->mem[0x0100], bench->image.ptr, size);
+    // CP/M warm boot at 0x0000 (trapped), BDOS entry at 0x0005 with
+    // a RET, and the top of the TPA (used as stack) at 0x0006
+    bench->mem[0x0000] = 0x76;  // HALT
+    bench->mem[0x0005] = 0xC9;  // RET
+    bench->mem[0x0006] = 0x00;
+    bench->mem[0x0007] = 0xF0;
+    bench->pins = z80_init(&bench->cpu);
+    bench->pins = z80_prefetch(&bench->cpu, 0x0100);
+}
+
+static void _bench_z80_bdos(bench_z80_t* bench) {
+    if (0 == bench->out_cb) {
+        return;
+    }
+    z80_t* cpu = &bench->cpu;
+    if (cpu->c == 2) {
+        // output character in E
+        bench->out_cb((char)cpu->e, bench->user_data);
+    }
+    else if (cpu->c == 9) {
+        // output '$' terminated string at DE
+        for (uint16_t addr = cpu->de; bench->mem[addr] != '$'; addr++) {
+            bench->out_cb((char)bench->mem[addr], bench->user_data);
+        }
+    }
+}
+
+void bench_z80_init(bench_z80_t* bench, const bench_z80_desc_t* desc) {
+    CHIPS_ASSERT(bench && desc);
+    CHIPS_ASSERT(desc->image.ptr && (desc->image.size > 0));
+    memset(bench, 0, sizeof(bench_z80_t));
+    bench->image = desc->image;
+    bench->out_cb = desc->out_cb;
+    bench->user_data = desc->user_data;
+    _bench_z80_restart(bench);
+}
+
+uint32_t bench_z80_run(void* user_data, uint32_t num_ticks) {
+    bench_z80_t* bench = (bench_z80_t*) user_data;
+    uint8_t* mem = bench->mem;
+    uint64_t pins = bench->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        pins = z80_tick(&bench->cpu, pins);
+        if (pins & Z80_MREQ) {
+            const uint16_t addr = Z80_GET_ADDR(pins);
+            if (pins & Z80_RD) {
+                if ((pins & Z80_M1) && (addr <= 0x0005)) {
+                    if (addr == 0x0005) {
+                        _bench_z80_bdos(bench);
+                    }
+                    else if (addr == 0x0000) {
+                        bench->num_restarts++;
+                        _bench_z80_restart(bench);
+                        pins = bench->pins;
+                        continue;
+                    }
+                }
+                Z80_SET_DATA(pins, mem[addr]);
+            }
+            else if (pins & Z80_WR) {
+                mem[addr] = Z80_GET_DATA(pins);
+            }
+        }
+    }
+    bench->pins = pins;
+    return num_ticks;
+}
+#endif // BENCH_USE_Z80
+
+#if defined(BENCH_USE_M6502)
+static void _bench_m6502_restart(bench_m6502_t* bench) {
+    memset(bench->mem, 0, sizeof(bench->mem));
+    const size_t size = (bench->image.size < sizeof(bench->mem)) ? bench->image.size : sizeof(bench->mem);
+    memcpy(bench->mem, bench->image.ptr, size);
+    // point the reset vector to the start address
+    bench->mem[0xFFFC] = (uint8_t)bench->start_addr;
+    bench->mem[0xFFFD] = (uint8_t)(bench->start_addr >> 8);
+    bench->pins = m6502_init(&bench->cpu, &(m6502_desc_t){0});
+    bench->last_pc = 0;
+}
+
+void bench_m6502_init(bench_m6502_t* bench, const bench_m6502_desc_t* desc) {
+    CHIPS_ASSERT(bench && desc);
+    CHIPS_ASSERT(desc->image.ptr && (desc->image.size > 0));
+    memset(bench, 0, sizeof(bench_m6502_t));
+    bench->image = desc->image;
+    bench->start_addr = (desc->start_addr != 0) ? desc->start_addr : 0x0400;
+    _bench_m6502_restart(bench);
+}
+
+uint32_t bench_m6502_run(void* user_data, uint32_t num_ticks) {
+    bench_m6502_t* bench = (bench_m6502_t*) user_data;
+    uint8_t* mem = bench->mem;
+    uint64_t pins = bench->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        pins = m6502_tick(&bench->cpu, pins);
+        const uint16_t addr = M6502_GET_ADDR(pins);
+        if (pins & M6502_SYNC) {
+            // an instruction which jumps or branches to itself is a trap
+            if (addr == bench->last_pc) {
+                bench->trap_addr = addr;
+                bench->num_restarts++;
+                _bench_m6502_restart(bench);
+                pins = bench->pins;
+                continue;
+            }
+            bench->last_pc = addr;
+        }
+        if (pins & M6502_RW) {
+            M6502_SET_DATA(pins, mem[addr]);
+        }
+        else {
+            mem[addr] = M6502_GET_DATA(pins);
+        }
+    }
+    bench->pins = pins;
+    return num_ticks;
+}
+#endif // BENCH_USE_M6502
+
+#if defined(BENCH_USE_M6581)
+static void _bench_m6581_wr(m6581_t* sid, uint8_t reg, uint8_t data) {
+    m6581_tick(sid, M6581_CS | (reg & 0x1F) | ((uint64_t)data << M6581_PIN_D0));
+}
+
+void bench_m6581_init(bench_m6581_t* bench) {
+    CHIPS_ASSERT(bench);
+    memset(bench, 0, sizeof(bench_m6581_t));
+    m6581_init(&bench->sid, &(m6581_desc_t){
+        .tick_hz = 985248,
+        .sound_hz = 44100,
+        .magnitude = 1.0f,
+    });
+    // voice 1: sawtooth, voice 2: pulse, voice 3: noise
+    static const uint8_t voice_regs[3][7] = {
+        // freq lo, freq hi, pw lo, pw hi, control, attack/decay, sustain/release
+        { 0x25, 0x11, 0x00, 0x00, 0x21, 0x09, 0xF0 },
+        { 0x8F, 0x16, 0x00, 0x08, 0x41, 0x09, 0xF0 },
+        { 0x00, 0x40, 0x00, 0x00, 0x81, 0x09, 0xF0 },
+    };
+    for (int v = 0; v < 3; v++) {
+        for (int i = 0; i < 7; i++) {
+            _bench_m6581_wr(&bench->sid, (uint8_t)(v * 7 + i), voice_regs[v][i]);
+        }
+    }
+    // low-pass filter with resonance on voices 1 and 2, full volume
+    _bench_m6581_wr(&bench->sid, 0x15, 0x00);
+    _bench_m6581_wr(&bench->sid, 0x16, 0x40);
+    _bench_m6581_wr(&bench->sid, 0x17, 0x83);
+    _bench_m6581_wr(&bench->sid, 0x18, 0x1F);
+}
+
+uint32_t bench_m6581_run(void* user_data, uint32_t num_ticks) {
+    bench_m6581_t* bench = (bench_m6581_t*) user_data;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        m6581_tick(&bench->sid, 0);
+    }
+    return num_ticks;
+}
+#endif // BENCH_USE_M6581
+
+#if defined(BENCH_USE_AY38910)
+void bench_ay38910_init(bench_ay38910_t* bench) {
+    CHIPS_ASSERT(bench);
+    memset(bench, 0, sizeof(bench_ay38910_t));
+    ay38910_init(&bench->ay, &(ay38910_desc_t){
+        .type = AY38910_TYPE_8910,
+        .tick_hz = 1000000,
+        .sound_hz = 44100,
+        .magnitude = 1.0f,
+    });
+    static const uint8_t regs[14] = {
+        0xEF, 0x00,     // tone A period
+        0x77, 0x01,     // tone B period
+        0xBD, 0x00,     // tone C period
+        0x0F,           // noise period
+        0x18,           // enable: tone A, B, C, noise on C
+        0x0F, 0x10, 0x0C,   // amplitudes (B uses the envelope)
+        0x00, 0x08,     // envelope period
+        0x0E,           // envelope shape (continuous triangle)
+    };
+    for (int i = 0; i < 14; i++) {
+        ay38910_set_register(&bench->ay, (uint8_t)i, regs[i]);
+    }
+}
+
+uint32_t bench_ay38910_run(void* user_data, uint32_t num_ticks) {
+    bench_ay38910_t* bench = (bench_ay38910_t*) user_data;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        ay38910_tick(&bench->ay);
+    }
+    return num_ticks;
+}
+#endif // BENCH_USE_AY38910
+
+#if defined(BENCH_USE_M6569)
+static uint16_t _bench_m6569_fetch(uint16_t addr, void* user_data) {
+    bench_m6569_t* bench = (bench_m6569_t*) user_data;
+    return (uint16_t)((bench->color_ram[addr & 0x03FF] << 8) | bench->mem[addr & 0x3FFF]);
+}
+
+static void _bench_m6569_wr(m6569_t* vic, uint8_t reg, uint8_t data) {
+    uint64_t pins = M6569_CS | (reg & M6569_REG_MASK);
+    M6569_SET_DATA(pins, data);
+    m6569_tick(vic, pins);
+}
+
+void bench_m6569_init(bench_m6569_t* bench) {
+    CHIPS_ASSERT(bench);
+    memset(bench, 0, sizeof(bench_m6569_t));
+    _bench_fill(bench->mem, sizeof(bench->mem), 0x6569);
+    _bench_fill(bench->color_ram, sizeof(bench->color_ram), 0xC010);
+    m6569_init(&bench->vic, &(m6569_desc_t){
+        .framebuffer = { .ptr = bench->fb, .size = sizeof(bench->fb) },
+        .screen = { .x = 64, .y = 24, .width = 392, .height = 272 },
+        .fetch_cb = _bench_m6569_fetch,
+        .user_data = bench,
+    });
+    // all 8 sprites spread over the visible area
+    for (int i = 0; i < 8; i++) {
+        _bench_m6569_wr(&bench->vic, (uint8_t)(i * 2), (uint8_t)(40 + i * 32));
+        _bench_m6569_wr(&bench->vic, (uint8_t)(i * 2 + 1), (uint8_t)(60 + i * 20));
+        _bench_m6569_wr(&bench->vic, (uint8_t)(0x27 + i), (uint8_t)(i + 1));
+    }
+    _bench_m6569_wr(&bench->vic, 0x15, 0xFF);   // sprite enable
+    _bench_m6569_wr(&bench->vic, 0x1C, 0x0F);   // multicolor sprites 0..3
+    _bench_m6569_wr(&bench->vic, 0x1D, 0x30);   // x-expand sprites 4 and 5
+    _bench_m6569_wr(&bench->vic, 0x17, 0xC0);   // y-expand sprites 6 and 7
+    // text mode with 25 rows and 40 columns, screen at 0x0400, chars at 0x1000
+    _bench_m6569_wr(&bench->vic, 0x11, 0x1B);
+    _bench_m6569_wr(&bench->vic, 0x16, 0x08);
+    _bench_m6569_wr(&bench->vic, 0x18, 0x14);
+    _bench_m6569_wr(&bench->vic, 0x20, 0x0E);   // border color
+    _bench_m6569_wr(&bench->vic, 0x21, 0x06);   // background color
+}
+
+uint32_t bench_m6569_run(void* user_data, uint32_t num_ticks) {
+    bench_m6569_t* bench = (bench_m6569_t*) user_data;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        m6569_tick(&bench->vic, 0);
+    }
+    return num_ticks;
+}
+#endif // BENCH_USE_M6569
+
+#if defined(BENCH_USE_AM40010)
+static uint64_t _bench_am40010_cclk(void* user_data) {
+    bench_am40010_t* bench = (bench_am40010_t*) user_data;
+    return mc6845_tick(&bench->crtc);
+}
+
+static void _bench_am40010_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_select, void* user_data) {
+    (void)ram_config; (void)rom_enable; (void)rom_select; (void)user_data;
+}
+
+static void _bench_am40010_wr(am40010_t* ga, uint8_t data) {
+    am40010_iorq(ga, AM40010_IORQ | AM40010_WR | AM40010_A14 | ((uint64_t)data << AM40010_PIN_D0));
+}
+
+void bench_am40010_init(bench_am40010_t* bench) {
+    CHIPS_ASSERT(bench);
+    memset(bench, 0, sizeof(bench_am40010_t));
+    _bench_fill(&bench->ram[0][0], sizeof(bench->ram), 0x40010);
+    mc6845_init(&bench->crtc, MC6845_TYPE_UM6845R);
+    am40010_init(&bench->ga, &(am40010_desc_t){
+        .cpc_type = AM40010_CPC_TYPE_464,
+        .bankswitch_cb = _bench_am40010_bankswitch,
+        .cclk_cb = _bench_am40010_cclk,
+        .ram = { .ptr = bench->ram, .size = sizeof(bench->ram) },
+        .framebuffer = { .ptr = bench->fb, .size = sizeof(bench->fb) },
+        .user_data = bench,
+    });
+    // the CPC firmware's default CRTC setup
+    static const uint8_t crtc_regs[14] = { 63, 40, 46, 0x8E, 38, 0, 25, 30, 0, 7, 0, 0, 0x30, 0 };
+    for (int i = 0; i < 14; i++) {
+        uint64_t pins = MC6845_CS;
+        MC6845_SET_DATA(pins, i);
+        mc6845_iorq(&bench->crtc, pins);
+        pins = MC6845_CS | MC6845_RS;
+        MC6845_SET_DATA(pins, crtc_regs[i]);
+        mc6845_iorq(&bench->crtc, pins);
+    }
+    // select mode 1 and setup a 4-color palette
+    _bench_am40010_wr(&bench->ga, 0x80 | 1);
+    static const uint8_t colors[4] = { 0x14, 0x0A, 0x13, 0x0C };
+    for (int i = 0; i < 4; i++) {
+        _bench_am40010_wr(&bench->ga, (uint8_t)i);
+        _bench_am40010_wr(&bench->ga, 0x40 | colors[i]);
+    }
+}
+
+uint32_t bench_am40010_run(void* user_data, uint32_t num_ticks) {
+    bench_am40010_t* bench = (bench_am40010_t*) user_data;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        am40010_tick(&bench->ga, 0);
+    }
+    return num_ticks;
+}
+#endif // BENCH_USE_AM40010
+
+#endif /* CHIPS_UTIL_IMPL */
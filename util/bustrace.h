@@ -0,0 +1,675 @@
+#pragma once
+/*#
+    # bustrace.h
+
+    Streaming capture of per-tick pin state for offline timing analysis.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    You need to include the following headers before including bustrace.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    A bus trace records the 64-bit CPU pin mask of every tick (plus an
+    optional second 64-bit value per tick, for instance the pins of a video
+    chip), so that the full pin history of a run can be inspected after the
+    fact.
+
+    Recording is split between two threads:
+
+    - the *producer* (the emulation thread) appends one record per tick
+      into fixed-size chunks taken from a lock-free single-producer/single-
+      consumer ring of chunks, this is just a couple of stores per tick and
+      never waits for the consumer
+    - the *consumer* (a background thread owned by the host) takes finished
+      chunks out of the ring and encodes each into a self-contained
+      compressed block, which the host writes to a file (or wherever)
+
+    If the consumer falls behind and the chunk ring runs full, records are
+    dropped (and counted), the tick counter continues to advance so that
+    the gap is visible in the block headers.
+
+    The bus trace doesn't do any file I/O or threading itself, this is
+    left to the host.
+
+    A reader decodes a complete trace (for instance a memory-mapped trace
+    file) and looks up the pin state at any tick.
+
+    ## Usage
+
+    Provide the memory for the chunk ring (the number of chunks is derived
+    from the buffer size and must be a power of 2, at least 2 chunks), and
+    hook the bus trace into the system's debug callback:
+
+    ~~~C
+    static bustrace_chunk_t chunks[8];
+    static bustrace_t trace;
+
+    bustrace_init(&trace, &(bustrace_desc_t){
+        .chunks = { .ptr = chunks, .size = sizeof(chunks) },
+    });
+    zx_init(&sys, &(zx_desc_t){
+        ...
+        .debug = { .callback = { .func = bustrace_debug_func, .user_data = &trace } },
+    });
+    ~~~
+
+    Or, to record a second value per tick, call bustrace_record() from your
+    own debug callback (remember to set .aux = true in the desc):
+
+    ~~~C
+    static void my_debug_func(void* user_data, uint64_t pins) {
+        bustrace_record(&trace, pins, sys.vic.pins);
+    }
+    ~~~
+
+    On the background thread, encode finished chunks and write them out:
+
+    ~~~C
+    static uint8_t block[BUSTRACE_MAX_BLOCK_SIZE];
+    while (recording) {
+        size_t num_bytes = bustrace_encode(&trace, block, sizeof(block));
+        if (num_bytes > 0) {
+            fwrite(block, 1, num_bytes, fp);
+        }
+        else {
+            // wait a little
+        }
+    }
+    ~~~
+
+    When recording stops, call bustrace_flush() on the emulation thread to
+    hand the partially filled chunk to the consumer, and drain the ring
+    with bustrace_encode() until it returns 0.
+
+    To look at a trace, load (or memory-map) the file and initialize a
+    reader with a caller-provided block index (one bustrace_index_t per
+    block, a minute of 4 MHz trace is about 14700 blocks):
+
+    ~~~C
+    static bustrace_index_t index[1<<15];
+    static bustrace_reader_t reader;
+    bustrace_reader_init(&reader, &(bustrace_reader_desc_t){
+        .data = { .ptr = file_data, .size = file_size },
+        .index = { .ptr = index, .size = sizeof(index) },
+    });
+    uint64_t pins, aux;
+    if (bustrace_reader_get(&reader, tick, &pins, &aux)) {
+        ...
+    }
+    ~~~
+
+    bustrace_reader_get() decodes (and caches) one block at a time, so
+    sequential lookups are cheap, random lookups decode at most one block.
+
+    ## Encoding
+
+    Each encoded block starts with a 32-byte little-endian header:
+
+        uint32_t magic              'BTRC'
+        uint32_t flags              BUSTRACE_FLAG_AUX if the aux values are present
+        uint64_t first_tick         tick number of the first record
+        uint32_t num_ticks          number of records in the block
+        uint32_t delta_size         size of the decompressed delta stream
+        uint32_t payload_size       size of the compressed payload following the header
+        uint32_t dropped            number of records dropped before this block
+
+    Block payloads are independent from each other (which makes seeking
+    possible). The records are first transformed into a delta stream by
+    XOR-ing each value with the value of the previous tick: each tick is
+    a byte mask of changed bytes (one for the pins, one for the aux value),
+    followed by the changed bytes. If nothing changed, the zero mask(s) are
+    followed by a repeat count for the following unchanged ticks. The
+    delta stream is then compressed with a small greedy LZ77 compressor
+    (with LZ4-style sequences: a token byte with literal and match length
+    nibbles, the literals, a 16-bit match offset), which catches the
+    repeating bus patterns of loops.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BUSTRACE_CHUNK_TICKS (1<<14)
+#define BUSTRACE_HEADER_SIZE (32)
+#define BUSTRACE_MAGIC (0x43525442)     // 'BTRC'
+#define BUSTRACE_FLAG_AUX (1<<0)
+// worst case size of a delta stream (2 mask bytes + 16 value bytes per tick)
+#define BUSTRACE_MAX_DELTA_SIZE (BUSTRACE_CHUNK_TICKS * 18)
+// worst case size of an encoded block
+#define BUSTRACE_MAX_BLOCK_SIZE (BUSTRACE_HEADER_SIZE + BUSTRACE_MAX_DELTA_SIZE + (BUSTRACE_MAX_DELTA_SIZE / 255) + 16)
+
+// a chunk of recorded ticks
+typedef struct {
+    uint64_t first_tick;
+    uint32_t num_ticks;
+    uint32_t dropped;
+    uint64_t pins[BUSTRACE_CHUNK_TICKS];
+    uint64_t aux[BUSTRACE_CHUNK_TICKS];
+} bustrace_chunk_t;
+
+// bustrace_init() parameters
+typedef struct {
+    chips_range_t chunks;       // caller-provided memory for the chunk ring (power-of-2 number of bustrace_chunk_t)
+    bool aux;                   // true to record and encode the aux value
+} bustrace_desc_t;
+
+// bus trace state
+typedef struct {
+    bustrace_chunk_t* chunks;
+    uint32_t num_chunks;
+    bool aux;
+    // producer side, only accessed by the emulation thread
+    bustrace_chunk_t* cur;      // chunk currently being filled, or null
+    uint64_t tick;              // number of ticks seen so far
+    uint32_t dropped;           // dropped ticks since the last published chunk
+    uint64_t total_dropped;
+    uint8_t _pad0[64];          // keep the producer and consumer indices on separate cache lines
+    uint32_t write_idx;         // number of published chunks
+    uint8_t _pad1[64];
+    uint32_t read_idx;          // number of consumed chunks
+    // consumer side, only accessed by the background thread
+    uint8_t delta[BUSTRACE_MAX_DELTA_SIZE];
+    uint32_t hash[1<<12];
+} bustrace_t;
+
+// an entry in the reader's block index
+typedef struct {
+    uint64_t first_tick;
+    uint32_t num_ticks;
+    size_t offset;              // offset of the block header in the trace data
+} bustrace_index_t;
+
+// bustrace_reader_init() parameters
+typedef struct {
+    chips_range_t data;         // the entire encoded trace
+    chips_range_t index;        // caller-provided memory for the block index
+} bustrace_reader_desc_t;
+
+// bus trace reader state
+typedef struct {
+    const uint8_t* data;
+    size_t data_size;
+    bustrace_index_t* index;
+    int num_blocks;
+    bool valid;                 // false if the trace data was malformed or the index too small
+    int cur_block;              // currently decoded block, or -1
+    uint64_t pins[BUSTRACE_CHUNK_TICKS];
+    uint64_t aux[BUSTRACE_CHUNK_TICKS];
+    uint8_t delta[BUSTRACE_MAX_DELTA_SIZE];
+} bustrace_reader_t;
+
+// initialize a bus trace
+void bustrace_init(bustrace_t* bt, const bustrace_desc_t* desc);
+// producer: publish the partially filled chunk (call when recording stops)
+void bustrace_flush(bustrace_t* bt);
+// producer: a chips_debug_func_t compatible callback, user_data must point to a bustrace_t
+void bustrace_debug_func(void* user_data, uint64_t pins);
+// consumer: encode the next finished chunk into dst, returns number of bytes written, or 0 if no chunk is ready
+size_t bustrace_encode(bustrace_t* bt, uint8_t* dst, size_t dst_size);
+// consumer: number of finished chunks waiting to be encoded
+uint32_t bustrace_pending(bustrace_t* bt);
+// initialize a reader and build the block index, returns false if the trace data is malformed
+bool bustrace_reader_init(bustrace_reader_t* r, const bustrace_reader_desc_t* desc);
+// first recorded tick
+uint64_t bustrace_reader_first_tick(const bustrace_reader_t* r);
+// one past the last recorded tick
+uint64_t bustrace_reader_end_tick(const bustrace_reader_t* r);
+// get the pin state at a tick, returns false if the tick isn't in the trace (or has been dropped)
+bool bustrace_reader_get(bustrace_reader_t* r, uint64_t tick, uint64_t* out_pins, uint64_t* out_aux);
+
+// producer: record a single tick (called once per tick from the system's debug callback)
+static inline void bustrace_record(bustrace_t* bt, uint64_t pins, uint64_t aux) {
+    bustrace_chunk_t* chunk = bt->cur;
+    if (0 == chunk) {
+        const uint32_t wi = bt->write_idx;
+        if ((wi - _CHIPS_ATOMIC_LOAD(&bt->read_idx)) < bt->num_chunks) {
+            chunk = bt->cur = &bt->chunks[wi & (bt->num_chunks - 1)];
+            chunk->first_tick = bt->tick;
+            chunk->num_ticks = 0;
+            chunk->dropped = bt->dropped;
+            bt->dropped = 0;
+        }
+        else {
+            bt->tick++;
+            bt->dropped++;
+            bt->total_dropped++;
+            return;
+        }
+    }
+    chunk->pins[chunk->num_ticks] = pins;
+    chunk->aux[chunk->num_ticks] = aux;
+    bt->tick++;
+    if (++chunk->num_ticks == BUSTRACE_CHUNK_TICKS) {
+        bt->cur = 0;
+        _CHIPS_ATOMIC_STORE(&bt->write_idx, bt->write_idx + 1);
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void bustrace_init(bustrace_t* bt, const bustrace_desc_t* desc) {
+    CHIPS_ASSERT(bt && desc);
+    CHIPS_ASSERT(desc->chunks.ptr);
+    const size_t num_chunks = desc->chunks.size / sizeof(bustrace_chunk_t);
+    CHIPS_ASSERT((num_chunks >= 2) && (0 == (num_chunks & (num_chunks - 1))));
+    memset(bt, 0, sizeof(bustrace_t));
+    bt->chunks = (bustrace_chunk_t*) desc->chunks.ptr;
+    bt->num_chunks = (uint32_t) num_chunks;
+    bt->aux = desc->aux;
+}
+
+void bustrace_flush(bustrace_t* bt) {
+    CHIPS_ASSERT(bt);
+    if (bt->cur && (bt->cur->num_ticks > 0)) {
+        bt->cur = 0;
+        _CHIPS_ATOMIC_STORE(&bt->write_idx, bt->write_idx + 1);
+    }
+}
+
+void bustrace_debug_func(void* user_data, uint64_t pins) {
+    bustrace_record((bustrace_t*)user_data, pins, 0);
+}
+
+uint32_t bustrace_pending(bustrace_t* bt) {
+    CHIPS_ASSERT(bt);
+    return _CHIPS_ATOMIC_LOAD(&bt->write_idx) - bt->read_idx;
+}
+
+static inline void _bustrace_put32(uint8_t* dst, uint32_t val) {
+    dst[0] = (uint8_t)val; dst[1] = (uint8_t)(val>>8); dst[2] = (uint8_t)(val>>16); dst[3] = (uint8_t)(val>>24);
+}
+
+static inline uint32_t _bustrace_get32(const uint8_t* src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1]<<8) | ((uint32_t)src[2]<<16) | ((uint32_t)src[3]<<24);
+}
+
+// XOR delta value against previous value, write mask byte at *mask_ptr and changed bytes to dst
+static inline uint8_t* _bustrace_put_delta(uint8_t* dst, uint8_t* mask_ptr, uint64_t x) {
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; i++, x >>= 8) {
+        if (x & 0xFF) {
+            mask |= 1<<i;
+            *dst++ = (uint8_t)x;
+        }
+    }
+    *mask_ptr = mask;
+    return dst;
+}
+
+// transform a chunk into the delta stream, returns size of delta stream
+static uint32_t _bustrace_delta_encode(uint8_t* dst, const bustrace_chunk_t* chunk, bool aux) {
+    uint8_t* ptr = dst;
+    uint64_t prev_pins = 0;
+    uint64_t prev_aux = 0;
+    uint32_t i = 0;
+    while (i < chunk->num_ticks) {
+        const uint64_t xp = chunk->pins[i] ^ prev_pins;
+        const uint64_t xa = aux ? (chunk->aux[i] ^ prev_aux) : 0;
+        prev_pins = chunk->pins[i];
+        prev_aux = aux ? chunk->aux[i] : 0;
+        i++;
+        uint8_t* mask_p = ptr++;
+        uint8_t* mask_a = aux ? ptr++ : 0;
+        if ((xp | xa) == 0) {
+            // a run of unchanged ticks
+            *mask_p = 0;
+            if (mask_a) {
+                *mask_a = 0;
+            }
+            uint32_t n = 0;
+            while ((n < 255) && (i < chunk->num_ticks) && (chunk->pins[i] == prev_pins) && (!aux || (chunk->aux[i] == prev_aux))) {
+                n++; i++;
+            }
+            *ptr++ = (uint8_t)n;
+        }
+        else {
+            uint8_t* vals = _bustrace_put_delta(ptr, mask_p, xp);
+            if (mask_a) {
+                vals = _bustrace_put_delta(vals, mask_a, xa);
+            }
+            ptr = vals;
+        }
+    }
+    CHIPS_ASSERT((ptr - dst) <= BUSTRACE_MAX_DELTA_SIZE);
+    return (uint32_t)(ptr - dst);
+}
+
+// undo _bustrace_delta_encode(), returns false on malformed input
+static bool _bustrace_delta_decode(uint64_t* pins, uint64_t* aux_vals, uint32_t num_ticks, const uint8_t* src, uint32_t src_size, bool aux) {
+    const uint8_t* end = src + src_size;
+    uint64_t prev_pins = 0;
+    uint64_t prev_aux = 0;
+    uint32_t i = 0;
+    while (i < num_ticks) {
+        if ((end - src) < (aux ? 2 : 1)) {
+            return false;
+        }
+        const uint8_t mask_p = *src++;
+        const uint8_t mask_a = aux ? *src++ : 0;
+        if ((mask_p | mask_a) == 0) {
+            if (src >= end) {
+                return false;
+            }
+            uint32_t n = 1 + *src++;
+            if ((i + n) > num_ticks) {
+                return false;
+            }
+            while (n--) {
+                pins[i] = prev_pins;
+                aux_vals[i] = prev_aux;
+                i++;
+            }
+        }
+        else {
+            for (int j = 0; j < 8; j++) {
+                if (mask_p & (1<<j)) {
+                    if (src >= end) {
+                        return false;
+                    }
+                    prev_pins ^= (uint64_t)(*src++) << (j * 8);
+                }
+            }
+            for (int j = 0; j < 8; j++) {
+                if (mask_a & (1<<j)) {
+                    if (src >= end) {
+                        return false;
+                    }
+                    prev_aux ^= (uint64_t)(*src++) << (j * 8);
+                }
+            }
+            pins[i] = prev_pins;
+            aux_vals[i] = prev_aux;
+            i++;
+        }
+    }
+    return src == end;
+}
+
+static inline uint8_t* _bustrace_put_length(uint8_t* dst, uint32_t len) {
+    while (len >= 255) {
+        *dst++ = 255;
+        len -= 255;
+    }
+    *dst++ = (uint8_t)len;
+    return dst;
+}
+
+static inline uint8_t* _bustrace_put_sequence(uint8_t* dst, const uint8_t* lit, uint32_t lit_len, uint32_t match_len, uint32_t offset) {
+    // token: high nibble literal length, low nibble match length - 4
+    uint8_t* token = dst++;
+    *token = (uint8_t)(((lit_len < 15) ? lit_len : 15) << 4);
+    if (lit_len >= 15) {
+        dst = _bustrace_put_length(dst, lit_len - 15);
+    }
+    memcpy(dst, lit, lit_len);
+    dst += lit_len;
+    if (match_len > 0) {
+        *dst++ = (uint8_t)offset;
+        *dst++ = (uint8_t)(offset >> 8);
+        const uint32_t ml = match_len - 4;
+        *token |= (uint8_t)((ml < 15) ? ml : 15);
+        if (ml >= 15) {
+            dst = _bustrace_put_length(dst, ml - 15);
+        }
+    }
+    return dst;
+}
+
+// a greedy LZ77 compressor writing LZ4-style sequences, returns compressed size
+static uint32_t _bustrace_lz_compress(uint8_t* dst, const uint8_t* src, uint32_t size, uint32_t* hash) {
+    memset(hash, 0xFF, (1<<12) * sizeof(uint32_t));
+    uint8_t* ptr = dst;
+    uint32_t pos = 0;
+    uint32_t anchor = 0;
+    while ((pos + 4) < size) {
+        uint32_t v;
+        memcpy(&v, src + pos, 4);
+        const uint32_t h = (v * 2654435761u) >> 20;
+        const uint32_t ref = hash[h];
+        hash[h] = pos;
+        // match offsets are 16 bits
+        if ((ref != 0xFFFFFFFF) && ((pos - ref) <= 0xFFFF)) {
+            uint32_t rv;
+            memcpy(&rv, src + ref, 4);
+            if (rv == v) {
+                uint32_t len = 4;
+                while (((pos + len) < size) && (src[ref + len] == src[pos + len])) {
+                    len++;
+                }
+                ptr = _bustrace_put_sequence(ptr, src + anchor, pos - anchor, len, pos - ref);
+                pos += len;
+                anchor = pos;
+                continue;
+            }
+        }
+        pos++;
+    }
+    // trailing literals
+    ptr = _bustrace_put_sequence(ptr, src + anchor, size - anchor, 0, 0);
+    return (uint32_t)(ptr - dst);
+}
+
+static inline bool _bustrace_get_length(const uint8_t** src, const uint8_t* end, uint32_t* len) {
+    uint8_t b;
+    do {
+        if (*src >= end) {
+            return false;
+        }
+        b = *(*src)++;
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+// undo _bustrace_lz_compress(), returns false on malformed input
+static bool _bustrace_lz_decompress(uint8_t* dst, uint32_t dst_size, const uint8_t* src, uint32_t src_size) {
+    const uint8_t* end = src + src_size;
+    uint32_t pos = 0;
+    while (src < end) {
+        const uint8_t token = *src++;
+        uint32_t lit_len = token >> 4;
+        if ((lit_len == 15) && !_bustrace_get_length(&src, end, &lit_len)) {
+            return false;
+        }
+        if ((lit_len > (uint32_t)(end - src)) || ((pos + lit_len) > dst_size)) {
+            return false;
+        }
+        memcpy(dst + pos, src, lit_len);
+        src += lit_len;
+        pos += lit_len;
+        if (src == end) {
+            // the last sequence only has literals
+            break;
+        }
+        if ((end - src) < 2) {
+            return false;
+        }
+        const uint32_t offset = (uint32_t)src[0] | ((uint32_t)src[1] << 8);
+        src += 2;
+        uint32_t match_len = (token & 15);
+        if ((match_len == 15) && !_bustrace_get_length(&src, end, &match_len)) {
+            return false;
+        }
+        match_len += 4;
+        if ((offset == 0) || (offset > pos) || ((pos + match_len) > dst_size)) {
+            return false;
+        }
+        // byte-wise copy, the match may overlap the output
+        for (uint32_t i = 0; i < match_len; i++, pos++) {
+            dst[pos] = dst[pos - offset];
+        }
+    }
+    return pos == dst_size;
+}
+
+size_t bustrace_encode(bustrace_t* bt, uint8_t* dst, size_t dst_size) {
+    CHIPS_ASSERT(bt && dst);
+    CHIPS_ASSERT(dst_size >= BUSTRACE_MAX_BLOCK_SIZE);
+    (void)dst_size;
+    const uint32_t ri = bt->read_idx;
+    if (ri == _CHIPS_ATOMIC_LOAD(&bt->write_idx)) {
+        return 0;
+    }
+    const bustrace_chunk_t* chunk = &bt->chunks[ri & (bt->num_chunks - 1)];
+    const uint32_t delta_size = _bustrace_delta_encode(bt->delta, chunk, bt->aux);
+    const uint32_t payload_size = _bustrace_lz_compress(dst + BUSTRACE_HEADER_SIZE, bt->delta, delta_size, bt->hash);
+    _bustrace_put32(dst + 0, BUSTRACE_MAGIC);
+    _bustrace_put32(dst + 4, bt->aux ? BUSTRACE_FLAG_AUX : 0);
+    _bustrace_put32(dst + 8, (uint32_t)chunk->first_tick);
+    _bustrace_put32(dst + 12, (uint32_t)(chunk->first_tick >> 32));
+    _bustrace_put32(dst + 16, chunk->num_ticks);
+    _bustrace_put32(dst + 20, delta_size);
+    _bustrace_put32(dst + 24, payload_size);
+    _bustrace_put32(dst + 28, chunk->dropped);
+    _CHIPS_ATOMIC_STORE(&bt->read_idx, ri + 1);
+    return BUSTRACE_HEADER_SIZE + payload_size;
+}
+
+bool bustrace_reader_init(bustrace_reader_t* r, const bustrace_reader_desc_t* desc) {
+    CHIPS_ASSERT(r && desc);
+    CHIPS_ASSERT(desc->data.ptr && desc->index.ptr);
+    memset(r, 0, sizeof(bustrace_reader_t));
+    r->data = (const uint8_t*) desc->data.ptr;
+    r->data_size = desc->data.size;
+    r->index = (bustrace_index_t*) desc->index.ptr;
+    r->cur_block = -1;
+    const int max_blocks = (int)(desc->index.size / sizeof(bustrace_index_t));
+    size_t offset = 0;
+    while (offset < r->data_size) {
+        if (((r->data_size - offset) < BUSTRACE_HEADER_SIZE) || (r->num_blocks >= max_blocks)) {
+            return false;
+        }
+        const uint8_t* hdr = r->data + offset;
+        const uint32_t payload_size = _bustrace_get32(hdr + 24);
+        const uint32_t num_ticks = _bustrace_get32(hdr + 16);
+        if ((_bustrace_get32(hdr) != BUSTRACE_MAGIC) ||
+            (num_ticks > BUSTRACE_CHUNK_TICKS) ||
+            (_bustrace_get32(hdr + 20) > BUSTRACE_MAX_DELTA_SIZE) ||
+            (payload_size > (r->data_size - offset - BUSTRACE_HEADER_SIZE)))
+        {
+            return false;
+        }
+        bustrace_index_t* entry = &r->index[r->num_blocks++];
+        entry->first_tick = (uint64_t)_bustrace_get32(hdr + 8) | ((uint64_t)_bustrace_get32(hdr + 12) << 32);
+        entry->num_ticks = num_ticks;
+        entry->offset = offset;
+        offset += BUSTRACE_HEADER_SIZE + payload_size;
+    }
+    r->valid = true;
+    return true;
+}
+
+uint64_t bustrace_reader_first_tick(const bustrace_reader_t* r) {
+    CHIPS_ASSERT(r);
+    return (r->num_blocks > 0) ? r->index[0].first_tick : 0;
+}
+
+uint64_t bustrace_reader_end_tick(const bustrace_reader_t* r) {
+    CHIPS_ASSERT(r);
+    if (r->num_blocks > 0) {
+        const bustrace_index_t* last = &r->index[r->num_blocks - 1];
+        return last->first_tick + last->num_ticks;
+    }
+    return 0;
+}
+
+static bool _bustrace_reader_decode(bustrace_reader_t* r, int block) {
+    if (block == r->cur_block) {
+        return true;
+    }
+    r->cur_block = -1;
+    const uint8_t* hdr = r->data + r->index[block].offset;
+    const bool aux = 0 != (_bustrace_get32(hdr + 4) & BUSTRACE_FLAG_AUX);
+    const uint32_t num_ticks = _bustrace_get32(hdr + 16);
+    const uint32_t delta_size = _bustrace_get32(hdr + 20);
+    const uint32_t payload_size = _bustrace_get32(hdr + 24);
+    if (!_bustrace_lz_decompress(r->delta, delta_size, hdr + BUSTRACE_HEADER_SIZE, payload_size)) {
+        return false;
+    }
+    if (!_bustrace_delta_decode(r->pins, r->aux, num_ticks, r->delta, delta_size, aux)) {
+        return false;
+    }
+    r->cur_block = block;
+    return true;
+}
+
+bool bustrace_reader_get(bustrace_reader_t* r, uint64_t tick, uint64_t* out_pins, uint64_t* out_aux) {
+    CHIPS_ASSERT(r);
+    if (!r->valid || (r->num_blocks == 0)) {
+        return false;
+    }
+    // binary search for the last block starting at or before tick
+    int lo = 0;
+    int hi = r->num_blocks - 1;
+    while (lo < hi) {
+        const int mid = (lo + hi + 1) / 2;
+        if (r->index[mid].first_tick <= tick) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    const bustrace_index_t* entry = &r->index[lo];
+    if ((tick < entry->first_tick) || (tick >= (entry->first_tick + entry->num_ticks))) {
+        return false;
+    }
+    if (!_bustrace_reader_decode(r, lo)) {
+        return false;
+    }
+    const uint32_t i = (uint32_t)(tick - entry->first_tick);
+    if (out_pins) {
+        *out_pins = r->pins[i];
+    }
+    if (out_aux) {
+        *out_aux = r->aux[i];
+    }
+    return true;
+}
+#endif /* CHIPS_UTIL_IMPL */
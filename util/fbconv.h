@@ -0,0 +1,210 @@
+#pragma once
+/*#
+    # fbconv.h
+
+    Compact visible-area framebuffer conversion to RGBA8 or YUV420.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    You need to include the following headers before including fbconv.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    The systems decode video into a physical framebuffer which is usually
+    bigger than the visible screen area (chips_display_info_t.screen), and
+    most of them store palette indices instead of colors. A host which
+    needs the visible picture as RGBA8 pixels (e.g. for a video encoder)
+    would otherwise crop the framebuffer, and resolve the palette (and
+    convert to YUV) in separate passes.
+
+    The fbconv functions do all of this in a single pass over the visible
+    area, and the result is tightly packed (the row pitch is the screen
+    width). With `dirty_only` set, only the framebuffer rows which are marked in
+    the system's dirty-row bitmap are converted. The rest of the output
+    keeps its previous content (the host still calls chips_dirty_lines_clear()
+    after consuming the frame).
+
+    If the system uses a triple buffer, pass the buffer returned by
+    chips_triple_buffer_acquire() as `fb` (dirty rows are not available
+    in that case), otherwise pass null to use `info->frame.buffer`.
+
+    ## Usage
+
+    ~~~C
+    const chips_display_info_t info = cpc_display_info(&sys);
+    static uint32_t rgba[768*272];
+    fbconv_rgba(&info, 0, rgba, true);
+    ~~~
+
+    For YUV420 (BT.601 limited range), the luma plane is screen.width *
+    screen.height bytes, and each chroma plane is ((screen.width+1)/2) *
+    ((screen.height+1)/2) bytes. Chroma is averaged over 2x2 pixel blocks,
+    so with `dirty_only` a row pair is converted when either row is dirty:
+
+    ~~~C
+    fbconv_yuv420(&info, 0, y_plane, u_plane, v_plane, true);
+    ~~~
+
+    The `portrait` flag of chips_display_info_t is ignored, rotating the
+    picture is up to the host.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// convert the visible screen area into tightly packed RGBA8 pixels (screen.width * screen.height)
+void fbconv_rgba(const chips_display_info_t* info, const void* fb, uint32_t* dst, bool dirty_only);
+// convert the visible screen area into YUV420 planes (see 'Usage' for plane sizes)
+void fbconv_yuv420(const chips_display_info_t* info, const void* fb, uint8_t* y_plane, uint8_t* u_plane, uint8_t* v_plane, bool dirty_only);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+static const uint8_t* _fbconv_src(const chips_display_info_t* info, const void* fb) {
+    CHIPS_ASSERT(info);
+    const uint8_t* src = (const uint8_t*) (fb ? fb : info->frame.buffer.ptr);
+    CHIPS_ASSERT(src);
+    CHIPS_ASSERT((info->frame.bytes_per_pixel == 1) || (info->frame.bytes_per_pixel == 4));
+    CHIPS_ASSERT((info->screen.x >= 0) && (info->screen.y >= 0));
+    CHIPS_ASSERT((info->screen.x + info->screen.width) <= info->frame.dim.width);
+    CHIPS_ASSERT((info->screen.y + info->screen.height) <= info->frame.dim.height);
+    return src;
+}
+
+// true if framebuffer row y needs to be converted
+static inline bool _fbconv_row_dirty(const chips_display_info_t* info, const void* fb, bool dirty_only, int y) {
+    if (!dirty_only || fb || !info->frame.dirty_lines) {
+        return true;
+    }
+    return chips_dirty_lines_test(info->frame.dirty_lines, (size_t)y);
+}
+
+// resolve a framebuffer row into RGBA8 pixels
+static void _fbconv_row_rgba(const chips_display_info_t* info, const uint8_t* src, int y, uint32_t* dst) {
+    const int w = info->screen.width;
+    if (info->frame.bytes_per_pixel == 4) {
+        memcpy(dst, src + ((size_t)y * info->frame.dim.width + info->screen.x) * 4, (size_t)w * 4);
+    } else {
+        const uint32_t* palette = (const uint32_t*) info->palette.ptr;
+        const size_t num_colors = info->palette.size / sizeof(uint32_t);
+        const uint8_t* row = src + (size_t)y * info->frame.dim.width + info->screen.x;
+        for (int x = 0; x < w; x++) {
+            const uint8_t c = row[x];
+            dst[x] = (c < num_colors) ? palette[c] : 0xFF000000;
+        }
+    }
+}
+
+void fbconv_rgba(const chips_display_info_t* info, const void* fb, uint32_t* dst, bool dirty_only) {
+    CHIPS_ASSERT(dst);
+    const uint8_t* src = _fbconv_src(info, fb);
+    for (int y = 0; y < info->screen.height; y++) {
+        const int fb_y = info->screen.y + y;
+        if (_fbconv_row_dirty(info, fb, dirty_only, fb_y)) {
+            _fbconv_row_rgba(info, src, fb_y, dst + (size_t)y * info->screen.width);
+        }
+    }
+}
+
+// BT.601 limited range
+static inline uint8_t _fbconv_y(uint32_t c) {
+    const int r = c & 0xFF, g = (c >> 8) & 0xFF, b = (c >> 16) & 0xFF;
+    return (uint8_t) (((66*r + 129*g + 25*b + 128) >> 8) + 16);
+}
+static inline uint8_t _fbconv_u(uint32_t c) {
+    const int r = c & 0xFF, g = (c >> 8) & 0xFF, b = (c >> 16) & 0xFF;
+    return (uint8_t) (((-38*r - 74*g + 112*b + 128) >> 8) + 128);
+}
+static inline uint8_t _fbconv_v(uint32_t c) {
+    const int r = c & 0xFF, g = (c >> 8) & 0xFF, b = (c >> 16) & 0xFF;
+    return (uint8_t) (((112*r - 94*g - 18*b + 128) >> 8) + 128);
+}
+
+#define _FBCONV_MAX_WIDTH (1024)
+
+void fbconv_yuv420(const chips_display_info_t* info, const void* fb, uint8_t* y_plane, uint8_t* u_plane, uint8_t* v_plane, bool dirty_only) {
+    CHIPS_ASSERT(y_plane && u_plane && v_plane);
+    const uint8_t* src = _fbconv_src(info, fb);
+    const int w = info->screen.width;
+    const int h = info->screen.height;
+    const int cw = (w + 1) / 2;
+    CHIPS_ASSERT(w <= _FBCONV_MAX_WIDTH);
+    uint32_t rows[2][_FBCONV_MAX_WIDTH];
+    for (int y = 0; y < h; y += 2) {
+        const int fb_y0 = info->screen.y + y;
+        // the last row is duplicated for odd screen heights
+        const int fb_y1 = (y + 1 < h) ? (fb_y0 + 1) : fb_y0;
+        if (!_fbconv_row_dirty(info, fb, dirty_only, fb_y0) && !_fbconv_row_dirty(info, fb, dirty_only, fb_y1)) {
+            continue;
+        }
+        _fbconv_row_rgba(info, src, fb_y0, rows[0]);
+        _fbconv_row_rgba(info, src, fb_y1, rows[1]);
+        uint8_t* y0 = y_plane + (size_t)y * w;
+        for (int x = 0; x < w; x++) {
+            y0[x] = _fbconv_y(rows[0][x]);
+        }
+        if (y + 1 < h) {
+            uint8_t* y1 = y0 + w;
+            for (int x = 0; x < w; x++) {
+                y1[x] = _fbconv_y(rows[1][x]);
+            }
+        }
+        uint8_t* u = u_plane + (size_t)(y / 2) * cw;
+        uint8_t* v = v_plane + (size_t)(y / 2) * cw;
+        for (int cx = 0; cx < cw; cx++) {
+            const int x0 = cx * 2;
+            // the last column is duplicated for odd screen widths
+            const int x1 = (x0 + 1 < w) ? (x0 + 1) : x0;
+            const uint32_t c0 = rows[0][x0], c1 = rows[0][x1], c2 = rows[1][x0], c3 = rows[1][x1];
+            u[cx] = (uint8_t) ((_fbconv_u(c0) + _fbconv_u(c1) + _fbconv_u(c2) + _fbconv_u(c3) + 2) >> 2);
+            v[cx] = (uint8_t) ((_fbconv_v(c0) + _fbconv_v(c1) + _fbconv_v(c2) + _fbconv_v(c3) + 2) >> 2);
+        }
+    }
+}
+
+#endif /* CHIPS_UTIL_IMPL */
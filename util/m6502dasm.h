@@ -41,6 +41,18 @@
     NOTE that the output callback will never be called with a null character,
     you need to terminate the resulting string yourself if needed.
 
+    To disassemble a whole block of instructions into a caller-provided
+    buffer (for instance to fill a disassembler view cache in one go):
+
+    ~~~C
+    uint16_t m6502dasm_range(uint16_t pc, int num_lines, m6502dasm_input_t in_cb, void* user_data, m6502dasm_line_t* out_lines)
+    ~~~
+
+    This decodes num_lines consecutive instructions starting at pc and
+    writes each into an m6502dasm_line_t item (instruction address, raw
+    bytes and the zero-terminated mnemonic string). The return value is
+    the pc following the last decoded instruction.
+
     Undocumented instructions are supported and are marked with a '*'.
 
     ## zlib/libpng license
@@ -76,6 +88,23 @@ typedef void (*m6502dasm_output_t)(char c, void* user_data);
 /* disassemble a single 6502 instruction into a stream of ASCII characters */
 uint16_t m6502dasm_op(uint16_t pc, m6502dasm_input_t in_cb, m6502dasm_output_t out_cb, void* user_data);
 
+/* max number of bytes in a single instruction */
+#define M6502DASM_MAX_BYTES (3)
+/* max length of a disassembled instruction string (including terminating zero) */
+#define M6502DASM_MAX_CHARS (32)
+
+/* a single disassembled instruction as written by m6502dasm_range() */
+typedef struct {
+    uint16_t addr;
+    uint8_t num_bytes;
+    uint8_t num_chars;
+    uint8_t bytes[M6502DASM_MAX_BYTES];
+    char chars[M6502DASM_MAX_CHARS];
+} m6502dasm_line_t;
+
+/* disassemble num_lines consecutive instructions into a line buffer, returns pc after last instruction */
+uint16_t m6502dasm_range(uint16_t pc, int num_lines, m6502dasm_input_t in_cb, void* user_data, m6502dasm_line_t* out_lines);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -458,6 +487,45 @@ uint16_t m6502dasm_op(uint16_t pc, m6502dasm_input_t in_cb, m6502dasm_output_t o
     return pc;
 }
 
+typedef struct {
+    m6502dasm_input_t in_cb;
+    void* user_data;
+    m6502dasm_line_t* line;
+} _m6502dasm_range_t;
+
+static uint8_t _m6502dasm_range_in(void* user_data) {
+    _m6502dasm_range_t* ctx = (_m6502dasm_range_t*) user_data;
+    const uint8_t val = ctx->in_cb(ctx->user_data);
+    if (ctx->line->num_bytes < M6502DASM_MAX_BYTES) {
+        ctx->line->bytes[ctx->line->num_bytes++] = val;
+    }
+    return val;
+}
+
+static void _m6502dasm_range_out(char c, void* user_data) {
+    _m6502dasm_range_t* ctx = (_m6502dasm_range_t*) user_data;
+    if ((ctx->line->num_chars + 1) < M6502DASM_MAX_CHARS) {
+        ctx->line->chars[ctx->line->num_chars++] = c;
+    }
+}
+
+uint16_t m6502dasm_range(uint16_t pc, int num_lines, m6502dasm_input_t in_cb, void* user_data, m6502dasm_line_t* out_lines) {
+    CHIPS_ASSERT(in_cb && out_lines && (num_lines >= 0));
+    _m6502dasm_range_t ctx;
+    ctx.in_cb = in_cb;
+    ctx.user_data = user_data;
+    for (int i = 0; i < num_lines; i++) {
+        m6502dasm_line_t* line = &out_lines[i];
+        line->addr = pc;
+        line->num_bytes = 0;
+        line->num_chars = 0;
+        ctx.line = line;
+        pc = m6502dasm_op(pc, _m6502dasm_range_in, _m6502dasm_range_out, &ctx);
+        line->chars[line->num_chars] = 0;
+    }
+    return pc;
+}
+
 #undef _FETCH_I8
 #undef _FETCH_U8
 #undef _FETCH_U16
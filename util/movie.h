@@ -0,0 +1,372 @@
+#pragma once
+/*#
+    # movie.h
+
+    Deterministic input recording and replay with state-hash checkpoints.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    You need to include the following headers before including movie.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    The emulated systems are deterministic: starting from the same state
+    and calling the same sequence of *_exec(), *_key_down(), *_key_up(),
+    *_joystick() etc... functions always produces the same result. The
+    only timing information a host application has is the sequence of
+    *_exec() calls between input events (and those usually have varying
+    durations, depending on the host's frame timing).
+
+    A movie_t records exactly that sequence: every *_exec() call (with the
+    requested duration and the returned number of ticks), and every input
+    event (stamped with the tick count at which it happened). On replay,
+    the same calls are issued in the same order, so that each input event
+    is injected at exactly the same tick as during recording, no matter how
+    fast the replay runs.
+
+    Every N frames (*_exec() calls), a hash of the system state is recorded
+    as checkpoint. On replay the hashes (and the tick counts returned by
+    *_exec()) are compared, so a replay which diverges from the recording
+    is detected within N frames.
+
+    The movie doesn't know anything about the emulated system, it talks to
+    the system through callbacks. All memory is provided by the caller.
+
+    ## Usage
+
+    Provide the system callbacks, for instance for the ZX Spectrum:
+
+    ~~~C
+    static uint32_t zx_movie_exec(void* user_data, uint32_t micro_seconds) {
+        return zx_exec((zx_t*)user_data, micro_seconds);
+    }
+    static void zx_movie_input(void* user_data, const movie_event_t* ev) {
+        zx_t* sys = (zx_t*)user_data;
+        switch (ev->type) {
+            case MOVIE_EVENT_KEY_DOWN: zx_key_down(sys, (int)ev->arg0); break;
+            case MOVIE_EVENT_KEY_UP:   zx_key_up(sys, (int)ev->arg0); break;
+            case MOVIE_EVENT_JOYSTICK: zx_joystick(sys, (uint8_t)ev->arg0); break;
+            default: break;
+        }
+    }
+    static uint64_t zx_movie_hash(void* user_data) {
+        const zx_t* sys = (const zx_t*)user_data;
+        uint64_t h = movie_hash(MOVIE_HASH_SEED, sys->ram, sizeof(sys->ram));
+        return movie_hash(h, &sys->cpu, sizeof(sys->cpu));
+    }
+    ~~~
+
+    Initialize a movie_t with a caller-provided event buffer:
+
+    ~~~C
+    static movie_event_t events[1<<20];
+    movie_init(&movie, &(movie_desc_t){
+        .events = { .ptr = events, .size = sizeof(events) },
+        .hash_interval = 60,
+        .exec_cb = zx_movie_exec,
+        .input_cb = zx_movie_input,
+        .hash_cb = zx_movie_hash,
+        .user_data = &sys,
+    });
+    ~~~
+
+    While recording, call the emulator through the movie_t (the movie
+    forwards the calls to the callbacks and records them):
+
+    ~~~C
+    movie_exec(&movie, frame_time_us);
+    ...
+    movie_input(&movie, MOVIE_EVENT_KEY_DOWN, key_code, 0);
+    ~~~
+
+    To replay, bring the system into the same start state as the
+    recording (e.g. re-initialize it, or load a snapshot taken before
+    recording started), and run:
+
+    ~~~C
+    movie_start_replay(&movie);
+    if (MOVIE_REPLAY_DIVERGED == movie_replay(&movie, -1)) {
+        printf("diverged at frame %d\n", movie.replay.frame);
+    }
+    ~~~
+
+    The recorded events can be stored to a file directly from movie.events
+    (movie.num_events items), and loaded later with movie_load_events().
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOVIE_DEFAULT_HASH_INTERVAL (60)
+#define MOVIE_HASH_SEED (0xCBF29CE484222325ULL)
+
+// event types
+typedef enum {
+    MOVIE_EVENT_INVALID = 0,
+    MOVIE_EVENT_EXEC,       // arg0: requested micro_seconds, arg1: returned ticks
+    MOVIE_EVENT_HASH,       // arg0: lower 32 bits of state hash, arg1: upper 32 bits
+    MOVIE_EVENT_KEY_DOWN,   // arg0: key code
+    MOVIE_EVENT_KEY_UP,     // arg0: key code
+    MOVIE_EVENT_JOYSTICK,   // arg0: joystick mask (1st joystick), arg1: 2nd joystick mask
+    MOVIE_EVENT_INPUT,      // arg0: system-specific input mask (e.g. namco_input_set())
+    MOVIE_EVENT_USER,       // first system-specific event type
+} movie_event_type_t;
+
+// a recorded event
+typedef struct {
+    uint64_t tick;          // system tick count when the event happened
+    uint32_t type;          // movie_event_type_t
+    uint32_t arg0;
+    uint32_t arg1;
+} movie_event_t;
+
+// system callbacks
+typedef uint32_t (*movie_exec_t)(void* user_data, uint32_t micro_seconds);
+typedef void (*movie_input_t)(void* user_data, const movie_event_t* event);
+typedef uint64_t (*movie_hash_t)(void* user_data);
+
+// movie_init() parameters
+typedef struct {
+    chips_range_t events;       // caller-provided buffer for movie_event_t items
+    int hash_interval;          // number of frames between state-hash checkpoints (default: 60)
+    movie_exec_t exec_cb;       // calls the system's *_exec() function
+    movie_input_t input_cb;     // calls the system's input functions
+    movie_hash_t hash_cb;       // optional, computes a state hash
+    void* user_data;
+} movie_desc_t;
+
+// replay result
+typedef enum {
+    MOVIE_REPLAY_OK,            // requested number of frames replayed
+    MOVIE_REPLAY_END,           // end of recording reached
+    MOVIE_REPLAY_DIVERGED,      // returned ticks or state hash differ from recording
+} movie_replay_result_t;
+
+// movie state
+typedef struct {
+    movie_event_t* events;
+    int max_events;
+    int num_events;
+    int hash_interval;
+    movie_exec_t exec_cb;
+    movie_input_t input_cb;
+    movie_hash_t hash_cb;
+    void* user_data;
+    bool overflow;              // true if recording ran out of event buffer space
+    uint64_t tick;              // current tick count
+    int frame;                  // number of recorded frames
+    struct {
+        int pos;                // index of next event to replay
+        int frame;              // number of replayed frames
+        uint64_t tick;          // current replay tick count
+        bool diverged;
+    } replay;
+} movie_t;
+
+// initialize a movie instance
+void movie_init(movie_t* movie, const movie_desc_t* desc);
+// discard all recorded events and start a new recording
+void movie_clear(movie_t* movie);
+// record and run an exec call, returns the number of executed ticks
+uint32_t movie_exec(movie_t* movie, uint32_t micro_seconds);
+// record and forward an input event
+void movie_input(movie_t* movie, uint32_t type, uint32_t arg0, uint32_t arg1);
+// replace the recorded events (e.g. after loading from a file)
+void movie_load_events(movie_t* movie, const movie_event_t* events, int num_events);
+// prepare for replay from the first event
+void movie_start_replay(movie_t* movie);
+// replay num_frames frames (-1 for all remaining frames)
+movie_replay_result_t movie_replay(movie_t* movie, int num_frames);
+// helper to compute a state hash over a memory range
+uint64_t movie_hash(uint64_t hash, const void* ptr, size_t num_bytes);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void movie_init(movie_t* movie, const movie_desc_t* desc) {
+    CHIPS_ASSERT(movie && desc);
+    CHIPS_ASSERT(desc->events.ptr && (desc->events.size >= sizeof(movie_event_t)));
+    CHIPS_ASSERT(desc->exec_cb && desc->input_cb);
+    memset(movie, 0, sizeof(movie_t));
+    movie->events = (movie_event_t*) desc->events.ptr;
+    movie->max_events = (int)(desc->events.size / sizeof(movie_event_t));
+    movie->hash_interval = (desc->hash_interval > 0) ? desc->hash_interval : MOVIE_DEFAULT_HASH_INTERVAL;
+    movie->exec_cb = desc->exec_cb;
+    movie->input_cb = desc->input_cb;
+    movie->hash_cb = desc->hash_cb;
+    movie->user_data = desc->user_data;
+}
+
+void movie_clear(movie_t* movie) {
+    CHIPS_ASSERT(movie && movie->events);
+    movie->num_events = 0;
+    movie->overflow = false;
+    movie->tick = 0;
+    movie->frame = 0;
+    memset(&movie->replay, 0, sizeof(movie->replay));
+}
+
+static void _movie_record(movie_t* movie, uint32_t type, uint32_t arg0, uint32_t arg1) {
+    if (movie->num_events < movie->max_events) {
+        movie_event_t* ev = &movie->events[movie->num_events++];
+        ev->tick = movie->tick;
+        ev->type = type;
+        ev->arg0 = arg0;
+        ev->arg1 = arg1;
+    }
+    else {
+        movie->overflow = true;
+    }
+}
+
+uint32_t movie_exec(movie_t* movie, uint32_t micro_seconds) {
+    CHIPS_ASSERT(movie && movie->events);
+    const uint32_t ticks = movie->exec_cb(movie->user_data, micro_seconds);
+    _movie_record(movie, MOVIE_EVENT_EXEC, micro_seconds, ticks);
+    movie->tick += ticks;
+    movie->frame++;
+    if (movie->hash_cb && ((movie->frame % movie->hash_interval) == 0)) {
+        const uint64_t hash = movie->hash_cb(movie->user_data);
+        _movie_record(movie, MOVIE_EVENT_HASH, (uint32_t)hash, (uint32_t)(hash>>32));
+    }
+    return ticks;
+}
+
+void movie_input(movie_t* movie, uint32_t type, uint32_t arg0, uint32_t arg1) {
+    CHIPS_ASSERT(movie && movie->events);
+    CHIPS_ASSERT((type != MOVIE_EVENT_EXEC) && (type != MOVIE_EVENT_HASH));
+    _movie_record(movie, type, arg0, arg1);
+    const movie_event_t ev = { movie->tick, type, arg0, arg1 };
+    movie->input_cb(movie->user_data, &ev);
+}
+
+void movie_load_events(movie_t* movie, const movie_event_t* events, int num_events) {
+    CHIPS_ASSERT(movie && movie->events && events);
+    CHIPS_ASSERT((num_events >= 0) && (num_events <= movie->max_events));
+    movie_clear(movie);
+    memcpy(movie->events, events, (size_t)num_events * sizeof(movie_event_t));
+    movie->num_events = num_events;
+    for (int i = 0; i < num_events; i++) {
+        if (events[i].type == MOVIE_EVENT_EXEC) {
+            movie->tick += events[i].arg1;
+            movie->frame++;
+        }
+    }
+}
+
+void movie_start_replay(movie_t* movie) {
+    CHIPS_ASSERT(movie && movie->events);
+    memset(&movie->replay, 0, sizeof(movie->replay));
+}
+
+movie_replay_result_t movie_replay(movie_t* movie, int num_frames) {
+    CHIPS_ASSERT(movie && movie->events);
+    if (movie->replay.diverged) {
+        return MOVIE_REPLAY_DIVERGED;
+    }
+    int frames = 0;
+    while ((num_frames < 0) || (frames < num_frames)) {
+        if (movie->replay.pos >= movie->num_events) {
+            return MOVIE_REPLAY_END;
+        }
+        const movie_event_t* ev = &movie->events[movie->replay.pos++];
+        switch (ev->type) {
+            case MOVIE_EVENT_EXEC:
+                {
+                    const uint32_t ticks = movie->exec_cb(movie->user_data, ev->arg0);
+                    movie->replay.tick += ticks;
+                    movie->replay.frame++;
+                    frames++;
+                    if (ticks != ev->arg1) {
+                        movie->replay.diverged = true;
+                    }
+                }
+                break;
+            case MOVIE_EVENT_HASH:
+                if (movie->hash_cb) {
+                    const uint64_t hash = movie->hash_cb(movie->user_data);
+                    if (hash != (((uint64_t)ev->arg1<<32) | ev->arg0)) {
+                        movie->replay.diverged = true;
+                    }
+                }
+                break;
+            default:
+                if (ev->tick != movie->replay.tick) {
+                    movie->replay.diverged = true;
+                }
+                movie->input_cb(movie->user_data, ev);
+                break;
+        }
+        if (movie->replay.diverged) {
+            return MOVIE_REPLAY_DIVERGED;
+        }
+    }
+    return MOVIE_REPLAY_OK;
+}
+
+uint64_t movie_hash(uint64_t hash, const void* ptr, size_t num_bytes) {
+    CHIPS_ASSERT(ptr || (num_bytes == 0));
+    // FNV-1a style, but hashing 8 bytes per step
+    const uint64_t prime = 0x100000001B3ULL;
+    const uint8_t* p = (const uint8_t*) ptr;
+    while (num_bytes >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        hash = (hash ^ v) * prime;
+        hash ^= hash >> 29;
+        p += 8;
+        num_bytes -= 8;
+    }
+    while (num_bytes > 0) {
+        hash = (hash ^ *p++) * prime;
+        num_bytes--;
+    }
+    return hash;
+}
+
+#endif /* CHIPS_UTIL_IMPL */
@@ -0,0 +1,227 @@
+#pragma once
+/*#
+    # runahead.h
+
+    Run-ahead input latency reduction with a secondary emulator instance.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    RUNAHEAD_MAX_FRAMES
+    ~~~
+        the max number of frames to run ahead (default: 8)
+
+    You need to include the following headers before including runahead.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    Many games only react to input one or more frames after the input
+    has been sampled by the emulated system. Run-ahead hides this latency
+    by showing a future frame: after the primary instance has run the
+    current frame with the current input, its state is copied into a
+    secondary instance, which then speculatively runs N more frames
+    with the input unchanged. The frontend displays the secondary
+    instance's framebuffer, so the reaction to a new input shows up N
+    frames earlier than it would otherwise.
+
+    There's no explicit rollback: since the primary instance always runs
+    the *real* frames, the speculative state is simply discarded when the
+    secondary instance is overwritten with the primary's state in the next
+    frame (where new input may have arrived).
+
+    Copying the state through the snapshot functions twice per frame would
+    be too expensive, instead the system's fast state copy function is used
+    (e.g. zx_copy_state(), cpc_copy_state() or c64_copy_state()), these skip
+    the ROM images, the framebuffer and any unused parts of tape or disc
+    images.
+
+    ## Usage
+
+    Initialize two instances with the same configuration. Only the primary
+    instance gets an audio callback, so that the speculative frames are
+    silent. Since the primary instance's framebuffer is never displayed
+    while running ahead, it can also be started in headless mode:
+
+    ~~~C
+    zx_init(&sys, &(zx_desc_t){ ..., .audio.callback = { .func = push_audio }, .headless.enabled = true });
+    zx_init(&ahead, &(zx_desc_t){ ... });
+    ~~~
+
+    Write an exec and a copy wrapper for the system type and initialize
+    the run-ahead helper:
+
+    ~~~C
+    static uint32_t exec_zx(void* sys, uint32_t micro_seconds) {
+        return zx_exec((zx_t*)sys, micro_seconds);
+    }
+    static void copy_zx(void* dst, void* src) {
+        zx_copy_state((zx_t*)dst, (zx_t*)src);
+    }
+
+    static runahead_t ra;
+    runahead_init(&ra, &(runahead_desc_t){
+        .sys = &sys,
+        .ahead = &ahead,
+        .exec = exec_zx,
+        .copy = copy_zx,
+        .num_frames = 1,
+    });
+    ~~~
+
+    Input is always sent to the primary instance, and each frame is run
+    through runahead_frame() instead of the system's exec function:
+
+    ~~~C
+    zx_key_down(&sys, key);
+    ...
+    runahead_frame(&ra, frame_time_us);
+    ~~~
+
+    Afterwards, display the framebuffer of the instance returned by
+    runahead_display_sys() (the secondary instance while running ahead,
+    the primary instance when runahead_set_frames() has been called with
+    0, which switches run-ahead off).
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RUNAHEAD_MAX_FRAMES
+#define RUNAHEAD_MAX_FRAMES (8)
+#endif
+
+// a system exec function wrapper, returns the number of executed ticks
+typedef uint32_t (*runahead_exec_t)(void* sys, uint32_t micro_seconds);
+// a system state copy function wrapper (e.g. calling zx_copy_state())
+typedef void (*runahead_copy_t)(void* dst, void* src);
+
+// runahead_init() parameters
+typedef struct {
+    void* sys;              // the primary instance, receives input and produces audio
+    void* ahead;            // the secondary instance, same configuration but no audio callback
+    runahead_exec_t exec;   // the system's exec function wrapper
+    runahead_copy_t copy;   // the system's state copy function wrapper
+    int num_frames;         // number of frames to run ahead (0: off)
+} runahead_desc_t;
+
+// run-ahead state
+typedef struct {
+    bool valid;
+    void* sys;
+    void* ahead;
+    runahead_exec_t exec;
+    runahead_copy_t copy;
+    int num_frames;
+    uint32_t num_ticks;         // number of ticks of the last real frame
+    uint32_t num_ahead_ticks;   // number of speculatively executed ticks in the last frame
+} runahead_t;
+
+// initialize a run-ahead helper
+void runahead_init(runahead_t* ra, const runahead_desc_t* desc);
+// discard a run-ahead helper
+void runahead_discard(runahead_t* ra);
+// change the number of frames to run ahead (0: off)
+void runahead_set_frames(runahead_t* ra, int num_frames);
+// get the number of frames to run ahead
+int runahead_frames(runahead_t* ra);
+// run one real frame on the primary instance followed by the speculative frames, returns the real frame's ticks
+uint32_t runahead_frame(runahead_t* ra, uint32_t micro_seconds);
+// get the instance whose framebuffer should be displayed
+void* runahead_display_sys(runahead_t* ra);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void runahead_init(runahead_t* ra, const runahead_desc_t* desc) {
+    CHIPS_ASSERT(ra && desc);
+    CHIPS_ASSERT(desc->sys && desc->ahead && (desc->sys != desc->ahead) && desc->exec && desc->copy);
+    CHIPS_ASSERT((desc->num_frames >= 0) && (desc->num_frames <= RUNAHEAD_MAX_FRAMES));
+    memset(ra, 0, sizeof(runahead_t));
+    ra->valid = true;
+    ra->sys = desc->sys;
+    ra->ahead = desc->ahead;
+    ra->exec = desc->exec;
+    ra->copy = desc->copy;
+    ra->num_frames = desc->num_frames;
+}
+
+void runahead_discard(runahead_t* ra) {
+    CHIPS_ASSERT(ra && ra->valid);
+    ra->valid = false;
+}
+
+void runahead_set_frames(runahead_t* ra, int num_frames) {
+    CHIPS_ASSERT(ra && ra->valid);
+    CHIPS_ASSERT((num_frames >= 0) && (num_frames <= RUNAHEAD_MAX_FRAMES));
+    ra->num_frames = num_frames;
+}
+
+int runahead_frames(runahead_t* ra) {
+    CHIPS_ASSERT(ra && ra->valid);
+    return ra->num_frames;
+}
+
+uint32_t runahead_frame(runahead_t* ra, uint32_t micro_seconds) {
+    CHIPS_ASSERT(ra && ra->valid);
+    ra->num_ticks = ra->exec(ra->sys, micro_seconds);
+    ra->num_ahead_ticks = 0;
+    if (ra->num_frames > 0) {
+        // throw away the previous speculative state and run ahead from the real state
+        ra->copy(ra->ahead, ra->sys);
+        for (int i = 0; i < ra->num_frames; i++) {
+            ra->num_ahead_ticks += ra->exec(ra->ahead, micro_seconds);
+        }
+    }
+    return ra->num_ticks;
+}
+
+void* runahead_display_sys(runahead_t* ra) {
+    CHIPS_ASSERT(ra && ra->valid);
+    return (ra->num_frames > 0) ? ra->ahead : ra->sys;
+}
+#endif /* CHIPS_UTIL_IMPL */
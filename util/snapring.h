@@ -0,0 +1,460 @@
+#pragma once
+/*#
+    # snapring.h
+
+    A ring buffer of delta-compressed snapshots for implementing rewind.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    SNAPRING_MAX_FRAMES
+    ~~~
+        the max number of frames in the ring (default: 1024)
+
+    You need to include the following headers before including snapring.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    The snapshot ring stores the snapshot images produced by the system
+    save functions (e.g. zx_save_snapshot()) as a sequence of frames. Each
+    frame is either a *keyframe* (the entire snapshot image, run-length
+    encoded), or a *delta frame* (the XOR difference to the previous frame,
+    run-length encoded). Since only a tiny fraction of the emulator state
+    changes between two video frames, a delta frame is usually just a few
+    KBytes even though the snapshot itself is several hundred KBytes.
+
+    A new keyframe is stored every 'keyframe_interval' frames, this limits
+    the number of deltas which need to be applied when restoring a frame.
+    When the ring runs out of space, the oldest keyframe and all its delta
+    frames are dropped.
+
+    The snapshot ring doesn't know anything about the emulated system, it
+    works on the opaque snapshot images, and all memory is provided by the
+    caller.
+
+    ## Usage
+
+    Initialize a snapring_t with a caller-provided memory buffer and the
+    size of a snapshot image:
+
+    ~~~C
+    static uint8_t ring_buffer[4 * 1024 * 1024];
+    static snapring_t ring;
+
+    snapring_init(&ring, &(snapring_desc_t){
+        .buffer = { .ptr = ring_buffer, .size = sizeof(ring_buffer) },
+        .snapshot_size = sizeof(zx_t),
+        .keyframe_interval = 60,
+    });
+    ~~~
+
+    Once per frame, save a snapshot into a scratch buffer and push it into
+    the ring:
+
+    ~~~C
+    static zx_t snapshot;
+    uint32_t version = zx_save_snapshot(&sys, &snapshot);
+    snapring_push(&ring, version, &snapshot, sizeof(snapshot));
+    ~~~
+
+    To rewind, restore a frame (0 is the oldest frame, snapring_num_frames()-1
+    the newest) into a scratch buffer, and load the snapshot through the
+    system's load function. snapring_rewind() also drops all newer frames,
+    so that recording can continue from the restored frame:
+
+    ~~~C
+    const int frame = snapring_num_frames(&ring) - 1 - num_frames_back;
+    uint32_t version;
+    if (snapring_rewind(&ring, frame, &snapshot, sizeof(snapshot), &version)) {
+        zx_load_snapshot(&sys, version, &snapshot);
+    }
+    ~~~
+
+    Use snapring_restore() instead to look at a frame without dropping the
+    newer frames (e.g. for scrubbing back and forth through the recording).
+
+    ## Memory Layout
+
+    The first 'snapshot_size' bytes of the memory buffer hold a copy of the
+    most recently pushed snapshot (the reference for the next delta frame),
+    the rest of the buffer holds the encoded frames.
+
+    ## Encoding
+
+    Keyframes are encoded exactly like delta frames against an all-zero
+    image. An encoded frame is a sequence of (zero-run, literal-run) pairs,
+    each run length stored as LEB128 varint, followed by the literal bytes.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2026 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SNAPRING_MAX_FRAMES
+#define SNAPRING_MAX_FRAMES (1024)
+#endif
+#define SNAPRING_DEFAULT_KEYFRAME_INTERVAL (60)
+
+// snapring_init() parameters
+typedef struct {
+    chips_range_t buffer;       // caller-provided memory buffer
+    size_t snapshot_size;       // size of a snapshot image in bytes
+    int keyframe_interval;      // number of frames between keyframes (default: 60)
+} snapring_desc_t;
+
+// stored frame
+typedef struct {
+    uint32_t offset;            // offset into encoded-frame pool
+    uint32_t size;              // encoded size in bytes
+    uint32_t version;           // the snapshot version
+    bool keyframe;
+} snapring_frame_t;
+
+// snapshot ring state
+typedef struct {
+    uint8_t* ref;               // copy of the most recently pushed snapshot
+    uint8_t* pool;              // encoded frames
+    uint32_t pool_size;
+    uint32_t pool_head;         // pool offset where the next frame goes
+    uint32_t snapshot_size;
+    int keyframe_interval;
+    int frames_since_keyframe;
+    int tail;                   // index of oldest frame in frames[]
+    int num_frames;
+    snapring_frame_t frames[SNAPRING_MAX_FRAMES];
+} snapring_t;
+
+// initialize a snapshot ring
+void snapring_init(snapring_t* ring, const snapring_desc_t* desc);
+// drop all frames
+void snapring_clear(snapring_t* ring);
+// push a new snapshot image, returns false if the encoded frame doesn't fit into the ring
+bool snapring_push(snapring_t* ring, uint32_t version, const void* snapshot, size_t size);
+// get number of stored frames
+int snapring_num_frames(const snapring_t* ring);
+// get number of pool bytes used by the encoded frames
+uint32_t snapring_bytes_used(const snapring_t* ring);
+// restore a snapshot image (0 is oldest frame), returns false if frame index is invalid
+bool snapring_restore(const snapring_t* ring, int frame, void* dst, size_t size, uint32_t* out_version);
+// restore a snapshot image and drop all newer frames
+bool snapring_rewind(snapring_t* ring, int frame, void* dst, size_t size, uint32_t* out_version);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+void snapring_init(snapring_t* ring, const snapring_desc_t* desc) {
+    CHIPS_ASSERT(ring && desc);
+    CHIPS_ASSERT(desc->buffer.ptr && (desc->snapshot_size > 0));
+    CHIPS_ASSERT(desc->buffer.size > desc->snapshot_size);
+    CHIPS_ASSERT((desc->buffer.size - desc->snapshot_size) <= 0xFFFFFFFF);
+    memset(ring, 0, sizeof(snapring_t));
+    ring->ref = (uint8_t*) desc->buffer.ptr;
+    ring->pool = ring->ref + desc->snapshot_size;
+    ring->pool_size = (uint32_t)(desc->buffer.size - desc->snapshot_size);
+    ring->snapshot_size = (uint32_t)desc->snapshot_size;
+    ring->keyframe_interval = (desc->keyframe_interval > 0) ? desc->keyframe_interval : SNAPRING_DEFAULT_KEYFRAME_INTERVAL;
+}
+
+void snapring_clear(snapring_t* ring) {
+    CHIPS_ASSERT(ring && ring->ref);
+    ring->pool_head = 0;
+    ring->frames_since_keyframe = 0;
+    ring->tail = 0;
+    ring->num_frames = 0;
+}
+
+int snapring_num_frames(const snapring_t* ring) {
+    CHIPS_ASSERT(ring);
+    return ring->num_frames;
+}
+
+static inline int _snapring_index(const snapring_t* ring, int frame) {
+    return (ring->tail + frame) % SNAPRING_MAX_FRAMES;
+}
+
+uint32_t snapring_bytes_used(const snapring_t* ring) {
+    CHIPS_ASSERT(ring);
+    uint32_t bytes = 0;
+    for (int i = 0; i < ring->num_frames; i++) {
+        bytes += ring->frames[_snapring_index(ring, i)].size;
+    }
+    return bytes;
+}
+
+static inline uint32_t _snapring_varint_size(uint32_t val) {
+    uint32_t n = 1;
+    while (val >= 0x80) {
+        val >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static inline uint8_t* _snapring_put_varint(uint8_t* dst, uint32_t val) {
+    while (val >= 0x80) {
+        *dst++ = (uint8_t)(val | 0x80);
+        val >>= 7;
+    }
+    *dst++ = (uint8_t)val;
+    return dst;
+}
+
+static inline const uint8_t* _snapring_get_varint(const uint8_t* src, uint32_t* val) {
+    uint32_t v = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+        b = *src++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    *val = v;
+    return src;
+}
+
+// length of the run of identical bytes (i.e. zero XOR delta) starting at pos
+static uint32_t _snapring_same_run(const uint8_t* cur, const uint8_t* ref, uint32_t pos, uint32_t size) {
+    uint32_t i = pos;
+    if (ref) {
+        while (((i + 8) <= size) && (0 == memcmp(&cur[i], &ref[i], 8))) {
+            i += 8;
+        }
+        while ((i < size) && (cur[i] == ref[i])) {
+            i++;
+        }
+    }
+    else {
+        static const uint8_t zeroes[8] = { 0 };
+        while (((i + 8) <= size) && (0 == memcmp(&cur[i], zeroes, 8))) {
+            i += 8;
+        }
+        while ((i < size) && (cur[i] == 0)) {
+            i++;
+        }
+    }
+    return i - pos;
+}
+
+/*  length of the literal run starting at pos, a literal run only ends
+    at a zero-delta run which is long enough to be worth the run overhead
+*/
+static uint32_t _snapring_diff_run(const uint8_t* cur, const uint8_t* ref, uint32_t pos, uint32_t size) {
+    uint32_t i = pos;
+    while (i < size) {
+        const uint8_t r = ref ? ref[i] : 0;
+        if (cur[i] == r) {
+            const uint32_t same = _snapring_same_run(cur, ref, i, size);
+            if ((same >= 4) || ((i + same) == size)) {
+                break;
+            }
+            i += same;
+        }
+        else {
+            i++;
+        }
+    }
+    return i - pos;
+}
+
+/*  encode the XOR delta between cur and ref (ref == 0 for keyframes), if
+    dst is null only compute the encoded size
+*/
+static uint32_t _snapring_encode(uint8_t* dst, const uint8_t* cur, const uint8_t* ref, uint32_t size) {
+    uint32_t num_bytes = 0;
+    uint32_t pos = 0;
+    while (pos < size) {
+        const uint32_t same = _snapring_same_run(cur, ref, pos, size);
+        pos += same;
+        const uint32_t diff = _snapring_diff_run(cur, ref, pos, size);
+        num_bytes += _snapring_varint_size(same) + _snapring_varint_size(diff) + diff;
+        if (dst) {
+            dst = _snapring_put_varint(dst, same);
+            dst = _snapring_put_varint(dst, diff);
+            for (uint32_t i = 0; i < diff; i++) {
+                *dst++ = cur[pos + i] ^ (ref ? ref[pos + i] : 0);
+            }
+        }
+        pos += diff;
+    }
+    return num_bytes;
+}
+
+// apply an encoded frame to dst, for keyframes dst must be cleared first
+static void _snapring_decode(uint8_t* dst, const uint8_t* src, uint32_t src_size, uint32_t size) {
+    const uint8_t* end = src + src_size;
+    uint32_t pos = 0;
+    while (src < end) {
+        uint32_t same, diff;
+        src = _snapring_get_varint(src, &same);
+        src = _snapring_get_varint(src, &diff);
+        pos += same;
+        CHIPS_ASSERT((pos + diff) <= size);
+        (void)size;
+        for (uint32_t i = 0; i < diff; i++) {
+            dst[pos++] ^= *src++;
+        }
+    }
+}
+
+// drop the oldest keyframe and its delta frames
+static void _snapring_drop_oldest(snapring_t* ring) {
+    CHIPS_ASSERT(ring->num_frames > 0);
+    do {
+        ring->tail = (ring->tail + 1) % SNAPRING_MAX_FRAMES;
+        ring->num_frames--;
+    } while ((ring->num_frames > 0) && !ring->frames[ring->tail].keyframe);
+    if (0 == ring->num_frames) {
+        ring->pool_head = 0;
+        ring->frames_since_keyframe = 0;
+    }
+}
+
+// find a free pool offset for an encoded frame, returns false if not enough space
+static bool _snapring_alloc(const snapring_t* ring, uint32_t size, uint32_t* out_offset) {
+    if (ring->num_frames == SNAPRING_MAX_FRAMES) {
+        return false;
+    }
+    const uint32_t head = ring->pool_head;
+    if (0 == ring->num_frames) {
+        *out_offset = 0;
+        return size <= ring->pool_size;
+    }
+    const uint32_t oldest = ring->frames[ring->tail].offset;
+    if (oldest < head) {
+        // used area doesn't wrap around, free space at end and start of pool
+        if ((head + size) <= ring->pool_size) {
+            *out_offset = head;
+            return true;
+        }
+        else if (size <= oldest) {
+            *out_offset = 0;
+            return true;
+        }
+    }
+    else if ((head + size) <= oldest) {
+        // used area wraps around, free space between head and oldest frame
+        *out_offset = head;
+        return true;
+    }
+    return false;
+}
+
+bool snapring_push(snapring_t* ring, uint32_t version, const void* snapshot, size_t size) {
+    CHIPS_ASSERT(ring && ring->ref && snapshot);
+    CHIPS_ASSERT(size == ring->snapshot_size);
+    (void)size;
+    const uint8_t* cur = (const uint8_t*) snapshot;
+    bool keyframe;
+    uint32_t enc_size;
+    uint32_t offset = 0;
+    for (;;) {
+        keyframe = (0 == ring->num_frames) || (ring->frames_since_keyframe >= ring->keyframe_interval);
+        enc_size = _snapring_encode(0, cur, keyframe ? 0 : ring->ref, ring->snapshot_size);
+        if (_snapring_alloc(ring, enc_size, &offset)) {
+            break;
+        }
+        if (0 == ring->num_frames) {
+            // doesn't fit even into an empty ring
+            return false;
+        }
+        _snapring_drop_oldest(ring);
+    }
+    _snapring_encode(ring->pool + offset, cur, keyframe ? 0 : ring->ref, ring->snapshot_size);
+    memcpy(ring->ref, cur, ring->snapshot_size);
+    snapring_frame_t* frame = &ring->frames[_snapring_index(ring, ring->num_frames)];
+    frame->offset = offset;
+    frame->size = enc_size;
+    frame->version = version;
+    frame->keyframe = keyframe;
+    ring->num_frames++;
+    ring->pool_head = offset + enc_size;
+    ring->frames_since_keyframe = keyframe ? 1 : (ring->frames_since_keyframe + 1);
+    return true;
+}
+
+bool snapring_restore(const snapring_t* ring, int frame, void* dst, size_t size, uint32_t* out_version) {
+    CHIPS_ASSERT(ring && ring->ref && dst);
+    CHIPS_ASSERT(size == ring->snapshot_size);
+    if ((frame < 0) || (frame >= ring->num_frames)) {
+        return false;
+    }
+    // find the frame's keyframe (the oldest frame is always a keyframe)
+    int key = frame;
+    while (!ring->frames[_snapring_index(ring, key)].keyframe) {
+        CHIPS_ASSERT(key > 0);
+        key--;
+    }
+    uint8_t* dst8 = (uint8_t*) dst;
+    memset(dst8, 0, size);
+    for (int i = key; i <= frame; i++) {
+        const snapring_frame_t* f = &ring->frames[_snapring_index(ring, i)];
+        _snapring_decode(dst8, ring->pool + f->offset, f->size, ring->snapshot_size);
+    }
+    if (out_version) {
+        *out_version = ring->frames[_snapring_index(ring, frame)].version;
+    }
+    return true;
+}
+
+bool snapring_rewind(snapring_t* ring, int frame, void* dst, size_t size, uint32_t* out_version) {
+    if (!snapring_restore(ring, frame, dst, size, out_version)) {
+        return false;
+    }
+    // drop all newer frames, the restored frame becomes the delta reference
+    int key = frame;
+    while (!ring->frames[_snapring_index(ring, key)].keyframe) {
+        key--;
+    }
+    const snapring_frame_t* f = &ring->frames[_snapring_index(ring, frame)];
+    ring->num_frames = frame + 1;
+    ring->pool_head = f->offset + f->size;
+    ring->frames_since_keyframe = frame - key + 1;
+    memcpy(ring->ref, dst, ring->snapshot_size);
+    return true;
+}
+
+#endif /* CHIPS_UTIL_IMPL */